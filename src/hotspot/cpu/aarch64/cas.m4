@@ -66,7 +66,7 @@ instruct compareAndExchange$1$7(iReg$2NoSp res, indirect mem, iReg$2 oldval, iRe
   ins_encode %{
     __ $5(rscratch2, $oldval$$Register);
     __ cmpxchg($mem$$Register, rscratch2, $newval$$Register,
-               Assembler::$4, /*acquire*/ ifelse($5,Acq,true,false), /*release*/ true,
+               Assembler::$4, /*acquire*/ ifelse($7,Acq,true,false), /*release*/ true,
                /*weak*/ false, $res$$Register);
     __ $6($res$$Register, $res$$Register);
   %}
@@ -79,12 +79,12 @@ CAS_INSN(L,L,long,xword)
 CAS_INSN(N,N,narrow oop,word)
 CAS_INSN(P,P,ptr,xword)
 dnl
-dnl CAS_INSN4(B,I,byte,byte,uxtbw,sxtbw,Acq)
-dnl CAS_INSN4(S,I,short,halfword,uxthw,sxthw,Acq)
-dnl CAS_INSN(I,I,int,word,Acq)
-dnl CAS_INSN(L,L,long,xword,Acq)
-dnl CAS_INSN(N,N,narrow oop,word,Acq)
-dnl CAS_INSN(P,P,ptr,xword,Acq)
+CAS_INSN4(B,I,byte,byte,uxtbw,sxtbw,Acq)
+CAS_INSN4(S,I,short,halfword,uxthw,sxthw,Acq)
+CAS_INSN(I,I,int,word,Acq)
+CAS_INSN(L,L,long,xword,Acq)
+CAS_INSN(N,N,narrow oop,word,Acq)
+CAS_INSN(P,P,ptr,xword,Acq)
 dnl
 define(`CAS_INSN2',
 `
@@ -131,12 +131,12 @@ CAS_INSN3(I,I,int,word)
 CAS_INSN3(L,L,long,xword)
 CAS_INSN3(N,N,narrow oop,word)
 CAS_INSN3(P,P,ptr,xword)
-dnl CAS_INSN2(B,I,byte,byte,bw,Acq)
-dnl CAS_INSN2(S,I,short,halfword,hw,Acq)
-dnl CAS_INSN3(I,I,int,word,Acq)
-dnl CAS_INSN3(L,L,long,xword,Acq)
-dnl CAS_INSN3(N,N,narrow oop,word,Acq)
-dnl CAS_INSN3(P,P,ptr,xword,Acq)
+CAS_INSN2(B,I,byte,byte,bw,Acq)
+CAS_INSN2(S,I,short,halfword,hw,Acq)
+CAS_INSN3(I,I,int,word,Acq)
+CAS_INSN3(L,L,long,xword,Acq)
+CAS_INSN3(N,N,narrow oop,word,Acq)
+CAS_INSN3(P,P,ptr,xword,Acq)
 dnl
 
 // END This section of the file is automatically generated. Do not edit --------------
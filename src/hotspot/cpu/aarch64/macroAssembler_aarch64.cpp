@@ -1247,6 +1247,15 @@ void MacroAssembler::check_klass_subtype_slow_path(Register sub_klass,
   str(rscratch1, pst_counter_addr);
 #endif //PRODUCT
 
+  // Consult the secondary supers bitmap first: if the super's hash slot
+  // is clear, the super cannot be in the array and no scan is needed.
+  Label L_scan_done;
+  ldrb(rscratch1, Address(super_klass, Klass::hash_slot_offset()));
+  ldr(rscratch2, Address(sub_klass, Klass::secondary_supers_bitmap_offset()));
+  lsrv(rscratch2, rscratch2, rscratch1);
+  cmp(sp, zr); // Clear Z flag; SP is never zero
+  tbz(rscratch2, 0, L_scan_done);
+
   // We will consult the secondary-super array.
   ldr(r5, secondary_supers_addr);
   // Load the array length.
@@ -1254,11 +1263,12 @@ void MacroAssembler::check_klass_subtype_slow_path(Register sub_klass,
   // Skip to start of data.
   add(r5, r5, Array<Klass*>::base_offset_in_bytes());
 
-  cmp(sp, zr); // Clear Z flag; SP is never zero
   // Scan R2 words at [R5] for an occurrence of R0.
   // Set NZ/Z based on last compare.
   repne_scan(r5, r0, r2, rscratch1);
 
+  bind(L_scan_done);
+
   // Unspill the temp. registers:
   pop(pushed_registers, sp);
 
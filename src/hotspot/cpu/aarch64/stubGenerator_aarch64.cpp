@@ -656,6 +656,8 @@ class StubGenerator: public StubCodeGenerator {
         break;
       case BarrierSet::CardTableModRef:
         break;
+      case BarrierSet::EpsilonBarrierSet:
+        break;
       default:
         ShouldNotReachHere();
 
@@ -719,6 +721,8 @@ class StubGenerator: public StubCodeGenerator {
           __ br(Assembler::GE, L_loop);
         }
         break;
+      case BarrierSet::EpsilonBarrierSet:
+        break;
       default:
         ShouldNotReachHere();
 
@@ -35,6 +35,7 @@
 #include "oops/objArrayKlass.hpp"
 #include "oops/oop.inline.hpp"
 #include "prims/methodHandles.hpp"
+#include "runtime/safepointMechanism.hpp"
 #include "runtime/sharedRuntime.hpp"
 #include "runtime/stubRoutines.hpp"
 #include "runtime/synchronizer.hpp"
@@ -200,6 +201,9 @@ static void do_oop_store(InterpreterMacroAssembler* _masm,
         }
       }
       break;
+#if INCLUDE_ALL_GCS
+    case BarrierSet::EpsilonBarrierSet:
+#endif // INCLUDE_ALL_GCS
     case BarrierSet::ModRef:
       if (val == noreg) {
         __ store_heap_oop_null(obj);
@@ -908,6 +912,20 @@ void TemplateTable::fast_icaload()
   __ load_unsigned_short(r0, Address(r1,  arrayOopDesc::base_offset_in_bytes(T_CHAR)));
 }
 
+// iload followed by iadd frequent pair
+void TemplateTable::fast_iload_iadd()
+{
+  transition(vtos, itos);
+  // load local
+  locals_index(r2);
+  __ ldr(r0, iaddress(r2));
+
+  // r0: local
+  // r1: other operand
+  __ pop_i(r1);
+  __ addw(r0, r1, r0);
+}
+
 void TemplateTable::saload()
 {
   transition(itos, itos);
@@ -2331,6 +2349,18 @@ void TemplateTable::_return(TosState state)
     __ bind(skip_register_finalizer);
   }
 
+  if (SafepointMechanism::uses_thread_local_poll() && _desc->bytecode() != Bytecodes::_return_register_finalizer) {
+    Label no_safepoint;
+    NOT_PRODUCT(__ block_comment("Thread-local Safepoint poll"));
+    __ ldr(rscratch1, Address(rthread, Thread::polling_page_offset()));
+    __ tbz(rscratch1, exact_log2(SafepointMechanism::poll_bit()), no_safepoint);
+    __ push(state);
+    __ call_VM(noreg, CAST_FROM_FN_PTR(address,
+                                    InterpreterRuntime::at_safepoint));
+    __ pop(state);
+    __ bind(no_safepoint);
+  }
+
   // Issue a StoreStore barrier after all stores but before return
   // from any constructor for any class with a final field.  We don't
   // know if this is a finalizer, so we always do so.
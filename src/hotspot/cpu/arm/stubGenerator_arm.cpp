@@ -2911,6 +2911,8 @@ class StubGenerator: public StubCodeGenerator {
       }
     case BarrierSet::CardTableModRef:
       break;
+    case BarrierSet::EpsilonBarrierSet:
+      break;
     default:
       ShouldNotReachHere();
     }
@@ -2993,6 +2995,8 @@ class StubGenerator: public StubCodeGenerator {
         __ BIND(L_done);
       }
       break;
+    case BarrierSet::EpsilonBarrierSet:
+      break;
     default:
       ShouldNotReachHere();
     }
@@ -243,6 +243,16 @@ static void do_oop_store(InterpreterMacroAssembler* _masm,
         }
       }
       break;
+#if INCLUDE_ALL_GCS
+    case BarrierSet::EpsilonBarrierSet:
+      if (is_null) {
+        __ store_heap_oop_null(new_val, obj);
+      } else {
+        __ store_heap_oop(new_val, obj); // blows new_val:
+        new_val = noreg;
+      }
+      break;
+#endif // INCLUDE_ALL_GCS
     case BarrierSet::ModRef:
       ShouldNotReachHere();
       break;
@@ -905,6 +915,21 @@ void TemplateTable::fast_icaload() {
   __ ldrh(R0_tos, get_array_elem_addr(T_CHAR, Rarray, Rindex, Rtemp));
 }
 
+// iload followed by iadd frequent pair
+void TemplateTable::fast_iload_iadd() {
+  transition(vtos, itos);
+  const Register Rlocal_index = R1_tmp;
+  const Register Rother = R1_tmp;
+
+  // load local
+  locals_index(Rlocal_index);
+  Address local = load_iaddress(Rlocal_index, Rtemp);
+  __ ldr_s32(R0_tos, local);
+
+  __ pop_i(Rother);
+  __ add_32(R0_tos, Rother, R0_tos);
+}
+
 
 void TemplateTable::saload() {
   transition(itos, itos);
@@ -671,6 +671,8 @@ class StubGenerator: public StubCodeGenerator {
         break;
       case BarrierSet::CardTableModRef:
         break;
+      case BarrierSet::EpsilonBarrierSet:
+        break;
       default:
         ShouldNotReachHere();
     }
@@ -739,6 +741,8 @@ class StubGenerator: public StubCodeGenerator {
       break;
       case BarrierSet::ModRef:
         break;
+      case BarrierSet::EpsilonBarrierSet:
+        break;
       default:
         ShouldNotReachHere();
     }
@@ -138,6 +138,38 @@ static void do_oop_store(InterpreterMacroAssembler* _masm,
         __ bind(Ldone);
       }
       break;
+#if INCLUDE_ALL_GCS
+    case BarrierSet::EpsilonBarrierSet:
+      {
+        Label Lnull, Ldone;
+        if (Rval != noreg) {
+          if (check_null) {
+            __ cmpdi(CCR0, Rval, 0);
+            __ beq(CCR0, Lnull);
+          }
+          __ store_heap_oop_not_null(Rval, offset, Rbase, Rtmp1);
+          if (check_null) {
+            __ b(Ldone);
+          }
+        }
+
+        if (Rval == noreg || check_null) { // Store null oop.
+          Register Rnull = Rval;
+          __ bind(Lnull);
+          if (Rval == noreg) {
+            Rnull = Rtmp1;
+            __ li(Rnull, 0);
+          }
+          if (UseCompressedOops) {
+            __ stw(Rnull, offset, Rbase);
+          } else {
+            __ std(Rnull, offset, Rbase);
+          }
+        }
+        __ bind(Ldone);
+      }
+      break;
+#endif // INCLUDE_ALL_GCS
     case BarrierSet::ModRef:
       ShouldNotReachHere();
       break;
@@ -795,6 +827,18 @@ void TemplateTable::fast_icaload() {
   __ lhz(R17_tos, arrayOopDesc::base_offset_in_bytes(T_CHAR), Rload_addr);
 }
 
+// Iload followed by iadd frequent pair.
+void TemplateTable::fast_iload_iadd() {
+  transition(vtos, itos);
+
+  const Register Rscratch = R11_scratch1;
+
+  locals_index(R17_tos);
+  __ load_local_int(R17_tos, Rscratch, R17_tos);
+  __ pop_i(Rscratch);
+  __ add(R17_tos, Rscratch, R17_tos);
+}
+
 void TemplateTable::saload() {
   transition(itos, itos);
 
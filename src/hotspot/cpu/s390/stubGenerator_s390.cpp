@@ -727,6 +727,8 @@ class StubGenerator: public StubCodeGenerator {
       case BarrierSet::CardTableModRef:
       case BarrierSet::ModRef:
         break;
+      case BarrierSet::EpsilonBarrierSet:
+        break;
       default:
         ShouldNotReachHere();
     }
@@ -862,6 +864,8 @@ class StubGenerator: public StubCodeGenerator {
       case BarrierSet::ModRef:
         if (!branchToEnd) { __ z_br(Z_R14); }
         break;
+      case BarrierSet::EpsilonBarrierSet:
+        break;
       default:
         ShouldNotReachHere();
     }
@@ -274,6 +274,17 @@ static void do_oop_store(InterpreterMacroAssembler* _masm,
       }
     }
     break;
+#if INCLUDE_ALL_GCS
+    case BarrierSet::EpsilonBarrierSet:
+    {
+      if (val_is_null) {
+        __ store_heap_oop_null(val, offset, base);
+      } else {
+        __ store_heap_oop(val, offset, base);
+      }
+    }
+    break;
+#endif // INCLUDE_ALL_GCS
   case BarrierSet::ModRef:
     // fall through
   default:
@@ -967,6 +978,18 @@ void TemplateTable::fast_icaload() {
             Address(Z_tmp_2, Z_ARG3, arrayOopDesc::base_offset_in_bytes(T_CHAR)));
 }
 
+// Iload followed by iadd frequent pair.
+void TemplateTable::fast_iload_iadd() {
+  transition(vtos, itos);
+
+  // Load local.
+  locals_index(Z_R1_scratch);
+  __ mem2reg_opt(Z_tos, iaddress(_masm, Z_R1_scratch), false);
+  // Add the other operand from the stack top.
+  __ z_ay(Z_tos, __ stackTop());
+  __ pop_i();
+}
+
 void TemplateTable::saload() {
   transition(itos, itos);
 
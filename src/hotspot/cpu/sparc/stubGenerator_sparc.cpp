@@ -879,6 +879,8 @@ class StubGenerator: public StubCodeGenerator {
         break;
       case BarrierSet::CardTableModRef:
         break;
+      case BarrierSet::EpsilonBarrierSet:
+        break;
       default:
         ShouldNotReachHere();
     }
@@ -938,6 +940,8 @@ class StubGenerator: public StubCodeGenerator {
         break;
       case BarrierSet::ModRef:
         break;
+      case BarrierSet::EpsilonBarrierSet:
+        break;
       default:
         ShouldNotReachHere();
     }
@@ -111,6 +111,16 @@ static void do_oop_store(InterpreterMacroAssembler* _masm,
         }
       }
       break;
+#if INCLUDE_ALL_GCS
+    case BarrierSet::EpsilonBarrierSet:
+      if (index == noreg ) {
+        assert(Assembler::is_simm13(offset), "fix this code");
+        __ store_heap_oop(val, base, offset);
+      } else {
+        __ store_heap_oop(val, base, index);
+      }
+      break;
+#endif // INCLUDE_ALL_GCS
     case BarrierSet::ModRef:
       ShouldNotReachHere();
       break;
@@ -617,6 +627,16 @@ void TemplateTable::fast_icaload() {
   __ lduh(O3, arrayOopDesc::base_offset_in_bytes(T_CHAR), Otos_i);
 }
 
+void TemplateTable::fast_iload_iadd() {
+  transition(vtos, itos);
+  // Otos_i: local
+  // tos: other operand
+  locals_index(G3_scratch);
+  __ access_local_int( G3_scratch, Otos_i );
+  __ pop_i(O1);
+  __ add(O1, Otos_i, Otos_i);
+}
+
 
 void TemplateTable::saload() {
   transition(itos, itos);
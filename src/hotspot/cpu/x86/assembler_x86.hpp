@@ -1402,6 +1402,9 @@ private:
   void vmovdqu(XMMRegister dst, Address src);
   void vmovdqu(XMMRegister dst, XMMRegister src);
 
+  // Store 256bit Vector, non-temporal (destination must be 32-byte aligned)
+  void vmovntdq(Address dst, XMMRegister src);
+
    // Move Unaligned 512bit Vector
   void evmovdqub(Address dst, XMMRegister src, int vector_len);
   void evmovdqub(XMMRegister dst, Address src, int vector_len);
@@ -1635,6 +1638,10 @@ private:
 
   void vpopcntd(XMMRegister dst, XMMRegister src, int vector_len);
 
+  // 52-bit integer multiply, add low/high 52 bits of the products (AVX-512 IFMA)
+  void vpmadd52luq(XMMRegister dst, XMMRegister nds, XMMRegister src, int vector_len);
+  void vpmadd52huq(XMMRegister dst, XMMRegister nds, XMMRegister src, int vector_len);
+
 #ifdef _LP64
   void popcntq(Register dst, Address src);
   void popcntq(Register dst, Register src);
@@ -1763,6 +1770,8 @@ private:
   void shrq(Register dst, int imm8);
   void shrq(Register dst);
 
+  void sfence();
+
   void smovl(); // QQQ generic?
 
   // Compute Square Root of Scalar Double-Precision Floating-Point Value
@@ -1991,6 +2000,15 @@ private:
   void vpmulld(XMMRegister dst, XMMRegister nds, Address src, int vector_len);
   void vpmullq(XMMRegister dst, XMMRegister nds, Address src, int vector_len);
 
+  // Multiply and add adjacent packed integers
+  void vpmaddubsw(XMMRegister dst, XMMRegister nds, XMMRegister src, int vector_len);
+  void vpmaddwd(XMMRegister dst, XMMRegister nds, XMMRegister src, int vector_len);
+  void vpmaddwd(XMMRegister dst, XMMRegister nds, Address src, int vector_len);
+
+  // Sum of absolute differences of packed unsigned bytes
+  void vpsadbw(XMMRegister dst, XMMRegister nds, XMMRegister src, int vector_len);
+  void vpsadbw(XMMRegister dst, XMMRegister nds, Address src, int vector_len);
+
   // Shift left packed integers
   void psllw(XMMRegister dst, int shift);
   void pslld(XMMRegister dst, int shift);
@@ -150,9 +150,21 @@ define_pd_global(bool, ThreadLocalHandshakes, false);
   product(bool, UseUnalignedLoadStores, false,                              \
           "Use SSE2 MOVDQU instruction for Arraycopy")                      \
                                                                             \
+  product(intx, ArrayCopyNonTemporalThreshold, 0,                           \
+          "Copies of at least this many bytes use non-temporal stores "     \
+          "with AVX2 unaligned arraycopy (0 disables)")                     \
+          range(0, max_jint)                                                \
+                                                                            \
+  experimental(bool, UseTSCForJavaTimeNanos, false,                         \
+          "Compute System.nanoTime from a calibrated invariant TSC "        \
+          "instead of calling clock_gettime (Linux x86_64 only)")           \
+                                                                            \
   product(bool, UseFastStosb, false,                                        \
           "Use fast-string operation for zeroing: rep stosb")               \
                                                                             \
+  product(bool, UseXMMForObjInit, false,                                    \
+          "Use XMM/YMM MOVDQU instruction for Object Initialization")       \
+                                                                            \
   /* Use Restricted Transactional Memory for lock eliding */                \
   product(bool, UseRTMLocking, false,                                       \
           "Enable RTM lock eliding for inflated locks in compiled code")    \
@@ -175,6 +187,11 @@ define_pd_global(bool, ThreadLocalHandshakes, false);
           "Calculate abort ratio after this number of aborts")              \
           range(0, max_jint)                                                \
                                                                             \
+  experimental(int, RTMMonitorAbortThreshold, 0,                            \
+          "Stop eliding an inflated monitor once it has seen this many "    \
+          "RTM aborts (0 disables per-monitor abort tracking)")             \
+          range(0, max_jint)                                                \
+                                                                            \
   experimental(int, RTMLockingThreshold, 10000,                             \
           "Lock count at which to do RTM lock eliding without "             \
           "abort ratio calculation")                                        \
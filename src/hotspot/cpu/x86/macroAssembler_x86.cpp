@@ -1543,8 +1543,9 @@ void MacroAssembler::rtm_inflated_locking(Register objReg, Register boxReg, Regi
   assert(UseRTMLocking, "why call this otherwise?");
   assert(tmpReg == rax, "");
   assert(scrReg == rdx, "");
-  Label L_rtm_retry, L_decrement_retry, L_on_abort;
+  Label L_rtm_retry, L_decrement_retry, L_on_abort, L_no_elision;
   int owner_offset = OM_OFFSET_NO_MONITOR_VALUE_TAG(owner);
+  int rtm_aborts_offset = OM_OFFSET_NO_MONITOR_VALUE_TAG(rtm_aborts);
 
   // Without cast to int32_t a movptr will destroy r10 which is typically obj
   movptr(Address(boxReg, 0), (int32_t)intptr_t(markOopDesc::unused_mark()));
@@ -1555,6 +1556,11 @@ void MacroAssembler::rtm_inflated_locking(Register objReg, Register boxReg, Regi
     movl(retry_on_abort_count_Reg, RTMRetryCount); // Retry on abort
     bind(L_rtm_retry);
   }
+  if (RTMMonitorAbortThreshold > 0) {
+    // This monitor aborts too often to be worth eliding, lock it for real
+    cmpl(Address(boxReg, rtm_aborts_offset), RTMMonitorAbortThreshold);
+    jcc(Assembler::aboveEqual, L_no_elision);
+  }
   if (PrintPreciseRTMLockingStatistics || profile_rtm) {
     Label L_noincrement;
     if (RTMTotalCountIncrRate > 1) {
@@ -1582,11 +1588,29 @@ void MacroAssembler::rtm_inflated_locking(Register objReg, Register boxReg, Regi
   if (PrintPreciseRTMLockingStatistics || profile_rtm) {
     rtm_profiling(abort_status_Reg, scrReg, rtm_counters, method_data, profile_rtm);
   }
+  if (RTMMonitorAbortThreshold > 0) {
+    // Count aborts per monitor. The increment is not atomic: losing an
+    // update only delays reaching the threshold.
+    Label L_keep_eliding;
+    incrementl(Address(boxReg, rtm_aborts_offset));
+    cmpl(Address(boxReg, rtm_aborts_offset), RTMMonitorAbortThreshold);
+    jccb(Assembler::below, L_keep_eliding);
+#ifdef _LP64
+    if (UsePerfData) {
+      jcc(Assembler::above, L_no_elision);
+      // First abort past the threshold, scrReg is free here
+      atomic_incptr(ExternalAddress((address)&ObjectMonitor::_rtm_disabled_monitors), scrReg);
+    }
+#endif
+    jmp(L_no_elision);
+    bind(L_keep_eliding);
+  }
   if (RTMRetryCount > 0) {
     // retry on lock abort if abort status is 'can retry' (0x2) or 'memory conflict' (0x4)
     rtm_retry_lock_on_abort(retry_on_abort_count_Reg, abort_status_Reg, L_rtm_retry);
   }
 
+  bind(L_no_elision);
   movptr(tmpReg, Address(boxReg, owner_offset)) ;
   testptr(tmpReg, tmpReg) ;
   jccb(Assembler::notZero, L_decrement_retry) ;
@@ -5948,6 +5972,22 @@ void MacroAssembler::check_klass_subtype_slow_path(Register sub_klass,
   LP64_ONLY( incrementl(Address(rcx, 0)) );
 #endif //PRODUCT
 
+  // Consult the secondary supers bitmap first: if the super's hash slot
+  // is clear, the super cannot be in the array and no scan is needed.
+  // (Skipped when sub_klass lives in RDI, which the test clobbers.)
+  Label L_scan, L_scan_done;
+  if (sub_klass != rdi) {
+    movzbl(rcx, Address(rax, Klass::hash_slot_offset()));
+    movptr(rdi, Address(sub_klass, Klass::secondary_supers_bitmap_offset()));
+    shrptr(rdi);              // Shift by CL
+    testl(rdi, 1);
+    jccb(Assembler::notZero, L_scan);
+    movptr(rdi, rax);         // Miss: leave RDI non-zero
+    testptr(rax, rax);        // Set Z = 0
+    jmpb(L_scan_done);
+  }
+
+  bind(L_scan);
   // We will consult the secondary-super array.
   movptr(rdi, secondary_supers_addr);
   // Load the array length.  (Positive movl does right thing on LP64.)
@@ -5964,6 +6004,8 @@ void MacroAssembler::check_klass_subtype_slow_path(Register sub_klass,
     testptr(rax,rax); // Set Z = 0
     repne_scan();
 
+  bind(L_scan_done);
+
   // Unspill the temp. registers:
   if (pushed_rdi)  pop(rdi);
   if (pushed_rcx)  pop(rcx);
@@ -7068,7 +7110,58 @@ void MacroAssembler::verified_entry(int framesize, int stack_bang_size, bool fp_
 
 }
 
-void MacroAssembler::clear_mem(Register base, Register cnt, Register tmp, bool is_large) {
+void MacroAssembler::xmm_clear_mem(Register base, Register cnt, XMMRegister xtmp) {
+  // cnt - number of qwords (8-byte words).
+  // base - start address, qword aligned.
+  Label L_zero_64_bytes, L_loop, L_sloop, L_tail, L_end;
+  if (UseAVX >= 2) {
+    vpxor(xtmp, xtmp, xtmp, AVX_256bit);
+  } else {
+    pxor(xtmp, xtmp);
+  }
+  jmp(L_zero_64_bytes);
+
+  BIND(L_loop);
+  if (UseAVX >= 2) {
+    vmovdqu(Address(base,  0), xtmp);
+    vmovdqu(Address(base, 32), xtmp);
+  } else {
+    movdqu(Address(base,  0), xtmp);
+    movdqu(Address(base, 16), xtmp);
+    movdqu(Address(base, 32), xtmp);
+    movdqu(Address(base, 48), xtmp);
+  }
+  addptr(base, 64);
+
+  BIND(L_zero_64_bytes);
+  subptr(cnt, 8);
+  jccb(Assembler::greaterEqual, L_loop);
+  addptr(cnt, 4);
+  jccb(Assembler::less, L_tail);
+  // Copy trailing 32 bytes
+  if (UseAVX >= 2) {
+    vmovdqu(Address(base, 0), xtmp);
+  } else {
+    movdqu(Address(base,  0), xtmp);
+    movdqu(Address(base, 16), xtmp);
+  }
+  addptr(base, 32);
+  subptr(cnt, 4);
+
+  BIND(L_tail);
+  addptr(cnt, 4);
+  jccb(Assembler::lessEqual, L_end);
+  decrement(cnt);
+
+  BIND(L_sloop);
+  movq(Address(base, 0), xtmp);
+  addptr(base, 8);
+  decrement(cnt);
+  jccb(Assembler::greaterEqual, L_sloop);
+  BIND(L_end);
+}
+
+void MacroAssembler::clear_mem(Register base, Register cnt, Register tmp, XMMRegister xtmp, bool is_large) {
   // cnt - number of qwords (8-byte words).
   // base - start address, qword aligned.
   // is_large - if optimizers know cnt is larger than InitArrayShortSize
@@ -7106,6 +7199,9 @@ void MacroAssembler::clear_mem(Register base, Register cnt, Register tmp, bool i
   if (UseFastStosb) {
     shlptr(cnt, 3); // convert to number of bytes
     rep_stosb();
+  } else if (UseXMMForObjInit) {
+    movptr(tmp, base);
+    xmm_clear_mem(tmp, cnt, xtmp);
   } else {
     NOT_LP64(shlptr(cnt, 1);) // convert to number of 32-bit words for 32-bit VM
     rep_stos();
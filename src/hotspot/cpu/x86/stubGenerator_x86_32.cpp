@@ -709,6 +709,10 @@ class StubGenerator: public StubCodeGenerator {
 #endif // INCLUDE_ALL_GCS
       case BarrierSet::CardTableModRef:
         break;
+#if INCLUDE_ALL_GCS
+      case BarrierSet::EpsilonBarrierSet:
+        break;
+#endif // INCLUDE_ALL_GCS
       default      :
         ShouldNotReachHere();
 
@@ -763,6 +767,10 @@ class StubGenerator: public StubCodeGenerator {
         break;
       case BarrierSet::ModRef:
         break;
+#if INCLUDE_ALL_GCS
+      case BarrierSet::EpsilonBarrierSet:
+        break;
+#endif // INCLUDE_ALL_GCS
       default      :
         ShouldNotReachHere();
 
@@ -1237,6 +1237,8 @@ class StubGenerator: public StubCodeGenerator {
          break;
       case BarrierSet::CardTableModRef:
         break;
+      case BarrierSet::EpsilonBarrierSet:
+        break;
       default:
         ShouldNotReachHere();
 
@@ -1297,6 +1299,8 @@ class StubGenerator: public StubCodeGenerator {
         __ BIND(L_done);
         }
         break;
+      case BarrierSet::EpsilonBarrierSet:
+        break;
       default:
         ShouldNotReachHere();
 
@@ -1321,11 +1325,45 @@ class StubGenerator: public StubCodeGenerator {
     Label L_loop;
     __ align(OptoLoopAlignment);
     if (UseUnalignedLoadStores) {
-      Label L_end;
+      Label L_end, L_loop_test;
       if (UseAVX > 2) {
         __ movl(to, 0xffff);
         __ kmovwl(k1, to);
       }
+      if (UseAVX >= 2 && ArrayCopyNonTemporalThreshold > 0) {
+        // Large copies bypass the caches with streaming stores, which need a
+        // 32-byte aligned destination: peel qwords until it is aligned, or
+        // stay with the regular loop if qword steps can never align it.
+        Label L_align, L_nt_loop;
+        const intx nt_qwords = MAX2(ArrayCopyNonTemporalThreshold / BytesPerLong, (intx)32);
+        __ BIND(L_copy_bytes);
+        __ cmpptr(qword_count, -(int32_t)nt_qwords);
+        __ jcc(Assembler::greater, L_loop_test);
+        __ lea(to, Address(end_to, qword_count, Address::times_8, 8));
+        __ testl(to, BytesPerLong - 1);
+        __ jcc(Assembler::notZero, L_loop_test);
+        __ BIND(L_align);
+        __ testl(to, 31);
+        __ jccb(Assembler::zero, L_nt_loop);
+        __ movq(to, Address(end_from, qword_count, Address::times_8, 8));
+        __ movq(Address(end_to, qword_count, Address::times_8, 8), to);
+        __ increment(qword_count);
+        __ lea(to, Address(end_to, qword_count, Address::times_8, 8));
+        __ jmpb(L_align);
+        // Copy 64-bytes per iteration
+        __ align(OptoLoopAlignment);
+        __ BIND(L_nt_loop);
+        __ vmovdqu(xmm0, Address(end_from, qword_count, Address::times_8, 8));
+        __ vmovntdq(Address(end_to, qword_count, Address::times_8, 8), xmm0);
+        __ vmovdqu(xmm1, Address(end_from, qword_count, Address::times_8, 40));
+        __ vmovntdq(Address(end_to, qword_count, Address::times_8, 40), xmm1);
+        __ addptr(qword_count, 8);
+        __ cmpptr(qword_count, -8);
+        __ jcc(Assembler::lessEqual, L_nt_loop);
+        __ sfence();
+        __ jmp(L_loop_test);
+        __ align(OptoLoopAlignment);
+      }
       // Copy 64-bytes per iteration
       __ BIND(L_loop);
       if (UseAVX > 2) {
@@ -1346,7 +1384,10 @@ class StubGenerator: public StubCodeGenerator {
         __ movdqu(xmm3, Address(end_from, qword_count, Address::times_8, - 8));
         __ movdqu(Address(end_to, qword_count, Address::times_8, - 8), xmm3);
       }
-      __ BIND(L_copy_bytes);
+      if (!L_copy_bytes.is_bound()) {
+        __ BIND(L_copy_bytes);
+      }
+      __ BIND(L_loop_test);
       __ addptr(qword_count, 8);
       __ jcc(Assembler::lessEqual, L_loop);
       __ subptr(qword_count, 4);  // sub(8) and add(4)
@@ -4418,6 +4459,170 @@ class StubGenerator: public StubCodeGenerator {
       return start;
   }
 
+  // Byte weights 32..1 and word multipliers for the Adler32 stub
+  address generate_adler32_tables() {
+    __ align(CodeEntryAlignment);
+    StubCodeMark mark(this, "StubRoutines", "adler32_tables");
+    address start = __ pc();
+    __ emit_data64(0x191a1b1c1d1e1f20, relocInfo::none);
+    __ emit_data64(0x1112131415161718, relocInfo::none);
+    __ emit_data64(0x090a0b0c0d0e0f10, relocInfo::none);
+    __ emit_data64(0x0102030405060708, relocInfo::none);
+    for (int i = 0; i < 4; i++) {
+      __ emit_data64(0x0001000100010001, relocInfo::none);
+    }
+    return start;
+  }
+
+  /**
+   *  Arguments:
+   *
+   *  Inputs:
+   *   c_rarg0   - int   adler
+   *   c_rarg1   - byte* buff
+   *   c_rarg2   - int   len
+   *
+   *  Output:
+   *   rax   - int adler result
+   *
+   *  Sums 32-byte chunks with AVX2 in blocks of at most NMAX bytes, so that
+   *  the 32-bit lane accumulators cannot overflow before the modulo reduction,
+   *  and finishes the remaining bytes one at a time.
+   */
+  address generate_updateBytesAdler32() {
+    assert(UseAdler32Intrinsics, "need AVX2");
+    __ align(CodeEntryAlignment);
+    StubCodeMark mark(this, "StubRoutines", "updateBytesAdler32");
+    address start = __ pc();
+
+    const int BASE = 65521;         // largest prime smaller than 65536
+    const int NMAX = 5552 & ~31;    // NMAX as in zlib, rounded down to whole chunks
+
+    const Register buf   = r11;
+    const Register len   = r10;
+    const Register s1    = r9;
+    const Register s2    = r8;
+    const Register count = rcx;
+    const Register table = rdx;     // only live inside a block
+
+    const XMMRegister xzero    = xmm0;
+    const XMMRegister xweights = xmm1;
+    const XMMRegister xs1      = xmm2;  // byte sums
+    const XMMRegister xs2      = xmm3;  // weighted byte sums
+    const XMMRegister xs1acc   = xmm4;  // byte sums of the preceding chunks
+    const XMMRegister xtmp     = xmm5;
+
+    Label L_block, L_nmax, L_chunk, L_tail, L_tail_loop, L_done;
+
+    __ enter(); // required for proper stackwalking of RuntimeStub frame
+
+    __ movl(rax, c_rarg0);
+    __ movptr(buf, c_rarg1);
+    __ movl(len, c_rarg2);
+    __ movl(s1, rax);
+    __ andl(s1, 0xffff);
+    __ shrl(rax, 16);
+    __ movl(s2, rax);
+
+    __ cmpl(len, 32);
+    __ jcc(Assembler::less, L_tail);
+    __ lea(table, ExternalAddress(StubRoutines::x86::adler32_tables_addr()));
+    __ vpxor(xzero, xzero, xzero, Assembler::AVX_256bit);
+    __ vmovdqu(xweights, Address(table, 0));
+
+    __ BIND(L_block);
+    __ movl(count, len);
+    __ andl(count, ~31);
+    __ cmpl(count, NMAX);
+    __ jccb(Assembler::belowEqual, L_nmax);
+    __ movl(count, NMAX);
+    __ BIND(L_nmax);
+    __ subl(len, count);
+    // Each byte of the block adds the incoming s1 to s2
+    __ movl(rax, s1);
+    __ imull(rax, count);
+    __ addl(s2, rax);
+    __ shrl(count, 5);
+    __ vpxor(xs1, xs1, xs1, Assembler::AVX_256bit);
+    __ vpxor(xs2, xs2, xs2, Assembler::AVX_256bit);
+    __ vpxor(xs1acc, xs1acc, xs1acc, Assembler::AVX_256bit);
+
+    __ BIND(L_chunk);
+    __ vpaddd(xs1acc, xs1acc, xs1, Assembler::AVX_256bit);
+    __ vmovdqu(xtmp, Address(buf, 0));
+    __ vpmaddubsw(xtmp, xtmp, xweights, Assembler::AVX_256bit);
+    __ vpmaddwd(xtmp, xtmp, Address(table, 32), Assembler::AVX_256bit);
+    __ vpaddd(xs2, xs2, xtmp, Assembler::AVX_256bit);
+    __ vpsadbw(xtmp, xzero, Address(buf, 0), Assembler::AVX_256bit);
+    __ vpaddd(xs1, xs1, xtmp, Assembler::AVX_256bit);
+    __ addptr(buf, 32);
+    __ decrementl(count);
+    __ jcc(Assembler::notZero, L_chunk);
+
+    // Every earlier chunk contributes its byte sum 32 times per later chunk
+    __ vpslld(xs1acc, xs1acc, 5, Assembler::AVX_256bit);
+    __ vpaddd(xs2, xs2, xs1acc, Assembler::AVX_256bit);
+    // Reduce the lanes into s1 and s2
+    __ vextracti128_high(xtmp, xs1);
+    __ vpaddd(xs1, xs1, xtmp, Assembler::AVX_128bit);
+    __ pshufd(xtmp, xs1, 0x4e);
+    __ vpaddd(xs1, xs1, xtmp, Assembler::AVX_128bit);
+    __ movdl(rax, xs1);
+    __ addl(s1, rax);
+    __ vextracti128_high(xtmp, xs2);
+    __ vpaddd(xs2, xs2, xtmp, Assembler::AVX_128bit);
+    __ pshufd(xtmp, xs2, 0x4e);
+    __ vpaddd(xs2, xs2, xtmp, Assembler::AVX_128bit);
+    __ pshufd(xtmp, xs2, 0xb1);
+    __ vpaddd(xs2, xs2, xtmp, Assembler::AVX_128bit);
+    __ movdl(rax, xs2);
+    __ addl(s2, rax);
+    // s1 %= BASE, s2 %= BASE
+    __ movl(count, BASE);
+    __ movl(rax, s1);
+    __ xorl(rdx, rdx);
+    __ divl(count);
+    __ movl(s1, rdx);
+    __ movl(rax, s2);
+    __ xorl(rdx, rdx);
+    __ divl(count);
+    __ movl(s2, rdx);
+    __ lea(table, ExternalAddress(StubRoutines::x86::adler32_tables_addr()));
+
+    __ cmpl(len, 32);
+    __ jcc(Assembler::greaterEqual, L_block);
+    __ vzeroupper();
+
+    __ BIND(L_tail);
+    __ testl(len, len);
+    __ jcc(Assembler::zero, L_done);
+    __ BIND(L_tail_loop);
+    __ movzbl(rax, Address(buf, 0));
+    __ addl(s1, rax);
+    __ addl(s2, s1);
+    __ incrementq(buf);
+    __ decrementl(len);
+    __ jcc(Assembler::notZero, L_tail_loop);
+    __ movl(count, BASE);
+    __ movl(rax, s1);
+    __ xorl(rdx, rdx);
+    __ divl(count);
+    __ movl(s1, rdx);
+    __ movl(rax, s2);
+    __ xorl(rdx, rdx);
+    __ divl(count);
+    __ movl(s2, rdx);
+
+    __ BIND(L_done);
+    __ movl(rax, s2);
+    __ shll(rax, 16);
+    __ orl(rax, s1);
+    __ leave(); // required for proper stackwalking of RuntimeStub frame
+    __ ret(0);
+
+    return start;
+  }
+
   /**
    *  Arguments:
    *
@@ -5064,6 +5269,10 @@ class StubGenerator: public StubCodeGenerator {
       StubRoutines::_crc32c_table_addr = (address)StubRoutines::x86::_crc32c_table;
       StubRoutines::_updateBytesCRC32C = generate_updateBytesCRC32C(supports_clmul);
     }
+    if (UseAdler32Intrinsics) {
+      StubRoutines::x86::_adler32_tables_addr = generate_adler32_tables();
+      StubRoutines::_updateBytesAdler32 = generate_updateBytesAdler32();
+    }
     if (VM_Version::supports_sse2() && UseLibmIntrinsic && InlineIntrinsics) {
       if (vmIntrinsics::is_intrinsic_available(vmIntrinsics::_dsin) ||
           vmIntrinsics::is_intrinsic_available(vmIntrinsics::_dcos) ||
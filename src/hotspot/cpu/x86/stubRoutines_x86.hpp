@@ -122,6 +122,8 @@ class x86 {
   // swap mask for ghash
   static address _ghash_long_swap_mask_addr;
   static address _ghash_byte_swap_mask_addr;
+  // weights for adler32
+  static address _adler32_tables_addr;
 
   // upper word mask for sha1
   static address _upper_word_mask_addr;
@@ -191,6 +193,7 @@ class x86 {
   static address crc_by128_masks_addr()  { return (address)_crc_by128_masks; }
   static address ghash_long_swap_mask_addr() { return _ghash_long_swap_mask_addr; }
   static address ghash_byte_swap_mask_addr() { return _ghash_byte_swap_mask_addr; }
+  static address adler32_tables_addr() { return _adler32_tables_addr; }
   static address upper_word_mask_addr() { return _upper_word_mask_addr; }
   static address shuffle_byte_flip_mask_addr() { return _shuffle_byte_flip_mask_addr; }
   static address k256_addr()      { return _k256_adr; }
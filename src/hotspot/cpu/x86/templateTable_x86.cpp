@@ -214,6 +214,9 @@ static void do_oop_store(InterpreterMacroAssembler* _masm,
         }
       }
       break;
+#if INCLUDE_ALL_GCS
+    case BarrierSet::EpsilonBarrierSet:
+#endif // INCLUDE_ALL_GCS
     case BarrierSet::ModRef:
       if (val == noreg) {
         __ store_heap_oop_null(obj);
@@ -709,6 +712,11 @@ void TemplateTable::iload_internal(RewriteControl rc) {
     __ movl(bc, Bytecodes::_fast_icaload);
     __ jccb(Assembler::equal, rewrite);
 
+    // if _iadd, rewrite to fast_iload_iadd
+    __ cmpl(rbx, Bytecodes::_iadd);
+    __ movl(bc, Bytecodes::_fast_iload_iadd);
+    __ jccb(Assembler::equal, rewrite);
+
     // rewrite so iload doesn't check again.
     __ movl(bc, Bytecodes::_fast_iload);
 
@@ -911,6 +919,19 @@ void TemplateTable::fast_icaload() {
                                  arrayOopDesc::base_offset_in_bytes(T_CHAR)));
 }
 
+// iload followed by iadd frequent pair
+void TemplateTable::fast_iload_iadd() {
+  transition(vtos, itos);
+  // load local
+  locals_index(rbx);
+  __ movl(rax, iaddress(rbx));
+
+  // rax: local
+  // stack top: other operand
+  __ pop_i(rdx);
+  __ addl(rax, rdx);
+}
+
 
 void TemplateTable::saload() {
   transition(itos, itos);
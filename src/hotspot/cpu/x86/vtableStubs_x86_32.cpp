@@ -175,8 +175,13 @@ VtableStub* VtableStubs::create_itable_stub(int itable_index) {
   assert(VtableStub::receiver_location() ==  rcx->as_VMReg(), "receiver expected in  rcx");
   __ load_klass(recv_klass_reg, rcx);
 
-  // Receiver subtype check against REFC.
+  // Receiver subtype check against REFC.  When the method is declared in
+  // REFC itself, the itable lookup below fails for exactly the receivers
+  // that fail this check, so the separate scan is skipped.
   // Destroys recv_klass_reg value.
+  Label L_refc_checked;
+  __ cmpptr(resolved_klass_reg, holder_klass_reg);
+  __ jcc(Assembler::equal, L_refc_checked);
   __ lookup_interface_method(// inputs: rec. class, interface
                              recv_klass_reg, resolved_klass_reg, noreg,
                              // outputs:  scan temp. reg1, scan temp. reg2
@@ -184,9 +189,11 @@ VtableStub* VtableStubs::create_itable_stub(int itable_index) {
                              L_no_such_interface,
                              /*return_method=*/false);
 
+  __ load_klass(recv_klass_reg, rcx); // restore recv_klass_reg
+  __ bind(L_refc_checked);
+
   // Get selected method from declaring class and itable index
   const Register method = rbx;
-  __ load_klass(recv_klass_reg, rcx); // restore recv_klass_reg
   __ lookup_interface_method(// inputs: rec. class, interface, itable index
                              recv_klass_reg, holder_klass_reg, itable_index,
                              // outputs: method, scan temp. reg
@@ -244,7 +251,7 @@ int VtableStub::pd_code_size_limit(bool is_vtable_stub) {
     return (DebugVtables ? 210 : 16) + (CountCompiledCalls ? 6 : 0);
   } else {
     // Itable stub size
-    return (DebugVtables ? 256 : 110) + (CountCompiledCalls ? 6 : 0);
+    return (DebugVtables ? 256 : 120) + (CountCompiledCalls ? 6 : 0);
   }
   // In order to tune these parameters, run the JVM with VM options
   // +PrintMiscellaneous and +WizardMode to see information about
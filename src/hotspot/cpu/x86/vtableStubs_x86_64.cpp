@@ -169,8 +169,13 @@ VtableStub* VtableStubs::create_itable_stub(int itable_index) {
   address npe_addr = __ pc();
   __ load_klass(recv_klass_reg, j_rarg0);
 
-  // Receiver subtype check against REFC.
+  // Receiver subtype check against REFC.  When the method is declared in
+  // REFC itself, the itable lookup below fails for exactly the receivers
+  // that fail this check, so the separate scan is skipped.
   // Destroys recv_klass_reg value.
+  Label L_refc_checked;
+  __ cmpptr(resolved_klass_reg, holder_klass_reg);
+  __ jcc(Assembler::equal, L_refc_checked);
   __ lookup_interface_method(// inputs: rec. class, interface
                              recv_klass_reg, resolved_klass_reg, noreg,
                              // outputs:  scan temp. reg1, scan temp. reg2
@@ -178,9 +183,11 @@ VtableStub* VtableStubs::create_itable_stub(int itable_index) {
                              L_no_such_interface,
                              /*return_method=*/false);
 
+  __ load_klass(recv_klass_reg, j_rarg0);   // restore recv_klass_reg
+  __ bind(L_refc_checked);
+
   // Get selected method from declaring class and itable index
   const Register method = rbx;
-  __ load_klass(recv_klass_reg, j_rarg0);   // restore recv_klass_reg
   __ lookup_interface_method(// inputs: rec. class, interface, itable index
                              recv_klass_reg, holder_klass_reg, itable_index,
                              // outputs: method, scan temp. reg
@@ -244,7 +251,7 @@ int VtableStub::pd_code_size_limit(bool is_vtable_stub) {
            (UseCompressedClassPointers ?  MacroAssembler::instr_size_for_decode_klass_not_null() : 0);
   } else {
     // Itable stub size
-    return (DebugVtables ? 512 : 140) + (CountCompiledCalls ? 13 : 0) +
+    return (DebugVtables ? 512 : 150) + (CountCompiledCalls ? 13 : 0) +
            (UseCompressedClassPointers ? 2 * MacroAssembler::instr_size_for_decode_klass_not_null() : 0);
   }
   // In order to tune these parameters, run the JVM with VM options
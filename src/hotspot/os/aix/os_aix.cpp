@@ -2543,6 +2543,18 @@ bool os::release_memory_special(char* base, size_t bytes) {
   return false;
 }
 
+bool os::resident_size_in_range(address start, size_t size, size_t* resident) {
+  return false;
+}
+
+bool os::huge_page_backed_size_in_range(address start, size_t size, size_t* backed) {
+  return false;
+}
+
+bool os::numa_node_residency(address start, size_t size, size_t* node_sizes, int node_count) {
+  return false;
+}
+
 size_t os::large_page_size() {
   return _large_page_size;
 }
@@ -73,6 +73,9 @@
 #include "utilities/growableArray.hpp"
 #include "utilities/macros.hpp"
 #include "utilities/vmError.hpp"
+#ifdef AMD64
+#include OS_CPU_HEADER_INLINE(os)
+#endif
 
 // put OS-includes here
 # include <sys/types.h>
@@ -1300,10 +1303,33 @@ void os::Linux::fast_thread_clock_init() {
   }
 }
 
-jlong os::javaTimeNanos() {
+#ifdef AMD64
+// Invariant TSC clock for javaTimeNanos(). The TSC and CLOCK_MONOTONIC are
+// sampled together once VM_Version has verified that the TSC is invariant
+// and synchronized. When the first sample is old enough to give a precise
+// tick rate, javaTimeNanos() switches to extrapolating from the TSC and
+// no longer goes through clock_gettime().
+enum TSCClockState {
+  tsc_clock_inactive,
+  tsc_clock_calibrating,
+  tsc_clock_busy,
+  tsc_clock_ready
+};
+
+static volatile int _tsc_clock_state = tsc_clock_inactive;
+static jlong  _tsc_clock_base_ticks = 0;
+static jlong  _tsc_clock_base_nanos = 0;
+static double _tsc_clock_nanos_per_tick = 0.0;
+
+// Length of the calibration interval. Any error in the measured rate shows
+// up as drift against CLOCK_MONOTONIC, so this is kept reasonably long.
+static const jlong tsc_clock_calibration_nanos = NANOSECS_PER_SEC;
+#endif // AMD64
+
+static jlong monotonic_clock_nanos() {
   if (os::supports_monotonic_clock()) {
     struct timespec tp;
-    int status = Linux::clock_gettime(CLOCK_MONOTONIC, &tp);
+    int status = os::Linux::clock_gettime(CLOCK_MONOTONIC, &tp);
     assert(status == 0, "gettime error");
     jlong result = jlong(tp.tv_sec) * (1000 * 1000 * 1000) + jlong(tp.tv_nsec);
     return result;
@@ -1316,6 +1342,60 @@ jlong os::javaTimeNanos() {
   }
 }
 
+void os::Linux::tsc_clock_init() {
+#ifdef AMD64
+  if (UseTSCForJavaTimeNanos && os::supports_monotonic_clock()) {
+    _tsc_clock_base_ticks = os::rdtsc();
+    _tsc_clock_base_nanos = monotonic_clock_nanos();
+    OrderAccess::release_store(&_tsc_clock_state, (int)tsc_clock_calibrating);
+  }
+#endif // AMD64
+}
+
+#ifdef AMD64
+static void tsc_clock_calibrate(jlong now) {
+  if (now - _tsc_clock_base_nanos < tsc_clock_calibration_nanos ||
+      Atomic::cmpxchg((int)tsc_clock_busy, &_tsc_clock_state, (int)tsc_clock_calibrating) != tsc_clock_calibrating) {
+    return;
+  }
+  jlong ticks = os::rdtsc();
+  jlong nanos = monotonic_clock_nanos();
+  jlong elapsed_ticks = ticks - _tsc_clock_base_ticks;
+  jlong elapsed_nanos = nanos - _tsc_clock_base_nanos;
+  double nanos_per_tick = elapsed_ticks > 0 ? (double)elapsed_nanos / (double)elapsed_ticks : 0.0;
+  // A rate outside 100 MHz .. 10 GHz means the TSC did not tick at a
+  // constant rate or was skewed between the CPUs that took the samples.
+  if (nanos_per_tick < 0.1 || nanos_per_tick > 10.0) {
+    log_info(os)("TSC clock calibration failed, javaTimeNanos uses clock_gettime");
+    OrderAccess::release_store(&_tsc_clock_state, (int)tsc_clock_inactive);
+    return;
+  }
+  // Rebase at the calibration point so that the switch is continuous.
+  _tsc_clock_base_ticks = ticks;
+  _tsc_clock_base_nanos = nanos;
+  _tsc_clock_nanos_per_tick = nanos_per_tick;
+  OrderAccess::release_store(&_tsc_clock_state, (int)tsc_clock_ready);
+  log_info(os)("TSC clock calibrated at %.3f MHz", 1000.0 / nanos_per_tick);
+}
+#endif // AMD64
+
+jlong os::javaTimeNanos() {
+#ifdef AMD64
+  int state = OrderAccess::load_acquire(&_tsc_clock_state);
+  if (state == tsc_clock_ready) {
+    return _tsc_clock_base_nanos +
+           (jlong)((double)(os::rdtsc() - _tsc_clock_base_ticks) * _tsc_clock_nanos_per_tick);
+  }
+  jlong result = monotonic_clock_nanos();
+  if (state == tsc_clock_calibrating) {
+    tsc_clock_calibrate(result);
+  }
+  return result;
+#else
+  return monotonic_clock_nanos();
+#endif // AMD64
+}
+
 void os::javaTimeNanos_info(jvmtiTimerInfo *info_ptr) {
   if (os::supports_monotonic_clock()) {
     info_ptr->max_value = ALL_64_BITS;
@@ -3875,6 +3955,84 @@ bool os::Linux::release_memory_special_impl(char* base, size_t bytes) {
   return res;
 }
 
+// Sums the AnonHugePages of the mappings in /proc/self/smaps that overlap
+// the range. The kernel reports huge pages per mapping only, so a mapping
+// that is partly outside the range contributes in proportion to the overlap.
+// Ranges smaller than a huge page cannot contain one and are not scanned.
+bool os::huge_page_backed_size_in_range(address start, size_t size, size_t* backed) {
+  static size_t huge_page_size = 0;
+  if (huge_page_size == 0) {
+    huge_page_size = Linux::find_large_page_size();
+  }
+  if (size < huge_page_size) {
+    *backed = 0;
+    return true;
+  }
+
+  FILE* fp = fopen("/proc/self/smaps", "r");
+  if (fp == NULL) {
+    return false;
+  }
+  const uintptr_t lo = (uintptr_t)start;
+  const uintptr_t hi = lo + size;
+  julong total = 0;
+  julong overlap = 0;        // bytes of the current mapping inside the range
+  julong mapping_size = 0;
+  bool line_start = true;
+  char line[512];
+  while (fgets(line, sizeof(line), fp) != NULL) {
+    // Long lines (mapping paths) are read in pieces; only look at line starts
+    bool at_start = line_start;
+    line_start = strchr(line, '\n') != NULL;
+    if (!at_start) {
+      continue;
+    }
+    unsigned long map_lo, map_hi;
+    julong kb;
+    if (sscanf(line, "%lx-%lx", &map_lo, &map_hi) == 2) {
+      mapping_size = map_hi - map_lo;
+      overlap = (map_hi > lo && map_lo < hi) ? MIN2((uintptr_t)map_hi, hi) - MAX2((uintptr_t)map_lo, lo) : 0;
+    } else if (overlap > 0 && sscanf(line, "AnonHugePages: " JULONG_FORMAT " kB", &kb) == 1 && kb > 0) {
+      julong huge = kb * K;
+      total += (overlap == mapping_size) ? huge
+                                         : MIN2(overlap, (julong)((double)huge * overlap / mapping_size));
+    }
+  }
+  fclose(fp);
+  *backed = (size_t)total;
+  return true;
+}
+
+// move_pages(2) without target nodes only reports the node each page is on
+// and does not fault in pages that are not present (those get -ENOENT).
+bool os::numa_node_residency(address start, size_t size, size_t* node_sizes, int node_count) {
+#ifdef SYS_move_pages
+  const size_t page_sz = os::vm_page_size();
+  const int batch = 256;
+  void* pages[batch];
+  int status[batch];
+  address p = align_down(start, page_sz);
+  const address end = start + size;
+  while (p < end) {
+    int n = 0;
+    for (; n < batch && p < end; n++, p += page_sz) {
+      pages[n] = p;
+    }
+    if (syscall(SYS_move_pages, 0, (unsigned long)n, pages, NULL, status, 0) != 0) {
+      return false;
+    }
+    for (int i = 0; i < n; i++) {
+      if (status[i] >= 0 && status[i] < node_count) {
+        node_sizes[status[i]] += page_sz;
+      }
+    }
+  }
+  return true;
+#else
+  return false;
+#endif
+}
+
 size_t os::large_page_size() {
   return _large_page_size;
 }
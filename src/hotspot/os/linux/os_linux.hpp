@@ -195,6 +195,9 @@ class Linux {
   // fast POSIX clocks support
   static void fast_thread_clock_init(void);
 
+  // TSC based javaTimeNanos() support, set up after VM_Version
+  static void tsc_clock_init(void);
+
   static int clock_gettime(clockid_t clock_id, struct timespec *tp) {
     return _clock_gettime ? _clock_gettime(clock_id, tp) : -1;
   }
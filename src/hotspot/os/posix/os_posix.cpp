@@ -408,6 +408,41 @@ void os::Posix::print_rlimit_info(outputStream* st) {
   st->cr();
 }
 
+#if defined(LINUX) || defined(BSD)
+// Uses mincore(2) to count the resident pages in the range; the range is
+// examined in chunks so the residency vector can live on the stack.
+bool os::resident_size_in_range(address start, size_t size, size_t* resident) {
+  const size_t page_sz = os::vm_page_size();
+  const size_t chunk_pages = 1024;
+#ifdef LINUX
+  unsigned char vec[chunk_pages];
+#else
+  char vec[chunk_pages];
+#endif
+  address cur = align_down(start, page_sz);
+  address end = align_up(start + size, page_sz);
+  size_t res = 0;
+  while (cur < end) {
+    size_t pages = MIN2(chunk_pages, (size_t)pointer_delta(end, cur, page_sz));
+    if (::mincore((void*)cur, pages * page_sz, vec) != 0) {
+      if (errno != ENOMEM) {
+        return false;
+      }
+      // Part of the chunk is not mapped; treat it as not resident.
+    } else {
+      for (size_t i = 0; i < pages; i++) {
+        if ((vec[i] & 1) != 0) {
+          res += page_sz;
+        }
+      }
+    }
+    cur += pages * page_sz;
+  }
+  *resident = res;
+  return true;
+}
+#endif // LINUX || BSD
+
 void os::Posix::print_uname_info(outputStream* st) {
   // kernel
   st->print("uname:");
@@ -1977,6 +2012,12 @@ void Parker::park(bool isAbsolute, jlong time) {
     to_abstime(&absTime, time, isAbsolute);
   }
 
+  // An unpark that arrives shortly is cheaper to catch by spinning
+  // than by blocking on the condvar.
+  if (spin_for_permit(jt)) {
+    return;
+  }
+
   // Enter safepoint region
   // Beware of deadlocks such as 6317397.
   // The per-thread Parker:: mutex is a classic leaf-lock.
@@ -3049,6 +3049,18 @@ char* os::pd_attempt_reserve_memory_at(size_t bytes, char* requested_addr, int f
   return map_memory_to_file(requested_addr, bytes, file_desc);
 }
 
+bool os::resident_size_in_range(address start, size_t size, size_t* resident) {
+  return false;
+}
+
+bool os::huge_page_backed_size_in_range(address start, size_t size, size_t* backed) {
+  return false;
+}
+
+bool os::numa_node_residency(address start, size_t size, size_t* node_sizes, int node_count) {
+  return false;
+}
+
 size_t os::large_page_size() {
   return _large_page_size;
 }
@@ -4074,6 +4074,9 @@ int MatchRule::is_expensive() const {
         strcmp(opType,"MulReductionVL")==0 ||
         strcmp(opType,"MulReductionVF")==0 ||
         strcmp(opType,"MulReductionVD")==0 ||
+        strcmp(opType,"AndReductionVI")==0 ||
+        strcmp(opType,"OrReductionVI")==0 ||
+        strcmp(opType,"XorReductionVI")==0 ||
         0 /* 0 to line up columns nicely */ )
       return 1;
   }
@@ -4174,6 +4177,7 @@ bool MatchRule::is_vector() const {
     "AddReductionVF", "AddReductionVD",
     "MulReductionVI", "MulReductionVL",
     "MulReductionVF", "MulReductionVD",
+    "AndReductionVI", "OrReductionVI", "XorReductionVI",
     "LShiftCntV","RShiftCntV",
     "LShiftVB","LShiftVS","LShiftVI","LShiftVL",
     "RShiftVB","RShiftVS","RShiftVI","RShiftVL",
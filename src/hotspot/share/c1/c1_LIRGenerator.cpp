@@ -1462,6 +1462,9 @@ void LIRGenerator::pre_barrier(LIR_Opr addr_opr, LIR_Opr pre_val,
     case BarrierSet::G1BarrierSet:
       G1SATBCardTableModRef_pre_barrier(addr_opr, pre_val, do_load, patch, info);
       break;
+    case BarrierSet::EpsilonBarrierSet:
+      // No barriers
+      break;
 #endif // INCLUDE_ALL_GCS
     case BarrierSet::CardTableModRef:
       // No pre barriers
@@ -1478,6 +1481,9 @@ void LIRGenerator::post_barrier(LIR_OprDesc* addr, LIR_OprDesc* new_val) {
     case BarrierSet::G1BarrierSet:
       G1SATBCardTableModRef_post_barrier(addr,  new_val);
       break;
+    case BarrierSet::EpsilonBarrierSet:
+      // No barriers
+      break;
 #endif // INCLUDE_ALL_GCS
     case BarrierSet::CardTableModRef:
       CardTableModRef_post_barrier(addr,  new_val);
@@ -1626,6 +1632,38 @@ void LIRGenerator::CardTableModRef_post_barrier(LIR_OprDesc* addr, LIR_OprDesc*
   }
   assert(addr->is_register(), "must be a register at this point");
 
+  CardTableModRefBS* ctbs = barrier_set_cast<CardTableModRefBS>(_bs);
+  LabelObj* L_filtered = NULL;
+  if (ctbs->can_filter_card_marks()) {
+    if (new_val->is_constant() && new_val->as_constant_ptr()->as_jobject() == NULL) {
+      return;
+    }
+    // Only a store of a young object into an old object needs the
+    // card: skip stores into the young generation and stores of old
+    // objects.  See GraphKit::write_barrier_post.
+    L_filtered = new LabelObj();
+    LIR_Opr boundary = new_pointer_register();
+    __ move(LIR_OprFact::intptrConst(ctbs->young_gen_boundary()), boundary);
+    if (!new_val->is_register()) {
+      LIR_Opr new_val_reg = new_register(T_OBJECT);
+      if (new_val->is_constant()) {
+        __ move(new_val, new_val_reg);
+      } else {
+        __ leal(new_val, new_val_reg);
+      }
+      new_val = new_val_reg;
+    }
+    LIR_Opr val = new_pointer_register();
+    __ move(new_val, val);
+    bool young_above = ctbs->young_gen_above_boundary();
+    LIR_Condition in_young = young_above ? lir_cond_greaterEqual : lir_cond_less;
+    LIR_Condition in_old   = young_above ? lir_cond_less : lir_cond_greaterEqual;
+    __ cmp(in_young, addr, boundary);
+    __ branch(in_young, LP64_ONLY(T_LONG) NOT_LP64(T_INT), L_filtered->label());
+    __ cmp(in_old, val, boundary);
+    __ branch(in_old, LP64_ONLY(T_LONG) NOT_LP64(T_INT), L_filtered->label());
+  }
+
 #ifdef CARDTABLEMODREF_POST_BARRIER_HELPER
   CardTableModRef_post_barrier_helper(addr, card_table_base);
 #else
@@ -1664,6 +1702,10 @@ void LIRGenerator::CardTableModRef_post_barrier(LIR_OprDesc* addr, LIR_OprDesc*
     __ move(dirty, card_addr);
   }
 #endif
+
+  if (L_filtered != NULL) {
+    __ branch_destination(L_filtered->label());
+  }
 }
 
 
@@ -3502,10 +3544,29 @@ void LIRGenerator::increment_event_counter_impl(CodeEmitInfo* info,
   } else {
     ShouldNotReachHere();
   }
+  int step = 1;
+  LabelObj* L_skip = NULL;
+  if (level == CompLevel_full_profile && C1ProfileCounterSampleLog > 0) {
+    // Only every step-th event of this thread updates the shared MDO counter,
+    // by step events at a time.
+    step = 1 << C1ProfileCounterSampleLog;
+    L_skip = new LabelObj();
+    LIR_Address* sample_addr = new LIR_Address(getThreadPointer(),
+                                               in_bytes(JavaThread::profile_sample_counter_offset()),
+                                               T_INT);
+    LIR_Opr sample = new_register(T_INT);
+    __ load(sample_addr, sample);
+    __ add(sample, LIR_OprFact::intConst(1), sample);
+    __ store(sample, sample_addr);
+    LIR_Opr sample_mask = load_immediate(step - 1, T_INT);
+    __ logical_and(sample, sample_mask, sample);
+    __ cmp(lir_cond_notEqual, sample, LIR_OprFact::intConst(0));
+    __ branch(lir_cond_notEqual, T_INT, L_skip->label());
+  }
   LIR_Address* counter = new LIR_Address(counter_holder, offset, T_INT);
   LIR_Opr result = new_register(T_INT);
   __ load(counter, result);
-  __ add(result, LIR_OprFact::intConst(InvocationCounter::count_increment), result);
+  __ add(result, LIR_OprFact::intConst(InvocationCounter::count_increment * step), result);
   __ store(result, counter);
   if (notify && (!backedge || UseOnStackReplacement)) {
     LIR_Opr meth = LIR_OprFact::metadataConst(method->constant_encoding());
@@ -3517,11 +3578,21 @@ void LIRGenerator::increment_event_counter_impl(CodeEmitInfo* info,
     } else {
       LIR_Opr mask = load_immediate(freq, T_INT);
       __ logical_and(result, mask, result);
-      __ cmp(lir_cond_equal, result, LIR_OprFact::intConst(0));
-      __ branch(lir_cond_equal, T_INT, overflow);
+      if (step == 1) {
+        __ cmp(lir_cond_equal, result, LIR_OprFact::intConst(0));
+        __ branch(lir_cond_equal, T_INT, overflow);
+      } else {
+        // The counter moves in steps and may jump over the exact multiple
+        // of the frequency, so notify whenever the last step crossed one.
+        __ cmp(lir_cond_less, result, LIR_OprFact::intConst(InvocationCounter::count_increment * step));
+        __ branch(lir_cond_less, T_INT, overflow);
+      }
     }
     __ branch_destination(overflow->continuation());
   }
+  if (L_skip != NULL) {
+    __ branch_destination(L_skip->label());
+  }
 }
 
 void LIRGenerator::do_RuntimeCall(RuntimeCall* x) {
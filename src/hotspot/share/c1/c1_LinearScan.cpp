@@ -1579,25 +1579,36 @@ void LinearScan::sort_intervals_before_allocation() {
 
   // special sorting algorithm: the original interval-list is almost sorted,
   // only some intervals are swapped. So this is much faster than a complete QuickSort
+  int out_of_order = 0;
   for (unsorted_idx = 0; unsorted_idx < unsorted_len; unsorted_idx++) {
     Interval* cur_interval = unsorted_list->at(unsorted_idx);
 
     if (cur_interval != NULL) {
-      int cur_from = cur_interval->from();
-
-      if (sorted_from_max <= cur_from) {
-        sorted_list->at_put(sorted_idx++, cur_interval);
+      sorted_list->at_put(sorted_idx++, cur_interval);
+      if (sorted_from_max <= cur_interval->from()) {
         sorted_from_max = cur_interval->from();
       } else {
-        // the asumption that the intervals are already sorted failed,
-        // so this interval must be sorted in manually
+        out_of_order++;
+      }
+    }
+  }
+
+  if (out_of_order > 0) {
+    // Each misplaced interval may have to be moved across the whole list, so
+    // insertion is only cheaper than a complete QuickSort if there are few of
+    // them. Huge methods can have many, which made this step quadratic.
+    if (out_of_order <= log2_intptr(sorted_len)) {
+      for (sorted_idx = 1; sorted_idx < sorted_len; sorted_idx++) {
+        Interval* cur_interval = sorted_list->at(sorted_idx);
+        int cur_from = cur_interval->from();
         int j;
         for (j = sorted_idx - 1; j >= 0 && cur_from < sorted_list->at(j)->from(); j--) {
           sorted_list->at_put(j + 1, sorted_list->at(j));
         }
         sorted_list->at_put(j + 1, cur_interval);
-        sorted_idx++;
       }
+    } else {
+      sorted_list->sort(interval_cmp);
     }
   }
   _sorted_intervals = sorted_list;
@@ -321,6 +321,13 @@
   product(bool, C1UpdateMethodData, trueInTiered,                           \
           "Update MethodData*s in Tier1-generated code")                    \
                                                                             \
+  product(intx, C1ProfileCounterSampleLog, 0,                               \
+          "Update the invocation and backedge counters of MDOs from "       \
+          "profiled code only on every 2^n-th event of a thread, adding "   \
+          "2^n at a time, to reduce cache line contention on hot MDOs. "    \
+          "0 updates the counters on every event")                          \
+          range(0, 10)                                                      \
+                                                                            \
   develop(bool, PrintCFGToFile, false,                                      \
           "print control flow graph to a separate file during compilation") \
                                                                             \
@@ -1229,8 +1229,12 @@ void ciEnv::dump_replay_data_unsafe(outputStream* out) {
   out->print_cr("JvmtiExport can_post_on_exceptions %d",         _jvmti_can_post_on_exceptions);
 #endif // INCLUDE_JVMTI
 
+  GrowableArray<ciMetadata*>* shared = ciObjectFactory::get_shared_ci_metadata();
   GrowableArray<ciMetadata*>* objects = _factory->get_ci_metadata();
-  out->print_cr("# %d ciObject found", objects->length());
+  out->print_cr("# %d ciObject found", shared->length() + objects->length());
+  for (int i = 0; i < shared->length(); i++) {
+    shared->at(i)->dump_replay_data(out);
+  }
   for (int i = 0; i < objects->length(); i++) {
     objects->at(i)->dump_replay_data(out);
   }
@@ -511,10 +511,13 @@ ciCallProfile ciMethod::call_profile_at_bci(int bci) {
         // The call site count is 0 with known morphism (only 1 or 2 receivers)
         // or < 0 in the case of a type check failure for checkcast, aastore, instanceof.
         // The call site count is > 0 in the case of a polymorphic virtual call.
+        // The morphism is known only if all rows were not needed or no
+        // receiver missed the rows.
+        int row_limit = MIN2((int)call->row_limit(), (int)ciCallProfile::MorphismLimit);
         if (morphism > 0 && morphism == result._limit) {
            // The morphism <= MorphismLimit.
-           if ((morphism <  ciCallProfile::MorphismLimit) ||
-               (morphism == ciCallProfile::MorphismLimit && count == 0)) {
+           if ((morphism <  row_limit) ||
+               (morphism == row_limit && count == 0)) {
 #ifdef ASSERT
              if (count > 0) {
                this->print_short_name(tty);
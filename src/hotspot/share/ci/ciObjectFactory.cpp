@@ -83,14 +83,11 @@ ciObjectFactory::ciObjectFactory(Arena* arena,
 
   _next_ident = _shared_ident_limit;
   _arena = arena;
+  // The shared ci objects are not copied in; get_metadata() looks them up
+  // in _shared_ci_metadata first, so each compilation starts empty and its
+  // sorted array only ever holds the metadata it actually touches.
   _ci_metadata = new (arena) GrowableArray<ciMetadata*>(arena, expected_size, 0, NULL);
 
-  // If the shared ci objects exist append them to this factory's objects
-
-  if (_shared_ci_metadata != NULL) {
-    _ci_metadata->appendAll(_shared_ci_metadata);
-  }
-
   _unloaded_methods = new (arena) GrowableArray<ciMethod*>(arena, 4, 0, NULL);
   _unloaded_klasses = new (arena) GrowableArray<ciKlass*>(arena, 8, 0, NULL);
   _unloaded_instances = new (arena) GrowableArray<ciInstance*>(arena, 4, 0, NULL);
@@ -283,8 +280,15 @@ ciMetadata* ciObjectFactory::get_metadata(Metadata* key) {
     }
   }
 #endif // ASSERT
-  int len = _ci_metadata->length();
   bool found = false;
+  if (_shared_ci_metadata != NULL) {
+    // The shared objects are immutable once initialize() has run.
+    int index = _shared_ci_metadata->find_sorted<Metadata*, ciObjectFactory::metadata_compare>(key, found);
+    if (found) {
+      return _shared_ci_metadata->at(index)->as_metadata();
+    }
+  }
+  int len = _ci_metadata->length();
   int index = _ci_metadata->find_sorted<Metadata*, ciObjectFactory::metadata_compare>(key, found);
 #ifdef ASSERT
   if (CIObjectFactoryVerify) {
@@ -672,6 +676,11 @@ ciSymbol* ciObjectFactory::vm_symbol_at(int index) {
 // ciObjectFactory::metadata_do
 void ciObjectFactory::metadata_do(void f(Metadata*)) {
   if (_ci_metadata == NULL) return;
+  if (_shared_ci_metadata != NULL && _shared_ci_metadata != _ci_metadata) {
+    for (int j = 0; j < _shared_ci_metadata->length(); j++) {
+      f(_shared_ci_metadata->at(j)->constant_encoding());
+    }
+  }
   for (int j = 0; j< _ci_metadata->length(); j++) {
     Metadata* o = _ci_metadata->at(j)->constant_encoding();
     f(o);
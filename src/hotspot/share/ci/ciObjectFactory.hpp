@@ -138,6 +138,8 @@ public:
   ciReturnAddress* get_return_address(int bci);
 
   GrowableArray<ciMetadata*>* get_ci_metadata() const { return _ci_metadata; }
+  // Metadata wrapped once at startup and shared by all compilations
+  static GrowableArray<ciMetadata*>* get_shared_ci_metadata() { return _shared_ci_metadata; }
   // RedefineClasses support
   void metadata_do(void f(Metadata*));
 
@@ -58,6 +58,7 @@
 #include "oops/symbol.hpp"
 #include "prims/jvmtiExport.hpp"
 #include "prims/jvmtiThreadState.hpp"
+#include "runtime/fieldType.hpp"
 #include "runtime/javaCalls.hpp"
 #include "runtime/perfData.hpp"
 #include "runtime/reflection.hpp"
@@ -3683,7 +3684,6 @@ static unsigned int compute_oop_map_count(const InstanceKlass* super,
   return map_count;
 }
 
-#ifndef PRODUCT
 static void print_field_layout(const Symbol* name,
                                Array<u2>* fields,
                                const constantPoolHandle& cp,
@@ -3718,7 +3718,28 @@ static void print_field_layout(const Symbol* name,
   tty->print("  @%3d %s\n", static_fields_end, "--- static fields end ---");
   tty->print("\n");
 }
-#endif
+
+// Returns the end of the nonstatic fields laid out by 'super' and its
+// superclasses, if it lies below 'fields_start' by less than an oop size.
+// Such a trailing hole only comes from alignment of the superclass field
+// block and can be reused by subclass fields. Larger holes are contended
+// padding, so 'fields_start' is returned for them.
+static int super_fields_end(const InstanceKlass* super, int fields_start) {
+  for (const InstanceKlass* k = super; k != NULL; k = k->java_super()) {
+    int end = -1;
+    for (AllFieldStream fs(const_cast<InstanceKlass*>(k)); !fs.done(); fs.next()) {
+      if (fs.access_flags().is_static()) continue;
+      const BasicType type = FieldType::basic_type(fs.signature());
+      const int size = is_reference_type(type) ? heapOopSize : type2aelembytes(type);
+      end = MAX2(end, fs.offset() + size);
+    }
+    if (end >= 0) {
+      assert(end <= fields_start, "superclass fields overlap subclass fields");
+      return (fields_start - end < heapOopSize) ? end : fields_start;
+    }
+  }
+  return fields_start;
+}
 
 // Values needed for oopmap and InstanceKlass creation
 class ClassFileParser::FieldLayoutInfo : public ResourceObj {
@@ -3906,44 +3927,53 @@ void ClassFileParser::layout_fields(ConstantPool* cp,
   int nonstatic_short_space_offset = 0;
   int nonstatic_byte_space_offset = 0;
 
-  // Try to squeeze some of the fields into the gaps due to
-  // long/double alignment.
+  // The superclass field block may end below the heapOopSize aligned
+  // start of our fields. Reuse that hole unless oops go first or the
+  // class is contended, in which case it is followed by padding.
+  int gap_start = next_nonstatic_double_offset;
+  if (compact_fields && allocation_style == 1 && !is_contended_class &&
+      next_nonstatic_double_offset == nonstatic_fields_start) {
+    gap_start = super_fields_end(_super_klass, nonstatic_fields_start);
+  }
   if (nonstatic_double_count > 0) {
+    next_nonstatic_double_offset = align_up(next_nonstatic_double_offset, BytesPerLong);
+  }
+
+  // Try to squeeze some of the fields into the gaps due to superclass
+  // and long/double alignment. Ints and shorts are placed from the end
+  // of the gap, which is int aligned, and bytes from its start.
+  if (compact_fields && gap_start != next_nonstatic_double_offset) {
     int offset = next_nonstatic_double_offset;
-    next_nonstatic_double_offset = align_up(offset, BytesPerLong);
-    if (compact_fields && offset != next_nonstatic_double_offset) {
-      // Allocate available fields into the gap before double field.
-      int length = next_nonstatic_double_offset - offset;
-      assert(length == BytesPerInt, "");
-      nonstatic_word_space_offset = offset;
-      if (nonstatic_word_count > 0) {
-        nonstatic_word_count      -= 1;
-        nonstatic_word_space_count = 1; // Only one will fit
-        length -= BytesPerInt;
-        offset += BytesPerInt;
-      }
-      nonstatic_short_space_offset = offset;
-      while (length >= BytesPerShort && nonstatic_short_count > 0) {
-        nonstatic_short_count       -= 1;
-        nonstatic_short_space_count += 1;
-        length -= BytesPerShort;
-        offset += BytesPerShort;
-      }
-      nonstatic_byte_space_offset = offset;
-      while (length > 0 && nonstatic_byte_count > 0) {
-        nonstatic_byte_count       -= 1;
-        nonstatic_byte_space_count += 1;
-        length -= 1;
-      }
-      // Allocate oop field in the gap if there are no other fields for that.
+    int length = offset - gap_start;
+    assert(is_aligned(offset, BytesPerInt), "gap end must be int aligned");
+    while (length >= BytesPerInt && nonstatic_word_count > 0) {
+      nonstatic_word_count       -= 1;
+      nonstatic_word_space_count += 1;
+      length -= BytesPerInt;
+      offset -= BytesPerInt;
+    }
+    nonstatic_word_space_offset = offset;
+    while (length >= BytesPerShort && nonstatic_short_count > 0) {
+      nonstatic_short_count       -= 1;
+      nonstatic_short_space_count += 1;
+      length -= BytesPerShort;
+      offset -= BytesPerShort;
+    }
+    nonstatic_short_space_offset = offset;
+    nonstatic_byte_space_offset = gap_start;
+    while (length > 0 && nonstatic_byte_count > 0) {
+      nonstatic_byte_count       -= 1;
+      nonstatic_byte_space_count += 1;
+      length -= 1;
+    }
+    // Allocate oop field in the gap if there are no other fields for that.
+    if (length >= heapOopSize && nonstatic_oop_count > 0 &&
+        is_aligned(offset, heapOopSize) &&
+        allocation_style != 0) { // when oop fields not first
+      nonstatic_oop_count      -= 1;
+      nonstatic_oop_space_count = 1; // Only one will fit
+      offset -= heapOopSize;
       nonstatic_oop_space_offset = offset;
-      if (length >= heapOopSize && nonstatic_oop_count > 0 &&
-          allocation_style != 0) { // when oop fields not first
-        nonstatic_oop_count      -= 1;
-        nonstatic_oop_space_count = 1; // Only one will fit
-        length -= heapOopSize;
-        offset += heapOopSize;
-      }
     }
   }
 
@@ -4229,7 +4259,6 @@ void ClassFileParser::layout_fields(ConstantPool* cp,
     compute_oop_map_count(_super_klass, nonstatic_oop_map_count,
                           first_nonstatic_oop_offset);
 
-#ifndef PRODUCT
   if (PrintFieldLayout) {
     print_field_layout(_class_name,
           _fields,
@@ -4240,7 +4269,6 @@ void ClassFileParser::layout_fields(ConstantPool* cp,
           static_fields_end);
   }
 
-#endif
   // Pass back information needed for InstanceKlass creation
   info->nonstatic_oop_offsets = nonstatic_oop_offsets;
   info->nonstatic_oop_counts = nonstatic_oop_counts;
@@ -57,6 +57,7 @@
 #include "oops/symbol.hpp"
 #include "prims/jvm_misc.hpp"
 #include "runtime/arguments.hpp"
+#include "runtime/atomic.hpp"
 #include "runtime/compilationPolicy.hpp"
 #include "runtime/handles.hpp"
 #include "runtime/handles.inline.hpp"
@@ -64,6 +65,7 @@
 #include "runtime/interfaceSupport.hpp"
 #include "runtime/java.hpp"
 #include "runtime/javaCalls.hpp"
+#include "runtime/orderAccess.inline.hpp"
 #include "runtime/os.hpp"
 #include "runtime/threadCritical.hpp"
 #include "runtime/timer.hpp"
@@ -85,6 +87,7 @@ typedef void (JNICALL *ZipClose_t)(jzfile *zip);
 typedef jzentry* (JNICALL *FindEntry_t)(jzfile *zip, const char *name, jint *sizeP, jint *nameLen);
 typedef jboolean (JNICALL *ReadEntry_t)(jzfile *zip, jzentry *entry, unsigned char *buf, char *namebuf);
 typedef jzentry* (JNICALL *GetNextEntry_t)(jzfile *zip, jint n);
+typedef void     (JNICALL *FreeEntry_t)(jzfile *zip, jzentry *entry);
 typedef jboolean (JNICALL *ZipInflateFully_t)(void *inBuf, jlong inLen, void *outBuf, jlong outLen, char **pmsg);
 typedef jint     (JNICALL *Crc32_t)(jint crc, const jbyte *buf, jint len);
 
@@ -93,6 +96,7 @@ static ZipClose_t        ZipClose           = NULL;
 static FindEntry_t       FindEntry          = NULL;
 static ReadEntry_t       ReadEntry          = NULL;
 static GetNextEntry_t    GetNextEntry       = NULL;
+static FreeEntry_t       FreeEntry          = NULL;
 static canonicalize_fn_t CanonicalizeEntry  = NULL;
 static ZipInflateFully_t ZipInflateFully    = NULL;
 static Crc32_t           Crc32              = NULL;
@@ -311,6 +315,7 @@ ClassPathZipEntry::ClassPathZipEntry(jzfile* zip, const char* zip_name, bool is_
   _zip_name = copy;
   _is_boot_append = is_boot_append;
   _multi_versioned = _unknown;
+  _package_filter = NULL;
 }
 
 ClassPathZipEntry::~ClassPathZipEntry() {
@@ -318,9 +323,65 @@ ClassPathZipEntry::~ClassPathZipEntry() {
     (*ZipClose)(_zip);
   }
   FREE_C_HEAP_ARRAY(char, _zip_name);
+  if (_package_filter != NULL) {
+    FREE_C_HEAP_ARRAY(uintptr_t, _package_filter);
+  }
+}
+
+// Hash of the directory part of an entry name, i.e. everything up to the
+// last '/'. Entries in the root of the archive all hash to 0.
+static unsigned int zip_directory_hash(const char* name) {
+  const char* last_slash = strrchr(name, '/');
+  unsigned int h = 0;
+  if (last_slash != NULL) {
+    for (const char* p = name; p < last_slash; p++) {
+      h = 31 * h + (unsigned char)*p;
+    }
+  }
+  return h;
+}
+
+// Record the directory of every entry in a bitmap, so that lookups for
+// packages this archive doesn't contain return without calling into the
+// zip library. With a long class path most lookups are misses. The filter
+// is only built after the first miss, so archives that satisfy every
+// lookup never pay for the scan.
+void ClassPathZipEntry::build_package_filter() {
+  const size_t words = package_filter_bits / BitsPerWord;
+  uintptr_t* filter = NEW_C_HEAP_ARRAY(uintptr_t, words, mtClass);
+  memset(filter, 0, words * sizeof(uintptr_t));
+  {
+    JavaThread* thread = JavaThread::current();
+    ThreadToNativeFromVM ttn(thread);
+    for (int n = 0; ; n++) {
+      jzentry* ze = (*GetNextEntry)(_zip, n);
+      if (ze == NULL) break;
+      unsigned int bit = zip_directory_hash(ze->name) % package_filter_bits;
+      filter[bit / BitsPerWord] |= (uintptr_t)1 << (bit % BitsPerWord);
+      if (FreeEntry != NULL) {
+        (*FreeEntry)(_zip, ze);
+      }
+    }
+  }
+  if (Atomic::cmpxchg(filter, &_package_filter, (uintptr_t*)NULL) != NULL) {
+    // Another thread built the filter first
+    FREE_C_HEAP_ARRAY(uintptr_t, filter);
+  }
+}
+
+bool ClassPathZipEntry::may_contain(const char* name) const {
+  const uintptr_t* filter = OrderAccess::load_acquire(&_package_filter);
+  if (filter == NULL) {
+    return true;
+  }
+  unsigned int bit = zip_directory_hash(name) % package_filter_bits;
+  return (filter[bit / BitsPerWord] & ((uintptr_t)1 << (bit % BitsPerWord))) != 0;
 }
 
 u1* ClassPathZipEntry::open_entry(const char* name, jint* filesize, bool nul_terminate, TRAPS) {
+  if (!may_contain(name)) {
+    return NULL;
+  }
     // enable call to C land
   JavaThread* thread = JavaThread::current();
   ThreadToNativeFromVM ttn(thread);
@@ -436,6 +497,9 @@ ClassFileStream* ClassPathZipEntry::open_stream(const char* name, TRAPS) {
   if (buffer == NULL) {
     buffer = open_entry(name, &filesize, false, CHECK_NULL);
     if (buffer == NULL) {
+      if (_package_filter == NULL) {
+        build_package_filter();
+      }
       return NULL;
     }
   }
@@ -1158,6 +1222,7 @@ void ClassLoader::load_zip_library() {
   FindEntry    = CAST_TO_FN_PTR(FindEntry_t, os::dll_lookup(handle, "ZIP_FindEntry"));
   ReadEntry    = CAST_TO_FN_PTR(ReadEntry_t, os::dll_lookup(handle, "ZIP_ReadEntry"));
   GetNextEntry = CAST_TO_FN_PTR(GetNextEntry_t, os::dll_lookup(handle, "ZIP_GetNextEntry"));
+  FreeEntry    = CAST_TO_FN_PTR(FreeEntry_t, os::dll_lookup(handle, "ZIP_FreeEntry"));
   ZipInflateFully = CAST_TO_FN_PTR(ZipInflateFully_t, os::dll_lookup(handle, "ZIP_InflateFully"));
   Crc32        = CAST_TO_FN_PTR(Crc32_t, os::dll_lookup(handle, "ZIP_CRC32"));
 
@@ -1705,6 +1770,30 @@ jlong ClassLoader::class_link_time_ms() {
     Management::ticks_to_ms(_perf_class_link_time->get_value()) : -1;
 }
 
+void ClassLoader::print_counters(outputStream* st) {
+  if (!UsePerfData) {
+    st->print_cr("ClassLoader: per-phase times require -XX:+UsePerfData");
+    return;
+  }
+  st->print_cr("ClassLoader: " JLONG_FORMAT " ms total", classloader_time_ms());
+  st->print_cr("  parse:  " JLONG_FORMAT " ms (self " JLONG_FORMAT " ms)",
+               Management::ticks_to_ms(_perf_class_parse_time->get_value()),
+               Management::ticks_to_ms(_perf_class_parse_selftime->get_value()));
+  st->print_cr("  link:   " JLONG_FORMAT " classes, " JLONG_FORMAT " ms (self " JLONG_FORMAT " ms)",
+               class_link_count(), class_link_time_ms(),
+               Management::ticks_to_ms(_perf_class_link_selftime->get_value()));
+  st->print_cr("  verify: " JLONG_FORMAT " classes, " JLONG_FORMAT " ms (self " JLONG_FORMAT " ms)",
+               _perf_classes_verified->get_value(), class_verify_time_ms(),
+               Management::ticks_to_ms(_perf_class_verify_selftime->get_value()));
+  st->print_cr("  init:   " JLONG_FORMAT " classes, " JLONG_FORMAT " ms (self " JLONG_FORMAT " ms)",
+               class_init_count(), class_init_time_ms(),
+               Management::ticks_to_ms(_perf_class_init_selftime->get_value()));
+  st->print_cr("  boot loader: lookup " JLONG_FORMAT " ms, shared " JLONG_FORMAT " ms, load " JLONG_FORMAT " ms",
+               Management::ticks_to_ms(_perf_sys_class_lookup_time->get_value()),
+               Management::ticks_to_ms(_perf_shared_classload_time->get_value()),
+               Management::ticks_to_ms(_perf_sys_classload_time->get_value()));
+}
+
 int ClassLoader::compute_Object_vtable() {
   // hardwired for JDK1.2 -- would need to duplicate class file parsing
   // code to determine actual value from file
@@ -99,12 +99,20 @@ class ClassPathZipEntry: public ClassPathEntry {
    _yes     = 1,
    _no      = 2
  };
+ enum {
+   package_filter_bits = 4096 // bits in the directory name filter
+ };
  private:
   jzfile* _zip;              // The zip archive
   const char*   _zip_name;   // Name of zip archive
   bool _is_boot_append;      // entry coming from -Xbootclasspath/a
   u1 _multi_versioned;       // indicates if the jar file has multi-versioned entries.
                              // It can have value of "_unknown", "_yes", or "_no"
+  uintptr_t* volatile _package_filter; // bitmap of hashed entry directory names,
+                                       // NULL until the first lookup miss
+
+  void build_package_filter();
+  bool may_contain(const char* name) const;
  public:
   bool is_modules_image() const { return false; }
   bool is_jar_file() const { return true;  }
@@ -431,6 +439,9 @@ class ClassLoader: AllStatic {
   static jlong class_link_count();
   static jlong class_link_time_ms();
 
+  // Per-phase breakdown (parse/link/verify/init) of class loading time
+  static void print_counters(outputStream* st);
+
   // indicates if class path already contains a entry (exact match by name)
   static bool contains_append_entry(const char* name);
 
@@ -585,6 +585,25 @@ ModuleEntryTable* ClassLoaderData::modules() {
   return modules;
 }
 
+// The boot loader's package table is created long before the CDS archive is
+// mapped. Once the archive tells how many packages the boot layer defined at
+// dump time, swap the still empty table for one with matching bucket count
+// so that module system initialization and package lookups during class
+// loading do not walk long chains.
+void ClassLoaderData::presize_packages(int expected_packages) {
+  assert(is_the_null_class_loader_data(), "only the boot loader's packages are archived");
+  assert(_packages->number_of_entries() == 0, "packages must not be defined yet");
+  static const int sizes[] = { PackageEntryTable::_packagetable_entry_size, 257, 509, 1021, 2039 };
+  int size = sizes[0];
+  for (size_t i = 1; i < ARRAY_SIZE(sizes) && size < expected_packages; i++) {
+    size = sizes[i];
+  }
+  if (size != _packages->table_size()) {
+    delete _packages;
+    _packages = new PackageEntryTable(size);
+  }
+}
+
 const int _boot_loader_dictionary_size    = 1009;
 const int _default_loader_dictionary_size = 107;
 
@@ -1217,7 +1236,8 @@ bool ClassLoaderDataGraph::contains_loader_data(ClassLoaderData* loader_data) {
 // Move class loader data from main list to the unloaded list for unloading
 // and deallocation later.
 bool ClassLoaderDataGraph::do_unloading(BoolObjectClosure* is_alive_closure,
-                                        bool clean_previous_versions) {
+                                        bool clean_previous_versions,
+                                        bool clean_alive_loaders) {
 
   ClassLoaderData* data = _head;
   ClassLoaderData* prev = NULL;
@@ -1266,26 +1286,9 @@ bool ClassLoaderDataGraph::do_unloading(BoolObjectClosure* is_alive_closure,
   }
 
   if (seen_dead_loader) {
-    data = _head;
-    while (data != NULL) {
-      // Remove entries in the dictionary of live class loader that have
-      // initiated loading classes in a dead class loader.
-      if (data->dictionary() != NULL) {
-        data->dictionary()->do_unloading(is_alive_closure);
-      }
-      // Walk a ModuleEntry's reads, and a PackageEntry's exports
-      // lists to determine if there are modules on those lists that are now
-      // dead and should be removed.  A module's life cycle is equivalent
-      // to its defining class loader's life cycle.  Since a module is
-      // considered dead if its class loader is dead, these walks must
-      // occur after each class loader's aliveness is determined.
-      if (data->packages() != NULL) {
-        data->packages()->purge_all_package_exports();
-      }
-      if (data->modules_defined()) {
-        data->modules()->purge_all_module_reads();
-      }
-      data = data->next();
+    if (clean_alive_loaders) {
+      ClassLoaderDataGraphIteratorAtomic iter;
+      ClassLoaderDataGraph::clean_alive_loaders(&iter, is_alive_closure);
     }
 
     post_class_unload_events();
@@ -1294,6 +1297,35 @@ bool ClassLoaderDataGraph::do_unloading(BoolObjectClosure* is_alive_closure,
   return seen_dead_loader;
 }
 
+void ClassLoaderDataGraph::clean_alive_loaders(ClassLoaderDataGraphIteratorAtomic* iter,
+                                               BoolObjectClosure* is_alive_closure) {
+  assert(SafepointSynchronize::is_at_safepoint(), "must be at safepoint!");
+  ClassLoaderData* data;
+  while ((data = iter->next()) != NULL) {
+    data->clean_after_unloading(is_alive_closure);
+  }
+}
+
+void ClassLoaderData::clean_after_unloading(BoolObjectClosure* is_alive_closure) {
+  // Remove entries in the dictionary of live class loader that have
+  // initiated loading classes in a dead class loader.
+  if (dictionary() != NULL) {
+    dictionary()->do_unloading(is_alive_closure);
+  }
+  // Walk a ModuleEntry's reads, and a PackageEntry's exports
+  // lists to determine if there are modules on those lists that are now
+  // dead and should be removed.  A module's life cycle is equivalent
+  // to its defining class loader's life cycle.  Since a module is
+  // considered dead if its class loader is dead, these walks must
+  // occur after each class loader's aliveness is determined.
+  if (packages() != NULL) {
+    packages()->purge_all_package_exports();
+  }
+  if (modules_defined()) {
+    modules()->purge_all_module_reads();
+  }
+}
+
 void ClassLoaderDataGraph::purge() {
   assert(SafepointSynchronize::is_at_safepoint(), "must be at safepoint!");
   ClassLoaderData* list = _unloading;
@@ -1396,6 +1428,25 @@ Klass* ClassLoaderDataGraphKlassIteratorAtomic::next_klass() {
   return NULL;
 }
 
+ClassLoaderDataGraphIteratorAtomic::ClassLoaderDataGraphIteratorAtomic()
+    : _next(ClassLoaderDataGraph::_head) {}
+
+ClassLoaderData* ClassLoaderDataGraphIteratorAtomic::next() {
+  ClassLoaderData* head = _next;
+
+  while (head != NULL) {
+    ClassLoaderData* old_head = Atomic::cmpxchg(head->next(), &_next, head);
+
+    if (old_head == head) {
+      return head; // Won the CAS.
+    }
+
+    head = old_head;
+  }
+
+  return NULL;
+}
+
 ClassLoaderDataGraphMetaspaceIterator::ClassLoaderDataGraphMetaspaceIterator() {
   _data = ClassLoaderDataGraph::_head;
 }
@@ -51,6 +51,7 @@
 // and provides iterators for root tracing and other GC operations.
 
 class ClassLoaderData;
+class ClassLoaderDataGraphIteratorAtomic;
 class JNIMethodBlock;
 class Metadebug;
 class ModuleEntry;
@@ -65,6 +66,7 @@ class Dictionary;
 class ClassLoaderDataGraph : public AllStatic {
   friend class ClassLoaderData;
   friend class ClassLoaderDataGraphMetaspaceIterator;
+  friend class ClassLoaderDataGraphIteratorAtomic;
   friend class ClassLoaderDataGraphKlassIteratorAtomic;
   friend class ClassLoaderDataGraphKlassIteratorStatic;
   friend class VMStructs;
@@ -113,7 +115,14 @@ class ClassLoaderDataGraph : public AllStatic {
   static void packages_unloading_do(void f(PackageEntry*));
   static void loaded_classes_do(KlassClosure* klass_closure);
   static void classes_unloading_do(void f(Klass* const));
-  static bool do_unloading(BoolObjectClosure* is_alive, bool clean_previous_versions);
+  static bool do_unloading(BoolObjectClosure* is_alive, bool clean_previous_versions,
+                           bool clean_alive_loaders = true);
+  // Remove references to unloaded class loaders from the dictionaries,
+  // package exports and module reads of the surviving class loaders. This
+  // is part of do_unloading() unless clean_alive_loaders was false; then
+  // the caller must do it, possibly with several workers sharing iter.
+  static void clean_alive_loaders(ClassLoaderDataGraphIteratorAtomic* iter,
+                                  BoolObjectClosure* is_alive);
 
   // dictionary do
   // Iterate over all klasses in dictionary, but
@@ -212,6 +221,7 @@ class ClassLoaderData : public CHeapObj<mtClass> {
   };
 
   friend class ClassLoaderDataGraph;
+  friend class ClassLoaderDataGraphIteratorAtomic;
   friend class ClassLoaderDataGraphKlassIteratorAtomic;
   friend class ClassLoaderDataGraphKlassIteratorStatic;
   friend class ClassLoaderDataGraphMetaspaceIterator;
@@ -299,6 +309,9 @@ class ClassLoaderData : public CHeapObj<mtClass> {
   void free_deallocate_list();      // for the classes that are not unloaded
   void unload_deallocate_list();    // for the classes that are unloaded
 
+  // Drop references to unloaded class loaders; see ClassLoaderDataGraph::clean_alive_loaders().
+  void clean_after_unloading(BoolObjectClosure* is_alive);
+
   // Allocate out of this class loader data
   MetaWord* allocate(size_t size);
 
@@ -390,6 +403,7 @@ class ClassLoaderData : public CHeapObj<mtClass> {
   bool contains_klass(Klass* k);
   void record_dependency(const Klass* to);
   PackageEntryTable* packages() { return _packages; }
+  void presize_packages(int expected_packages);
   ModuleEntry* unnamed_module() { return _unnamed_module; }
   ModuleEntryTable* modules();
   bool modules_defined() { return (_modules != NULL); }
@@ -416,6 +430,14 @@ class ClassLoaderDataGraphKlassIteratorAtomic : public StackObj {
   static Klass* next_klass_in_cldg(Klass* klass);
 };
 
+// An iterator that distributes ClassLoaderData to parallel worker threads.
+class ClassLoaderDataGraphIteratorAtomic : public StackObj {
+  ClassLoaderData* volatile _next;
+ public:
+  ClassLoaderDataGraphIteratorAtomic();
+  ClassLoaderData* next();
+};
+
 class ClassLoaderDataGraphMetaspaceIterator : public StackObj {
   ClassLoaderData* _data;
  public:
@@ -129,8 +129,15 @@ class java_lang_String : AllStatic {
   // hash P(31) from Kernighan & Ritchie
   //
   // For this reason, THIS ALGORITHM MUST MATCH String.hashCode().
+  // Four elements are folded in per step, so the multiplies by powers of
+  // 31 are independent of each other and only one multiply per step is on
+  // the loop-carried dependency chain.
   static unsigned int hash_code(const jchar* s, int len) {
     unsigned int h = 0;
+    for (; len >= 4; len -= 4, s += 4) {
+      h = 31*31*31*31*h + 31*31*31*(unsigned int) s[0] + 31*31*(unsigned int) s[1] +
+          31*(unsigned int) s[2] + (unsigned int) s[3];
+    }
     while (len-- > 0) {
       h = 31*h + (unsigned int) *s;
       s++;
@@ -140,6 +147,10 @@ class java_lang_String : AllStatic {
 
   static unsigned int hash_code(const jbyte* s, int len) {
     unsigned int h = 0;
+    for (; len >= 4; len -= 4, s += 4) {
+      h = 31*31*31*31*h + 31*31*31*(((unsigned int) s[0]) & 0xFF) + 31*31*(((unsigned int) s[1]) & 0xFF) +
+          31*(((unsigned int) s[2]) & 0xFF) + (((unsigned int) s[3]) & 0xFF);
+    }
     while (len-- > 0) {
       h = 31*h + (((unsigned int) *s) & 0xFF);
       s++;
@@ -1845,7 +1845,8 @@ public:
 // Note: anonymous classes are not in the SD.
 bool SystemDictionary::do_unloading(BoolObjectClosure* is_alive,
                                     GCTimer* gc_timer,
-                                    bool do_cleaning) {
+                                    bool do_cleaning,
+                                    bool clean_alive_loaders) {
 
 
   bool unloading_occurred;
@@ -1854,7 +1855,8 @@ bool SystemDictionary::do_unloading(BoolObjectClosure* is_alive,
 
     // First, mark for unload all ClassLoaderData referencing a dead class loader.
     unloading_occurred = ClassLoaderDataGraph::do_unloading(is_alive,
-                                                            do_cleaning);
+                                                            do_cleaning,
+                                                            clean_alive_loaders);
   }
 
   if (unloading_occurred) {
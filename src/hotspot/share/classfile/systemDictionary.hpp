@@ -368,9 +368,12 @@ public:
 
   // Unload (that is, break root links to) all unmarked classes and
   // loaders.  Returns "true" iff something was unloaded.
+  // If clean_alive_loaders is false, the caller must call
+  // ClassLoaderDataGraph::clean_alive_loaders() when classes were unloaded.
   static bool do_unloading(BoolObjectClosure* is_alive,
                            GCTimer* gc_timer,
-                           bool do_cleaning = true);
+                           bool do_cleaning = true,
+                           bool clean_alive_loaders = true);
 
   // Used by DumpSharedSpaces only to remove classes that failed verification
   static void remove_classes_in_error_state();
@@ -101,8 +101,14 @@ bool VerificationType::is_reference_assignable_from(
       return true;
     }
 
-    return resolve_and_check_assignability(klass, name(), from.name(),
-          from_field_is_protected, from.is_array(), from.is_object(), THREAD);
+    bool result;
+    if (context->lookup_assignability(name(), from.name(), from_field_is_protected, &result)) {
+      return result;
+    }
+    result = resolve_and_check_assignability(klass, name(), from.name(),
+          from_field_is_protected, from.is_array(), from.is_object(), CHECK_false);
+    context->record_assignability(name(), from.name(), from_field_is_protected, result);
+    return result;
   } else if (is_array() && from.is_array()) {
     VerificationType comp_this = get_component(context, CHECK_false);
     VerificationType comp_from = from.get_component(context, CHECK_false);
@@ -572,6 +572,7 @@ ClassVerifier::ClassVerifier(
   _this_type = VerificationType::reference_type(klass->name());
   // Create list to hold symbols in reference area.
   _symbols = new GrowableArray<Symbol*>(100, 0, NULL);
+  memset(_assignability_cache, 0, sizeof(_assignability_cache));
 }
 
 ClassVerifier::~ClassVerifier() {
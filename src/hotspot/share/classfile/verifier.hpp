@@ -366,6 +366,24 @@ class ClassVerifier : public StackObj {
   bool is_same_or_direct_interface(InstanceKlass* klass,
     VerificationType klass_type, VerificationType ref_class_type);
 
+  // Direct-mapped cache of reference assignability results for this
+  // verification pass, so repeated checks between the same two class
+  // names don't go through class resolution again. The names are kept
+  // alive by the constant pool or the _symbols list.
+  enum { assignability_cache_size = 64 };
+  struct AssignabilityCacheEntry {
+    Symbol* _target;
+    Symbol* _from;
+    bool    _from_field_is_protected;
+    bool    _result;
+  };
+  AssignabilityCacheEntry _assignability_cache[assignability_cache_size];
+
+  AssignabilityCacheEntry* assignability_cache_at(Symbol* target, Symbol* from) {
+    uintptr_t h = ((uintptr_t)target >> 3) ^ ((uintptr_t)from >> 5);
+    return &_assignability_cache[h & (assignability_cache_size - 1)];
+  }
+
  public:
   enum {
     BYTECODE_OFFSET = 1,
@@ -383,6 +401,27 @@ class ClassVerifier : public StackObj {
   InstanceKlass* current_class() const { return _klass; }
   VerificationType current_type() const { return _this_type; }
 
+  // Returns true and sets 'result' if the assignability of 'from' to
+  // 'target' was already checked in this verification pass.
+  bool lookup_assignability(Symbol* target, Symbol* from,
+                            bool from_field_is_protected, bool* result) {
+    AssignabilityCacheEntry* e = assignability_cache_at(target, from);
+    if (e->_target == target && e->_from == from &&
+        e->_from_field_is_protected == from_field_is_protected) {
+      *result = e->_result;
+      return true;
+    }
+    return false;
+  }
+  void record_assignability(Symbol* target, Symbol* from,
+                            bool from_field_is_protected, bool result) {
+    AssignabilityCacheEntry* e = assignability_cache_at(target, from);
+    e->_target = target;
+    e->_from = from;
+    e->_from_field_is_protected = from_field_is_protected;
+    e->_result = result;
+  }
+
   // Verifies the class.  If a verify or class file format error occurs,
   // the '_exception_name' symbols will set to the exception name and
   // the message_buffer will be filled in with the exception message.
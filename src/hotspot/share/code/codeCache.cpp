@@ -33,6 +33,7 @@
 #include "code/pcDesc.hpp"
 #include "compiler/compileBroker.hpp"
 #include "gc/shared/gcLocker.hpp"
+#include "logging/log.hpp"
 #include "memory/allocation.inline.hpp"
 #include "memory/iterator.hpp"
 #include "memory/resourceArea.hpp"
@@ -1267,17 +1268,7 @@ void CodeCache::flush_evol_dependents_on(InstanceKlass* ev_k) {
     // At least one nmethod has been marked for deoptimization
 
     // All this already happens inside a VM_Operation, so we'll do all the work here.
-    // Stuff copied from VM_Deoptimize and modified slightly.
-
-    // We do not want any GCs to happen while we are in the middle of this VM operation
-    ResourceMark rm;
-    DeoptimizationMarker dm;
-
-    // Deoptimize all activations depending on marked nmethods
-    Deoptimization::deoptimize_dependents();
-
-    // Make the dependent methods not entrant
-    make_marked_nmethods_not_entrant();
+    Deoptimization::deoptimize_all_marked();
   }
 }
 #endif // HOTSWAP
@@ -1297,17 +1288,7 @@ void CodeCache::flush_dependents_on_method(const methodHandle& m_h) {
     // At least one nmethod has been marked for deoptimization
 
     // All this already happens inside a VM_Operation, so we'll do all the work here.
-    // Stuff copied from VM_Deoptimize and modified slightly.
-
-    // We do not want any GCs to happen while we are in the middle of this VM operation
-    ResourceMark rm;
-    DeoptimizationMarker dm;
-
-    // Deoptimize all activations depending on marked nmethods
-    Deoptimization::deoptimize_dependents();
-
-    // Make the dependent methods not entrant
-    make_marked_nmethods_not_entrant();
+    Deoptimization::deoptimize_all_marked();
   }
 }
 
@@ -1367,6 +1348,14 @@ void CodeCache::report_codemem_full(int code_blob_type, bool print) {
     tty->print("%s", s.as_string());
   }
 
+  if (log_is_enabled(Info, codecache)) {
+    // Record how fragmented the code cache was when it filled up
+    ResourceMark rm;
+    stringStream s;
+    print_fragmentation(&s);
+    log_info(codecache)("%s", s.as_string());
+  }
+
   heap->report_full();
 
   EventCodeCacheFull event;
@@ -1633,6 +1622,58 @@ void CodeCache::print_layout(outputStream* st) {
   print_summary(st, true);
 }
 
+void CodeCache::print_fragmentation(outputStream* st) {
+  MutexLockerEx mu(CodeCache_lock, Mutex::_no_safepoint_check_flag);
+  ResourceMark rm;
+  const int top_n = 10;
+  FOR_ALL_ALLOCABLE_HEAPS(heap_iterator) {
+    CodeHeap* heap = (*heap_iterator);
+    heap->print_fragmentation(st);
+
+    // Collect the largest blobs and the space used by nmethods in each state
+    CodeBlob* largest[top_n];
+    int nof_largest = 0;
+    int    state_count[3] = { 0, 0, 0 };  // in use, not entrant, zombie/unloaded
+    size_t state_bytes[3] = { 0, 0, 0 };
+    FOR_ALL_BLOBS(cb, heap) {
+      int pos = nof_largest;
+      while (pos > 0 && largest[pos - 1]->size() < cb->size()) {
+        if (pos < top_n) {
+          largest[pos] = largest[pos - 1];
+        }
+        pos--;
+      }
+      if (pos < top_n) {
+        largest[pos] = cb;
+        nof_largest = MIN2(nof_largest + 1, top_n);
+      }
+      if (cb->is_nmethod()) {
+        nmethod* nm = (nmethod*)cb;
+        int state = nm->is_in_use() ? 0 : (nm->is_not_entrant() ? 1 : 2);
+        state_count[state]++;
+        state_bytes[state] += nm->total_size();
+      }
+    }
+    st->print_cr("  nmethods: in_use=%d (" SIZE_FORMAT "Kb) not_entrant=%d (" SIZE_FORMAT "Kb) dead=%d (" SIZE_FORMAT "Kb)",
+                 state_count[0], state_bytes[0] / K, state_count[1], state_bytes[1] / K,
+                 state_count[2], state_bytes[2] / K);
+    if (nof_largest > 0) {
+      st->print_cr("  largest blobs:");
+    }
+    for (int i = 0; i < nof_largest; i++) {
+      CodeBlob* cb = largest[i];
+      st->print("  %8dKb " INTPTR_FORMAT " ", cb->size() / (int)K, p2i(cb));
+      if (cb->is_nmethod()) {
+        nmethod* nm = (nmethod*)cb;
+        st->print_cr("nmethod %d level %d %s", nm->compile_id(), nm->comp_level(),
+                     nm->method() != NULL ? nm->method()->name_and_sig_as_C_string() : "(unloaded)");
+      } else {
+        st->print_cr("%s", cb->name());
+      }
+    }
+  }
+}
+
 void CodeCache::log_state(outputStream* st) {
   st->print(" total_blobs='" UINT32_FORMAT "' nmethods='" UINT32_FORMAT "'"
             " adapters='" UINT32_FORMAT "' free_code_cache='" SIZE_FORMAT "'",
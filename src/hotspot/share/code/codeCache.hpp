@@ -203,6 +203,7 @@ class CodeCache : AllStatic {
   // Dcmd (Diagnostic commands)
   static void print_codelist(outputStream* st);
   static void print_layout(outputStream* st);
+  static void print_fragmentation(outputStream* st);
 
   // The full limits of the codeCache
   static address low_bound()                          { return _low_bound; }
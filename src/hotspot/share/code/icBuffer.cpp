@@ -31,6 +31,7 @@
 #include "gc/shared/collectedHeap.inline.hpp"
 #include "interpreter/interpreter.hpp"
 #include "interpreter/linkResolver.hpp"
+#include "logging/log.hpp"
 #include "memory/resourceArea.hpp"
 #include "memory/universe.hpp"
 #include "oops/method.hpp"
@@ -46,6 +47,7 @@ ICStub*    InlineCacheBuffer::_next_stub = NULL;
 
 CompiledICHolder* InlineCacheBuffer::_pending_released = NULL;
 int InlineCacheBuffer::_pending_count = 0;
+int InlineCacheBuffer::_buffer_full_count = 0;
 
 void ICStub::finalize() {
   if (!is_empty()) {
@@ -111,7 +113,7 @@ void InlineCacheBuffer::init_next_stub() {
 
 void InlineCacheBuffer::initialize() {
   if (_buffer != NULL) return; // already initialized
-  _buffer = new StubQueue(new ICStubInterface, 10*K, InlineCacheBuffer_lock, "InlineCacheBuffer");
+  _buffer = new StubQueue(new ICStubInterface, (int)InlineCacheBufferSize, InlineCacheBuffer_lock, "InlineCacheBuffer");
   assert (_buffer != NULL, "cannot allocate InlineCacheBuffer");
   init_next_stub();
 }
@@ -127,6 +129,11 @@ ICStub* InlineCacheBuffer::new_ic_stub() {
     // We do this by forcing a safepoint
     EXCEPTION_MARK;
 
+    _buffer_full_count++;
+    log_debug(codecache)("InlineCacheBuffer full with %d stubs, forcing safepoint (%d so far); "
+                         "consider increasing InlineCacheBufferSize",
+                         buffer()->number_of_stubs(), _buffer_full_count);
+
     VM_ICBufferFull ibf;
     VMThread::execute(&ibf);
     // We could potential get an async. exception at this point.
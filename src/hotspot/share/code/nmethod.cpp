@@ -1784,6 +1784,34 @@ static PcDesc* linear_search(const PcDescSearch& search, int pc_offset, bool app
 #endif
 
 
+// Global cache of exact PcDesc lookups, shared by all threads and all
+// compiled methods, in front of the search in find_pc_desc_internal. The
+// per-method PcDescCache only holds the last few hits, which stack walks
+// over deep stacks (exception backtraces, StackWalker) keep evicting.
+//
+// Entries are single words, indexed by a hash of the pc, and are only
+// trusted after checking that they point at an element of the searched
+// method's own PcDesc array with the right pc offset. Stale entries left
+// behind by flushed methods therefore never need to be invalidated.
+static const int global_pc_desc_cache_size = 4096;  // power of 2
+static PcDesc* volatile global_pc_desc_cache[global_pc_desc_cache_size];
+
+static inline int global_pc_desc_cache_index(address pc) {
+  uintptr_t p = (uintptr_t)pc;
+  return (int)((p ^ (p >> 12)) & (global_pc_desc_cache_size - 1));
+}
+
+static inline PcDesc* global_pc_desc_cache_lookup(address pc, int pc_offset, const PcDescSearch& search) {
+  PcDesc* pd = global_pc_desc_cache[global_pc_desc_cache_index(pc)];
+  PcDesc* lower = search.scopes_pcs_begin();
+  if (pd >= lower && pd < search.scopes_pcs_end() &&
+      ((address)pd - (address)lower) % sizeof(PcDesc) == 0 &&
+      pd->pc_offset() == pc_offset) {
+    return pd;
+  }
+  return NULL;
+}
+
 // Finds a PcDesc with real-pc equal to "pc"
 PcDesc* PcDescContainer::find_pc_desc_internal(address pc, bool approximate, const PcDescSearch& search) {
   address base_address = search.code_begin();
@@ -1801,6 +1829,15 @@ PcDesc* PcDescContainer::find_pc_desc_internal(address pc, bool approximate, con
     return res;
   }
 
+  if (!approximate) {
+    res = global_pc_desc_cache_lookup(pc, pc_offset, search);
+    if (res != NULL) {
+      assert(res == linear_search(search, pc_offset, approximate), "global cache ok");
+      _pc_desc_cache.add_pc_desc(res);
+      return res;
+    }
+  }
+
   // Fallback algorithm: quasi-linear search for the PcDesc
   // Find the last pc_offset less than the given offset.
   // The successor must be the required match, if there is a match at all.
@@ -1859,6 +1896,9 @@ PcDesc* PcDescContainer::find_pc_desc_internal(address pc, bool approximate, con
   if (match_desc(upper, pc_offset, approximate)) {
     assert(upper == linear_search(search, pc_offset, approximate), "search ok");
     _pc_desc_cache.add_pc_desc(upper);
+    if (!approximate) {
+      global_pc_desc_cache[global_pc_desc_cache_index(pc)] = upper;
+    }
     return upper;
   } else {
     assert(NULL == linear_search(search, pc_offset, approximate), "search ok");
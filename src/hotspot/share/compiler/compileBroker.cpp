@@ -364,12 +364,18 @@ CompileTask* CompileQueue::get() {
   // we ran out of code cache so compilation has been disabled. In the latter
   // case we perform code cache sweeps to free memory such that we can re-enable
   // compilation.
-  while (_first == NULL) {
+  while (_first == NULL || must_park()) {
     // Exit loop if compilation is disabled forever
     if (CompileBroker::is_compilation_disabled_forever()) {
       return NULL;
     }
 
+    // More threads than the active limit are taking tasks from this queue.
+    if (must_park()) {
+      park();
+      continue;
+    }
+
     // If there are no compilation tasks and we can compile new jobs
     // (i.e., there is enough free space in the code cache) there is
     // no need to invoke the sweeper. As a result, the hotness of methods
@@ -405,6 +411,37 @@ CompileTask* CompileQueue::get() {
   return task;
 }
 
+void CompileQueue::set_num_threads(int num_threads) {
+  _num_threads = num_threads;
+  _active_thread_limit = num_threads;
+}
+
+void CompileQueue::set_active_thread_limit(int limit) {
+  assert(MethodCompileQueue_lock->owned_by_self(), "must own lock");
+  assert(limit > 0 && limit <= _num_threads, "invalid limit %d", limit);
+  int old_limit = _active_thread_limit;
+  _active_thread_limit = limit;
+  if (limit > old_limit) {
+    // Let parked threads pick up tasks again.
+    MethodCompileQueue_lock->notify_all();
+  }
+}
+
+// Park the current compiler thread until the active thread limit of this
+// queue is raised again or compilation is disabled forever.
+void CompileQueue::park() {
+  assert(MethodCompileQueue_lock->owned_by_self(), "must own lock");
+  _num_parked_threads++;
+  log_debug(jit, compilation)("%s: parking %s, %d of %d threads active",
+                              _name, Thread::current()->name(),
+                              _num_threads - _num_parked_threads, _num_threads);
+  while (_num_threads - _num_parked_threads >= _active_thread_limit &&
+         !CompileBroker::is_compilation_disabled_forever()) {
+    MethodCompileQueue_lock->wait(!Mutex::_no_safepoint_check_flag, 5*1000);
+  }
+  _num_parked_threads--;
+}
+
 // Clean & deallocate stale compile tasks.
 // Temporarily releases MethodCompileQueue lock.
 void CompileQueue::purge_stale_tasks() {
@@ -770,10 +807,12 @@ void CompileBroker::init_compiler_sweeper_threads(int c1_compiler_count, int c2_
   if (c2_compiler_count > 0) {
     const char* name = JVMCI_ONLY(UseJVMCICompiler ? "JVMCI compile queue" :) "C2 compile queue";
     _c2_compile_queue  = new CompileQueue(name);
+    _c2_compile_queue->set_num_threads(c2_compiler_count);
     _compilers[1]->set_num_compiler_threads(c2_compiler_count);
   }
   if (c1_compiler_count > 0) {
     _c1_compile_queue  = new CompileQueue("C1 compile queue");
+    _c1_compile_queue->set_num_threads(c1_compiler_count);
     _compilers[0]->set_num_compiler_threads(c1_compiler_count);
   }
 
@@ -806,6 +845,38 @@ void CompileBroker::init_compiler_sweeper_threads(int c1_compiler_count, int c2_
   }
 }
 
+/**
+ * Scale the number of compiler threads that may compile concurrently with
+ * the current processor count. The threads themselves stay alive: threads
+ * over the limit park in CompileQueue::get() once they finish their current
+ * task, and are woken up when the limit is raised again.
+ */
+void CompileBroker::update_active_compiler_threads(int processor_count) {
+  if (!FLAG_IS_DEFAULT(CICompilerCount)) {
+    // The user asked for a fixed number of compiler threads.
+    return;
+  }
+  MutexLocker locker(MethodCompileQueue_lock);
+  update_active_compiler_threads(_c2_compile_queue, processor_count);
+  update_active_compiler_threads(_c1_compile_queue, processor_count);
+}
+
+void CompileBroker::update_active_compiler_threads(CompileQueue* queue, int processor_count) {
+  assert(MethodCompileQueue_lock->owned_by_self(), "must own lock");
+  if (queue == NULL || queue->num_threads() == 0) {
+    return;
+  }
+  int num_threads = queue->num_threads();
+  int initial_count = os::initial_active_processor_count();
+  int limit = (int)(((jlong)num_threads * processor_count + initial_count - 1) / initial_count);
+  limit = MAX2(1, MIN2(limit, num_threads));
+  if (limit != queue->active_thread_limit()) {
+    log_info(jit, compilation)("%s: active compiler threads changed from %d to %d of %d",
+                               queue->name(), queue->active_thread_limit(), limit, num_threads);
+    queue->set_active_thread_limit(limit);
+  }
+}
+
 
 /**
  * Set the methods on the stack as on_stack so that redefine classes doesn't
@@ -89,7 +89,16 @@ class CompileQueue : public CHeapObj<mtCompiler> {
 
   int _size;
 
+  // Number of compiler threads taking tasks from this queue, how many of
+  // them may compile at the same time, and how many are parked because
+  // the limit was lowered.
+  int _num_threads;
+  int _active_thread_limit;
+  int _num_parked_threads;
+
   void purge_stale_tasks();
+  bool must_park() const { return _num_threads - _num_parked_threads > _active_thread_limit; }
+  void park();
  public:
   CompileQueue(const char* name) {
     _name = name;
@@ -97,6 +106,9 @@ class CompileQueue : public CHeapObj<mtCompiler> {
     _last = NULL;
     _size = 0;
     _first_stale = NULL;
+    _num_threads = 0;
+    _active_thread_limit = 0;
+    _num_parked_threads = 0;
   }
 
   const char*  name() const                      { return _name; }
@@ -112,6 +124,11 @@ class CompileQueue : public CHeapObj<mtCompiler> {
   bool         is_empty() const                  { return _first == NULL; }
   int          size()     const                  { return _size;          }
 
+  void         set_num_threads(int num_threads);
+  int          num_threads() const               { return _num_threads; }
+  int          active_thread_limit() const       { return _active_thread_limit; }
+  void         set_active_thread_limit(int limit);
+
 
   // Redefine Classes support
   void mark_on_stack();
@@ -221,6 +238,7 @@ class CompileBroker: AllStatic {
 
   static JavaThread* make_thread(const char* name, CompileQueue* queue, CompilerCounters* counters, AbstractCompiler* comp, bool compiler_thread, TRAPS);
   static void init_compiler_sweeper_threads(int c1_compiler_count, int c2_compiler_count);
+  static void update_active_compiler_threads(CompileQueue* queue, int processor_count);
   static bool compilation_is_complete  (const methodHandle& method, int osr_bci, int comp_level);
   static bool compilation_is_prohibited(const methodHandle& method, int osr_bci, int comp_level, bool excluded);
   static void preload_classes          (const methodHandle& method, TRAPS);
@@ -284,6 +302,11 @@ public:
   }
   static void compilation_init(TRAPS);
   static void init_compiler_thread_log();
+
+  // Scale the number of compiler threads that may compile concurrently
+  // with processor_count, relative to the processor count at startup.
+  // Called by the ResourceLimitMonitor when the processor count changes.
+  static void update_active_compiler_threads(int processor_count);
   static nmethod* compile_method(const methodHandle& method,
                                  int osr_bci,
                                  int comp_level,
@@ -31,7 +31,9 @@
 #include "gc/cms/vmCMSOperations.hpp"
 #include "gc/shared/genMemoryPools.hpp"
 #include "gc/shared/genOopClosures.inline.hpp"
+#include "gc/shared/stringDedup.hpp"
 #include "gc/shared/strongRootsScope.hpp"
+#include "gc/shared/suspendibleThreadSet.hpp"
 #include "gc/shared/workgroup.hpp"
 #include "oops/oop.inline.hpp"
 #include "runtime/vmThread.hpp"
@@ -87,6 +89,9 @@ jint CMSHeap::initialize() {
     return JNI_ENOMEM;
   }
 
+  // Initialize string deduplication
+  StringDedup::initialize();
+
   return JNI_OK;
 }
 
@@ -140,12 +145,18 @@ void CMSHeap::gc_threads_do(ThreadClosure* tc) const {
   assert(workers() != NULL, "should have workers here");
   workers()->threads_do(tc);
   ConcurrentMarkSweepThread::threads_do(tc);
+  if (StringDedup::is_enabled()) {
+    StringDedup::threads_do(tc);
+  }
 }
 
 void CMSHeap::print_gc_threads_on(outputStream* st) const {
   assert(workers() != NULL, "should have workers here");
   workers()->print_worker_threads_on(st);
   ConcurrentMarkSweepThread::print_all_on(st);
+  if (StringDedup::is_enabled()) {
+    StringDedup::print_worker_threads_on(st);
+  }
 }
 
 void CMSHeap::print_on_error(outputStream* st) const {
@@ -206,13 +217,24 @@ void CMSHeap::collect_mostly_concurrent(GCCause::Cause cause) {
 
 void CMSHeap::stop() {
   ConcurrentMarkSweepThread::cmst()->stop();
+  if (StringDedup::is_enabled()) {
+    StringDedup::stop();
+  }
 }
 
 void CMSHeap::safepoint_synchronize_begin() {
   ConcurrentMarkSweepThread::synchronize(false);
+  // The string deduplication thread uses the suspendible thread set
+  // rather than the CMS token to yield to safepoints.
+  if (StringDedup::is_enabled()) {
+    SuspendibleThreadSet::synchronize();
+  }
 }
 
 void CMSHeap::safepoint_synchronize_end() {
+  if (StringDedup::is_enabled()) {
+    SuspendibleThreadSet::desynchronize();
+  }
   ConcurrentMarkSweepThread::desynchronize(false);
 }
 
@@ -0,0 +1,710 @@
+/*
+ * Copyright (c) 2018, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#include "precompiled.hpp"
+#include "classfile/classLoaderData.hpp"
+#include "classfile/symbolTable.hpp"
+#include "classfile/systemDictionary.hpp"
+#include "code/codeCache.hpp"
+#include "gc/cms/cmsHeap.hpp"
+#include "gc/cms/cmsParMarkSweep.hpp"
+#include "gc/cms/compactibleFreeListSpace.hpp"
+#include "gc/cms/concurrentMarkSweepGeneration.hpp"
+#include "gc/serial/markSweep.inline.hpp"
+#include "gc/shared/adaptiveSizePolicy.hpp"
+#include "gc/shared/cardTableRS.hpp"
+#include "gc/shared/gcTimer.hpp"
+#include "gc/shared/gcTrace.hpp"
+#include "gc/shared/gcTraceTime.inline.hpp"
+#include "gc/shared/genOopClosures.inline.hpp"
+#include "gc/shared/preservedMarks.inline.hpp"
+#include "gc/shared/space.hpp"
+#include "gc/shared/strongRootsScope.hpp"
+#include "gc/shared/stringDedup.hpp"
+#include "gc/shared/taskqueue.inline.hpp"
+#include "gc/shared/weakProcessor.hpp"
+#include "gc/shared/workgroup.hpp"
+#include "memory/iterator.inline.hpp"
+#include "oops/objArrayOop.inline.hpp"
+#include "oops/oop.inline.hpp"
+#include "prims/jvmtiExport.hpp"
+#include "runtime/atomic.hpp"
+#include "runtime/thread.hpp"
+#include "utilities/stack.inline.hpp"
+
+class CMSParMarkSweepThreadState;
+
+// Marks the objects reachable from a root and follows them.
+class CMSParFollowRootClosure: public OopsInGenClosure {
+  CMSParMarkSweepThreadState* _state;
+  template <class T> inline void do_oop_work(T* p);
+ public:
+  CMSParFollowRootClosure(CMSParMarkSweepThreadState* state, Generation* gen) :
+    OopsInGenClosure(gen), _state(state) { }
+  virtual void do_oop(oop* p);
+  virtual void do_oop(narrowOop* p);
+};
+
+// Marks the objects referenced from a marked object and pushes them on the
+// marking stack of the worker.
+class CMSParMarkAndPushClosure: public ExtendedOopClosure {
+  CMSParMarkSweepThreadState* _state;
+  template <class T> inline void do_oop_work(T* p);
+ public:
+  CMSParMarkAndPushClosure(CMSParMarkSweepThreadState* state) :
+    ExtendedOopClosure(NULL), _state(state) { }
+  virtual void do_oop(oop* p);
+  virtual void do_oop(narrowOop* p);
+
+  virtual bool do_metadata() { return true; }
+  virtual void do_klass(Klass* k);
+  virtual void do_cld(ClassLoaderData* cld);
+
+  void set_ref_processor(ReferenceProcessor* rp) {
+    set_ref_processor_internal(rp);
+  }
+};
+
+// Drains the marking stacks of a worker; used to complete the marking
+// during serial reference processing.
+class CMSParFollowStackClosure: public VoidClosure {
+  CMSParMarkSweepThreadState* _state;
+ public:
+  CMSParFollowStackClosure(CMSParMarkSweepThreadState* state) : _state(state) { }
+  virtual void do_void();
+};
+
+// The marking state of one worker: the stealable marking stacks, the
+// preserved marks and the closures that push onto them.
+class CMSParMarkSweepThreadState : public CHeapObj<mtGC> {
+  const uint               _worker_id;
+  CMSParMarkingStack       _marking_stack;
+  CMSParObjArrayStack      _objarray_stack;
+  PreservedMarks*          _preserved_marks;
+
+  CMSParFollowRootClosure  _follow_root_closure;
+  CMSParMarkAndPushClosure _mark_and_push_closure;
+  CLDToOopClosure          _follow_cld_closure;
+  CMSParFollowStackClosure _follow_stack_closure;
+
+  // Mark the object, preserving its mark word if needed.  Returns false
+  // if the object was already marked, possibly by another worker.
+  inline bool mark_object(oop obj);
+  inline void push_objarray(oop obj, size_t index);
+  inline void follow_array(objArrayOop array);
+  void follow_array_chunk(objArrayOop array, int index);
+  inline void follow_object(oop obj);
+
+ public:
+  CMSParMarkSweepThreadState(uint worker_id, Generation* old_gen);
+
+  CMSParMarkingStack*  marking_stack()  { return &_marking_stack; }
+  CMSParObjArrayStack* objarray_stack() { return &_objarray_stack; }
+
+  CMSParFollowRootClosure*  follow_root_closure()   { return &_follow_root_closure; }
+  CMSParMarkAndPushClosure* mark_and_push_closure() { return &_mark_and_push_closure; }
+  CLDToOopClosure*          follow_cld_closure()    { return &_follow_cld_closure; }
+  CMSParFollowStackClosure* follow_stack_closure()  { return &_follow_stack_closure; }
+
+  void set_up(ReferenceProcessor* rp, PreservedMarks* preserved_marks) {
+    _mark_and_push_closure.set_ref_processor(rp);
+    _preserved_marks = preserved_marks;
+  }
+
+  bool marking_stacks_empty() const {
+    return _marking_stack.is_empty() && _objarray_stack.is_empty();
+  }
+
+  template <class T> inline void mark_and_push(T* p);
+  template <class T> inline void follow_root(T* p);
+  inline void follow_klass(Klass* klass);
+  inline void follow_cld(ClassLoaderData* cld);
+
+  // Empty the marking stacks of this worker.
+  void follow_marking_stacks();
+  // Steal from the other workers until all marking stacks are empty.
+  void steal_and_follow(ParallelTaskTerminator* terminator);
+};
+
+CMSParMarkSweepThreadState::CMSParMarkSweepThreadState(uint worker_id, Generation* old_gen) :
+  _worker_id(worker_id),
+  _preserved_marks(NULL),
+  _follow_root_closure(this, old_gen),
+  _mark_and_push_closure(this),
+  _follow_cld_closure(&_mark_and_push_closure),
+  _follow_stack_closure(this) {
+  _marking_stack.initialize();
+  _objarray_stack.initialize();
+}
+
+inline bool CMSParMarkSweepThreadState::mark_object(oop obj) {
+  // Some marks may contain information we need to preserve so we store
+  // them away and overwrite the mark.  We'll restore them at the end of
+  // the collection.
+  markOop mark = obj->mark();
+  if (mark->is_marked()) {
+    return false;
+  }
+  if (obj->cas_set_mark(markOopDesc::prototype()->set_marked(), mark) != mark) {
+    // Only the GC workers modify the mark word at this point: another
+    // worker marked the object first.
+    return false;
+  }
+  if (mark->must_be_preserved(obj)) {
+    _preserved_marks->push(obj, mark);
+  }
+  return true;
+}
+
+template <class T> inline void CMSParMarkSweepThreadState::mark_and_push(T* p) {
+  T heap_oop = oopDesc::load_heap_oop(p);
+  if (!oopDesc::is_null(heap_oop)) {
+    oop obj = oopDesc::decode_heap_oop_not_null(heap_oop);
+    if (mark_object(obj)) {
+      _marking_stack.push(obj);
+    }
+  }
+}
+
+template <class T> inline void CMSParMarkSweepThreadState::follow_root(T* p) {
+  assert(!Universe::heap()->is_in_reserved(p),
+         "roots shouldn't be things within the heap");
+  mark_and_push(p);
+  follow_marking_stacks();
+}
+
+inline void CMSParMarkSweepThreadState::follow_klass(Klass* klass) {
+  oop op = klass->klass_holder();
+  mark_and_push(&op);
+}
+
+inline void CMSParMarkSweepThreadState::follow_cld(ClassLoaderData* cld) {
+  _follow_cld_closure.do_cld(cld);
+}
+
+inline void CMSParMarkSweepThreadState::push_objarray(oop obj, size_t index) {
+  ObjArrayTask task(obj, index);
+  assert(task.is_valid(), "bad ObjArrayTask");
+  _objarray_stack.push(task);
+}
+
+inline void CMSParMarkSweepThreadState::follow_array(objArrayOop array) {
+  follow_klass(array->klass());
+  // Don't push empty arrays to avoid unnecessary work.
+  if (array->length() > 0) {
+    push_objarray(array, 0);
+  }
+}
+
+inline void CMSParMarkSweepThreadState::follow_object(oop obj) {
+  assert(obj->is_gc_marked(), "should be marked");
+  if (obj->is_objArray()) {
+    // Handle object arrays explicitly to allow them to
+    // be split into chunks if needed.
+    follow_array((objArrayOop)obj);
+  } else {
+    obj->oop_iterate(&_mark_and_push_closure);
+  }
+}
+
+void CMSParMarkSweepThreadState::follow_array_chunk(objArrayOop array, int index) {
+  const int len = array->length();
+  const int beg_index = index;
+  const int end_index = ObjArrayTask::chunk_end(beg_index, len);
+
+  if (end_index < len) {
+    push_objarray(array, end_index); // Push the continuation.
+  }
+
+  array->oop_iterate_range(&_mark_and_push_closure, beg_index, end_index);
+}
+
+void CMSParMarkSweepThreadState::follow_marking_stacks() {
+  do {
+    // Drain the overflow stack first, to allow stealing from the marking stack.
+    oop obj;
+    while (_marking_stack.pop_overflow(obj)) {
+      follow_object(obj);
+    }
+    while (_marking_stack.pop_local(obj)) {
+      follow_object(obj);
+    }
+
+    // Process ObjArrays one at a time to avoid marking stack bloat.
+    ObjArrayTask task;
+    if (_objarray_stack.pop_overflow(task) || _objarray_stack.pop_local(task)) {
+      follow_array_chunk((objArrayOop)task.obj(), task.index());
+    }
+  } while (!marking_stacks_empty());
+}
+
+void CMSParMarkSweepThreadState::steal_and_follow(ParallelTaskTerminator* terminator) {
+  oop obj = NULL;
+  ObjArrayTask task;
+  int random_seed = 17;
+  do {
+    while (CMSParMarkSweep::objarray_stacks()->steal(_worker_id, &random_seed, task)) {
+      follow_array_chunk((objArrayOop)task.obj(), task.index());
+      follow_marking_stacks();
+    }
+    while (CMSParMarkSweep::marking_stacks()->steal(_worker_id, &random_seed, obj)) {
+      follow_object(obj);
+      follow_marking_stacks();
+    }
+  } while (!terminator->offer_termination());
+}
+
+template <class T> inline void CMSParFollowRootClosure::do_oop_work(T* p) { _state->follow_root(p); }
+void CMSParFollowRootClosure::do_oop(oop* p)                            { do_oop_work(p); }
+void CMSParFollowRootClosure::do_oop(narrowOop* p)                      { do_oop_work(p); }
+
+template <class T> inline void CMSParMarkAndPushClosure::do_oop_work(T* p) { _state->mark_and_push(p); }
+void CMSParMarkAndPushClosure::do_oop(oop* p)                            { do_oop_work(p); }
+void CMSParMarkAndPushClosure::do_oop(narrowOop* p)                      { do_oop_work(p); }
+void CMSParMarkAndPushClosure::do_klass(Klass* k)                        { _state->follow_klass(k); }
+void CMSParMarkAndPushClosure::do_cld(ClassLoaderData* cld)              { _state->follow_cld(cld); }
+
+void CMSParFollowStackClosure::do_void() { _state->follow_marking_stacks(); }
+
+uint                         CMSParMarkSweep::_num_workers = 0;
+CMSParMarkSweepThreadState** CMSParMarkSweep::_thread_states = NULL;
+CMSParMarkingStackSet*       CMSParMarkSweep::_marking_stacks = NULL;
+CMSParObjArrayStackSet*      CMSParMarkSweep::_objarray_stacks = NULL;
+PreservedMarksSet            CMSParMarkSweep::_preserved_marks_set(true /* in_c_heap */);
+CFLSCompactionRegion*        CMSParMarkSweep::_regions = NULL;
+uint                         CMSParMarkSweep::_num_regions = 0;
+
+bool CMSParMarkSweep::should_use() {
+  // The regions update the block offset table concurrently, which is
+  // not possible when it also tracks the unallocated block.
+  return CMSParallelFullGC && ParallelGCThreads > 1 && !BlockOffsetArrayUseUnallocatedBlock;
+}
+
+CMSParMarkSweepThreadState* CMSParMarkSweep::thread_state(uint i) {
+  assert(_thread_states != NULL && i < workers()->total_workers(), "invariant");
+  return _thread_states[i];
+}
+
+CFLSCompactionRegion* CMSParMarkSweep::region(uint i) {
+  assert(i < _num_regions, "invariant");
+  return &_regions[i];
+}
+
+WorkGang* CMSParMarkSweep::workers() {
+  return CMSHeap::heap()->workers();
+}
+
+CompactibleFreeListSpace* CMSParMarkSweep::cms_space() {
+  return ((ConcurrentMarkSweepGeneration*)CMSHeap::heap()->old_gen())->cmsSpace();
+}
+
+void CMSParMarkSweep::invoke_at_safepoint(ReferenceProcessor* rp, bool clear_all_softrefs) {
+  assert(SafepointSynchronize::is_at_safepoint(), "must be at a safepoint");
+  assert(should_use(), "should not be used");
+
+  CMSHeap* heap = CMSHeap::heap();
+#ifdef ASSERT
+  if (heap->soft_ref_policy()->should_clear_all_soft_refs()) {
+    assert(clear_all_softrefs, "Policy should have been checked earlier");
+  }
+#endif
+
+  // hook up weak ref data so it can be used during Mark-Sweep
+  assert(ref_processor() == NULL, "no stomping");
+  assert(rp != NULL, "should be non-NULL");
+  assert(rp->discovery_is_mt(), "workers discover references concurrently");
+  set_ref_processor(rp);
+  rp->setup_policy(clear_all_softrefs);
+
+  heap->trace_heap_before_gc(_gc_tracer);
+
+  // When collecting the permanent generation Method*s may be moving,
+  // so we either have to flush all bcp data or convert it into bci.
+  CodeCache::gc_prologue();
+
+  // Increment the invocation count
+  _total_invocations++;
+
+  // Capture used regions for each generation that will be
+  // subject to collection, so that card table adjustments can
+  // be made intelligently (see clear / invalidate further below).
+  heap->save_used_regions();
+
+  allocate_stacks(rp);
+
+  mark_sweep_phase1(clear_all_softrefs);
+
+  mark_sweep_phase2();
+
+  // Don't add any more derived pointers during phase3
+#if COMPILER2_OR_JVMCI
+  assert(DerivedPointerTable::is_active(), "Sanity");
+  DerivedPointerTable::set_active(false);
+#endif
+
+  mark_sweep_phase3();
+
+  mark_sweep_phase4();
+
+  SharedRestorePreservedMarksTaskExecutor task_executor(workers());
+  _preserved_marks_set.restore(&task_executor);
+
+  // Set saved marks for allocation profiler (and other things? -- dld)
+  // (Should this be in general part?)
+  heap->save_marks();
+
+  deallocate_stacks();
+
+  // If compaction completely evacuated the young generation then we
+  // can clear the card table.  Otherwise, we must invalidate
+  // it (consider all cards dirty).
+  CardTableRS* rs = heap->rem_set();
+  Generation* old_gen = heap->old_gen();
+
+  // Clear/invalidate below make use of the "prev_used_regions" saved earlier.
+  if (heap->young_gen()->used() == 0) {
+    // We've evacuated the young generation.
+    rs->clear_into_younger(old_gen);
+  } else {
+    // Invalidate the cards corresponding to the currently used
+    // region and clear those corresponding to the evacuated region.
+    rs->invalidate_or_clear(old_gen);
+  }
+
+  CodeCache::gc_epilogue();
+  JvmtiExport::gc_epilogue();
+
+  // refs processing: clean slate
+  set_ref_processor(NULL);
+
+  // Update heap occupancy information which is used as
+  // input to soft ref clearing policy at the next gc.
+  Universe::update_heap_info_at_gc();
+
+  // Update time of last gc for all generations we collected
+  // (which currently is all the generations in the heap).
+  // We need to use a monotonically non-decreasing time in ms
+  // or we will see time-warp warnings and os::javaTimeMillis()
+  // does not guarantee monotonicity.
+  jlong now = os::javaTimeNanos() / NANOSECS_PER_MILLISEC;
+  heap->update_time_of_last_gc(now);
+
+  heap->trace_heap_after_gc(_gc_tracer);
+}
+
+void CMSParMarkSweep::allocate_stacks(ReferenceProcessor* rp) {
+  WorkGang* gang = workers();
+  uint active_workers =
+       AdaptiveSizePolicy::calc_active_workers(gang->total_workers(),
+                                               gang->active_workers(),
+                                               Threads::number_of_non_daemon_threads());
+  _num_workers = gang->update_active_workers(active_workers);
+  log_info(gc, task)("Using %u workers of %u for full compaction", _num_workers, gang->total_workers());
+
+  if (_thread_states == NULL) {
+    // The stacks are kept between collections, as ParNew does.
+    uint total_workers = gang->total_workers();
+    Generation* old_gen = CMSHeap::heap()->old_gen();
+    _marking_stacks = new CMSParMarkingStackSet(total_workers);
+    _objarray_stacks = new CMSParObjArrayStackSet(total_workers);
+    _thread_states = NEW_C_HEAP_ARRAY(CMSParMarkSweepThreadState*, total_workers, mtGC);
+    for (uint i = 0; i < total_workers; i++) {
+      _thread_states[i] = new CMSParMarkSweepThreadState(i, old_gen);
+      _marking_stacks->register_queue(i, _thread_states[i]->marking_stack());
+      _objarray_stacks->register_queue(i, _thread_states[i]->objarray_stack());
+    }
+  }
+
+  _preserved_marks_set.init(_num_workers);
+  for (uint i = 0; i < _num_workers; i++) {
+    _thread_states[i]->set_up(rp, _preserved_marks_set.get(i));
+  }
+}
+
+void CMSParMarkSweep::deallocate_stacks() {
+  for (uint i = 0; i < _num_workers; i++) {
+    assert(_thread_states[i]->marking_stacks_empty(), "Marking should have completed");
+    _thread_states[i]->set_up(NULL, NULL);
+  }
+  _preserved_marks_set.reclaim();
+
+  FREE_C_HEAP_ARRAY(CFLSCompactionRegion, _regions);
+  _regions = NULL;
+  _num_regions = 0;
+}
+
+class CMSParMarkTask : public AbstractGangTask {
+  StrongRootsScope*       _strong_roots_scope;
+  ParallelTaskTerminator* _terminator;
+
+ public:
+  CMSParMarkTask(StrongRootsScope* strong_roots_scope, ParallelTaskTerminator* terminator) :
+    AbstractGangTask("CMSParMarkSweep marking"),
+    _strong_roots_scope(strong_roots_scope),
+    _terminator(terminator) { }
+
+  void work(uint worker_id) {
+    CMSParMarkSweepThreadState* state = CMSParMarkSweep::thread_state(worker_id);
+    CMSHeap::heap()->full_process_roots(_strong_roots_scope,
+                                        false, // not the adjust phase
+                                        GenCollectedHeap::SO_None,
+                                        ClassUnloading, // only strong roots if ClassUnloading
+                                                        // is enabled
+                                        state->follow_root_closure(),
+                                        state->follow_cld_closure());
+    state->steal_and_follow(_terminator);
+  }
+};
+
+void CMSParMarkSweep::mark_sweep_phase1(bool clear_all_softrefs) {
+  // Recursively traverse all live objects and mark them
+  GCTraceTime(Info, gc, phases) tm("Phase 1: Mark live objects", _gc_timer);
+
+  // Need new claim bits before marking starts.
+  ClassLoaderDataGraph::clear_claimed_marks();
+
+  {
+    StrongRootsScope srs(_num_workers);
+    TaskTerminator terminator(_num_workers, _marking_stacks);
+    CMSParMarkTask task(&srs, terminator.terminator());
+    workers()->run_task(&task);
+  }
+
+  // Process reference objects found during marking.  Processing is
+  // single threaded; the marking it causes is done with the stacks of
+  // the first worker.
+  {
+    GCTraceTime(Debug, gc, phases) tm_m("Reference Processing", gc_timer());
+
+    CMSParMarkSweepThreadState* state = thread_state(0);
+    ref_processor()->setup_policy(clear_all_softrefs);
+    ReferenceProcessorPhaseTimes pt(_gc_timer, ref_processor()->num_q());
+    const ReferenceProcessorStats& stats =
+      ref_processor()->process_discovered_references(
+        &is_alive, state->mark_and_push_closure(), state->follow_stack_closure(), NULL, &pt);
+    pt.print_all_references();
+    gc_tracer()->report_gc_reference_stats(stats);
+  }
+
+  // This is the point where the entire marking should have completed.
+  assert(thread_state(0)->marking_stacks_empty(), "Marking should have completed");
+
+  {
+    GCTraceTime(Debug, gc, phases) tm_m("Weak Processing", gc_timer());
+    WeakProcessor::weak_oops_do(&is_alive, &do_nothing_cl);
+    if (StringDedup::is_enabled()) {
+      StringDedup::unlink(&is_alive);
+    }
+  }
+
+  {
+    GCTraceTime(Debug, gc, phases) tm_m("Class Unloading", gc_timer());
+
+    // Unload classes and purge the SystemDictionary.
+    bool purged_class = SystemDictionary::do_unloading(&is_alive, gc_timer());
+
+    // Unload nmethods.
+    CodeCache::do_unloading(&is_alive, purged_class);
+
+    // Prune dead klasses from subklass/sibling/implementor lists.
+    Klass::clean_weak_klass_links(&is_alive);
+  }
+
+  // Unreferenced symbols are removed concurrently by the ServiceThread.
+  SymbolTable::trigger_cleanup();
+
+  gc_tracer()->report_object_count_after_gc(&is_alive);
+}
+
+// Hands out the regions of the CMS space to the workers.
+class CMSParRegionTask : public AbstractGangTask {
+  volatile uint _next_region;
+
+ protected:
+  CMSParRegionTask(const char* name) : AbstractGangTask(name), _next_region(0) { }
+
+  CFLSCompactionRegion* claim_region() {
+    uint i = Atomic::add(1u, &_next_region) - 1;
+    return i < CMSParMarkSweep::num_regions() ? CMSParMarkSweep::region(i) : NULL;
+  }
+};
+
+class CMSParForwardTask : public CMSParRegionTask {
+ public:
+  CMSParForwardTask() : CMSParRegionTask("CMSParMarkSweep forwarding") { }
+
+  void work(uint worker_id) {
+    CompactibleFreeListSpace* space = CMSParMarkSweep::cms_space();
+    CFLSCompactionRegion* region;
+    while ((region = claim_region()) != NULL) {
+      space->prepare_region_for_compaction(region);
+    }
+  }
+};
+
+void CMSParMarkSweep::compute_regions() {
+  // Too many regions fragment the free space, too few of them balance
+  // the work badly when the live data is unevenly spread.
+  const uint   RegionsPerWorker = 2;
+  const size_t MinRegionWords = 4 * M / HeapWordSize;
+
+  CompactibleFreeListSpace* space = cms_space();
+  const uint max_regions = _num_workers * RegionsPerWorker;
+  const size_t space_words = pointer_delta(space->end(), space->bottom());
+  const size_t region_words = MAX2(space_words / max_regions, MinRegionWords);
+
+  _regions = NEW_C_HEAP_ARRAY(CFLSCompactionRegion, max_regions, mtGC);
+  _num_regions = 0;
+
+  HeapWord* start = space->bottom();
+  for (uint i = 1; i < max_regions; i++) {
+    size_t offset = i * region_words;
+    if (offset >= space_words) {
+      break;
+    }
+    // Regions start at block boundaries, the block containing the
+    // nominal boundary belongs to the preceding region.
+    HeapWord* boundary = (HeapWord*)space->block_start(space->bottom() + offset);
+    if (boundary > start) {
+      _regions[_num_regions++].set(start, boundary);
+      start = boundary;
+    }
+  }
+  _regions[_num_regions++].set(start, space->end());
+}
+
+void CMSParMarkSweep::mark_sweep_phase2() {
+  // Now all live objects are marked, compute the new object addresses.
+  GCTraceTime(Info, gc, phases) tm("Phase 2: Compute new object addresses", _gc_timer);
+
+  CMSHeap* heap = CMSHeap::heap();
+  CompactibleFreeListSpace* space = cms_space();
+
+  compute_regions();
+  {
+    CMSParForwardTask task;
+    workers()->run_task(&task);
+  }
+
+  // Every region but the last one leaves its free space behind.
+  space->clear_compaction_gaps();
+  for (uint i = 0; i < _num_regions - 1; i++) {
+    MemRegion gap = _regions[i].free_region();
+    if (!gap.is_empty()) {
+      space->add_compaction_gap(gap);
+    }
+  }
+  log_debug(gc, phases)("Compacting %u regions, " SIZE_FORMAT "K free between regions",
+                        _num_regions, space->compaction_gaps_word_size() * HeapWordSize / K);
+
+  // The young generation is compacted into the free space at the top of
+  // the CMS space, and then into itself.
+  CompactPoint cp(heap->old_gen());
+  cp.space = space;
+  cp.threshold = space->end();
+  space->set_compaction_top(_regions[_num_regions - 1]._compaction_top);
+  heap->young_gen()->prepare_for_compaction(&cp);
+}
+
+class CMSParAdjustPointersTask : public CMSParRegionTask {
+  StrongRootsScope* _strong_roots_scope;
+
+ public:
+  CMSParAdjustPointersTask(StrongRootsScope* strong_roots_scope) :
+    CMSParRegionTask("CMSParMarkSweep pointer adjustment"),
+    _strong_roots_scope(strong_roots_scope) { }
+
+  void work(uint worker_id) {
+    CMSHeap* heap = CMSHeap::heap();
+    heap->full_process_roots(_strong_roots_scope,
+                             true,  // this is the adjust phase
+                             GenCollectedHeap::SO_AllCodeCache,
+                             false, // all roots
+                             &MarkSweep::adjust_pointer_closure,
+                             &MarkSweep::adjust_cld_closure);
+
+    CMSParMarkSweep::preserved_marks(worker_id)->adjust_during_full_gc();
+
+    CompactibleFreeListSpace* space = CMSParMarkSweep::cms_space();
+    CFLSCompactionRegion* region;
+    while ((region = claim_region()) != NULL) {
+      space->adjust_pointers_in_region(region);
+    }
+  }
+};
+
+void CMSParMarkSweep::mark_sweep_phase3() {
+  CMSHeap* heap = CMSHeap::heap();
+
+  // Adjust the pointers to reflect the new locations
+  GCTraceTime(Info, gc, phases) tm("Phase 3: Adjust pointers", gc_timer());
+
+  // Need new claim bits for the pointer adjustment tracing.
+  ClassLoaderDataGraph::clear_claimed_marks();
+
+  // Because the closure below is created statically, we cannot
+  // use OopsInGenClosure constructor which takes a generation,
+  // as the Universe has not been created when the static constructors
+  // are run.
+  adjust_pointer_closure.set_orig_generation(heap->old_gen());
+
+  {
+    StrongRootsScope srs(_num_workers);
+    CMSParAdjustPointersTask task(&srs);
+    workers()->run_task(&task);
+  }
+
+  heap->gen_process_weak_roots(&adjust_pointer_closure);
+
+  heap->young_gen()->adjust_pointers();
+}
+
+class CMSParCompactTask : public CMSParRegionTask {
+ public:
+  CMSParCompactTask() : CMSParRegionTask("CMSParMarkSweep compaction") { }
+
+  void work(uint worker_id) {
+    CompactibleFreeListSpace* space = CMSParMarkSweep::cms_space();
+    CFLSCompactionRegion* region;
+    while ((region = claim_region()) != NULL) {
+      space->compact_region(region);
+    }
+  }
+};
+
+void CMSParMarkSweep::mark_sweep_phase4() {
+  // All pointers are now adjusted, move objects accordingly
+  GCTraceTime(Info, gc, phases) tm("Phase 4: Move objects", _gc_timer);
+
+  {
+    CMSParCompactTask task;
+    workers()->run_task(&task);
+  }
+
+  // The objects of the young generation only move after the space they
+  // are moving to in the CMS space has been vacated.
+  CMSHeap::heap()->young_gen()->compact();
+
+  cms_space()->reset_after_compaction();
+}
@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) 2018, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#ifndef SHARE_VM_GC_CMS_CMSPARMARKSWEEP_HPP
+#define SHARE_VM_GC_CMS_CMSPARMARKSWEEP_HPP
+
+#include "gc/serial/markSweep.hpp"
+#include "gc/shared/preservedMarks.hpp"
+#include "gc/shared/taskqueue.hpp"
+
+class CFLSCompactionRegion;
+class CMSParMarkSweepThreadState;
+class CompactibleFreeListSpace;
+class WorkGang;
+
+typedef OverflowTaskQueue<oop, mtGC>                   CMSParMarkingStack;
+typedef GenericTaskQueueSet<CMSParMarkingStack, mtGC>  CMSParMarkingStackSet;
+typedef OverflowTaskQueue<ObjArrayTask, mtGC>          CMSParObjArrayStack;
+typedef GenericTaskQueueSet<CMSParObjArrayStack, mtGC> CMSParObjArrayStackSet;
+
+// CMSParMarkSweep is a parallel version of GenMarkSweep, used for the
+// compacting collection that CMS falls back to on a concurrent mode
+// failure.  Marking and pointer adjustment are done by the ParNew worker
+// gang, with work stealing during marking.  The CMS space is split into
+// block aligned regions that are forwarded, adjusted and compacted in
+// parallel, each region sliding its live objects down to its own start.
+// The free space left at the end of each region is returned to the free
+// lists of the space when it is reset after the compaction.  The young
+// generation is compacted serially, into the free space at the top of the
+// CMS space first, as with GenMarkSweep.
+class CMSParMarkSweep : public MarkSweep {
+ private:
+  // Number of workers taking part in the current collection.
+  static uint                        _num_workers;
+  // Per worker marking state, created on first use.
+  static CMSParMarkSweepThreadState** _thread_states;
+  static CMSParMarkingStackSet*      _marking_stacks;
+  static CMSParObjArrayStackSet*     _objarray_stacks;
+  static PreservedMarksSet           _preserved_marks_set;
+
+  // Regions of the CMS space that are compacted independently.
+  static CFLSCompactionRegion*       _regions;
+  static uint                        _num_regions;
+
+ public:
+  // Whether the compacting collection of a CMS heap is done in parallel.
+  static bool should_use();
+
+  static void invoke_at_safepoint(ReferenceProcessor* rp, bool clear_all_softrefs);
+
+  static uint num_workers()                  { return _num_workers; }
+  static CMSParMarkSweepThreadState* thread_state(uint i);
+  static CMSParMarkingStackSet* marking_stacks()   { return _marking_stacks; }
+  static CMSParObjArrayStackSet* objarray_stacks() { return _objarray_stacks; }
+  static PreservedMarks* preserved_marks(uint i)   { return _preserved_marks_set.get(i); }
+
+  static uint num_regions()                  { return _num_regions; }
+  static CFLSCompactionRegion* region(uint i);
+
+  static CompactibleFreeListSpace* cms_space();
+
+ private:
+  static WorkGang* workers();
+
+  // Mark live objects
+  static void mark_sweep_phase1(bool clear_all_softrefs);
+  // Calculate new addresses
+  static void mark_sweep_phase2();
+  // Update pointers
+  static void mark_sweep_phase3();
+  // Move objects to new positions
+  static void mark_sweep_phase4();
+
+  // Split the CMS space into the regions compacted in parallel.
+  static void compute_regions();
+
+  // Temporary data structures for traversal and storing/restoring marks
+  static void allocate_stacks(ReferenceProcessor* rp);
+  static void deallocate_stacks();
+};
+
+#endif // SHARE_VM_GC_CMS_CMSPARMARKSWEEP_HPP
@@ -92,6 +92,7 @@ CompactibleFreeListSpace::CompactibleFreeListSpace(BlockOffsetSharedArray* bs, M
                     CMSRescanMultiple),
   _marking_task_size(CardTable::card_size_in_words * BitsPerWord *
                     CMSConcMarkMultiple),
+  _compaction_gaps(NULL),
   _collector(NULL),
   _preconsumptionDirtyCardClosure(NULL)
 {
@@ -268,6 +269,13 @@ void CompactibleFreeListSpace::reset_after_compaction() {
   // Reset the space to the new reality - one free chunk.
   MemRegion mr(compaction_top(), end());
   reset(mr);
+  // Add back the free space between independently compacted regions.
+  if (_compaction_gaps != NULL) {
+    for (int i = 0; i < _compaction_gaps->length(); i++) {
+      MemRegion gap = _compaction_gaps->at(i);
+      addChunkAndRepairOffsetTable(gap.start(), gap.word_size(), true /* coalesced */);
+    }
+  }
   // Now refill the linear allocation block(s) if possible.
   refillLinearAllocBlocksIfNeeded();
 }
@@ -1967,6 +1975,145 @@ void CompactibleFreeListSpace::compact() {
   scan_and_compact(this);
 }
 
+// A copy of scan_and_forward() restricted to one region, without a dead
+// spacer (CFLS allows no dead space) and without switching compaction
+// spaces: the live objects of a region always fit into the region itself.
+void CompactibleFreeListSpace::prepare_region_for_compaction(CFLSCompactionRegion* region) {
+  assert(!BlockOffsetArrayUseUnallocatedBlock,
+         "Updates of the unallocated block are not MT safe");
+  const intx interval = PrefetchScanIntervalInBytes;
+
+  HeapWord* const scan_limit = region->_end;
+  HeapWord* compact_top = region->_start;
+  HeapWord* end_of_live = region->_start;
+  HeapWord* first_dead = NULL;
+  HeapWord* cur_obj = region->_start;
+
+  while (cur_obj < scan_limit) {
+    if (scanned_block_is_obj(cur_obj) && oop(cur_obj)->is_gc_marked()) {
+      Prefetch::write(cur_obj, interval);
+      size_t size = scanned_block_size(cur_obj);
+      if (cur_obj != compact_top) {
+        oop(cur_obj)->forward_to(oop(compact_top));
+      } else {
+        oop(cur_obj)->init_mark();
+      }
+      // Update the offset table for where the object will be once the
+      // compaction phase finishes, as forward() does.
+      _bt.single_block(compact_top, size);
+      compact_top += size;
+      cur_obj += size;
+      end_of_live = cur_obj;
+    } else {
+      // Run over all the contiguous dead blocks and store a pointer to
+      // the next live object in the first one.
+      HeapWord* end = cur_obj;
+      do {
+        Prefetch::write(end, interval);
+        end += scanned_block_size(end);
+      } while (end < scan_limit && (!scanned_block_is_obj(end) || !oop(end)->is_gc_marked()));
+      *(HeapWord**)cur_obj = end;
+      if (first_dead == NULL) {
+        first_dead = cur_obj;
+      }
+      cur_obj = end;
+    }
+  }
+
+  assert(cur_obj == scan_limit, "just checking");
+  region->_compaction_top = compact_top;
+  region->_end_of_live = end_of_live;
+  region->_first_dead = first_dead != NULL ? first_dead : end_of_live;
+}
+
+void CompactibleFreeListSpace::adjust_pointers_in_region(CFLSCompactionRegion* region) {
+  HeapWord* cur_obj = region->_start;
+  HeapWord* const end_of_live = region->_end_of_live;
+  HeapWord* const first_dead = region->_first_dead;
+
+  assert(first_dead <= end_of_live, "Stands to reason, no?");
+
+  const intx interval = PrefetchScanIntervalInBytes;
+
+  while (cur_obj < end_of_live) {
+    Prefetch::write(cur_obj, interval);
+    if (cur_obj < first_dead || oop(cur_obj)->is_gc_marked()) {
+      size_t size = MarkSweep::adjust_pointers(oop(cur_obj));
+      cur_obj += adjust_obj_size(size);
+    } else {
+      // cur_obj is not a live object, instead it points at the next live object
+      HeapWord* next = *(HeapWord**)cur_obj;
+      assert(next > cur_obj, "we should be moving forward through memory");
+      cur_obj = next;
+    }
+  }
+
+  assert(cur_obj == end_of_live, "just checking");
+}
+
+void CompactibleFreeListSpace::compact_region(CFLSCompactionRegion* region) {
+  HeapWord* const end_of_live = region->_end_of_live;
+  if (region->_first_dead == end_of_live) {
+    // Nothing to compact, all live objects are left in place.
+    return;
+  }
+
+  const intx scan_interval = PrefetchScanIntervalInBytes;
+  const intx copy_interval = PrefetchCopyIntervalInBytes;
+
+  // The objects before _first_dead do not move.  A pointer to the first
+  // live object after them is stored at the memory location for _first_dead.
+  HeapWord* cur_obj = *(HeapWord**)region->_first_dead;
+
+  while (cur_obj < end_of_live) {
+    if (!oop(cur_obj)->is_gc_marked()) {
+      // The first word of the dead block contains a pointer to the next live object.
+      HeapWord* next = *(HeapWord**)cur_obj;
+      assert(next > cur_obj, "we should be moving forward through memory");
+      cur_obj = next;
+    } else {
+      Prefetch::read(cur_obj, scan_interval);
+
+      size_t size = obj_size(cur_obj);
+      HeapWord* compaction_top = (HeapWord*)oop(cur_obj)->forwardee();
+      assert(compaction_top >= region->_start && compaction_top < cur_obj,
+             "objects only slide down within their region");
+
+      Prefetch::write(compaction_top, copy_interval);
+
+      Copy::aligned_conjoint_words(cur_obj, compaction_top, size);
+      oop(compaction_top)->init_mark();
+      assert(oop(compaction_top)->klass() != NULL, "should have a class");
+
+      cur_obj += size;
+    }
+  }
+}
+
+void CompactibleFreeListSpace::add_compaction_gap(MemRegion mr) {
+  assert(!mr.is_empty() && mr.word_size() >= MinChunkSize, "Chunk size is too small");
+  if (_compaction_gaps == NULL) {
+    _compaction_gaps = new (ResourceObj::C_HEAP, mtGC) GrowableArray<MemRegion>(8, true, mtGC);
+  }
+  _compaction_gaps->append(mr);
+}
+
+void CompactibleFreeListSpace::clear_compaction_gaps() {
+  if (_compaction_gaps != NULL) {
+    _compaction_gaps->clear();
+  }
+}
+
+size_t CompactibleFreeListSpace::compaction_gaps_word_size() const {
+  size_t size = 0;
+  if (_compaction_gaps != NULL) {
+    for (int i = 0; i < _compaction_gaps->length(); i++) {
+      size += _compaction_gaps->at(i).word_size();
+    }
+  }
+  return size;
+}
+
 // Fragmentation metric = 1 - [sum of (fbs**2) / (sum of fbs)**2]
 // where fbs is free block sizes
 double CompactibleFreeListSpace::flsFrag() const {
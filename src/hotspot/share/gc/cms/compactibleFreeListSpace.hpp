@@ -33,6 +33,7 @@
 #include "logging/log.hpp"
 #include "memory/binaryTreeDictionary.hpp"
 #include "memory/freeList.hpp"
+#include "utilities/growableArray.hpp"
 
 // Classes in support of keeping track of promotions into a non-Contiguous
 // space, in this case a CompactibleFreeListSpace.
@@ -67,6 +68,29 @@ class LinearAllocBlock {
   void print_on(outputStream* st) const;
 };
 
+// A part of a CompactibleFreeListSpace, starting and ending at block
+// boundaries, that is compacted independently of the rest of the space
+// by the parallel compacting collector (see CMSParMarkSweep).
+class CFLSCompactionRegion {
+ public:
+  CFLSCompactionRegion() : _start(NULL), _end(NULL), _compaction_top(NULL),
+    _first_dead(NULL), _end_of_live(NULL) {}
+  void set(HeapWord* start, HeapWord* end) {
+    _start = start;
+    _end = end;
+    _compaction_top = start;
+    _first_dead = start;
+    _end_of_live = start;
+  }
+  HeapWord* _start;
+  HeapWord* _end;
+  HeapWord* _compaction_top;  // Where the live data of the region ends after compaction
+  HeapWord* _first_dead;      // The first dead block, or _end_of_live if there is none
+  HeapWord* _end_of_live;     // One word beyond the last live object
+
+  MemRegion free_region() const { return MemRegion(_compaction_top, _end); }
+};
+
 // Concrete subclass of CompactibleSpace that implements
 // a free list space, such as used in the concurrent mark sweep
 // generation.
@@ -102,6 +126,11 @@ class CompactibleFreeListSpace: public CompactibleSpace {
 
   BlockOffsetArrayNonContigSpace _bt;
 
+  // Free space left at the end of the regions that were compacted
+  // independently by a parallel compaction; returned to the free lists
+  // by reset_after_compaction() along with the space above compaction_top().
+  GrowableArray<MemRegion>* _compaction_gaps;
+
   CMSCollector* _collector;
   ConcurrentMarkSweepGeneration* _old_gen;
 
@@ -538,6 +567,19 @@ class CompactibleFreeListSpace: public CompactibleSpace {
   // space has been done.
   virtual void reset_after_compaction();
 
+  // Support for parallel compaction (CMSParMarkSweep).  Each region
+  // slides its live objects down to its own start and records where they
+  // end in the region.  The block offset table is updated only for the
+  // cards of the region, so that different regions can be processed by
+  // different threads.
+  void prepare_region_for_compaction(CFLSCompactionRegion* region);
+  void adjust_pointers_in_region(CFLSCompactionRegion* region);
+  void compact_region(CFLSCompactionRegion* region);
+  // Record the free space left at the end of a compacted region.
+  void add_compaction_gap(MemRegion mr);
+  void clear_compaction_gaps();
+  size_t compaction_gaps_word_size() const;
+
   // Debugging support.
   void print()                            const;
   void print_on(outputStream* st)         const;
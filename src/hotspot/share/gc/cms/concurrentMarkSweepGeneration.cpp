@@ -24,13 +24,13 @@
 
 #include "precompiled.hpp"
 #include "classfile/classLoaderData.hpp"
-#include "classfile/stringTable.hpp"
 #include "classfile/symbolTable.hpp"
 #include "classfile/systemDictionary.hpp"
 #include "code/codeCache.hpp"
 #include "gc/cms/cmsCollectorPolicy.hpp"
 #include "gc/cms/cmsHeap.hpp"
 #include "gc/cms/cmsOopClosures.inline.hpp"
+#include "gc/cms/cmsParMarkSweep.hpp"
 #include "gc/cms/compactibleFreeListSpace.hpp"
 #include "gc/cms/concurrentMarkSweepGeneration.inline.hpp"
 #include "gc/cms/concurrentMarkSweepThread.hpp"
@@ -54,6 +54,7 @@
 #include "gc/shared/isGCActiveMark.hpp"
 #include "gc/shared/referencePolicy.hpp"
 #include "gc/shared/strongRootsScope.hpp"
+#include "gc/shared/stringDedup.hpp"
 #include "gc/shared/taskqueue.inline.hpp"
 #include "gc/shared/weakProcessor.hpp"
 #include "logging/log.hpp"
@@ -1530,6 +1531,8 @@ void CMSCollector::do_compaction_work(bool clear_all_soft_refs) {
 
   GCTraceTime(Trace, gc, phases) t("CMS:MSC");
 
+  const bool parallel_compaction = CMSParMarkSweep::should_use();
+
   // Temporarily widen the span of the weak reference processing to
   // the entire heap.
   MemRegion new_span(CMSHeap::heap()->reserved_region());
@@ -1541,8 +1544,9 @@ void CMSCollector::do_compaction_work(bool clear_all_soft_refs) {
   ReferenceProcessorMTProcMutator rp_mut_mt_processing(ref_processor(), false);
   // Temporarily make refs discovery atomic
   ReferenceProcessorAtomicMutator rp_mut_atomic(ref_processor(), true);
-  // Temporarily make reference _discovery_ single threaded (non-MT)
-  ReferenceProcessorMTDiscoveryMutator rp_mut_discovery(ref_processor(), false);
+  // Temporarily make reference _discovery_ single threaded (non-MT), unless
+  // the references are discovered by the workers of the parallel compaction.
+  ReferenceProcessorMTDiscoveryMutator rp_mut_discovery(ref_processor(), parallel_compaction);
 
   ref_processor()->set_enqueuing_is_done(false);
   ref_processor()->enable_discovery();
@@ -1570,22 +1574,32 @@ void CMSCollector::do_compaction_work(bool clear_all_soft_refs) {
                                             _intra_sweep_estimate.padded_average());
   }
 
-  GenMarkSweep::invoke_at_safepoint(ref_processor(), clear_all_soft_refs);
+  // Forget about the free space left by an earlier parallel compaction.
+  _cmsGen->cmsSpace()->clear_compaction_gaps();
+  if (parallel_compaction) {
+    CMSParMarkSweep::invoke_at_safepoint(ref_processor(), clear_all_soft_refs);
+  } else {
+    GenMarkSweep::invoke_at_safepoint(ref_processor(), clear_all_soft_refs);
+  }
   #ifdef ASSERT
     CompactibleFreeListSpace* cms_space = _cmsGen->cmsSpace();
     size_t free_size = cms_space->free();
+    size_t gaps_size = cms_space->compaction_gaps_word_size() * HeapWordSize;
     assert(free_size ==
            pointer_delta(cms_space->end(), cms_space->compaction_top())
-           * HeapWordSize,
-      "All the free space should be compacted into one chunk at top");
-    assert(cms_space->dictionary()->total_chunk_size(
-                                      debug_only(cms_space->freelistLock())) == 0 ||
-           cms_space->totalSizeInIndexedFreeLists() == 0,
-      "All the free space should be in a single chunk");
-    size_t num = cms_space->totalCount();
-    assert((free_size == 0 && num == 0) ||
-           (free_size > 0  && (num == 1 || num == 2)),
-         "There should be at most 2 free chunks after compaction");
+           * HeapWordSize + gaps_size,
+      "All the free space should be compacted into one chunk at top, "
+      "or be left between the regions of a parallel compaction");
+    if (gaps_size == 0) {
+      assert(cms_space->dictionary()->total_chunk_size(
+                                        debug_only(cms_space->freelistLock())) == 0 ||
+             cms_space->totalSizeInIndexedFreeLists() == 0,
+        "All the free space should be in a single chunk");
+      size_t num = cms_space->totalCount();
+      assert((free_size == 0 && num == 0) ||
+             (free_size > 0  && (num == 1 || num == 2)),
+           "There should be at most 2 free chunks after compaction");
+    }
   #endif // ASSERT
   _collectorState = Resetting;
   assert(_restart_addr == NULL,
@@ -2713,9 +2727,12 @@ bool ConcurrentMarkSweepGeneration::expand_and_ensure_spooling_space(
 
 void ConcurrentMarkSweepGeneration::shrink(size_t bytes) {
   // Only shrink if a compaction was done so that all the free space
-  // in the generation is in a contiguous block at the end.
+  // in the generation is in a contiguous block at the end.  A parallel
+  // compaction also leaves free space between its regions, which
+  // cannot be given back.
   if (did_compact()) {
-    CardGeneration::shrink(bytes);
+    size_t contiguous_free = pointer_delta(cmsSpace()->end(), cmsSpace()->compaction_top(), 1);
+    CardGeneration::shrink(MIN2(bytes, contiguous_free));
   }
 }
 
@@ -4296,7 +4313,7 @@ class CMSParRemarkTask: public CMSParMarkTask {
 
   // The per-thread work queues, available here for stealing.
   OopTaskQueueSet*       _task_queues;
-  ParallelTaskTerminator _term;
+  TaskTerminator         _term;
   StrongRootsScope*      _strong_roots_scope;
 
  public:
@@ -4318,7 +4335,7 @@ class CMSParRemarkTask: public CMSParMarkTask {
 
   OopTaskQueue* work_queue(int i) { return task_queues()->queue(i); }
 
-  ParallelTaskTerminator* terminator() { return &_term; }
+  ParallelTaskTerminator* terminator() { return _term.terminator(); }
   uint n_workers() { return _n_workers; }
 
   void work(uint worker_id);
@@ -5006,11 +5023,11 @@ void CMSCollector::do_remark_non_parallel() {
 ////////////////////////////////////////////////////////
 class AbstractGangTaskWOopQueues : public AbstractGangTask {
   OopTaskQueueSet*       _queues;
-  ParallelTaskTerminator _terminator;
+  TaskTerminator         _terminator;
  public:
   AbstractGangTaskWOopQueues(const char* name, OopTaskQueueSet* queues, uint n_threads) :
     AbstractGangTask(name), _queues(queues), _terminator(n_threads, _queues) {}
-  ParallelTaskTerminator* terminator() { return &_terminator; }
+  ParallelTaskTerminator* terminator() { return _terminator.terminator(); }
   OopTaskQueueSet* queues() { return _queues; }
 };
 
@@ -5143,7 +5160,7 @@ void CMSRefProcTaskProxy::do_work_steal(int i,
   log_develop_trace(gc, task)("\t(%d: stole %d oops)", i, num_steals);
 }
 
-void CMSRefProcTaskExecutor::execute(ProcessTask& task)
+void CMSRefProcTaskExecutor::execute(ProcessTask& task, uint ergo_workers)
 {
   CMSHeap* heap = CMSHeap::heap();
   WorkGang* workers = heap->workers();
@@ -5228,6 +5245,9 @@ void CMSCollector::refProcessingWork() {
   {
     GCTraceTime(Debug, gc, phases) t("Weak Processing", _gc_timer_cm);
     WeakProcessor::weak_oops_do(&_is_alive_closure, &do_nothing_cl);
+    if (StringDedup::is_enabled()) {
+      StringDedup::unlink(&_is_alive_closure);
+    }
   }
 
   if (should_unload_classes()) {
@@ -5244,17 +5264,8 @@ void CMSCollector::refProcessingWork() {
       Klass::clean_weak_klass_links(&_is_alive_closure);
     }
 
-    {
-      GCTraceTime(Debug, gc, phases) t("Scrub Symbol Table", _gc_timer_cm);
-      // Clean up unreferenced symbols in symbol table.
-      SymbolTable::unlink();
-    }
-
-    {
-      GCTraceTime(Debug, gc, phases) t("Scrub String Table", _gc_timer_cm);
-      // Delete entries for dead interned strings.
-      StringTable::unlink(&_is_alive_closure);
-    }
+    // Unreferenced symbols are removed concurrently by the ServiceThread.
+    SymbolTable::trigger_cleanup();
   }
 
   // Restore any preserved marks as a result of mark stack or
@@ -5465,6 +5476,11 @@ void CMSCollector::sweepWork(ConcurrentMarkSweepGeneration* old_gen) {
                                           _intra_sweep_estimate.padded_average());
   old_gen->setNearLargestChunk();
 
+  // The fragmentation metric walks all the free lists and the
+  // dictionary, so only compute it when someone will see it.
+  const bool log_frag = log_is_enabled(Debug, gc, sweep);
+  const double frag_before = log_frag ? old_gen->cmsSpace()->flsFrag() : 0.0;
+
   {
     SweepClosure sweepClosure(this, old_gen, &_markBitMap, CMSYield);
     old_gen->cmsSpace()->blk_iterate_careful(&sweepClosure);
@@ -5474,6 +5490,12 @@ void CMSCollector::sweepWork(ConcurrentMarkSweepGeneration* old_gen) {
     // end-of-sweep-census below will be off by a little bit.
   }
   old_gen->cmsSpace()->sweep_completed();
+  if (log_frag) {
+    CompactibleFreeListSpace* cms_space = old_gen->cmsSpace();
+    log_debug(gc, sweep)("Fragmentation before sweep %1.4f, after sweep %1.4f, free " SIZE_FORMAT "K, largest free block " SIZE_FORMAT "K",
+                         frag_before, cms_space->flsFrag(), cms_space->free() / K,
+                         cms_space->dictionary()->max_chunk_size() * HeapWordSize / K);
+  }
   old_gen->cmsSpace()->endSweepFLCensus(sweep_count());
   if (should_unload_classes()) {                // unloaded classes this cycle,
     _concurrent_cycles_since_last_unload = 0;   // ... reset count
@@ -487,7 +487,7 @@ public:
   { }
 
   // Executes a task using worker threads.
-  virtual void execute(ProcessTask& task);
+  virtual void execute(ProcessTask& task, uint ergo_workers);
   virtual void execute(EnqueueTask& task);
 private:
   CMSCollector& _collector;
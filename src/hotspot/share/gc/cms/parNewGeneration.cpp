@@ -45,6 +45,7 @@
 #include "gc/shared/space.hpp"
 #include "gc/shared/spaceDecorator.hpp"
 #include "gc/shared/strongRootsScope.hpp"
+#include "gc/shared/stringDedup.hpp"
 #include "gc/shared/taskqueue.inline.hpp"
 #include "gc/shared/weakProcessor.hpp"
 #include "gc/shared/workgroup.hpp"
@@ -805,7 +806,7 @@ public:
   }
 };
 
-void ParNewRefProcTaskExecutor::execute(ProcessTask& task) {
+void ParNewRefProcTaskExecutor::execute(ProcessTask& task, uint ergo_workers) {
   CMSHeap* gch = CMSHeap::heap();
   WorkGang* workers = gch->workers();
   assert(workers != NULL, "Need parallel worker threads.");
@@ -935,11 +936,11 @@ void ParNewGeneration::collect(bool   full,
 
   // Always set the terminator for the active number of workers
   // because only those workers go through the termination protocol.
-  ParallelTaskTerminator _term(active_workers, task_queues());
+  TaskTerminator _term(active_workers, task_queues());
   ParScanThreadStateSet thread_state_set(active_workers,
                                          *to(), *this, *_old_gen, *task_queues(),
                                          _overflow_stacks, _preserved_marks_set,
-                                         desired_plab_sz(), _term);
+                                         desired_plab_sz(), *_term.terminator());
 
   thread_state_set.reset(active_workers, promotion_failed());
 
@@ -1003,6 +1004,9 @@ void ParNewGeneration::collect(bool   full,
   assert(gch->no_allocs_since_save_marks(), "evacuation should be done at this point");
 
   WeakProcessor::weak_oops_do(&is_alive, &keep_alive);
+  if (StringDedup::is_enabled()) {
+    StringDedup::unlink_or_oops_do(&is_alive, &keep_alive);
+  }
 
   // Verify that the usage of keep_alive only forwarded
   // the oops and did not find anything new to copy.
@@ -1219,6 +1223,14 @@ oop ParNewGeneration::copy_to_survivor_space(ParScanThreadState* par_scan_state,
       TASKQUEUE_STATS_ONLY(par_scan_state->taskqueue_stats().record_overflow(0));
     }
 
+    if (StringDedup::is_enabled() && new_obj != old) {
+      // Objects that failed promotion stay in place and are not candidates.
+      StringDedup::enqueue_from_evacuation(true /* from_young */,
+                                           is_in_reserved(new_obj),
+                                           par_scan_state->thread_num(),
+                                           new_obj);
+    }
+
     return new_obj;
   }
 
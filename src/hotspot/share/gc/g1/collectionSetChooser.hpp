@@ -57,11 +57,6 @@ class CollectionSetChooser: public CHeapObj<mtGC> {
   // parallel GC workers.
   uint _first_par_unreserved_idx;
 
-  // If a region has more live bytes than this threshold, it will not
-  // be added to the CSet chooser and will not be a candidate for
-  // collection.
-  size_t _region_live_threshold_bytes;
-
   // The sum of reclaimable bytes over all the regions in the CSet chooser.
   size_t _remaining_reclaimable_bytes;
 
@@ -104,13 +99,20 @@ public:
   void sort_regions();
 
   // Determine whether to add the given region to the CSet chooser or
-  // not. Currently, we skip pinned regions and regions whose live
-  // bytes are over the threshold. Humongous regions may be reclaimed during cleanup.
-  bool should_add(HeapRegion* hr) {
-    assert(hr->is_marked(), "pre-condition");
-    assert(!hr->is_young(), "should never consider young regions");
-    return !hr->is_pinned() &&
-            hr->live_bytes() < _region_live_threshold_bytes;
+  // not. Currently, we skip pinned regions, regions whose live
+  // bytes are over the threshold and regions without a complete
+  // remembered set. Humongous regions may be reclaimed during cleanup.
+  bool should_add(HeapRegion* hr) const;
+
+  // If a region has more live bytes than this threshold, it will not
+  // be added to the CSet chooser and will not be a candidate for
+  // collection.
+  static size_t mixed_gc_live_threshold_bytes() {
+    return HeapRegion::GrainBytes * (size_t) G1MixedGCLiveThresholdPercent / 100;
+  }
+
+  static bool region_occupancy_low_enough_for_evac(size_t live_bytes) {
+    return live_bytes < mixed_gc_live_threshold_bytes();
   }
 
   // Returns the number candidate old regions added
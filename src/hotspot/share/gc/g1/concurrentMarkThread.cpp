@@ -58,7 +58,7 @@ STATIC_ASSERT(ConcurrentGCPhaseManager::UNCONSTRAINED_PHASE <
   expander(MARK_FROM_ROOTS,, "Concurrent Mark From Roots")              \
   expander(BEFORE_REMARK,, NULL)                                        \
   expander(REMARK,, NULL)                                               \
-  expander(CREATE_LIVE_DATA,, "Concurrent Create Live Data")            \
+  expander(REBUILD_REMEMBERED_SETS,, "Concurrent Rebuild Remembered Sets") \
   expander(COMPLETE_CLEANUP,, "Concurrent Complete Cleanup")            \
   expander(CLEANUP_FOR_NEXT_MARK,, "Concurrent Cleanup for Next Mark")  \
   /* */
@@ -350,8 +350,8 @@ void ConcurrentMarkThread::run_service() {
       }
 
       if (!cm()->has_aborted()) {
-        G1ConcPhase p(G1ConcurrentPhase::CREATE_LIVE_DATA, this);
-        cm()->create_live_data();
+        G1ConcPhase p(G1ConcurrentPhase::REBUILD_REMEMBERED_SETS, this);
+        cm()->rebuild_rem_set_concurrently();
       }
 
       double end_time = os::elapsedVTime();
@@ -28,6 +28,7 @@
 #include "gc/g1/g1RemSet.hpp"
 #include "gc/g1/heapRegionRemSet.hpp"
 #include "gc/shared/workgroup.hpp"
+#include "logging/log.hpp"
 #include "runtime/atomic.hpp"
 #include "runtime/mutexLocker.hpp"
 #include "runtime/safepoint.hpp"
@@ -121,7 +122,8 @@ void FreeIdSet::release_par_id(uint id) {
 DirtyCardQueue::DirtyCardQueue(DirtyCardQueueSet* qset, bool permanent) :
   // Dirty card queues are always active, so we create them with their
   // active field set to true.
-  PtrQueue(qset, permanent, true /* active */)
+  PtrQueue(qset, permanent, true /* active */),
+  _completed_buffers(0)
 { }
 
 DirtyCardQueue::~DirtyCardQueue() {
@@ -134,7 +136,9 @@ DirtyCardQueueSet::DirtyCardQueueSet(bool notify_when_complete) :
   PtrQueueSet(notify_when_complete),
   _shared_dirty_card_queue(this, true /* permanent */),
   _free_ids(NULL),
-  _processed_buffers_mut(0), _processed_buffers_rs_thread(0)
+  _processed_buffers_mut(0), _processed_buffers_rs_thread(0),
+  _mut_throttle_threshold(0),
+  _mut_throttle_buffers(SIZE_MAX)
 {
   _all_active = true;
 }
@@ -345,4 +349,54 @@ void DirtyCardQueueSet::concatenate_logs() {
   concatenate_log(_shared_dirty_card_queue);
   // Restore the completed buffer queue limit.
   _max_completed_queue = save_max_completed_queue;
+
+  update_mut_throttle_buffers();
+}
+
+bool DirtyCardQueueSet::mut_should_process_buffer() {
+  DirtyCardQueue& dcq = JavaThread::current()->dirty_card_queue();
+  dcq.inc_completed_buffers();
+  if (PtrQueueSet::mut_should_process_buffer()) {
+    return true;
+  }
+  // Between the throttle threshold and the maximum queue length only the
+  // mutators dirtying cards at a much higher rate than the others process
+  // their own buffers, leaving the others unaffected.
+  return _mut_throttle_threshold > 0 &&
+         _n_completed_buffers >= _mut_throttle_threshold &&
+         dcq.completed_buffers() > _mut_throttle_buffers;
+}
+
+void DirtyCardQueueSet::update_mut_throttle_buffers() {
+  assert(SafepointSynchronize::is_at_safepoint(), "Must be at safepoint.");
+  // A mutator is considered to have a high dirty card rate if it completed
+  // more than this factor times the average number of buffers completed by
+  // the mutators that completed any buffers during the last mutator phase.
+  const size_t HighRateFactor = 2;
+
+  size_t num_threads = 0;
+  size_t total_buffers = 0;
+  size_t max_buffers = 0;
+  for (JavaThreadIteratorWithHandle jtiwh; JavaThread *t = jtiwh.next(); ) {
+    DirtyCardQueue& dcq = t->dirty_card_queue();
+    size_t buffers = dcq.completed_buffers();
+    if (buffers > 0) {
+      num_threads++;
+      total_buffers += buffers;
+      max_buffers = MAX2(max_buffers, buffers);
+    }
+    dcq.reset_completed_buffers();
+  }
+
+  // With fewer than two active mutators there is no one to protect.
+  if (num_threads < 2) {
+    _mut_throttle_buffers = SIZE_MAX;
+  } else {
+    _mut_throttle_buffers = MAX2(total_buffers / num_threads * HighRateFactor, (size_t)1);
+  }
+  log_debug(gc, refine)("Mutator dirty card rates: threads: " SIZE_FORMAT ", "
+                        "buffers: " SIZE_FORMAT ", max buffers per thread: " SIZE_FORMAT ", "
+                        "throttle limit: " SIZE_FORMAT,
+                        num_threads, total_buffers, max_buffers,
+                        _mut_throttle_buffers == SIZE_MAX ? 0 : _mut_throttle_buffers);
 }
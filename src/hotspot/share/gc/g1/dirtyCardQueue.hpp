@@ -42,6 +42,10 @@ public:
 
 // A ptrQueue whose elements are "oops", pointers to object heads.
 class DirtyCardQueue: public PtrQueue {
+  // The number of buffers completed by the owning thread since the last
+  // GC. Used to measure the dirty card rate of the individual mutators.
+  size_t _completed_buffers;
+
 public:
   DirtyCardQueue(DirtyCardQueueSet* qset, bool permanent = false);
 
@@ -52,6 +56,10 @@ public:
   // Process queue entries and release resources.
   void flush() { flush_impl(); }
 
+  size_t completed_buffers() const { return _completed_buffers; }
+  void inc_completed_buffers() { _completed_buffers++; }
+  void reset_completed_buffers() { _completed_buffers = 0; }
+
   // Compiler support.
   static ByteSize byte_offset_of_index() {
     return PtrQueue::byte_offset_of_index<DirtyCardQueue>();
@@ -101,6 +109,22 @@ class DirtyCardQueueSet: public PtrQueueSet {
 
   bool mut_process_buffer(BufferNode* node);
 
+  // Also lets the mutators with the highest dirty card rate process their
+  // own buffers once the number of completed buffers reaches the throttle
+  // threshold.
+  virtual bool mut_should_process_buffer();
+
+  // Number of completed buffers above which mutators are throttled; zero
+  // disables throttling.
+  size_t _mut_throttle_threshold;
+  // Mutators that completed more than this number of buffers since the
+  // last GC are throttled.
+  size_t _mut_throttle_buffers;
+
+  // Gather the per-thread dirty card rates of the last mutator phase and
+  // derive the per-thread throttle limit from them.
+  void update_mut_throttle_buffers();
+
   // Protected by the _cbl_mon.
   FreeIdSet* _free_ids;
 
@@ -169,6 +193,9 @@ public:
     return _processed_buffers_rs_thread;
   }
 
+  void set_mut_throttle_threshold(size_t threshold) { _mut_throttle_threshold = threshold; }
+  size_t mut_throttle_threshold() const { return _mut_throttle_threshold; }
+
 };
 
 #endif // SHARE_VM_GC_G1_DIRTYCARDQUEUE_HPP
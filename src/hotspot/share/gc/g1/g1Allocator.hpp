@@ -31,6 +31,7 @@
 #include "gc/shared/plab.hpp"
 
 class EvacuationInfo;
+class G1NUMA;
 
 // Interface to keep track of which regions G1 is currently allocating into. Provides
 // some accessors (e.g. allocating into them, or getting their occupancy).
@@ -39,8 +40,15 @@ class G1Allocator : public CHeapObj<mtGC> {
   friend class VMStructs;
 protected:
   G1CollectedHeap* _g1h;
+  G1NUMA* _numa;
 
-  virtual MutatorAllocRegion* mutator_alloc_region() = 0;
+  // The number of mutator and survivor alloc regions, one per active NUMA node.
+  uint _num_alloc_regions;
+
+  // The NUMA node index the current thread should allocate on.
+  inline uint current_node_index() const;
+
+  virtual MutatorAllocRegion* mutator_alloc_region(uint node_index) = 0;
 
   virtual bool survivor_is_full() const = 0;
   virtual bool old_is_full() const = 0;
@@ -49,24 +57,27 @@ protected:
   virtual void set_old_full() = 0;
 
   // Accessors to the allocation regions.
-  virtual SurvivorGCAllocRegion* survivor_gc_alloc_region() = 0;
+  virtual SurvivorGCAllocRegion* survivor_gc_alloc_region(uint node_index) = 0;
   virtual OldGCAllocRegion* old_gc_alloc_region() = 0;
 
   // Allocation attempt during GC for a survivor object / PLAB.
   inline HeapWord* survivor_attempt_allocation(size_t min_word_size,
                                                size_t desired_word_size,
-                                               size_t* actual_word_size);
+                                               size_t* actual_word_size,
+                                               uint node_index);
   // Allocation attempt during GC for an old object / PLAB.
   inline HeapWord* old_attempt_allocation(size_t min_word_size,
                                           size_t desired_word_size,
                                           size_t* actual_word_size);
 public:
-  G1Allocator(G1CollectedHeap* heap) : _g1h(heap) { }
+  G1Allocator(G1CollectedHeap* heap);
   virtual ~G1Allocator() { }
 
+  uint num_alloc_regions() const { return _num_alloc_regions; }
+
 #ifdef ASSERT
   // Do we currently have an active mutator region to allocate into?
-  bool has_mutator_alloc_region() { return mutator_alloc_region()->get() != NULL; }
+  bool has_mutator_alloc_region();
 #endif
   virtual void init_mutator_alloc_region() = 0;
   virtual void release_mutator_alloc_region() = 0;
@@ -82,7 +93,8 @@ public:
                                  OldGCAllocRegion* old,
                                  HeapRegion** retained);
 
-  // Allocate blocks of memory during mutator time.
+  // Allocate blocks of memory during mutator time. The mutator alloc region
+  // of the NUMA node the current thread runs on is used.
 
   inline HeapWord* attempt_allocation(size_t word_size);
   inline HeapWord* attempt_allocation_locked(size_t word_size);
@@ -94,31 +106,36 @@ public:
   // allocation region, either by picking one or expanding the
   // heap, and then allocate a block of the given size. The block
   // may not be a humongous - it must fit into a single heap region.
+  // Survivor allocations are satisfied from the alloc region of the given
+  // NUMA node index.
   HeapWord* par_allocate_during_gc(InCSetState dest,
-                                   size_t word_size);
+                                   size_t word_size,
+                                   uint node_index);
 
   HeapWord* par_allocate_during_gc(InCSetState dest,
                                    size_t min_word_size,
                                    size_t desired_word_size,
-                                   size_t* actual_word_size);
+                                   size_t* actual_word_size,
+                                   uint node_index);
 
   virtual size_t used_in_alloc_regions() = 0;
 };
 
-// The default allocation region manager for G1. Provides a single mutator, survivor
-// and old generation allocation region.
+// The default allocation region manager for G1. Provides a mutator and a survivor
+// allocation region per NUMA node, and a single old generation allocation region.
 // Can retain the (single) old generation allocation region across GCs.
 class G1DefaultAllocator : public G1Allocator {
 private:
   bool _survivor_is_full;
   bool _old_is_full;
 protected:
-  // Alloc region used to satisfy mutator allocation requests.
-  MutatorAllocRegion _mutator_alloc_region;
+  // Alloc regions used to satisfy mutator allocation requests, indexed
+  // by NUMA node index.
+  MutatorAllocRegion* _mutator_alloc_regions;
 
-  // Alloc region used to satisfy allocation requests by the GC for
-  // survivor objects.
-  SurvivorGCAllocRegion _survivor_gc_alloc_region;
+  // Alloc regions used to satisfy allocation requests by the GC for
+  // survivor objects, indexed by NUMA node index.
+  SurvivorGCAllocRegion* _survivor_gc_alloc_regions;
 
   // Alloc region used to satisfy allocation requests by the GC for
   // old objects.
@@ -127,6 +144,7 @@ protected:
   HeapRegion* _retained_old_gc_alloc_region;
 public:
   G1DefaultAllocator(G1CollectedHeap* heap);
+  virtual ~G1DefaultAllocator();
 
   virtual bool survivor_is_full() const;
   virtual bool old_is_full() const ;
@@ -145,12 +163,14 @@ public:
     return _retained_old_gc_alloc_region == hr;
   }
 
-  virtual MutatorAllocRegion* mutator_alloc_region() {
-    return &_mutator_alloc_region;
+  virtual MutatorAllocRegion* mutator_alloc_region(uint node_index) {
+    assert(node_index < _num_alloc_regions, "Invalid node index %u", node_index);
+    return &_mutator_alloc_regions[node_index];
   }
 
-  virtual SurvivorGCAllocRegion* survivor_gc_alloc_region() {
-    return &_survivor_gc_alloc_region;
+  virtual SurvivorGCAllocRegion* survivor_gc_alloc_region(uint node_index) {
+    assert(node_index < _num_alloc_regions, "Invalid node index %u", node_index);
+    return &_survivor_gc_alloc_regions[node_index];
   }
 
   virtual OldGCAllocRegion* old_gc_alloc_region() {
@@ -162,10 +182,12 @@ public:
            "Should be owned on this thread's behalf.");
     size_t result = 0;
 
-    // Read only once in case it is set to NULL concurrently
-    HeapRegion* hr = mutator_alloc_region()->get();
-    if (hr != NULL) {
-      result += hr->used();
+    for (uint i = 0; i < _num_alloc_regions; i++) {
+      // Read only once in case it is set to NULL concurrently
+      HeapRegion* hr = mutator_alloc_region(i)->get();
+      if (hr != NULL) {
+        result += hr->used();
+      }
     }
     return result;
   }
@@ -191,7 +213,9 @@ protected:
   size_t _direct_allocated[InCSetState::Num];
 
   virtual void flush_and_retire_stats() = 0;
-  virtual PLAB* alloc_buffer(InCSetState dest) = 0;
+  // Returns the PLAB for dest. Survivor PLABs are kept per NUMA node, the
+  // node index is ignored for other destinations.
+  virtual PLAB* alloc_buffer(InCSetState dest, uint node_index) = 0;
 
   // Calculate the survivor space object alignment in bytes. Returns that or 0 if
   // there are no restrictions on survivor alignment.
@@ -223,42 +247,51 @@ public:
   // PLAB failed or not.
   HeapWord* allocate_direct_or_new_plab(InCSetState dest,
                                         size_t word_sz,
-                                        bool* plab_refill_failed);
+                                        bool* plab_refill_failed,
+                                        uint node_index);
 
   // Allocate word_sz words in the PLAB of dest.  Returns the address of the
   // allocated memory, NULL if not successful.
   inline HeapWord* plab_allocate(InCSetState dest,
-                                 size_t word_sz);
+                                 size_t word_sz,
+                                 uint node_index);
 
   HeapWord* allocate(InCSetState dest,
                      size_t word_sz,
-                     bool* refill_failed) {
-    HeapWord* const obj = plab_allocate(dest, word_sz);
+                     bool* refill_failed,
+                     uint node_index) {
+    HeapWord* const obj = plab_allocate(dest, word_sz, node_index);
     if (obj != NULL) {
       return obj;
     }
-    return allocate_direct_or_new_plab(dest, word_sz, refill_failed);
+    return allocate_direct_or_new_plab(dest, word_sz, refill_failed, node_index);
   }
 
-  void undo_allocation(InCSetState dest, HeapWord* obj, size_t word_sz);
+  void undo_allocation(InCSetState dest, HeapWord* obj, size_t word_sz, uint node_index);
 };
 
-// The default PLAB allocator for G1. Keeps the current (single) PLAB for survivor
-// and old generation allocation.
+// The default PLAB allocator for G1. Keeps the current PLAB per NUMA node for
+// survivor and a single PLAB for old generation allocation.
 class G1DefaultPLABAllocator : public G1PLABAllocator {
-  PLAB  _surviving_alloc_buffer;
-  PLAB  _tenured_alloc_buffer;
-  PLAB* _alloc_buffers[InCSetState::Num];
+  PLAB** _alloc_buffers[InCSetState::Num];
+  // The number of PLABs in each of _alloc_buffers.
+  uint _num_alloc_buffers[InCSetState::Num];
 
 public:
   G1DefaultPLABAllocator(G1Allocator* _allocator);
+  virtual ~G1DefaultPLABAllocator();
 
-  virtual PLAB* alloc_buffer(InCSetState dest) {
+  virtual PLAB* alloc_buffer(InCSetState dest, uint node_index) {
     assert(dest.is_valid(),
            "Allocation buffer index out-of-bounds: " CSETSTATE_FORMAT, dest.value());
     assert(_alloc_buffers[dest.value()] != NULL,
            "Allocation buffer is NULL: " CSETSTATE_FORMAT, dest.value());
-    return _alloc_buffers[dest.value()];
+    if (!dest.is_young()) {
+      return _alloc_buffers[dest.value()][0];
+    }
+    assert(node_index < _num_alloc_buffers[dest.value()],
+           "Allocation buffer node index out-of-bounds: %u", node_index);
+    return _alloc_buffers[dest.value()][node_index];
   }
 
   virtual void flush_and_retire_stats();
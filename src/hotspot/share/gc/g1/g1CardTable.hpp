@@ -51,7 +51,11 @@ class G1CardTable: public CardTable {
   G1CardTableChangedListener _listener;
 
   enum G1CardValues {
-    g1_young_gen = CT_MR_BS_last_reserved << 1
+    g1_young_gen = CT_MR_BS_last_reserved << 1,
+    // Set on claimed cards during the evacuation pause once they have been
+    // scanned for references into the collection set, so that incremental
+    // evacuation of optional regions does not scan them again.
+    g1_card_already_scanned = 0x1
   };
 
 public:
@@ -63,6 +67,7 @@ public:
   }
 
   static jbyte g1_young_card_val() { return g1_young_gen; }
+  static jbyte g1_scanned_card_val() { return g1_card_already_scanned; }
 
 /*
    Claimed and deferred bits are used together in G1 during the evacuation
@@ -84,6 +89,18 @@ public:
 
   inline void set_card_claimed(size_t card_index);
 
+  // Returns whether the card has been claimed for remembered set scanning but
+  // not been scanned yet.
+  bool is_card_claimed_unscanned(size_t card_index) {
+    jbyte val = _byte_map[card_index];
+    return (val & (clean_card_mask_val() | claimed_card_val() | g1_scanned_card_val())) == claimed_card_val();
+  }
+
+  void set_card_scanned(size_t card_index) {
+    assert(is_card_claimed(card_index), "Only claimed cards can be scanned");
+    _byte_map[card_index] |= g1_scanned_card_val();
+  }
+
   void verify_g1_young_region(MemRegion mr) PRODUCT_RETURN;
   void g1_mark_as_young(const MemRegion& mr);
 
@@ -24,7 +24,6 @@
 
 #include "precompiled.hpp"
 #include "classfile/metadataOnStackMark.hpp"
-#include "classfile/stringTable.hpp"
 #include "classfile/symbolTable.hpp"
 #include "code/codeCache.hpp"
 #include "code/icBuffer.hpp"
@@ -155,7 +154,7 @@ HeapRegion* G1CollectedHeap::new_heap_region(uint hrs_index,
 // Private methods.
 
 HeapRegion*
-G1CollectedHeap::new_region_try_secondary_free_list(bool is_old) {
+G1CollectedHeap::new_region_try_secondary_free_list(bool is_old, uint node_index) {
   MutexLockerEx x(SecondaryFreeList_lock, Mutex::_no_safepoint_check_flag);
   while (!_secondary_free_list.is_empty() || free_regions_coming()) {
     if (!_secondary_free_list.is_empty()) {
@@ -169,7 +168,7 @@ G1CollectedHeap::new_region_try_secondary_free_list(bool is_old) {
 
       assert(_hrm.num_free_regions() > 0, "if the secondary_free_list was not "
              "empty we should have moved at least one entry to the free_list");
-      HeapRegion* res = _hrm.allocate_free_region(is_old);
+      HeapRegion* res = _hrm.allocate_free_region(is_old, node_index);
       log_develop_trace(gc, freelist)("G1ConcRegionFreeing [region alloc] : "
                                       "allocated " HR_FORMAT " from secondary_free_list",
                                       HR_FORMAT_PARAMS(res));
@@ -187,7 +186,7 @@ G1CollectedHeap::new_region_try_secondary_free_list(bool is_old) {
   return NULL;
 }
 
-HeapRegion* G1CollectedHeap::new_region(size_t word_size, bool is_old, bool do_expand) {
+HeapRegion* G1CollectedHeap::new_region(size_t word_size, bool is_old, bool do_expand, uint node_index) {
   assert(!is_humongous(word_size) || word_size <= HeapRegion::GrainWords,
          "the only time we use this to allocate a humongous region is "
          "when we are allocating a single humongous region");
@@ -197,19 +196,19 @@ HeapRegion* G1CollectedHeap::new_region(size_t word_size, bool is_old, bool do_e
     if (!_secondary_free_list.is_empty()) {
       log_develop_trace(gc, freelist)("G1ConcRegionFreeing [region alloc] : "
                                       "forced to look at the secondary_free_list");
-      res = new_region_try_secondary_free_list(is_old);
+      res = new_region_try_secondary_free_list(is_old, node_index);
       if (res != NULL) {
         return res;
       }
     }
   }
 
-  res = _hrm.allocate_free_region(is_old);
+  res = _hrm.allocate_free_region(is_old, node_index);
 
   if (res == NULL) {
     log_develop_trace(gc, freelist)("G1ConcRegionFreeing [region alloc] : "
                                     "res == NULL, trying the secondary_free_list");
-    res = new_region_try_secondary_free_list(is_old);
+    res = new_region_try_secondary_free_list(is_old, node_index);
   }
   if (res == NULL && do_expand && _expand_heap_after_alloc_failure) {
     // Currently, only attempts to allocate GC alloc regions set
@@ -226,7 +225,7 @@ HeapRegion* G1CollectedHeap::new_region(size_t word_size, bool is_old, bool do_e
       // always expand the heap by an amount aligned to the heap
       // region size, the free list should in theory not be empty.
       // In either case allocate_free_region() will check for NULL.
-      res = _hrm.allocate_free_region(is_old);
+      res = _hrm.allocate_free_region(is_old, node_index);
     } else {
       _expand_heap_after_alloc_failure = false;
     }
@@ -301,12 +300,14 @@ G1CollectedHeap::humongous_obj_allocate_initialize_regions(uint first,
   // that there is a single object that starts at the bottom of the
   // first region.
   first_hr->set_starts_humongous(obj_top, word_fill_size);
+  _g1_policy->remset_tracker()->update_at_allocate(first_hr);
   // Then, if there are any, we will set up the "continues
   // humongous" regions.
   HeapRegion* hr = NULL;
   for (uint i = first + 1; i <= last; ++i) {
     hr = region_at(i);
     hr->set_continues_humongous(first_hr);
+    _g1_policy->remset_tracker()->update_at_allocate(hr);
   }
 
   // Up to this point no concurrent thread would have been able to
@@ -693,6 +694,7 @@ bool G1CollectedHeap::alloc_archive_regions(MemRegion* ranges,
       } else {
         curr_region->set_closed_archive();
       }
+      _g1_policy->remset_tracker()->update_at_allocate(curr_region);
       _hr_printer.alloc(curr_region);
       _old_set.add(curr_region);
       HeapWord* top;
@@ -1080,7 +1082,7 @@ void G1CollectedHeap::prepare_heap_for_mutators() {
   assert(num_free_regions() == 0, "we should not have added any free regions");
   rebuild_region_sets(false /* free_list_only */);
   abort_refinement();
-  resize_if_necessary_after_full_collection();
+  resize_heap_if_necessary();
 
   // Rebuild the strong code root lists for each region
   rebuild_strong_code_roots();
@@ -1183,7 +1185,9 @@ void G1CollectedHeap::do_full_collection(bool clear_all_soft_refs) {
                                   clear_all_soft_refs);
 }
 
-void G1CollectedHeap::resize_if_necessary_after_full_collection() {
+void G1CollectedHeap::resize_heap_if_necessary() {
+  assert_at_safepoint_on_vm_thread();
+
   // Capacity, free and used after the GC counted as full regions to
   // include the waste in the following calculations.
   const size_t capacity_after_gc = capacity();
@@ -1240,7 +1244,7 @@ void G1CollectedHeap::resize_if_necessary_after_full_collection() {
     // Don't expand unless it's significant
     size_t expand_bytes = minimum_desired_capacity - capacity_after_gc;
 
-    log_debug(gc, ergo, heap)("Attempt heap expansion (capacity lower than min desired capacity after Full GC). "
+    log_debug(gc, ergo, heap)("Attempt heap expansion (capacity lower than min desired capacity). "
                               "Capacity: " SIZE_FORMAT "B occupancy: " SIZE_FORMAT "B live: " SIZE_FORMAT "B "
                               "min_desired_capacity: " SIZE_FORMAT "B (" UINTX_FORMAT " %%)",
                               capacity_after_gc, used_after_gc, used(), minimum_desired_capacity, MinHeapFreeRatio);
@@ -1252,7 +1256,7 @@ void G1CollectedHeap::resize_if_necessary_after_full_collection() {
     // Capacity too large, compute shrinking size
     size_t shrink_bytes = capacity_after_gc - maximum_desired_capacity;
 
-    log_debug(gc, ergo, heap)("Attempt heap shrinking (capacity higher than max desired capacity after Full GC). "
+    log_debug(gc, ergo, heap)("Attempt heap shrinking (capacity higher than max desired capacity). "
                               "Capacity: " SIZE_FORMAT "B occupancy: " SIZE_FORMAT "B live: " SIZE_FORMAT "B "
                               "maximum_desired_capacity: " SIZE_FORMAT "B (" UINTX_FORMAT " %%)",
                               capacity_after_gc, used_after_gc, used(), maximum_desired_capacity, MaxHeapFreeRatio);
@@ -1428,8 +1432,8 @@ void G1CollectedHeap::shrink_helper(size_t shrink_bytes) {
 void G1CollectedHeap::shrink(size_t shrink_bytes) {
   _verifier->verify_region_sets_optional();
 
-  // We should only reach here at the end of a Full GC which means we
-  // should not not be holding to any GC alloc regions. The method
+  // We should only reach here at the end of a Full GC or during Remark which
+  // means we should not not be holding to any GC alloc regions. The method
   // below will make sure of that and do any remaining clean up.
   _allocator->abandon_gc_alloc_regions();
 
@@ -1477,6 +1481,8 @@ G1CollectedHeap::G1CollectedHeap(G1CollectorPolicy* collector_policy) :
   _humongous_set("Master Humongous Set", true /* humongous */, new HumongousRegionSetMtSafeChecker()),
   _humongous_reclaim_candidates(),
   _has_humongous_reclaim_candidates(false),
+  _jni_pinned_count(0),
+  _numa(NULL),
   _archive_allocator(NULL),
   _free_regions_coming(false),
   _gc_time_stamp(0),
@@ -1494,6 +1500,7 @@ G1CollectedHeap::G1CollectedHeap(G1CollectorPolicy* collector_policy) :
   _workers->initialize_workers();
   _verifier = new G1HeapVerifier(this);
 
+  _numa = G1NUMA::create();
   _allocator = new G1DefaultAllocator(this);
 
   _heap_sizing_policy = G1HeapSizingPolicy::create(this, _g1_policy->analytics());
@@ -1631,6 +1638,7 @@ jint G1CollectedHeap::initialize() {
                        heap_rs.base(),
                        heap_rs.size());
   heap_storage->set_mapping_changed_listener(&_listener);
+  _numa->set_region_info(HeapRegion::GrainBytes, page_size);
 
   // Create storage for the BOT, card table, card counts table (hot card cache) and the bitmaps.
   G1RegionToSpaceMapper* bot_storage =
@@ -1858,9 +1866,11 @@ void G1CollectedHeap::ref_processing_init() {
                                 // degree of mt discovery
                            false,
                                 // Reference discovery is not atomic
-                           &_is_alive_closure_cm);
+                           &_is_alive_closure_cm,
                                 // is alive closure
                                 // (for efficiency/performance)
+                           true);
+                                // allow changes to number of processing threads
 
   // STW ref processor
   _ref_processor_stw =
@@ -1875,9 +1885,11 @@ void G1CollectedHeap::ref_processing_init() {
                                 // degree of mt discovery
                            true,
                                 // Reference discovery is atomic
-                           &_is_alive_closure_stw);
+                           &_is_alive_closure_stw,
                                 // is alive closure
                                 // (for efficiency/performance)
+                           true);
+                                // allow changes to number of processing threads
 }
 
 CollectorPolicy* G1CollectedHeap::collector_policy() const {
@@ -1993,6 +2005,7 @@ bool G1CollectedHeap::should_do_concurrent_full_gc(GCCause::Cause cause) {
   switch (cause) {
     case GCCause::_gc_locker:               return GCLockerInvokesConcurrent;
     case GCCause::_g1_humongous_allocation: return true;
+    case GCCause::_g1_periodic_collection:  return G1PeriodicGCInvokesConcurrent;
     default:                                return is_user_requested_concurrent_full_gc(cause);
   }
 }
@@ -2191,6 +2204,30 @@ void G1CollectedHeap::object_iterate(ObjectClosure* cl) {
   heap_region_iterate(&blk);
 }
 
+class G1ParallelObjectIterator : public ParallelObjectIterator {
+private:
+  G1CollectedHeap*  _heap;
+  HeapRegionClaimer _claimer;
+
+public:
+  G1ParallelObjectIterator(uint thread_num) :
+      _heap(G1CollectedHeap::heap()),
+      _claimer(thread_num) {}
+
+  virtual void object_iterate(ObjectClosure* cl, uint worker_id) {
+    _heap->object_iterate_parallel(cl, worker_id, &_claimer);
+  }
+};
+
+ParallelObjectIterator* G1CollectedHeap::parallel_object_iterator(uint thread_num) {
+  return new G1ParallelObjectIterator(thread_num);
+}
+
+void G1CollectedHeap::object_iterate_parallel(ObjectClosure* cl, uint worker_id, HeapRegionClaimer* claimer) {
+  IterateObjectClosureRegionClosure blk(cl);
+  heap_region_par_iterate_from_worker_offset(&blk, claimer, worker_id);
+}
+
 void G1CollectedHeap::heap_region_iterate(HeapRegionClosure* cl) const {
   _hrm.iterate(cl);
 }
@@ -2399,6 +2436,8 @@ void G1CollectedHeap::gc_threads_do(ThreadClosure* tc) const {
 void G1CollectedHeap::print_tracing_info() const {
   g1_rem_set()->print_summary_info();
   concurrent_mark()->print_summary_info();
+  log_info(gc, jni)("JNI critical regions: " SIZE_FORMAT " pinned, %u GCs delayed by GCLocker for %.3fms",
+                    _jni_pinned_count, GCLocker::delayed_gc_count(), GCLocker::total_gc_delay_ms());
 }
 
 #ifndef PRODUCT
@@ -2608,6 +2647,12 @@ class RegisterHumongousWithInCSetFastTestClosure : public HeapRegionClosure {
       return false;
     }
 
+    // Native code may still access an object held by a JNI critical
+    // region without any Java reference to it.
+    if (region->has_jni_pins()) {
+      return false;
+    }
+
     // Candidate selection must satisfy the following constraints
     // while concurrent marking is in progress:
     //
@@ -2629,22 +2674,32 @@ class RegisterHumongousWithInCSetFastTestClosure : public HeapRegionClosure {
     // structures don't support efficiently performing the needed
     // additional tests or scrubbing of the mark stack.
     //
-    // However, we presently only nominate is_typeArray() objects.
-    // A humongous object containing references induces remembered
-    // set entries on other regions.  In order to reclaim such an
-    // object, those remembered sets would need to be cleaned up.
+    // We treat is_typeArray() objects specially, allowing them to be
+    // reclaimed even if allocated before the start of concurrent mark.
+    // For this we rely on mark stack insertion to exclude is_typeArray()
+    // objects, preventing reclaiming an object that is in the mark
+    // stack.  We also rely on the metadata for such objects to be
+    // built-in and so ensured to be kept live.  Frequent allocation and
+    // drop of large binary blobs is an important use case for eager
+    // reclaim, and this special handling may reduce needed headroom.
     //
-    // We also treat is_typeArray() objects specially, allowing them
-    // to be reclaimed even if allocated before the start of
-    // concurrent mark.  For this we rely on mark stack insertion to
-    // exclude is_typeArray() objects, preventing reclaiming an object
-    // that is in the mark stack.  We also rely on the metadata for
-    // such objects to be built-in and so ensured to be kept live.
-    // Frequent allocation and drop of large binary blobs is an
-    // important use case for eager reclaim, and this special handling
-    // may reduce needed headroom.
+    // A humongous object containing references induces remembered set
+    // entries on other regions.  These are not cleaned up when the
+    // object is reclaimed; scanning the remembered sets only considers
+    // cards below the scan top of old and humongous regions, so stale
+    // entries into a reclaimed and reused region only cause some extra
+    // card scanning of valid objects.
+    if (!obj->is_typeArray()) {
+      if (!G1EagerReclaimHumongousObjArrays || !obj->is_objArray()) {
+        return false;
+      }
+      if (heap->collector_state()->mark_in_progress() &&
+          !region->obj_allocated_since_next_marking(obj)) {
+        return false;
+      }
+    }
 
-    return obj->is_typeArray() && is_remset_small(region);
+    return is_remset_small(region);
   }
 
  public:
@@ -3002,11 +3057,18 @@ G1CollectedHeap::do_collection_pause_at_safepoint(double target_pause_time_ms) {
         // Initialize the GC alloc regions.
         _allocator->init_gc_alloc_regions(evacuation_info);
 
-        G1ParScanThreadStateSet per_thread_states(this, workers()->active_workers(), collection_set()->young_region_length());
+        G1ParScanThreadStateSet per_thread_states(this,
+                                                  workers()->active_workers(),
+                                                  collection_set()->young_region_length(),
+                                                  collection_set()->optional_region_length());
         pre_evacuate_collection_set();
 
         // Actually do the work...
         evacuate_collection_set(&per_thread_states);
+        evacuate_optional_collection_set(&per_thread_states);
+
+        // Optional regions evacuated above are now part of the collection set.
+        evacuation_info.set_collectionset_regions(collection_set()->region_length());
 
         post_evacuate_collection_set(evacuation_info, &per_thread_states);
 
@@ -3112,6 +3174,7 @@ G1CollectedHeap::do_collection_pause_at_safepoint(double target_pause_time_ms) {
 
     g1_policy()->print_phases();
     heap_transition.print();
+    _numa->print_statistics();
 
     // It is not yet to safe to tell the concurrent mark to
     // start as we have some optional output below. We don't want the
@@ -3203,7 +3266,7 @@ protected:
   G1ParScanThreadStateSet* _pss;
   RefToScanQueueSet*       _queues;
   G1RootProcessor*         _root_processor;
-  ParallelTaskTerminator   _terminator;
+  TaskTerminator           _terminator;
   uint                     _n_workers;
 
 public:
@@ -3250,7 +3313,7 @@ public:
       size_t evac_term_attempts = 0;
       {
         double start = os::elapsedTime();
-        G1ParEvacuateFollowersClosure evac(_g1h, pss, _queues, &_terminator);
+        G1ParEvacuateFollowersClosure evac(_g1h, pss, _queues, _terminator.terminator());
         evac.do_void();
 
         evac_term_attempts = evac.term_attempts();
@@ -3286,6 +3349,136 @@ public:
   }
 };
 
+class G1EvacuateOptionalRegionTask : public AbstractGangTask {
+  G1CollectedHeap* _g1h;
+  G1ParScanThreadStateSet* _per_thread_states;
+  G1OptionalCSet* _optional;
+  RefToScanQueueSet* _queues;
+  TaskTerminator _terminator;
+
+  // Process the references into the current batch of optional regions that
+  // this worker recorded so far, and the merged remembered sets of these regions.
+  void scan_roots(G1ParScanThreadState* pss, uint worker_id) {
+    double start_sec = os::elapsedTime();
+
+    G1ScanObjsDuringScanRSClosure obj_cl(_g1h, pss);
+    G1ScanRSForRegionClosure scan_rs_cl(_g1h->g1_rem_set()->scan_state(),
+                                        &obj_cl,
+                                        pss->closures()->weak_codeblobs(),
+                                        worker_id);
+
+    size_t scanned_refs = 0;
+    for (uint i = _optional->current_index(); i < _optional->current_limit(); i++) {
+      HeapRegion* hr = _optional->region_at(i);
+      G1OopStarChunkedList* oops = pss->oops_into_optional_region(hr);
+      scanned_refs += oops->oops_do(&obj_cl, pss->closures()->raw_strong_oops());
+      // The recorded references into this region are not needed any more.
+      oops->free_chunk_lists();
+    }
+
+    scan_rs_cl.scan_claimed_chunks();
+    for (uint i = _optional->current_index(); i < _optional->current_limit(); i++) {
+      scan_rs_cl.do_heap_region(_optional->region_at(i));
+    }
+
+    G1GCPhaseTimes* p = _g1h->g1_policy()->phase_times();
+    p->record_or_add_time_secs(G1GCPhaseTimes::OptScanRS, worker_id, os::elapsedTime() - start_sec);
+    p->record_or_add_thread_work_item(G1GCPhaseTimes::OptScanRS, worker_id, scan_rs_cl.cards_scanned(), G1GCPhaseTimes::OptScanRSScannedCards);
+    p->record_or_add_thread_work_item(G1GCPhaseTimes::OptScanRS, worker_id, scan_rs_cl.chunks_claimed(), G1GCPhaseTimes::OptScanRSClaimedChunks);
+    p->record_or_add_thread_work_item(G1GCPhaseTimes::OptScanRS, worker_id, scan_rs_cl.chunks_skipped(), G1GCPhaseTimes::OptScanRSSkippedChunks);
+    p->record_or_add_thread_work_item(G1GCPhaseTimes::OptScanRS, worker_id, scanned_refs, G1GCPhaseTimes::OptScanRSScannedOptRefs);
+  }
+
+  void evacuate_live_objects(G1ParScanThreadState* pss, uint worker_id) {
+    double start = os::elapsedTime();
+    G1ParEvacuateFollowersClosure cl(_g1h, pss, _queues, _terminator.terminator());
+    cl.do_void();
+
+    double term_sec = cl.term_time();
+    double elapsed_sec = os::elapsedTime() - start;
+    G1GCPhaseTimes* p = _g1h->g1_policy()->phase_times();
+    p->record_or_add_time_secs(G1GCPhaseTimes::OptObjCopy, worker_id, elapsed_sec - term_sec);
+    p->record_or_add_time_secs(G1GCPhaseTimes::OptTermination, worker_id, term_sec);
+  }
+
+public:
+  G1EvacuateOptionalRegionTask(G1CollectedHeap* g1h,
+                               G1ParScanThreadStateSet* per_thread_states,
+                               G1OptionalCSet* cset,
+                               RefToScanQueueSet* queues,
+                               uint n_workers) :
+    AbstractGangTask("G1 Evacuation Optional Region Task"),
+    _g1h(g1h),
+    _per_thread_states(per_thread_states),
+    _optional(cset),
+    _queues(queues),
+    _terminator(n_workers, _queues) {
+  }
+
+  void work(uint worker_id) {
+    ResourceMark rm;
+    HandleMark  hm;
+
+    G1ParScanThreadState* pss = _per_thread_states->state_for_worker(worker_id);
+    pss->set_ref_processor(_g1h->ref_processor_stw());
+
+    scan_roots(pss, worker_id);
+    evacuate_live_objects(pss, worker_id);
+
+    assert(pss->queue_is_empty(), "should be empty");
+  }
+};
+
+void G1CollectedHeap::evacuate_optional_regions(G1ParScanThreadStateSet* per_thread_states, G1OptionalCSet* ocset) {
+  g1_rem_set()->merge_rem_sets(ocset);
+
+  G1EvacuateOptionalRegionTask task(this, per_thread_states, ocset, _task_queues, workers()->active_workers());
+  workers()->run_task(&task);
+}
+
+void G1CollectedHeap::evacuate_optional_collection_set(G1ParScanThreadStateSet* per_thread_states) {
+  // Regions of the optional collection set that are not evacuated are
+  // returned to the collection set chooser when optional_cset goes out of scope.
+  G1OptionalCSet optional_cset(&_collection_set, per_thread_states);
+  if (optional_cset.is_empty()) {
+    return;
+  }
+
+  if (evacuation_failed()) {
+    return;
+  }
+
+  G1GCPhaseTimes* phase_times = g1_policy()->phase_times();
+  const double gc_start_time_ms = phase_times->cur_collection_start_sec() * 1000.0;
+
+  double start_time_sec = os::elapsedTime();
+
+  do {
+    double time_used_ms = os::elapsedTime() * 1000.0 - gc_start_time_ms;
+    double time_left_ms = MaxGCPauseMillis - time_used_ms;
+
+    if (time_left_ms < 0) {
+      log_trace(gc, ergo, cset)("Skipping %u optional regions, pause time exceeded %.3fms", optional_cset.size(), time_used_ms);
+      break;
+    }
+
+    optional_cset.prepare_evacuation(time_left_ms * _g1_policy->optional_evacuation_fraction());
+    if (optional_cset.prepare_failed()) {
+      log_trace(gc, ergo, cset)("Skipping %u optional regions, no regions can be evacuated in %.3fms", optional_cset.size(), time_left_ms);
+      break;
+    }
+
+    evacuate_optional_regions(per_thread_states, &optional_cset);
+
+    optional_cset.complete_evacuation();
+    if (optional_cset.evacuation_failed()) {
+      break;
+    }
+  } while (!optional_cset.is_empty());
+
+  phase_times->record_optional_evacuation((os::elapsedTime() - start_time_sec) * 1000.0);
+}
+
 void G1CollectedHeap::print_termination_stats_hdr() {
   log_debug(gc, task, stats)("GC Termination Stats");
   log_debug(gc, task, stats)("     elapsed  --strong roots-- -------termination------- ------waste (KiB)------");
@@ -3311,84 +3504,34 @@ void G1CollectedHeap::print_termination_stats(uint worker_id,
                undo_waste * HeapWordSize / K);
 }
 
+// Interned strings are cleared by the WeakProcessor and removed from the
+// StringTable concurrently by the ServiceThread, so this task only cleans
+// the string deduplication table and triggers the symbol table cleanup.
 class G1StringAndSymbolCleaningTask : public AbstractGangTask {
 private:
   BoolObjectClosure* _is_alive;
-  G1StringDedupUnlinkOrOopsDoClosure _dedup_closure;
-
-  int _initial_string_table_size;
-  int _initial_symbol_table_size;
-
-  bool  _process_strings;
-  int _strings_processed;
-  int _strings_removed;
-
-  bool  _process_symbols;
-  int _symbols_processed;
-  int _symbols_removed;
+  StringDedupUnlinkOrOopsDoClosure _dedup_closure;
 
   bool _process_string_dedup;
 
 public:
-  G1StringAndSymbolCleaningTask(BoolObjectClosure* is_alive, bool process_strings, bool process_symbols, bool process_string_dedup) :
+  G1StringAndSymbolCleaningTask(BoolObjectClosure* is_alive, bool process_symbols, bool process_string_dedup) :
     AbstractGangTask("String/Symbol Unlinking"),
     _is_alive(is_alive),
     _dedup_closure(is_alive, NULL, false),
-    _process_strings(process_strings), _strings_processed(0), _strings_removed(0),
-    _process_symbols(process_symbols), _symbols_processed(0), _symbols_removed(0),
     _process_string_dedup(process_string_dedup) {
 
-    _initial_string_table_size = StringTable::the_table()->table_size();
-    _initial_symbol_table_size = SymbolTable::the_table()->table_size();
-    if (process_strings) {
-      StringTable::clear_parallel_claimed_index();
-    }
     if (process_symbols) {
-      SymbolTable::clear_parallel_claimed_index();
+      // Unreferenced symbols are removed concurrently by the ServiceThread.
+      SymbolTable::trigger_cleanup();
     }
   }
 
-  ~G1StringAndSymbolCleaningTask() {
-    guarantee(!_process_strings || StringTable::parallel_claimed_index() >= _initial_string_table_size,
-              "claim value %d after unlink less than initial string table size %d",
-              StringTable::parallel_claimed_index(), _initial_string_table_size);
-    guarantee(!_process_symbols || SymbolTable::parallel_claimed_index() >= _initial_symbol_table_size,
-              "claim value %d after unlink less than initial symbol table size %d",
-              SymbolTable::parallel_claimed_index(), _initial_symbol_table_size);
-
-    log_info(gc, stringtable)(
-        "Cleaned string and symbol table, "
-        "strings: " SIZE_FORMAT " processed, " SIZE_FORMAT " removed, "
-        "symbols: " SIZE_FORMAT " processed, " SIZE_FORMAT " removed",
-        strings_processed(), strings_removed(),
-        symbols_processed(), symbols_removed());
-  }
-
   void work(uint worker_id) {
-    int strings_processed = 0;
-    int strings_removed = 0;
-    int symbols_processed = 0;
-    int symbols_removed = 0;
-    if (_process_strings) {
-      StringTable::possibly_parallel_unlink(_is_alive, &strings_processed, &strings_removed);
-      Atomic::add(strings_processed, &_strings_processed);
-      Atomic::add(strings_removed, &_strings_removed);
-    }
-    if (_process_symbols) {
-      SymbolTable::possibly_parallel_unlink(&symbols_processed, &symbols_removed);
-      Atomic::add(symbols_processed, &_symbols_processed);
-      Atomic::add(symbols_removed, &_symbols_removed);
-    }
     if (_process_string_dedup) {
       G1StringDedup::parallel_unlink(&_dedup_closure, worker_id);
     }
   }
-
-  size_t strings_processed() const { return (size_t)_strings_processed; }
-  size_t strings_removed()   const { return (size_t)_strings_removed; }
-
-  size_t symbols_processed() const { return (size_t)_symbols_processed; }
-  size_t symbols_removed()   const { return (size_t)_symbols_removed; }
 };
 
 class G1CodeCacheUnloadingTask {
@@ -3614,6 +3757,26 @@ public:
   }
 };
 
+class G1ClassLoaderDataCleaningTask : public StackObj {
+  BoolObjectClosure*                 _is_alive;
+  bool                               _unloading_occurred;
+  ClassLoaderDataGraphIteratorAtomic _cld_iterator;
+
+public:
+  G1ClassLoaderDataCleaningTask(BoolObjectClosure* is_alive, bool unloading_occurred) :
+      _is_alive(is_alive),
+      _unloading_occurred(unloading_occurred),
+      _cld_iterator() {
+  }
+
+  // All workers help cleaning the surviving class loaders.
+  void work() {
+    if (_unloading_occurred) {
+      ClassLoaderDataGraph::clean_alive_loaders(&_cld_iterator, _is_alive);
+    }
+  }
+};
+
 class G1ResolvedMethodCleaningTask : public StackObj {
   BoolObjectClosure* _is_alive;
   volatile int       _resolved_method_task_claimed;
@@ -3643,15 +3806,17 @@ private:
   G1StringAndSymbolCleaningTask _string_symbol_task;
   G1CodeCacheUnloadingTask      _code_cache_task;
   G1KlassCleaningTask           _klass_cleaning_task;
+  G1ClassLoaderDataCleaningTask _cld_cleaning_task;
   G1ResolvedMethodCleaningTask  _resolved_method_cleaning_task;
 
 public:
   // The constructor is run in the VMThread.
   G1ParallelCleaningTask(BoolObjectClosure* is_alive, uint num_workers, bool unloading_occurred) :
       AbstractGangTask("Parallel Cleaning"),
-      _string_symbol_task(is_alive, true, true, G1StringDedup::is_enabled()),
+      _string_symbol_task(is_alive, true, G1StringDedup::is_enabled()),
       _code_cache_task(num_workers, is_alive, unloading_occurred),
       _klass_cleaning_task(is_alive),
+      _cld_cleaning_task(is_alive, unloading_occurred),
       _resolved_method_cleaning_task(is_alive) {
   }
 
@@ -3663,12 +3828,16 @@ public:
     // Let the threads mark that the first pass is done.
     _code_cache_task.barrier_mark(worker_id);
 
-    // Clean the Strings and Symbols.
+    // Clean the string deduplication table and trigger symbol cleaning.
     _string_symbol_task.work(worker_id);
 
     // Clean unreferenced things in the ResolvedMethodTable
     _resolved_method_cleaning_task.work();
 
+    // Clean the dictionaries, package exports and module reads of the
+    // class loaders that survived.
+    _cld_cleaning_task.work();
+
     // Wait for all workers to finish the first code cache cleaning pass.
     _code_cache_task.barrier_wait(worker_id);
 
@@ -3691,15 +3860,14 @@ void G1CollectedHeap::complete_cleaning(BoolObjectClosure* is_alive,
 }
 
 void G1CollectedHeap::partial_cleaning(BoolObjectClosure* is_alive,
-                                       bool process_strings,
                                        bool process_symbols,
                                        bool process_string_dedup) {
-  if (!process_strings && !process_symbols && !process_string_dedup) {
+  if (!process_symbols && !process_string_dedup) {
     // Nothing to clean.
     return;
   }
 
-  G1StringAndSymbolCleaningTask g1_unlink_task(is_alive, process_strings, process_symbols, process_string_dedup);
+  G1StringAndSymbolCleaningTask g1_unlink_task(is_alive, process_symbols, process_string_dedup);
   workers()->run_task(&g1_unlink_task);
 
 }
@@ -3876,7 +4044,6 @@ private:
   G1ParScanThreadStateSet*  _pss;
   RefToScanQueueSet*        _queues;
   WorkGang*                 _workers;
-  uint                      _active_workers;
 
 public:
   G1STWRefProcTaskExecutor(G1CollectedHeap* g1h,
@@ -3887,14 +4054,13 @@ public:
     _g1h(g1h),
     _pss(per_thread_states),
     _queues(task_queues),
-    _workers(workers),
-    _active_workers(n_workers)
+    _workers(workers)
   {
     g1h->ref_processor_stw()->set_active_mt_degree(n_workers);
   }
 
   // Executes the given task using concurrent marking worker threads.
-  virtual void execute(ProcessTask& task);
+  virtual void execute(ProcessTask& task, uint ergo_workers);
   virtual void execute(EnqueueTask& task);
 };
 
@@ -3951,13 +4117,16 @@ public:
 // Driver routine for parallel reference processing.
 // Creates an instance of the ref processing gang
 // task and has the worker threads execute it.
-void G1STWRefProcTaskExecutor::execute(ProcessTask& proc_task) {
+void G1STWRefProcTaskExecutor::execute(ProcessTask& proc_task, uint ergo_workers) {
   assert(_workers != NULL, "Need parallel worker threads.");
 
-  ParallelTaskTerminator terminator(_active_workers, _queues);
-  G1STWRefProcTaskProxy proc_task_proxy(proc_task, _g1h, _pss, _queues, &terminator);
+  assert(_workers->active_workers() >= ergo_workers,
+         "Ergonomically chosen workers (%u) should be less than or equal to active workers (%u)",
+         ergo_workers, _workers->active_workers());
+  TaskTerminator terminator(ergo_workers, _queues);
+  G1STWRefProcTaskProxy proc_task_proxy(proc_task, _g1h, _pss, _queues, terminator.terminator());
 
-  _workers->run_task(&proc_task_proxy);
+  _workers->run_task(&proc_task_proxy, ergo_workers);
 }
 
 // Gang task for parallel reference enqueueing.
@@ -4000,7 +4169,7 @@ protected:
   G1CollectedHeap*         _g1h;
   G1ParScanThreadStateSet* _pss;
   RefToScanQueueSet*       _queues;
-  ParallelTaskTerminator   _terminator;
+  TaskTerminator           _terminator;
   uint                     _n_workers;
 
 public:
@@ -4063,8 +4232,11 @@ public:
     }
 
     // Drain the queue - which may cause stealing
-    G1ParEvacuateFollowersClosure drain_queue(_g1h, pss, _queues, &_terminator);
+    G1ParEvacuateFollowersClosure drain_queue(_g1h, pss, _queues, _terminator.terminator());
     drain_queue.do_void();
+    G1GCPhaseTimes* phase_times = _g1h->g1_policy()->phase_times();
+    phase_times->record_time_secs(G1GCPhaseTimes::PreserveCMReferentsTermination, worker_id, drain_queue.term_time());
+    phase_times->record_thread_work_item(G1GCPhaseTimes::PreserveCMReferentsTermination, worker_id, drain_queue.term_attempts());
     // Allocation buffers were retired at the end of G1ParEvacuateFollowersClosure
     assert(pss->queue_is_empty(), "should be");
   }
@@ -4210,7 +4382,7 @@ void G1CollectedHeap::enqueue_discovered_references(G1ParScanThreadStateSet* per
   if (collector_state()->during_initial_mark_pause()) {
     oop pll_head = Universe::reference_pending_list();
     if (pll_head != NULL) {
-      _cm->mark_in_next_bitmap(pll_head);
+      _cm->mark_in_next_bitmap(0 /* worker_id */, pll_head);
     }
   }
 
@@ -4264,6 +4436,8 @@ void G1CollectedHeap::evacuate_collection_set(G1ParScanThreadStateSet* per_threa
   double start_par_time_sec = os::elapsedTime();
   double end_par_time_sec;
 
+  g1_rem_set()->merge_rem_sets();
+
   {
     const uint n_workers = workers()->active_workers();
     G1RootProcessor root_processor(this, n_workers);
@@ -4399,6 +4573,7 @@ void G1CollectedHeap::free_region(HeapRegion* hr,
     _hot_card_cache->reset_card_counts(hr);
   }
   hr->hr_clear(skip_remset, true /* clear_space */, locked /* locked */);
+  _g1_policy->remset_tracker()->update_at_free(hr);
   free_list->add_ordered(hr);
 }
 
@@ -4433,29 +4608,6 @@ void G1CollectedHeap::decrement_summary_bytes(size_t bytes) {
   decrease_used(bytes);
 }
 
-class G1ParScrubRemSetTask: public AbstractGangTask {
-protected:
-  G1RemSet* _g1rs;
-  HeapRegionClaimer _hrclaimer;
-
-public:
-  G1ParScrubRemSetTask(G1RemSet* g1_rs, uint num_workers) :
-    AbstractGangTask("G1 ScrubRS"),
-    _g1rs(g1_rs),
-    _hrclaimer(num_workers) {
-  }
-
-  void work(uint worker_id) {
-    _g1rs->scrub(worker_id, &_hrclaimer);
-  }
-};
-
-void G1CollectedHeap::scrub_rem_set() {
-  uint num_workers = workers()->active_workers();
-  G1ParScrubRemSetTask g1_par_scrub_rs_task(g1_rem_set(), num_workers);
-  workers()->run_task(&g1_par_scrub_rs_task);
-}
-
 class G1FreeCollectionSetTask : public AbstractGangTask {
 private:
 
@@ -4781,10 +4933,11 @@ class G1FreeHumongousRegionClosure : public HeapRegionClosure {
     // are completely up-to-date wrt to references to the humongous object.
     //
     // Other implementation considerations:
-    // - never consider object arrays at this time because they would pose
-    // considerable effort for cleaning up the the remembered sets. This is
-    // required because stale remembered sets might reference locations that
-    // are currently allocated into.
+    // - object arrays are only considered if there is no concurrent marking in
+    // progress, or if they have been allocated after its start. Otherwise their
+    // references might not have been scanned yet, which would break the SATB
+    // invariants. Their outgoing remembered set entries are left stale; see
+    // RegisterHumongousWithInCSetFastTestClosure::humongous_region_is_candidate().
     uint region_idx = r->hrm_index();
     if (!g1h->is_humongous_reclaim_candidate(region_idx) ||
         !r->rem_set()->is_empty()) {
@@ -4801,8 +4954,8 @@ class G1FreeHumongousRegionClosure : public HeapRegionClosure {
       return false;
     }
 
-    guarantee(obj->is_typeArray(),
-              "Only eagerly reclaiming type arrays is supported, but the object "
+    guarantee(obj->is_typeArray() || obj->is_objArray(),
+              "Only eagerly reclaiming type and object arrays is supported, but the object "
               PTR_FORMAT " is not.", p2i(r->bottom()));
 
     log_debug(gc, humongous)("Dead humongous region %u object size " SIZE_FORMAT " start " PTR_FORMAT " with remset " SIZE_FORMAT " code roots " SIZE_FORMAT " is marked %d reclaim candidate %d type array %d",
@@ -4816,10 +4969,7 @@ class G1FreeHumongousRegionClosure : public HeapRegionClosure {
                              obj->is_typeArray()
                             );
 
-    // Need to clear mark bit of the humongous object if already set.
-    if (next_bitmap->is_marked(r->bottom())) {
-      next_bitmap->clear(r->bottom());
-    }
+    g1h->concurrent_mark()->humongous_object_eagerly_reclaimed(r);
     _humongous_objects_reclaimed++;
     do {
       HeapRegion* next = g1h->next_region_in_humongous(r);
@@ -5107,15 +5257,22 @@ bool G1CollectedHeap::is_in_closed_subset(const void* p) const {
 // Methods for the mutator alloc region
 
 HeapRegion* G1CollectedHeap::new_mutator_alloc_region(size_t word_size,
-                                                      bool force) {
+                                                      bool force,
+                                                      uint node_index) {
   assert_heap_locked_or_at_safepoint(true /* should_be_vm_thread */);
   bool should_allocate = g1_policy()->should_allocate_mutator_region();
+  if (!should_allocate && g1_policy()->revise_young_list_target_length_for_allocation_spike()) {
+    should_allocate = g1_policy()->should_allocate_mutator_region();
+  }
   if (force || should_allocate) {
     HeapRegion* new_alloc_region = new_region(word_size,
                                               false /* is_old */,
-                                              false /* do_expand */);
+                                              false /* do_expand */,
+                                              node_index);
     if (new_alloc_region != NULL) {
+      _numa->record_region_allocation(node_index, new_alloc_region->node_index());
       set_region_short_lived_locked(new_alloc_region);
+      _g1_policy->remset_tracker()->update_at_allocate(new_alloc_region);
       _hr_printer.alloc(new_alloc_region, !should_allocate);
       _verifier->check_bitmaps("Mutator Region Allocation", new_alloc_region);
       return new_alloc_region;
@@ -5148,7 +5305,7 @@ bool G1CollectedHeap::has_more_regions(InCSetState dest) {
   }
 }
 
-HeapRegion* G1CollectedHeap::new_gc_alloc_region(size_t word_size, InCSetState dest) {
+HeapRegion* G1CollectedHeap::new_gc_alloc_region(size_t word_size, InCSetState dest, uint node_index) {
   assert(FreeList_lock->owned_by_self(), "pre-condition");
 
   if (!has_more_regions(dest)) {
@@ -5159,8 +5316,10 @@ HeapRegion* G1CollectedHeap::new_gc_alloc_region(size_t word_size, InCSetState d
 
   HeapRegion* new_alloc_region = new_region(word_size,
                                             !is_survivor,
-                                            true /* do_expand */);
+                                            true /* do_expand */,
+                                            node_index);
   if (new_alloc_region != NULL) {
+    _numa->record_region_allocation(node_index, new_alloc_region->node_index());
     // We really only need to do this for old regions given that we
     // should never scan survivors. But it doesn't hurt to do it
     // for survivors too.
@@ -5173,6 +5332,7 @@ HeapRegion* G1CollectedHeap::new_gc_alloc_region(size_t word_size, InCSetState d
       new_alloc_region->set_old();
       _verifier->check_bitmaps("Old Region Allocation", new_alloc_region);
     }
+    _g1_policy->remset_tracker()->update_at_allocate(new_alloc_region);
     _hr_printer.alloc(new_alloc_region);
     bool during_im = collector_state()->during_initial_mark_pause();
     new_alloc_region->note_start_of_copying(during_im);
@@ -5282,6 +5442,31 @@ void G1CollectedHeap::unregister_nmethod(nmethod* nm) {
   nm->oops_do(&reg_cl, true);
 }
 
+bool G1CollectedHeap::pin_object(JavaThread* thread, oop obj) {
+  if (!G1PinJNICriticalObjects) {
+    return false;
+  }
+  HeapRegion* hr = heap_region_containing(obj);
+  if (!hr->is_pinned()) {
+    return false;
+  }
+  hr->increment_jni_pin_count();
+  Atomic::inc(&_jni_pinned_count);
+  return true;
+}
+
+bool G1CollectedHeap::unpin_object(JavaThread* thread, oop obj) {
+  if (!G1PinJNICriticalObjects) {
+    return false;
+  }
+  HeapRegion* hr = heap_region_containing(obj);
+  if (!hr->is_pinned()) {
+    return false;
+  }
+  hr->decrement_jni_pin_count();
+  return true;
+}
+
 void G1CollectedHeap::purge_code_root_memory() {
   double purge_start = os::elapsedTime();
   G1CodeRootSet::purge();
@@ -40,6 +40,7 @@
 #include "gc/g1/g1HRPrinter.hpp"
 #include "gc/g1/g1InCSetState.hpp"
 #include "gc/g1/g1MonitoringSupport.hpp"
+#include "gc/g1/g1NUMA.hpp"
 #include "gc/g1/g1SurvivorRegions.hpp"
 #include "gc/g1/g1YCTypes.hpp"
 #include "gc/g1/heapRegionManager.hpp"
@@ -64,6 +65,7 @@ class HeapRegion;
 class HRRSCleanupTask;
 class GenerationSpec;
 class G1ParScanThreadState;
+class G1OptionalCSet;
 class G1ParScanThreadStateSet;
 class G1ParScanThreadState;
 class MemoryPool;
@@ -208,6 +210,9 @@ private:
   // The sequence of all heap regions in the heap.
   HeapRegionManager _hrm;
 
+  // The NUMA nodes the heap is spread across.
+  G1NUMA* _numa;
+
   // Manages all allocations with regions except humongous object allocations.
   G1Allocator* _allocator;
 
@@ -267,6 +272,10 @@ private:
   // If not, we can skip a few steps.
   bool _has_humongous_reclaim_candidates;
 
+  // Number of JNI critical regions handled by pinning rather than
+  // the GCLocker.
+  volatile size_t _jni_pinned_count;
+
   volatile uint _gc_time_stamp;
 
   G1HRPrinter _hr_printer;
@@ -279,6 +288,7 @@ private:
   // (c) cause == _java_lang_system_gc and +ExplicitGCInvokesConcurrent.
   // (d) cause == _dcmd_gc_run and +ExplicitGCInvokesConcurrent.
   // (e) cause == _wb_conc_mark
+  // (f) cause == _g1_periodic_collection and +G1PeriodicGCInvokesConcurrent.
   bool should_do_concurrent_full_gc(GCCause::Cause cause);
 
   // indicates whether we are in young or mixed GC mode
@@ -385,14 +395,17 @@ private:
   // check whether there's anything available on the
   // secondary_free_list and/or wait for more regions to appear on
   // that list, if _free_regions_coming is set.
-  HeapRegion* new_region_try_secondary_free_list(bool is_old);
+  HeapRegion* new_region_try_secondary_free_list(bool is_old, uint node_index);
 
   // Try to allocate a single non-humongous HeapRegion sufficient for
   // an allocation of the given word_size. If do_expand is true,
   // attempt to expand the heap if necessary to satisfy the allocation
   // request. If the region is to be used as an old region or for a
   // humongous object, set is_old to true. If not, to false.
-  HeapRegion* new_region(size_t word_size, bool is_old, bool do_expand);
+  // If node_index is a valid NUMA node index, prefer a region placed
+  // on that node.
+  HeapRegion* new_region(size_t word_size, bool is_old, bool do_expand,
+                         uint node_index = G1NUMA::AnyNodeIndex);
 
   // Initialize a contiguous set of free regions of length num_regions
   // and starting at index first so that they appear as a single
@@ -463,13 +476,13 @@ private:
   // These methods are the "callbacks" from the G1AllocRegion class.
 
   // For mutator alloc regions.
-  HeapRegion* new_mutator_alloc_region(size_t word_size, bool force);
+  HeapRegion* new_mutator_alloc_region(size_t word_size, bool force, uint node_index);
   void retire_mutator_alloc_region(HeapRegion* alloc_region,
                                    size_t allocated_bytes);
 
   // For GC alloc regions.
   bool has_more_regions(InCSetState dest);
-  HeapRegion* new_gc_alloc_region(size_t word_size, InCSetState dest);
+  HeapRegion* new_gc_alloc_region(size_t word_size, InCSetState dest, uint node_index);
   void retire_gc_alloc_region(HeapRegion* alloc_region,
                               size_t allocated_bytes, InCSetState dest);
 
@@ -485,9 +498,6 @@ private:
   // Callback from VM_G1CollectFull operation, or collect_as_vm_thread.
   virtual void do_full_collection(bool clear_all_soft_refs);
 
-  // Resize the heap if necessary after a full collection.
-  void resize_if_necessary_after_full_collection();
-
   // Callback from VM_G1CollectForAllocation operation.
   // This function does everything necessary/possible to satisfy a
   // failed allocation request (including collection, expansion, etc.)
@@ -535,10 +545,15 @@ public:
 
   WorkGang* workers() const { return _workers; }
 
+  // The parallel workers are idle at non-GC safepoints.
+  virtual WorkGang* get_safepoint_workers() { return _workers; }
+
   G1Allocator* allocator() {
     return _allocator;
   }
 
+  G1NUMA* numa() const { return _numa; }
+
   G1HeapVerifier* verifier() {
     return _verifier;
   }
@@ -554,6 +569,10 @@ public:
   // (Rounds up to a HeapRegion boundary.)
   bool expand(size_t expand_bytes, WorkGang* pretouch_workers = NULL, double* expand_time_ms = NULL);
 
+  // Resize the heap according to MinHeapFreeRatio and MaxHeapFreeRatio
+  // after a full collection or remark.
+  void resize_heap_if_necessary();
+
   // Returns the PLAB statistics for a given destination.
   inline G1EvacStats* alloc_buffer_stats(InCSetState dest);
 
@@ -586,6 +605,9 @@ public:
   void register_old_region_with_cset(HeapRegion* r) {
     _in_cset_fast_test.set_in_old(r->hrm_index());
   }
+  void register_optional_region_with_cset(HeapRegion* r) {
+    _in_cset_fast_test.set_optional(r->hrm_index());
+  }
   void clear_in_cset(const HeapRegion* hr) {
     _in_cset_fast_test.clear(hr);
   }
@@ -741,6 +763,10 @@ private:
 
   // Actually do the work of evacuating the collection set.
   void evacuate_collection_set(G1ParScanThreadStateSet* per_thread_states);
+  // Evacuate the optional part of the collection set in batches as long as
+  // there is time left in the pause.
+  void evacuate_optional_collection_set(G1ParScanThreadStateSet* per_thread_states);
+  void evacuate_optional_regions(G1ParScanThreadStateSet* per_thread_states, G1OptionalCSet* ocset);
 
   void pre_evacuate_collection_set();
   void post_evacuate_collection_set(EvacuationInfo& evacuation_info, G1ParScanThreadStateSet* pss);
@@ -981,9 +1007,6 @@ public:
   // The rem set and barrier set.
   G1RemSet* g1_rem_set() const { return _g1_rem_set; }
 
-  // Try to minimize the remembered set.
-  void scrub_rem_set();
-
   uint get_gc_time_stamp() {
     return _gc_time_stamp;
   }
@@ -1165,6 +1188,11 @@ public:
     object_iterate(cl);
   }
 
+  virtual ParallelObjectIterator* parallel_object_iterator(uint thread_num);
+
+  // Iterate over all objects of the regions claimed by the given worker.
+  void object_iterate_parallel(ObjectClosure* cl, uint worker_id, HeapRegionClaimer* claimer);
+
   // Iterate over heap regions, in address order, terminating the
   // iteration early if the "do_heap_region" method returns "true".
   void heap_region_iterate(HeapRegionClosure* blk) const;
@@ -1359,6 +1387,11 @@ public:
   // Unregister the given nmethod from the G1 heap.
   virtual void unregister_nmethod(nmethod* nm);
 
+  // Objects in humongous and archive regions are never moved, so JNI
+  // critical regions on them pin the region instead of using the GCLocker.
+  virtual bool pin_object(JavaThread* thread, oop obj);
+  virtual bool unpin_object(JavaThread* thread, oop obj);
+
   // Free up superfluous code root memory.
   void purge_code_root_memory();
 
@@ -1368,10 +1401,9 @@ public:
 
   // Partial cleaning used when class unloading is disabled.
   // Let the caller choose what structures to clean out:
-  // - StringTable
   // - SymbolTable
   // - StringDeduplication structures
-  void partial_cleaning(BoolObjectClosure* is_alive, bool unlink_strings, bool unlink_symbols, bool unlink_string_dedup);
+  void partial_cleaning(BoolObjectClosure* is_alive, bool unlink_symbols, bool unlink_string_dedup);
 
   // Complete cleaning used when class unloading is enabled.
   // Cleans out all structures handled by partial_cleaning and also the CodeCache.
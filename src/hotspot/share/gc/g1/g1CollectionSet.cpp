@@ -23,10 +23,12 @@
  */
 
 #include "precompiled.hpp"
-#include "gc/g1/g1CollectedHeap.hpp"
+#include "gc/g1/g1CollectedHeap.inline.hpp"
 #include "gc/g1/g1CollectionSet.hpp"
 #include "gc/g1/g1CollectorState.hpp"
+#include "gc/g1/g1ParScanThreadState.hpp"
 #include "gc/g1/g1Policy.hpp"
+#include "gc/g1/g1RemSet.hpp"
 #include "gc/g1/heapRegion.inline.hpp"
 #include "gc/g1/heapRegionRemSet.hpp"
 #include "gc/g1/heapRegionSet.hpp"
@@ -62,6 +64,9 @@ G1CollectionSet::G1CollectionSet(G1CollectedHeap* g1h, G1Policy* policy) :
   _collection_set_regions(NULL),
   _collection_set_cur_length(0),
   _collection_set_max_length(0),
+  _optional_regions(NULL),
+  _optional_region_length(0),
+  _optional_region_max_length(0),
   // Incremental CSet attributes
   _inc_build_state(Inactive),
   _inc_bytes_used_before(0),
@@ -75,6 +80,7 @@ G1CollectionSet::~G1CollectionSet() {
   if (_collection_set_regions != NULL) {
     FREE_C_HEAP_ARRAY(uint, _collection_set_regions);
   }
+  free_optional_regions();
   delete _cset_chooser;
 }
 
@@ -97,6 +103,23 @@ void G1CollectionSet::initialize(uint max_region_length) {
   _collection_set_regions = NEW_C_HEAP_ARRAY(uint, max_region_length, mtGC);
 }
 
+void G1CollectionSet::initialize_optional(uint max_length) {
+  assert(_optional_regions == NULL, "Already initialized");
+  assert(_optional_region_length == 0, "Already initialized");
+  assert(_optional_region_max_length == 0, "Already initialized");
+  _optional_region_max_length = max_length;
+  _optional_regions = NEW_C_HEAP_ARRAY(HeapRegion*, _optional_region_max_length, mtGC);
+}
+
+void G1CollectionSet::free_optional_regions() {
+  _optional_region_length = 0;
+  _optional_region_max_length = 0;
+  if (_optional_regions != NULL) {
+    FREE_C_HEAP_ARRAY(HeapRegion*, _optional_regions);
+    _optional_regions = NULL;
+  }
+}
+
 void G1CollectionSet::set_recorded_rs_lengths(size_t rs_lengths) {
   _recorded_rs_lengths = rs_lengths;
 }
@@ -105,7 +128,8 @@ void G1CollectionSet::set_recorded_rs_lengths(size_t rs_lengths) {
 void G1CollectionSet::add_old_region(HeapRegion* hr) {
   assert_at_safepoint_on_vm_thread();
 
-  assert(_inc_build_state == Active, "Precondition");
+  assert(_inc_build_state == Active || hr->index_in_opt_cset() != G1OptionalCSet::InvalidCSetIndex,
+         "Precondition, actively building cset or adding optional later on");
   assert(hr->is_old(), "the region should be old");
 
   assert(!hr->in_collection_set(), "should not already be in the CSet");
@@ -120,6 +144,34 @@ void G1CollectionSet::add_old_region(HeapRegion* hr) {
   _old_region_length += 1;
 }
 
+void G1CollectionSet::add_optional_region(HeapRegion* hr) {
+  assert(!optional_is_full(), "Precondition, must have room left for this region");
+  assert(hr->is_old(), "the region should be old");
+  assert(!hr->in_collection_set(), "should not already be in the CSet");
+
+  _g1->register_optional_region_with_cset(hr);
+
+  _optional_regions[_optional_region_length] = hr;
+  uint index = _optional_region_length++;
+  hr->set_index_in_opt_cset(index);
+}
+
+HeapRegion* G1CollectionSet::remove_last_optional_region() {
+  assert(_optional_regions != NULL, "Optional regions not yet initialized");
+  assert(_optional_region_length > 0, "No optional regions left");
+
+  uint index = --_optional_region_length;
+  HeapRegion* hr = _optional_regions[index];
+  _optional_regions[index] = NULL;
+  return hr;
+}
+
+void G1CollectionSet::clear_optional_region(const HeapRegion* hr) {
+  assert(_optional_regions != NULL, "Must not be called before array is allocated");
+  uint index = hr->index_in_opt_cset();
+  _optional_regions[index] = NULL;
+}
+
 // Initialize the per-collection-set information
 void G1CollectionSet::start_incremental_building() {
   assert(_collection_set_cur_length == 0, "Collection set must be empty before starting a new collection set.");
@@ -407,9 +459,23 @@ static int compare_region_idx(const uint a, const uint b) {
   }
 }
 
+void G1CollectionSet::add_as_old(HeapRegion* hr) {
+  cset_chooser()->pop(); // already have region via peek()
+  _g1->old_set_remove(hr);
+  add_old_region(hr);
+}
+
+void G1CollectionSet::add_as_optional(HeapRegion* hr) {
+  assert(_optional_regions != NULL, "Must not be called before array is allocated");
+  cset_chooser()->pop(); // already have region via peek()
+  _g1->old_set_remove(hr);
+  add_optional_region(hr);
+}
+
 void G1CollectionSet::finalize_old_part(double time_remaining_ms) {
   double non_young_start_time_sec = os::elapsedTime();
   double predicted_old_time_ms = 0.0;
+  double predicted_optional_time_ms = 0.0;
 
   if (!collector_state()->gcs_are_young()) {
     cset_chooser()->verify();
@@ -419,12 +485,19 @@ void G1CollectionSet::finalize_old_part(double time_remaining_ms) {
     uint expensive_region_num = 0;
     bool check_time_remaining = _policy->adaptive_young_list_length();
 
+    // Regions predicted to fit into the last part of the remaining time are
+    // added to the optional part of the collection set. They are evacuated
+    // only if the mandatory part finishes early enough.
+    const double optional_threshold_ms = time_remaining_ms * _policy->optional_prediction_fraction();
+    initialize_optional(max_old_cset_length - MIN2(min_old_cset_length, max_old_cset_length));
+
     HeapRegion* hr = cset_chooser()->peek();
     while (hr != NULL) {
-      if (old_region_length() >= max_old_cset_length) {
+      if (old_region_length() + optional_region_length() >= max_old_cset_length) {
         // Added maximum number of old regions to the CSet.
-        log_debug(gc, ergo, cset)("Finish adding old regions to CSet (old CSet region num reached max). old %u regions, max %u regions",
-                                  old_region_length(), max_old_cset_length);
+        log_debug(gc, ergo, cset)("Finish adding old regions to CSet (old CSet region num reached max). "
+                                  "old %u regions, optional %u regions, max %u regions",
+                                  old_region_length(), optional_region_length(), max_old_cset_length);
         break;
       }
 
@@ -438,47 +511,51 @@ void G1CollectionSet::finalize_old_part(double time_remaining_ms) {
         // reclaimable space is at or below the waste threshold. Stop
         // adding old regions to the CSet.
         log_debug(gc, ergo, cset)("Finish adding old regions to CSet (reclaimable percentage not over threshold). "
-                                  "old %u regions, max %u regions, reclaimable: " SIZE_FORMAT "B (%1.2f%%) threshold: " UINTX_FORMAT "%%",
-                                  old_region_length(), max_old_cset_length, reclaimable_bytes, reclaimable_percent, G1HeapWastePercent);
+                                  "old %u regions, optional %u regions, max %u regions, reclaimable: " SIZE_FORMAT "B (%1.2f%%) threshold: " UINTX_FORMAT "%%",
+                                  old_region_length(), optional_region_length(), max_old_cset_length, reclaimable_bytes, reclaimable_percent, G1HeapWastePercent);
         break;
       }
 
       double predicted_time_ms = predict_region_elapsed_time_ms(hr);
-      if (check_time_remaining) {
-        if (predicted_time_ms > time_remaining_ms) {
-          // Too expensive for the current CSet.
-
-          if (old_region_length() >= min_old_cset_length) {
-            // We have added the minimum number of old regions to the CSet,
-            // we are done with this CSet.
-            log_debug(gc, ergo, cset)("Finish adding old regions to CSet (predicted time is too high). "
-                                      "predicted time: %1.2fms, remaining time: %1.2fms old %u regions, min %u regions",
-                                      predicted_time_ms, time_remaining_ms, old_region_length(), min_old_cset_length);
-            break;
-          }
-
-          // We'll add it anyway given that we haven't reached the
-          // minimum number of old regions.
+      if (old_region_length() < min_old_cset_length) {
+        // We have not added the minimum number of old regions yet, so add
+        // this one to the mandatory part regardless of its cost.
+        if (check_time_remaining && predicted_time_ms > time_remaining_ms) {
           expensive_region_num += 1;
         }
+        time_remaining_ms = MAX2(time_remaining_ms - predicted_time_ms, 0.0);
+        predicted_old_time_ms += predicted_time_ms;
+        add_as_old(hr);
+      } else if (!check_time_remaining) {
+        // In the non-auto-tuning case, we'll finish adding regions
+        // to the CSet if we reach the minimum.
+        log_debug(gc, ergo, cset)("Finish adding old regions to CSet (old CSet region num reached min). old %u regions, min %u regions",
+                                  old_region_length(), min_old_cset_length);
+        break;
+      } else if (predicted_time_ms > time_remaining_ms) {
+        // Too expensive for the current CSet, we are done with this CSet.
+        log_debug(gc, ergo, cset)("Finish adding old regions to CSet (predicted time is too high). "
+                                  "predicted time: %1.2fms, remaining time: %1.2fms old %u regions, optional %u regions, min %u regions",
+                                  predicted_time_ms, time_remaining_ms, old_region_length(), optional_region_length(), min_old_cset_length);
+        break;
+      } else if (time_remaining_ms - predicted_time_ms > optional_threshold_ms) {
+        // Keep adding regions to the mandatory part until we reach the
+        // optional threshold.
+        time_remaining_ms -= predicted_time_ms;
+        predicted_old_time_ms += predicted_time_ms;
+        add_as_old(hr);
+      } else if (!optional_is_full()) {
+        // Keep adding optional regions until the time is up.
+        time_remaining_ms -= predicted_time_ms;
+        predicted_optional_time_ms += predicted_time_ms;
+        add_as_optional(hr);
       } else {
-        if (old_region_length() >= min_old_cset_length) {
-          // In the non-auto-tuning case, we'll finish adding regions
-          // to the CSet if we reach the minimum.
-
-          log_debug(gc, ergo, cset)("Finish adding old regions to CSet (old CSet region num reached min). old %u regions, min %u regions",
-                                    old_region_length(), min_old_cset_length);
-          break;
-        }
+        log_debug(gc, ergo, cset)("Finish adding old regions to CSet (optional set full). "
+                                  "old %u regions, optional %u regions",
+                                  old_region_length(), optional_region_length());
+        break;
       }
 
-      // We will add this region to the CSet.
-      time_remaining_ms = MAX2(time_remaining_ms - predicted_time_ms, 0.0);
-      predicted_old_time_ms += predicted_time_ms;
-      cset_chooser()->pop(); // already have region via peek()
-      _g1->old_set_remove(hr);
-      add_old_region(hr);
-
       hr = cset_chooser()->peek();
     }
     if (hr == NULL) {
@@ -499,8 +576,10 @@ void G1CollectionSet::finalize_old_part(double time_remaining_ms) {
 
   stop_incremental_building();
 
-  log_debug(gc, ergo, cset)("Finish choosing CSet. old: %u regions, predicted old region time: %1.2fms, time remaining: %1.2f",
-                            old_region_length(), predicted_old_time_ms, time_remaining_ms);
+  log_debug(gc, ergo, cset)("Finish choosing CSet. old: %u regions, optional: %u regions, "
+                            "predicted old region time: %1.2fms, predicted optional region time: %1.2fms, time remaining: %1.2f",
+                            old_region_length(), optional_region_length(),
+                            predicted_old_time_ms, predicted_optional_time_ms, time_remaining_ms);
 
   double non_young_end_time_sec = os::elapsedTime();
   phase_times()->record_non_young_cset_choice_time_ms((non_young_end_time_sec - non_young_start_time_sec) * 1000.0);
@@ -508,6 +587,83 @@ void G1CollectionSet::finalize_old_part(double time_remaining_ms) {
   QuickSort::sort(_collection_set_regions, _collection_set_cur_length, compare_region_idx, true);
 }
 
+HeapRegion* G1OptionalCSet::region_at(uint index) const {
+  return _cset->optional_region_at(index);
+}
+
+void G1OptionalCSet::prepare_to_evacuate_optional_region(HeapRegion* hr) {
+  log_trace(gc, ergo, cset)("Adding region %u for optional evacuation", hr->hrm_index());
+  G1CollectedHeap* g1h = G1CollectedHeap::heap();
+  g1h->clear_in_cset(hr);
+  g1h->g1_rem_set()->exclude_region_from_scan(hr->hrm_index());
+  _cset->add_old_region(hr);
+  g1h->hr_printer()->cset(hr);
+}
+
+void G1OptionalCSet::prepare_evacuation(double time_limit_ms) {
+  assert(_current_index == _current_limit, "Before prepare no regions should be ready for evac");
+
+  uint prepared_regions = 0;
+  double prediction_ms = 0;
+
+  _prepare_failed = true;
+  for (uint i = _current_index; i < _cset->optional_region_length(); i++) {
+    HeapRegion* hr = region_at(i);
+    prediction_ms += _cset->predict_region_elapsed_time_ms(hr);
+    if (prediction_ms > time_limit_ms) {
+      log_debug(gc, ergo, cset)("Prepared %u regions for optional evacuation. Predicted time: %1.2fms, time limit: %1.2fms",
+                                prepared_regions, prediction_ms, time_limit_ms);
+      return;
+    }
+
+    // This region will be included in the next optional evacuation.
+    prepare_to_evacuate_optional_region(hr);
+    prepared_regions++;
+    _current_limit++;
+    _prepare_failed = false;
+  }
+
+  log_debug(gc, ergo, cset)("Prepared all %u regions for optional evacuation. Predicted time: %1.2fms",
+                            prepared_regions, prediction_ms);
+}
+
+void G1OptionalCSet::complete_evacuation() {
+  _evacuation_failed = false;
+  for (uint i = _current_index; i < _current_limit; i++) {
+    HeapRegion* hr = region_at(i);
+    _cset->clear_optional_region(hr);
+    hr->set_index_in_opt_cset(InvalidCSetIndex);
+    if (hr->evacuation_failed()) {
+      _evacuation_failed = true;
+    }
+  }
+  _current_index = _current_limit;
+}
+
+uint G1OptionalCSet::size() const {
+  return _cset->optional_region_length() - _current_index;
+}
+
+bool G1OptionalCSet::is_empty() const {
+  return size() == 0;
+}
+
+G1OptionalCSet::~G1OptionalCSet() {
+  G1CollectedHeap* g1h = G1CollectedHeap::heap();
+  while (!is_empty()) {
+    // Return the regions that have not been evacuated to the chooser in
+    // reverse order to maintain the original order.
+    HeapRegion* hr = _cset->remove_last_optional_region();
+    assert(hr != NULL, "Should be valid region left");
+    _pset->record_unused_optional_region(hr);
+    g1h->old_set_add(hr);
+    g1h->clear_in_cset(hr);
+    hr->set_index_in_opt_cset(InvalidCSetIndex);
+    _cset->cset_chooser()->push(hr);
+  }
+  _cset->free_optional_regions();
+}
+
 #ifdef ASSERT
 class G1VerifyYoungCSetIndicesClosure : public HeapRegionClosure {
 private:
@@ -32,6 +32,7 @@
 class G1CollectedHeap;
 class G1CollectorState;
 class G1GCPhaseTimes;
+class G1ParScanThreadStateSet;
 class G1Policy;
 class G1SurvivorRegions;
 class HeapRegion;
@@ -56,6 +57,14 @@ class G1CollectionSet {
   volatile size_t _collection_set_cur_length;
   size_t _collection_set_max_length;
 
+  // Old regions chosen as the optional part of the collection set. They are
+  // only evacuated if there is time left in the pause after evacuating the
+  // mandatory part, in the order they were taken from the CollectionSetChooser.
+  // Entries are set to NULL once the region has been evacuated.
+  HeapRegion** _optional_regions;
+  uint _optional_region_length;
+  uint _optional_region_max_length;
+
   // The number of bytes in the collection set before the pause. Set from
   // the incrementally built collection set at the start of an evacuation
   // pause, and incremented in finalize_old_part() when adding old regions
@@ -106,9 +115,14 @@ class G1CollectionSet {
   G1CollectorState* collector_state();
   G1GCPhaseTimes* phase_times();
 
-  double predict_region_elapsed_time_ms(HeapRegion* hr);
-
   void verify_young_cset_indices() const NOT_DEBUG_RETURN;
+
+  // Add the given old region to the mandatory or optional part of the
+  // collection set, removing it from the old set.
+  void add_as_old(HeapRegion* hr);
+  void add_as_optional(HeapRegion* hr);
+
+  void initialize_optional(uint max_length);
 public:
   G1CollectionSet(G1CollectedHeap* g1h, G1Policy* policy);
   ~G1CollectionSet();
@@ -131,6 +145,29 @@ public:
   uint eden_region_length() const     { return _eden_region_length;     }
   uint survivor_region_length() const { return _survivor_region_length; }
   uint old_region_length() const      { return _old_region_length;      }
+  uint optional_region_length() const { return _optional_region_length; }
+
+  bool optional_is_full() const {
+    assert(_optional_region_length <= _optional_region_max_length, "Invariant");
+    return _optional_region_length == _optional_region_max_length;
+  }
+
+  HeapRegion* optional_region_at(uint i) const {
+    assert(_optional_regions != NULL, "Not yet initialized");
+    assert(i < _optional_region_length, "index %u out of bounds (%u)", i, _optional_region_length);
+    return _optional_regions[i];
+  }
+
+  // Remove and return the last optional region that has not been evacuated.
+  HeapRegion* remove_last_optional_region();
+
+  // Mark the given optional region as evacuated.
+  void clear_optional_region(const HeapRegion* hr);
+
+  // Free the optional region information after the pause.
+  void free_optional_regions();
+
+  double predict_region_elapsed_time_ms(HeapRegion* hr);
 
   // Incremental collection set support
 
@@ -175,6 +212,9 @@ public:
   // Add old region "hr" to the collection set.
   void add_old_region(HeapRegion* hr);
 
+  // Add old region "hr" to the optional part of the collection set.
+  void add_optional_region(HeapRegion* hr);
+
   // Update information about hr in the aggregated information for
   // the incrementally built collection set.
   void update_young_region_prediction(HeapRegion* hr, size_t new_rs_length);
@@ -196,5 +236,54 @@ private:
   void add_young_region_common(HeapRegion* hr);
 };
 
+// Manages the optional part of the collection set during a mixed collection.
+// Optional regions are moved into the collection set in batches that fit into
+// the remaining pause time. On destruction, regions that have not been
+// evacuated are returned to the CollectionSetChooser.
+class G1OptionalCSet : public StackObj {
+private:
+  G1CollectionSet* _cset;
+  G1ParScanThreadStateSet* _pset;
+  // Optional regions in [_current_index, _current_limit) are part of the
+  // current evacuation batch.
+  uint _current_index;
+  uint _current_limit;
+  bool _prepare_failed;
+  bool _evacuation_failed;
+
+  void prepare_to_evacuate_optional_region(HeapRegion* hr);
+
+public:
+  static const int InvalidCSetIndex = -1;
+
+  G1OptionalCSet(G1CollectionSet* cset, G1ParScanThreadStateSet* pset) :
+    _cset(cset),
+    _pset(pset),
+    _current_index(0),
+    _current_limit(0),
+    _prepare_failed(false),
+    _evacuation_failed(false) { }
+  ~G1OptionalCSet();
+
+  uint current_index() const { return _current_index; }
+  uint current_limit() const { return _current_limit; }
+
+  // Number of optional regions not yet evacuated.
+  uint size() const;
+  bool is_empty() const;
+
+  HeapRegion* region_at(uint index) const;
+
+  // Move as many optional regions into the collection set as are predicted
+  // to be evacuated within time_limit_ms.
+  void prepare_evacuation(double time_limit_ms);
+  bool prepare_failed() const { return _prepare_failed; }
+
+  // Complete the evacuation of the previously prepared batch of regions and
+  // check whether any of them failed evacuation.
+  void complete_evacuation();
+  bool evacuation_failed() const { return _evacuation_failed; }
+};
+
 #endif // SHARE_VM_GC_G1_G1COLLECTIONSET_HPP
 
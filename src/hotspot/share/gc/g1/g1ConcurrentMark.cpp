@@ -30,10 +30,12 @@
 #include "gc/g1/g1CollectedHeap.inline.hpp"
 #include "gc/g1/g1CollectorState.hpp"
 #include "gc/g1/g1ConcurrentMark.inline.hpp"
+#include "gc/g1/g1ConcurrentRefine.hpp"
 #include "gc/g1/g1HeapVerifier.hpp"
 #include "gc/g1/g1OopClosures.inline.hpp"
-#include "gc/g1/g1CardLiveData.inline.hpp"
 #include "gc/g1/g1Policy.hpp"
+#include "gc/g1/g1RegionMarkStatsCache.inline.hpp"
+#include "gc/g1/g1RemSet.hpp"
 #include "gc/g1/g1StringDedup.hpp"
 #include "gc/g1/heapRegion.inline.hpp"
 #include "gc/g1/heapRegionRemSet.hpp"
@@ -361,7 +363,7 @@ G1ConcurrentMark::G1ConcurrentMark(G1CollectedHeap* g1h,
   // _tasks set inside the constructor
 
   _task_queues(new G1CMTaskQueueSet((int) _max_num_tasks)),
-  _terminator(ParallelTaskTerminator((int) _max_num_tasks, _task_queues)),
+  _terminator((int) _max_num_tasks, _task_queues),
 
   _first_overflow_barrier_sync(),
   _second_overflow_barrier_sync(),
@@ -381,14 +383,15 @@ G1ConcurrentMark::G1ConcurrentMark(G1CollectedHeap* g1h,
   _remark_mark_times(),
   _remark_weak_ref_times(),
   _cleanup_times(),
-  _total_counting_time(0.0),
-  _total_rs_scrub_time(0.0),
 
   _accum_task_vtime(NULL),
 
   _concurrent_workers(NULL),
   _num_concurrent_workers(0),
-  _max_concurrent_workers(0)
+  _max_concurrent_workers(0),
+
+  _region_mark_stats(NEW_C_HEAP_ARRAY(G1RegionMarkStats, _g1h->max_regions(), mtGC)),
+  _top_at_rebuild_starts(NEW_C_HEAP_ARRAY(HeapWord*, _g1h->max_regions(), mtGC))
 {
   _mark_bitmap_1.initialize(g1h->reserved_region(), prev_bitmap_storage);
   _mark_bitmap_2.initialize(g1h->reserved_region(), next_bitmap_storage);
@@ -478,11 +481,13 @@ G1ConcurrentMark::G1ConcurrentMark(G1CollectedHeap* g1h,
     task_queue->initialize();
     _task_queues->register_queue(i, task_queue);
 
-    _tasks[i] = new G1CMTask(i, this, task_queue);
+    _tasks[i] = new G1CMTask(i, this, task_queue, _region_mark_stats, _g1h->max_regions());
 
     _accum_task_vtime[i] = 0.0;
   }
 
+  clear_all_region_mark_stats();
+
   set_non_marking_state();
   _completed_initialization = true;
 }
@@ -509,11 +514,81 @@ void G1ConcurrentMark::reset() {
     _tasks[i]->reset(_next_mark_bitmap);
   }
 
+  clear_all_region_mark_stats();
+
   // we need this to make sure that the flag is on during the evac
   // pause with initial mark piggy-backed
   set_concurrent_marking_in_progress();
 }
 
+void G1ConcurrentMark::clear_all_region_mark_stats() {
+  uint max_regions = _g1h->max_regions();
+  for (uint i = 0; i < max_regions; i++) {
+    _top_at_rebuild_starts[i] = NULL;
+    _region_mark_stats[i].clear();
+  }
+}
+
+void G1ConcurrentMark::clear_statistics_in_region(uint region_idx) {
+  for (uint j = 0; j < _max_num_tasks; ++j) {
+    _tasks[j]->clear_mark_stats_cache(region_idx);
+  }
+  _top_at_rebuild_starts[region_idx] = NULL;
+  _region_mark_stats[region_idx].clear();
+}
+
+void G1ConcurrentMark::clear_statistics(HeapRegion* r) {
+  uint const region_idx = r->hrm_index();
+  if (r->is_humongous()) {
+    assert(r->is_starts_humongous(), "Got humongous continues region here");
+    uint const size_in_regions = (uint)_g1h->humongous_obj_size_in_regions(oop(r->humongous_start_region()->bottom())->size());
+    for (uint j = region_idx; j < (region_idx + size_in_regions); j++) {
+      clear_statistics_in_region(j);
+    }
+  } else {
+    clear_statistics_in_region(region_idx);
+  }
+}
+
+void G1ConcurrentMark::humongous_object_eagerly_reclaimed(HeapRegion* r) {
+  assert(SafepointSynchronize::is_at_safepoint(), "May only be called at a safepoint.");
+
+  // Objects containing references must not be reclaimed while marking might
+  // still need to trace through them. Objects allocated after the start of
+  // marking are implicitly live, never pushed on the mark stack, and SATB
+  // entries pointing to them are filtered by their TAMS.
+  guarantee(oop(r->bottom())->is_typeArray() ||
+            !_g1h->collector_state()->mark_in_progress() ||
+            r->obj_allocated_since_next_marking(oop(r->bottom())),
+            "Humongous object " PTR_FORMAT " in region %u may still need to be scanned by marking",
+            p2i(r->bottom()), r->hrm_index());
+
+  // Need to clear mark bit of the humongous object.
+  if (_next_mark_bitmap->is_marked(r->bottom())) {
+    _next_mark_bitmap->clear(r->bottom());
+  }
+
+  if (!_g1h->collector_state()->mark_in_progress()) {
+    return;
+  }
+
+  // Clear any statistics about the region gathered so far.
+  clear_statistics(r);
+}
+
+void G1ConcurrentMark::flush_all_task_caches() {
+  size_t hits = 0;
+  size_t misses = 0;
+  for (uint i = 0; i < _max_num_tasks; i++) {
+    Pair<size_t, size_t> stats = _tasks[i]->flush_mark_stats_cache();
+    hits += stats.first;
+    misses += stats.second;
+  }
+  size_t sum = hits + misses;
+  log_debug(gc, stats)("Mark stats cache hits " SIZE_FORMAT " misses " SIZE_FORMAT " ratio %1.3lf",
+                       hits, misses, percent_of(hits, sum));
+}
+
 
 void G1ConcurrentMark::reset_marking_state() {
   _global_mark_stack.set_empty();
@@ -538,7 +613,7 @@ void G1ConcurrentMark::set_concurrency(uint active_tasks) {
   _num_active_tasks = active_tasks;
   // Need to update the three data structures below according to the
   // number of active threads for this phase.
-  _terminator   = ParallelTaskTerminator((int) active_tasks, _task_queues);
+  _terminator.terminator()->reset_for_reuse((int) active_tasks);
   _first_overflow_barrier_sync.set_n_workers((int) active_tasks);
   _second_overflow_barrier_sync.set_n_workers((int) active_tasks);
 }
@@ -671,13 +746,6 @@ void G1ConcurrentMark::cleanup_for_next_mark() {
 
   clear_bitmap(_next_mark_bitmap, _concurrent_workers, true);
 
-  // Clear the live count data. If the marking has been aborted, the abort()
-  // call already did that.
-  if (!has_aborted()) {
-    clear_live_data(_concurrent_workers);
-    DEBUG_ONLY(verify_live_data_clear());
-  }
-
   // Repeat the asserts from above.
   guarantee(cm_thread()->during_cycle(), "invariant");
   guarantee(!_g1h->collector_state()->mark_in_progress(), "invariant");
@@ -888,10 +956,10 @@ uint G1ConcurrentMark::calc_active_marking_workers() {
   return result;
 }
 
-void G1ConcurrentMark::scan_root_region(HeapRegion* hr) {
+void G1ConcurrentMark::scan_root_region(HeapRegion* hr, uint worker_id) {
   // Currently, only survivors can be root regions.
   assert(hr->next_top_at_mark_start() == hr->bottom(), "invariant");
-  G1RootRegionScanClosure cl(_g1h, this);
+  G1RootRegionScanClosure cl(_g1h, this, worker_id);
 
   const uintx interval = PrefetchScanIntervalInBytes;
   HeapWord* curr = hr->bottom();
@@ -920,7 +988,7 @@ public:
     G1CMRootRegions* root_regions = _cm->root_regions();
     HeapRegion* hr = root_regions->claim_next();
     while (hr != NULL) {
-      _cm->scan_root_region(hr);
+      _cm->scan_root_region(hr, worker_id);
       hr = root_regions->claim_next();
     }
   }
@@ -1000,6 +1068,96 @@ void G1ConcurrentMark::mark_from_roots() {
   print_stats();
 }
 
+class G1UpdateRemSetTrackingBeforeRebuildTask : public AbstractGangTask {
+  G1CollectedHeap* _g1h;
+  G1ConcurrentMark* _cm;
+  HeapRegionClaimer _hrclaimer;
+  uint volatile _total_selected_for_rebuild;
+
+  class G1UpdateRemSetTrackingBeforeRebuild : public HeapRegionClosure {
+    G1CollectedHeap* _g1h;
+    G1ConcurrentMark* _cm;
+
+    uint _num_regions_selected_for_rebuild;  // The number of regions actually selected for rebuild.
+
+    // Distribute the given words across the humongous object starting with hr.
+    void distribute_marked_bytes(HeapRegion* hr, size_t marked_words) {
+      uint const region_idx = hr->hrm_index();
+      size_t const obj_size_in_words = (size_t)oop(hr->bottom())->size();
+      uint const num_regions_in_humongous = (uint)G1CollectedHeap::humongous_obj_size_in_regions(obj_size_in_words);
+
+      assert(marked_words == 0 || obj_size_in_words == marked_words,
+             "Marked words should either be 0 or the same as humongous object (" SIZE_FORMAT ") but is " SIZE_FORMAT,
+             obj_size_in_words, marked_words);
+
+      for (uint i = region_idx; i < (region_idx + num_regions_in_humongous); i++) {
+        HeapRegion* const r = _g1h->region_at(i);
+        size_t const words_to_add = MIN2(HeapRegion::GrainWords, marked_words);
+
+        log_trace(gc, marking)("Adding " SIZE_FORMAT " words to humongous region %u (%s)",
+                               words_to_add, i, r->get_type_str());
+        r->add_to_marked_bytes(words_to_add * HeapWordSize);
+        marked_words -= words_to_add;
+      }
+      assert(marked_words == 0,
+             SIZE_FORMAT " words left after distributing space across %u regions",
+             marked_words, num_regions_in_humongous);
+    }
+
+    void update_marked_bytes(HeapRegion* hr) {
+      uint const region_idx = hr->hrm_index();
+      size_t const marked_words = _cm->liveness(region_idx);
+      // The marking attributes the object's size completely to the humongous starts
+      // region. We need to distribute this value across the entire set of regions a
+      // humongous object spans.
+      if (hr->is_humongous()) {
+        assert(hr->is_starts_humongous() || marked_words == 0,
+               "Should not have marked words " SIZE_FORMAT " in non-starts humongous region %u (%s)",
+               marked_words, region_idx, hr->get_type_str());
+
+        if (marked_words > 0) {
+          distribute_marked_bytes(hr, marked_words);
+        }
+      } else {
+        log_trace(gc, marking)("Adding " SIZE_FORMAT " words to region %u (%s)", marked_words, region_idx, hr->get_type_str());
+        hr->add_to_marked_bytes(marked_words * HeapWordSize);
+      }
+    }
+
+  public:
+    G1UpdateRemSetTrackingBeforeRebuild(G1CollectedHeap* g1h, G1ConcurrentMark* cm) :
+      HeapRegionClosure(), _g1h(g1h), _cm(cm), _num_regions_selected_for_rebuild(0) { }
+
+    virtual bool do_heap_region(HeapRegion* r) {
+      update_marked_bytes(r);
+
+      G1RemSetTrackingPolicy* tracking_policy = _g1h->g1_policy()->remset_tracker();
+      if (!r->is_humongous() &&
+          tracking_policy->update_before_rebuild(r, _cm->liveness(r->hrm_index()) * HeapWordSize)) {
+        _num_regions_selected_for_rebuild++;
+      }
+      _cm->update_top_at_rebuild_start(r);
+
+      return false;
+    }
+
+    uint num_selected_for_rebuild() const { return _num_regions_selected_for_rebuild; }
+  };
+
+public:
+  G1UpdateRemSetTrackingBeforeRebuildTask(G1CollectedHeap* g1h, G1ConcurrentMark* cm, uint num_workers) :
+    AbstractGangTask("G1 Update RemSet Tracking Before Rebuild"),
+    _g1h(g1h), _cm(cm), _hrclaimer(num_workers), _total_selected_for_rebuild(0) { }
+
+  virtual void work(uint worker_id) {
+    G1UpdateRemSetTrackingBeforeRebuild update_cl(_g1h, _cm);
+    _g1h->heap_region_par_iterate_from_worker_offset(&update_cl, &_hrclaimer, worker_id);
+    Atomic::add(update_cl.num_selected_for_rebuild(), &_total_selected_for_rebuild);
+  }
+
+  uint total_selected_for_rebuild() const { return _total_selected_for_rebuild; }
+};
+
 void G1ConcurrentMark::checkpoint_roots_final(bool clear_all_soft_refs) {
   // world is stopped at this checkpoint
   assert(SafepointSynchronize::is_at_safepoint(),
@@ -1049,6 +1207,29 @@ void G1ConcurrentMark::checkpoint_roots_final(bool clear_all_soft_refs) {
     satb_mq_set.set_active_all_threads(false, /* new active value */
                                        true /* expected_active */);
 
+    {
+      GCTraceTime(Debug, gc, phases)("Flush Task Caches");
+      flush_all_task_caches();
+    }
+
+    {
+      GCTraceTime(Debug, gc, phases)("Update Remembered Set Tracking Before Rebuild");
+      G1UpdateRemSetTrackingBeforeRebuildTask cl(g1h, this, g1h->workers()->active_workers());
+      g1h->workers()->run_task(&cl);
+      log_debug(gc, remset, tracking)("Remembered Set Tracking update regions total %u, selected %u",
+                                      g1h->num_regions(), cl.total_selected_for_rebuild());
+    }
+
+    {
+      GCTraceTime(Debug, gc, phases)("Resize Heap");
+      // Give back memory that has not been needed for a while. This is the
+      // only opportunity to shrink the heap without a Full GC, e.g. after a
+      // periodic concurrent cycle on an otherwise idle application. Make
+      // regions freed by a previous cleanup visible to the resizing first.
+      g1h->append_secondary_free_list_if_not_empty_with_lock();
+      g1h->resize_heap_if_necessary();
+    }
+
     if (VerifyDuringGC) {
       g1h->verifier()->verify(G1HeapVerifier::G1VerifyRemark, VerifyOption_G1UseNextMarking, "During GC (after)");
     }
@@ -1095,6 +1276,7 @@ public:
 
   bool do_heap_region(HeapRegion *hr) {
     _g1->reset_gc_time_stamps(hr);
+    _g1->g1_policy()->remset_tracker()->update_after_rebuild(hr);
     hr->note_end_of_marking();
 
     if (hr->used() > 0 && hr->max_live_bytes() == 0 && !hr->is_young() && !hr->is_archive()) {
@@ -1193,22 +1375,8 @@ void G1ConcurrentMark::cleanup() {
 
   HeapRegionRemSet::reset_for_cleanup_tasks();
 
-  {
-    GCTraceTime(Debug, gc)("Finalize Live Data");
-    finalize_live_data();
-  }
-
-  if (VerifyDuringGC) {
-    GCTraceTime(Debug, gc)("Verify Live Data");
-    verify_live_data();
-  }
-
   g1h->collector_state()->set_mark_in_progress(false);
 
-  double count_end = os::elapsedTime();
-  double this_final_counting_time = (count_end - start);
-  _total_counting_time += this_final_counting_time;
-
   if (log_is_enabled(Trace, gc, liveness)) {
     G1PrintRegionLivenessInfoClosure cl("Post-Marking");
     _g1h->heap_region_iterate(&cl);
@@ -1233,14 +1401,6 @@ void G1ConcurrentMark::cleanup() {
     g1h->set_free_regions_coming();
   }
 
-  // call below, since it affects the metric by which we sort the heap
-  // regions.
-  if (G1ScrubRemSets) {
-    double rs_scrub_start = os::elapsedTime();
-    g1h->scrub_rem_set();
-    _total_rs_scrub_time += (os::elapsedTime() - rs_scrub_start);
-  }
-
   // this will also free any regions totally full of garbage objects,
   // and sort the regions.
   g1h->g1_policy()->record_concurrent_mark_cleanup_end();
@@ -1463,7 +1623,7 @@ public:
     _workers(workers), _active_workers(n_workers) { }
 
   // Executes the given task using concurrent marking worker threads.
-  virtual void execute(ProcessTask& task);
+  virtual void execute(ProcessTask& task, uint ergo_workers);
   virtual void execute(EnqueueTask& task);
 };
 
@@ -1495,9 +1655,12 @@ public:
   }
 };
 
-void G1CMRefProcTaskExecutor::execute(ProcessTask& proc_task) {
+void G1CMRefProcTaskExecutor::execute(ProcessTask& proc_task, uint ergo_workers) {
   assert(_workers != NULL, "Need parallel worker threads.");
   assert(_g1h->ref_processor_cm()->processing_is_mt(), "processing is not MT");
+  assert(_workers->active_workers() >= ergo_workers,
+         "Ergonomically chosen workers(%u) should be less than or equal to active workers(%u)",
+         ergo_workers, _workers->active_workers());
 
   G1CMRefProcTaskProxy proc_task_proxy(proc_task, _g1h, _cm);
 
@@ -1505,8 +1668,8 @@ void G1CMRefProcTaskExecutor::execute(ProcessTask& proc_task) {
   // proxy task execution, so that the termination protocol
   // and overflow handling in G1CMTask::do_marking_step() knows
   // how many workers to wait for.
-  _cm->set_concurrency(_active_workers);
-  _workers->run_task(&proc_task_proxy);
+  _cm->set_concurrency(ergo_workers);
+  _workers->run_task(&proc_task_proxy, ergo_workers);
 }
 
 class G1CMRefEnqueueTaskProxy: public AbstractGangTask {
@@ -1660,13 +1823,15 @@ void G1ConcurrentMark::weak_refs_work(bool clear_all_soft_refs) {
   // Unload Klasses, String, Symbols, Code Cache, etc.
   if (ClassUnloadingWithConcurrentMark) {
     GCTraceTime(Debug, gc, phases) debug("Class Unloading", _gc_timer_cm);
-    bool purged_classes = SystemDictionary::do_unloading(&g1_is_alive, _gc_timer_cm, false /* Defer cleaning */);
+    bool purged_classes = SystemDictionary::do_unloading(&g1_is_alive, _gc_timer_cm,
+                                                          false /* Defer cleaning */,
+                                                          false /* Clean alive loaders in parallel */);
     g1h->complete_cleaning(&g1_is_alive, purged_classes);
   } else {
     GCTraceTime(Debug, gc, phases) debug("Cleanup", _gc_timer_cm);
     // No need to clean string table and symbol table as they are treated as strong roots when
     // class unloading is disabled.
-    g1h->partial_cleaning(&g1_is_alive, false, false, G1StringDedup::is_enabled());
+    g1h->partial_cleaning(&g1_is_alive, false, G1StringDedup::is_enabled());
 
   }
 }
@@ -1928,28 +2093,12 @@ void G1ConcurrentMark::verify_no_cset_oops() {
   }
 }
 #endif // PRODUCT
-void G1ConcurrentMark::create_live_data() {
-  _g1h->g1_rem_set()->create_card_live_data(_concurrent_workers, _next_mark_bitmap);
-}
 
-void G1ConcurrentMark::finalize_live_data() {
-  _g1h->g1_rem_set()->finalize_card_live_data(_g1h->workers(), _next_mark_bitmap);
+void G1ConcurrentMark::rebuild_rem_set_concurrently() {
+  uint const worker_id_offset = DirtyCardQueueSet::num_par_ids() + G1ConcurrentRefine::max_num_threads();
+  _g1h->g1_rem_set()->rebuild_rem_set(this, _concurrent_workers, worker_id_offset);
 }
 
-void G1ConcurrentMark::verify_live_data() {
-  _g1h->g1_rem_set()->verify_card_live_data(_g1h->workers(), _next_mark_bitmap);
-}
-
-void G1ConcurrentMark::clear_live_data(WorkGang* workers) {
-  _g1h->g1_rem_set()->clear_card_live_data(workers);
-}
-
-#ifdef ASSERT
-void G1ConcurrentMark::verify_live_data_clear() {
-  _g1h->g1_rem_set()->verify_card_live_data_is_clear();
-}
-#endif
-
 void G1ConcurrentMark::print_stats() {
   if (!log_is_enabled(Debug, gc, stats)) {
     return;
@@ -1977,14 +2126,6 @@ void G1ConcurrentMark::abort() {
   // since VerifyDuringGC verifies the objects marked during
   // a full GC against the previous bitmap.
 
-  {
-    GCTraceTime(Debug, gc)("Clear Live Data");
-    clear_live_data(_g1h->workers());
-  }
-  DEBUG_ONLY({
-    GCTraceTime(Debug, gc)("Verify Live Data Clear");
-    verify_live_data_clear();
-  })
   // Empty mark stack
   reset_marking_state();
   for (uint i = 0; i < _max_num_tasks; ++i) {
@@ -2028,12 +2169,6 @@ void G1ConcurrentMark::print_summary_info() {
 
   }
   print_ms_time_info("  ", "cleanups", _cleanup_times);
-  log.trace("    Finalize live data total time = %8.2f s (avg = %8.2f ms).",
-            _total_counting_time, (_cleanup_times.num() > 0 ? _total_counting_time * 1000.0 / (double)_cleanup_times.num() : 0.0));
-  if (G1ScrubRemSets) {
-    log.trace("    RS scrub total time = %8.2f s (avg = %8.2f ms).",
-              _total_rs_scrub_time, (_cleanup_times.num() > 0 ? _total_rs_scrub_time * 1000.0 / (double)_cleanup_times.num() : 0.0));
-  }
   log.trace("  Total stop_world time = %8.2f s.",
             (_init_times.sum() + _remark_times.sum() + _cleanup_times.sum())/1000.0);
   log.trace("  Total concurrent time = %8.2f s (%8.2f s marking).",
@@ -2139,6 +2274,16 @@ void G1CMTask::reset(G1CMBitMap* next_mark_bitmap) {
   _elapsed_time_ms               = 0.0;
   _termination_time_ms           = 0.0;
   _termination_start_time_ms     = 0.0;
+
+  _mark_stats_cache.reset();
+}
+
+void G1CMTask::clear_mark_stats_cache(uint region_idx) {
+  _mark_stats_cache.reset(region_idx);
+}
+
+Pair<size_t, size_t> G1CMTask::flush_mark_stats_cache() {
+  return _mark_stats_cache.evict_all();
 }
 
 bool G1CMTask::should_exit_termination() {
@@ -2809,7 +2954,11 @@ void G1CMTask::do_marking_step(double time_target_ms,
   }
 }
 
-G1CMTask::G1CMTask(uint worker_id, G1ConcurrentMark* cm, G1CMTaskQueue* task_queue) :
+G1CMTask::G1CMTask(uint worker_id,
+                   G1ConcurrentMark* cm,
+                   G1CMTaskQueue* task_queue,
+                   G1RegionMarkStats* mark_stats,
+                   uint max_regions) :
   _objArray_processor(this),
   _worker_id(worker_id),
   _g1h(G1CollectedHeap::heap()),
@@ -2838,7 +2987,8 @@ G1CMTask::G1CMTask(uint worker_id, G1ConcurrentMark* cm, G1CMTaskQueue* task_que
   _termination_time_ms(0.0),
   _termination_start_time_ms(0.0),
   _concurrent(false),
-  _marking_step_diffs_ms()
+  _marking_step_diffs_ms(),
+  _mark_stats_cache(mark_stats, max_regions, RegionMarkStatsCacheSize)
 {
   guarantee(task_queue != NULL, "invariant");
 
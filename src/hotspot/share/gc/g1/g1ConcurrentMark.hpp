@@ -27,6 +27,7 @@
 
 #include "gc/g1/g1ConcurrentMarkBitMap.hpp"
 #include "gc/g1/g1ConcurrentMarkObjArrayProcessor.hpp"
+#include "gc/g1/g1RegionMarkStatsCache.hpp"
 #include "gc/g1/heapRegionSet.hpp"
 #include "gc/shared/taskqueue.hpp"
 #include "memory/allocation.hpp"
@@ -316,7 +317,7 @@ class G1ConcurrentMark: public CHeapObj<mtGC> {
   G1CMTask**             _tasks;            // Task queue array (max_worker_id length)
 
   G1CMTaskQueueSet*      _task_queues;      // Task queue set
-  ParallelTaskTerminator _terminator;       // For termination
+  TaskTerminator         _terminator;       // For termination
 
   // Two sync barriers that are used to synchronize tasks when an
   // overflow occurs. The algorithm is the following. All tasks enter
@@ -358,8 +359,6 @@ class G1ConcurrentMark: public CHeapObj<mtGC> {
   NumberSeq _remark_mark_times;
   NumberSeq _remark_weak_ref_times;
   NumberSeq _cleanup_times;
-  double    _total_counting_time;
-  double    _total_rs_scrub_time;
 
   double*   _accum_task_vtime;   // Accumulated task vtime
 
@@ -367,6 +366,14 @@ class G1ConcurrentMark: public CHeapObj<mtGC> {
   uint      _num_concurrent_workers; // The number of marking worker threads we're using
   uint      _max_concurrent_workers; // Maximum number of marking worker threads
 
+  // Per-region live data gathered during marking, indexed by region.
+  G1RegionMarkStats* _region_mark_stats;
+  // Top pointer for each region at the start of the rebuild remembered set process
+  // for regions which remembered sets need to be rebuilt. A NULL for a given region
+  // means that this region does not be scanned during the rebuilding remembered
+  // set phase at all.
+  HeapWord* volatile* _top_at_rebuild_starts;
+
   void weak_refs_work_parallel_part(BoolObjectClosure* is_alive, bool purged_classes);
   void weak_refs_work(bool clear_all_soft_refs);
 
@@ -376,6 +383,10 @@ class G1ConcurrentMark: public CHeapObj<mtGC> {
   // task local ones; should be called during initial mark.
   void reset();
 
+  // Clear statistics gathered during the concurrent cycle for the given region after
+  // it has been reclaimed.
+  void clear_statistics(HeapRegion* r);
+
   // Resets all the marking data structures. Called when we have to restart
   // marking or when marking completes (via set_non_marking_state below).
   void reset_marking_state();
@@ -401,7 +412,7 @@ class G1ConcurrentMark: public CHeapObj<mtGC> {
   HeapWord*               finger()          { return _finger;   }
   bool                    concurrent()      { return _concurrent; }
   uint                    active_tasks()    { return _num_active_tasks; }
-  ParallelTaskTerminator* terminator()      { return &_terminator; }
+  ParallelTaskTerminator* terminator() const { return _terminator.terminator(); }
 
   // Claims the next available region to be scanned by a marking
   // task/thread. It might return NULL if the next region is empty or
@@ -493,6 +504,24 @@ public:
   // Attempts to steal an object from the task queues of other tasks
   bool try_stealing(uint worker_id, int* hash_seed, G1TaskQueueEntry& task_entry);
 
+  // Update liveness data for the given object of the given size,
+  // gathered by the task of the given worker.
+  inline void add_to_liveness(uint worker_id, oop const obj, size_t size);
+  // Liveness of the given region as determined by concurrent marking, i.e. the amount of
+  // live words between bottom and nTAMS.
+  size_t liveness(uint region) { return _region_mark_stats[region]._live_words; }
+
+  // Sets the internal top_at_region_start for the given region to current top of the region.
+  inline void update_top_at_rebuild_start(HeapRegion* r);
+  // TARS for the given region during remembered set rebuilding.
+  inline HeapWord* top_at_rebuild_start(uint region) const;
+
+  // Clear statistics gathered during the concurrent cycle for the given region after
+  // it has been reclaimed.
+  void clear_statistics_in_region(uint region_idx);
+  // Notification for eagerly reclaimed regions to clean up.
+  void humongous_object_eagerly_reclaimed(HeapRegion* r);
+
   G1ConcurrentMark(G1CollectedHeap* g1h,
                    G1RegionToSpaceMapper* prev_bitmap_storage,
                    G1RegionToSpaceMapper* next_bitmap_storage);
@@ -532,7 +561,7 @@ public:
   void scan_root_regions();
 
   // Scan a single root region and mark everything reachable from it.
-  void scan_root_region(HeapRegion* hr);
+  void scan_root_region(HeapRegion* hr, uint worker_id);
 
   // Do concurrent phase of marking, to a tentative transitive closure.
   void mark_from_roots();
@@ -540,6 +569,10 @@ public:
   void checkpoint_roots_final(bool clear_all_soft_refs);
   void checkpoint_roots_final_work();
 
+  // Rebuild the remembered sets of the regions selected at remark concurrently,
+  // using the marking information just gathered.
+  void rebuild_rem_set_concurrently();
+
   void cleanup();
   void complete_cleanup();
 
@@ -573,9 +606,11 @@ public:
 
   void print_on_error(outputStream* st) const;
 
-  // Mark the given object on the next bitmap if it is below nTAMS.
-  inline bool mark_in_next_bitmap(HeapRegion* const hr, oop const obj);
-  inline bool mark_in_next_bitmap(oop const obj);
+  // Mark the given object on the next bitmap if it is below nTAMS, and account
+  // for its size in the liveness data of the task with the given worker id. If
+  // obj_size is zero, the size is taken from the object.
+  inline bool mark_in_next_bitmap(uint worker_id, HeapRegion* const hr, oop const obj, size_t const obj_size = 0);
+  inline bool mark_in_next_bitmap(uint worker_id, oop const obj, size_t const obj_size = 0);
 
   // Returns true if initialization was successfully completed.
   bool completed_initialization() const {
@@ -586,21 +621,11 @@ public:
   G1OldTracer* gc_tracer_cm() const { return _gc_tracer_cm; }
 
 private:
-  // Clear (Reset) all liveness count data.
-  void clear_live_data(WorkGang* workers);
+  // Flush the mark statistics caches of all tasks into the global statistics.
+  void flush_all_task_caches();
 
-#ifdef ASSERT
-  // Verify all of the above data structures that they are in initial state.
-  void verify_live_data_clear();
-#endif
-
-  // Aggregates the per-card liveness data based on the current marking. Also sets
-  // the amount of marked bytes for each region.
-  void create_live_data();
-
-  void finalize_live_data();
-
-  void verify_live_data();
+  // Clear the liveness data of all regions.
+  void clear_all_region_mark_stats();
 };
 
 // A class representing a marking task.
@@ -694,6 +719,12 @@ private:
 
   TruncatedSeq                _marking_step_diffs_ms;
 
+  // Number of entries in the per-task stats entry. This seems enough to have a very
+  // low cache miss rate.
+  static const uint RegionMarkStatsCacheSize = 1024;
+
+  G1RegionMarkStatsCache      _mark_stats_cache;
+
   // Updates the local fields after this task has claimed
   // a new region to scan
   void setup_for_region(HeapRegion* hr);
@@ -732,6 +763,11 @@ public:
   inline size_t scan_objArray(objArrayOop obj, MemRegion mr);
   // Resets the task; should be called right at the beginning of a marking phase.
   void reset(G1CMBitMap* next_mark_bitmap);
+  // Clears the cached liveness data of the given region.
+  void clear_mark_stats_cache(uint region_idx);
+  // Evict the whole statistics cache into the global statistics. Returns the
+  // number of cache hits and misses so far.
+  Pair<size_t, size_t> flush_mark_stats_cache();
   // Clears all the fields that correspond to a claimed region.
   void clear_region_fields();
 
@@ -816,9 +852,14 @@ public:
     _finger = new_finger;
   }
 
+  // Increment the live data of the given object's region by the given size.
+  inline void update_liveness(oop const obj, size_t const obj_size);
+
   G1CMTask(uint worker_id,
            G1ConcurrentMark *cm,
-           G1CMTaskQueue* task_queue);
+           G1CMTaskQueue* task_queue,
+           G1RegionMarkStats* mark_stats,
+           uint max_regions);
 
   // Prints statistics associated with this task
   void print_stats();
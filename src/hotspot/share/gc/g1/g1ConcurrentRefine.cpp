@@ -322,10 +322,22 @@ void G1ConcurrentRefine::print_threads_on(outputStream* st) const {
 static size_t calc_new_green_zone(size_t green,
                                   double update_rs_time,
                                   size_t update_rs_processed_buffers,
-                                  double goal_ms) {
-  // Adjust green zone based on whether we're meeting the time goal.
-  // Limit to max_green_zone.
+                                  double goal_ms,
+                                  double predicted_buffer_cost_ms) {
   const double inc_k = 1.1, dec_k = 0.9;
+  if (predicted_buffer_cost_ms > 0.0) {
+    // Aim for the number of buffers that is predicted to be processed within
+    // the goal time. Only move halfway towards that target to dampen noise in
+    // the prediction, and back off if the goal has just been missed anyway.
+    double target = MIN2(goal_ms / predicted_buffer_cost_ms, (double)max_green_zone);
+    double new_green = (green + target) / 2.0;
+    if (update_rs_time > goal_ms) {
+      new_green = MIN2(new_green, green * dec_k);
+    }
+    return static_cast<size_t>(new_green);
+  }
+  // Without a prediction, adjust green zone based on whether we're meeting
+  // the time goal. Limit to max_green_zone.
   if (update_rs_time > goal_ms) {
     if (green > 0) {
       green = static_cast<size_t>(green * dec_k);
@@ -350,19 +362,24 @@ static size_t calc_new_red_zone(size_t green, size_t yellow) {
 
 void G1ConcurrentRefine::update_zones(double update_rs_time,
                                       size_t update_rs_processed_buffers,
-                                      double goal_ms) {
+                                      double goal_ms,
+                                      double predicted_card_cost_ms) {
+  double predicted_buffer_cost_ms = predicted_card_cost_ms * JavaThread::dirty_card_queue_set().buffer_size();
   log_trace( CTRL_TAGS )("Updating Refinement Zones: "
                          "update_rs time: %.3fms, "
                          "update_rs buffers: " SIZE_FORMAT ", "
-                         "update_rs goal time: %.3fms",
+                         "update_rs goal time: %.3fms, "
+                         "predicted buffer cost: %.3fms",
                          update_rs_time,
                          update_rs_processed_buffers,
-                         goal_ms);
+                         goal_ms,
+                         predicted_buffer_cost_ms);
 
   _green_zone = calc_new_green_zone(_green_zone,
                                     update_rs_time,
                                     update_rs_processed_buffers,
-                                    goal_ms);
+                                    goal_ms,
+                                    predicted_buffer_cost_ms);
   _yellow_zone = calc_new_yellow_zone(_green_zone, _min_yellow_zone_size);
   _red_zone = calc_new_red_zone(_green_zone, _yellow_zone);
 
@@ -376,11 +393,12 @@ void G1ConcurrentRefine::update_zones(double update_rs_time,
 
 void G1ConcurrentRefine::adjust(double update_rs_time,
                                 size_t update_rs_processed_buffers,
-                                double goal_ms) {
+                                double goal_ms,
+                                double predicted_card_cost_ms) {
   DirtyCardQueueSet& dcqs = JavaThread::dirty_card_queue_set();
 
   if (G1UseAdaptiveConcRefinement) {
-    update_zones(update_rs_time, update_rs_processed_buffers, goal_ms);
+    update_zones(update_rs_time, update_rs_processed_buffers, goal_ms, predicted_card_cost_ms);
 
     // Change the barrier params
     if (max_num_threads() == 0) {
@@ -393,9 +411,14 @@ void G1ConcurrentRefine::adjust(double update_rs_time,
       dcqs.set_process_completed_threshold((int)activate);
     }
     dcqs.set_max_completed_queue((int)red_zone());
+    // Once all refinement threads are running, throttle the mutators with
+    // the highest dirty card rates before all mutators have to help.
+    dcqs.set_mut_throttle_threshold(yellow_zone());
   }
 
   size_t curr_queue_size = dcqs.completed_buffers_num();
+  log_debug( CTRL_TAGS )("Refinement threads to activate: %u of %u (" SIZE_FORMAT " completed buffers)",
+                         num_threads_wanted(curr_queue_size), max_num_threads(), curr_queue_size);
   if (curr_queue_size >= yellow_zone()) {
     dcqs.set_completed_queue_padding(curr_queue_size);
   } else {
@@ -418,6 +441,14 @@ uint G1ConcurrentRefine::worker_id_offset() {
   return DirtyCardQueueSet::num_par_ids();
 }
 
+uint G1ConcurrentRefine::num_threads_wanted(size_t num_cur_buffers) const {
+  uint wanted = 0;
+  while (wanted < max_num_threads() && num_cur_buffers > activation_threshold(wanted)) {
+    wanted++;
+  }
+  return wanted;
+}
+
 void G1ConcurrentRefine::maybe_activate_more_threads(uint worker_id, size_t num_cur_buffers) {
   if (num_cur_buffers > activation_threshold(worker_id + 1)) {
     _thread_control.maybe_activate_next(worker_id);
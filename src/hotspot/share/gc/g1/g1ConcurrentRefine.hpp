@@ -98,13 +98,21 @@ class G1ConcurrentRefine : public CHeapObj<mtGC> {
                      size_t min_yellow_zone_size);
 
   // Update green/yellow/red zone values based on how well goals are being met.
+  // If a prediction of the cost of refining a card is available, the green
+  // zone is steered towards the number of buffers predicted to be processed
+  // within the goal time.
   void update_zones(double update_rs_time,
                     size_t update_rs_processed_buffers,
-                    double goal_ms);
+                    double goal_ms,
+                    double predicted_card_cost_ms);
 
   static uint worker_id_offset();
   void maybe_activate_more_threads(uint worker_id, size_t num_cur_buffers);
 
+  // The number of refinement threads that should be active for the given
+  // number of completed buffers.
+  uint num_threads_wanted(size_t num_cur_buffers) const;
+
   jint initialize();
 public:
   ~G1ConcurrentRefine();
@@ -115,8 +123,10 @@ public:
 
   void stop();
 
-  // Adjust refinement thresholds based on work done during the pause and the goal time.
-  void adjust(double update_rs_time, size_t update_rs_processed_buffers, double goal_ms);
+  // Adjust refinement thresholds based on work done during the pause, the goal time
+  // and the predicted time to refine a card during the pause.
+  void adjust(double update_rs_time, size_t update_rs_processed_buffers, double goal_ms,
+              double predicted_card_cost_ms);
 
   size_t activation_threshold(uint worker_id) const;
   size_t deactivation_threshold(uint worker_id) const;
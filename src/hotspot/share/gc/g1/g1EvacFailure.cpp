@@ -124,7 +124,7 @@ public:
         // explicitly and all objects in the CSet are considered
         // (implicitly) live. So, we won't mark them explicitly and
         // we'll leave them over NTAMS.
-        _cm->mark_in_next_bitmap(_hr, obj);
+        _cm->mark_in_next_bitmap(_worker_id, _hr, obj);
       }
       size_t obj_size = obj->size();
 
@@ -238,6 +238,10 @@ public:
         size_t live_bytes = remove_self_forward_ptr_by_walking_hr(hr, during_initial_mark);
 
         hr->rem_set()->clean_strong_code_roots(hr);
+        // The region becomes an old region with an untracked remembered set;
+        // it is only considered for evacuation again after a remembered set
+        // rebuild.
+        hr->rem_set()->clear_locked(true /* only_cardset */);
 
         hr->note_self_forwarding_removal_end(live_bytes);
       }
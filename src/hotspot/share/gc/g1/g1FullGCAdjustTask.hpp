@@ -38,7 +38,7 @@ class G1FullGCAdjustTask : public G1FullGCTask {
   G1RootProcessor          _root_processor;
   HeapRegionClaimer        _hrclaimer;
   G1AdjustClosure          _adjust;
-  G1StringDedupUnlinkOrOopsDoClosure _adjust_string_dedup;
+  StringDedupUnlinkOrOopsDoClosure _adjust_string_dedup;
 
 public:
   G1FullGCAdjustTask(G1FullCollector* collector);
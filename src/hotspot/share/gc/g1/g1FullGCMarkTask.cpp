@@ -52,14 +52,14 @@ void G1FullGCMarkTask::work(uint worker_id) {
         marker->cld_closure(),
         &code_closure);
   } else {
-    _root_processor.process_all_roots_no_string_table(
+    _root_processor.process_all_roots(
         marker->mark_closure(),
         marker->cld_closure(),
         &code_closure);
   }
 
   // Mark stack is populated, now process and drain it.
-  marker->complete_marking(collector()->oop_queue_set(), collector()->array_queue_set(), &_terminator);
+  marker->complete_marking(collector()->oop_queue_set(), collector()->array_queue_set(), _terminator.terminator());
 
   // This is the point where the entire marking should have completed.
   assert(marker->oop_stack()->is_empty(), "Marking should have completed");
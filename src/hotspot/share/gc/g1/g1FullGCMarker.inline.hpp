@@ -29,8 +29,9 @@
 #include "gc/g1/g1ConcurrentMarkBitMap.inline.hpp"
 #include "gc/g1/g1FullGCMarker.hpp"
 #include "gc/g1/g1StringDedup.hpp"
-#include "gc/g1/g1StringDedupQueue.hpp"
 #include "gc/shared/preservedMarks.inline.hpp"
+#include "gc/shared/stringDedupQueue.hpp"
+#include "gc/shared/taskqueue.inline.hpp"
 #include "utilities/debug.hpp"
 
 inline bool G1FullGCMarker::mark_object(oop obj) {
@@ -102,10 +103,11 @@ inline void G1FullGCMarker::follow_array(objArrayOop array) {
 void G1FullGCMarker::follow_array_chunk(objArrayOop array, int index) {
   const int len = array->length();
   const int beg_index = index;
-  assert(beg_index < len || len == 0, "index too large");
+  const int end_index = ObjArrayTask::chunk_end(beg_index, len);
 
-  const int stride = MIN2(len - beg_index, (int) ObjArrayMarkingStride);
-  const int end_index = beg_index + stride;
+  if (end_index < len) {
+    push_objarray(array, end_index); // Push the continuation.
+  }
 
   array->oop_iterate_range(mark_closure(), beg_index, end_index);
 
@@ -117,10 +119,6 @@ void G1FullGCMarker::follow_array_chunk(objArrayOop array, int index) {
       assert(false, "Failed");
     }
   }
-
-  if (end_index < len) {
-    push_objarray(array, end_index); // Push the continuation.
-  }
 }
 
 inline void G1FullGCMarker::follow_object(oop obj) {
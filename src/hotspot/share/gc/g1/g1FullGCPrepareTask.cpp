@@ -31,6 +31,7 @@
 #include "gc/g1/g1FullGCOopClosures.inline.hpp"
 #include "gc/g1/g1FullGCPrepareTask.hpp"
 #include "gc/g1/g1HotCardCache.hpp"
+#include "gc/g1/g1Policy.hpp"
 #include "gc/g1/heapRegion.inline.hpp"
 #include "gc/shared/gcTraceTime.inline.hpp"
 #include "gc/shared/referenceProcessor.hpp"
@@ -54,6 +55,13 @@ bool G1FullGCPrepareTask::G1CalculatePointersClosure::do_heap_region(HeapRegion*
   // Reset data structures not valid after Full GC.
   reset_region_metadata(hr);
 
+  // Remembered sets of live humongous objects are rebuilt during the adjust
+  // phase to keep them eligible for eager reclaim; all other remembered sets
+  // stay untracked until the next concurrent cycle rebuilds them.
+  if (hr->is_humongous()) {
+    _g1h->g1_policy()->remset_tracker()->update_at_allocate(hr);
+  }
+
   return false;
 }
 
@@ -47,11 +47,12 @@ G1FullGCReferenceProcessingExecutor::~G1FullGCReferenceProcessingExecutor() {
 }
 
 G1FullGCReferenceProcessingExecutor::G1RefProcTaskProxy::G1RefProcTaskProxy(ProcessTask& proc_task,
-                                                                      G1FullCollector* collector) :
+                                                                      G1FullCollector* collector,
+                                                                      uint workers) :
      AbstractGangTask("G1 reference processing task"),
      _proc_task(proc_task),
      _collector(collector),
-     _terminator(_collector->workers(), _collector->oop_queue_set()) { }
+     _terminator(workers, _collector->oop_queue_set()) { }
 
 void G1FullGCReferenceProcessingExecutor::G1RefProcTaskProxy::work(uint worker_id) {
   G1FullGCMarker* marker = _collector->marker(worker_id);
@@ -75,9 +76,16 @@ void G1FullGCReferenceProcessingExecutor::run_task(AbstractGangTask* task) {
   G1CollectedHeap::heap()->workers()->run_task(task, _collector->workers());
 }
 
-void G1FullGCReferenceProcessingExecutor::execute(ProcessTask& proc_task) {
-  G1RefProcTaskProxy proc_task_proxy(proc_task, _collector);
-  run_task(&proc_task_proxy);
+void G1FullGCReferenceProcessingExecutor::run_task(AbstractGangTask* task, uint workers) {
+  G1CollectedHeap::heap()->workers()->run_task(task, workers);
+}
+
+void G1FullGCReferenceProcessingExecutor::execute(ProcessTask& proc_task, uint ergo_workers) {
+  assert(ergo_workers <= _collector->workers(),
+         "Ergonomically chosen workers (%u) must be less than or equal to active workers (%u)",
+         ergo_workers, _collector->workers());
+  G1RefProcTaskProxy proc_task_proxy(proc_task, _collector, ergo_workers);
+  run_task(&proc_task_proxy, ergo_workers);
 }
 
 // Driver routine for parallel reference processing.
@@ -50,21 +50,23 @@ public:
   void execute(STWGCTimer* timer, G1FullGCTracer* tracer);
 
   // Executes the given task using concurrent marking worker threads.
-  virtual void execute(ProcessTask& task);
+  virtual void execute(ProcessTask& task, uint ergo_workers);
   virtual void execute(EnqueueTask& task);
 
 private:
   void run_task(AbstractGangTask* task);
+  void run_task(AbstractGangTask* task, uint workers);
 
   class G1RefProcTaskProxy : public AbstractGangTask {
     typedef AbstractRefProcTaskExecutor::ProcessTask ProcessTask;
     ProcessTask&             _proc_task;
     G1FullCollector*         _collector;
-    ParallelTaskTerminator   _terminator;
+    TaskTerminator           _terminator;
 
   public:
     G1RefProcTaskProxy(ProcessTask& proc_task,
-                       G1FullCollector* scope);
+                       G1FullCollector* scope,
+                       uint workers);
 
     virtual void work(uint worker_id);
   };
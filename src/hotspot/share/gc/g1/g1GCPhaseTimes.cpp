@@ -50,7 +50,6 @@ G1GCPhaseTimes::G1GCPhaseTimes(STWGCTimer* gc_timer, uint max_gc_threads) :
 
   // Root scanning phases
   _gc_par_phases[ThreadRoots] = new WorkerDataArray<double>(max_gc_threads, "Thread Roots (ms):");
-  _gc_par_phases[StringTableRoots] = new WorkerDataArray<double>(max_gc_threads, "StringTable Roots (ms):");
   _gc_par_phases[UniverseRoots] = new WorkerDataArray<double>(max_gc_threads, "Universe Roots (ms):");
   _gc_par_phases[JNIRoots] = new WorkerDataArray<double>(max_gc_threads, "JNI Handles Roots (ms):");
   _gc_par_phases[ObjectSynchronizerRoots] = new WorkerDataArray<double>(max_gc_threads, "ObjectSynchronizer Roots (ms):");
@@ -79,20 +78,39 @@ G1GCPhaseTimes::G1GCPhaseTimes(STWGCTimer* gc_timer, uint max_gc_threads) :
   _gc_par_phases[GCWorkerTotal] = new WorkerDataArray<double>(max_gc_threads, "GC Worker Total (ms):");
   _gc_par_phases[GCWorkerEnd] = new WorkerDataArray<double>(max_gc_threads, "GC Worker End (ms):");
   _gc_par_phases[Other] = new WorkerDataArray<double>(max_gc_threads, "GC Worker Other (ms):");
+  _gc_par_phases[MergeRS] = new WorkerDataArray<double>(max_gc_threads, "Merge RS (ms):");
+  _gc_par_phases[OptMergeRS] = new WorkerDataArray<double>(max_gc_threads, "Optional Merge RS (ms):");
+  _gc_par_phases[OptScanRS] = new WorkerDataArray<double>(max_gc_threads, "Optional Scan RS (ms):");
+  _gc_par_phases[OptObjCopy] = new WorkerDataArray<double>(max_gc_threads, "Optional Object Copy (ms):");
+  _gc_par_phases[OptTermination] = new WorkerDataArray<double>(max_gc_threads, "Optional Termination (ms):");
+
+  _merge_rs_merged_cards = new WorkerDataArray<size_t>(max_gc_threads, "Merged Cards:");
+  _gc_par_phases[MergeRS]->link_thread_work_items(_merge_rs_merged_cards);
+  _opt_merge_rs_merged_cards = new WorkerDataArray<size_t>(max_gc_threads, "Merged Cards:");
+  _gc_par_phases[OptMergeRS]->link_thread_work_items(_opt_merge_rs_merged_cards);
 
   _scan_rs_scanned_cards = new WorkerDataArray<size_t>(max_gc_threads, "Scanned Cards:");
   _gc_par_phases[ScanRS]->link_thread_work_items(_scan_rs_scanned_cards, ScanRSScannedCards);
-  _scan_rs_claimed_cards = new WorkerDataArray<size_t>(max_gc_threads, "Claimed Cards:");
-  _gc_par_phases[ScanRS]->link_thread_work_items(_scan_rs_claimed_cards, ScanRSClaimedCards);
-  _scan_rs_skipped_cards = new WorkerDataArray<size_t>(max_gc_threads, "Skipped Cards:");
-  _gc_par_phases[ScanRS]->link_thread_work_items(_scan_rs_skipped_cards, ScanRSSkippedCards);
+  _scan_rs_claimed_chunks = new WorkerDataArray<size_t>(max_gc_threads, "Claimed Chunks:");
+  _gc_par_phases[ScanRS]->link_thread_work_items(_scan_rs_claimed_chunks, ScanRSClaimedChunks);
+  _scan_rs_skipped_chunks = new WorkerDataArray<size_t>(max_gc_threads, "Skipped Chunks:");
+  _gc_par_phases[ScanRS]->link_thread_work_items(_scan_rs_skipped_chunks, ScanRSSkippedChunks);
+
+  _opt_scan_rs_scanned_cards = new WorkerDataArray<size_t>(max_gc_threads, "Scanned Cards:");
+  _gc_par_phases[OptScanRS]->link_thread_work_items(_opt_scan_rs_scanned_cards, OptScanRSScannedCards);
+  _opt_scan_rs_claimed_chunks = new WorkerDataArray<size_t>(max_gc_threads, "Claimed Chunks:");
+  _gc_par_phases[OptScanRS]->link_thread_work_items(_opt_scan_rs_claimed_chunks, OptScanRSClaimedChunks);
+  _opt_scan_rs_skipped_chunks = new WorkerDataArray<size_t>(max_gc_threads, "Skipped Chunks:");
+  _gc_par_phases[OptScanRS]->link_thread_work_items(_opt_scan_rs_skipped_chunks, OptScanRSSkippedChunks);
+  _opt_scan_rs_scanned_opt_refs = new WorkerDataArray<size_t>(max_gc_threads, "Scanned Refs:");
+  _gc_par_phases[OptScanRS]->link_thread_work_items(_opt_scan_rs_scanned_opt_refs, OptScanRSScannedOptRefs);
 
   _update_rs_processed_buffers = new WorkerDataArray<size_t>(max_gc_threads, "Processed Buffers:");
   _gc_par_phases[UpdateRS]->link_thread_work_items(_update_rs_processed_buffers, UpdateRSProcessedBuffers);
   _update_rs_scanned_cards = new WorkerDataArray<size_t>(max_gc_threads, "Scanned Cards:");
   _gc_par_phases[UpdateRS]->link_thread_work_items(_update_rs_scanned_cards, UpdateRSScannedCards);
   _update_rs_skipped_cards = new WorkerDataArray<size_t>(max_gc_threads, "Skipped Cards:");
-  _gc_par_phases[UpdateRS]->link_thread_work_items(_update_rs_skipped_cards, ScanRSSkippedCards);
+  _gc_par_phases[UpdateRS]->link_thread_work_items(_update_rs_skipped_cards, UpdateRSSkippedCards);
 
   _termination_attempts = new WorkerDataArray<size_t>(max_gc_threads, "Termination Attempts:");
   _gc_par_phases[Termination]->link_thread_work_items(_termination_attempts);
@@ -113,12 +131,17 @@ G1GCPhaseTimes::G1GCPhaseTimes(STWGCTimer* gc_timer, uint max_gc_threads) :
   _gc_par_phases[NonYoungFreeCSet] = new WorkerDataArray<double>(max_gc_threads, "Non-Young Free Collection Set (ms):");
 
   _gc_par_phases[PreserveCMReferents] = new WorkerDataArray<double>(max_gc_threads, "Parallel Preserve CM Refs (ms):");
+  _gc_par_phases[PreserveCMReferentsTermination] = new WorkerDataArray<double>(max_gc_threads, "Preserve CM Refs Termination (ms):");
+  _preserve_cm_referents_termination_attempts = new WorkerDataArray<size_t>(max_gc_threads, "Termination Attempts:");
+  _gc_par_phases[PreserveCMReferentsTermination]->link_thread_work_items(_preserve_cm_referents_termination_attempts);
 
+  create_perf_counters();
   reset();
 }
 
 void G1GCPhaseTimes::reset() {
   _cur_collection_par_time_ms = 0.0;
+  _cur_optional_evac_ms = 0.0;
   _cur_collection_code_root_fixup_time_ms = 0.0;
   _cur_strong_code_root_purge_time_ms = 0.0;
   _cur_evac_fail_recalc_used = 0.0;
@@ -160,6 +183,73 @@ void G1GCPhaseTimes::reset() {
   _ref_phase_times.reset();
 }
 
+void G1GCPhaseTimes::create_perf_counters() {
+  for (int i = 0; i < GCParPhasesSentinel; i++) {
+    _perf_phase_time[i] = NULL;
+    for (uint j = 0; j < PhaseHistogramBuckets; j++) {
+      _perf_phase_histogram[i][j] = NULL;
+    }
+  }
+  if (!UsePerfData) {
+    return;
+  }
+
+  static const struct {
+    GCParPhases phase;
+    const char* name;
+  } exported[] = {
+    { ExtRootScan,   "extRootScan" },
+    { UpdateRS,      "updateRS" },
+    { ScanRS,        "scanRS" },
+    { CodeRoots,     "codeRoots" },
+    { ObjCopy,       "objCopy" },
+    { Termination,   "termination" },
+    { Other,         "other" },
+    { GCWorkerTotal, "workerTotal" }
+  };
+
+  static const char* bucket_names[PhaseHistogramBuckets] = {
+    "lt1ms", "lt10ms", "lt100ms", "ge100ms"
+  };
+
+  EXCEPTION_MARK;
+  ResourceMark rm;
+  for (size_t i = 0; i < ARRAY_SIZE(exported); i++) {
+    GCParPhases phase = exported[i].phase;
+    const char* ns = PerfDataManager::name_space("g1.phases", exported[i].name);
+    const char* cname = PerfDataManager::counter_name(ns, "time");
+    _perf_phase_time[phase] = PerfDataManager::create_counter(SUN_GC, cname, PerfData::U_Ticks, CHECK);
+    for (uint j = 0; j < PhaseHistogramBuckets; j++) {
+      cname = PerfDataManager::counter_name(ns, bucket_names[j]);
+      _perf_phase_histogram[phase][j] = PerfDataManager::create_counter(SUN_GC, cname, PerfData::U_Events, CHECK);
+    }
+  }
+}
+
+void G1GCPhaseTimes::update_perf_counters() {
+  double uninitialized = WorkerDataArray<double>::uninitialized();
+  for (int i = 0; i < GCParPhasesSentinel; i++) {
+    if (_perf_phase_time[i] == NULL || _gc_par_phases[i] == NULL) {
+      continue;
+    }
+    // The pause waits for the slowest worker, so that is what we account.
+    double max_secs = -1.0;
+    for (uint w = 0; w < _max_gc_threads; w++) {
+      double value = _gc_par_phases[i]->get(w);
+      if (value != uninitialized && value > max_secs) {
+        max_secs = value;
+      }
+    }
+    if (max_secs < 0.0) {
+      continue;
+    }
+    _perf_phase_time[i]->inc((jlong)(max_secs * os::elapsed_frequency()));
+    double max_ms = max_secs * MILLIUNITS;
+    uint bucket = max_ms < 1.0 ? 0 : (max_ms < 10.0 ? 1 : (max_ms < 100.0 ? 2 : 3));
+    _perf_phase_histogram[i][bucket]->inc();
+  }
+}
+
 void G1GCPhaseTimes::note_gc_start() {
   _gc_start_counter = os::elapsed_counter();
   reset();
@@ -210,6 +300,10 @@ void G1GCPhaseTimes::note_gc_end() {
       ASSERT_PHASE_UNINITIALIZED(Termination);
     }
   }
+
+  if (UsePerfData) {
+    update_perf_counters();
+  }
 }
 
 #undef ASSERT_PHASE_UNINITIALIZED
@@ -228,6 +322,18 @@ void G1GCPhaseTimes::record_thread_work_item(GCParPhases phase, uint worker_i, s
   _gc_par_phases[phase]->set_thread_work_item(worker_i, count, index);
 }
 
+void G1GCPhaseTimes::record_or_add_time_secs(GCParPhases phase, uint worker_i, double secs) {
+  if (_gc_par_phases[phase]->get(worker_i) == _gc_par_phases[phase]->uninitialized()) {
+    record_time_secs(phase, worker_i, secs);
+  } else {
+    add_time_secs(phase, worker_i, secs);
+  }
+}
+
+void G1GCPhaseTimes::record_or_add_thread_work_item(GCParPhases phase, uint worker_i, size_t count, uint index) {
+  _gc_par_phases[phase]->set_or_add_thread_work_item(worker_i, count, index);
+}
+
 // return the average time for a phase in milliseconds
 double G1GCPhaseTimes::average_time_ms(GCParPhases phase) {
   return _gc_par_phases[phase]->average() * 1000.0;
@@ -342,6 +448,7 @@ double G1GCPhaseTimes::print_evacuate_collection_set() const {
 
   info_time("Evacuate Collection Set", sum_ms);
 
+  debug_phase(_gc_par_phases[MergeRS]);
   trace_phase(_gc_par_phases[GCWorkerStart], false);
   debug_phase(_gc_par_phases[ExtRootScan]);
   for (int i = ThreadRoots; i <= SATBFiltering; i++) {
@@ -365,6 +472,18 @@ double G1GCPhaseTimes::print_evacuate_collection_set() const {
   return sum_ms;
 }
 
+double G1GCPhaseTimes::print_evacuate_optional_collection_set() const {
+  const double sum_ms = _cur_optional_evac_ms;
+  if (sum_ms > 0) {
+    info_time("Evacuate Optional Collection Set", sum_ms);
+    debug_phase(_gc_par_phases[OptMergeRS]);
+    debug_phase(_gc_par_phases[OptScanRS]);
+    debug_phase(_gc_par_phases[OptObjCopy]);
+    debug_phase(_gc_par_phases[OptTermination]);
+  }
+  return sum_ms;
+}
+
 double G1GCPhaseTimes::print_post_evacuate_collection_set() const {
   const double evac_fail_handling = _cur_evac_fail_recalc_used +
                                     _cur_evac_fail_remove_self_forwards;
@@ -388,6 +507,7 @@ double G1GCPhaseTimes::print_post_evacuate_collection_set() const {
 
   debug_time("Preserve CM Refs", _recorded_preserve_cm_referents_time_ms);
   trace_phase(_gc_par_phases[PreserveCMReferents]);
+  trace_phase(_gc_par_phases[PreserveCMReferentsTermination]);
 
   debug_time_for_reference("Reference Processing", _cur_ref_proc_time_ms);
   _ref_phase_times.print_all_references(2, false);
@@ -451,6 +571,7 @@ void G1GCPhaseTimes::print() {
   double accounted_ms = 0.0;
   accounted_ms += print_pre_evacuate_collection_set();
   accounted_ms += print_evacuate_collection_set();
+  accounted_ms += print_evacuate_optional_collection_set();
   accounted_ms += print_post_evacuate_collection_set();
   print_other(accounted_ms);
 
@@ -28,6 +28,7 @@
 #include "gc/shared/referenceProcessorPhaseTimes.hpp"
 #include "logging/logLevel.hpp"
 #include "memory/allocation.hpp"
+#include "runtime/perfData.hpp"
 #include "utilities/macros.hpp"
 
 class LineBuffer;
@@ -45,7 +46,6 @@ class G1GCPhaseTimes : public CHeapObj<mtGC> {
     GCWorkerStart,
     ExtRootScan,
     ThreadRoots,
-    StringTableRoots,
     UniverseRoots,
     JNIRoots,
     ObjectSynchronizerRoots,
@@ -69,10 +69,16 @@ class G1GCPhaseTimes : public CHeapObj<mtGC> {
     Other,
     GCWorkerTotal,
     GCWorkerEnd,
+    MergeRS,
+    OptMergeRS,
+    OptScanRS,
+    OptObjCopy,
+    OptTermination,
     StringDedupQueueFixup,
     StringDedupTableFixup,
     RedirtyCards,
     PreserveCMReferents,
+    PreserveCMReferentsTermination,
     YoungFreeCSet,
     NonYoungFreeCSet,
     GCParPhasesSentinel
@@ -80,8 +86,15 @@ class G1GCPhaseTimes : public CHeapObj<mtGC> {
 
   enum GCScanRSWorkItems {
     ScanRSScannedCards,
-    ScanRSClaimedCards,
-    ScanRSSkippedCards
+    ScanRSClaimedChunks,
+    ScanRSSkippedChunks
+  };
+
+  enum GCOptScanRSWorkItems {
+    OptScanRSScannedCards,
+    OptScanRSClaimedChunks,
+    OptScanRSSkippedChunks,
+    OptScanRSScannedOptRefs
   };
 
   enum GCUpdateRSWorkItems {
@@ -102,15 +115,25 @@ class G1GCPhaseTimes : public CHeapObj<mtGC> {
   WorkerDataArray<size_t>* _update_rs_scanned_cards;
   WorkerDataArray<size_t>* _update_rs_skipped_cards;
 
+  WorkerDataArray<size_t>* _merge_rs_merged_cards;
+  WorkerDataArray<size_t>* _opt_merge_rs_merged_cards;
+
   WorkerDataArray<size_t>* _scan_rs_scanned_cards;
-  WorkerDataArray<size_t>* _scan_rs_claimed_cards;
-  WorkerDataArray<size_t>* _scan_rs_skipped_cards;
+  WorkerDataArray<size_t>* _scan_rs_claimed_chunks;
+  WorkerDataArray<size_t>* _scan_rs_skipped_chunks;
+
+  WorkerDataArray<size_t>* _opt_scan_rs_scanned_cards;
+  WorkerDataArray<size_t>* _opt_scan_rs_claimed_chunks;
+  WorkerDataArray<size_t>* _opt_scan_rs_skipped_chunks;
+  WorkerDataArray<size_t>* _opt_scan_rs_scanned_opt_refs;
 
   WorkerDataArray<size_t>* _termination_attempts;
+  WorkerDataArray<size_t>* _preserve_cm_referents_termination_attempts;
 
   WorkerDataArray<size_t>* _redirtied_cards;
 
   double _cur_collection_par_time_ms;
+  double _cur_optional_evac_ms;
   double _cur_collection_code_root_fixup_time_ms;
   double _cur_strong_code_root_purge_time_ms;
 
@@ -162,6 +185,16 @@ class G1GCPhaseTimes : public CHeapObj<mtGC> {
 
   ReferenceProcessorPhaseTimes _ref_phase_times;
 
+  // Cumulative statistics for the main parallel phases, exported as
+  // PerfData under sun.gc.g1.phases.  The histogram buckets count pauses
+  // by the phase time of the slowest worker: <1ms, <10ms, <100ms, >=100ms.
+  static const uint PhaseHistogramBuckets = 4;
+  PerfCounter* _perf_phase_time[GCParPhasesSentinel];
+  PerfCounter* _perf_phase_histogram[GCParPhasesSentinel][PhaseHistogramBuckets];
+
+  void create_perf_counters();
+  void update_perf_counters();
+
   double worker_time(GCParPhases phase, uint worker);
   void note_gc_end();
   void reset();
@@ -182,6 +215,7 @@ class G1GCPhaseTimes : public CHeapObj<mtGC> {
 
   double print_pre_evacuate_collection_set() const;
   double print_evacuate_collection_set() const;
+  double print_evacuate_optional_collection_set() const;
   double print_post_evacuate_collection_set() const;
   void print_other(double accounted_ms) const;
 
@@ -198,6 +232,12 @@ class G1GCPhaseTimes : public CHeapObj<mtGC> {
 
   void record_thread_work_item(GCParPhases phase, uint worker_i, size_t count, uint index = 0);
 
+  // record the time or add to the already recorded time of a phase that may
+  // be executed multiple times during a pause
+  void record_or_add_time_secs(GCParPhases phase, uint worker_i, double secs);
+
+  void record_or_add_thread_work_item(GCParPhases phase, uint worker_i, size_t count, uint index = 0);
+
   // return the average time for a phase in milliseconds
   double average_time_ms(GCParPhases phase);
 
@@ -229,6 +269,10 @@ class G1GCPhaseTimes : public CHeapObj<mtGC> {
     _cur_collection_par_time_ms = ms;
   }
 
+  void record_optional_evacuation(double ms) {
+    _cur_optional_evac_ms = ms;
+  }
+
   void record_code_root_fixup_time(double ms) {
     _cur_collection_code_root_fixup_time_ms = ms;
   }
@@ -0,0 +1,245 @@
+/*
+ * Copyright (c) 2018, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#include "precompiled.hpp"
+#include "gc/g1/g1CollectedHeap.inline.hpp"
+#include "gc/g1/g1NUMA.hpp"
+#include "gc/g1/heapRegion.hpp"
+#include "logging/log.hpp"
+#include "memory/allocation.inline.hpp"
+#include "runtime/globals.hpp"
+#include "runtime/os.hpp"
+#include "utilities/align.hpp"
+
+G1NUMA* G1NUMA::_inst = NULL;
+
+G1NUMA* G1NUMA::create() {
+  guarantee(_inst == NULL, "Should be called once.");
+  _inst = new G1NUMA();
+  _inst->initialize(UseNUMA);
+  return _inst;
+}
+
+G1NUMA::G1NUMA() :
+  _node_id_to_index_map(NULL), _len_node_id_to_index_map(0),
+  _node_ids(NULL), _num_active_node_ids(0),
+  _region_size(0), _page_size(0),
+  _region_allocs_requested(NULL), _region_allocs_local(NULL) {
+}
+
+void G1NUMA::initialize(bool use_numa) {
+  size_t num_node_ids = use_numa ? os::numa_get_groups_num() : 0;
+  if (num_node_ids > 0) {
+    _node_ids = NEW_C_HEAP_ARRAY(int, num_node_ids, mtGC);
+    num_node_ids = os::numa_get_leaf_groups(_node_ids, num_node_ids);
+  }
+  if (num_node_ids == 0) {
+    // Without NUMA support behave as if there were a single node with id 0,
+    // so that callers do not need to special case this.
+    FREE_C_HEAP_ARRAY(int, _node_ids);
+    _node_ids = NEW_C_HEAP_ARRAY(int, 1, mtGC);
+    _node_ids[0] = 0;
+    num_node_ids = 1;
+  }
+  _num_active_node_ids = (uint)num_node_ids;
+
+  int max_node_id = 0;
+  for (uint i = 0; i < _num_active_node_ids; i++) {
+    max_node_id = MAX2(max_node_id, _node_ids[i]);
+  }
+
+  _len_node_id_to_index_map = max_node_id + 1;
+  _node_id_to_index_map = NEW_C_HEAP_ARRAY(uint, _len_node_id_to_index_map, mtGC);
+  for (int i = 0; i < _len_node_id_to_index_map; i++) {
+    _node_id_to_index_map[i] = UnknownNodeIndex;
+  }
+  for (uint i = 0; i < _num_active_node_ids; i++) {
+    _node_id_to_index_map[_node_ids[i]] = i;
+  }
+
+  _region_allocs_requested = NEW_C_HEAP_ARRAY(size_t, _num_active_node_ids, mtGC);
+  _region_allocs_local = NEW_C_HEAP_ARRAY(size_t, _num_active_node_ids, mtGC);
+  for (uint i = 0; i < _num_active_node_ids; i++) {
+    _region_allocs_requested[i] = 0;
+    _region_allocs_local[i] = 0;
+  }
+
+  if (is_enabled()) {
+    log_info(gc, heap, numa)("NUMA nodes: %u", _num_active_node_ids);
+  }
+}
+
+G1NUMA::~G1NUMA() {
+  FREE_C_HEAP_ARRAY(size_t, _region_allocs_local);
+  FREE_C_HEAP_ARRAY(size_t, _region_allocs_requested);
+  FREE_C_HEAP_ARRAY(uint, _node_id_to_index_map);
+  FREE_C_HEAP_ARRAY(int, _node_ids);
+}
+
+void G1NUMA::set_region_info(size_t region_size, size_t page_size) {
+  _region_size = region_size;
+  _page_size = page_size;
+}
+
+int G1NUMA::numa_id(uint index) const {
+  assert(index < _num_active_node_ids, "Invalid node index %u", index);
+  return _node_ids[index];
+}
+
+uint G1NUMA::index_of_node_id(int node_id) const {
+  if (node_id < 0 || node_id >= _len_node_id_to_index_map) {
+    return UnknownNodeIndex;
+  }
+  return _node_id_to_index_map[node_id];
+}
+
+uint G1NUMA::index_of_current_thread() const {
+  if (!is_enabled()) {
+    return 0;
+  }
+  uint index = index_of_node_id(os::numa_get_group_id());
+  // The thread may run on a node without memory; fall back to the first one.
+  return index == UnknownNodeIndex ? 0 : index;
+}
+
+uint G1NUMA::preferred_node_index_for_index(uint region_index) const {
+  if (!is_enabled()) {
+    return 0;
+  }
+  assert(_region_size > 0 && _page_size > 0, "Region info must have been set");
+  if (_region_size >= _page_size) {
+    // Each region spans one or more pages.
+    return region_index % _num_active_node_ids;
+  } else {
+    // Each page spans several regions; all of them share the preferred node
+    // of the page.
+    size_t regions_per_page = _page_size / _region_size;
+    return (uint)((region_index / regions_per_page) % _num_active_node_ids);
+  }
+}
+
+void G1NUMA::request_memory_on_node(void* aligned_address, size_t size_in_bytes, uint region_index) {
+  if (!is_enabled() || size_in_bytes == 0) {
+    return;
+  }
+  assert(is_aligned(aligned_address, _page_size), "Given address (" PTR_FORMAT ") should be aligned.", p2i(aligned_address));
+  assert(is_aligned(size_in_bytes, _page_size), "Given size (" SIZE_FORMAT ") should be aligned.", size_in_bytes);
+
+  uint node_index = preferred_node_index_for_index(region_index);
+
+  log_trace(gc, heap, numa)("Request memory [" PTR_FORMAT ", " PTR_FORMAT ") to be NUMA id (%d)",
+                            p2i(aligned_address), p2i((char*)aligned_address + size_in_bytes),
+                            numa_id(node_index));
+  os::numa_make_local((char*)aligned_address, size_in_bytes, numa_id(node_index));
+}
+
+void G1NUMA::record_region_allocation(uint requested_node_index, uint allocated_node_index) {
+  if (!is_enabled() || requested_node_index >= _num_active_node_ids) {
+    return;
+  }
+  _region_allocs_requested[requested_node_index]++;
+  if (requested_node_index == allocated_node_index) {
+    _region_allocs_local[requested_node_index]++;
+  }
+}
+
+class G1NodeRegionCountClosure : public HeapRegionClosure {
+  uint _num_nodes;
+  uint* _eden;
+  uint* _survivor;
+  uint* _old;
+  uint* _humongous;
+
+  void inc(uint* counts, HeapRegion* hr) {
+    uint index = hr->node_index();
+    if (index < _num_nodes) {
+      counts[index]++;
+    }
+  }
+public:
+  G1NodeRegionCountClosure(uint num_nodes) : _num_nodes(num_nodes) {
+    _eden = NEW_C_HEAP_ARRAY(uint, num_nodes * 4, mtGC);
+    _survivor = _eden + num_nodes;
+    _old = _survivor + num_nodes;
+    _humongous = _old + num_nodes;
+    for (uint i = 0; i < num_nodes * 4; i++) {
+      _eden[i] = 0;
+    }
+  }
+
+  ~G1NodeRegionCountClosure() {
+    FREE_C_HEAP_ARRAY(uint, _eden);
+  }
+
+  bool do_heap_region(HeapRegion* hr) {
+    if (hr->is_eden()) {
+      inc(_eden, hr);
+    } else if (hr->is_survivor()) {
+      inc(_survivor, hr);
+    } else if (hr->is_humongous()) {
+      inc(_humongous, hr);
+    } else if (hr->is_old()) {
+      inc(_old, hr);
+    }
+    return false;
+  }
+
+  uint eden(uint index) const      { return _eden[index]; }
+  uint survivor(uint index) const  { return _survivor[index]; }
+  uint old(uint index) const       { return _old[index]; }
+  uint humongous(uint index) const { return _humongous[index]; }
+};
+
+void G1NUMA::print_region_distribution() const {
+  G1NodeRegionCountClosure cl(_num_active_node_ids);
+  G1CollectedHeap::heap()->heap_region_iterate(&cl);
+
+  for (uint i = 0; i < _num_active_node_ids; i++) {
+    log_debug(gc, heap, numa)("NUMA node %d regions: eden %u survivor %u old %u humongous %u",
+                              numa_id(i), cl.eden(i), cl.survivor(i), cl.old(i), cl.humongous(i));
+  }
+}
+
+void G1NUMA::print_statistics() {
+  if (!is_enabled()) {
+    return;
+  }
+
+  LogTarget(Debug, gc, heap, numa) lt;
+  if (lt.is_enabled()) {
+    for (uint i = 0; i < _num_active_node_ids; i++) {
+      size_t requested = _region_allocs_requested[i];
+      size_t local = _region_allocs_local[i];
+      lt.print("NUMA node %d region allocations: requested " SIZE_FORMAT " local " SIZE_FORMAT " (%.1f%%)",
+               numa_id(i), requested, local,
+               requested > 0 ? (double)local * 100.0 / requested : 0.0);
+    }
+    print_region_distribution();
+  }
+
+  for (uint i = 0; i < _num_active_node_ids; i++) {
+    _region_allocs_requested[i] = 0;
+    _region_allocs_local[i] = 0;
+  }
+}
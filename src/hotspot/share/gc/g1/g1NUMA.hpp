@@ -0,0 +1,116 @@
+/*
+ * Copyright (c) 2018, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#ifndef SHARE_VM_GC_G1_G1NUMA_HPP
+#define SHARE_VM_GC_G1_G1NUMA_HPP
+
+#include "memory/allocation.hpp"
+#include "runtime/os.hpp"
+
+class G1CollectedHeap;
+
+// Keeps track of the NUMA nodes the Java heap is spread across and provides
+// the mapping between heap regions and their preferred nodes.
+//
+// Nodes are identified by a dense index in [0, num_active_nodes()) rather than
+// by the (possibly sparse) OS node id, so that callers can use the index to
+// pick per-node resources like allocation regions and PLABs.
+//
+// Regions are assigned to nodes round-robin by their index, using the OS page
+// as the unit if a page spans more than one region. The memory of a region is
+// requested to be placed on its preferred node when the region is committed.
+class G1NUMA: public CHeapObj<mtGC> {
+  // Mapping of available OS node ids to the dense node index.
+  // Node ids that are not available map to UnknownNodeIndex.
+  uint* _node_id_to_index_map;
+  // Length of _node_id_to_index_map.
+  int _len_node_id_to_index_map;
+
+  // The OS node ids of all active nodes, indexed by node index.
+  int* _node_ids;
+  uint _num_active_node_ids;
+
+  // Size of a heap region and of the pages backing the heap.
+  size_t _region_size;
+  size_t _page_size;
+
+  // Per-node region allocation statistics since the last call to
+  // print_statistics(). Indexed by the requested node index.
+  // Region allocation is serialized by the Heap_lock or the FreeList_lock,
+  // so no atomics are needed for updates.
+  size_t* _region_allocs_requested;
+  size_t* _region_allocs_local;
+
+  static G1NUMA* _inst;
+
+  G1NUMA();
+  void initialize(bool use_numa);
+
+  void print_region_distribution() const;
+public:
+  static const uint UnknownNodeIndex = UINT_MAX;
+  static const uint AnyNodeIndex = UnknownNodeIndex - 1;
+
+  static G1NUMA* numa() { return _inst; }
+
+  static G1NUMA* create();
+
+  ~G1NUMA();
+
+  // Sets the heap region size and the page size of the heap. Must be
+  // called before any region is committed.
+  void set_region_info(size_t region_size, size_t page_size);
+
+  // Returns true if NUMA is enabled and there is more than one active node.
+  bool is_enabled() const { return num_active_nodes() > 1; }
+
+  // Returns the number of active nodes, at least one.
+  uint num_active_nodes() const { return _num_active_node_ids; }
+
+  // Returns the OS node id of the given node index.
+  int numa_id(uint index) const;
+
+  // Returns the node index of the given OS node id, or UnknownNodeIndex.
+  uint index_of_node_id(int node_id) const;
+
+  // Returns the node index of the node the current thread is running on.
+  uint index_of_current_thread() const;
+
+  // Returns the preferred node index of the region with the given index.
+  uint preferred_node_index_for_index(uint region_index) const;
+
+  // Requests the given committed memory, starting at the region with the
+  // given index, to be placed on the preferred node of that region.
+  void request_memory_on_node(void* aligned_address, size_t size_in_bytes, uint region_index);
+
+  // Records that a region was requested on requested_node_index and a region
+  // with the preferred node allocated_node_index was handed out.
+  void record_region_allocation(uint requested_node_index, uint allocated_node_index);
+
+  // Logs and resets the region allocation statistics, and logs the current
+  // distribution of regions across the nodes.
+  void print_statistics();
+};
+
+#endif // SHARE_VM_GC_G1_G1NUMA_HPP
@@ -0,0 +1,78 @@
+/*
+ * Copyright (c) 2018, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#include "precompiled.hpp"
+#include "gc/g1/g1OopStarChunkedList.inline.hpp"
+
+template <typename T>
+void G1OopStarChunkedList::delete_list(ChunkedList<T*, mtGC>* c) {
+  while (c != NULL) {
+    ChunkedList<T*, mtGC>* next = c->next_used();
+    delete c;
+    c = next;
+  }
+}
+
+template <typename T>
+size_t G1OopStarChunkedList::chunks_do(ChunkedList<T*, mtGC>* head, OopClosure* cl) {
+  size_t result = 0;
+  for (ChunkedList<T*, mtGC>* c = head; c != NULL; c = c->next_used()) {
+    result += c->size();
+    for (size_t i = 0; i < c->size(); i++) {
+      T* p = c->at(i);
+      cl->do_oop(p);
+    }
+  }
+  return result;
+}
+
+G1OopStarChunkedList::~G1OopStarChunkedList() {
+  free_chunk_lists();
+}
+
+size_t G1OopStarChunkedList::free_chunk_lists() {
+  delete_list(_roots);
+  delete_list(_croots);
+  delete_list(_oops);
+  delete_list(_coops);
+  _roots = NULL;
+  _croots = NULL;
+  _oops = NULL;
+  _coops = NULL;
+
+  size_t result = _used_memory;
+  _used_memory = 0;
+  return result;
+}
+
+size_t G1OopStarChunkedList::oops_do(OopClosure* obj_cl, OopClosure* root_cl) {
+  size_t result = 0;
+  if (root_cl != NULL) {
+    result += chunks_do(_roots, root_cl);
+    result += chunks_do(_croots, root_cl);
+  }
+  result += chunks_do(_oops, obj_cl);
+  result += chunks_do(_coops, obj_cl);
+  return result;
+}
@@ -58,8 +58,15 @@ G1Policy::G1Policy(STWGCTimer* gc_timer) :
   _reserve_factor((double) G1ReservePercent / 100.0),
   _reserve_regions(0),
   _rs_lengths_prediction(0),
+  _alloc_spike_rate_ms(0.0),
+  _predicted_update_rs_time_ms(0.0),
+  _predicted_scan_rs_time_ms(0.0),
+  _predicted_eden_copy_time_ms(0.0),
+  _predicted_survivor_copy_time_ms(0.0),
+  _predicted_other_time_ms(0.0),
   _bytes_allocated_in_old_since_last_gc(0),
   _initial_mark_to_mixed(),
+  _remset_tracker(),
   _collection_set(NULL),
   _g1(NULL),
   _phase_times(new G1GCPhaseTimes(gc_timer, ParallelGCThreads)),
@@ -174,7 +181,8 @@ uint G1Policy::calculate_young_list_desired_min_length(uint base_min_length) con
     if (_analytics->num_alloc_rate_ms() > 3) {
       double now_sec = os::elapsedTime();
       double when_ms = _mmu_tracker->when_max_gc_sec(now_sec) * 1000.0;
-      double alloc_rate_ms = _analytics->predict_alloc_rate_ms();
+      // Size for an allocation spike seen during this mutator phase, if any.
+      double alloc_rate_ms = MAX2(_analytics->predict_alloc_rate_ms(), _alloc_spike_rate_ms);
       desired_min_length = (uint) ceil(alloc_rate_ms * when_ms);
     } else {
       // otherwise we don't have enough info to make the prediction
@@ -399,6 +407,39 @@ void G1Policy::revise_young_list_target_length_if_necessary(size_t rs_lengths) {
   }
 }
 
+bool G1Policy::revise_young_list_target_length_for_allocation_spike() {
+  if (!adaptive_young_list_length() ||
+      G1AllocationSpikePercent == 0 ||
+      _analytics->num_alloc_rate_ms() <= 3) {
+    return false;
+  }
+
+  double app_time_ms = os::elapsedTime() * 1000.0 - _analytics->prev_collection_pause_end_ms();
+  // Too little mutator time to measure a meaningful allocation rate.
+  if (app_time_ms < 1.0) {
+    return false;
+  }
+
+  double alloc_rate_ms = (double) _g1->eden_regions_count() / app_time_ms;
+  double predicted_alloc_rate_ms = _analytics->predict_alloc_rate_ms();
+  if (alloc_rate_ms * 100.0 < predicted_alloc_rate_ms * G1AllocationSpikePercent ||
+      alloc_rate_ms <= _alloc_spike_rate_ms) {
+    return false;
+  }
+
+  _alloc_spike_rate_ms = alloc_rate_ms;
+  uint old_young_list_target_length = _young_list_target_length;
+  update_young_list_max_and_target_length(_rs_lengths_prediction);
+
+  log_debug(gc, ergo, heap)("Revise young list target length (allocation spike). "
+                            "allocation rate: %1.2fMB/s predicted: %1.2fMB/s "
+                            "young list target length: %u -> %u",
+                            alloc_rate_ms * HeapRegion::GrainBytes * MILLIUNITS / M,
+                            predicted_alloc_rate_ms * HeapRegion::GrainBytes * MILLIUNITS / M,
+                            old_young_list_target_length, _young_list_target_length);
+  return _young_list_target_length > old_young_list_target_length;
+}
+
 void G1Policy::update_rs_lengths_prediction() {
   update_rs_lengths_prediction(_analytics->predict_rs_lengths());
 }
@@ -439,6 +480,7 @@ void G1Policy::record_full_collection_end() {
   // also call this on any additional surv rate groups
 
   _free_regions_at_end_of_collection = _g1->num_free_regions();
+  _alloc_spike_rate_ms = 0.0;
   // Reset survivors SurvRateGroup.
   _survivor_surv_rate_group->reset();
   update_young_list_max_and_target_length();
@@ -462,6 +504,7 @@ void G1Policy::record_collection_pause_start(double start_time_sec) {
 
   phase_times()->record_cur_collection_start_sec(start_time_sec);
   _pending_cards = _g1->pending_card_num();
+  record_pause_time_prediction();
 
   _collection_set->reset_bytes_used_before();
   _bytes_copied_during_gc = 0;
@@ -713,11 +756,16 @@ void G1Policy::record_collection_pause_end(double pause_time_ms, size_t cards_sc
 
     _analytics->report_pending_cards((double) _pending_cards);
     _analytics->report_rs_lengths((double) _max_rs_lengths);
+
+    if (collector_state()->last_gc_was_young()) {
+      report_pause_time_prediction(pause_time_ms);
+    }
   }
 
   collector_state()->set_in_marking_window(new_in_marking_window);
   collector_state()->set_in_marking_window_im(new_in_marking_window_im);
   _free_regions_at_end_of_collection = _g1->num_free_regions();
+  _alloc_spike_rate_ms = 0.0;
   // IHOP control wants to know the expected young gen length if it were not
   // restrained by the heap reserve. Using the actual length would make the
   // prediction too small and the limit the young gen every time we get to the
@@ -746,7 +794,8 @@ void G1Policy::record_collection_pause_end(double pause_time_ms, size_t cards_sc
   }
   _g1->concurrent_refine()->adjust(average_time_ms(G1GCPhaseTimes::UpdateRS) - scan_hcc_time_ms,
                                       phase_times()->sum_thread_work_items(G1GCPhaseTimes::UpdateRS),
-                                      update_rs_time_goal_ms);
+                                      update_rs_time_goal_ms,
+                                      _analytics->predict_cost_per_card_ms());
 
   cset_chooser()->verify();
 }
@@ -836,6 +885,58 @@ double G1Policy::predict_base_elapsed_time_ms(size_t pending_cards) const {
   return predict_base_elapsed_time_ms(pending_cards, card_num);
 }
 
+void G1Policy::record_pause_time_prediction() {
+  const bool during_cm = collector_state()->during_concurrent_mark();
+  const size_t rs_lengths = _rs_lengths_prediction + _analytics->predict_rs_length_diff();
+  const size_t card_num = _analytics->predict_card_num(rs_lengths, collector_state()->gcs_are_young());
+
+  _predicted_update_rs_time_ms = _analytics->predict_rs_update_time_ms(_pending_cards);
+  _predicted_scan_rs_time_ms = _analytics->predict_rs_scan_time_ms(card_num, collector_state()->gcs_are_young());
+
+  // Eden and survivor regions are predicted separately: eden survival is
+  // predicted from the accumulated short-lived survival rates, survivor
+  // regions each use the survival rate of their own age.
+  const uint eden_length = _g1->eden_regions_count();
+  size_t eden_bytes_to_copy = 0;
+  if (eden_length > 0) {
+    eden_bytes_to_copy = (size_t) (accum_yg_surv_rate_pred((int) eden_length - 1) * HeapRegion::GrainBytes);
+  }
+  _predicted_eden_copy_time_ms = _analytics->predict_object_copy_time_ms(eden_bytes_to_copy, during_cm);
+
+  size_t survivor_bytes_to_copy = 0;
+  const GrowableArray<HeapRegion*>* survivor_regions = _g1->survivor()->regions();
+  for (GrowableArrayIterator<HeapRegion*> it = survivor_regions->begin();
+       it != survivor_regions->end();
+       ++it) {
+    survivor_bytes_to_copy += predict_bytes_to_copy(*it);
+  }
+  _predicted_survivor_copy_time_ms = _analytics->predict_object_copy_time_ms(survivor_bytes_to_copy, during_cm);
+
+  _predicted_other_time_ms = _analytics->predict_constant_other_time_ms() +
+                             _analytics->predict_young_other_time_ms(_g1->young_regions_count());
+}
+
+void G1Policy::report_pause_time_prediction(double pause_time_ms) const {
+  const double update_rs_time_ms = average_time_ms(G1GCPhaseTimes::UpdateRS);
+  const double scan_rs_time_ms = average_time_ms(G1GCPhaseTimes::ScanRS);
+  const double copy_time_ms = average_time_ms(G1GCPhaseTimes::ObjCopy);
+  const double other_time_ms = MAX2(0.0, pause_time_ms - update_rs_time_ms - scan_rs_time_ms - copy_time_ms);
+
+  const double predicted_copy_time_ms = _predicted_eden_copy_time_ms + _predicted_survivor_copy_time_ms;
+  const double predicted_pause_time_ms = _predicted_update_rs_time_ms + _predicted_scan_rs_time_ms +
+                                         predicted_copy_time_ms + _predicted_other_time_ms;
+
+  log_debug(gc, ergo)("Pause time prediction (predicted/actual): "
+                      "update RS: %1.2fms/%1.2fms scan RS: %1.2fms/%1.2fms "
+                      "object copy: %1.2fms (eden: %1.2fms survivor: %1.2fms)/%1.2fms "
+                      "other: %1.2fms/%1.2fms total: %1.2fms/%1.2fms",
+                      _predicted_update_rs_time_ms, update_rs_time_ms,
+                      _predicted_scan_rs_time_ms, scan_rs_time_ms,
+                      predicted_copy_time_ms, _predicted_eden_copy_time_ms, _predicted_survivor_copy_time_ms, copy_time_ms,
+                      _predicted_other_time_ms, other_time_ms,
+                      predicted_pause_time_ms, pause_time_ms);
+}
+
 size_t G1Policy::predict_bytes_to_copy(HeapRegion* hr) const {
   size_t bytes_to_copy;
   if (hr->is_marked())
@@ -31,6 +31,7 @@
 #include "gc/g1/g1InitialMarkToMixedTimeTracker.hpp"
 #include "gc/g1/g1MMUTracker.hpp"
 #include "gc/g1/g1Predictions.hpp"
+#include "gc/g1/g1RemSetTrackingPolicy.hpp"
 #include "gc/g1/g1YoungGenSizer.hpp"
 #include "gc/shared/gcCause.hpp"
 #include "utilities/pair.hpp"
@@ -98,15 +99,33 @@ class G1Policy: public CHeapObj<mtGC> {
 
   size_t _pending_cards;
 
+  // The highest eden allocation rate (in regions/ms) of an allocation spike
+  // detected during the current mutator phase, or 0.0 if there was none.
+  double _alloc_spike_rate_ms;
+
+  // Predictions for the components of the young part of the current pause,
+  // recorded at its start so that they can be compared to the actual times.
+  double _predicted_update_rs_time_ms;
+  double _predicted_scan_rs_time_ms;
+  double _predicted_eden_copy_time_ms;
+  double _predicted_survivor_copy_time_ms;
+  double _predicted_other_time_ms;
+
   // The amount of allocated bytes in old gen during the last mutator and the following
   // young GC phase.
   size_t _bytes_allocated_in_old_since_last_gc;
 
   G1InitialMarkToMixedTimeTracker _initial_mark_to_mixed;
+
+  // The remembered set tracking policy deciding which regions get their
+  // remembered sets maintained.
+  G1RemSetTrackingPolicy _remset_tracker;
 public:
   const G1Predictions& predictor() const { return _predictor; }
   const G1Analytics* analytics()   const { return const_cast<const G1Analytics*>(_analytics); }
 
+  G1RemSetTrackingPolicy* remset_tracker() { return &_remset_tracker; }
+
   // Add the given number of bytes to the total number of allocated bytes in the old gen.
   void add_bytes_allocated_in_old_since_last_gc(size_t bytes) { _bytes_allocated_in_old_since_last_gc += bytes; }
 
@@ -228,6 +247,11 @@ private:
   void update_rs_lengths_prediction();
   void update_rs_lengths_prediction(size_t prediction);
 
+  // Record the predicted pause time components for the young regions of the
+  // pause about to start, and log them against the actual times at its end.
+  void record_pause_time_prediction();
+  void report_pause_time_prediction(double pause_time_ms) const;
+
   // Check whether a given young length (young_length) fits into the
   // given target pause time and whether the prediction for the amount
   // of objects to be copied for the given length will fit into the
@@ -252,6 +276,15 @@ public:
   // percentage of the current heap capacity.
   double reclaimable_bytes_percent(size_t reclaimable_bytes) const;
 
+  // Fraction of the remaining pause time, after the young and mandatory old
+  // regions have been chosen, that is used for the optional part of the
+  // collection set.
+  double optional_prediction_fraction() const { return 0.2; }
+
+  // Fraction of the time left in the pause that is used to choose the next
+  // batch of optional regions to evacuate.
+  double optional_evacuation_fraction() const { return 0.75; }
+
   jlong collection_pause_end_millis() { return _collection_pause_end_millis; }
 
 private:
@@ -290,6 +323,12 @@ public:
   // higher, recalculate the young list target length prediction.
   void revise_young_list_target_length_if_necessary(size_t rs_lengths);
 
+  // Called when the mutator used up the young list target length. If eden
+  // has been allocated at a rate well above the predicted allocation rate,
+  // recalculate the young list target length for that rate within the
+  // current mutator phase. Returns whether the target length increased.
+  bool revise_young_list_target_length_for_allocation_spike();
+
   // This should be called after the heap is resized.
   void record_new_heap_size(uint new_number_of_regions);
 
@@ -27,6 +27,8 @@
 #include "gc/g1/g1BlockOffsetTable.inline.hpp"
 #include "gc/g1/g1CardTable.inline.hpp"
 #include "gc/g1/g1CollectedHeap.inline.hpp"
+#include "gc/g1/g1CollectionSet.hpp"
+#include "gc/g1/g1ConcurrentMark.inline.hpp"
 #include "gc/g1/g1ConcurrentRefine.hpp"
 #include "gc/g1/g1FromCardCache.hpp"
 #include "gc/g1/g1GCPhaseTimes.hpp"
@@ -38,6 +40,7 @@
 #include "gc/g1/heapRegionRemSet.hpp"
 #include "gc/shared/gcTraceTime.inline.hpp"
 #include "gc/shared/suspendibleThreadSet.hpp"
+#include "logging/log.hpp"
 #include "memory/iterator.hpp"
 #include "memory/resourceArea.hpp"
 #include "oops/oop.inline.hpp"
@@ -45,6 +48,7 @@
 #include "utilities/globalDefinitions.hpp"
 #include "utilities/intHisto.hpp"
 #include "utilities/stack.inline.hpp"
+#include "utilities/ticks.inline.hpp"
 
 // Collects information about the overall remembered set scan progress during an evacuation.
 class G1RemSetScanState : public CHeapObj<mtGC> {
@@ -144,7 +148,22 @@ private:
   // This is valid because we are not interested in scanning stray remembered set
   // entries from free or archive regions.
   HeapWord** _scan_top;
+
+  // The remembered sets of the collection set regions are merged into the card
+  // table before scanning. Scanning then claims fixed size chunks of cards of the
+  // regions in [0.._num_scan_regions) of the _dirty_region_buffer in memory order.
+  // For each chunk of the heap, contains whether the merge put any claimed card
+  // into it. The flag is cleared again by the thread that scans the chunk.
+  bool* _scan_chunks;
+  size_t _num_scan_regions;
+  size_t volatile _next_scan_chunk;
+
+  static size_t scan_chunks_per_region() { return HeapRegion::CardsPerRegion / CardsPerScanChunk; }
 public:
+  // Number of cards claimed by a single thread at once when scanning the merged
+  // remembered sets.
+  static const size_t CardsPerScanChunk = 128;
+
   G1RemSetScanState() :
     _max_regions(0),
     _iter_states(NULL),
@@ -152,7 +171,10 @@ public:
     _dirty_region_buffer(NULL),
     _in_dirty_region_buffer(NULL),
     _cur_dirty_region(0),
-    _scan_top(NULL) {
+    _scan_top(NULL),
+    _scan_chunks(NULL),
+    _num_scan_regions(0),
+    _next_scan_chunk(0) {
   }
 
   ~G1RemSetScanState() {
@@ -171,6 +193,9 @@ public:
     if (_scan_top != NULL) {
       FREE_C_HEAP_ARRAY(HeapWord*, _scan_top);
     }
+    if (_scan_chunks != NULL) {
+      FREE_C_HEAP_ARRAY(bool, _scan_chunks);
+    }
   }
 
   void initialize(uint max_regions) {
@@ -182,6 +207,12 @@ public:
     _dirty_region_buffer = NEW_C_HEAP_ARRAY(uint, max_regions, mtGC);
     _in_dirty_region_buffer = NEW_C_HEAP_ARRAY(IsDirtyRegionState, max_regions, mtGC);
     _scan_top = NEW_C_HEAP_ARRAY(HeapWord*, max_regions, mtGC);
+
+    assert(HeapRegion::CardsPerRegion % CardsPerScanChunk == 0,
+           "Regions must consist of whole scan chunks");
+    size_t const num_chunks = (size_t)max_regions * scan_chunks_per_region();
+    _scan_chunks = NEW_C_HEAP_ARRAY(bool, num_chunks, mtGC);
+    memset(_scan_chunks, false, num_chunks * sizeof(bool));
   }
 
   void reset() {
@@ -195,6 +226,8 @@ public:
     memset((void*)_iter_claims, 0, _max_regions * sizeof(size_t));
     memset(_in_dirty_region_buffer, Clean, _max_regions * sizeof(IsDirtyRegionState));
     _cur_dirty_region = 0;
+    _num_scan_regions = 0;
+    _next_scan_chunk = 0;
   }
 
   // Attempt to claim the remembered set of the region for iteration. Returns true
@@ -248,10 +281,52 @@ public:
     }
   }
 
+  // Record that the chunk containing the given card contains claimed cards that
+  // need to be scanned.
+  void set_chunk_dirty(size_t card_index) {
+    _scan_chunks[card_index / CardsPerScanChunk] = true;
+  }
+
+  // Makes all chunks of regions dirtied so far available for claiming. Must be
+  // called after merging the remembered sets and before scanning them.
+  void prepare_for_scan() {
+    _num_scan_regions = _cur_dirty_region;
+    _next_scan_chunk = 0;
+  }
+
+  // Claim the next chunk of cards to scan. Returns false if there are no more
+  // chunks to claim, otherwise sets first_card to the index of the first card of
+  // the chunk and is_dirty to whether the chunk contains any cards to scan.
+  bool claim_scan_chunk(size_t& first_card, bool& is_dirty) {
+    size_t const chunks_per_region = scan_chunks_per_region();
+    size_t const num_chunks = _num_scan_regions * chunks_per_region;
+    if (_next_scan_chunk >= num_chunks) {
+      return false;
+    }
+    size_t const claim = Atomic::add((size_t)1, &_next_scan_chunk) - 1;
+    if (claim >= num_chunks) {
+      return false;
+    }
+    uint const region_idx = _dirty_region_buffer[claim / chunks_per_region];
+    size_t const chunk_idx = (size_t)region_idx * chunks_per_region + claim % chunks_per_region;
+
+    first_card = chunk_idx * CardsPerScanChunk;
+    is_dirty = _scan_chunks[chunk_idx];
+    if (is_dirty) {
+      // We are the only thread that claimed this chunk.
+      _scan_chunks[chunk_idx] = false;
+    }
+    return true;
+  }
+
   HeapWord* scan_top(uint region_idx) const {
     return _scan_top[region_idx];
   }
 
+  void clear_scan_top(uint region_idx) {
+    _scan_top[region_idx] = NULL;
+  }
+
   // Clear the card table of "dirty" regions.
   void clear_card_table(WorkGang* workers) {
     if (_cur_dirty_region == 0) {
@@ -298,20 +373,137 @@ G1RemSet::~G1RemSet() {
 }
 
 uint G1RemSet::num_par_rem_sets() {
-  return MAX2(DirtyCardQueueSet::num_par_ids() + G1ConcurrentRefine::max_num_threads(), ParallelGCThreads);
+  return DirtyCardQueueSet::num_par_ids() + G1ConcurrentRefine::max_num_threads() + MAX2(ConcGCThreads, ParallelGCThreads);
 }
 
 void G1RemSet::initialize(size_t capacity, uint max_regions) {
   G1FromCardCache::initialize(num_par_rem_sets(), max_regions);
   _scan_state->initialize(max_regions);
-  {
-    GCTraceTime(Debug, gc, marking)("Initialize Card Live Data");
-    _card_live_data.initialize(capacity, max_regions);
+}
+
+void G1RemSet::exclude_region_from_scan(uint region_idx) {
+  _scan_state->clear_scan_top(region_idx);
+}
+
+// Merges the remembered set entries of collection set regions into the card
+// table: every card that needs to be scanned for references into the collection
+// set is claimed, and the chunk containing it marked for scanning.
+class G1MergeRemSetClosure : public HeapRegionClosure {
+  G1RemSetScanState* _scan_state;
+  G1CollectedHeap* _g1h;
+  G1CardTable* _ct;
+
+  size_t _cards_merged;
+
+  void merge_card(size_t card_index) {
+    // If the card is dirty, then G1 will scan it during Update RS.
+    if (_ct->is_card_claimed(card_index) || _ct->is_card_dirty(card_index)) {
+      return;
+    }
+
+    HeapWord* const card_start = _g1h->bot()->address_for_index(card_index);
+    uint const region_idx_for_card = _g1h->addr_to_region(card_start);
+
+    assert(_g1h->region_at(region_idx_for_card)->is_in_reserved(card_start),
+           "Card start " PTR_FORMAT " to merge outside of region %u", p2i(card_start), _g1h->region_at(region_idx_for_card)->hrm_index());
+    if (card_start >= _scan_state->scan_top(region_idx_for_card)) {
+      return;
+    }
+
+    // We claim lazily (so races are possible but they're benign), which reduces the
+    // number of duplicate scans (the rsets of the regions in the cset can intersect).
+    // Claim the card after checking bounds above: the remembered set may contain
+    // random cards into current survivor, and we would then have an incorrectly
+    // claimed card in survivor space. Card table clear does not reset the card table
+    // of survivor space regions.
+    _ct->set_card_claimed(card_index);
+    _scan_state->add_dirty_region(region_idx_for_card);
+    _scan_state->set_chunk_dirty(card_index);
+    _cards_merged++;
+  }
+
+public:
+  G1MergeRemSetClosure(G1RemSetScanState* scan_state) :
+    _scan_state(scan_state),
+    _g1h(G1CollectedHeap::heap()),
+    _ct(G1CollectedHeap::heap()->card_table()),
+    _cards_merged(0) {
+  }
+
+  bool do_heap_region(HeapRegion* r) {
+    assert(r->in_collection_set(), "should only be called on elements of CS.");
+    uint const region_idx = r->hrm_index();
+
+    // If we ever free the collection set concurrently, we should also
+    // clear the card table concurrently therefore we won't need to
+    // add regions of the collection set to the dirty cards region.
+    _scan_state->add_dirty_region(region_idx);
+
+    // We claim cards in blocks so as to reduce the contention.
+    size_t const block_size = G1RSetScanBlockSize;
+
+    HeapRegionRemSetIterator iter(r->rem_set());
+    size_t card_index;
+
+    size_t claimed_card_block = _scan_state->iter_claimed_next(region_idx, block_size);
+    for (size_t current_card = 0; iter.has_next(card_index); current_card++) {
+      if (current_card >= claimed_card_block + block_size) {
+        claimed_card_block = _scan_state->iter_claimed_next(region_idx, block_size);
+      }
+      if (current_card < claimed_card_block) {
+        continue;
+      }
+      merge_card(card_index);
+    }
+    return false;
+  }
+
+  size_t cards_merged() const { return _cards_merged; }
+};
+
+class G1MergeRemSetTask : public AbstractGangTask {
+  G1CollectedHeap* _g1h;
+  G1RemSetScanState* _scan_state;
+  G1OptionalCSet* _ocset;
+
+  void merge_optional_rem_sets(G1MergeRemSetClosure* cl, uint worker_id) {
+    uint const num_regions = _ocset->current_limit() - _ocset->current_index();
+    for (uint i = 0; i < num_regions; i++) {
+      // Start at different regions to reduce contention on the claims.
+      cl->do_heap_region(_ocset->region_at(_ocset->current_index() + (worker_id + i) % num_regions));
+    }
   }
-  if (G1PretouchAuxiliaryMemory) {
-    GCTraceTime(Debug, gc, marking)("Pre-Touch Card Live Data");
-    _card_live_data.pretouch();
+
+public:
+  G1MergeRemSetTask(G1CollectedHeap* g1h, G1RemSetScanState* scan_state, G1OptionalCSet* ocset) :
+    AbstractGangTask("G1 Merge Remembered Sets"),
+    _g1h(g1h),
+    _scan_state(scan_state),
+    _ocset(ocset) {
+  }
+
+  void work(uint worker_id) {
+    double start_sec = os::elapsedTime();
+
+    G1MergeRemSetClosure cl(_scan_state);
+    if (_ocset == NULL) {
+      _g1h->collection_set_iterate_from(&cl, worker_id);
+    } else {
+      merge_optional_rem_sets(&cl, worker_id);
+    }
+
+    G1GCPhaseTimes::GCParPhases phase = _ocset == NULL ? G1GCPhaseTimes::MergeRS : G1GCPhaseTimes::OptMergeRS;
+    G1GCPhaseTimes* p = _g1h->g1_policy()->phase_times();
+    p->record_or_add_time_secs(phase, worker_id, os::elapsedTime() - start_sec);
+    p->record_or_add_thread_work_item(phase, worker_id, cl.cards_merged());
   }
+};
+
+void G1RemSet::merge_rem_sets(G1OptionalCSet* ocset) {
+  G1MergeRemSetTask task(_g1, _scan_state, ocset);
+  _g1->workers()->run_task(&task);
+
+  _scan_state->prepare_for_scan();
 }
 
 G1ScanRSForRegionClosure::G1ScanRSForRegionClosure(G1RemSetScanState* scan_state,
@@ -322,20 +514,67 @@ G1ScanRSForRegionClosure::G1ScanRSForRegionClosure(G1RemSetScanState* scan_state
   _scan_objs_on_card_cl(scan_obj_on_card),
   _code_root_cl(code_root_cl),
   _strong_code_root_scan_time_sec(0.0),
-  _cards_claimed(0),
   _cards_scanned(0),
-  _cards_skipped(0),
+  _chunks_claimed(0),
+  _chunks_skipped(0),
   _worker_i(worker_i) {
   _g1h = G1CollectedHeap::heap();
   _bot = _g1h->bot();
   _ct = _g1h->card_table();
 }
 
-void G1ScanRSForRegionClosure::scan_card(MemRegion mr, uint region_idx_for_card) {
+void G1ScanRSForRegionClosure::scan_cards(size_t first_card, size_t num_cards) {
+  HeapWord* const card_start = _bot->address_for_index(first_card);
+  uint const region_idx_for_card = _g1h->addr_to_region(card_start);
+  HeapWord* const top = _scan_state->scan_top(region_idx_for_card);
+  if (card_start >= top) {
+    return;
+  }
+
+  // Mark the cards as scanned before actually scanning them, so that
+  // concurrently deferred cards are not lost.
+  for (size_t i = first_card; i < first_card + num_cards; i++) {
+    _ct->set_card_scanned(i);
+  }
+
+  MemRegion const mr(card_start, MIN2(card_start + num_cards * BOTConstants::N_words, top));
+
   HeapRegion* const card_region = _g1h->region_at(region_idx_for_card);
   _scan_objs_on_card_cl->set_region(card_region);
   card_region->oops_on_card_seq_iterate_careful<true>(mr, _scan_objs_on_card_cl);
-  _cards_scanned++;
+  _cards_scanned += num_cards;
+}
+
+void G1ScanRSForRegionClosure::scan_chunk(size_t first_card) {
+  size_t const end_card = first_card + G1RemSetScanState::CardsPerScanChunk;
+
+  size_t card = first_card;
+  while (card < end_card) {
+    if (!_ct->is_card_claimed_unscanned(card)) {
+      card++;
+      continue;
+    }
+    // Scan consecutive claimed cards at once.
+    size_t run_end = card + 1;
+    while (run_end < end_card && _ct->is_card_claimed_unscanned(run_end)) {
+      run_end++;
+    }
+    scan_cards(card, run_end - card);
+    card = run_end;
+  }
+}
+
+void G1ScanRSForRegionClosure::scan_claimed_chunks() {
+  size_t first_card;
+  bool is_dirty;
+  while (_scan_state->claim_scan_chunk(first_card, is_dirty)) {
+    if (!is_dirty) {
+      _chunks_skipped++;
+      continue;
+    }
+    _chunks_claimed++;
+    scan_chunk(first_card);
+  }
 }
 
 void G1ScanRSForRegionClosure::scan_strong_code_roots(HeapRegion* r) {
@@ -344,72 +583,14 @@ void G1ScanRSForRegionClosure::scan_strong_code_roots(HeapRegion* r) {
   _strong_code_root_scan_time_sec += (os::elapsedTime() - scan_start);
 }
 
-void G1ScanRSForRegionClosure::claim_card(size_t card_index, const uint region_idx_for_card){
-  _ct->set_card_claimed(card_index);
-  _scan_state->add_dirty_region(region_idx_for_card);
-}
-
 bool G1ScanRSForRegionClosure::do_heap_region(HeapRegion* r) {
   assert(r->in_collection_set(), "should only be called on elements of CS.");
   uint region_idx = r->hrm_index();
 
-  if (_scan_state->iter_is_complete(region_idx)) {
-    return false;
-  }
   if (_scan_state->claim_iter(region_idx)) {
-    // If we ever free the collection set concurrently, we should also
-    // clear the card table concurrently therefore we won't need to
-    // add regions of the collection set to the dirty cards region.
-    _scan_state->add_dirty_region(region_idx);
-  }
-
-  // We claim cards in blocks so as to reduce the contention.
-  size_t const block_size = G1RSetScanBlockSize;
-
-  HeapRegionRemSetIterator iter(r->rem_set());
-  size_t card_index;
-
-  size_t claimed_card_block = _scan_state->iter_claimed_next(region_idx, block_size);
-  for (size_t current_card = 0; iter.has_next(card_index); current_card++) {
-    if (current_card >= claimed_card_block + block_size) {
-      claimed_card_block = _scan_state->iter_claimed_next(region_idx, block_size);
-    }
-    if (current_card < claimed_card_block) {
-      _cards_skipped++;
-      continue;
-    }
-    _cards_claimed++;
-
-    // If the card is dirty, then G1 will scan it during Update RS.
-    if (_ct->is_card_claimed(card_index) || _ct->is_card_dirty(card_index)) {
-      continue;
-    }
-
-    HeapWord* const card_start = _g1h->bot()->address_for_index(card_index);
-    uint const region_idx_for_card = _g1h->addr_to_region(card_start);
-
-    assert(_g1h->region_at(region_idx_for_card)->is_in_reserved(card_start),
-           "Card start " PTR_FORMAT " to scan outside of region %u", p2i(card_start), _g1h->region_at(region_idx_for_card)->hrm_index());
-    HeapWord* const top = _scan_state->scan_top(region_idx_for_card);
-    if (card_start >= top) {
-      continue;
-    }
-
-    // We claim lazily (so races are possible but they're benign), which reduces the
-    // number of duplicate scans (the rsets of the regions in the cset can intersect).
-    // Claim the card after checking bounds above: the remembered set may contain
-    // random cards into current survivor, and we would then have an incorrectly
-    // claimed card in survivor space. Card table clear does not reset the card table
-    // of survivor space regions.
-    claim_card(card_index, region_idx_for_card);
-
-    MemRegion const mr(card_start, MIN2(card_start + BOTConstants::N_words, top));
-
-    scan_card(mr, region_idx_for_card);
-  }
-  if (_scan_state->set_iter_complete(region_idx)) {
     // Scan the strong code root list attached to the current region
     scan_strong_code_roots(r);
+    _scan_state->set_iter_complete(region_idx);
   }
   return false;
 }
@@ -421,6 +602,7 @@ void G1RemSet::scan_rem_set(G1ParScanThreadState* pss,
 
   G1ScanObjsDuringScanRSClosure scan_cl(_g1, pss);
   G1ScanRSForRegionClosure cl(_scan_state, &scan_cl, heap_region_codeblobs, worker_i);
+  cl.scan_claimed_chunks();
   _g1->collection_set_iterate_from(&cl, worker_i);
 
   double scan_rs_time_sec = (os::elapsedTime() - rs_time_start) -
@@ -430,8 +612,8 @@ void G1RemSet::scan_rem_set(G1ParScanThreadState* pss,
 
   p->record_time_secs(G1GCPhaseTimes::ScanRS, worker_i, scan_rs_time_sec);
   p->record_thread_work_item(G1GCPhaseTimes::ScanRS, worker_i, cl.cards_scanned(), G1GCPhaseTimes::ScanRSScannedCards);
-  p->record_thread_work_item(G1GCPhaseTimes::ScanRS, worker_i, cl.cards_claimed(), G1GCPhaseTimes::ScanRSClaimedCards);
-  p->record_thread_work_item(G1GCPhaseTimes::ScanRS, worker_i, cl.cards_skipped(), G1GCPhaseTimes::ScanRSSkippedCards);
+  p->record_thread_work_item(G1GCPhaseTimes::ScanRS, worker_i, cl.chunks_claimed(), G1GCPhaseTimes::ScanRSClaimedChunks);
+  p->record_thread_work_item(G1GCPhaseTimes::ScanRS, worker_i, cl.chunks_skipped(), G1GCPhaseTimes::ScanRSSkippedChunks);
 
   p->record_time_secs(G1GCPhaseTimes::CodeRoots, worker_i, cl.strong_code_root_scan_time_sec());
 }
@@ -514,27 +696,6 @@ void G1RemSet::cleanup_after_oops_into_collection_set_do() {
   phase_times->record_clear_ct_time((os::elapsedTime() - start) * 1000.0);
 }
 
-class G1ScrubRSClosure: public HeapRegionClosure {
-  G1CollectedHeap* _g1h;
-  G1CardLiveData* _live_data;
-public:
-  G1ScrubRSClosure(G1CardLiveData* live_data) :
-    _g1h(G1CollectedHeap::heap()),
-    _live_data(live_data) { }
-
-  bool do_heap_region(HeapRegion* r) {
-    if (!r->is_continues_humongous()) {
-      r->rem_set()->scrub(_live_data);
-    }
-    return false;
-  }
-};
-
-void G1RemSet::scrub(uint worker_num, HeapRegionClaimer *hrclaimer) {
-  G1ScrubRSClosure scrub_cl(&_card_live_data);
-  _g1->heap_region_par_iterate_from_worker_offset(&scrub_cl, hrclaimer, worker_num);
-}
-
 inline void check_card_ptr(jbyte* card_ptr, G1CardTable* ct) {
 #ifdef ASSERT
   G1CollectedHeap* g1 = G1CollectedHeap::heap();
@@ -750,24 +911,264 @@ void G1RemSet::print_summary_info() {
   }
 }
 
-void G1RemSet::create_card_live_data(WorkGang* workers, G1CMBitMap* mark_bitmap) {
-  _card_live_data.create(workers, mark_bitmap);
-}
+class G1RebuildRemSetTask: public AbstractGangTask {
+  // Scans the live objects of old and humongous regions and adds the references
+  // found to the remembered sets of the regions that are tracked.
+  class G1RebuildRemSetHeapRegionClosure : public HeapRegionClosure {
+    G1ConcurrentMark* _cm;
+    G1RebuildRemSetClosure _update_cl;
+
+    // Applies _update_cl to the references of the given object, limiting objArrays
+    // to the given MemRegion. Returns the amount of words actually scanned.
+    size_t scan_for_references(oop const obj, MemRegion mr) {
+      size_t const obj_size = obj->size();
+      // All non-objArrays and objArrays completely within the mr
+      // can be scanned without passing the mr.
+      if (!obj->is_objArray() || mr.contains(MemRegion((HeapWord*)obj, obj_size))) {
+        obj->oop_iterate(&_update_cl);
+        return obj_size;
+      }
+      // This path is for objArrays crossing the given MemRegion. Only scan the
+      // area within the MemRegion.
+      return obj->oop_iterate_size(&_update_cl, mr);
+    }
 
-void G1RemSet::finalize_card_live_data(WorkGang* workers, G1CMBitMap* mark_bitmap) {
-  _card_live_data.finalize(workers, mark_bitmap);
-}
+    // A humongous object is live (with respect to the scanning) either
+    // a) it is marked on the bitmap as such
+    // b) its TARS is larger than TAMS, i.e. has been allocated during marking.
+    bool is_humongous_live(oop const humongous_obj, const G1CMBitMap* const bitmap, HeapWord* tams, HeapWord* tars) const {
+      return bitmap->is_marked(humongous_obj) || (tars > tams);
+    }
 
-void G1RemSet::verify_card_live_data(WorkGang* workers, G1CMBitMap* bitmap) {
-  _card_live_data.verify(workers, bitmap);
-}
+    // Iterator over the live objects within the given MemRegion.
+    class LiveObjIterator : public StackObj {
+      const G1CMBitMap* const _bitmap;
+      const HeapWord* _tams;
+      const MemRegion _mr;
+      HeapWord* _current;
 
-void G1RemSet::clear_card_live_data(WorkGang* workers) {
-  _card_live_data.clear(workers);
-}
+      bool is_below_tams() const {
+        return _current < _tams;
+      }
 
-#ifdef ASSERT
-void G1RemSet::verify_card_live_data_is_clear() {
-  _card_live_data.verify_is_clear();
+      bool is_live(HeapWord* obj) const {
+        return !is_below_tams() || _bitmap->is_marked(obj);
+      }
+
+      HeapWord* bitmap_limit() const {
+        return MIN2(const_cast<HeapWord*>(_tams), _mr.end());
+      }
+
+      void move_if_below_tams() {
+        if (is_below_tams() && has_next()) {
+          _current = _bitmap->get_next_marked_addr(_current, bitmap_limit());
+        }
+      }
+    public:
+      LiveObjIterator(const G1CMBitMap* const bitmap, const HeapWord* tams, const MemRegion mr, HeapWord* first_oop_into_mr) :
+          _bitmap(bitmap),
+          _tams(tams),
+          _mr(mr),
+          _current(first_oop_into_mr) {
+
+        assert(_current <= _mr.start(),
+               "First oop " PTR_FORMAT " should extend into mr [" PTR_FORMAT ", " PTR_FORMAT ")",
+               p2i(first_oop_into_mr), p2i(mr.start()), p2i(mr.end()));
+
+        // Step to the next live object within the MemRegion if needed.
+        if (is_live(_current)) {
+          // Non-objArrays were scanned by the previous part of that region.
+          if (_current < mr.start() && !oop(_current)->is_objArray()) {
+            _current += oop(_current)->size();
+            // We might have positioned _current on a non-live object. Reposition to the next
+            // live one if needed.
+            move_if_below_tams();
+          }
+        } else {
+          // The object at _current can only be dead if below TAMS, so we can use the bitmap
+          // immediately.
+          _current = _bitmap->get_next_marked_addr(_current, bitmap_limit());
+          assert(_current == _mr.end() || is_live(_current),
+                 "Current " PTR_FORMAT " should be live (%s) or beyond the end of the MemRegion (" PTR_FORMAT ")",
+                 p2i(_current), BOOL_TO_STR(is_live(_current)), p2i(_mr.end()));
+        }
+      }
+
+      void move_to_next() {
+        _current += next()->size();
+        move_if_below_tams();
+      }
+
+      oop next() const {
+        oop result = oop(_current);
+        assert(is_live(_current),
+               "Object " PTR_FORMAT " must be live TAMS " PTR_FORMAT " below %d mr " PTR_FORMAT " " PTR_FORMAT " outside %d",
+               p2i(_current), p2i(_tams), _tams > _current, p2i(_mr.start()), p2i(_mr.end()), _mr.contains(result));
+        return result;
+      }
+
+      bool has_next() const {
+        return _current < _mr.end();
+      }
+    };
+
+    // Rebuild remembered sets in the part of the region specified by mr and hr.
+    // Objects between the bottom of the region and the TAMS are checked for liveness
+    // using the given bitmap. Objects between TAMS and TARS are assumed to be live.
+    // Returns the number of live bytes between bottom and TAMS.
+    size_t rebuild_rem_set_in_region(const G1CMBitMap* const bitmap,
+                                     HeapWord* const top_at_mark_start,
+                                     HeapWord* const top_at_rebuild_start,
+                                     HeapRegion* hr,
+                                     MemRegion mr) {
+      size_t marked_bytes = 0;
+
+      if (hr->is_humongous()) {
+        oop const humongous_obj = oop(hr->humongous_start_region()->bottom());
+        if (is_humongous_live(humongous_obj, bitmap, top_at_mark_start, top_at_rebuild_start)) {
+          // We need to scan both [bottom, TAMS) and [TAMS, top_at_rebuild_start);
+          // however in case of humongous objects it is sufficient to scan the encompassing
+          // area (top_at_rebuild_start is always larger or equal to TAMS) as one of the
+          // two areas will be zero sized. I.e. TAMS is either
+          // the same as bottom or top(_at_rebuild_start). There is no way TAMS has a different
+          // value: this would mean that TAMS points somewhere into the object.
+          assert(hr->top() == top_at_mark_start || hr->top() == top_at_rebuild_start,
+                 "More than one object in the humongous region?");
+          humongous_obj->oop_iterate(&_update_cl, mr);
+          return top_at_mark_start != hr->bottom() ? mr.intersection(MemRegion((HeapWord*)humongous_obj, humongous_obj->size())).byte_size() : 0;
+        } else {
+          return 0;
+        }
+      }
+
+      for (LiveObjIterator it(bitmap, top_at_mark_start, mr, hr->block_start(mr.start())); it.has_next(); it.move_to_next()) {
+        oop obj = it.next();
+        size_t scanned_size = scan_for_references(obj, mr);
+        if ((HeapWord*)obj < top_at_mark_start) {
+          marked_bytes += scanned_size * HeapWordSize;
+        }
+      }
+
+      return marked_bytes;
+    }
+  public:
+    G1RebuildRemSetHeapRegionClosure(G1CollectedHeap* g1h,
+                                     G1ConcurrentMark* cm,
+                                     uint worker_id) :
+      HeapRegionClosure(),
+      _cm(cm),
+      _update_cl(g1h, worker_id) { }
+
+    bool do_heap_region(HeapRegion* hr) {
+      if (_cm->has_aborted()) {
+        return true;
+      }
+
+      uint const region_idx = hr->hrm_index();
+      DEBUG_ONLY(HeapWord* const top_at_rebuild_start_check = _cm->top_at_rebuild_start(region_idx);)
+      assert(top_at_rebuild_start_check == NULL ||
+             top_at_rebuild_start_check > hr->bottom(),
+             "A TARS (" PTR_FORMAT ") == bottom() (" PTR_FORMAT ") indicates the old region %u is empty (%s)",
+             p2i(top_at_rebuild_start_check), p2i(hr->bottom()),  region_idx, hr->get_type_str());
+
+      size_t total_marked_bytes = 0;
+      size_t const chunk_size_in_words = G1RebuildRemSetChunkSize / HeapWordSize;
+
+      HeapWord* const top_at_mark_start = hr->next_top_at_mark_start();
+
+      HeapWord* cur = hr->bottom();
+      while (cur < hr->end()) {
+        // After every iteration (yield point) we need to check whether the region's
+        // TARS changed due to e.g. eager reclaim.
+        HeapWord* const top_at_rebuild_start = _cm->top_at_rebuild_start(region_idx);
+        if (top_at_rebuild_start == NULL) {
+          return false;
+        }
+
+        MemRegion next_chunk = MemRegion(hr->bottom(), top_at_rebuild_start).intersection(MemRegion(cur, chunk_size_in_words));
+        if (next_chunk.is_empty()) {
+          break;
+        }
+
+        const Ticks start = Ticks::now();
+        size_t marked_bytes = rebuild_rem_set_in_region(_cm->next_mark_bitmap(),
+                                                        top_at_mark_start,
+                                                        top_at_rebuild_start,
+                                                        hr,
+                                                        next_chunk);
+        Tickspan time = Ticks::now() - start;
+
+        log_trace(gc, remset, tracking)("Rebuilt region %u "
+                                        "live " SIZE_FORMAT " "
+                                        "time %.3fms "
+                                        "marked bytes " SIZE_FORMAT " "
+                                        "bot " PTR_FORMAT " "
+                                        "TAMS " PTR_FORMAT " "
+                                        "TARS " PTR_FORMAT,
+                                        region_idx,
+                                        _cm->liveness(region_idx) * HeapWordSize,
+                                        TicksToTimeHelper::seconds(time) * 1000.0,
+                                        marked_bytes,
+                                        p2i(hr->bottom()),
+                                        p2i(top_at_mark_start),
+                                        p2i(top_at_rebuild_start));
+
+        if (marked_bytes > 0) {
+          total_marked_bytes += marked_bytes;
+        }
+        cur += chunk_size_in_words;
+
+        _cm->do_yield_check();
+        if (_cm->has_aborted()) {
+          return true;
+        }
+      }
+      // In the final iteration of the loop the region might have been eagerly reclaimed.
+      // Simply filter out those regions. We can not just use region type because there
+      // might have already been new allocations into these regions.
+      DEBUG_ONLY(HeapWord* const top_at_rebuild_start = _cm->top_at_rebuild_start(region_idx);)
+      assert(top_at_rebuild_start == NULL ||
+             total_marked_bytes == hr->next_marked_bytes(),
+             "Marked bytes " SIZE_FORMAT " for region %u (%s) in [bottom, TAMS) do not match calculated marked bytes " SIZE_FORMAT " "
+             "(" PTR_FORMAT " " PTR_FORMAT " " PTR_FORMAT ")",
+             total_marked_bytes, hr->hrm_index(), hr->get_type_str(), hr->next_marked_bytes(),
+             p2i(hr->bottom()), p2i(top_at_mark_start), p2i(top_at_rebuild_start));
+      // Abort state may have changed after the yield check.
+      return _cm->has_aborted();
+    }
+  };
+
+  HeapRegionClaimer _hr_claimer;
+  G1ConcurrentMark* _cm;
+
+  uint _worker_id_offset;
+public:
+  G1RebuildRemSetTask(G1ConcurrentMark* cm,
+                      uint n_workers,
+                      uint worker_id_offset) :
+      AbstractGangTask("G1 Rebuild Remembered Set"),
+      _hr_claimer(n_workers),
+      _cm(cm),
+      _worker_id_offset(worker_id_offset) {
+  }
+
+  void work(uint worker_id) {
+    SuspendibleThreadSetJoiner sts_join;
+
+    G1CollectedHeap* g1h = G1CollectedHeap::heap();
+
+    G1RebuildRemSetHeapRegionClosure cl(g1h, _cm, _worker_id_offset + worker_id);
+    g1h->heap_region_par_iterate_from_worker_offset(&cl, &_hr_claimer, worker_id);
+  }
+};
+
+void G1RemSet::rebuild_rem_set(G1ConcurrentMark* cm,
+                               WorkGang* workers,
+                               uint worker_id_offset) {
+  uint num_workers = workers->active_workers();
+
+  G1RebuildRemSetTask cl(cm,
+                         num_workers,
+                         worker_id_offset);
+  workers->run_task(&cl, num_workers);
 }
-#endif
@@ -26,7 +26,6 @@
 #define SHARE_VM_GC_G1_G1REMSET_HPP
 
 #include "gc/g1/dirtyCardQueue.hpp"
-#include "gc/g1/g1CardLiveData.hpp"
 #include "gc/g1/g1CardTable.hpp"
 #include "gc/g1/g1RemSetSummary.hpp"
 #include "gc/g1/heapRegion.hpp"
@@ -41,7 +40,9 @@ class CardTableModRefBS;
 class G1BlockOffsetTable;
 class CodeBlobClosure;
 class G1CollectedHeap;
+class G1ConcurrentMark;
 class G1HotCardCache;
+class G1OptionalCSet;
 class G1RemSetScanState;
 class G1ParScanThreadState;
 class G1Policy;
@@ -55,12 +56,11 @@ class HeapRegionClaimer;
 class G1RemSet: public CHeapObj<mtGC> {
 private:
   G1RemSetScanState* _scan_state;
-  G1CardLiveData _card_live_data;
 
   G1RemSetSummary _prev_period_summary;
 
-  // Scan all remembered sets of the collection set for references into the collection
-  // set.
+  // Scan the cards claimed when merging the remembered sets of the collection set
+  // for references into the collection set.
   void scan_rem_set(G1ParScanThreadState* pss,
                     CodeBlobClosure* heap_region_codeblobs,
                     uint worker_i);
@@ -114,8 +114,15 @@ public:
 
   G1RemSetScanState* scan_state() const { return _scan_state; }
 
-  // Eliminates any remembered set entries that correspond to dead heap ranges.
-  void scrub(uint worker_num, HeapRegionClaimer* hrclaimer);
+  // Merge the remembered sets of the collection set regions, or only of the
+  // current batch of optional regions if ocset is not NULL, into the card table
+  // so that they can be scanned in parallel in chunks of cards in memory order.
+  // Must be called before the remembered sets are scanned.
+  void merge_rem_sets(G1OptionalCSet* ocset = NULL);
+
+  // Do not scan cards of the given region for references into the collection
+  // set any more, e.g. because the region has been added to it during the pause.
+  void exclude_region_from_scan(uint region_idx);
 
   // Refine the card corresponding to "card_ptr". Safe to be called concurrently
   // to the mutator.
@@ -135,26 +142,19 @@ public:
 
   size_t num_conc_refined_cards() const { return _num_conc_refined_cards; }
 
-  void create_card_live_data(WorkGang* workers, G1CMBitMap* mark_bitmap);
-  void finalize_card_live_data(WorkGang* workers, G1CMBitMap* mark_bitmap);
-
-  // Verify that the liveness count data created concurrently matches one created
-  // during this safepoint.
-  void verify_card_live_data(WorkGang* workers, G1CMBitMap* actual_bitmap);
-
-  void clear_card_live_data(WorkGang* workers);
-
-#ifdef ASSERT
-  void verify_card_live_data_is_clear();
-#endif
+  // Rebuilds the remembered set by scanning from bottom to TARS for all regions
+  // using the given work gang.
+  void rebuild_rem_set(G1ConcurrentMark* cm, WorkGang* workers, uint worker_id_offset);
 };
 
+// Scans the chunks of cards claimed by merging the remembered sets, and the
+// strong code roots of the regions of the collection set it is applied to.
 class G1ScanRSForRegionClosure : public HeapRegionClosure {
   G1RemSetScanState* _scan_state;
 
   size_t _cards_scanned;
-  size_t _cards_claimed;
-  size_t _cards_skipped;
+  size_t _chunks_claimed;
+  size_t _chunks_skipped;
 
   G1CollectedHeap* _g1h;
 
@@ -167,8 +167,8 @@ class G1ScanRSForRegionClosure : public HeapRegionClosure {
   double _strong_code_root_scan_time_sec;
   uint   _worker_i;
 
-  void claim_card(size_t card_index, const uint region_idx_for_card);
-  void scan_card(MemRegion mr, uint region_idx_for_card);
+  void scan_cards(size_t first_card, size_t num_cards);
+  void scan_chunk(size_t first_card);
   void scan_strong_code_roots(HeapRegion* r);
 public:
   G1ScanRSForRegionClosure(G1RemSetScanState* scan_state,
@@ -176,6 +176,9 @@ public:
                            CodeBlobClosure* code_root_cl,
                            uint worker_i);
 
+  // Claim and scan chunks of cards until there are none left.
+  void scan_claimed_chunks();
+
   bool do_heap_region(HeapRegion* r);
 
   double strong_code_root_scan_time_sec() {
@@ -183,8 +186,8 @@ public:
   }
 
   size_t cards_scanned() const { return _cards_scanned; }
-  size_t cards_claimed() const { return _cards_claimed; }
-  size_t cards_skipped() const { return _cards_skipped; }
+  size_t chunks_claimed() const { return _chunks_claimed; }
+  size_t chunks_skipped() const { return _chunks_skipped; }
 };
 
 #endif // SHARE_VM_GC_G1_G1REMSET_HPP
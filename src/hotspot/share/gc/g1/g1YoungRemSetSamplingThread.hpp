@@ -39,12 +39,21 @@
 // reevaluates the prediction for the remembered set scanning costs, and potentially
 // G1Policy resizes the young gen. This may do a premature GC or even
 // increase the young gen size to keep pause time length goal.
+//
+// The thread also periodically checks whether the application has been idle
+// for longer than G1PeriodicGCInterval and, if so, triggers a collection so
+// that the heap can be shrunk and unused memory given back to the system.
 class G1YoungRemSetSamplingThread: public ConcurrentGCThread {
 private:
   Monitor _monitor;
 
+  double _last_periodic_gc_attempt_s;
+
   void sample_young_list_rs_lengths();
 
+  void check_for_periodic_gc();
+  bool should_start_periodic_gc();
+
   void run_service();
   void stop_service();
 
@@ -184,9 +184,6 @@
           "-1 means print all.")                                            \
           range(-1, max_jint)                                               \
                                                                             \
-  develop(bool, G1ScrubRemSets, true,                                       \
-          "When true, do RS scrubbing after cleanup.")                      \
-                                                                            \
   product(uintx, G1ReservePercent, 10,                                      \
           "It determines the minimum reserve we should have in the heap "   \
           "to minimize the probability of promotion failure.")              \
@@ -197,7 +194,7 @@
                                                                             \
   product(size_t, G1HeapRegionSize, 0,                                      \
           "Size of the G1 regions.")                                        \
-          range(0, 32*M)                                                    \
+          range(0, 512*M)                                                   \
           constraint(G1HeapRegionSizeConstraintFunc,AfterMemoryInit)        \
                                                                             \
   product(uint, G1ConcRefinementThreads, 0,                                 \
@@ -262,6 +259,10 @@
   experimental(bool, G1PretouchAuxiliaryMemory, false,                      \
           "Pre-touch large auxiliary data structures used by the GC.")      \
                                                                             \
+  diagnostic(bool, G1PinJNICriticalObjects, true,                          \
+          "Pin humongous and archive regions holding objects in JNI "       \
+          "critical regions instead of blocking GCs with the GCLocker.")    \
+                                                                            \
   experimental(bool, G1EagerReclaimHumongousObjects, true,                  \
           "Try to reclaim dead large objects at every young GC.")           \
                                                                             \
@@ -269,11 +270,44 @@
           "Try to reclaim dead large objects that have a few stale "        \
           "references at every young GC.")                                  \
                                                                             \
+  experimental(bool, G1EagerReclaimHumongousObjArrays, true,                \
+          "Try to reclaim dead large object arrays at every young GC. "     \
+          "Only applies to object arrays allocated after the start of "     \
+          "a concurrent marking that is in progress.")                      \
+                                                                            \
+  experimental(uintx, G1AllocationSpikePercent, 200,                        \
+          "Recalculate the young list target length during the mutator "    \
+          "phase if eden is allocated at a rate of at least this "          \
+          "percentage of the predicted allocation rate. "                   \
+          "0 disables it.")                                                 \
+          range(0, max_uintx)                                               \
+                                                                            \
   experimental(uintx, G1OldCSetRegionThresholdPercent, 10,                  \
           "An upper bound for the number of old CSet regions expressed "    \
           "as a percentage of the heap size.")                              \
           range(0, 100)                                                     \
                                                                             \
+  experimental(size_t, G1RebuildRemSetChunkSize, 256 * K,                   \
+          "Chunk size used for rebuilding the remembered set.")             \
+          range(4 * K, 32 * M)                                              \
+                                                                            \
+  manageable(uintx, G1PeriodicGCInterval, 0,                                \
+          "Number of milliseconds after a previous GC to wait before "      \
+          "triggering a periodic gc. A value of zero disables periodically "\
+          "enforced gc cycles.")                                            \
+                                                                            \
+  product(bool, G1PeriodicGCInvokesConcurrent, true,                        \
+          "Determines the kind of periodic GC. Set to true to have G1 "     \
+          "perform a concurrent GC as periodic GC, otherwise use a STW "    \
+          "Full GC.")                                                       \
+                                                                            \
+  manageable(uintx, G1PeriodicGCSystemLoadThreshold, 0,                     \
+          "Maximum recent system wide load as returned by the 1m value "    \
+          "of getloadavg() at which G1 triggers a periodic GC. A load "     \
+          "above this value cancels a given periodic GC. A value of zero "  \
+          "disables this check.")                                           \
+          range(0, max_uintx)                                               \
+                                                                            \
   notproduct(bool, G1EvacuationFailureALot, false,                          \
           "Force use of evacuation failure handling during certain "        \
           "evacuation pauses")                                              \
@@ -41,6 +41,8 @@ class G1ConcurrentRefineOopClosure;
 class G1CMOopClosure;
 class G1RootRegionScanClosure;
 
+class G1RebuildRemSetClosure;
+
 class G1MarkAndPushClosure;
 class G1AdjustAndRebuildClosure;
 
@@ -50,7 +52,8 @@ class G1AdjustAndRebuildClosure;
       f(G1ScanObjsDuringScanRSClosure,_nv)         \
       f(G1ConcurrentRefineOopClosure,_nv)          \
       f(G1CMOopClosure,_nv)                        \
-      f(G1RootRegionScanClosure,_nv)
+      f(G1RootRegionScanClosure,_nv)               \
+      f(G1RebuildRemSetClosure,_nv)
 
 #define SPECIALIZED_OOP_OOP_ITERATE_CLOSURES_G1FULL(f) \
       f(G1MarkAndPushClosure,_nv)                      \
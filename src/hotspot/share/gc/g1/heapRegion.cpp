@@ -27,6 +27,7 @@
 #include "gc/g1/g1BlockOffsetTable.inline.hpp"
 #include "gc/g1/g1CollectedHeap.inline.hpp"
 #include "gc/g1/g1HeapRegionTraceType.hpp"
+#include "gc/g1/g1NUMA.hpp"
 #include "gc/g1/g1OopClosures.inline.hpp"
 #include "gc/g1/heapRegion.inline.hpp"
 #include "gc/g1/heapRegionBounds.inline.hpp"
@@ -51,7 +52,14 @@ size_t HeapRegion::GrainWords        = 0;
 size_t HeapRegion::CardsPerRegion    = 0;
 
 size_t HeapRegion::max_region_size() {
-  return HeapRegionBounds::max_size();
+  // Only regions explicitly sized larger than the ergonomic maximum need a
+  // larger alignment; the region size is the largest power of 2 that is
+  // not larger than G1HeapRegionSize.
+  size_t max_size = HeapRegionBounds::max_ergonomics_size();
+  if (G1HeapRegionSize > max_size) {
+    max_size = MIN2(((size_t)1 << log2_long((jlong)G1HeapRegionSize)), HeapRegionBounds::max_size());
+  }
+  return max_size;
 }
 
 size_t HeapRegion::min_region_size_in_words() {
@@ -62,8 +70,9 @@ void HeapRegion::setup_heap_region_size(size_t initial_heap_size, size_t max_hea
   size_t region_size = G1HeapRegionSize;
   if (FLAG_IS_DEFAULT(G1HeapRegionSize)) {
     size_t average_heap_size = (initial_heap_size + max_heap_size) / 2;
-    region_size = MAX2(average_heap_size / HeapRegionBounds::target_number(),
-                       HeapRegionBounds::min_size());
+    region_size = MIN2(MAX2(average_heap_size / HeapRegionBounds::target_number(),
+                            HeapRegionBounds::min_size()),
+                       HeapRegionBounds::max_ergonomics_size());
   }
 
   int region_size_log = log2_long((jlong) region_size);
@@ -112,8 +121,11 @@ void HeapRegion::hr_clear(bool keep_remset, bool clear_space, bool locked) {
          "we should have already filtered out humongous regions");
   assert(!in_collection_set(),
          "Should not clear heap region %u in the collection set", hrm_index());
+  assert(!has_jni_pins(),
+         "Should not clear heap region %u held by a JNI critical region", hrm_index());
 
   set_young_index_in_cset(-1);
+  set_index_in_opt_cset(-1);
   uninstall_surv_rate_group();
   set_free();
   reset_pre_dummy_top();
@@ -236,13 +248,15 @@ HeapRegion::HeapRegion(uint hrm_index,
     _hrm_index(hrm_index),
     _humongous_start_region(NULL),
     _evacuation_failed(false),
+    _jni_pin_count(0),
     _prev_marked_bytes(0), _next_marked_bytes(0), _gc_efficiency(0.0),
     _next(NULL), _prev(NULL),
 #ifdef ASSERT
     _containing_set(NULL),
 #endif // ASSERT
-     _young_index_in_cset(-1), _surv_rate_group(NULL), _age_index(-1),
-    _rem_set(NULL), _recorded_rs_length(0), _predicted_elapsed_time_ms(0)
+     _young_index_in_cset(-1), _index_in_opt_cset(-1), _surv_rate_group(NULL), _age_index(-1),
+    _rem_set(NULL), _recorded_rs_length(0), _predicted_elapsed_time_ms(0),
+    _node_index(G1NUMA::UnknownNodeIndex)
 {
   _rem_set = new HeapRegionRemSet(bot, this);
 
@@ -570,7 +584,8 @@ public:
       HeapRegion* to = _g1h->heap_region_containing(obj);
       if (from != NULL && to != NULL &&
         from != to &&
-        !to->is_pinned()) {
+        !to->is_pinned() &&
+        to->rem_set()->is_complete()) {
         jbyte cv_obj = *_ct->byte_for_const(_containing_obj);
         jbyte cv_field = *_ct->byte_for_const(p);
         const jbyte dirty = G1CardTable::dirty_card_val();
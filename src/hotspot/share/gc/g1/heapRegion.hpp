@@ -33,6 +33,7 @@
 #include "gc/shared/ageTable.hpp"
 #include "gc/shared/cardTable.hpp"
 #include "gc/shared/spaceDecorator.hpp"
+#include "runtime/atomic.hpp"
 #include "utilities/macros.hpp"
 
 // A HeapRegion is the smallest piece of a G1CollectedHeap that
@@ -240,6 +241,10 @@ class HeapRegion: public G1ContiguousSpace {
   // True iff an attempt to evacuate an object in the region failed.
   bool _evacuation_failed;
 
+  // Number of JNI critical regions currently pinning the object(s) in
+  // this region.
+  volatile size_t _jni_pin_count;
+
   // Fields used by the HeapRegionSetBase class and subclasses.
   HeapRegion* _next;
   HeapRegion* _prev;
@@ -256,6 +261,8 @@ class HeapRegion: public G1ContiguousSpace {
   double _gc_efficiency;
 
   int  _young_index_in_cset;
+  // Index of this region in the optional part of the collection set, or -1.
+  int  _index_in_opt_cset;
   SurvRateGroup* _surv_rate_group;
   int  _age_index;
 
@@ -289,6 +296,10 @@ class HeapRegion: public G1ContiguousSpace {
   // for the collection set.
   double _predicted_elapsed_time_ms;
 
+  // The index of the NUMA node whose memory this region is preferably
+  // placed on.
+  uint _node_index;
+
   // Iterate over the references in a humongous objects and apply the given closure
   // to them.
   // Humongous objects are allocated directly in the old-gen. So we need special
@@ -371,6 +382,11 @@ class HeapRegion: public G1ContiguousSpace {
   // sequence, otherwise -1.
   uint hrm_index() const { return _hrm_index; }
 
+  // The preferred NUMA node index of this region, or G1NUMA::UnknownNodeIndex
+  // if it has not been set yet.
+  uint node_index() const { return _node_index; }
+  void set_node_index(uint node_index) { _node_index = node_index; }
+
   // The number of bytes marked live in the region in the last marking phase.
   size_t marked_bytes()    { return _prev_marked_bytes; }
   size_t live_bytes() {
@@ -566,6 +582,9 @@ class HeapRegion: public G1ContiguousSpace {
     _young_index_in_cset = index;
   }
 
+  int  index_in_opt_cset() const { return _index_in_opt_cset; }
+  void set_index_in_opt_cset(int index) { _index_in_opt_cset = index; }
+
   int age_in_surv_rate_group() {
     assert( _surv_rate_group != NULL, "pre-condition" );
     assert( _age_index > -1, "pre-condition" );
@@ -633,6 +652,18 @@ class HeapRegion: public G1ContiguousSpace {
     return (HeapWord *) obj >= next_top_at_mark_start();
   }
 
+  // JNI critical regions pinning the object(s) in this region. Only
+  // pinned regions, whose objects are never moved, are tracked.
+  void increment_jni_pin_count() {
+    assert(is_pinned(), "Only objects in pinned regions can be held by JNI critical regions");
+    Atomic::inc(&_jni_pin_count);
+  }
+  void decrement_jni_pin_count() {
+    assert(_jni_pin_count > 0, "Unbalanced JNI critical region pinning");
+    Atomic::dec(&_jni_pin_count);
+  }
+  bool has_jni_pins() const { return _jni_pin_count > 0; }
+
   // Returns the "evacuation_failed" property of the region.
   bool evacuation_failed() { return _evacuation_failed; }
 
@@ -34,12 +34,20 @@ private:
   // heaps a bit more efficiently.
   static const size_t MIN_REGION_SIZE = 1024 * 1024;
 
-  // Maximum region size; we don't go higher than that. There's a good
+  // Maximum region size determined ergonomically. There's a good
   // reason for having an upper bound. We don't want regions to get too
   // large, otherwise cleanup's effectiveness would decrease as there
   // will be fewer opportunities to find totally empty regions after
   // marking.
-  static const size_t MAX_REGION_SIZE = 32 * 1024 * 1024;
+  static const size_t MAX_ERGONOMICS_SIZE = 32 * 1024 * 1024;
+
+  // Maximum region size; we don't go higher than that. Very large heaps
+  // may explicitly select regions up to this size to reduce the overhead
+  // of per-region data structures. The remembered set cost per region
+  // grows with it: a fine-grained entry holds one bit per card, which is
+  // 128K at 512M instead of 8K at 32M, and sparse entries need 32-bit
+  // card indices above 32M.
+  static const size_t MAX_REGION_SIZE = 512 * 1024 * 1024;
 
   // The automatic region size calculation will try to have around this
   // many regions in the heap (based on the min heap size).
@@ -47,6 +55,7 @@ private:
 
 public:
   static inline size_t min_size();
+  static inline size_t max_ergonomics_size();
   static inline size_t max_size();
   static inline size_t target_number();
 };
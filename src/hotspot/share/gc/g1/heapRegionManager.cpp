@@ -141,6 +141,7 @@ void HeapRegionManager::make_regions_available(uint start, uint num_regions, Wor
     MemRegion mr(bottom, bottom + HeapRegion::GrainWords);
 
     hr->initialize(mr);
+    hr->set_node_index(G1NUMA::numa()->preferred_node_index_for_index(i));
     insert_into_free_list(at(i));
   }
 }
@@ -26,6 +26,7 @@
 #define SHARE_VM_GC_G1_HEAPREGIONMANAGER_HPP
 
 #include "gc/g1/g1BiasedArray.hpp"
+#include "gc/g1/g1NUMA.hpp"
 #include "gc/g1/g1RegionToSpaceMapper.hpp"
 #include "gc/g1/heapRegionSet.hpp"
 #include "services/memoryUsage.hpp"
@@ -167,8 +168,16 @@ public:
     _free_list.add_ordered(list);
   }
 
-  HeapRegion* allocate_free_region(bool is_old) {
-    HeapRegion* hr = _free_list.remove_region(is_old);
+  // Allocate a free region. If a node index is requested, prefer a region
+  // whose memory is placed on that node, and fall back to any free region.
+  HeapRegion* allocate_free_region(bool is_old, uint requested_node_index = G1NUMA::AnyNodeIndex) {
+    HeapRegion* hr = NULL;
+    if (requested_node_index != G1NUMA::AnyNodeIndex && G1NUMA::numa()->is_enabled()) {
+      hr = _free_list.remove_region_with_node_index(is_old, requested_node_index);
+    }
+    if (hr == NULL) {
+      hr = _free_list.remove_region(is_old);
+    }
 
     if (hr != NULL) {
       assert(hr->next() == NULL, "Single region should not have next");
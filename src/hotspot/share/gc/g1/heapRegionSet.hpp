@@ -209,6 +209,12 @@ public:
   // Removes from head or tail based on the given argument.
   HeapRegion* remove_region(bool from_head);
 
+  // Removes the first region, searching from head or tail based on the given
+  // argument, whose preferred NUMA node is requested_node_index. Returns NULL
+  // if there is no such region.
+  inline HeapRegion* remove_region_with_node_index(bool from_head,
+                                                   uint requested_node_index);
+
   // Merge two ordered lists. The result is also ordered. The order is
   // determined by hrm_index.
   void add_ordered(FreeRegionList* from_list);
@@ -147,5 +147,43 @@ inline HeapRegion* FreeRegionList::remove_region(bool from_head) {
   return hr;
 }
 
+inline HeapRegion* FreeRegionList::remove_region_with_node_index(bool from_head,
+                                                                 uint requested_node_index) {
+  check_mt_safety();
+  verify_optional();
+
+  HeapRegion* cur = from_head ? _head : _tail;
+  while (cur != NULL && cur->node_index() != requested_node_index) {
+    cur = from_head ? cur->next() : cur->prev();
+  }
+
+  if (cur == NULL) {
+    return NULL;
+  }
+
+  HeapRegion* prev = cur->prev();
+  HeapRegion* next = cur->next();
+  if (prev == NULL) {
+    _head = next;
+  } else {
+    prev->set_next(next);
+  }
+  if (next == NULL) {
+    _tail = prev;
+  } else {
+    next->set_prev(prev);
+  }
+  cur->set_prev(NULL);
+  cur->set_next(NULL);
+
+  if (_last == cur) {
+    _last = NULL;
+  }
+
+  // remove() will verify the region and check mt safety.
+  remove(cur);
+  return cur;
+}
+
 #endif // SHARE_VM_GC_G1_HEAPREGIONSET_INLINE_HPP
 
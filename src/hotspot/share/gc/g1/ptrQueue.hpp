@@ -301,6 +301,11 @@ protected:
     return false;
   }
 
+  // Returns true if the current mutator thread should process the buffer
+  // it just completed itself instead of enqueuing it. By default this is
+  // the case if the completed queue is at its maximum length.
+  virtual bool mut_should_process_buffer();
+
   // Create an empty ptr queue set.
   PtrQueueSet(bool notify_when_complete = false);
   ~PtrQueueSet();
@@ -39,32 +39,41 @@ STATIC_ASSERT(sizeof(SparsePRTEntry) % sizeof(int) == 0);
 
 void SparsePRTEntry::init(RegionIdx_t region_ind) {
   // Check that the card array element type can represent all cards in the region.
-  // Choose a large SparsePRTEntry::card_elem_t (e.g. CardIdx_t) if required.
-  assert(((size_t)1 << (sizeof(SparsePRTEntry::card_elem_t) * BitsPerByte)) *
-         G1CardTable::card_size >= HeapRegionBounds::max_size(), "precondition");
+  assert((julong)HeapRegion::CardsPerRegion <=
+         ((julong)1 << (card_elem_size() * BitsPerByte)), "precondition");
   assert(G1RSetSparseRegionEntries > 0, "precondition");
   _region_ind = region_ind;
   _next_index = RSHashTable::NullEntry;
   _next_null = 0;
 }
 
-bool SparsePRTEntry::contains_card(CardIdx_t card_index) const {
-  for (int i = 0; i < num_valid_cards(); i++) {
-    if (card(i) == card_index) {
+template <typename T>
+static bool contains_card_in(const T* cards, int num_cards, CardIdx_t card_index) {
+  for (int i = 0; i < num_cards; i++) {
+    if (cards[i] == (T)card_index) {
       return true;
     }
   }
   return false;
 }
 
+bool SparsePRTEntry::contains_card(CardIdx_t card_index) const {
+  if (wide_cards()) {
+    return contains_card_in(wide_card_array(), num_valid_cards(), card_index);
+  }
+  return contains_card_in(_cards, num_valid_cards(), card_index);
+}
+
 SparsePRTEntry::AddCardResult SparsePRTEntry::add_card(CardIdx_t card_index) {
-  for (int i = 0; i < num_valid_cards(); i++) {
-    if (card(i) == card_index) {
-      return found;
-    }
+  if (contains_card(card_index)) {
+    return found;
   }
   if (num_valid_cards() < cards_num() - 1) {
-    _cards[_next_null] = (card_elem_t)card_index;
+    if (wide_cards()) {
+      wide_card_array()[_next_null] = (wide_card_elem_t)card_index;
+    } else {
+      _cards[_next_null] = (card_elem_t)card_index;
+    }
     _next_null++;
     return added;
    }
@@ -72,12 +81,8 @@ SparsePRTEntry::AddCardResult SparsePRTEntry::add_card(CardIdx_t card_index) {
   return overflow;
 }
 
-void SparsePRTEntry::copy_cards(card_elem_t* cards) const {
-  memcpy(cards, _cards, cards_num() * sizeof(card_elem_t));
-}
-
 void SparsePRTEntry::copy_cards(SparsePRTEntry* e) const {
-  copy_cards(e->_cards);
+  memcpy(e->_cards, _cards, cards_num() * card_elem_size());
   assert(_next_null >= 0, "invariant");
   assert(_next_null <= cards_num(), "invariant");
   e->_next_null = _next_null;
@@ -47,6 +47,9 @@ class SparsePRTEntry: public CHeapObj<mtGC> {
 private:
   // The type of a card entry.
   typedef uint16_t card_elem_t;
+  // The type of a card entry if card_elem_t cannot represent all cards in
+  // a region. Only regions larger than 32M need it.
+  typedef uint32_t wide_card_elem_t;
 
   // We need to make sizeof(SparsePRTEntry) an even multiple of maximum member size,
   // in order to force correct alignment that could otherwise cause SIGBUS errors
@@ -62,11 +65,22 @@ private:
   // It should always be the last data member.
   card_elem_t _cards[card_array_alignment];
 
-  // Copy the current entry's cards into "cards".
-  inline void copy_cards(card_elem_t* cards) const;
+  // Whether the card array holds wide_card_elem_t instead of card_elem_t.
+  // Fixed once the region size is known.
+  static bool wide_cards() {
+    return HeapRegion::CardsPerRegion > ((size_t)1 << (sizeof(card_elem_t) * BitsPerByte));
+  }
+  static size_t card_elem_size() {
+    return wide_cards() ? sizeof(wide_card_elem_t) : sizeof(card_elem_t);
+  }
+  const wide_card_elem_t* wide_card_array() const { return (const wide_card_elem_t*)_cards; }
+  wide_card_elem_t* wide_card_array() { return (wide_card_elem_t*)_cards; }
+
 public:
   // Returns the size of the entry, used for entry allocation.
-  static size_t size() { return sizeof(SparsePRTEntry) + sizeof(card_elem_t) * (cards_num() - card_array_alignment); }
+  static size_t size() {
+    return sizeof(SparsePRTEntry) + card_elem_size() * cards_num() - sizeof(card_elem_t) * card_array_alignment;
+  }
   // Returns the size of the card array.
   static int cards_num() {
     return align_up((int)G1RSetSparseRegionEntries, (int)card_array_alignment);
@@ -105,7 +119,7 @@ public:
   inline CardIdx_t card(int i) const {
     assert(i >= 0, "must be nonnegative");
     assert(i < cards_num(), "range checking");
-    return (CardIdx_t)_cards[i];
+    return wide_cards() ? (CardIdx_t)wide_card_array()[i] : (CardIdx_t)_cards[i];
   }
 };
 
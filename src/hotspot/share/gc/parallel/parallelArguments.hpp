@@ -32,6 +32,8 @@ class CollectedHeap;
 class ParallelArguments : public GCArguments {
 public:
   virtual void initialize_flags();
+  // The throughput collector trades some time to safepoint for fewer polls.
+  virtual uintx loop_strip_mining_iter() { return 4000; }
   virtual size_t conservative_max_heap_alignment();
   virtual CollectedHeap* create_heap();
 };
@@ -26,7 +26,6 @@
 #include "code/codeCache.hpp"
 #include "gc/parallel/adjoiningGenerations.hpp"
 #include "gc/parallel/adjoiningVirtualSpaces.hpp"
-#include "gc/parallel/gcTaskManager.hpp"
 #include "gc/parallel/generationSizer.hpp"
 #include "gc/parallel/objectStartArray.inline.hpp"
 #include "gc/parallel/parallelScavengeHeap.inline.hpp"
@@ -40,6 +39,8 @@
 #include "gc/shared/gcHeapSummary.hpp"
 #include "gc/shared/gcLocker.inline.hpp"
 #include "gc/shared/gcWhen.hpp"
+#include "gc/shared/stringDedup.hpp"
+#include "gc/shared/suspendibleThreadSet.hpp"
 #include "logging/log.hpp"
 #include "oops/oop.inline.hpp"
 #include "runtime/handles.inline.hpp"
@@ -53,7 +54,6 @@ PSYoungGen*  ParallelScavengeHeap::_young_gen = NULL;
 PSOldGen*    ParallelScavengeHeap::_old_gen = NULL;
 PSAdaptiveSizePolicy* ParallelScavengeHeap::_size_policy = NULL;
 PSGCAdaptivePolicyCounters* ParallelScavengeHeap::_gc_policy_counters = NULL;
-GCTaskManager* ParallelScavengeHeap::_gc_task_manager = NULL;
 
 jint ParallelScavengeHeap::initialize() {
   const size_t heap_size = _collector_policy->max_heap_byte_size();
@@ -89,6 +89,11 @@ jint ParallelScavengeHeap::initialize() {
   _old_gen = _gens->old_gen();
   _young_gen = _gens->young_gen();
 
+  if (!UseAdaptiveGCBoundary) {
+    // The young generation sits above the old one and never moves.
+    barrier_set->set_young_gen_boundary(_young_gen->reserved().start(), true);
+  }
+
   const size_t eden_capacity = _young_gen->eden_space()->capacity_in_bytes();
   const size_t old_capacity = _old_gen->capacity_in_bytes();
   const size_t initial_promo_size = MIN2(eden_capacity, old_capacity);
@@ -110,16 +115,38 @@ jint ParallelScavengeHeap::initialize() {
   _gc_policy_counters =
     new PSGCAdaptivePolicyCounters("ParScav:MSC", 2, 2, _size_policy);
 
-  // Set up the GCTaskManager
-  _gc_task_manager = GCTaskManager::create(ParallelGCThreads);
+  _workers.initialize_workers();
 
   if (UseParallelOldGC && !PSParallelCompact::initialize()) {
     return JNI_ENOMEM;
   }
 
+  // Initialize string deduplication
+  StringDedup::initialize();
+
   return JNI_OK;
 }
 
+void ParallelScavengeHeap::stop() {
+  if (StringDedup::is_enabled()) {
+    StringDedup::stop();
+  }
+}
+
+void ParallelScavengeHeap::safepoint_synchronize_begin() {
+  // The string deduplication thread is the only suspendible thread
+  // running concurrently with the mutators.
+  if (StringDedup::is_enabled()) {
+    SuspendibleThreadSet::synchronize();
+  }
+}
+
+void ParallelScavengeHeap::safepoint_synchronize_end() {
+  if (StringDedup::is_enabled()) {
+    SuspendibleThreadSet::desynchronize();
+  }
+}
+
 void ParallelScavengeHeap::initialize_serviceability() {
 
   _eden_pool = new EdenMutableSpacePool(_young_gen,
@@ -585,11 +612,17 @@ void ParallelScavengeHeap::print_on_error(outputStream* st) const {
 }
 
 void ParallelScavengeHeap::gc_threads_do(ThreadClosure* tc) const {
-  PSScavenge::gc_task_manager()->threads_do(tc);
+  _workers.threads_do(tc);
+  if (StringDedup::is_enabled()) {
+    StringDedup::threads_do(tc);
+  }
 }
 
 void ParallelScavengeHeap::print_gc_threads_on(outputStream* st) const {
-  PSScavenge::gc_task_manager()->print_threads_on(st);
+  _workers.print_worker_threads_on(st);
+  if (StringDedup::is_enabled()) {
+    StringDedup::print_worker_threads_on(st);
+  }
 }
 
 void ParallelScavengeHeap::print_tracing_info() const {
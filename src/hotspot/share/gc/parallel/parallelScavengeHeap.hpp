@@ -37,13 +37,13 @@
 #include "gc/shared/gcWhen.hpp"
 #include "gc/shared/softRefPolicy.hpp"
 #include "gc/shared/strongRootsScope.hpp"
+#include "gc/shared/workgroup.hpp"
 #include "memory/metaspace.hpp"
 #include "utilities/growableArray.hpp"
 #include "utilities/ostream.hpp"
 
 class AdjoiningGenerations;
 class GCHeapSummary;
-class GCTaskManager;
 class MemoryManager;
 class MemoryPool;
 class PSAdaptiveSizePolicy;
@@ -69,8 +69,7 @@ class ParallelScavengeHeap : public CollectedHeap {
   AdjoiningGenerations* _gens;
   unsigned int _death_march_count;
 
-  // The task manager
-  static GCTaskManager* _gc_task_manager;
+  WorkGang _workers;
 
   GCMemoryManager* _young_manager;
   GCMemoryManager* _old_manager;
@@ -93,7 +92,13 @@ class ParallelScavengeHeap : public CollectedHeap {
 
  public:
   ParallelScavengeHeap(GenerationSizer* policy) :
-    CollectedHeap(), _collector_policy(policy), _death_march_count(0) { }
+    CollectedHeap(),
+    _collector_policy(policy),
+    _death_march_count(0),
+    _workers("GC Thread",
+             ParallelGCThreads,
+             true /* are_GC_task_threads */,
+             false /* are_ConcurrentGC_threads */) { }
 
   // For use by VM operations
   enum CollectionType {
@@ -125,7 +130,9 @@ class ParallelScavengeHeap : public CollectedHeap {
 
   static ParallelScavengeHeap* heap();
 
-  static GCTaskManager* const gc_task_manager() { return _gc_task_manager; }
+  WorkGang& workers() { return _workers; }
+
+  virtual WorkGang* get_safepoint_workers() { return &_workers; }
 
   CardTableModRefBS* barrier_set();
   PSCardTable* card_table();
@@ -136,6 +143,10 @@ class ParallelScavengeHeap : public CollectedHeap {
   virtual jint initialize();
 
   void post_initialize();
+
+  virtual void stop();
+  virtual void safepoint_synchronize_begin();
+  virtual void safepoint_synchronize_end();
   void update_counters();
 
   // The alignment used for the various areas
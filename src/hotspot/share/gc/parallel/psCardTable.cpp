@@ -23,13 +23,11 @@
  */
 
 #include "precompiled.hpp"
-#include "gc/parallel/gcTaskManager.hpp"
 #include "gc/parallel/objectStartArray.inline.hpp"
 #include "gc/parallel/parallelScavengeHeap.inline.hpp"
 #include "gc/parallel/psCardTable.hpp"
 #include "gc/parallel/psPromotionManager.inline.hpp"
 #include "gc/parallel/psScavenge.hpp"
-#include "gc/parallel/psTasks.hpp"
 #include "gc/parallel/psYoungGen.hpp"
 #include "oops/oop.inline.hpp"
 #include "runtime/prefetch.inline.hpp"
@@ -210,9 +208,7 @@ void PSCardTable::scavenge_contents_parallel(ObjectStartArray* start_array,
     jbyte* current_card = worker_start_card;
     while (current_card < worker_end_card) {
       // Find an unclean card.
-      while (current_card < worker_end_card && card_is_clean(*current_card)) {
-        current_card++;
-      }
+      current_card = find_first_non_clean_card(current_card, worker_end_card);
       jbyte* first_unclean_card = current_card;
 
       // Find the end of a run of contiguous unclean cards
@@ -25,10 +25,13 @@
 #ifndef SHARE_VM_GC_PARALLEL_PSCOMPACTIONMANAGER_HPP
 #define SHARE_VM_GC_PARALLEL_PSCOMPACTIONMANAGER_HPP
 
+#include "gc/parallel/psParallelCompact.hpp"
 #include "gc/shared/taskqueue.hpp"
 #include "memory/allocation.hpp"
+#include "utilities/growableArray.hpp"
 #include "utilities/stack.hpp"
 
+class Monitor;
 class MutableSpace;
 class PSOldGen;
 class ParCompactionManager;
@@ -40,10 +43,11 @@ class ParCompactionManager : public CHeapObj<mtGC> {
   friend class ParallelTaskTerminator;
   friend class ParMarkBitMap;
   friend class PSParallelCompact;
-  friend class CompactionWithStealingTask;
   friend class UpdateAndFillClosure;
   friend class RefProcTaskExecutor;
-  friend class IdleGCTask;
+  friend class PCRefProcTask;
+  friend class MarkFromRootsTask;
+  friend class UpdateDensePrefixAndCompactionTask;
 
  public:
 
@@ -72,6 +76,10 @@ class ParCompactionManager : public CHeapObj<mtGC> {
   static RegionTaskQueueSet*    _region_array;
   static PSOldGen*              _old_gen;
 
+  // Free regions usable as shadow regions, and the monitor guarding them.
+  static GrowableArray<size_t>* _shadow_region_array;
+  static Monitor*               _shadow_region_monitor;
+
 private:
   OverflowTaskQueue<oop, mtGC>        _marking_stack;
   ObjArrayTaskQueue             _objarray_stack;
@@ -89,6 +97,9 @@ private:
   oop _last_query_obj;
   size_t _last_query_ret;
 
+  // The next region this worker tries to steal for shadow filling.
+  size_t _next_shadow_region;
+
   static PSOldGen* old_gen()             { return _old_gen; }
   static ObjectStartArray* start_array() { return _start_array; }
   static OopTaskQueueSet* stack_array()  { return _stack_array; }
@@ -129,6 +140,22 @@ private:
 
   RegionTaskQueue* region_stack()                { return &_region_stack; }
 
+  // Shadow region support.  pop_shadow_region_mt_safe() blocks until either
+  // a shadow region is free or the heap region becomes available, in which
+  // case InvalidShadow is returned.
+  static const size_t InvalidShadow = ~0;
+  static size_t pop_shadow_region_mt_safe(PSParallelCompact::RegionData* region_ptr);
+  static void push_shadow_region_mt_safe(size_t shadow_region);
+  static void push_shadow_region(size_t shadow_region);
+  static void remove_all_shadow_regions();
+
+  size_t next_shadow_region() const { return _next_shadow_region; }
+  void set_next_shadow_region(size_t record) { _next_shadow_region = record; }
+  size_t move_next_shadow_region_by(size_t workers) {
+    _next_shadow_region += workers;
+    return next_shadow_region();
+  }
+
   inline static ParCompactionManager* manager_array(uint index);
 
   ParCompactionManager();
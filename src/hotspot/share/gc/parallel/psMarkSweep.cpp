@@ -24,7 +24,6 @@
 
 #include "precompiled.hpp"
 #include "aot/aotLoader.hpp"
-#include "classfile/stringTable.hpp"
 #include "classfile/symbolTable.hpp"
 #include "classfile/systemDictionary.hpp"
 #include "code/codeCache.hpp"
@@ -47,6 +46,7 @@
 #include "gc/shared/referencePolicy.hpp"
 #include "gc/shared/referenceProcessor.hpp"
 #include "gc/shared/spaceDecorator.hpp"
+#include "gc/shared/stringDedup.hpp"
 #include "gc/shared/weakProcessor.hpp"
 #include "logging/log.hpp"
 #include "oops/oop.inline.hpp"
@@ -496,8 +496,7 @@ void PSMarkSweep::allocate_stacks() {
 
 
 void PSMarkSweep::deallocate_stacks() {
-  _preserved_mark_stack.clear(true);
-  _preserved_oop_stack.clear(true);
+  _preserved_overflow_stack.clear(true);
   _marking_stack.clear();
   _objarray_stack.clear(true);
 }
@@ -550,6 +549,9 @@ void PSMarkSweep::mark_sweep_phase1(bool clear_all_softrefs) {
   {
     GCTraceTime(Debug, gc, phases) t("Weak Processing", _gc_timer);
     WeakProcessor::weak_oops_do(is_alive_closure(), &do_nothing_cl);
+    if (StringDedup::is_enabled()) {
+      StringDedup::unlink(is_alive_closure());
+    }
   }
 
   {
@@ -565,17 +567,8 @@ void PSMarkSweep::mark_sweep_phase1(bool clear_all_softrefs) {
     Klass::clean_weak_klass_links(is_alive_closure());
   }
 
-  {
-    GCTraceTime(Debug, gc, phases) t("Scrub String Table", _gc_timer);
-    // Delete entries for dead interned strings.
-    StringTable::unlink(is_alive_closure());
-  }
-
-  {
-    GCTraceTime(Debug, gc, phases) t("Scrub Symbol Table", _gc_timer);
-    // Clean up unreferenced symbols in symbol table.
-    SymbolTable::unlink();
-  }
+  // Unreferenced symbols are removed concurrently by the ServiceThread.
+  SymbolTable::trigger_cleanup();
 
   _gc_tracer->report_object_count_after_gc(is_alive_closure());
 }
@@ -625,11 +618,13 @@ void PSMarkSweep::mark_sweep_phase3() {
   // have been cleared if they pointed to non-surviving objects.)
   // Global (weak) JNI handles
   WeakProcessor::oops_do(adjust_pointer_closure());
+  if (StringDedup::is_enabled()) {
+    StringDedup::oops_do(adjust_pointer_closure());
+  }
 
   CodeBlobToOopClosure adjust_from_blobs(adjust_pointer_closure(), CodeBlobToOopClosure::FixRelocations);
   CodeCache::blobs_do(&adjust_from_blobs);
   AOTLoader::oops_do(adjust_pointer_closure());
-  StringTable::oops_do(adjust_pointer_closure());
   ref_processor()->weak_oops_do(adjust_pointer_closure());
   PSScavenge::reference_processor()->weak_oops_do(adjust_pointer_closure());
 
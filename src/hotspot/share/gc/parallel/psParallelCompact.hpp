@@ -40,11 +40,10 @@ class PSOldGen;
 class ParCompactionManager;
 class ParallelTaskTerminator;
 class PSParallelCompact;
-class GCTaskManager;
-class GCTaskQueue;
 class PreGCValues;
 class MoveAndUpdateClosure;
 class RefProcTaskExecutor;
+class UpdateDensePrefixTaskQueue;
 class ParallelOldTracer;
 class STWGCTimer;
 
@@ -328,6 +327,33 @@ public:
     inline void decrement_destination_count();
     inline bool claim();
 
+    // Possible values of _shadow_state, and transition is as follows
+    // Normal Path:
+    // UnusedRegion -> mark_normal() -> NormalRegion
+    // Shadow Path:
+    // UnusedRegion -> mark_shadow() -> ShadowRegion ->
+    // mark_filled() -> FilledShadow -> mark_copied() -> CopiedShadow
+    static const int UnusedRegion = 0; // The region is not collected yet
+    static const int ShadowRegion = 1; // Stolen by an idle thread, and a shadow region is created for it
+    static const int FilledShadow = 2; // Its shadow region has been filled and ready to be copied back
+    static const int CopiedShadow = 3; // The data of the shadow region has been copied back
+    static const int NormalRegion = 4; // The region will be collected by the original parallel algorithm
+
+    // Mark the current region as normal or shadow to enter different processing paths
+    inline bool mark_normal();
+    inline bool mark_shadow();
+    // Mark the shadow region as filled and ready to be copied back
+    inline void mark_filled();
+    // Mark the shadow region as copied back to avoid double copying.
+    inline bool mark_copied();
+    // Special case: see the comment in PSParallelCompact::fill_and_update_shadow_region.
+    // Return to the normal path here
+    inline void shadow_to_normal();
+
+    int shadow_state() const { return _shadow_state; }
+    size_t shadow_region() const { return _shadow_region; }
+    void set_shadow_region(size_t region) { _shadow_region = region; }
+
   private:
     // The type used to represent object sizes within a region.
     typedef uint region_sz_t;
@@ -348,6 +374,8 @@ public:
     region_sz_t          _partial_obj_size;
     region_sz_t volatile _dc_and_los;
     bool        volatile _blocks_filled;
+    int         volatile _shadow_state;
+    size_t               _shadow_region;
 
 #ifdef ASSERT
     size_t               _blocks_filled_count;   // Number of block table fills.
@@ -598,6 +626,29 @@ inline bool ParallelCompactData::RegionData::claim()
   return old == los;
 }
 
+inline bool ParallelCompactData::RegionData::mark_normal() {
+  return Atomic::cmpxchg(NormalRegion, &_shadow_state, UnusedRegion) == UnusedRegion;
+}
+
+inline bool ParallelCompactData::RegionData::mark_shadow() {
+  if (_shadow_state != UnusedRegion) return false;
+  return Atomic::cmpxchg(ShadowRegion, &_shadow_state, UnusedRegion) == UnusedRegion;
+}
+
+inline void ParallelCompactData::RegionData::mark_filled() {
+  int old = Atomic::cmpxchg(FilledShadow, &_shadow_state, ShadowRegion);
+  assert(old == ShadowRegion, "Fail to mark the region as filled");
+}
+
+inline bool ParallelCompactData::RegionData::mark_copied() {
+  return Atomic::cmpxchg(CopiedShadow, &_shadow_state, FilledShadow) == FilledShadow;
+}
+
+inline void ParallelCompactData::RegionData::shadow_to_normal() {
+  int old = Atomic::cmpxchg(NormalRegion, &_shadow_state, ShadowRegion);
+  assert(old == ShadowRegion, "Fail to mark the region as finish");
+}
+
 inline ParallelCompactData::RegionData*
 ParallelCompactData::region(size_t region_idx) const
 {
@@ -963,7 +1014,7 @@ class PSParallelCompact : AllStatic {
 
   friend class AdjustPointerClosure;
   friend class AdjustKlassClosure;
-  friend class RefProcTaskProxy;
+  friend class PCRefProcTask;
   friend class PSParallelCompactTest;
 
  private:
@@ -1078,20 +1129,13 @@ class PSParallelCompact : AllStatic {
   static void compact_perm(ParCompactionManager* cm);
   static void compact();
 
-  // Add available regions to the stack and draining tasks to the task queue.
-  static void prepare_region_draining_tasks(GCTaskQueue* q,
-                                            uint parallel_gc_threads);
+  // Add available regions to the region stacks of the active workers.
+  static void prepare_region_draining_tasks(uint parallel_gc_threads);
 
   // Add dense prefix update tasks to the task queue.
-  static void enqueue_dense_prefix_tasks(GCTaskQueue* q,
+  static void enqueue_dense_prefix_tasks(UpdateDensePrefixTaskQueue& task_queue,
                                          uint parallel_gc_threads);
 
-  // Add region stealing tasks to the task queue.
-  static void enqueue_region_stealing_tasks(
-                                       GCTaskQueue* q,
-                                       ParallelTaskTerminator* terminator_ptr,
-                                       uint parallel_gc_threads);
-
   // If objects are left in eden after a collection, try to move the boundary
   // and absorb them into the old gen.  Returns true if eden was emptied.
   static bool absorb_live_data_from_eden(PSAdaptiveSizePolicy* size_policy,
@@ -1130,9 +1174,6 @@ class PSParallelCompact : AllStatic {
   static unsigned int total_invocations() { return _total_invocations; }
   static CollectorCounters* counters()    { return _counters; }
 
-  // Used to add tasks
-  static GCTaskManager* const gc_task_manager();
-
   // Marking support
   static inline bool mark_obj(oop obj);
   static inline bool is_marked(oop obj);
@@ -1203,10 +1244,20 @@ class PSParallelCompact : AllStatic {
                                            HeapWord* end_addr);
 
   // Fill a region, copying objects from one or more source regions.
-  static void fill_region(ParCompactionManager* cm, size_t region_idx);
-  static void fill_and_update_region(ParCompactionManager* cm, size_t region) {
-    fill_region(cm, region);
-  }
+  static void fill_region(ParCompactionManager* cm, MoveAndUpdateClosure& closure, size_t region);
+  static void fill_and_update_region(ParCompactionManager* cm, size_t region);
+
+  // Fill a region that is not yet available into a free "shadow" region, so
+  // that idle workers can help with regions blocked on their sources.  The
+  // shadow is copied back once the heap region becomes available.
+  static bool steal_unavailable_region(ParCompactionManager* cm, size_t& region_idx);
+  static void fill_and_update_shadow_region(ParCompactionManager* cm, size_t region);
+  // Copy the content of a shadow region back to its corresponding heap region
+  static void copy_back(HeapWord* shadow_addr, HeapWord* region_addr);
+  // Collect empty regions as shadow regions and initialize the
+  // _next_shadow_region field for each compact manager
+  static void initialize_shadow_regions(uint parallel_gc_threads);
+  static HeapWord* shadow_regions_begin(SpaceId id);
 
   // Fill in the block table for the specified region.
   static void fill_blocks(size_t region_idx);
@@ -1260,6 +1311,7 @@ class MoveAndUpdateClosure: public ParMarkBitMapClosure {
 
   // Accessors.
   HeapWord* destination() const         { return _destination; }
+  HeapWord* copy_destination() const    { return _destination + _offset; }
 
   // If the object will fit (size <= words_remaining()), copy it to the current
   // destination, update the interior oops and the start array and return either
@@ -1276,6 +1328,9 @@ class MoveAndUpdateClosure: public ParMarkBitMapClosure {
   // array are not updated.
   void copy_partial_obj();
 
+  virtual void complete_region(ParCompactionManager* cm, HeapWord* dest_addr,
+                               ParallelCompactData::RegionData* region_ptr);
+
  protected:
   // Update variables to indicate that word_count words were processed.
   inline void update_state(size_t word_count);
@@ -1283,6 +1338,8 @@ class MoveAndUpdateClosure: public ParMarkBitMapClosure {
  protected:
   ObjectStartArray* const _start_array;
   HeapWord*               _destination;         // Next addr to be written.
+  size_t                  _offset;              // Distance from _destination
+                                                // to where the words are copied.
 };
 
 inline
@@ -1291,7 +1348,7 @@ MoveAndUpdateClosure::MoveAndUpdateClosure(ParMarkBitMap* bitmap,
                                            ObjectStartArray* start_array,
                                            HeapWord* destination,
                                            size_t words) :
-  ParMarkBitMapClosure(bitmap, cm, words), _start_array(start_array)
+  ParMarkBitMapClosure(bitmap, cm, words), _start_array(start_array), _offset(0)
 {
   _destination = destination;
 }
@@ -1303,6 +1360,42 @@ inline void MoveAndUpdateClosure::update_state(size_t words)
   _destination += words;
 }
 
+class MoveAndUpdateShadowClosure: public MoveAndUpdateClosure {
+  inline size_t calculate_shadow_offset(size_t region_idx, size_t shadow_idx);
+ public:
+  inline MoveAndUpdateShadowClosure(ParMarkBitMap* bitmap, ParCompactionManager* cm,
+                                    ObjectStartArray* start_array,
+                                    HeapWord* destination, size_t words,
+                                    size_t region, size_t shadow);
+
+  virtual void complete_region(ParCompactionManager* cm, HeapWord* dest_addr,
+                               ParallelCompactData::RegionData* region_ptr);
+
+ private:
+  size_t _shadow;
+};
+
+inline size_t MoveAndUpdateShadowClosure::calculate_shadow_offset(size_t region_idx, size_t shadow_idx) {
+  ParallelCompactData& sd = PSParallelCompact::summary_data();
+  HeapWord* dest_addr = sd.region_to_addr(region_idx);
+  HeapWord* shadow_addr = sd.region_to_addr(shadow_idx);
+  return pointer_delta(shadow_addr, dest_addr);
+}
+
+inline
+MoveAndUpdateShadowClosure::MoveAndUpdateShadowClosure(ParMarkBitMap* bitmap,
+                                                       ParCompactionManager* cm,
+                                                       ObjectStartArray* start_array,
+                                                       HeapWord* destination,
+                                                       size_t words,
+                                                       size_t region,
+                                                       size_t shadow) :
+  MoveAndUpdateClosure(bitmap, cm, start_array, destination, words),
+  _shadow(shadow)
+{
+  _offset = calculate_shadow_offset(region, shadow);
+}
+
 class UpdateOnlyClosure: public ParMarkBitMapClosure {
  private:
   const PSParallelCompact::SpaceId _space_id;
@@ -93,6 +93,9 @@ class PSPromotionManager {
   static MutableSpace* young_space() { return _young_space; }
 
   inline static PSPromotionManager* manager_array(uint index);
+  // Index of this manager in the manager array, ParallelGCThreads for
+  // the VMThread's manager.
+  inline uint manager_index() const;
   template <class T> inline void claim_or_forward_internal_depth(T* p);
 
   // On the task queues we push reference locations as well as
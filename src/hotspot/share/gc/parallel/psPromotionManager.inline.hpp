@@ -31,6 +31,7 @@
 #include "gc/parallel/psPromotionLAB.inline.hpp"
 #include "gc/parallel/psPromotionManager.hpp"
 #include "gc/parallel/psScavenge.hpp"
+#include "gc/shared/stringDedup.hpp"
 #include "gc/shared/taskqueue.inline.hpp"
 #include "logging/log.hpp"
 #include "oops/oop.inline.hpp"
@@ -41,6 +42,15 @@ inline PSPromotionManager* PSPromotionManager::manager_array(uint index) {
   return &_manager_array[index];
 }
 
+inline uint PSPromotionManager::manager_index() const {
+  assert(_manager_array != NULL, "access of NULL manager_array");
+  const PaddedEnd<PSPromotionManager>* manager =
+    static_cast<const PaddedEnd<PSPromotionManager>*>(this);
+  assert(manager >= _manager_array && manager <= &_manager_array[ParallelGCThreads],
+         "not a promotion manager in the manager array");
+  return (uint)(manager - _manager_array);
+}
+
 template <class T>
 inline void PSPromotionManager::push_depth(T* p) {
   claimed_stack_depth()->push(p);
@@ -239,6 +249,15 @@ inline oop PSPromotionManager::copy_to_survivor_space(oop o) {
         // we'll just push its contents
         push_contents(new_obj);
       }
+
+      if (StringDedup::is_enabled()) {
+        // The queue index matches the manager index, so the VMThread's
+        // manager gets its own deduplication queue.
+        StringDedup::enqueue_from_evacuation(true /* from_young */,
+                                             !new_obj_is_tenured,
+                                             manager_index(),
+                                             new_obj);
+      }
     }  else {
       // We lost, someone else "owns" this object
       guarantee(o->is_forwarded(), "Object must be forwarded if the cas failed.");
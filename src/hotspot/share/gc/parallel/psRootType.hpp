@@ -0,0 +1,49 @@
+/*
+ * Copyright (c) 2002, 2018, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#ifndef SHARE_VM_GC_PARALLEL_PSROOTTYPE_HPP
+#define SHARE_VM_GC_PARALLEL_PSROOTTYPE_HPP
+
+#include "memory/allocation.hpp"
+
+// The strong root groups scanned by the parallel scavenge and the parallel
+// compaction marking.  Each group is claimed by a single worker through a
+// SubTasksDone; thread stacks are not listed here since they are processed
+// in parallel via Threads::possibly_parallel_threads_do().
+class ParallelRootType : public AllStatic {
+public:
+  enum Value {
+    universe,
+    jni_handles,
+    object_synchronizer,
+    management,
+    system_dictionary,
+    class_loader_data,
+    jvmti,
+    code_cache,
+    sentinel
+  };
+};
+
+#endif // SHARE_VM_GC_PARALLEL_PSROOTTYPE_HPP
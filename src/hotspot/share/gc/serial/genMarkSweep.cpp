@@ -24,7 +24,6 @@
 
 #include "precompiled.hpp"
 #include "classfile/javaClasses.hpp"
-#include "classfile/stringTable.hpp"
 #include "classfile/symbolTable.hpp"
 #include "classfile/systemDictionary.hpp"
 #include "classfile/vmSymbols.hpp"
@@ -43,6 +42,7 @@
 #include "gc/shared/referencePolicy.hpp"
 #include "gc/shared/space.hpp"
 #include "gc/shared/strongRootsScope.hpp"
+#include "gc/shared/stringDedup.hpp"
 #include "gc/shared/weakProcessor.hpp"
 #include "oops/instanceRefKlass.hpp"
 #include "oops/oop.inline.hpp"
@@ -170,8 +170,7 @@ void GenMarkSweep::deallocate_stacks() {
   GenCollectedHeap* gch = GenCollectedHeap::heap();
   gch->release_scratch();
 
-  _preserved_mark_stack.clear(true);
-  _preserved_oop_stack.clear(true);
+  _preserved_overflow_stack.clear(true);
   _marking_stack.clear();
   _objarray_stack.clear(true);
 }
@@ -222,6 +221,9 @@ void GenMarkSweep::mark_sweep_phase1(bool clear_all_softrefs) {
   {
     GCTraceTime(Debug, gc, phases) tm_m("Weak Processing", gc_timer());
     WeakProcessor::weak_oops_do(&is_alive, &do_nothing_cl);
+    if (StringDedup::is_enabled()) {
+      StringDedup::unlink(&is_alive);
+    }
   }
 
   {
@@ -237,17 +239,8 @@ void GenMarkSweep::mark_sweep_phase1(bool clear_all_softrefs) {
     Klass::clean_weak_klass_links(&is_alive);
   }
 
-  {
-    GCTraceTime(Debug, gc, phases) t("Scrub String Table", gc_timer());
-    // Delete entries for dead interned strings.
-    StringTable::unlink(&is_alive);
-  }
-
-  {
-    GCTraceTime(Debug, gc, phases) t("Scrub Symbol Table", gc_timer());
-    // Clean up unreferenced symbols in symbol table.
-    SymbolTable::unlink();
-  }
+  // Unreferenced symbols are removed concurrently by the ServiceThread.
+  SymbolTable::trigger_cleanup();
 
   gc_tracer()->report_object_count_after_gc(&is_alive);
 }
@@ -48,10 +48,24 @@ class STWGCTimer;
 // Class unloading will only occur when a full gc is invoked.
 
 // declared at end
-class PreservedMark;
 class MarkAndPushClosure;
 class AdjustPointerClosure;
 
+class PreservedMark {
+private:
+  oop _obj;
+  markOop _mark;
+
+public:
+  void init(oop obj, markOop mark) {
+    _obj = obj;
+    _mark = mark;
+  }
+
+  void adjust_pointer();
+  void restore();
+};
+
 class MarkSweep : AllStatic {
   //
   // Inline closure decls
@@ -101,8 +115,7 @@ class MarkSweep : AllStatic {
   static Stack<ObjArrayTask, mtGC>             _objarray_stack;
 
   // Space for storing/restoring mark word
-  static Stack<markOop, mtGC>                  _preserved_mark_stack;
-  static Stack<oop, mtGC>                      _preserved_oop_stack;
+  static Stack<PreservedMark, mtGC>            _preserved_overflow_stack;
   static size_t                          _preserved_count;
   static size_t                          _preserved_count_max;
   static PreservedMark*                  _preserved_marks;
@@ -200,19 +213,4 @@ class AdjustPointerClosure: public OopsInGenClosure {
   debug_only(virtual bool should_verify_oops() { return false; })
 };
 
-class PreservedMark {
-private:
-  oop _obj;
-  markOop _mark;
-
-public:
-  void init(oop obj, markOop mark) {
-    _obj = obj;
-    _mark = mark;
-  }
-
-  void adjust_pointer();
-  void restore();
-};
-
 #endif // SHARE_VM_GC_SERIAL_MARKSWEEP_HPP
@@ -30,6 +30,7 @@
 #include "gc/shared/softRefPolicy.hpp"
 #include "gc/shared/workgroup.hpp"
 #include "logging/log.hpp"
+#include "runtime/resourceLimitMonitor.hpp"
 #include "runtime/timer.hpp"
 #include "utilities/ostream.hpp"
 
@@ -142,6 +143,12 @@ uint AdaptiveSizePolicy::calc_default_active_workers(uintx total_workers,
       MAX2(min_workers, (prev_active_workers + new_active_workers) / 2);
   }
 
+  // Never use more workers than there are processors available right now,
+  // the processor count may have been lowered since startup.
+  uintx active_workers_by_processors =
+    MAX2((uintx) ResourceLimitMonitor::active_processor_count(), min_workers);
+  new_active_workers = MIN2(new_active_workers, active_workers_by_processors);
+
   // Check once more that the number of workers is within the limits.
   assert(min_workers <= total_workers, "Minimum workers not consistent with total workers");
   assert(new_active_workers >= min_workers, "Minimum workers not observed");
@@ -167,12 +174,13 @@ uint AdaptiveSizePolicy::calc_default_active_workers(uintx total_workers,
       "Jiggled active workers too much");
   }
 
-  log_trace(gc, task)("GCTaskManager::calc_default_active_workers() : "
+  log_trace(gc, task)("AdaptiveSizePolicy::calc_default_active_workers() : "
      "active_workers(): " UINTX_FORMAT "  new_active_workers: " UINTX_FORMAT "  "
      "prev_active_workers: " UINTX_FORMAT "\n"
-     " active_workers_by_JT: " UINTX_FORMAT "  active_workers_by_heap_size: " UINTX_FORMAT,
+     " active_workers_by_JT: " UINTX_FORMAT "  active_workers_by_heap_size: " UINTX_FORMAT
+     "  active_workers_by_processors: " UINTX_FORMAT,
      active_workers, new_active_workers, prev_active_workers,
-     active_workers_by_JT, active_workers_by_heap_size);
+     active_workers_by_JT, active_workers_by_heap_size, active_workers_by_processors);
   assert(new_active_workers > 0, "Always need at least 1");
   return new_active_workers;
 }
@@ -29,6 +29,7 @@
 
 #if INCLUDE_ALL_GCS
 #define FOR_EACH_CONCRETE_INCLUDE_ALL_GC_BARRIER_SET_DO(f) \
+  f(EpsilonBarrierSet)                               \
   f(G1BarrierSet)
 #else
 #define FOR_EACH_CONCRETE_INCLUDE_ALL_GC_BARRIER_SET_DO(f)
@@ -47,6 +48,11 @@
   FOR_EACH_ABSTRACT_BARRIER_SET_DO(f) \
   FOR_EACH_CONCRETE_BARRIER_SET_DO(f)
 
+// To hardwire the Access API to a single barrier set at build time, please
+// define HARDWIRED_BARRIER_SET to its name, e.g. -DHARDWIRED_BARRIER_SET=G1BarrierSet.
+// Accesses then call that barrier set's accessors directly instead of through
+// resolved function pointers, and no other collector can be selected.
+
 // To enable runtime-resolution of GC barriers on primitives, please
 // define SUPPORT_BARRIER_ON_PRIMITIVES.
 #ifdef SUPPORT_BARRIER_ON_PRIMITIVES
@@ -31,6 +31,7 @@
 #include "gc/shared/cardTableModRefBS.inline.hpp"
 
 #if INCLUDE_ALL_GCS
+#include "gc/epsilon/epsilonBarrierSet.hpp" // Epsilon support
 #include "gc/g1/g1BarrierSet.inline.hpp" // G1 support
 #endif
 
@@ -241,6 +241,51 @@ public:
   static jbyte deferred_card_val()       { return deferred_card; }
   static intptr_t clean_card_row_val()   { return clean_card_row; }
 
+  // Card table searches skipping runs of clean cards a word at a time.
+  // Most cards of a large old generation are clean, so this is much
+  // faster than testing each card.  Both take a range of card entries
+  // and test single bytes only up to the next word boundary and in the
+  // word holding the card found.
+
+  // Returns the first non-clean card in [start, end), or end if there
+  // is none.
+  static jbyte* find_first_non_clean_card(jbyte* start, jbyte* end) {
+    jbyte* cur = start;
+    while (cur < end && !is_aligned(cur, BytesPerWord)) {
+      if (*cur != clean_card) {
+        return cur;
+      }
+      cur++;
+    }
+    while (cur + BytesPerWord <= end && *(intptr_t*)cur == clean_card_row) {
+      cur += BytesPerWord;
+    }
+    while (cur < end && *cur == clean_card) {
+      cur++;
+    }
+    return cur;
+  }
+
+  // Returns the last non-clean card in [limit, last], or limit - 1 if
+  // there is none.  The result is never dereferenced in the latter case.
+  static jbyte* find_last_non_clean_card(const jbyte* limit, jbyte* last) {
+    jbyte* cur = last;
+    while (cur >= limit && !is_aligned(cur + 1, BytesPerWord)) {
+      if (*cur != clean_card) {
+        return cur;
+      }
+      cur--;
+    }
+    while (cur + 1 - BytesPerWord >= limit &&
+           *(intptr_t*)(cur + 1 - BytesPerWord) == clean_card_row) {
+      cur -= BytesPerWord;
+    }
+    while (cur >= limit && *cur == clean_card) {
+      cur--;
+    }
+    return cur;
+  }
+
   // Card marking array base (adjusted for heap low boundary)
   // This would be the 0th element of _byte_map, if the heap started at 0x0.
   // But since the heap starts at some higher address, this points to somewhere
@@ -44,13 +44,17 @@ CardTableModRefBS::CardTableModRefBS(
   const BarrierSet::FakeRtti& fake_rtti) :
   ModRefBarrierSet(fake_rtti.add_tag(BarrierSet::CardTableModRef)),
   _defer_initial_card_mark(false),
-  _card_table(card_table)
+  _card_table(card_table),
+  _young_gen_boundary(NULL),
+  _young_gen_above_boundary(false)
 {}
 
 CardTableModRefBS::CardTableModRefBS(CardTable* card_table) :
   ModRefBarrierSet(BarrierSet::FakeRtti(BarrierSet::CardTableModRef)),
   _defer_initial_card_mark(false),
-  _card_table(card_table)
+  _card_table(card_table),
+  _young_gen_boundary(NULL),
+  _young_gen_above_boundary(false)
 {}
 
 void CardTableModRefBS::initialize() {
@@ -69,6 +73,16 @@ void CardTableModRefBS::invalidate(MemRegion mr) {
   _card_table->invalidate(mr);
 }
 
+void CardTableModRefBS::set_young_gen_boundary(HeapWord* boundary, bool young_above_boundary) {
+#ifdef _LP64
+  // The compiled filter compares addresses as signed words, which is
+  // only safe while the heap lies below the sign bit.
+  assert(boundary != NULL, "must be");
+  _young_gen_boundary = boundary;
+  _young_gen_above_boundary = young_above_boundary;
+#endif
+}
+
 void CardTableModRefBS::print_on(outputStream* st) const {
   _card_table->print_on(st);
 }
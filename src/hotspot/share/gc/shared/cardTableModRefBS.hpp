@@ -52,6 +52,13 @@ class CardTableModRefBS: public ModRefBarrierSet {
   bool       _defer_initial_card_mark;
   CardTable* _card_table;
 
+  // Used in support of UseFilteredCardMark. The young generation lies
+  // entirely on one side of _young_gen_boundary, which does not move
+  // while compiled code is running; NULL if the heap cannot support
+  // filtering.
+  HeapWord*  _young_gen_boundary;
+  bool       _young_gen_above_boundary;
+
   CardTableModRefBS(CardTable* card_table, const BarrierSet::FakeRtti& fake_rtti);
 
  public:
@@ -79,6 +86,19 @@ class CardTableModRefBS: public ModRefBarrierSet {
 
   virtual void invalidate(MemRegion mr);
 
+  // UseFilteredCardMark
+  // Compiled post-barriers only need to dirty a card when a reference
+  // to a young object is stored into an old object: every other card
+  // mark is redundant for a generational, non-concurrent collector.
+  // Heaps whose young generation is delimited by a fixed address call
+  // set_young_gen_boundary() once during initialization.
+  void set_young_gen_boundary(HeapWord* boundary, bool young_above_boundary);
+  bool can_filter_card_marks() const {
+    return UseFilteredCardMark && _young_gen_boundary != NULL;
+  }
+  HeapWord* young_gen_boundary() const   { return _young_gen_boundary; }
+  bool young_gen_above_boundary() const  { return _young_gen_above_boundary; }
+
   // ReduceInitialCardMarks
   void initialize_deferred_card_mark_barriers();
 
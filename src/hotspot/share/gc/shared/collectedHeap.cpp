@@ -39,9 +39,13 @@
 #include "memory/resourceArea.hpp"
 #include "oops/instanceMirrorKlass.hpp"
 #include "oops/oop.inline.hpp"
+#include "prims/jvmtiExport.hpp"
 #include "runtime/handles.inline.hpp"
 #include "runtime/init.hpp"
+#include "runtime/java.hpp"
+#include "runtime/mutexLocker.hpp"
 #include "runtime/thread.inline.hpp"
+#include "runtime/threadHeapSampler.hpp"
 #include "runtime/threadSMR.hpp"
 #include "runtime/vmThread.hpp"
 #include "services/heapDumper.hpp"
@@ -312,6 +316,12 @@ MetaWord* CollectedHeap::satisfy_failed_metadata_allocation(ClassLoaderData* loa
 }
 
 void CollectedHeap::set_barrier_set(BarrierSet* barrier_set) {
+#ifdef HARDWIRED_BARRIER_SET
+  if (barrier_set->kind() != BarrierSet::HARDWIRED_BARRIER_SET) {
+    vm_exit_during_initialization("The selected garbage collector is not supported by this VM",
+                                  "The Access API is hardwired to " XSTR(HARDWIRED_BARRIER_SET));
+  }
+#endif
   _barrier_set = barrier_set;
   BarrierSet::set_bs(barrier_set);
 }
@@ -356,19 +366,36 @@ void CollectedHeap::check_for_valid_allocation_state() {
 #endif
 
 HeapWord* CollectedHeap::allocate_from_tlab_slow(Klass* klass, Thread* thread, size_t size) {
+  ThreadLocalAllocBuffer& tlab = thread->tlab();
+
+  // The tlab end may have been lowered to the next heap sample point, in
+  // which case the tlab may still have room for the object.
+  if (tlab.end() != tlab.allocation_end()) {
+    tlab.set_back_allocation_end();
+    HeapWord* obj = tlab.allocate(size);
+    if (obj != NULL) {
+      if (ThreadHeapSampler::enabled()) {
+        thread->heap_sampler().set_check_pending(tlab.bytes_since_last_sample_point(), true);
+      }
+      return obj;
+    }
+  }
 
   // Retain tlab and allocate object in shared space if
   // the amount free in the tlab is too large to discard.
-  if (thread->tlab().free() > thread->tlab().refill_waste_limit()) {
-    thread->tlab().record_slow_allocation(size);
+  if (tlab.free() > tlab.refill_waste_limit()) {
+    tlab.record_slow_allocation(size);
     return NULL;
   }
 
+  // Bytes allocated in the retiring tlab since its sample end was set.
+  size_t bytes_since_sample_point = tlab.bytes_since_last_sample_point();
+
   // Discard tlab and allocate a new one.
   // To minimize fragmentation, the last TLAB may be smaller than the rest.
-  size_t new_tlab_size = thread->tlab().compute_size(size);
+  size_t new_tlab_size = tlab.compute_size(size);
 
-  thread->tlab().clear_before_allocation();
+  tlab.clear_before_allocation();
 
   if (new_tlab_size == 0) {
     return NULL;
@@ -395,7 +422,42 @@ HeapWord* CollectedHeap::allocate_from_tlab_slow(Klass* klass, Thread* thread, s
     Copy::fill_to_words(obj + hdr_size, new_tlab_size - hdr_size, badHeapWordVal);
 #endif // ASSERT
   }
-  thread->tlab().fill(obj, obj + size, new_tlab_size);
+  tlab.fill(obj, obj + size, new_tlab_size);
+  if (ThreadHeapSampler::enabled()) {
+    thread->heap_sampler().set_check_pending(bytes_since_sample_point, true);
+  }
+  return obj;
+}
+
+// Agents are only called back from Java threads in the VM that do not hold
+// locks the callback could need.
+static bool is_safe_to_post_sampled_object_alloc(Thread* thread) {
+  if (!thread->is_Java_thread() || thread->is_Compiler_thread()) {
+    return false;
+  }
+  if (((JavaThread*)thread)->thread_state() != _thread_in_vm) {
+    return false;
+  }
+  return Compile_lock->owner() != thread && MultiArray_lock->owner() != thread;
+}
+
+oop CollectedHeap::sample_allocation_slow(Thread* thread, oop obj, size_t size) {
+  ThreadHeapSampler& sampler = thread->heap_sampler();
+  bool update_tlab = sampler.update_tlab();
+  bool sample = sampler.check_for_sampling(size * HeapWordSize);
+  if (update_tlab) {
+    thread->tlab().set_sample_end();
+  }
+
+  // Mirrors are reported through ClassLoad and are not set up yet.
+  if (sample &&
+      JvmtiExport::should_post_sampled_object_alloc() &&
+      obj->klass() != SystemDictionary::Class_klass() &&
+      is_safe_to_post_sampled_object_alloc(thread)) {
+    Handle h(thread, obj);
+    JvmtiExport::post_sampled_object_alloc((JavaThread*)thread, obj);
+    return h();
+  }
   return obj;
 }
 
@@ -67,6 +67,14 @@ class GCMessage : public FormatBuffer<1024> {
 
 class CollectedHeap;
 
+// Iterates the objects of the heap from several worker threads. Each
+// worker passes its id, the heap hands out disjoint parts of the heap.
+class ParallelObjectIterator : public CHeapObj<mtGC> {
+public:
+  virtual void object_iterate(ObjectClosure* cl, uint worker_id) = 0;
+  virtual ~ParallelObjectIterator() {}
+};
+
 class GCHeapLog : public EventLogBase<GCMessage> {
  private:
   void log_heap(CollectedHeap* heap, bool before);
@@ -89,6 +97,7 @@ class GCHeapLog : public EventLogBase<GCMessage> {
 //     CMSHeap
 //   G1CollectedHeap
 //   ParallelScavengeHeap
+//   EpsilonHeap
 //
 class CollectedHeap : public CHeapObj<mtInternal> {
   friend class VMStructs;
@@ -147,6 +156,13 @@ class CollectedHeap : public CHeapObj<mtInternal> {
   // is guaranteed initialized to zeros.
   inline static HeapWord* common_mem_allocate_init(Klass* klass, size_t size, TRAPS);
 
+  // Account an allocation that took a slow path to the thread's heap
+  // sampler, and post a JVMTI SampledObjectAlloc event if it reached the
+  // sample point. Posting may safepoint, so the possibly moved object is
+  // returned.
+  inline static oop sample_allocation(Thread* thread, oop obj, size_t size);
+  static oop sample_allocation_slow(Thread* thread, oop obj, size_t size);
+
   // Helper functions for (VM) allocation.
   inline static void post_allocation_setup_common(Klass* klass, HeapWord* obj);
   inline static void post_allocation_setup_no_klass_install(Klass* klass,
@@ -190,7 +206,8 @@ class CollectedHeap : public CHeapObj<mtInternal> {
     SerialHeap,
     ParallelScavengeHeap,
     G1CollectedHeap,
-    CMSHeap
+    CMSHeap,
+    EpsilonHeap
   };
 
   static inline size_t filler_array_max_size() {
@@ -456,6 +473,13 @@ class CollectedHeap : public CHeapObj<mtInternal> {
   // over live objects.
   virtual void safe_object_iterate(ObjectClosure* cl) = 0;
 
+  // Returns an iterator which lets thread_num workers iterate over all
+  // objects in parallel at a safepoint, or NULL if the heap does not
+  // support this. The caller deletes the iterator.
+  virtual ParallelObjectIterator* parallel_object_iterator(uint thread_num) {
+    return NULL;
+  }
+
   // NOTE! There is no requirement that a collector implement these
   // functions.
   //
@@ -547,6 +571,14 @@ class CollectedHeap : public CHeapObj<mtInternal> {
   virtual void unregister_nmethod(nmethod* nm) {}
   virtual void verify_nmethod(nmethod* nmethod) {}
 
+  // Pin the given object for the duration of a JNI critical region, so
+  // that collections may proceed without moving it. Returns false if the
+  // heap cannot pin this object, in which case the caller has to lock out
+  // collections with the GCLocker instead.
+  virtual bool pin_object(JavaThread* thread, oop obj) { return false; }
+  // Undo pin_object(). Returns false if obj could not have been pinned.
+  virtual bool unpin_object(JavaThread* thread, oop obj) { return false; }
+
   void trace_heap_before_gc(const GCTracer* gc_tracer);
   void trace_heap_after_gc(const GCTracer* gc_tracer);
 
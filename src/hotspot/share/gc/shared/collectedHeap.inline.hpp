@@ -35,6 +35,7 @@
 #include "prims/jvmtiExport.hpp"
 #include "runtime/sharedRuntime.hpp"
 #include "runtime/thread.inline.hpp"
+#include "runtime/threadHeapSampler.hpp"
 #include "services/lowMemoryDetector.hpp"
 #include "utilities/align.hpp"
 #include "utilities/copy.hpp"
@@ -158,6 +159,10 @@ HeapWord* CollectedHeap::common_mem_allocate_noinit(Klass* klass, size_t size, T
 
     AllocTracer::send_allocation_outside_tlab(klass, result, size * HeapWordSize, THREAD);
 
+    if (ThreadHeapSampler::enabled()) {
+      THREAD->heap_sampler().set_check_pending(0, false);
+    }
+
     return result;
   }
 
@@ -193,6 +198,13 @@ HeapWord* CollectedHeap::common_mem_allocate_init(Klass* klass, size_t size, TRA
   return obj;
 }
 
+oop CollectedHeap::sample_allocation(Thread* thread, oop obj, size_t size) {
+  if (!thread->heap_sampler().check_pending()) {
+    return obj;
+  }
+  return sample_allocation_slow(thread, obj, size);
+}
+
 HeapWord* CollectedHeap::allocate_from_tlab(Klass* klass, Thread* thread, size_t size) {
   assert(UseTLAB, "should use UseTLAB");
 
@@ -219,7 +231,7 @@ oop CollectedHeap::obj_allocate(Klass* klass, int size, TRAPS) {
   HeapWord* obj = common_mem_allocate_init(klass, size, CHECK_NULL);
   post_allocation_setup_obj(klass, obj, size);
   NOT_PRODUCT(Universe::heap()->check_for_bad_heap_word_value(obj, size));
-  return (oop)obj;
+  return sample_allocation(THREAD, (oop)obj, size);
 }
 
 oop CollectedHeap::class_allocate(Klass* klass, int size, TRAPS) {
@@ -229,7 +241,7 @@ oop CollectedHeap::class_allocate(Klass* klass, int size, TRAPS) {
   HeapWord* obj = common_mem_allocate_init(klass, size, CHECK_NULL);
   post_allocation_setup_class(klass, obj, size); // set oop_size
   NOT_PRODUCT(Universe::heap()->check_for_bad_heap_word_value(obj, size));
-  return (oop)obj;
+  return sample_allocation(THREAD, (oop)obj, size);
 }
 
 oop CollectedHeap::array_allocate(Klass* klass,
@@ -242,7 +254,7 @@ oop CollectedHeap::array_allocate(Klass* klass,
   HeapWord* obj = common_mem_allocate_init(klass, size, CHECK_NULL);
   post_allocation_setup_array(klass, obj, length);
   NOT_PRODUCT(Universe::heap()->check_for_bad_heap_word_value(obj, size));
-  return (oop)obj;
+  return sample_allocation(THREAD, (oop)obj, size);
 }
 
 oop CollectedHeap::array_allocate_nozero(Klass* klass,
@@ -259,7 +271,7 @@ oop CollectedHeap::array_allocate_nozero(Klass* klass,
   const size_t hs = oopDesc::header_size()+1;
   Universe::heap()->check_for_non_bad_heap_word_value(obj+hs, size-hs);
 #endif
-  return (oop)obj;
+  return sample_allocation(THREAD, (oop)obj, size);
 }
 
 inline HeapWord* CollectedHeap::align_allocation_or_fail(HeapWord* addr,
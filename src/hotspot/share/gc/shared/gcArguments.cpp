@@ -36,6 +36,7 @@
 #include "utilities/macros.hpp"
 
 #if INCLUDE_ALL_GCS
+#include "gc/epsilon/epsilonArguments.hpp"
 #include "gc/parallel/parallelArguments.hpp"
 #include "gc/cms/cmsArguments.hpp"
 #include "gc/g1/g1Arguments.hpp"
@@ -54,7 +55,7 @@ bool GCArguments::is_initialized() {
 
 bool GCArguments::gc_selected() {
 #if INCLUDE_ALL_GCS
-  return UseSerialGC || UseParallelGC || UseParallelOldGC || UseConcMarkSweepGC || UseG1GC;
+  return UseSerialGC || UseParallelGC || UseParallelOldGC || UseConcMarkSweepGC || UseG1GC || UseEpsilonGC;
 #else
   return UseSerialGC;
 #endif // INCLUDE_ALL_GCS
@@ -81,6 +82,7 @@ void GCArguments::select_gc_ergonomically() {
   UNSUPPORTED_OPTION(UseParallelGC);
   UNSUPPORTED_OPTION(UseParallelOldGC);
   UNSUPPORTED_OPTION(UseConcMarkSweepGC);
+  UNSUPPORTED_OPTION(UseEpsilonGC);
   FLAG_SET_ERGO_IF_DEFAULT(bool, UseSerialGC, true);
 #endif // INCLUDE_ALL_GCS
 }
@@ -104,6 +106,23 @@ void GCArguments::initialize_flags() {
     FLAG_SET_CMDLINE(bool, ClassUnloadingWithConcurrentMark, false);
   }
 #endif // INCLUDE_ALL_GCS
+
+#ifdef COMPILER2
+  // Enable loop strip mining to offer better pause time guarantees: long
+  // counted loops poll for a safepoint once every LoopStripMiningIter
+  // iterations instead of never, or of in every iteration.
+  if (FLAG_IS_DEFAULT(UseCountedLoopSafepoints)) {
+    FLAG_SET_DEFAULT(UseCountedLoopSafepoints, true);
+    if (FLAG_IS_DEFAULT(LoopStripMiningIter)) {
+      FLAG_SET_DEFAULT(LoopStripMiningIter, loop_strip_mining_iter());
+      if (FLAG_IS_DEFAULT(LoopStripMiningIterShortLoop)) {
+        // Derived by check_vm_args_consistency() before the collector
+        // chose LoopStripMiningIter.
+        FLAG_SET_DEFAULT(LoopStripMiningIterShortLoop, LoopStripMiningIter / 10);
+      }
+    }
+  }
+#endif
 }
 
 void GCArguments::post_heap_initialize() {
@@ -139,6 +158,9 @@ jint GCArguments::initialize() {
   } else if (UseConcMarkSweepGC) {
     jio_fprintf(defaultStream::error_stream(), "UseConcMarkSweepGC not supported in this VM.\n");
     return JNI_ERR;
+  } else if (UseEpsilonGC) {
+    jio_fprintf(defaultStream::error_stream(), "UseEpsilonGC not supported in this VM.\n");
+    return JNI_ERR;
 #else
   if (UseParallelGC || UseParallelOldGC) {
     _instance = new ParallelArguments();
@@ -146,6 +168,8 @@ jint GCArguments::initialize() {
     _instance = new G1Arguments();
   } else if (UseConcMarkSweepGC) {
     _instance = new CMSArguments();
+  } else if (UseEpsilonGC) {
+    _instance = new EpsilonArguments();
 #endif
   } else if (UseSerialGC) {
     _instance = new SerialArguments();
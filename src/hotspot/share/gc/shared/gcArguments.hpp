@@ -50,6 +50,10 @@ public:
 
   virtual void initialize_flags();
 
+  // Number of iterations between safepoint polls in strip mined counted
+  // loops, see LoopStripMiningIter.
+  virtual uintx loop_strip_mining_iter() { return 1000; }
+
   // Collector specific function to allow finer grained verification
   // through VerifyGCType. If not overridden the default version will
   // warn that the flag is not supported for the given collector.
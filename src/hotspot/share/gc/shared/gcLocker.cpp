@@ -28,12 +28,16 @@
 #include "memory/resourceArea.hpp"
 #include "logging/log.hpp"
 #include "runtime/atomic.hpp"
+#include "runtime/os.hpp"
 #include "runtime/thread.inline.hpp"
 #include "runtime/threadSMR.hpp"
 
 volatile jint GCLocker::_jni_lock_count = 0;
 volatile bool GCLocker::_needs_gc       = false;
 volatile bool GCLocker::_doing_gc       = false;
+jlong         GCLocker::_needs_gc_start = 0;
+uint          GCLocker::_delayed_gc_count = 0;
+jlong         GCLocker::_total_gc_delay = 0;
 
 #ifdef ASSERT
 volatile jint GCLocker::_debug_jni_lock_count = 0;
@@ -90,6 +94,7 @@ bool GCLocker::check_active_before_gc() {
   if (is_active() && !_needs_gc) {
     verify_critical_count();
     _needs_gc = true;
+    _needs_gc_start = os::javaTimeNanos();
     log_debug_jni("Setting _needs_gc.");
   }
   return is_active();
@@ -140,6 +145,11 @@ void GCLocker::jni_unlock(JavaThread* thread) {
       log_debug_jni("Performing GC after exiting critical section.");
       Universe::heap()->collect(GCCause::_gc_locker);
     }
+    jlong delay = os::javaTimeNanos() - _needs_gc_start;
+    _delayed_gc_count++;
+    _total_gc_delay += delay;
+    log_info(gc, jni)("GC delayed by JNI critical regions for %.3fms",
+                      (double)delay / NANOSECS_PER_MILLISEC);
     _doing_gc = false;
     _needs_gc = false;
     JNICritical_lock->notify_all();
@@ -45,6 +45,11 @@ class GCLocker: public AllStatic {
                                          // note: bool is typedef'd as jint
   static volatile bool _doing_gc;        // unlock_critical() is doing a GC
 
+  // Collections held off until the last thread left its critical region.
+  static jlong _needs_gc_start;          // time _needs_gc was set, in ns
+  static uint  _delayed_gc_count;        // # of delayed collections
+  static jlong _total_gc_delay;          // total delay, in ns
+
 #ifdef ASSERT
   // This lock count is updated for all operations and is used to
   // validate the jni_lock_count that is computed during safepoints.
@@ -73,6 +78,11 @@ class GCLocker: public AllStatic {
   }
   static bool needs_gc()       { return _needs_gc;                        }
 
+  // Collections delayed by JNI critical regions and the total time they
+  // were delayed.
+  static uint delayed_gc_count()   { return _delayed_gc_count; }
+  static double total_gc_delay_ms() { return (double)_total_gc_delay / NANOSECS_PER_MILLISEC; }
+
   // Shorthand
   static bool is_active_and_needs_gc() {
     // Use is_active_internal since _needs_gc can change from true to
@@ -45,6 +45,7 @@
 #include "gc/shared/generationSpec.hpp"
 #include "gc/shared/space.hpp"
 #include "gc/shared/strongRootsScope.hpp"
+#include "gc/shared/stringDedup.hpp"
 #include "gc/shared/vmGCOperations.hpp"
 #include "gc/shared/weakProcessor.hpp"
 #include "gc/shared/workgroup.hpp"
@@ -120,6 +121,11 @@ jint GenCollectedHeap::initialize() {
   _young_gen = _young_gen_spec->init(young_rs, rem_set());
   heap_rs = heap_rs.last_part(_young_gen_spec->max_size());
 
+  if (!UseConcMarkSweepGC) {
+    // CMS needs every card mark for concurrent marking and precleaning.
+    bs->set_young_gen_boundary((HeapWord*)heap_rs.base(), false);
+  }
+
   ReservedSpace old_rs = heap_rs.first_part(_old_gen_spec->max_size(), false, false);
   _old_gen = _old_gen_spec->init(old_rs, rem_set());
   clear_incremental_collection_failed();
@@ -847,11 +853,8 @@ void GenCollectedHeap::process_roots(StrongRootsScope* scope,
 void GenCollectedHeap::process_string_table_roots(StrongRootsScope* scope,
                                                   OopClosure* root_closure) {
   assert(root_closure != NULL, "Must be set");
-  // All threads execute the following. A specific chunk of buckets
-  // from the StringTable are the individual tasks.
-  if (scope->n_threads() > 1) {
-    StringTable::possibly_parallel_oops_do(root_closure);
-  } else {
+  // The StringTable weak storage can only be iterated serially.
+  if (!_process_strong_tasks->is_task_claimed(GCH_PS_StringTable_oops_do)) {
     StringTable::oops_do(root_closure);
   }
 }
@@ -864,7 +867,6 @@ void GenCollectedHeap::young_process_roots(StrongRootsScope* scope,
 
   process_roots(scope, SO_ScavengeCodeCache, root_closure, root_closure,
                 cld_closure, cld_closure, &mark_code_closure);
-  process_string_table_roots(scope, root_closure);
 
   if (!_process_strong_tasks->is_task_claimed(GCH_PS_younger_gens)) {
     root_closure->reset_generation();
@@ -890,18 +892,17 @@ void GenCollectedHeap::full_process_roots(StrongRootsScope* scope,
   CLDClosure* weak_cld_closure = only_strong_roots ? NULL : cld_closure;
 
   process_roots(scope, so, root_closure, weak_roots, cld_closure, weak_cld_closure, &mark_code_closure);
-  if (is_adjust_phase) {
-    // We never treat the string table as roots during marking
-    // for the full gc, so we only need to process it during
-    // the adjust phase.
-    process_string_table_roots(scope, root_closure);
-  }
+  // The string table is never treated as roots during marking for
+  // the full gc, and it is adjusted by gen_process_weak_roots().
 
   _process_strong_tasks->all_tasks_completed(scope->n_threads());
 }
 
 void GenCollectedHeap::gen_process_weak_roots(OopClosure* root_closure) {
   WeakProcessor::oops_do(root_closure);
+  if (StringDedup::is_enabled()) {
+    StringDedup::oops_do(root_closure);
+  }
   _young_gen->ref_processor()->weak_oops_do(root_closure);
   _old_gen->ref_processor()->weak_oops_do(root_closure);
 }
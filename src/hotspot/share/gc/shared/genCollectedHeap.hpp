@@ -112,6 +112,7 @@ protected:
     GCH_PS_FlatProfiler_oops_do,
     GCH_PS_Management_oops_do,
     GCH_PS_SystemDictionary_oops_do,
+    GCH_PS_StringTable_oops_do,
     GCH_PS_ClassLoaderDataGraph_oops_do,
     GCH_PS_jvmti_oops_do,
     GCH_PS_CodeCache_oops_do,
@@ -189,6 +190,10 @@ public:
 
   virtual CollectorPolicy* collector_policy() const { return gen_policy(); }
 
+  // The work gang used to pre-touch the initially committed generations,
+  // or NULL if they are pre-touched by the initializing thread.
+  virtual WorkGang* pretouch_workers() const { return NULL; }
+
   virtual SoftRefPolicy* soft_ref_policy() { return &_soft_ref_gen_policy; }
 
   // Adaptive size policy
@@ -34,6 +34,7 @@
 #include "gc/shared/genOopClosures.hpp"
 #include "gc/shared/genOopClosures.inline.hpp"
 #include "gc/shared/generation.hpp"
+#include "gc/shared/pretouchTask.hpp"
 #include "gc/shared/space.inline.hpp"
 #include "gc/shared/spaceDecorator.hpp"
 #include "logging/log.hpp"
@@ -46,10 +47,20 @@
 Generation::Generation(ReservedSpace rs, size_t initial_size) :
   _ref_processor(NULL),
   _gc_manager(NULL) {
-  if (!_virtual_space.initialize(rs, initial_size)) {
+  bool success;
+  {
+    // Defer pre-touching so that it can be spread over the heap's workers.
+    FlagSetting fs(AlwaysPreTouch, false);
+    success = _virtual_space.initialize(rs, initial_size);
+  }
+  if (!success) {
     vm_exit_during_initialization("Could not reserve enough space for "
                     "object heap");
   }
+  if (AlwaysPreTouch) {
+    PretouchTask::pretouch("GC PreTouch", _virtual_space.low(), _virtual_space.high(),
+                           os::vm_page_size(), GenCollectedHeap::heap()->pretouch_workers());
+  }
   // Mangle all of the the initial generation.
   if (ZapUnusedHeapArea) {
     MemRegion mangle_region((HeapWord*)_virtual_space.low(),
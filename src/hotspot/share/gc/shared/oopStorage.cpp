@@ -237,7 +237,7 @@ OopStorage::Block* OopStorage::Block::new_block(const OopStorage* owner) {
   // _data must be first member: aligning block => aligning _data.
   STATIC_ASSERT(_data_pos == 0);
   size_t size_needed = allocation_size();
-  void* memory = NEW_C_HEAP_ARRAY_RETURN_NULL(char, size_needed, mtGC);
+  void* memory = NEW_C_HEAP_ARRAY_RETURN_NULL(char, size_needed, mtOopStorage);
   if (memory == NULL) {
     return NULL;
   }
@@ -328,6 +328,9 @@ OopStorage::Block::block_for_ptr(const OopStorage* owner, const oop* ptr) {
 // is empty, for ease of empty block deletion processing.
 
 oop* OopStorage::allocate() {
+  // Pass on any cleanup requests recorded by release().  Done before
+  // locking _allocate_mutex, to keep Service_lock out of its scope.
+  trigger_cleanup_if_needed();
   MutexLockerEx ml(_allocate_mutex, Mutex::_no_safepoint_check_flag);
   // Do some deferred update processing every time we allocate.
   // Continue processing deferred updates if _allocate_list is empty,
@@ -412,7 +415,8 @@ static void log_release_transitions(uintx releasing,
   }
 }
 
-void OopStorage::Block::release_entries(uintx releasing, Block* volatile* deferred_list) {
+// Returns true if the release transitioned the block to empty.
+bool OopStorage::Block::release_entries(uintx releasing, Block* volatile* deferred_list) {
   assert(releasing != 0, "preconditon");
   // Prevent empty block deletion when transitioning to empty.
   Atomic::inc(&_release_refcount);
@@ -458,6 +462,7 @@ void OopStorage::Block::release_entries(uintx releasing, Block* volatile* deferr
   }
   // Release hold on empty block deletion.
   Atomic::dec(&_release_refcount);
+  return releasing == old_allocated;
 }
 
 // Process one available deferred update.  Returns true if one was processed.
@@ -517,7 +522,9 @@ void OopStorage::release(const oop* ptr) {
   Block* block = find_block_or_null(ptr);
   assert(block != NULL, "%s: invalid release " PTR_FORMAT, name(), p2i(ptr));
   log_info(oopstorage, ref)("%s: released " PTR_FORMAT, name(), p2i(ptr));
-  block->release_entries(block->bitmask_for_entry(ptr), &_deferred_updates);
+  if (block->release_entries(block->bitmask_for_entry(ptr), &_deferred_updates)) {
+    record_needs_cleanup();
+  }
   Atomic::dec(&_allocation_count);
 }
 
@@ -544,13 +551,15 @@ void OopStorage::release(const oop* const* ptrs, size_t size) {
       ++count;
     }
     // Release the contiguous entries that are in block.
-    block->release_entries(releasing, &_deferred_updates);
+    if (block->release_entries(releasing, &_deferred_updates)) {
+      record_needs_cleanup();
+    }
     Atomic::sub(count, &_allocation_count);
   }
 }
 
 const char* dup_name(const char* name) {
-  char* dup = NEW_C_HEAP_ARRAY(char, strlen(name) + 1, mtGC);
+  char* dup = NEW_C_HEAP_ARRAY(char, strlen(name) + 1, mtOopStorage);
   strcpy(dup, name);
   return dup;
 }
@@ -567,7 +576,8 @@ OopStorage::OopStorage(const char* name,
   _active_mutex(active_mutex),
   _allocation_count(0),
   _block_count(0),
-  _concurrent_iteration_active(false)
+  _concurrent_iteration_active(false),
+  _needs_cleanup(false)
 {
   assert(_active_mutex->rank() < _allocate_mutex->rank(),
          "%s: active_mutex must have lower rank than allocate_mutex", _name);
@@ -619,7 +629,7 @@ void OopStorage::delete_empty_blocks_safepoint() {
   _active_head = _active_list.head();
 }
 
-void OopStorage::delete_empty_blocks_concurrent() {
+bool OopStorage::delete_empty_blocks_concurrent() {
   MutexLockerEx ml(_allocate_mutex, Mutex::_no_safepoint_check_flag);
   // Other threads could be adding to the empty block count while we
   // release the mutex across the block deletions.  Set an upper bound
@@ -637,13 +647,13 @@ void OopStorage::delete_empty_blocks_concurrent() {
       // No block to delete, so done.  There could be more pending
       // deferred updates that could give us more work to do; deal with
       // that in some later call, to limit lock duration here.
-      return;
+      return true;
     }
 
     {
       MutexLockerEx aml(_active_mutex, Mutex::_no_safepoint_check_flag);
       // Don't interfere with a concurrent iteration.
-      if (_concurrent_iteration_active) return;
+      if (_concurrent_iteration_active) return false;
       // Remove block from _active_list, updating head if needed.
       _active_list.unlink(*block);
       --_block_count;
@@ -657,6 +667,63 @@ void OopStorage::delete_empty_blocks_concurrent() {
     MutexUnlockerEx ul(_allocate_mutex, Mutex::_no_safepoint_check_flag);
     delete_empty_block(*block);
   }
+  // Reached the limit; there may be more deletable blocks.
+  return false;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// Asynchronous cleanup
+//
+// Empty blocks are not deleted by release(), which must remain lock-free.
+// Instead, release() records in _needs_cleanup that the storage has an
+// empty block, and sets the shared _cleanup_requested flag.  Because
+// release() can't lock Service_lock either, the ServiceThread is notified
+// later, by trigger_cleanup_if_needed(), from allocate() and from the
+// safepoint cleanup tasks.  The ServiceThread then deletes the empty
+// blocks of each storage with a pending request, concurrently with
+// allocations and releases by other threads.  If a concurrent iteration
+// (or the deletion limit) stops the cleanup early the request is
+// re-recorded, so the remaining blocks are picked up by a later round.
+
+volatile bool OopStorage::_cleanup_requested = false;
+bool OopStorage::_has_cleanup_work = false;
+
+void OopStorage::record_needs_cleanup() {
+  // Set the storage's flag before the shared request, so the ServiceThread
+  // can't be notified and then miss this storage.
+  OrderAccess::release_store(&_needs_cleanup, true);
+  OrderAccess::release_store_fence(&_cleanup_requested, true);
+}
+
+void OopStorage::trigger_cleanup_if_needed() {
+  if (OrderAccess::load_acquire(&_cleanup_requested) &&
+      Atomic::cmpxchg(false, &_cleanup_requested, true)) {
+    MonitorLockerEx ml(Service_lock, Monitor::_no_safepoint_check_flag);
+    _has_cleanup_work = true;
+    ml.notify_all();
+  }
+}
+
+bool OopStorage::has_cleanup_work_and_reset() {
+  assert_lock_strong(Service_lock);
+  bool result = _has_cleanup_work;
+  _has_cleanup_work = false;
+  return result;
+}
+
+void OopStorage::delete_empty_blocks() {
+  // Claim the request; a release() emptying another block after this
+  // point records a new one.
+  if (!OrderAccess::load_acquire(&_needs_cleanup) ||
+      !Atomic::cmpxchg(false, &_needs_cleanup, true)) {
+    return;
+  }
+  if (!delete_empty_blocks_concurrent()) {
+    log_debug(oopstorage, blocks)("%s: cleanup incomplete, %s", name(),
+                                  _concurrent_iteration_active ?
+                                  "concurrent iteration active" : "limit reached");
+    record_needs_cleanup();
+  }
 }
 
 OopStorage::EntryStatus OopStorage::allocation_status(const oop* ptr) const {
@@ -715,9 +782,15 @@ OopStorage::BasicParState::~BasicParState() {
 
 void OopStorage::BasicParState::update_iteration_state(bool value) {
   if (_concurrent) {
-    MutexLockerEx ml(_storage->_active_mutex, Mutex::_no_safepoint_check_flag);
-    assert(_storage->_concurrent_iteration_active != value, "precondition");
-    _storage->_concurrent_iteration_active = value;
+    {
+      MutexLockerEx ml(_storage->_active_mutex, Mutex::_no_safepoint_check_flag);
+      assert(_storage->_concurrent_iteration_active != value, "precondition");
+      _storage->_concurrent_iteration_active = value;
+    }
+    // Cleanup requests deferred by the iteration can now be serviced.
+    if (!value) {
+      trigger_cleanup_if_needed();
+    }
   }
 }
 
@@ -71,7 +71,7 @@ class outputStream;
 // interactions for this protocol.  Similarly, see the allocate() function for
 // a discussion of allocation.
 
-class OopStorage : public CHeapObj<mtGC> {
+class OopStorage : public CHeapObj<mtOopStorage> {
 public:
   OopStorage(const char* name, Mutex* allocate_mutex, Mutex* active_mutex);
   ~OopStorage();
@@ -152,11 +152,31 @@ public:
   template<bool concurrent, bool is_const> class ParState;
 #endif // INCLUDE_ALL_GCS
 
-  // Block cleanup functions are for the exclusive use of the GC.
-  // Both stop deleting if there is an in-progress concurrent iteration.
-  // Concurrent deletion locks both the allocate_mutex and the active_mutex.
+  // Block cleanup functions are for the exclusive use of the GC and the
+  // ServiceThread.  Both stop deleting if there is an in-progress concurrent
+  // iteration.  Concurrent deletion locks both the allocate_mutex and the
+  // active_mutex, and returns false if it stopped with deletable blocks
+  // possibly remaining.
   void delete_empty_blocks_safepoint();
-  void delete_empty_blocks_concurrent();
+  bool delete_empty_blocks_concurrent();
+
+  // Asynchronous cleanup support.  When a release() empties a block the
+  // storage records, without locking, that it needs cleanup.  The request
+  // is passed on to the ServiceThread by trigger_cleanup_if_needed(), which
+  // is called by allocate() and during safepoint cleanup.  The ServiceThread
+  // then calls delete_empty_blocks() on each of the VM's storage objects.
+
+  // Deletes empty blocks if cleanup has been requested for this storage.
+  // Locks _allocate_mutex and _active_mutex.
+  void delete_empty_blocks();
+
+  // Notifies the ServiceThread if any storage has requested cleanup since
+  // the last notification.  Locks Service_lock.
+  static void trigger_cleanup_if_needed();
+
+  // Returns true if the ServiceThread has been notified of cleanup work,
+  // clearing the notification.  Caller must hold Service_lock.
+  static bool has_cleanup_work_and_reset();
 
   // Debugging and logging support.
   const char* name() const;
@@ -236,10 +256,18 @@ private:
   volatile size_t _block_count;
   // mutable because this gets set even for const iteration.
   mutable bool _concurrent_iteration_active;
+  // Set by release() when a block becomes empty, cleared by cleanup.
+  volatile bool _needs_cleanup;
+
+  // Pending request to notify the ServiceThread, and the notification
+  // itself.  Shared by all storage objects.
+  static volatile bool _cleanup_requested;
+  static bool _has_cleanup_work;
 
   Block* find_block_or_null(const oop* ptr) const;
   void delete_empty_block(const Block& block);
   bool reduce_deferred_updates();
+  void record_needs_cleanup();
 
   template<typename F, typename Storage>
   static bool iterate_impl(F f, Storage* storage);
@@ -91,7 +91,7 @@ public:
   static Block* new_block(const OopStorage* owner);
   static void delete_block(const Block& block);
 
-  void release_entries(uintx releasing, Block* volatile* deferred_list);
+  bool release_entries(uintx releasing, Block* volatile* deferred_list);
 
   template<typename F> bool iterate(F f);
   template<typename F> bool iterate(F f) const;
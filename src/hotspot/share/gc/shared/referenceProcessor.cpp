@@ -98,11 +98,13 @@ ReferenceProcessor::ReferenceProcessor(MemRegion span,
                                        bool      mt_discovery,
                                        uint      mt_discovery_degree,
                                        bool      atomic_discovery,
-                                       BoolObjectClosure* is_alive_non_header)  :
+                                       BoolObjectClosure* is_alive_non_header,
+                                       bool      adjust_no_of_processing_threads)  :
   _discovering_refs(false),
   _enqueuing_is_done(false),
   _is_alive_non_header(is_alive_non_header),
   _processing_is_mt(mt_processing),
+  _adjust_no_of_processing_threads(adjust_no_of_processing_threads),
   _next_id(0)
 {
   _span = span;
@@ -350,6 +352,7 @@ void ReferenceProcessor::enqueue_discovered_reflists(AbstractRefProcTaskExecutor
 
   if (_processing_is_mt && task_executor != NULL) {
     // Parallel code
+    phase_times->set_par_phase_workers(ReferenceProcessorPhaseTimes::RefEnqueue, _num_q);
     RefProcEnqueueTask tsk(*this, _discovered_refs, _max_num_q, phase_times);
     task_executor->execute(tsk);
   } else {
@@ -773,6 +776,61 @@ void ReferenceProcessor::balance_queues(DiscoveredList ref_lists[])
 #endif
 }
 
+bool ReferenceProcessor::need_balance_queues(DiscoveredList refs_lists[]) {
+  assert(_processing_is_mt, "why balance non-mt processing?");
+  // _num_q is the number of queues that will be processed; references
+  // on any other queue would be skipped.
+  for (uint i = _num_q; i < _max_num_q; ++i) {
+    if (!refs_lists[i].is_empty()) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void ReferenceProcessor::maybe_balance_queues(DiscoveredList refs_lists[],
+                                              ReferenceProcessorPhaseTimes* phase_times) {
+  assert(_processing_is_mt, "Should not call this otherwise");
+  if (ParallelRefProcBalancingEnabled || need_balance_queues(refs_lists)) {
+    RefProcBalanceQueuesTimeTracker tt(phase_times);
+    balance_queues(refs_lists);
+  }
+}
+
+uint ReferenceProcessor::ergo_proc_thread_count(size_t ref_count, uint max_threads) const {
+  assert(0 < max_threads, "must allow at least one thread");
+
+  if (ReferencesPerThread == 0) {
+    return max_threads;
+  }
+
+  size_t thread_count = 1 + (ref_count / ReferencesPerThread);
+  return (uint)MIN3(thread_count,
+                    static_cast<size_t>(max_threads),
+                    (size_t)os::active_processor_count());
+}
+
+RefProcMTDegreeAdjuster::RefProcMTDegreeAdjuster(ReferenceProcessor* rp,
+                                                 size_t ref_count) :
+  _rp(rp),
+  _saved_mt_processing(rp->processing_is_mt()),
+  _saved_num_q(rp->num_q()) {
+  if (!_rp->processing_is_mt() || !_rp->adjust_no_of_processing_threads()) {
+    return;
+  }
+
+  uint workers = _rp->ergo_proc_thread_count(ref_count, _rp->num_q());
+
+  _rp->set_mt_processing(workers > 1);
+  _rp->set_active_mt_degree(workers);
+}
+
+RefProcMTDegreeAdjuster::~RefProcMTDegreeAdjuster() {
+  // Revert to previous status.
+  _rp->set_mt_processing(_saved_mt_processing);
+  _rp->set_active_mt_degree(_saved_num_q);
+}
+
 void ReferenceProcessor::balance_all_queues() {
   balance_queues(_discoveredSoftRefs);
   balance_queues(_discoveredWeakRefs);
@@ -790,23 +848,12 @@ void ReferenceProcessor::process_discovered_reflist(
   AbstractRefProcTaskExecutor*  task_executor,
   ReferenceProcessorPhaseTimes* phase_times)
 {
-  bool mt_processing = task_executor != NULL && _processing_is_mt;
-
-  phase_times->set_processing_is_mt(mt_processing);
-
-  // If discovery used MT and a dynamic number of GC threads, then
-  // the queues must be balanced for correctness if fewer than the
-  // maximum number of queues were used.  The number of queue used
-  // during discovery may be different than the number to be used
-  // for processing so don't depend of _num_q < _max_num_q as part
-  // of the test.
-  bool must_balance = _discovery_is_mt;
-
-  if ((mt_processing && ParallelRefProcBalancingEnabled) ||
-      must_balance) {
-    RefProcBalanceQueuesTimeTracker tt(phase_times);
-    balance_queues(refs_lists);
-  }
+  // Each phase below may run with a different number of threads, chosen
+  // from the number of references still on the lists when the phase
+  // starts (see RefProcMTDegreeAdjuster).  If the phase is processed MT,
+  // the queues are balanced first, both to spread the work left over by
+  // the previous phase and because only the first _num_q queues are
+  // processed.  The serial code processes all _max_num_q queues.
 
   // Phase 1 (soft refs only):
   // . Traverse the list and remove any SoftReferences whose
@@ -814,11 +861,18 @@ void ReferenceProcessor::process_discovered_reflist(
   //   policy reasons. Keep alive the transitive closure of all
   //   such referents.
   if (policy != NULL) {
-    RefProcParPhaseTimeTracker tt(ReferenceProcessorPhaseTimes::RefPhase1, phase_times);
+    RefProcMTDegreeAdjuster a(this, total_count(refs_lists));
+    bool mt_processing = task_executor != NULL && _processing_is_mt;
+    if (mt_processing) {
+      maybe_balance_queues(refs_lists, phase_times);
+    }
+
+    RefProcParPhaseTimeTracker tt(ReferenceProcessorPhaseTimes::RefPhase1, phase_times,
+                                  mt_processing ? _num_q : 0);
 
     if (mt_processing) {
       RefProcPhase1Task phase1(*this, refs_lists, policy, true /*marks_oops_alive*/, phase_times);
-      task_executor->execute(phase1);
+      task_executor->execute(phase1, _num_q);
     } else {
       for (uint i = 0; i < _max_num_q; i++) {
         process_phase1(refs_lists[i], policy,
@@ -833,11 +887,18 @@ void ReferenceProcessor::process_discovered_reflist(
   // Phase 2:
   // . Traverse the list and remove any refs whose referents are alive.
   {
-    RefProcParPhaseTimeTracker tt(ReferenceProcessorPhaseTimes::RefPhase2, phase_times);
+    RefProcMTDegreeAdjuster a(this, total_count(refs_lists));
+    bool mt_processing = task_executor != NULL && _processing_is_mt;
+    if (mt_processing) {
+      maybe_balance_queues(refs_lists, phase_times);
+    }
+
+    RefProcParPhaseTimeTracker tt(ReferenceProcessorPhaseTimes::RefPhase2, phase_times,
+                                  mt_processing ? _num_q : 0);
 
     if (mt_processing) {
       RefProcPhase2Task phase2(*this, refs_lists, !discovery_is_atomic() /*marks_oops_alive*/, phase_times);
-      task_executor->execute(phase2);
+      task_executor->execute(phase2, _num_q);
     } else {
       for (uint i = 0; i < _max_num_q; i++) {
         process_phase2(refs_lists[i], is_alive, keep_alive, complete_gc);
@@ -848,11 +909,18 @@ void ReferenceProcessor::process_discovered_reflist(
   // Phase 3:
   // . Traverse the list and process referents as appropriate.
   {
-    RefProcParPhaseTimeTracker tt(ReferenceProcessorPhaseTimes::RefPhase3, phase_times);
+    RefProcMTDegreeAdjuster a(this, total_count(refs_lists));
+    bool mt_processing = task_executor != NULL && _processing_is_mt;
+    if (mt_processing) {
+      maybe_balance_queues(refs_lists, phase_times);
+    }
+
+    RefProcParPhaseTimeTracker tt(ReferenceProcessorPhaseTimes::RefPhase3, phase_times,
+                                  mt_processing ? _num_q : 0);
 
     if (mt_processing) {
       RefProcPhase3Task phase3(*this, refs_lists, clear_referent, true /*marks_oops_alive*/, phase_times);
-      task_executor->execute(phase3);
+      task_executor->execute(phase3, _num_q);
     } else {
       for (uint i = 0; i < _max_num_q; i++) {
         process_phase3(refs_lists[i], clear_referent,
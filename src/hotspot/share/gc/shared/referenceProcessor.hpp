@@ -186,6 +186,8 @@ class ReferenceProcessor : public CHeapObj<mtGC> {
   bool        _enqueuing_is_done;       // true if all weak references enqueued
   bool        _processing_is_mt;        // true during phases when
                                         // reference processing is MT.
+  bool        _adjust_no_of_processing_threads; // allow dynamic adjustment of the
+                                        // number of threads used per phase
   uint        _next_id;                 // round-robin mod _num_q counter in
                                         // support of work distribution
 
@@ -341,6 +343,11 @@ class ReferenceProcessor : public CHeapObj<mtGC> {
 
   // Balances reference queues.
   void balance_queues(DiscoveredList ref_lists[]);
+  bool need_balance_queues(DiscoveredList refs_lists[]);
+
+  // If there is need to balance the given queue, do it.
+  void maybe_balance_queues(DiscoveredList refs_lists[],
+                            ReferenceProcessorPhaseTimes* phase_times);
 
   // Update (advance) the soft ref master clock field.
   void update_soft_ref_master_clock();
@@ -351,7 +358,8 @@ class ReferenceProcessor : public CHeapObj<mtGC> {
                      bool mt_processing = false, uint mt_processing_degree = 1,
                      bool mt_discovery  = false, uint mt_discovery_degree  = 1,
                      bool atomic_discovery = true,
-                     BoolObjectClosure* is_alive_non_header = NULL);
+                     BoolObjectClosure* is_alive_non_header = NULL,
+                     bool adjust_no_of_processing_threads = false);
 
   // RefDiscoveryPolicy values
   enum DiscoveryPolicy {
@@ -393,6 +401,14 @@ class ReferenceProcessor : public CHeapObj<mtGC> {
   bool processing_is_mt() const { return _processing_is_mt; }
   void set_mt_processing(bool mt) { _processing_is_mt = mt; }
 
+  // Whether the number of processing threads may be lowered for a phase,
+  // based on the number of references it has to process.
+  bool adjust_no_of_processing_threads() const { return _adjust_no_of_processing_threads; }
+
+  // Number of threads to use for processing ref_count references, given
+  // at most max_threads.
+  uint ergo_proc_thread_count(size_t ref_count, uint max_threads) const;
+
   // whether all enqueueing of weak references is complete
   bool enqueuing_is_done()  { return _enqueuing_is_done; }
   void set_enqueuing_is_done(bool v) { _enqueuing_is_done = v; }
@@ -563,6 +579,21 @@ class ReferenceProcessorMTProcMutator: StackObj {
 };
 
 
+// A utility class to lower the number of queues, and with them the number
+// of threads, used by MT reference processing for the duration of a single
+// processing phase.  The count is derived from the number of references
+// the phase has to process (see ReferencesPerThread).  Processing falls
+// back to the serial code if a single thread suffices.
+class RefProcMTDegreeAdjuster : public StackObj {
+  ReferenceProcessor* _rp;
+  bool                _saved_mt_processing;
+  uint                _saved_num_q;
+
+public:
+  RefProcMTDegreeAdjuster(ReferenceProcessor* rp, size_t ref_count);
+  ~RefProcMTDegreeAdjuster();
+};
+
 // This class is an interface used to implement task execution for the
 // reference processing.
 class AbstractRefProcTaskExecutor {
@@ -572,8 +603,9 @@ public:
   class ProcessTask;
   class EnqueueTask;
 
-  // Executes a task using worker threads.
-  virtual void execute(ProcessTask& task) = 0;
+  // Executes a task using worker threads.  A ProcessTask is run with
+  // ergo_workers threads, which may be fewer than the active workers.
+  virtual void execute(ProcessTask& task, uint ergo_workers) = 0;
   virtual void execute(EnqueueTask& task) = 0;
 
   // Switch to single threaded mode.
@@ -115,7 +115,7 @@ RefProcBalanceQueuesTimeTracker::RefProcBalanceQueuesTimeTracker(ReferenceProces
 
 RefProcBalanceQueuesTimeTracker::~RefProcBalanceQueuesTimeTracker() {
   double elapsed = elapsed_time();
-  phase_times()->set_balance_queues_time_ms(phase_times()->processing_ref_type(), elapsed);
+  phase_times()->add_balance_queues_time_ms(phase_times()->processing_ref_type(), elapsed);
 }
 
 #define ASSERT_REF_TYPE(ref_type) assert(ref_type >= REF_SOFT && ref_type <= REF_PHANTOM, \
@@ -142,9 +142,12 @@ static const char* phase_number_2_string(ReferenceProcessorPhaseTimes::RefProcPh
 }
 
 RefProcParPhaseTimeTracker::RefProcParPhaseTimeTracker(ReferenceProcessorPhaseTimes::RefProcPhaseNumbers phase_number,
-                                                       ReferenceProcessorPhaseTimes* phase_times) :
+                                                       ReferenceProcessorPhaseTimes* phase_times,
+                                                       uint workers) :
   _phase_number(phase_number),
-  RefProcPhaseTimeBaseTracker(phase_number_2_string(phase_number), phase_times) {}
+  RefProcPhaseTimeBaseTracker(phase_number_2_string(phase_number), phase_times) {
+  phase_times->set_par_phase_workers(phase_times->par_phase(phase_number), workers);
+}
 
 RefProcParPhaseTimeTracker::~RefProcParPhaseTimeTracker() {
   double elapsed = elapsed_time();
@@ -207,11 +210,12 @@ RefProcEnqueueTimeTracker::~RefProcEnqueueTimeTracker() {
 }
 
 ReferenceProcessorPhaseTimes::ReferenceProcessorPhaseTimes(GCTimer* gc_timer, uint max_gc_threads) :
-  _gc_timer(gc_timer), _processing_is_mt(false) {
+  _gc_timer(gc_timer) {
 
   for (int i = 0; i < RefParPhaseMax; i++) {
     _worker_time_sec[i] = new WorkerDataArray<double>(max_gc_threads, "Process lists (ms)");
     _par_phase_time_ms[i] = uninitialized();
+    _par_phase_workers[i] = 0;
   }
 
   for (int i = 0; i < number_of_subclasses_of_ref; i++) {
@@ -247,10 +251,22 @@ void ReferenceProcessorPhaseTimes::set_par_phase_time_ms(RefProcParPhases par_ph
   _par_phase_time_ms[par_phase] = par_phase_time_ms;
 }
 
+uint ReferenceProcessorPhaseTimes::par_phase_workers(RefProcParPhases par_phase) const {
+  ASSERT_PAR_PHASE(par_phase);
+  return _par_phase_workers[par_phase];
+}
+
+void ReferenceProcessorPhaseTimes::set_par_phase_workers(RefProcParPhases par_phase,
+                                                         uint workers) {
+  ASSERT_PAR_PHASE(par_phase);
+  _par_phase_workers[par_phase] = workers;
+}
+
 void ReferenceProcessorPhaseTimes::reset() {
   for (int i = 0; i < RefParPhaseMax; i++) {
     _worker_time_sec[i]->reset();
     _par_phase_time_ms[i] = uninitialized();
+    _par_phase_workers[i] = 0;
   }
 
   for (int i = 0; i < number_of_subclasses_of_ref; i++) {
@@ -262,8 +278,6 @@ void ReferenceProcessorPhaseTimes::reset() {
   }
 
   _total_time_ms = uninitialized();
-
-  _processing_is_mt = false;
 }
 
 ReferenceProcessorPhaseTimes::~ReferenceProcessorPhaseTimes() {
@@ -318,9 +332,14 @@ double ReferenceProcessorPhaseTimes::balance_queues_time_ms(ReferenceType ref_ty
   return _balance_queues_time_ms[ref_type_2_index(ref_type)];
 }
 
-void ReferenceProcessorPhaseTimes::set_balance_queues_time_ms(ReferenceType ref_type, double time_ms) {
+void ReferenceProcessorPhaseTimes::add_balance_queues_time_ms(ReferenceType ref_type, double time_ms) {
   ASSERT_REF_TYPE(ref_type);
-  _balance_queues_time_ms[ref_type_2_index(ref_type)] = time_ms;
+  // Queues may be balanced before each phase of a reference type.
+  double& balance_time = _balance_queues_time_ms[ref_type_2_index(ref_type)];
+  if (balance_time == uninitialized()) {
+    balance_time = 0.0;
+  }
+  balance_time += time_ms;
 }
 
 ReferenceProcessorPhaseTimes::RefProcParPhases
@@ -461,12 +480,13 @@ void ReferenceProcessorPhaseTimes::print_phase(RefProcParPhases phase, uint inde
                 phase_time);
 
     LogTarget(Trace, gc, phases, ref) lt2;
-    if (_processing_is_mt && lt2.is_enabled()) {
+    if (par_phase_workers(phase) > 0 && lt2.is_enabled()) {
       LogStream ls(lt2);
 
       ls.print("%s", Indents[indent + 1]);
       // worker_time_sec is recorded in seconds but it will be printed in milliseconds.
       worker_time_sec(phase)->print_summary_on(&ls, true);
+      worker_time_sec(phase)->print_details_on(&ls);
     }
   }
 }
@@ -80,7 +80,8 @@ private:
   size_t                   _ref_enqueued[number_of_subclasses_of_ref];
   double                   _balance_queues_time_ms[number_of_subclasses_of_ref];
 
-  bool                     _processing_is_mt;
+  // Number of threads that processed each phase, 0 if processed serially.
+  uint                     _par_phase_workers[RefParPhaseMax];
 
   // Currently processing reference type.
   ReferenceType            _processing_ref_type;
@@ -118,9 +119,10 @@ public:
   void set_ref_discovered(ReferenceType ref_type, size_t count);
   void set_ref_enqueued(ReferenceType ref_type, size_t count);
 
-  void set_balance_queues_time_ms(ReferenceType ref_type, double time_ms);
+  void add_balance_queues_time_ms(ReferenceType ref_type, double time_ms);
 
-  void set_processing_is_mt(bool processing_is_mt) { _processing_is_mt = processing_is_mt; }
+  uint par_phase_workers(RefProcParPhases phase) const;
+  void set_par_phase_workers(RefProcParPhases phase, uint workers);
 
   ReferenceType processing_ref_type() const { return _processing_ref_type; }
   void set_processing_ref_type(ReferenceType processing_ref_type) { _processing_ref_type = processing_ref_type; }
@@ -181,13 +183,15 @@ public:
   ~RefProcBalanceQueuesTimeTracker();
 };
 
-// Updates phase time at ReferenceProcessorPhaseTimes and save it into GCTimer.
+// Updates phase time and the number of threads used at
+// ReferenceProcessorPhaseTimes and save it into GCTimer.
 class RefProcParPhaseTimeTracker : public RefProcPhaseTimeBaseTracker {
   ReferenceProcessorPhaseTimes::RefProcPhaseNumbers _phase_number;
 
 public:
   RefProcParPhaseTimeTracker(ReferenceProcessorPhaseTimes::RefProcPhaseNumbers phase_number,
-                             ReferenceProcessorPhaseTimes* phase_times);
+                             ReferenceProcessorPhaseTimes* phase_times,
+                             uint workers);
   ~RefProcParPhaseTimeTracker();
 };
 
@@ -0,0 +1,176 @@
+/*
+ * Copyright (c) 2014, 2017, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#include "precompiled.hpp"
+#include "classfile/javaClasses.inline.hpp"
+#include "gc/shared/collectedHeap.hpp"
+#include "gc/shared/stringDedup.hpp"
+#include "gc/shared/stringDedupQueue.hpp"
+#include "gc/shared/stringDedupStat.hpp"
+#include "gc/shared/stringDedupTable.hpp"
+#include "gc/shared/stringDedupThread.hpp"
+#include "memory/universe.hpp"
+#include "runtime/atomic.hpp"
+#include "utilities/macros.hpp"
+#if INCLUDE_ALL_GCS
+#include "gc/g1/g1CollectedHeap.inline.hpp"
+#endif
+
+bool StringDedup::_enabled = false;
+
+void StringDedup::initialize() {
+  if (UseStringDeduplication) {
+    _enabled = true;
+    StringDedupQueue::create();
+    StringDedupTable::create();
+    StringDedupThread::create();
+  }
+}
+
+void StringDedup::stop() {
+  assert(is_enabled(), "String deduplication not enabled");
+  StringDedupThread::thread()->stop();
+}
+
+bool StringDedup::is_candidate_from_evacuation(bool from_young, bool to_young, oop obj) {
+  if (from_young && java_lang_String::is_instance_inlined(obj)) {
+    if (to_young && obj->age() == StringDeduplicationAgeThreshold) {
+      // Candidate found. String is being evacuated from young to young and just
+      // reached the deduplication age threshold.
+      return true;
+    }
+    if (!to_young && obj->age() < StringDeduplicationAgeThreshold) {
+      // Candidate found. String is being evacuated from young to old but has not
+      // reached the deduplication age threshold, i.e. has not previously been a
+      // candidate during its life in the young generation.
+      return true;
+    }
+  }
+
+  // Not a candidate
+  return false;
+}
+
+void StringDedup::enqueue_from_evacuation(bool from_young, bool to_young, uint worker_id, oop java_string) {
+  assert(is_enabled(), "String deduplication not enabled");
+  if (is_candidate_from_evacuation(from_young, to_young, java_string)) {
+    StringDedupQueue::push(worker_id, java_string);
+  }
+}
+
+bool StringDedup::is_in_young(oop obj) {
+#if INCLUDE_ALL_GCS
+  if (UseG1GC) {
+    return G1CollectedHeap::heap()->is_in_young(obj);
+  }
+#endif
+  // The generational collectors only scavenge the young generation.
+  return Universe::heap()->is_scavengable(obj);
+}
+
+void StringDedup::deduplicate(oop java_string) {
+  assert(is_enabled(), "String deduplication not enabled");
+  StringDedupStat dummy; // Statistics from this path is never used
+  StringDedupTable::deduplicate(java_string, dummy);
+}
+
+void StringDedup::parallel_unlink(StringDedupUnlinkOrOopsDoClosure* unlink, uint worker_id) {
+  assert(is_enabled(), "String deduplication not enabled");
+  StringDedupQueue::unlink_or_oops_do(unlink);
+  StringDedupTable::unlink_or_oops_do(unlink, worker_id);
+}
+
+void StringDedup::unlink_or_oops_do(BoolObjectClosure* is_alive,
+                                    OopClosure* keep_alive,
+                                    bool allow_resize_and_rehash) {
+  assert(is_enabled(), "String deduplication not enabled");
+  StringDedupUnlinkOrOopsDoClosure cl(is_alive, keep_alive, allow_resize_and_rehash);
+  parallel_unlink(&cl, 0);
+}
+
+void StringDedup::unlink(BoolObjectClosure* is_alive) {
+  unlink_or_oops_do(is_alive, NULL, true /* allow_resize_and_rehash */);
+}
+
+void StringDedup::oops_do(OopClosure* keep_alive) {
+  unlink_or_oops_do(NULL, keep_alive, true /* allow_resize_and_rehash */);
+}
+
+void StringDedup::threads_do(ThreadClosure* tc) {
+  assert(is_enabled(), "String deduplication not enabled");
+  tc->do_thread(StringDedupThread::thread());
+}
+
+void StringDedup::print_worker_threads_on(outputStream* st) {
+  assert(is_enabled(), "String deduplication not enabled");
+  StringDedupThread::thread()->print_on(st);
+  st->cr();
+}
+
+void StringDedup::verify() {
+  assert(is_enabled(), "String deduplication not enabled");
+  StringDedupQueue::verify();
+  StringDedupTable::verify();
+}
+
+StringDedupUnlinkOrOopsDoClosure::StringDedupUnlinkOrOopsDoClosure(BoolObjectClosure* is_alive,
+                                                                   OopClosure* keep_alive,
+                                                                   bool allow_resize_and_rehash) :
+  _is_alive(is_alive),
+  _keep_alive(keep_alive),
+  _resized_table(NULL),
+  _rehashed_table(NULL),
+  _next_queue(0),
+  _next_bucket(0) {
+  if (allow_resize_and_rehash) {
+    // If both resize and rehash is needed, only do resize. Rehash of
+    // the table will eventually happen if the situation persists.
+    _resized_table = StringDedupTable::prepare_resize();
+    if (!is_resizing()) {
+      _rehashed_table = StringDedupTable::prepare_rehash();
+    }
+  }
+}
+
+StringDedupUnlinkOrOopsDoClosure::~StringDedupUnlinkOrOopsDoClosure() {
+  assert(!is_resizing() || !is_rehashing(), "Can not both resize and rehash");
+  if (is_resizing()) {
+    StringDedupTable::finish_resize(_resized_table);
+  } else if (is_rehashing()) {
+    StringDedupTable::finish_rehash(_rehashed_table);
+  }
+}
+
+// Atomically claims the next available queue for exclusive access by
+// the current thread. Returns the queue number of the claimed queue.
+size_t StringDedupUnlinkOrOopsDoClosure::claim_queue() {
+  return Atomic::add((size_t)1, &_next_queue) - 1;
+}
+
+// Atomically claims the next available table partition for exclusive
+// access by the current thread. Returns the table bucket number where
+// the claimed partition starts.
+size_t StringDedupUnlinkOrOopsDoClosure::claim_table_partition(size_t partition_size) {
+  return Atomic::add(partition_size, &_next_bucket) - partition_size;
+}
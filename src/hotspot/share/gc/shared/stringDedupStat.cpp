@@ -23,10 +23,10 @@
  */
 
 #include "precompiled.hpp"
-#include "gc/g1/g1StringDedupStat.hpp"
+#include "gc/shared/stringDedupStat.hpp"
 #include "logging/log.hpp"
 
-G1StringDedupStat::G1StringDedupStat() :
+StringDedupStat::StringDedupStat() :
   _inspected(0),
   _skipped(0),
   _hashed(0),
@@ -50,7 +50,7 @@ G1StringDedupStat::G1StringDedupStat() :
   _block_elapsed(0.0) {
 }
 
-void G1StringDedupStat::add(const G1StringDedupStat& stat) {
+void StringDedupStat::add(const StringDedupStat& stat) {
   _inspected           += stat._inspected;
   _skipped             += stat._skipped;
   _hashed              += stat._hashed;
@@ -71,13 +71,13 @@ void G1StringDedupStat::add(const G1StringDedupStat& stat) {
   _block_elapsed       += stat._block_elapsed;
 }
 
-void G1StringDedupStat::print_start(const G1StringDedupStat& last_stat) {
+void StringDedupStat::print_start(const StringDedupStat& last_stat) {
   log_info(gc, stringdedup)(
-     "Concurrent String Deduplication (" G1_STRDEDUP_TIME_FORMAT ")",
-     G1_STRDEDUP_TIME_PARAM(last_stat._start_concurrent));
+     "Concurrent String Deduplication (" STRDEDUP_TIME_FORMAT ")",
+     STRDEDUP_TIME_PARAM(last_stat._start_concurrent));
 }
 
-void G1StringDedupStat::print_end(const G1StringDedupStat& last_stat, const G1StringDedupStat& total_stat) {
+void StringDedupStat::print_end(const StringDedupStat& last_stat, const StringDedupStat& total_stat) {
   double total_deduped_bytes_percent = 0.0;
 
   if (total_stat._new_bytes > 0) {
@@ -87,19 +87,19 @@ void G1StringDedupStat::print_end(const G1StringDedupStat& last_stat, const G1St
 
   log_info(gc, stringdedup)(
     "Concurrent String Deduplication "
-    G1_STRDEDUP_BYTES_FORMAT_NS "->" G1_STRDEDUP_BYTES_FORMAT_NS "(" G1_STRDEDUP_BYTES_FORMAT_NS ") "
-    "avg " G1_STRDEDUP_PERCENT_FORMAT_NS " "
-    "(" G1_STRDEDUP_TIME_FORMAT ", " G1_STRDEDUP_TIME_FORMAT ") " G1_STRDEDUP_TIME_FORMAT_MS,
-    G1_STRDEDUP_BYTES_PARAM(last_stat._new_bytes),
-    G1_STRDEDUP_BYTES_PARAM(last_stat._new_bytes - last_stat._deduped_bytes),
-    G1_STRDEDUP_BYTES_PARAM(last_stat._deduped_bytes),
+    STRDEDUP_BYTES_FORMAT_NS "->" STRDEDUP_BYTES_FORMAT_NS "(" STRDEDUP_BYTES_FORMAT_NS ") "
+    "avg " STRDEDUP_PERCENT_FORMAT_NS " "
+    "(" STRDEDUP_TIME_FORMAT ", " STRDEDUP_TIME_FORMAT ") " STRDEDUP_TIME_FORMAT_MS,
+    STRDEDUP_BYTES_PARAM(last_stat._new_bytes),
+    STRDEDUP_BYTES_PARAM(last_stat._new_bytes - last_stat._deduped_bytes),
+    STRDEDUP_BYTES_PARAM(last_stat._deduped_bytes),
     total_deduped_bytes_percent,
-    G1_STRDEDUP_TIME_PARAM(last_stat._start_concurrent),
-    G1_STRDEDUP_TIME_PARAM(last_stat._end_concurrent),
-    G1_STRDEDUP_TIME_PARAM_MS(last_stat._exec_elapsed));
+    STRDEDUP_TIME_PARAM(last_stat._start_concurrent),
+    STRDEDUP_TIME_PARAM(last_stat._end_concurrent),
+    STRDEDUP_TIME_PARAM_MS(last_stat._exec_elapsed));
 }
 
-void G1StringDedupStat::print_statistics(const G1StringDedupStat& stat, bool total) {
+void StringDedupStat::print_statistics(const StringDedupStat& stat, bool total) {
   double skipped_percent             = percent_of(stat._skipped, stat._inspected);
   double hashed_percent              = percent_of(stat._hashed, stat._inspected);
   double known_percent               = percent_of(stat._known, stat._inspected);
@@ -113,31 +113,31 @@ void G1StringDedupStat::print_statistics(const G1StringDedupStat& stat, bool tot
 
   if (total) {
     log_debug(gc, stringdedup)(
-      "  Total Exec: " UINTX_FORMAT "/" G1_STRDEDUP_TIME_FORMAT_MS
-      ", Idle: " UINTX_FORMAT "/" G1_STRDEDUP_TIME_FORMAT_MS
-      ", Blocked: " UINTX_FORMAT "/" G1_STRDEDUP_TIME_FORMAT_MS,
-      stat._exec, G1_STRDEDUP_TIME_PARAM_MS(stat._exec_elapsed),
-      stat._idle, G1_STRDEDUP_TIME_PARAM_MS(stat._idle_elapsed),
-      stat._block, G1_STRDEDUP_TIME_PARAM_MS(stat._block_elapsed));
+      "  Total Exec: " UINTX_FORMAT "/" STRDEDUP_TIME_FORMAT_MS
+      ", Idle: " UINTX_FORMAT "/" STRDEDUP_TIME_FORMAT_MS
+      ", Blocked: " UINTX_FORMAT "/" STRDEDUP_TIME_FORMAT_MS,
+      stat._exec, STRDEDUP_TIME_PARAM_MS(stat._exec_elapsed),
+      stat._idle, STRDEDUP_TIME_PARAM_MS(stat._idle_elapsed),
+      stat._block, STRDEDUP_TIME_PARAM_MS(stat._block_elapsed));
   } else {
     log_debug(gc, stringdedup)(
-      "  Last Exec: " G1_STRDEDUP_TIME_FORMAT_MS
-      ", Idle: " G1_STRDEDUP_TIME_FORMAT_MS
-      ", Blocked: " UINTX_FORMAT "/" G1_STRDEDUP_TIME_FORMAT_MS,
-      G1_STRDEDUP_TIME_PARAM_MS(stat._exec_elapsed),
-      G1_STRDEDUP_TIME_PARAM_MS(stat._idle_elapsed),
-      stat._block, G1_STRDEDUP_TIME_PARAM_MS(stat._block_elapsed));
+      "  Last Exec: " STRDEDUP_TIME_FORMAT_MS
+      ", Idle: " STRDEDUP_TIME_FORMAT_MS
+      ", Blocked: " UINTX_FORMAT "/" STRDEDUP_TIME_FORMAT_MS,
+      STRDEDUP_TIME_PARAM_MS(stat._exec_elapsed),
+      STRDEDUP_TIME_PARAM_MS(stat._idle_elapsed),
+      stat._block, STRDEDUP_TIME_PARAM_MS(stat._block_elapsed));
   }
-  log_debug(gc, stringdedup)("    Inspected:    " G1_STRDEDUP_OBJECTS_FORMAT, stat._inspected);
-  log_debug(gc, stringdedup)("      Skipped:    " G1_STRDEDUP_OBJECTS_FORMAT "(" G1_STRDEDUP_PERCENT_FORMAT ")", stat._skipped, skipped_percent);
-  log_debug(gc, stringdedup)("      Hashed:     " G1_STRDEDUP_OBJECTS_FORMAT "(" G1_STRDEDUP_PERCENT_FORMAT ")", stat._hashed, hashed_percent);
-  log_debug(gc, stringdedup)("      Known:      " G1_STRDEDUP_OBJECTS_FORMAT "(" G1_STRDEDUP_PERCENT_FORMAT ")", stat._known, known_percent);
-  log_debug(gc, stringdedup)("      New:        " G1_STRDEDUP_OBJECTS_FORMAT "(" G1_STRDEDUP_PERCENT_FORMAT ") " G1_STRDEDUP_BYTES_FORMAT,
-                             stat._new, new_percent, G1_STRDEDUP_BYTES_PARAM(stat._new_bytes));
-  log_debug(gc, stringdedup)("    Deduplicated: " G1_STRDEDUP_OBJECTS_FORMAT "(" G1_STRDEDUP_PERCENT_FORMAT ") " G1_STRDEDUP_BYTES_FORMAT "(" G1_STRDEDUP_PERCENT_FORMAT ")",
-                             stat._deduped, deduped_percent, G1_STRDEDUP_BYTES_PARAM(stat._deduped_bytes), deduped_bytes_percent);
-  log_debug(gc, stringdedup)("      Young:      " G1_STRDEDUP_OBJECTS_FORMAT "(" G1_STRDEDUP_PERCENT_FORMAT ") " G1_STRDEDUP_BYTES_FORMAT "(" G1_STRDEDUP_PERCENT_FORMAT ")",
-                             stat._deduped_young, deduped_young_percent, G1_STRDEDUP_BYTES_PARAM(stat._deduped_young_bytes), deduped_young_bytes_percent);
-  log_debug(gc, stringdedup)("      Old:        " G1_STRDEDUP_OBJECTS_FORMAT "(" G1_STRDEDUP_PERCENT_FORMAT ") " G1_STRDEDUP_BYTES_FORMAT "(" G1_STRDEDUP_PERCENT_FORMAT ")",
-                             stat._deduped_old, deduped_old_percent, G1_STRDEDUP_BYTES_PARAM(stat._deduped_old_bytes), deduped_old_bytes_percent);
+  log_debug(gc, stringdedup)("    Inspected:    " STRDEDUP_OBJECTS_FORMAT, stat._inspected);
+  log_debug(gc, stringdedup)("      Skipped:    " STRDEDUP_OBJECTS_FORMAT "(" STRDEDUP_PERCENT_FORMAT ")", stat._skipped, skipped_percent);
+  log_debug(gc, stringdedup)("      Hashed:     " STRDEDUP_OBJECTS_FORMAT "(" STRDEDUP_PERCENT_FORMAT ")", stat._hashed, hashed_percent);
+  log_debug(gc, stringdedup)("      Known:      " STRDEDUP_OBJECTS_FORMAT "(" STRDEDUP_PERCENT_FORMAT ")", stat._known, known_percent);
+  log_debug(gc, stringdedup)("      New:        " STRDEDUP_OBJECTS_FORMAT "(" STRDEDUP_PERCENT_FORMAT ") " STRDEDUP_BYTES_FORMAT,
+                             stat._new, new_percent, STRDEDUP_BYTES_PARAM(stat._new_bytes));
+  log_debug(gc, stringdedup)("    Deduplicated: " STRDEDUP_OBJECTS_FORMAT "(" STRDEDUP_PERCENT_FORMAT ") " STRDEDUP_BYTES_FORMAT "(" STRDEDUP_PERCENT_FORMAT ")",
+                             stat._deduped, deduped_percent, STRDEDUP_BYTES_PARAM(stat._deduped_bytes), deduped_bytes_percent);
+  log_debug(gc, stringdedup)("      Young:      " STRDEDUP_OBJECTS_FORMAT "(" STRDEDUP_PERCENT_FORMAT ") " STRDEDUP_BYTES_FORMAT "(" STRDEDUP_PERCENT_FORMAT ")",
+                             stat._deduped_young, deduped_young_percent, STRDEDUP_BYTES_PARAM(stat._deduped_young_bytes), deduped_young_bytes_percent);
+  log_debug(gc, stringdedup)("      Old:        " STRDEDUP_OBJECTS_FORMAT "(" STRDEDUP_PERCENT_FORMAT ") " STRDEDUP_BYTES_FORMAT "(" STRDEDUP_PERCENT_FORMAT ")",
+                             stat._deduped_old, deduped_old_percent, STRDEDUP_BYTES_PARAM(stat._deduped_old_bytes), deduped_old_bytes_percent);
 }
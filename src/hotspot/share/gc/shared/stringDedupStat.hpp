@@ -22,28 +22,28 @@
  *
  */
 
-#ifndef SHARE_VM_GC_G1_G1STRINGDEDUPSTAT_HPP
-#define SHARE_VM_GC_G1_G1STRINGDEDUPSTAT_HPP
+#ifndef SHARE_VM_GC_SHARED_STRINGDEDUPSTAT_HPP
+#define SHARE_VM_GC_SHARED_STRINGDEDUPSTAT_HPP
 
 #include "memory/allocation.hpp"
 #include "runtime/os.hpp"
 
 // Macros for GC log output formating
-#define G1_STRDEDUP_OBJECTS_FORMAT         UINTX_FORMAT_W(12)
-#define G1_STRDEDUP_TIME_FORMAT            "%.3fs"
-#define G1_STRDEDUP_TIME_PARAM(time)       (time)
-#define G1_STRDEDUP_TIME_FORMAT_MS         "%.3fms"
-#define G1_STRDEDUP_TIME_PARAM_MS(time)    ((time) * MILLIUNITS)
-#define G1_STRDEDUP_PERCENT_FORMAT         "%5.1f%%"
-#define G1_STRDEDUP_PERCENT_FORMAT_NS      "%.1f%%"
-#define G1_STRDEDUP_BYTES_FORMAT           "%8.1f%s"
-#define G1_STRDEDUP_BYTES_FORMAT_NS        "%.1f%s"
-#define G1_STRDEDUP_BYTES_PARAM(bytes)     byte_size_in_proper_unit((double)(bytes)), proper_unit_for_byte_size((bytes))
+#define STRDEDUP_OBJECTS_FORMAT         UINTX_FORMAT_W(12)
+#define STRDEDUP_TIME_FORMAT            "%.3fs"
+#define STRDEDUP_TIME_PARAM(time)       (time)
+#define STRDEDUP_TIME_FORMAT_MS         "%.3fms"
+#define STRDEDUP_TIME_PARAM_MS(time)    ((time) * MILLIUNITS)
+#define STRDEDUP_PERCENT_FORMAT         "%5.1f%%"
+#define STRDEDUP_PERCENT_FORMAT_NS      "%.1f%%"
+#define STRDEDUP_BYTES_FORMAT           "%8.1f%s"
+#define STRDEDUP_BYTES_FORMAT_NS        "%.1f%s"
+#define STRDEDUP_BYTES_PARAM(bytes)     byte_size_in_proper_unit((double)(bytes)), proper_unit_for_byte_size((bytes))
 
 //
 // Statistics gathered by the deduplication thread.
 //
-class G1StringDedupStat : public StackObj {
+class StringDedupStat : public StackObj {
 private:
   // Counters
   uintx  _inspected;
@@ -71,7 +71,7 @@ private:
   double _block_elapsed;
 
 public:
-  G1StringDedupStat();
+  StringDedupStat();
 
   void inc_inspected() {
     _inspected++;
@@ -140,11 +140,11 @@ public:
     _end_concurrent = now;
   }
 
-  void add(const G1StringDedupStat& stat);
+  void add(const StringDedupStat& stat);
 
-  static void print_start(const G1StringDedupStat& last_stat);
-  static void print_end(const G1StringDedupStat& last_stat, const G1StringDedupStat& total_stat);
-  static void print_statistics(const G1StringDedupStat& stat, bool total);
+  static void print_start(const StringDedupStat& last_stat);
+  static void print_end(const StringDedupStat& last_stat, const StringDedupStat& total_stat);
+  static void print_statistics(const StringDedupStat& stat, bool total);
 };
 
-#endif // SHARE_VM_GC_G1_G1STRINGDEDUPSTAT_HPP
+#endif // SHARE_VM_GC_SHARED_STRINGDEDUPSTAT_HPP
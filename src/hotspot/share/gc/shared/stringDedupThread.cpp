@@ -24,76 +24,76 @@
 
 #include "precompiled.hpp"
 #include "classfile/stringTable.hpp"
-#include "gc/g1/g1StringDedup.hpp"
-#include "gc/g1/g1StringDedupQueue.hpp"
-#include "gc/g1/g1StringDedupTable.hpp"
-#include "gc/g1/g1StringDedupThread.hpp"
+#include "gc/shared/stringDedup.hpp"
+#include "gc/shared/stringDedupQueue.hpp"
+#include "gc/shared/stringDedupTable.hpp"
+#include "gc/shared/stringDedupThread.hpp"
 #include "gc/shared/suspendibleThreadSet.hpp"
 #include "logging/log.hpp"
 #include "oops/oop.inline.hpp"
 #include "runtime/atomic.hpp"
 
-G1StringDedupThread* G1StringDedupThread::_thread = NULL;
+StringDedupThread* StringDedupThread::_thread = NULL;
 
-G1StringDedupThread::G1StringDedupThread() :
+StringDedupThread::StringDedupThread() :
   ConcurrentGCThread() {
-  set_name("G1 StrDedup");
+  set_name("StrDedup");
   create_and_start();
 }
 
-G1StringDedupThread::~G1StringDedupThread() {
+StringDedupThread::~StringDedupThread() {
   ShouldNotReachHere();
 }
 
-void G1StringDedupThread::create() {
-  assert(G1StringDedup::is_enabled(), "String deduplication not enabled");
+void StringDedupThread::create() {
+  assert(StringDedup::is_enabled(), "String deduplication not enabled");
   assert(_thread == NULL, "One string deduplication thread allowed");
-  _thread = new G1StringDedupThread();
+  _thread = new StringDedupThread();
 }
 
-G1StringDedupThread* G1StringDedupThread::thread() {
-  assert(G1StringDedup::is_enabled(), "String deduplication not enabled");
+StringDedupThread* StringDedupThread::thread() {
+  assert(StringDedup::is_enabled(), "String deduplication not enabled");
   assert(_thread != NULL, "String deduplication thread not created");
   return _thread;
 }
 
-class G1StringDedupSharedClosure: public OopClosure {
+class StringDedupSharedClosure: public OopClosure {
  private:
-  G1StringDedupStat& _stat;
+  StringDedupStat& _stat;
 
  public:
-  G1StringDedupSharedClosure(G1StringDedupStat& stat) : _stat(stat) {}
+  StringDedupSharedClosure(StringDedupStat& stat) : _stat(stat) {}
 
   virtual void do_oop(oop* p) { ShouldNotReachHere(); }
   virtual void do_oop(narrowOop* p) {
     oop java_string = oopDesc::load_decode_heap_oop(p);
-    G1StringDedupTable::deduplicate(java_string, _stat);
+    StringDedupTable::deduplicate(java_string, _stat);
   }
 };
 
 // The CDS archive does not include the string dedupication table. Only the string
 // table is saved in the archive. The shared strings from CDS archive need to be
 // added to the string dedupication table before deduplication occurs. That is
-// done in the begining of the G1StringDedupThread (see G1StringDedupThread::run()
+// done in the begining of the StringDedupThread (see StringDedupThread::run()
 // below).
-void G1StringDedupThread::deduplicate_shared_strings(G1StringDedupStat& stat) {
-  G1StringDedupSharedClosure sharedStringDedup(stat);
+void StringDedupThread::deduplicate_shared_strings(StringDedupStat& stat) {
+  StringDedupSharedClosure sharedStringDedup(stat);
   StringTable::shared_oops_do(&sharedStringDedup);
 }
 
-void G1StringDedupThread::run_service() {
-  G1StringDedupStat total_stat;
+void StringDedupThread::run_service() {
+  StringDedupStat total_stat;
 
   deduplicate_shared_strings(total_stat);
 
   // Main loop
   for (;;) {
-    G1StringDedupStat stat;
+    StringDedupStat stat;
 
     stat.mark_idle();
 
     // Wait for the queue to become non-empty
-    G1StringDedupQueue::wait();
+    StringDedupQueue::wait();
     if (should_terminate()) {
       break;
     }
@@ -107,12 +107,12 @@ void G1StringDedupThread::run_service() {
 
       // Process the queue
       for (;;) {
-        oop java_string = G1StringDedupQueue::pop();
+        oop java_string = StringDedupQueue::pop();
         if (java_string == NULL) {
           break;
         }
 
-        G1StringDedupTable::deduplicate(java_string, stat);
+        StringDedupTable::deduplicate(java_string, stat);
 
         // Safepoint this thread if needed
         if (sts_join.should_yield()) {
@@ -128,24 +128,24 @@ void G1StringDedupThread::run_service() {
       print_end(stat, total_stat);
     }
 
-    G1StringDedupTable::clean_entry_cache();
+    StringDedupTable::clean_entry_cache();
   }
 }
 
-void G1StringDedupThread::stop_service() {
-  G1StringDedupQueue::cancel_wait();
+void StringDedupThread::stop_service() {
+  StringDedupQueue::cancel_wait();
 }
 
-void G1StringDedupThread::print_start(const G1StringDedupStat& last_stat) {
-  G1StringDedupStat::print_start(last_stat);
+void StringDedupThread::print_start(const StringDedupStat& last_stat) {
+  StringDedupStat::print_start(last_stat);
 }
 
-void G1StringDedupThread::print_end(const G1StringDedupStat& last_stat, const G1StringDedupStat& total_stat) {
-  G1StringDedupStat::print_end(last_stat, total_stat);
+void StringDedupThread::print_end(const StringDedupStat& last_stat, const StringDedupStat& total_stat) {
+  StringDedupStat::print_end(last_stat, total_stat);
   if (log_is_enabled(Debug, gc, stringdedup)) {
-    G1StringDedupStat::print_statistics(last_stat, false);
-    G1StringDedupStat::print_statistics(total_stat, true);
-    G1StringDedupTable::print_statistics();
-    G1StringDedupQueue::print_statistics();
+    StringDedupStat::print_statistics(last_stat, false);
+    StringDedupStat::print_statistics(total_stat, true);
+    StringDedupTable::print_statistics();
+    StringDedupQueue::print_statistics();
   }
 }
@@ -22,10 +22,10 @@
  *
  */
 
-#ifndef SHARE_VM_GC_G1_G1STRINGDEDUPTHREAD_HPP
-#define SHARE_VM_GC_G1_G1STRINGDEDUPTHREAD_HPP
+#ifndef SHARE_VM_GC_SHARED_STRINGDEDUPTHREAD_HPP
+#define SHARE_VM_GC_SHARED_STRINGDEDUPTHREAD_HPP
 
-#include "gc/g1/g1StringDedupStat.hpp"
+#include "gc/shared/stringDedupStat.hpp"
 #include "gc/shared/concurrentGCThread.hpp"
 
 //
@@ -36,15 +36,15 @@
 // concurrently with the Java application but participates in safepoints to allow
 // the GC to adjust and unlink oops from the deduplication queue and table.
 //
-class G1StringDedupThread: public ConcurrentGCThread {
+class StringDedupThread: public ConcurrentGCThread {
 private:
-  static G1StringDedupThread* _thread;
+  static StringDedupThread* _thread;
 
-  G1StringDedupThread();
-  ~G1StringDedupThread();
+  StringDedupThread();
+  ~StringDedupThread();
 
-  void print_start(const G1StringDedupStat& last_stat);
-  void print_end(const G1StringDedupStat& last_stat, const G1StringDedupStat& total_stat);
+  void print_start(const StringDedupStat& last_stat);
+  void print_end(const StringDedupStat& last_stat, const StringDedupStat& total_stat);
 
   void run_service();
   void stop_service();
@@ -52,9 +52,9 @@ private:
 public:
   static void create();
 
-  static G1StringDedupThread* thread();
+  static StringDedupThread* thread();
 
-  void deduplicate_shared_strings(G1StringDedupStat& stat);
+  void deduplicate_shared_strings(StringDedupStat& stat);
 };
 
-#endif // SHARE_VM_GC_G1_G1STRINGDEDUPTHREAD_HPP
+#endif // SHARE_VM_GC_SHARED_STRINGDEDUPTHREAD_HPP
@@ -23,9 +23,9 @@
  */
 
 #include "precompiled.hpp"
-#include "classfile/stringTable.hpp"
 #include "code/nmethod.hpp"
 #include "gc/shared/strongRootsScope.hpp"
+#include "runtime/safepoint.hpp"
 #include "runtime/thread.hpp"
 
 MarkScope::MarkScope() {
@@ -38,10 +38,12 @@ MarkScope::~MarkScope() {
 
 StrongRootsScope::StrongRootsScope(uint n_threads) : _n_threads(n_threads) {
   Threads::change_thread_claim_parity();
-  // Zero the claimed high water mark in the StringTable
-  StringTable::clear_parallel_claimed_index();
+  if (n_threads > 1 && SafepointSynchronize::is_at_safepoint()) {
+    Threads::sort_parallel_claim_order();
+  }
 }
 
 StrongRootsScope::~StrongRootsScope() {
+  Threads::clear_parallel_claim_order();
   Threads::assert_all_threads_claimed();
 }
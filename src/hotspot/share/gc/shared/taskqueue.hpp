@@ -356,6 +356,9 @@ protected:
 public:
   // Returns "true" if some TaskQueue in the set contains a task.
   virtual bool peek() = 0;
+  // Returns an estimate of the number of tasks in all the TaskQueues
+  // of the set.
+  virtual size_t tasks() = 0;
 };
 
 template <MEMFLAGS F> class TaskQueueSetSuperImpl: public CHeapObj<F>, public TaskQueueSetSuper {
@@ -387,6 +390,7 @@ public:
   bool steal(uint queue_num, int* seed, E& t);
 
   bool peek();
+  size_t tasks();
 
   uint size() const { return _n; }
 };
@@ -412,6 +416,15 @@ bool GenericTaskQueueSet<T, F>::peek() {
   return false;
 }
 
+template<class T, MEMFLAGS F>
+size_t GenericTaskQueueSet<T, F>::tasks() {
+  size_t n = 0;
+  for (uint j = 0; j < _n; j++) {
+    n += _queues[j]->size();
+  }
+  return n;
+}
+
 // When to terminate from the termination protocol.
 class TerminatorTerminator: public CHeapObj<mtInternal> {
 public:
@@ -423,8 +436,8 @@ public:
 
 #undef TRACESPINNING
 
-class ParallelTaskTerminator: public StackObj {
-private:
+class ParallelTaskTerminator: public CHeapObj<mtGC> {
+protected:
   uint _n_threads;
   TaskQueueSetSuper* _queue_set;
   volatile uint _offered_termination;
@@ -436,15 +449,22 @@ private:
 #endif
 
   bool peek_in_queue_set();
-protected:
   virtual void yield();
   void sleep(uint millis);
 
+  // Called when exiting termination is requested.
+  // When the request is made, terminator may have already terminated
+  // (e.g. all threads are arrived and offered termination). In this case,
+  // it should ignore the request and complete the termination.
+  // Return true if termination is completed. Otherwise, return false.
+  bool complete_or_exit_termination();
+
 public:
 
   // "n_threads" is the number of threads to be terminated.  "queue_set" is a
   // queue sets of work queues of other threads.
   ParallelTaskTerminator(uint n_threads, TaskQueueSetSuper* queue_set);
+  virtual ~ParallelTaskTerminator();
 
   // The current thread has no work, and is ready to terminate if everyone
   // else is.  If returns "true", all threads are terminated.  If returns
@@ -457,7 +477,7 @@ public:
   // As above, but it also terminates if the should_exit_termination()
   // method of the terminator parameter returns true. If terminator is
   // NULL, then it is ignored.
-  bool offer_termination(TerminatorTerminator* terminator);
+  virtual bool offer_termination(TerminatorTerminator* terminator);
 
   // Reset the terminator, so that it may be reused again.
   // The caller is responsible for ensuring that this is done
@@ -476,6 +496,25 @@ public:
 #endif
 };
 
+// Selects the termination protocol used by a parallel task, see
+// UseOWSTTaskTerminator.
+class TaskTerminator : public StackObj {
+private:
+  ParallelTaskTerminator* _terminator;
+
+  // Noncopyable.
+  TaskTerminator(const TaskTerminator&);
+  TaskTerminator& operator=(const TaskTerminator&);
+
+public:
+  TaskTerminator(uint n_threads, TaskQueueSetSuper* queue_set);
+  ~TaskTerminator();
+
+  ParallelTaskTerminator* terminator() const {
+    return _terminator;
+  }
+};
+
 typedef GenericTaskQueue<oop, mtGC>             OopTaskQueue;
 typedef GenericTaskQueueSet<OopTaskQueue, mtGC> OopTaskQueueSet;
 
@@ -546,6 +585,13 @@ public:
   inline oop obj()   const { return _obj; }
   inline int index() const { return _index; }
 
+  // Returns the end of the chunk of at most ObjArrayMarkingStride elements
+  // that starts at beg_index in an array of length len. An end below len
+  // means the rest of the array is left to a continuation task, which
+  // should be pushed before the chunk is scanned so that idle workers can
+  // steal it in the meantime.
+  static inline int chunk_end(int beg_index, int len);
+
   DEBUG_ONLY(bool is_valid() const); // Tasks to be pushed/popped must be valid.
 
 private:
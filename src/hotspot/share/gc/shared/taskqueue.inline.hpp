@@ -29,6 +29,7 @@
 #include "memory/allocation.inline.hpp"
 #include "oops/oop.inline.hpp"
 #include "runtime/atomic.hpp"
+#include "runtime/globals.hpp"
 #include "runtime/orderAccess.inline.hpp"
 #include "utilities/debug.hpp"
 #include "utilities/stack.inline.hpp"
@@ -278,4 +279,9 @@ inline void GenericTaskQueue<E, F, N>::iterate(Fn fn) {
 }
 
 
+inline int ObjArrayTask::chunk_end(int beg_index, int len) {
+  assert(beg_index < len || len == 0, "index too large");
+  return beg_index + MIN2(len - beg_index, (int) ObjArrayMarkingStride);
+}
+
 #endif // SHARE_VM_GC_SHARED_TASKQUEUE_INLINE_HPP
@@ -29,6 +29,7 @@
 #include "memory/resourceArea.hpp"
 #include "memory/universe.hpp"
 #include "oops/oop.inline.hpp"
+#include "runtime/mutexLocker.hpp"
 #include "runtime/thread.inline.hpp"
 #include "runtime/threadSMR.hpp"
 #include "utilities/copy.hpp"
@@ -73,24 +74,28 @@ void ThreadLocalAllocBuffer::accumulate_statistics() {
 
   print_stats("gc");
 
+  // Update allocation history if a reasonable amount of eden was allocated.
+  bool update_allocation_history = used > 0.5 * capacity;
+
+  if (update_allocation_history && (_number_of_refills > 0 || ResizeTLABOnRefill)) {
+    // Average the fraction of eden allocated in a tlab by this
+    // thread for use in the next resize operation.
+    // _gc_waste is not subtracted because it's included in
+    // "used".
+    // The result can be larger than 1.0 due to direct to old allocations.
+    // These allocations should ideally not be counted but since it is not possible
+    // to filter them out here we just cap the fraction to be at most 1.0.
+    // Threads that did not refill at all are sampled too when tlabs may
+    // grow on refill, so that the tlabs of cold threads shrink over time
+    // and grow back quickly once they allocate again.
+    double alloc_frac = MIN2(1.0, (double) allocated_since_last_gc / used);
+    _allocation_fraction.sample(alloc_frac);
+  }
+
   if (_number_of_refills > 0) {
-    // Update allocation history if a reasonable amount of eden was allocated.
-    bool update_allocation_history = used > 0.5 * capacity;
-
-    if (update_allocation_history) {
-      // Average the fraction of eden allocated in a tlab by this
-      // thread for use in the next resize operation.
-      // _gc_waste is not subtracted because it's included in
-      // "used".
-      // The result can be larger than 1.0 due to direct to old allocations.
-      // These allocations should ideally not be counted but since it is not possible
-      // to filter them out here we just cap the fraction to be at most 1.0.
-      double alloc_frac = MIN2(1.0, (double) allocated_since_last_gc / used);
-      _allocation_fraction.sample(alloc_frac);
-    }
     global_stats()->update_allocating_threads();
     global_stats()->update_number_of_refills(_number_of_refills);
-    global_stats()->update_allocation(_number_of_refills * desired_size());
+    global_stats()->update_allocation(_allocated_size);
     global_stats()->update_gc_waste(_gc_waste);
     global_stats()->update_slow_refill_waste(_slow_refill_waste);
     global_stats()->update_fast_refill_waste(_fast_refill_waste);
@@ -122,6 +127,7 @@ void ThreadLocalAllocBuffer::make_parsable(bool retire, bool zap) {
       set_top(NULL);
       set_pf_top(NULL);
       set_end(NULL);
+      set_allocation_end(NULL);
     }
   }
   assert(!(retire || ZeroTLAB)  ||
@@ -157,8 +163,37 @@ void ThreadLocalAllocBuffer::resize() {
   set_refill_waste_limit(initial_refill_waste_limit());
 }
 
+void ThreadLocalAllocBuffer::resize_on_refill() {
+  assert(ResizeTLAB && ResizeTLABOnRefill, "Should not call this otherwise");
+  if (_number_of_refills < _next_growth_refills) {
+    return;
+  }
+  // The desired size was chosen so that this thread refills target_refills()
+  // times between GCs. Having used that budget before the GC means the
+  // allocation rate went up, so double the size. The size is capped at the
+  // size that would let this thread alone use up eden in target_refills()
+  // refills. The next GC recomputes the size from the allocation history.
+  _next_growth_refills = _number_of_refills + target_refills();
+
+  size_t capacity = Universe::heap()->tlab_capacity(myThread()) / HeapWordSize;
+  size_t max_growth_size = MIN2(MAX2(capacity / target_refills(), min_size()), max_size());
+  size_t new_size = align_object_size(MIN2(desired_size() * 2, max_growth_size));
+  if (new_size <= desired_size()) {
+    return;
+  }
+
+  log_trace(gc, tlab)("TLAB grow: thread: " INTPTR_FORMAT " [id: %2d]"
+                      " refills %d desired_size: " SIZE_FORMAT " -> " SIZE_FORMAT,
+                      p2i(myThread()), myThread()->osthread()->thread_id(),
+                      _number_of_refills, desired_size(), new_size);
+
+  set_desired_size(new_size);
+}
+
 void ThreadLocalAllocBuffer::initialize_statistics() {
     _number_of_refills = 0;
+    _next_growth_refills = target_refills();
+    _allocated_size    = 0;
     _fast_refill_waste = 0;
     _slow_refill_waste = 0;
     _gc_waste          = 0;
@@ -169,10 +204,15 @@ void ThreadLocalAllocBuffer::fill(HeapWord* start,
                                   HeapWord* top,
                                   size_t    new_size) {
   _number_of_refills++;
+  _allocated_size += new_size;
   print_stats("fill");
   assert(top <= start + new_size - alignment_reserve(), "size too small");
   initialize(start, top, start + new_size - alignment_reserve());
 
+  if (ResizeTLAB && ResizeTLABOnRefill) {
+    resize_on_refill();
+  }
+
   // Reset amount of internal fragmentation
   set_refill_waste_limit(initial_refill_waste_limit());
 }
@@ -184,6 +224,7 @@ void ThreadLocalAllocBuffer::initialize(HeapWord* start,
   set_top(top);
   set_pf_top(top);
   set_end(end);
+  set_allocation_end(end);
   invariants();
 }
 
@@ -267,6 +308,21 @@ size_t ThreadLocalAllocBuffer::initial_desired_size() {
   return init_sz;
 }
 
+void ThreadLocalAllocBuffer::set_sample_end() {
+  size_t heap_words_remaining = pointer_delta(_allocation_end, _top);
+  size_t bytes_until_sample = myThread()->heap_sampler().bytes_until_sample();
+  size_t words_until_sample = bytes_until_sample / HeapWordSize;
+
+  if (heap_words_remaining > words_until_sample) {
+    HeapWord* new_end = _top + words_until_sample;
+    set_end(new_end);
+    _bytes_since_last_sample_point = bytes_until_sample;
+  } else {
+    set_end(_allocation_end);
+    _bytes_since_last_sample_point = heap_words_remaining * HeapWordSize;
+  }
+}
+
 void ThreadLocalAllocBuffer::print_stats(const char* tag) {
   Log(gc, tlab) log;
   if (!log.is_trace()) {
@@ -275,7 +331,7 @@ void ThreadLocalAllocBuffer::print_stats(const char* tag) {
 
   Thread* thrd = myThread();
   size_t waste = _gc_waste + _slow_refill_waste + _fast_refill_waste;
-  size_t alloc = _number_of_refills * _desired_size;
+  size_t alloc = _allocated_size;
   double waste_percent = percent_of(waste, alloc);
   size_t tlab_used  = Universe::heap()->tlab_used(thrd);
   log.trace("TLAB: %s thread: " INTPTR_FORMAT " [id: %2d]"
@@ -294,6 +350,65 @@ void ThreadLocalAllocBuffer::print_stats(const char* tag) {
             _fast_refill_waste * HeapWordSize);
 }
 
+// Sizes are bucketed by powers of two, starting at min_size().
+static const uint TLABSizeBuckets = 24;
+
+void ThreadLocalAllocBuffer::print_statistics_on(outputStream* st) {
+  if (!UseTLAB) {
+    st->print_cr("TLABs are disabled");
+    return;
+  }
+
+  size_t size_histo[TLABSizeBuckets] = { 0 };
+  size_t refills_histo[TLABSizeBuckets] = { 0 };
+  uint nthreads = 0;
+
+  ResourceMark rm;
+  // Threads_lock is needed to read the names of other threads.
+  MutexLocker ml(Threads_lock);
+  st->print_cr("%-40s %12s %10s %10s %12s", "thread", "desired(KB)", "refills", "alloc-frac", "waste(KB)");
+  for (JavaThreadIteratorWithHandle jtiwh; JavaThread *thread = jtiwh.next(); ) {
+    ThreadLocalAllocBuffer& tlab = thread->tlab();
+    // The values are read racily; they are only used for reporting.
+    size_t desired = tlab.desired_size();
+    unsigned refills = tlab._number_of_refills;
+    size_t waste = (size_t)tlab._gc_waste + tlab._slow_refill_waste + tlab._fast_refill_waste;
+    st->print_cr("%-40.40s %12.1f %10u %10.5f %12.1f",
+                 thread->get_thread_name(),
+                 (double)desired * HeapWordSize / K,
+                 refills,
+                 tlab._allocation_fraction.average(),
+                 (double)waste * HeapWordSize / K);
+
+    uint size_bucket = 0;
+    for (size_t s = min_size(); s < desired && size_bucket < TLABSizeBuckets - 1; s <<= 1) {
+      size_bucket++;
+    }
+    size_histo[size_bucket]++;
+    uint refills_bucket = 0;
+    for (unsigned r = refills; r > 0 && refills_bucket < TLABSizeBuckets - 1; r >>= 1) {
+      refills_bucket++;
+    }
+    refills_histo[refills_bucket]++;
+    nthreads++;
+  }
+
+  st->cr();
+  st->print_cr("Desired size distribution (%u threads):", nthreads);
+  for (uint i = 0; i < TLABSizeBuckets; i++) {
+    if (size_histo[i] != 0) {
+      st->print_cr("  <= " SIZE_FORMAT_W(10) "KB: " SIZE_FORMAT,
+                   (min_size() << i) * HeapWordSize / K, size_histo[i]);
+    }
+  }
+  st->print_cr("Refills since last GC distribution:");
+  for (uint i = 0; i < TLABSizeBuckets; i++) {
+    if (refills_histo[i] != 0) {
+      st->print_cr("  < %10u: " SIZE_FORMAT, 1u << i, refills_histo[i]);
+    }
+  }
+}
+
 void ThreadLocalAllocBuffer::verify() {
   HeapWord* p = start();
   HeapWord* t = top();
@@ -44,16 +44,20 @@ private:
   HeapWord* _start;                              // address of TLAB
   HeapWord* _top;                                // address after last allocation
   HeapWord* _pf_top;                             // allocation prefetch watermark
-  HeapWord* _end;                                // allocation end (excluding alignment_reserve)
+  HeapWord* _end;                                // allocation end (can be the sampling end point or _allocation_end)
+  HeapWord* _allocation_end;                     // end for allocations (actual TLAB end, excluding alignment_reserve)
   size_t    _desired_size;                       // desired size   (including alignment_reserve)
   size_t    _refill_waste_limit;                 // hold onto tlab if free() is larger than this
   size_t    _allocated_before_last_gc;           // total bytes allocated up until the last gc
+  size_t    _bytes_since_last_sample_point;      // bytes since last sample point
 
   static size_t   _max_size;                          // maximum size of any TLAB
   static int      _reserve_for_allocation_prefetch;   // Reserve at the end of the TLAB
   static unsigned _target_refills;                    // expected number of refills between GCs
 
   unsigned  _number_of_refills;
+  unsigned  _next_growth_refills;                // grow desired size when _number_of_refills reaches this
+  size_t    _allocated_size;                     // sum of tlab sizes handed out since last gc
   unsigned  _fast_refill_waste;
   unsigned  _slow_refill_waste;
   unsigned  _gc_waste;
@@ -66,6 +70,7 @@ private:
 
   void set_start(HeapWord* start)                { _start = start; }
   void set_end(HeapWord* end)                    { _end = end; }
+  void set_allocation_end(HeapWord* ptr)         { _allocation_end = ptr; }
   void set_top(HeapWord* top)                    { _top = top; }
   void set_pf_top(HeapWord* pf_top)              { _pf_top = pf_top; }
   void set_desired_size(size_t desired_size)     { _desired_size = desired_size; }
@@ -84,6 +89,10 @@ private:
   // Resize based on amount of allocation, etc.
   void resize();
 
+  // Grow the desired size if this thread refills more often than
+  // target_refills() predicts for the current GC epoch.
+  void resize_on_refill();
+
   void invariants() const { assert(top() >= start() && top() <= end(), "invalid tlab"); }
 
   void initialize(HeapWord* start, HeapWord* top, HeapWord* end);
@@ -104,7 +113,8 @@ private:
   static GlobalTLABStats* global_stats() { return _global_stats; }
 
 public:
-  ThreadLocalAllocBuffer() : _allocation_fraction(TLABAllocationWeight), _allocated_before_last_gc(0) {
+  ThreadLocalAllocBuffer() : _allocated_before_last_gc(0), _bytes_since_last_sample_point(0),
+                             _allocation_fraction(TLABAllocationWeight) {
     // do nothing.  tlabs must be inited by initialize() calls
   }
 
@@ -115,7 +125,8 @@ public:
 
   HeapWord* start() const                        { return _start; }
   HeapWord* end() const                          { return _end; }
-  HeapWord* hard_end() const                     { return _end + alignment_reserve(); }
+  HeapWord* hard_end() const                     { return _allocation_end + alignment_reserve(); }
+  HeapWord* allocation_end() const               { return _allocation_end; }
   HeapWord* top() const                          { return _top; }
   HeapWord* pf_top() const                       { return _pf_top; }
   size_t desired_size() const                    { return _desired_size; }
@@ -159,9 +170,18 @@ public:
   // Resize tlabs for all threads
   static void resize_all_tlabs();
 
+  // Print per-thread tlab sizes and refills, and their distribution
+  static void print_statistics_on(outputStream* st);
+
   void fill(HeapWord* start, HeapWord* top, size_t new_size);
   void initialize();
 
+  // Heap sampling support: lower end() to the thread's next sample point,
+  // or restore it to allocation_end() once that point has been reached.
+  void set_sample_end();
+  void set_back_allocation_end()                 { _end = _allocation_end; }
+  size_t bytes_since_last_sample_point() const   { return _bytes_since_last_sample_point; }
+
   static size_t refill_waste_limit_increment()   { return TLABWasteIncrement; }
 
   // Code generation support
@@ -273,6 +273,7 @@ class Bytecodes: AllStatic {
     _fast_iload           ,
     _fast_iload2          ,
     _fast_icaload         ,
+    _fast_iload_iadd      ,
 
     _fast_invokevfinal    ,
     _fast_linearswitch    ,
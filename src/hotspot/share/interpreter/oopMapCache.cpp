@@ -29,8 +29,10 @@
 #include "memory/allocation.inline.hpp"
 #include "memory/resourceArea.hpp"
 #include "oops/oop.inline.hpp"
+#include "runtime/atomic.hpp"
 #include "runtime/handles.inline.hpp"
 #include "runtime/signature.hpp"
+#include "runtime/timer.hpp"
 
 class OopMapCacheEntry: private InterpreterOopMap {
   friend class InterpreterOopMap;
@@ -433,6 +435,12 @@ inline unsigned int OopMapCache::hash_value_for(const methodHandle& method, int
 
 OopMapCacheEntry* volatile OopMapCache::_old_entries = NULL;
 
+volatile size_t OopMapCache::_total_lookups       = 0;
+volatile size_t OopMapCache::_total_hits          = 0;
+volatile size_t OopMapCache::_total_uncached      = 0;
+volatile size_t OopMapCache::_total_evictions     = 0;
+volatile jlong  OopMapCache::_total_compute_ticks = 0;
+
 OopMapCache::OopMapCache() {
   _array  = NEW_C_HEAP_ARRAY(OopMapCacheEntry*, _size, mtClass);
   for(int i = 0; i < _size; i++) _array[i] = NULL;
@@ -495,6 +503,10 @@ void OopMapCache::lookup(const methodHandle& method,
   int probe = hash_value_for(method, bci);
   int i;
   OopMapCacheEntry* entry = NULL;
+  const bool collect_stats = log_is_enabled(Info, interpreter, oopmap);
+  if (collect_stats) {
+    Atomic::inc(&_total_lookups);
+  }
 
   if (log_is_enabled(Debug, interpreter, oopmap)) {
     static int count = 0;
@@ -511,6 +523,9 @@ void OopMapCache::lookup(const methodHandle& method,
       entry_for->resource_copy(entry);
       assert(!entry_for->is_empty(), "A non-empty oop map should be returned");
       log_debug(interpreter, oopmap)("- found at hash %d", probe + i);
+      if (collect_stats) {
+        Atomic::inc(&_total_hits);
+      }
       return;
     }
   }
@@ -518,16 +533,23 @@ void OopMapCache::lookup(const methodHandle& method,
   // Entry is not in hashtable.
   // Compute entry
 
+  jlong start = collect_stats ? os::elapsed_counter() : 0;
   OopMapCacheEntry* tmp = NEW_C_HEAP_OBJ(OopMapCacheEntry, mtClass);
   tmp->initialize();
   tmp->fill(method, bci);
   entry_for->resource_copy(tmp);
+  if (collect_stats) {
+    Atomic::add(os::elapsed_counter() - start, &_total_compute_ticks);
+  }
 
   if (method->should_not_be_cached()) {
     // It is either not safe or not a good idea to cache this Method*
     // at this time. We give the caller of lookup() a copy of the
     // interesting info via parameter entry_for, but we don't add it to
     // the cache. See the gory details in Method*.cpp.
+    if (collect_stats) {
+      Atomic::inc(&_total_uncached);
+    }
     FREE_C_HEAP_OBJ(tmp);
     return;
   }
@@ -547,6 +569,9 @@ void OopMapCache::lookup(const methodHandle& method,
 
   // No empty slot (uncommon case). Use (some approximation of a) LRU algorithm
   // where the first entry in the collision array is replaced with the new one.
+  if (collect_stats) {
+    Atomic::inc(&_total_evictions);
+  }
   OopMapCacheEntry* old = entry_at(probe + 0);
   if (put_at(probe + 0, tmp, old)) {
     enqueue_for_cleanup(old);
@@ -590,6 +615,25 @@ void OopMapCache::cleanup_old_entries() {
     FREE_C_HEAP_OBJ(entry);
     entry = next;
   }
+
+  LogTarget(Info, interpreter, oopmap) lt;
+  if (lt.is_enabled()) {
+    LogStream ls(lt);
+    print_statistics(&ls);
+  }
+}
+
+void OopMapCache::print_statistics(outputStream* st) {
+  size_t lookups = _total_lookups;
+  size_t hits = _total_hits;
+  size_t computed = lookups - hits;
+  double hit_rate = lookups > 0 ? 100.0 * hits / lookups : 0.0;
+  double compute_ms = TimeHelper::counter_to_millis(_total_compute_ticks);
+  st->print_cr("OopMapCache: " SIZE_FORMAT " lookups, " SIZE_FORMAT " hits (%.1f%%), "
+               SIZE_FORMAT " computed (" SIZE_FORMAT " not cacheable, " SIZE_FORMAT " evictions), "
+               "%.3f ms computing, %.3f us/compute",
+               lookups, hits, hit_rate, computed, (size_t)_total_uncached, (size_t)_total_evictions,
+               compute_ms, computed > 0 ? compute_ms * 1000.0 / computed : 0.0);
 }
 
 void OopMapCache::compute_one_oop_map(const methodHandle& method, int bci, InterpreterOopMap* entry) {
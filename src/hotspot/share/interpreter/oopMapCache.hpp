@@ -158,6 +158,17 @@ class OopMapCache : public CHeapObj<mtClass> {
 
   static void enqueue_for_cleanup(OopMapCacheEntry* entry);
 
+  // Statistics over all caches, only collected if interpreter+oopmap
+  // logging is enabled at info level. Updated without locking by the
+  // GC threads doing the lookups; reported after each GC operation.
+  static volatile size_t _total_lookups;
+  static volatile size_t _total_hits;
+  static volatile size_t _total_uncached;        // computed but not cacheable
+  static volatile size_t _total_evictions;       // entries replaced on collision
+  static volatile jlong  _total_compute_ticks;   // time spent computing oop maps
+
+  static void print_statistics(outputStream* st);
+
   void flush();
 
  public:
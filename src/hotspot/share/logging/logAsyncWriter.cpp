@@ -0,0 +1,210 @@
+/*
+ * Copyright (c) 2018, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#include "precompiled.hpp"
+#include "logging/log.hpp"
+#include "logging/logAsyncWriter.hpp"
+#include "logging/logConfiguration.hpp"
+#include "logging/logFileOutput.hpp"
+#include "memory/allocation.inline.hpp"
+#include "runtime/atomic.hpp"
+#include "runtime/globals.hpp"
+#include "runtime/orderAccess.inline.hpp"
+#include "runtime/os.hpp"
+#include "utilities/align.hpp"
+
+AsyncLogWriter* AsyncLogWriter::_instance = NULL;
+
+uint AsyncLogMessage::entry_size(const char* msg) {
+  return (uint)align_up(sizeof(AsyncLogMessage) + strlen(msg) + 1, sizeof(void*));
+}
+
+AsyncLogWriter::AsyncLogWriter() : _sem(0), _io_sem(1) {
+  size_t capacity = align_down(AsyncLogBufferSize / 2, sizeof(void*));
+  for (int i = 0; i < 2; i++) {
+    _buffers[i]._base = NEW_C_HEAP_ARRAY(char, capacity, mtLogging);
+    _buffers[i]._capacity = capacity;
+    _buffers[i]._top = 0;
+    // unwritten entries must read as Reserved
+    memset(_buffers[i]._base, 0, capacity);
+  }
+  _current = &_buffers[0];
+  set_name("AsyncLog Thread");
+}
+
+char* AsyncLogWriter::reserve(size_t size) {
+  for (;;) {
+    AsyncLogBuffer* buffer = OrderAccess::load_acquire(&_current);
+    size_t top = Atomic::add(size, &buffer->_top);
+    size_t offset = top - size;
+
+    if (offset >= AsyncLogBuffer::Sealed) {
+      // The writer has taken this buffer, retry with the new one.
+      continue;
+    }
+    if (top > buffer->_capacity) {
+      // Full. The reservation crossing the end marks where the writer stops.
+      if (offset + sizeof(AsyncLogMessage) <= buffer->_capacity) {
+        AsyncLogMessage* pad = reinterpret_cast<AsyncLogMessage*>(buffer->_base + offset);
+        OrderAccess::release_store(&pad->_state, (int)AsyncLogMessage::Padding);
+      }
+      return NULL;
+    }
+    if (offset == 0) {
+      // the buffer was empty, wake up the writer
+      _sem.signal();
+    }
+    return buffer->_base + offset;
+  }
+}
+
+void AsyncLogWriter::enqueue(LogFileOutput& output, const LogDecorations& decorations, const char* msg) {
+  uint size = AsyncLogMessage::entry_size(msg);
+  char* entry = reserve(size);
+  if (entry == NULL) {
+    output.increment_dropped_messages(1);
+    return;
+  }
+
+  AsyncLogMessage* m = ::new (entry) AsyncLogMessage(&output, decorations, size);
+  strcpy(m->text(), msg);
+  OrderAccess::release_store(&m->_state, (int)AsyncLogMessage::Ready);
+}
+
+void AsyncLogWriter::enqueue(LogFileOutput& output, LogMessageBuffer::Iterator msg_iterator) {
+  // Reserve the space for all lines at once so the lines stay together.
+  size_t total = 0;
+  size_t lines = 0;
+  for (LogMessageBuffer::Iterator it = msg_iterator; !it.is_at_end(); it++) {
+    total += AsyncLogMessage::entry_size(it.message());
+    lines++;
+  }
+  if (lines == 0) {
+    return;
+  }
+
+  char* entry = reserve(total);
+  if (entry == NULL) {
+    output.increment_dropped_messages(lines);
+    return;
+  }
+
+  for (; !msg_iterator.is_at_end(); msg_iterator++) {
+    const char* msg = msg_iterator.message();
+    uint size = AsyncLogMessage::entry_size(msg);
+    AsyncLogMessage* m = ::new (entry) AsyncLogMessage(&output, msg_iterator.decorations(), size);
+    strcpy(m->text(), msg);
+    OrderAccess::release_store(&m->_state, (int)AsyncLogMessage::Ready);
+    entry += size;
+  }
+}
+
+void AsyncLogWriter::write_message(AsyncLogMessage* msg) {
+  LogFileOutput* output = msg->_output;
+
+  size_t dropped = output->take_dropped_messages();
+  if (dropped > 0) {
+    char buf[64];
+    jio_snprintf(buf, sizeof(buf), SIZE_FORMAT " messages dropped due to async logging", dropped);
+    output->write_blocking(msg->_decorations, buf);
+  }
+
+  output->write_blocking(msg->_decorations, msg->text());
+}
+
+void AsyncLogWriter::drain() {
+  AsyncLogBuffer* full = _current;
+  AsyncLogBuffer* empty = (full == &_buffers[0]) ? &_buffers[1] : &_buffers[0];
+
+  // New messages go to the other buffer from now on. Producers that still
+  // see the old buffer fail to reserve after the seal and retry.
+  OrderAccess::release_store(&_current, empty);
+  size_t top = Atomic::xchg(AsyncLogBuffer::Sealed, &full->_top);
+  size_t end = MIN2(top, full->_capacity);
+
+  size_t pos = 0;
+  while (pos + sizeof(AsyncLogMessage) <= end) {
+    AsyncLogMessage* m = reinterpret_cast<AsyncLogMessage*>(full->_base + pos);
+    int state;
+    while ((state = OrderAccess::load_acquire(&m->_state)) == AsyncLogMessage::Reserved) {
+      // the producer reserved the space but is still copying its message
+      SpinPause();
+    }
+    if (state == AsyncLogMessage::Padding) {
+      break;
+    }
+    write_message(m);
+    pos += m->_size;
+  }
+
+  // Clear what was used, unwritten entries must read as Reserved next time.
+  memset(full->_base, 0, end);
+  OrderAccess::release_store(&full->_top, (size_t)0);
+}
+
+void AsyncLogWriter::run() {
+  this->record_stack_base_and_size();
+  this->initialize_named_thread();
+
+  for (;;) {
+    _sem.wait();
+
+    _io_sem.wait();
+    while (OrderAccess::load_acquire(&_current->_top) != 0) {
+      drain();
+    }
+    _io_sem.signal();
+  }
+}
+
+void AsyncLogWriter::initialize() {
+  if (!LogConfiguration::is_async_mode()) return;
+
+  assert(_instance == NULL, "initialize() should only be invoked once");
+
+  AsyncLogWriter* self = new AsyncLogWriter();
+  if (os::create_thread(self, os::os_thread)) {
+    os::set_priority(self, NearMaxPriority);
+    os::start_thread(self);
+    // Publish the writer only once it is running, logging stays
+    // synchronous until then.
+    OrderAccess::release_store(&_instance, self);
+    log_debug(logging)("Async logging enabled, buffer size: " SIZE_FORMAT " bytes", AsyncLogBufferSize);
+  } else {
+    log_warning(logging)("Failed to create the AsyncLog thread, logging stays synchronous");
+    delete self;
+  }
+}
+
+void AsyncLogWriter::flush() {
+  AsyncLogWriter* writer = OrderAccess::load_acquire(&_instance);
+  if (writer != NULL) {
+    writer->_io_sem.wait();
+    // Messages may also sit in the other buffer, written by producers that
+    // picked it up just before an earlier swap.
+    writer->drain();
+    writer->drain();
+    writer->_io_sem.signal();
+  }
+}
@@ -0,0 +1,119 @@
+/*
+ * Copyright (c) 2018, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#ifndef SHARE_VM_LOGGING_LOGASYNCWRITER_HPP
+#define SHARE_VM_LOGGING_LOGASYNCWRITER_HPP
+
+#include "logging/logDecorations.hpp"
+#include "logging/logMessageBuffer.hpp"
+#include "runtime/semaphore.hpp"
+#include "runtime/thread.hpp"
+#include "utilities/globalDefinitions.hpp"
+
+class LogFileOutput;
+
+// A message in the buffer of the asynchronous log writer. Messages are
+// placed back to back, each header is followed by the message text.
+class AsyncLogMessage {
+  friend class AsyncLogWriter;
+
+  enum State {
+    Reserved = 0,  // space reserved, the producer has not finished yet
+    Ready,         // the message can be written out
+    Padding        // the rest of the buffer is unused
+  };
+
+  volatile int _state;
+  uint _size;                    // size of the entry including the text, aligned
+  LogFileOutput* _output;
+  LogDecorations _decorations;
+
+  AsyncLogMessage(LogFileOutput* output, const LogDecorations& decorations, uint size) :
+    _state(Reserved), _size(size), _output(output), _decorations(decorations) { }
+
+  char* text() { return reinterpret_cast<char*>(this + 1); }
+
+  static uint entry_size(const char* msg);
+};
+
+// One of the two buffers of the asynchronous log writer. Producers reserve
+// space by atomically bumping _top. The writer seals a buffer by setting
+// _top to a value beyond any capacity, after which no further space can be
+// reserved in it.
+class AsyncLogBuffer {
+  friend class AsyncLogWriter;
+
+  char* _base;
+  size_t _capacity;
+  volatile size_t _top;
+
+  static const size_t Sealed = SIZE_MAX / 2;
+};
+
+// The AsyncLogWriter thread writes the messages of all file outputs when
+// asynchronous logging (-Xlog:async) is enabled. Logging threads copy their
+// messages into the current buffer without taking a lock and only signal
+// the writer when a buffer turns non-empty. The writer swaps the buffers
+// and writes out the messages of the full one, so file I/O never stalls a
+// logging thread. Messages that do not fit into the buffer are dropped and
+// counted per output; the count is reported in the output with the next
+// message that gets through.
+class AsyncLogWriter : public NamedThread {
+ private:
+  static AsyncLogWriter* _instance;
+
+  Semaphore _sem;     // signalled when a buffer turns non-empty
+  Semaphore _io_sem;  // serializes draining between the writer and flush()
+
+  AsyncLogBuffer _buffers[2];
+  AsyncLogBuffer* volatile _current;
+
+  AsyncLogWriter();
+
+  // Reserves size bytes in the current buffer. Returns NULL if the message
+  // has to be dropped.
+  char* reserve(size_t size);
+
+  // Swaps the buffers and writes out the messages of the previous one.
+  void drain();
+  void write_message(AsyncLogMessage* msg);
+
+  virtual void run();
+
+ public:
+  void enqueue(LogFileOutput& output, const LogDecorations& decorations, const char* msg);
+  void enqueue(LogFileOutput& output, LogMessageBuffer::Iterator msg_iterator);
+
+  // Creates and starts the writer thread if -Xlog:async is in effect.
+  static void initialize();
+
+  // Returns the writer, or NULL if logging is synchronous.
+  static AsyncLogWriter* instance() { return _instance; }
+
+  // Writes out all messages enqueued so far. Must be called before a
+  // file output is deleted.
+  static void flush();
+};
+
+#endif // SHARE_VM_LOGGING_LOGASYNCWRITER_HPP
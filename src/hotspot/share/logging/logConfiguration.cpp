@@ -24,6 +24,7 @@
 #include "precompiled.hpp"
 #include "jvm.h"
 #include "logging/log.hpp"
+#include "logging/logAsyncWriter.hpp"
 #include "logging/logConfiguration.hpp"
 #include "logging/logDecorations.hpp"
 #include "logging/logDecorators.hpp"
@@ -44,6 +45,7 @@ size_t      LogConfiguration::_n_outputs = 0;
 
 LogConfiguration::UpdateListenerFunction* LogConfiguration::_listener_callbacks = NULL;
 size_t      LogConfiguration::_n_listener_callbacks = 0;
+bool        LogConfiguration::_async_mode = false;
 
 // LogFileOutput is the default type of output, its type prefix should be used if no type was specified
 static const char* implicit_output_prefix = LogFileOutput::Prefix;
@@ -210,6 +212,8 @@ void LogConfiguration::delete_output(size_t idx) {
   // Swap places with the last output and shrink the array
   _outputs[idx] = _outputs[--_n_outputs];
   _outputs = REALLOC_C_HEAP_ARRAY(LogOutput*, _outputs, _n_outputs, mtLogging);
+  // Write out pending asynchronous messages that refer to the output
+  AsyncLogWriter::flush();
   delete output;
 }
 
@@ -529,6 +533,13 @@ void LogConfiguration::print_command_line_help(outputStream* out) {
                                     " This will cause existing log files to be overwritten.");
   out->cr();
 
+  out->print_cr("Asynchronous logging (off by default):");
+  out->print_cr(" -Xlog:async");
+  out->print_cr("  All log messages to files are written by a dedicated thread."
+                " Messages that do not fit into the buffer (see AsyncLogBufferSize) are dropped,"
+                " the number of dropped messages is reported in the affected output.");
+  out->cr();
+
   out->print_cr("Some examples:");
   out->print_cr(" -Xlog");
   out->print_cr("\t Log all messages up to 'info' level to stdout with 'uptime', 'levels' and 'tags' decorations.");
@@ -33,8 +33,29 @@ jlong LogDecorations::_vm_start_time_millis = 0;
 const char* LogDecorations::_host_name = "";
 
 LogDecorations::LogDecorations(LogLevelType level, const LogTagSet &tagset, const LogDecorators &decorators)
-    : _level(level), _tagset(tagset), _millis(-1) {
-  create_decorations(decorators);
+    : _rendered(false), _level(level), _tagset(tagset), _decorators(decorators),
+      _millis(-1), _nanos(0), _elapsed_counter(0), _tid(0) {
+  capture_values();
+}
+
+LogDecorations::LogDecorations(const LogDecorations& other)
+    : _rendered(other._rendered), _level(other._level), _tagset(other._tagset),
+      _decorators(other._decorators), _millis(other._millis), _nanos(other._nanos),
+      _elapsed_counter(other._elapsed_counter), _tid(other._tid) {
+  if (!_rendered) {
+    return;
+  }
+  memcpy(_decorations_buffer, other._decorations_buffer, sizeof(_decorations_buffer));
+  // Offsets of decorators that are not in use are never initialized
+  const char* start = other._decorations_buffer;
+  for (uint i = 0; i < LogDecorators::Count; i++) {
+    char* offset = other._decoration_offset[i];
+    if (offset >= start && offset < start + DecorationsBufferSize) {
+      _decoration_offset[i] = _decorations_buffer + (offset - start);
+    } else {
+      _decoration_offset[i] = NULL;
+    }
+  }
 }
 
 void LogDecorations::initialize(jlong vm_start_time) {
@@ -45,89 +66,105 @@ void LogDecorations::initialize(jlong vm_start_time) {
   _vm_start_time_millis = vm_start_time;
 }
 
-void LogDecorations::create_decorations(const LogDecorators &decorators) {
+// Only the values that would be different if taken later, or on another
+// thread, are captured here.
+void LogDecorations::capture_values() {
+  if (_decorators.is_decorator(LogDecorators::time_decorator) ||
+      _decorators.is_decorator(LogDecorators::utctime_decorator) ||
+      _decorators.is_decorator(LogDecorators::timemillis_decorator) ||
+      _decorators.is_decorator(LogDecorators::uptimemillis_decorator)) {
+    _millis = os::javaTimeMillis();
+  }
+  if (_decorators.is_decorator(LogDecorators::timenanos_decorator)) {
+    _nanos = os::javaTimeNanos();
+  }
+  if (_decorators.is_decorator(LogDecorators::uptime_decorator) ||
+      _decorators.is_decorator(LogDecorators::uptimenanos_decorator)) {
+    _elapsed_counter = os::elapsed_counter();
+  }
+  if (_decorators.is_decorator(LogDecorators::tid_decorator)) {
+    _tid = os::current_thread_id();
+  }
+}
+
+void LogDecorations::render() const {
   char* position = _decorations_buffer;
   #define DECORATOR(full_name, abbr) \
-  if (decorators.is_decorator(LogDecorators::full_name##_decorator)) { \
+  if (_decorators.is_decorator(LogDecorators::full_name##_decorator)) { \
     _decoration_offset[LogDecorators::full_name##_decorator] = position; \
     position = create_##full_name##_decoration(position) + 1; \
   }
   DECORATOR_LIST
 #undef DECORATOR
-}
-
-jlong LogDecorations::java_millis() {
-  if (_millis < 0) {
-    _millis = os::javaTimeMillis();
-  }
-  return _millis;
+  _rendered = true;
 }
 
 #define ASSERT_AND_RETURN(written, pos) \
     assert(written >= 0, "Decorations buffer overflow"); \
     return pos + written;
 
-char* LogDecorations::create_time_decoration(char* pos) {
-  char* buf = os::iso8601_time(pos, 29);
+char* LogDecorations::create_time_decoration(char* pos) const {
+  char* buf = os::iso8601_time(_millis, pos, 29);
   int written = buf == NULL ? -1 : 29;
   ASSERT_AND_RETURN(written, pos)
 }
 
-char* LogDecorations::create_utctime_decoration(char* pos) {
-  char* buf = os::iso8601_time(pos, 29, true);
+char* LogDecorations::create_utctime_decoration(char* pos) const {
+  char* buf = os::iso8601_time(_millis, pos, 29, true);
   int written = buf == NULL ? -1 : 29;
   ASSERT_AND_RETURN(written, pos)
 }
 
-char * LogDecorations::create_uptime_decoration(char* pos) {
-  int written = jio_snprintf(pos, DecorationsBufferSize - (pos - _decorations_buffer), "%.3fs", os::elapsedTime());
+char * LogDecorations::create_uptime_decoration(char* pos) const {
+  int written = jio_snprintf(pos, DecorationsBufferSize - (pos - _decorations_buffer), "%.3fs",
+                             (double)_elapsed_counter / os::elapsed_frequency());
   ASSERT_AND_RETURN(written, pos)
 }
 
-char * LogDecorations::create_timemillis_decoration(char* pos) {
-  int written = jio_snprintf(pos, DecorationsBufferSize - (pos - _decorations_buffer), INT64_FORMAT "ms", java_millis());
+char * LogDecorations::create_timemillis_decoration(char* pos) const {
+  int written = jio_snprintf(pos, DecorationsBufferSize - (pos - _decorations_buffer), INT64_FORMAT "ms", _millis);
   ASSERT_AND_RETURN(written, pos)
 }
 
-char * LogDecorations::create_uptimemillis_decoration(char* pos) {
+char * LogDecorations::create_uptimemillis_decoration(char* pos) const {
   int written = jio_snprintf(pos, DecorationsBufferSize - (pos - _decorations_buffer),
-                             INT64_FORMAT "ms", java_millis() - _vm_start_time_millis);
+                             INT64_FORMAT "ms", _millis - _vm_start_time_millis);
   ASSERT_AND_RETURN(written, pos)
 }
 
-char * LogDecorations::create_timenanos_decoration(char* pos) {
-  int written = jio_snprintf(pos, DecorationsBufferSize - (pos - _decorations_buffer), INT64_FORMAT "ns", os::javaTimeNanos());
+char * LogDecorations::create_timenanos_decoration(char* pos) const {
+  int written = jio_snprintf(pos, DecorationsBufferSize - (pos - _decorations_buffer), INT64_FORMAT "ns", _nanos);
   ASSERT_AND_RETURN(written, pos)
 }
 
-char * LogDecorations::create_uptimenanos_decoration(char* pos) {
-  int written = jio_snprintf(pos, DecorationsBufferSize - (pos - _decorations_buffer), INT64_FORMAT "ns", os::elapsed_counter());
+char * LogDecorations::create_uptimenanos_decoration(char* pos) const {
+  int written = jio_snprintf(pos, DecorationsBufferSize - (pos - _decorations_buffer), INT64_FORMAT "ns", _elapsed_counter);
   ASSERT_AND_RETURN(written, pos)
 }
 
-char * LogDecorations::create_pid_decoration(char* pos) {
+char * LogDecorations::create_pid_decoration(char* pos) const {
   int written = jio_snprintf(pos, DecorationsBufferSize - (pos - _decorations_buffer), "%d", os::current_process_id());
   ASSERT_AND_RETURN(written, pos)
 }
 
-char * LogDecorations::create_tid_decoration(char* pos) {
+char * LogDecorations::create_tid_decoration(char* pos) const {
   int written = jio_snprintf(pos, DecorationsBufferSize - (pos - _decorations_buffer),
-                             INTX_FORMAT, os::current_thread_id());
+                             INTX_FORMAT, _tid);
   ASSERT_AND_RETURN(written, pos)
 }
 
-char* LogDecorations::create_level_decoration(char* pos) {
+char* LogDecorations::create_level_decoration(char* pos) const {
   // Avoid generating the level decoration because it may change.
   // The decoration() method has a special case for level decorations.
   return pos;
 }
 
-char* LogDecorations::create_tags_decoration(char* pos) {
+char* LogDecorations::create_tags_decoration(char* pos) const {
   int written = _tagset.label(pos, DecorationsBufferSize - (pos - _decorations_buffer));
   ASSERT_AND_RETURN(written, pos)
 }
 
-char* LogDecorations::create_hostname_decoration(char* pos) {
+char* LogDecorations::create_hostname_decoration(char* pos) const {
   int written = jio_snprintf(pos, DecorationsBufferSize - (pos - _decorations_buffer), "%s", _host_name);
   ASSERT_AND_RETURN(written, pos)
 }
@@ -29,22 +29,31 @@
 #include "memory/allocation.hpp"
 
 // Temporary object containing the necessary data for a log call's decorations (timestamps, etc).
+// The values that depend on the logging thread or the time of the call are
+// captured when the object is created, but they are only rendered as text
+// when a decoration is first asked for. Asynchronous outputs copy the
+// decorations before that, so the rendering is done by the writer thread.
 class LogDecorations {
  public:
   static const int DecorationsBufferSize = 256;
  private:
-  char _decorations_buffer[DecorationsBufferSize];
-  char* _decoration_offset[LogDecorators::Count];
+  mutable char _decorations_buffer[DecorationsBufferSize];
+  mutable char* _decoration_offset[LogDecorators::Count];
+  mutable bool _rendered;
   LogLevelType _level;
   const LogTagSet& _tagset;
+  LogDecorators _decorators;
   jlong _millis;
+  jlong _nanos;
+  jlong _elapsed_counter;
+  intx _tid;
   static jlong _vm_start_time_millis;
   static const char* _host_name;
 
-  jlong java_millis();
-  void create_decorations(const LogDecorators& decorators);
+  void capture_values();
+  void render() const;
 
-#define DECORATOR(name, abbr) char* create_##name##_decoration(char* pos);
+#define DECORATOR(name, abbr) char* create_##name##_decoration(char* pos) const;
   DECORATOR_LIST
 #undef DECORATOR
 
@@ -53,6 +62,10 @@ class LogDecorations {
 
   LogDecorations(LogLevelType level, const LogTagSet& tagset, const LogDecorators& decorators);
 
+  // Copies the decorations, the decoration strings are rebased
+  // onto the buffer of the copy.
+  LogDecorations(const LogDecorations& other);
+
   void set_level(LogLevelType level) {
     _level = level;
   }
@@ -61,6 +74,9 @@ class LogDecorations {
     if (decorator == LogDecorators::level_decorator) {
       return LogLevel::name(_level);
     }
+    if (!_rendered) {
+      render();
+    }
     return _decoration_offset[decorator];
   }
 };
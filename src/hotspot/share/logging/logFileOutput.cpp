@@ -24,6 +24,7 @@
 #include "precompiled.hpp"
 #include "jvm.h"
 #include "logging/log.hpp"
+#include "logging/logAsyncWriter.hpp"
 #include "logging/logConfiguration.hpp"
 #include "logging/logFileOutput.hpp"
 #include "memory/allocation.inline.hpp"
@@ -46,7 +47,7 @@ LogFileOutput::LogFileOutput(const char* name)
     : LogFileStreamOutput(NULL), _name(os::strdup_check_oom(name, mtLogging)),
       _file_name(NULL), _archive_name(NULL), _archive_name_len(0),
       _rotate_size(DefaultFileSize), _file_count(DefaultFileCount),
-      _current_size(0), _current_file(0), _rotation_semaphore(1) {
+      _current_size(0), _current_file(0), _rotation_semaphore(1), _dropped_messages(0) {
   assert(strstr(name, Prefix) == name, "invalid output name '%s': missing prefix: %s", name, Prefix);
   _file_name = make_file_name(name + strlen(Prefix), _pid_str, _vm_start_time_str);
 }
@@ -64,6 +65,13 @@ void LogFileOutput::set_file_name_parameters(jlong vm_start_time) {
 
 LogFileOutput::~LogFileOutput() {
   if (_stream != NULL) {
+    size_t dropped = take_dropped_messages();
+    if (dropped > 0) {
+      LogDecorations decorations(LogLevel::Warning, LogTagSetMapping<LOG_TAGS(logging)>::tagset(), _decorators);
+      char buf[64];
+      jio_snprintf(buf, sizeof(buf), SIZE_FORMAT " messages dropped due to async logging", dropped);
+      write_blocking(decorations, buf);
+    }
     if (fclose(_stream) != 0) {
       jio_fprintf(defaultStream::error_stream(), "Could not close log file '%s' (%s).\n",
                   _file_name, os::strerror(errno));
@@ -266,6 +274,36 @@ int LogFileOutput::write(const LogDecorations& decorations, const char* msg) {
     return 0;
   }
 
+  AsyncLogWriter* async_writer = AsyncLogWriter::instance();
+  if (async_writer != NULL) {
+    async_writer->enqueue(*this, decorations, msg);
+    return 0;
+  }
+
+  return write_blocking(decorations, msg);
+}
+
+int LogFileOutput::write(LogMessageBuffer::Iterator msg_iterator) {
+  if (_stream == NULL) {
+    // An error has occurred with this output, avoid writing to it.
+    return 0;
+  }
+
+  AsyncLogWriter* async_writer = AsyncLogWriter::instance();
+  if (async_writer != NULL) {
+    async_writer->enqueue(*this, msg_iterator);
+    return 0;
+  }
+
+  return write_blocking(msg_iterator);
+}
+
+int LogFileOutput::write_blocking(const LogDecorations& decorations, const char* msg) {
+  if (_stream == NULL) {
+    // An error has occurred with this output, avoid writing to it.
+    return 0;
+  }
+
   _rotation_semaphore.wait();
   int written = LogFileStreamOutput::write(decorations, msg);
   _current_size += written;
@@ -278,7 +316,7 @@ int LogFileOutput::write(const LogDecorations& decorations, const char* msg) {
   return written;
 }
 
-int LogFileOutput::write(LogMessageBuffer::Iterator msg_iterator) {
+int LogFileOutput::write_blocking(LogMessageBuffer::Iterator msg_iterator) {
   if (_stream == NULL) {
     // An error has occurred with this output, avoid writing to it.
     return 0;
@@ -25,6 +25,7 @@
 #define SHARE_VM_LOGGING_LOGFILEOUTPUT_HPP
 
 #include "logging/logFileStreamOutput.hpp"
+#include "runtime/atomic.hpp"
 #include "runtime/semaphore.hpp"
 #include "utilities/globalDefinitions.hpp"
 
@@ -62,6 +63,10 @@ class LogFileOutput : public LogFileStreamOutput {
   // Semaphore used for synchronizing file rotations and writes
   Semaphore _rotation_semaphore;
 
+  // Messages dropped since the last report because the buffer of
+  // asynchronous logging was full
+  volatile size_t _dropped_messages;
+
   void archive();
   void rotate();
   bool parse_options(const char* options, outputStream* errstream);
@@ -85,6 +90,17 @@ class LogFileOutput : public LogFileStreamOutput {
   virtual int write(const LogDecorations& decorations, const char* msg);
   virtual int write(LogMessageBuffer::Iterator msg_iterator);
   virtual void force_rotate();
+
+  // Writes to the file in the calling thread, bypassing asynchronous logging.
+  int write_blocking(const LogDecorations& decorations, const char* msg);
+  int write_blocking(LogMessageBuffer::Iterator msg_iterator);
+
+  void increment_dropped_messages(size_t count) {
+    Atomic::add(count, &_dropped_messages);
+  }
+  size_t take_dropped_messages() {
+    return Atomic::xchg((size_t)0, &_dropped_messages);
+  }
   virtual void describe(outputStream* out);
 
   virtual const char* name() const {
@@ -126,6 +126,9 @@ class ChunkPool: public CHeapObj<mtInternal> {
     }
   }
 
+  // Bytes cached in the pool; read without the lock, so only approximate
+  size_t pooled_bytes() const { return _num_chunks * _size; }
+
   // Accessors to preallocated pool's
   static ChunkPool* large_pool()  { assert(_large_pool  != NULL, "must be initialized"); return _large_pool;  }
   static ChunkPool* medium_pool() { assert(_medium_pool != NULL, "must be initialized"); return _medium_pool; }
@@ -139,6 +142,11 @@ class ChunkPool: public CHeapObj<mtInternal> {
     _tiny_pool   = new ChunkPool(Chunk::tiny_size   + Chunk::aligned_overhead_size());
   }
 
+  static size_t total_pooled_bytes() {
+    return _tiny_pool->pooled_bytes() + _small_pool->pooled_bytes() +
+           _medium_pool->pooled_bytes() + _large_pool->pooled_bytes();
+  }
+
   static void clean() {
     enum { BlocksToKeep = 5 };
      _tiny_pool->free_all_but(BlocksToKeep);
@@ -162,6 +170,10 @@ Chunk::clean_chunk_pool() {
   ChunkPool::clean();
 }
 
+size_t Chunk::pooled_bytes() {
+  return ChunkPool::total_pooled_bytes();
+}
+
 
 //--------------------------------------------------------------------------------------
 // ChunkPoolCleaner implementation
@@ -416,6 +428,21 @@ void *Arena::Arealloc(void* old_ptr, size_t old_size, size_t new_size, AllocFail
   return new_ptr;
 }
 
+bool Arena::Aextend(void* old_ptr, size_t old_size, size_t new_size) {
+  assert(new_size >= old_size, "not an extension");
+  debug_only(if (UseMallocOnly) return false;)
+  char* c_old = (char*)old_ptr;
+  size_t corrected_old_size = ARENA_ALIGN(old_size);
+  size_t corrected_new_size = ARENA_ALIGN(new_size);
+  if (c_old + corrected_old_size != _hwm ||
+      corrected_new_size > pointer_delta(_max, c_old, 1)) {
+    return false;
+  }
+  NOT_PRODUCT(inc_bytes_allocated(corrected_new_size - corrected_old_size);)
+  _hwm = c_old + corrected_new_size;
+  return true;
+}
+
 
 // Determine if pointer belongs to this Arena or not.
 bool Arena::contains( const void *ptr ) const {
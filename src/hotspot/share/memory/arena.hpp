@@ -86,6 +86,9 @@ class Chunk: CHeapObj<mtChunk> {
   static void start_chunk_pool_cleaner_task();
 
   static void clean_chunk_pool();
+
+  // Bytes held in the chunk pools, i.e. malloc'd but not in use by any arena
+  static size_t pooled_bytes();
 };
 
 //------------------------------Arena------------------------------------------
@@ -210,6 +213,10 @@ protected:
   void *Arealloc( void *old_ptr, size_t old_size, size_t new_size,
       AllocFailType alloc_failmode = AllocFailStrategy::EXIT_OOM);
 
+  // Grow the most recent allocation in place if it still fits in the
+  // current chunk.  Returns false, leaving the arena untouched, otherwise.
+  bool Aextend(void *old_ptr, size_t old_size, size_t new_size);
+
   // Move contents of this arena into an empty arena
   Arena *move_contents(Arena *empty_arena);
 
@@ -77,7 +77,7 @@ private:
   friend class ManifestStream;
   enum {
     _invalid_version = -1,
-    _current_version = 3
+    _current_version = 4
   };
 
   bool  _file_open;
@@ -125,6 +125,8 @@ public:
     size_t  _cds_i2i_entry_code_buffers_size;
     size_t  _core_spaces_size;        // number of bytes allocated by the core spaces
                                       // (mc, md, ro, rw and od).
+    int     _boot_package_count;      // number of packages the boot layer defined to
+                                      // the boot loader during dumping
     struct space_info {
       int    _crc;           // crc checksum of the current space
       size_t _file_offset;   // sizeof(this) rounded to vm page size
@@ -228,6 +230,7 @@ public:
   }
   void set_core_spaces_size(size_t s)    {  _header->_core_spaces_size = s; }
   size_t core_spaces_size()              { return _header->_core_spaces_size; }
+  int    boot_package_count()            { return _header->_boot_package_count; }
 
   static FileMapInfo* current_info() {
     CDS_ONLY(return _current_info;)
@@ -28,6 +28,7 @@
 #include "runtime/os.hpp"
 #include "services/memTracker.hpp"
 #include "utilities/align.hpp"
+#include "utilities/ostream.hpp"
 
 size_t CodeHeap::header_size() {
   return sizeof(HeapBlock);
@@ -471,15 +472,32 @@ FreeBlock* CodeHeap::search_freelist(size_t length) {
   FreeBlock* prev = NULL;
   FreeBlock* cur = _freelist;
 
-  // Search for first block that fits
+  // Search for the smallest block that fits. Picking the best fit instead
+  // of the first fit keeps large free blocks intact and the live code in
+  // the heap dense, which reduces the number of pages (and iTLB entries)
+  // touched by the code that is actually executing.
+  //
+  // The search runs with the CodeCache_lock held, so once a fitting block
+  // has been found only a bounded number of further elements is examined.
+  // Beyond that the cost of the scan would grow with the length of a
+  // fragmented freelist, while a better fit only saves a few segments.
+  const size_t max_best_fit_steps = 32;
+  size_t steps_since_fit = 0;
   while(cur != NULL) {
-    if (cur->length() >= length) {
+    if (found_block != NULL && ++steps_since_fit > max_best_fit_steps) {
+      break;
+    }
+    size_t cur_length = cur->length();
+    if (cur_length >= length && (found_block == NULL || cur_length < found_length)) {
       // Remember block, its previous element, and its length
       found_block = cur;
       found_prev  = prev;
-      found_length = found_block->length();
+      found_length = cur_length;
 
-      break;
+      if (found_length - length < CodeCacheMinBlockLength) {
+        // Exact (or at least good enough) fit, no need to search further.
+        break;
+      }
     }
     // Next element in list
     prev = cur;
@@ -520,6 +538,55 @@ FreeBlock* CodeHeap::search_freelist(size_t length) {
   return found_block;
 }
 
+/**
+ * Prints a histogram of the free blocks in this heap by size, together with
+ * the largest contiguous free space. Free space is either on the freelist or
+ * in the never allocated tail of the heap. A large amount of free space with
+ * a small largest block means that big nmethods may fail to allocate although
+ * the heap is far from full.
+ */
+void CodeHeap::print_fragmentation(outputStream* st) const {
+  // Bucket 0 holds blocks smaller than 1K, bucket i > 0 blocks in [2^(i-1)K, 2^i K).
+  const int nof_buckets = 12;
+  size_t bucket_count[nof_buckets];
+  size_t bucket_bytes[nof_buckets];
+  for (int i = 0; i < nof_buckets; i++) {
+    bucket_count[i] = 0;
+    bucket_bytes[i] = 0;
+  }
+
+  size_t free_bytes = 0;
+  size_t largest = 0;
+  for (FreeBlock* b = _freelist; b != NULL; b = b->link()) {
+    size_t size = segments_to_size(b->length());
+    int bucket = (size < K) ? 0 : MIN2(nof_buckets - 1, 1 + log2_intptr((intptr_t)(size / K)));
+    bucket_count[bucket]++;
+    bucket_bytes[bucket] += size;
+    free_bytes += size;
+    largest = MAX2(largest, size);
+  }
+  size_t tail = segments_to_size(_number_of_reserved_segments - _next_segment);
+  largest = MAX2(largest, tail);
+
+  st->print_cr("%s: free=" SIZE_FORMAT "Kb (freelist=" SIZE_FORMAT "Kb in %d blocks, tail=" SIZE_FORMAT "Kb)"
+               " largest_free=" SIZE_FORMAT "Kb fragmentation=%.1f%%",
+               name(), (free_bytes + tail) / K, free_bytes / K, _freelist_length, tail / K, largest / K,
+               (free_bytes + tail) == 0 ? 0.0 : 100.0 * (1.0 - (double)largest / (double)(free_bytes + tail)));
+  for (int i = 0; i < nof_buckets; i++) {
+    if (bucket_count[i] == 0) {
+      continue;
+    }
+    if (i == 0) {
+      st->print("        < 1Kb");
+    } else if (i == nof_buckets - 1) {
+      st->print("  >= %6dKb", 1 << (i - 1));
+    } else {
+      st->print("  < %7dKb", 1 << i);
+    }
+    st->print_cr(": " SIZE_FORMAT_W(8) " blocks " SIZE_FORMAT_W(10) "Kb", bucket_count[i], bucket_bytes[i] / K);
+  }
+}
+
 //----------------------------------------------------------------------------
 // Non-product code
 
@@ -209,6 +209,7 @@ class CodeHeap : public CHeapObj<mtCode> {
   void    set_adapter_count(int count)           {        _adapter_count = count; }
   int         full_count()                       { return _full_count; }
   void        report_full()                      {        _full_count++; }
+  void        print_fragmentation(outputStream* st) const; // Free block size histogram; needs CodeCache_lock
 
 private:
   size_t heap_unallocated_capacity() const;
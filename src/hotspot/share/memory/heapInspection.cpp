@@ -28,9 +28,12 @@
 #include "classfile/systemDictionary.hpp"
 #include "gc/shared/collectedHeap.hpp"
 #include "gc/shared/genCollectedHeap.hpp"
+#include "gc/shared/workgroup.hpp"
+#include "logging/log.hpp"
 #include "memory/heapInspection.hpp"
 #include "memory/resourceArea.hpp"
 #include "oops/oop.inline.hpp"
+#include "runtime/mutexLocker.hpp"
 #include "runtime/os.hpp"
 #include "utilities/globalDefinitions.hpp"
 #include "utilities/macros.hpp"
@@ -233,6 +236,42 @@ size_t KlassInfoTable::size_of_instances_in_words() const {
   return _size_of_instances_in_words;
 }
 
+// Return false if the entry could not be recorded on account
+// of running out of space required to create a new entry.
+bool KlassInfoTable::merge_entry(const KlassInfoEntry* cie) {
+  Klass*          k = cie->klass();
+  KlassInfoEntry* elt = lookup(k);
+  if (elt != NULL) {
+    elt->set_count(elt->count() + cie->count());
+    elt->set_words(elt->words() + cie->words());
+    _size_of_instances_in_words += cie->words();
+    return true;
+  }
+  return false;
+}
+
+class KlassInfoTableMergeClosure : public KlassInfoClosure {
+ private:
+  KlassInfoTable* _dest;
+  size_t _missed_count;
+ public:
+  KlassInfoTableMergeClosure(KlassInfoTable* table) : _dest(table), _missed_count(0) {}
+
+  void do_cinfo(KlassInfoEntry* cie) {
+    if (!_dest->merge_entry(cie)) {
+      _missed_count += cie->count();
+    }
+  }
+
+  size_t missed_count() { return _missed_count; }
+};
+
+size_t KlassInfoTable::merge(KlassInfoTable* table) {
+  KlassInfoTableMergeClosure closure(this);
+  table->iterate(&closure);
+  return closure.missed_count();
+}
+
 int KlassInfoHisto::sort_helper(KlassInfoEntry** e1, KlassInfoEntry** e2) {
   return (*e1)->compare(*e1,*e2);
 }
@@ -684,9 +723,10 @@ class RecordInstanceClosure : public ObjectClosure {
   RecordInstanceClosure(KlassInfoTable* cit, BoolObjectClosure* filter) :
     _cit(cit), _missed_count(0), _filter(filter) {}
 
+  // A NULL table only counts the visited objects as missed.
   void do_object(oop obj) {
     if (should_visit(obj)) {
-      if (!_cit->record_instance(obj)) {
+      if (_cit == NULL || !_cit->record_instance(obj)) {
         _missed_count++;
       }
     }
@@ -700,15 +740,67 @@ class RecordInstanceClosure : public ObjectClosure {
   }
 };
 
-size_t HeapInspection::populate_table(KlassInfoTable* cit, BoolObjectClosure *filter) {
+// Each worker records the objects of its part of the heap into a private
+// table and merges it into the shared table when done.
+class ParHeapInspectTask : public AbstractGangTask {
+ private:
+  ParallelObjectIterator* _poi;
+  KlassInfoTable* _shared_cit;
+  BoolObjectClosure* _filter;
+  size_t _missed_count;
+  Mutex _mutex;
+
+ public:
+  ParHeapInspectTask(ParallelObjectIterator* poi,
+                     KlassInfoTable* shared_cit,
+                     BoolObjectClosure* filter) :
+      AbstractGangTask("Iterating heap"),
+      _poi(poi),
+      _shared_cit(shared_cit),
+      _filter(filter),
+      _missed_count(0),
+      _mutex(Mutex::leaf, "Parallel heap inspection merge lock", false,
+             Mutex::_safepoint_check_never) {}
+
+  size_t missed_count() const { return _missed_count; }
+
+  virtual void work(uint worker_id) {
+    KlassInfoTable cit(false);
+    RecordInstanceClosure ric(cit.allocation_failed() ? NULL : &cit, _filter);
+    _poi->object_iterate(&ric, worker_id);
+
+    MutexLockerEx ml(&_mutex, Mutex::_no_safepoint_check_flag);
+    _missed_count += ric.missed_count();
+    if (!cit.allocation_failed()) {
+      _missed_count += _shared_cit->merge(&cit);
+    }
+  }
+};
+
+size_t HeapInspection::populate_table(KlassInfoTable* cit, BoolObjectClosure *filter,
+                                      uint parallel_thread_num) {
   ResourceMark rm;
 
+  if (parallel_thread_num > 1) {
+    CollectedHeap* heap = Universe::heap();
+    WorkGang* gang = heap->get_safepoint_workers();
+    uint num_workers = (gang == NULL) ? 1 : MIN2(parallel_thread_num, gang->active_workers());
+    ParallelObjectIterator* poi = (num_workers > 1) ? heap->parallel_object_iterator(num_workers) : NULL;
+    if (poi != NULL) {
+      log_debug(gc, heap)("Inspecting heap with %u threads", num_workers);
+      ParHeapInspectTask task(poi, cit, filter);
+      gang->run_task(&task, num_workers);
+      delete poi;
+      return task.missed_count();
+    }
+  }
+
   RecordInstanceClosure ric(cit, filter);
   Universe::heap()->object_iterate(&ric);
   return ric.missed_count();
 }
 
-void HeapInspection::heap_inspection(outputStream* st) {
+void HeapInspection::heap_inspection(outputStream* st, uint parallel_thread_num) {
   ResourceMark rm;
 
   if (_print_help) {
@@ -732,7 +824,7 @@ void HeapInspection::heap_inspection(outputStream* st) {
   KlassInfoTable cit(_print_class_stats);
   if (!cit.allocation_failed()) {
     // populate table with object allocation info
-    size_t missed_count = populate_table(&cit);
+    size_t missed_count = populate_table(&cit, NULL, parallel_thread_num);
     if (missed_count != 0) {
       st->print_cr("WARNING: Ran out of C-heap; undercounted " SIZE_FORMAT
                    " total instances in data below",
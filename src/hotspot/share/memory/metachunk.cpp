@@ -61,6 +61,7 @@ Metachunk::Metachunk(ChunkIndex chunktype, bool is_class, size_t word_size,
 {
   _top = initial_top();
   set_is_tagged_free(false);
+  set_is_payload_uncommitted(false);
 #ifdef ASSERT
   mangle(uninitMetaWordVal);
   verify();
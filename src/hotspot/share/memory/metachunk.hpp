@@ -168,6 +168,8 @@ class Metachunk : public Metabase<Metachunk> {
   const bool _is_class;
   // Whether the chunk is free (in freelist) or in use by some class loader.
   bool _is_tagged_free;
+  // Whether the payload of this free chunk has been uncommitted.
+  bool _is_payload_uncommitted;
 
   ChunkOrigin _origin;
   int _use_count;
@@ -209,6 +211,9 @@ class Metachunk : public Metabase<Metachunk> {
   bool is_tagged_free() { return _is_tagged_free; }
   void set_is_tagged_free(bool v) { _is_tagged_free = v; }
 
+  bool is_payload_uncommitted() const     { return _is_payload_uncommitted; }
+  void set_is_payload_uncommitted(bool v) { _is_payload_uncommitted = v; }
+
   bool contains(const void* ptr) { return bottom() <= ptr && ptr < _top; }
 
   void print_on(outputStream* st) const;
@@ -192,6 +192,9 @@ class ChunkManager : public CHeapObj<mtInternal> {
   size_t _free_chunks_total;
   // Number of chunks in this ChunkManager
   size_t _free_chunks_count;
+  // Size, in metaspace words, of free chunk payload which has been
+  // uncommitted and has to be committed again before the chunk is used.
+  size_t _free_chunks_uncommitted;
 
   // Update counters after a chunk was added or removed removed.
   void account_for_added_chunk(const Metachunk* c);
@@ -237,6 +240,15 @@ class ChunkManager : public CHeapObj<mtInternal> {
   // Note that this chunk is supposed to be removed from the freelist right away.
   Metachunk* split_chunk(size_t target_chunk_word_size, Metachunk* chunk);
 
+  // The part of a free chunk which can be uncommitted: all whole commit
+  // granules of the chunk except those overlapping the chunk header (for
+  // humongous chunks, the header includes the dictionary tree links).
+  static MemRegion uncommittable_region(const Metachunk* chunk);
+
+  // Commit the payload of a free chunk again, if it had been uncommitted.
+  // Must be called before the chunk memory is used or rearranged.
+  void commit_chunk(Metachunk* chunk);
+
  public:
 
   struct ChunkManagerStatistics {
@@ -245,6 +257,7 @@ class ChunkManager : public CHeapObj<mtInternal> {
     size_t total_size_by_type[NumberOfFreeLists];
     size_t num_humongous_chunks;
     size_t total_size_humongous_chunks;
+    size_t total_size_uncommitted;
   };
 
   void locked_get_statistics(ChunkManagerStatistics* stat) const;
@@ -253,7 +266,8 @@ class ChunkManager : public CHeapObj<mtInternal> {
 
 
   ChunkManager(bool is_class)
-      : _is_class(is_class), _free_chunks_total(0), _free_chunks_count(0) {
+      : _is_class(is_class), _free_chunks_total(0), _free_chunks_count(0),
+        _free_chunks_uncommitted(0) {
     _free_chunks[SpecializedIndex].set_size(get_size_for_nonhumongous_chunktype(SpecializedIndex, is_class));
     _free_chunks[SmallIndex].set_size(get_size_for_nonhumongous_chunktype(SmallIndex, is_class));
     _free_chunks[MediumIndex].set_size(get_size_for_nonhumongous_chunktype(MediumIndex, is_class));
@@ -295,6 +309,12 @@ class ChunkManager : public CHeapObj<mtInternal> {
   // Number of chunks in the free chunks list
   size_t free_chunks_count();
 
+  // Uncommit the payload of a free chunk; see MetaspaceReclaimPolicy.
+  void uncommit_chunk(Metachunk* chunk);
+
+  // Size of the free chunk payload which is currently uncommitted.
+  size_t free_chunks_uncommitted_words() const { return _free_chunks_uncommitted; }
+
   // Remove from a list by size.  Selects list based on size of chunk.
   Metachunk* free_chunks_get(size_t chunk_word_size);
 
@@ -858,6 +878,11 @@ class VirtualSpaceNode : public CHeapObj<mtClass> {
   // the smallest chunk size.
   void retire(ChunkManager* chunk_manager);
 
+  // Return memory of this node to the OS according to MetaspaceReclaimPolicy:
+  // uncommit the payload of large free chunks and, if aggressive, the
+  // committed space above top. Returns the number of words by which the
+  // committed size of the virtual space shrank.
+  size_t reclaim(ChunkManager* chunk_manager);
 
   void print_on(outputStream* st) const;
   void print_map(outputStream* st, bool is_class) const;
@@ -924,6 +949,39 @@ void VirtualSpaceNode::purge(ChunkManager* chunk_manager) {
   }
 }
 
+size_t VirtualSpaceNode::reclaim(ChunkManager* chunk_manager) {
+  if (Metaspace::reclaim_policy() == Metaspace::ReclaimNone || is_pre_committed()) {
+    return 0;
+  }
+
+  // Only chunks of medium size and above span whole commit granules
+  // beyond their header.
+  Metachunk* chunk = first_chunk();
+  Metachunk* invalid_chunk = (Metachunk*) top();
+  while (chunk < invalid_chunk) {
+    if (chunk->is_tagged_free() && chunk->get_chunk_type() >= MediumIndex) {
+      chunk_manager->uncommit_chunk(chunk);
+    }
+    chunk = (Metachunk*) (((MetaWord*)chunk) + chunk->word_size());
+  }
+
+  if (Metaspace::reclaim_policy() != Metaspace::ReclaimAggressive) {
+    return 0;
+  }
+
+  // Give back the committed space which has not been carved into chunks
+  // yet; it is committed again through expand_by() when needed.
+  char* const new_high = align_up((char*)top(), Metaspace::commit_alignment());
+  if (new_high >= high()) {
+    return 0;
+  }
+  const size_t shrink_bytes = pointer_delta(high(), new_high, 1);
+  virtual_space()->shrink_by(shrink_bytes);
+  log_trace(gc, metaspace, freelist)("Shrunk %s virtual space list node by " SIZE_FORMAT " words.",
+            (is_class() ? "class" : "non-class"), shrink_bytes / BytesPerWord);
+  return shrink_bytes / BytesPerWord;
+}
+
 void VirtualSpaceNode::print_map(outputStream* st, bool is_class) const {
 
   if (bottom() == top()) {
@@ -1183,6 +1241,9 @@ class VirtualSpaceList : public CHeapObj<mtClass> {
   // Unlink empty VirtualSpaceNodes and free it.
   void purge(ChunkManager* chunk_manager);
 
+  // Return memory of the remaining nodes to the OS.
+  void reclaim(ChunkManager* chunk_manager);
+
   void print_on(outputStream* st) const;
   void print_map(outputStream* st) const;
 
@@ -1984,6 +2045,7 @@ int ChunkManager::remove_chunks_in_area(MetaWord* p, size_t word_size) {
     // splitting function which does the same).
     ChunkList* const list = free_chunks(list_index(cur->word_size()));
     list->remove_chunk(cur);
+    commit_chunk(cur);
     num_removed ++;
     cur = next;
   }
@@ -2041,6 +2103,14 @@ void VirtualSpaceList::purge(ChunkManager* chunk_manager) {
 #endif
 }
 
+void VirtualSpaceList::reclaim(ChunkManager* chunk_manager) {
+  assert_lock_strong(SpaceManager::expand_lock());
+  VirtualSpaceListIterator iter(virtual_space_list());
+  while (iter.repeat()) {
+    VirtualSpaceNode* vsl = iter.get_next();
+    dec_committed_words(vsl->reclaim(chunk_manager));
+  }
+}
 
 // This function looks at the mmap regions in the metaspace without locking.
 // The chunks are added with store ordering and not deleted except for at
@@ -2632,6 +2702,10 @@ void ChunkManager::account_for_removed_chunk(const Metachunk* c) {
      "(now: " SIZE_FORMAT ", decrement value: " SIZE_FORMAT ").", _free_chunks_total, c->word_size());
   _free_chunks_count --;
   _free_chunks_total -= c->word_size();
+  if (c->is_payload_uncommitted()) {
+    // Only happens when the containing node is purged.
+    _free_chunks_uncommitted -= uncommittable_region(c).word_size();
+  }
 }
 
 size_t ChunkManager::free_chunks_count() {
@@ -2778,6 +2852,52 @@ ChunkList* ChunkManager::find_free_chunks_list(size_t word_size) {
   return free_chunks(index);
 }
 
+MemRegion ChunkManager::uncommittable_region(const Metachunk* chunk) {
+  const size_t granularity = Metaspace::commit_alignment();
+  const size_t header_size = MAX2(sizeof(TreeChunk<Metachunk, FreeList<Metachunk> >),
+                                  Metachunk::overhead() * BytesPerWord);
+  HeapWord* const start = (HeapWord*)align_up((char*)chunk + header_size, granularity);
+  HeapWord* const end = (HeapWord*)align_down((char*)chunk + chunk->word_size() * BytesPerWord, granularity);
+  if (start >= end) {
+    return MemRegion();
+  }
+  return MemRegion(start, end);
+}
+
+void ChunkManager::uncommit_chunk(Metachunk* chunk) {
+  assert_lock_strong(SpaceManager::expand_lock());
+  assert(chunk->is_tagged_free(), "Only free chunks can be uncommitted");
+  if (chunk->is_payload_uncommitted()) {
+    return;
+  }
+  MemRegion mr = uncommittable_region(chunk);
+  if (mr.is_empty()) {
+    return;
+  }
+  if (!os::uncommit_memory((char*)mr.start(), mr.byte_size())) {
+    log_debug(gc, metaspace, freelist)("Failed to uncommit chunk " PTR_FORMAT ".", p2i(chunk));
+    return;
+  }
+  chunk->set_is_payload_uncommitted(true);
+  _free_chunks_uncommitted += mr.word_size();
+  log_trace(gc, metaspace, freelist)("%s: uncommitted " SIZE_FORMAT " words of %s chunk " PTR_FORMAT ".",
+    (is_class() ? "class space" : "metaspace"), mr.word_size(),
+    chunk_size_name(chunk->get_chunk_type()), p2i(chunk));
+}
+
+void ChunkManager::commit_chunk(Metachunk* chunk) {
+  assert_lock_strong(SpaceManager::expand_lock());
+  if (!chunk->is_payload_uncommitted()) {
+    return;
+  }
+  MemRegion mr = uncommittable_region(chunk);
+  os::commit_memory_or_exit((char*)mr.start(), mr.byte_size(), false,
+                            "Failed to commit free metaspace chunk");
+  chunk->set_is_payload_uncommitted(false);
+  assert(_free_chunks_uncommitted >= mr.word_size(), "about to go negative");
+  _free_chunks_uncommitted -= mr.word_size();
+}
+
 // Helper for chunk splitting: given a target chunk size and a larger free chunk,
 // split up the larger chunk into n smaller chunks, at least one of which should be
 // the target chunk of target chunk size. The smaller chunks, including the target
@@ -2802,6 +2922,7 @@ Metachunk* ChunkManager::split_chunk(size_t target_chunk_word_size, Metachunk* l
 
   // Remove old chunk.
   free_chunks(larger_chunk_index)->remove_chunk(larger_chunk);
+  commit_chunk(larger_chunk);
   larger_chunk->remove_sentinel();
 
   // Prevent access to the old chunk from here on.
@@ -2956,6 +3077,9 @@ Metachunk* ChunkManager::free_chunks_get(size_t word_size) {
                                     chunk->word_size(), word_size, chunk->word_size() - word_size);
   }
 
+  // The chunk is about to be used; make its payload accessible again.
+  commit_chunk(chunk);
+
   // Chunk has been removed from the chunk manager; update counters.
   account_for_removed_chunk(chunk);
   do_update_in_use_info_for_chunk(chunk, true);
@@ -3111,6 +3235,7 @@ void ChunkManager::locked_get_statistics(ChunkManagerStatistics* stat) const {
   }
   stat->num_humongous_chunks = num_free_chunks(HumongousIndex);
   stat->total_size_humongous_chunks = size_free_chunks_in_bytes(HumongousIndex);
+  stat->total_size_uncommitted = free_chunks_uncommitted_words() * BytesPerWord;
 }
 
 void ChunkManager::get_statistics(ChunkManagerStatistics* stat) const {
@@ -3145,12 +3270,14 @@ void ChunkManager::print_statistics(const ChunkManagerStatistics* stat, outputSt
     stat->num_humongous_chunks, stat->total_size_humongous_chunks);
 
     out->print_cr("  total size: " SIZE_FORMAT " bytes.", total);
+    out->print_cr("  uncommitted: " SIZE_FORMAT " bytes.", stat->total_size_uncommitted);
   } else {
     out->print_cr("  " SIZE_FORMAT " humongous chunks, total %.2f%s",
     stat->num_humongous_chunks,
     (float)stat->total_size_humongous_chunks / scale, unit);
 
     out->print_cr("  total size: %.2f%s.", (float)total / scale, unit);
+    out->print_cr("  uncommitted: %.2f%s.", (float)stat->total_size_uncommitted / scale, unit);
   }
 
 }
@@ -4326,6 +4453,7 @@ size_t Metaspace::_first_class_chunk_word_size = 0;
 
 size_t Metaspace::_commit_alignment = 0;
 size_t Metaspace::_reserve_alignment = 0;
+Metaspace::ReclaimPolicy Metaspace::_reclaim_policy = Metaspace::ReclaimBalanced;
 
 VirtualSpaceList* Metaspace::_space_list = NULL;
 VirtualSpaceList* Metaspace::_class_space_list = NULL;
@@ -4564,6 +4692,20 @@ void Metaspace::ergo_initialize() {
   _commit_alignment  = page_size;
   _reserve_alignment = MAX2(page_size, (size_t)os::vm_allocation_granularity());
 
+  if (strcmp(MetaspaceReclaimPolicy, "none") == 0) {
+    _reclaim_policy = ReclaimNone;
+  } else if (strcmp(MetaspaceReclaimPolicy, "balanced") == 0) {
+    _reclaim_policy = ReclaimBalanced;
+  } else if (strcmp(MetaspaceReclaimPolicy, "aggressive") == 0) {
+    _reclaim_policy = ReclaimAggressive;
+  } else {
+    vm_exit_during_initialization("Invalid value for MetaspaceReclaimPolicy", MetaspaceReclaimPolicy);
+  }
+  if (UseLargePages && UseLargePagesInMetaspace) {
+    // Large pages cannot be partially uncommitted.
+    _reclaim_policy = ReclaimNone;
+  }
+
   // Do not use FLAG_SET_ERGO to update MaxMetaspaceSize, since this will
   // override if MaxMetaspaceSize was set on the command line or not.
   // This information is needed later to conform to the specification of the
@@ -4785,6 +4927,7 @@ const char* Metaspace::metadata_type_name(Metaspace::MetadataType mdtype) {
 
 void Metaspace::purge(MetadataType mdtype) {
   get_space_list(mdtype)->purge(get_chunk_manager(mdtype));
+  get_space_list(mdtype)->reclaim(get_chunk_manager(mdtype));
 }
 
 void Metaspace::purge() {
@@ -98,6 +98,12 @@ class Metaspace : public AllStatic {
     AnonymousMetaspaceType,
     ReflectionMetaspaceType
   };
+  // See MetaspaceReclaimPolicy.
+  enum ReclaimPolicy {
+    ReclaimNone,
+    ReclaimBalanced,
+    ReclaimAggressive
+  };
 
  private:
 
@@ -120,6 +126,7 @@ class Metaspace : public AllStatic {
 
   static size_t _commit_alignment;
   static size_t _reserve_alignment;
+  static ReclaimPolicy _reclaim_policy;
   DEBUG_ONLY(static bool   _frozen;)
 
   // Virtual Space lists for both classes and other metadata
@@ -190,6 +197,8 @@ class Metaspace : public AllStatic {
   static size_t commit_alignment()        { return _commit_alignment; }
   static size_t commit_alignment_words()  { return _commit_alignment / BytesPerWord; }
 
+  static ReclaimPolicy reclaim_policy()   { return _reclaim_policy; }
+
   static MetaWord* allocate(ClassLoaderData* loader_data, size_t word_size,
                             MetaspaceObj::Type type, TRAPS);
   void deallocate(MetaWord* ptr, size_t byte_size, bool is_class);
@@ -25,6 +25,7 @@
 #include "precompiled.hpp"
 #include "jvm.h"
 #include "classfile/classListParser.hpp"
+#include "classfile/classLoaderData.hpp"
 #include "classfile/classLoaderExt.hpp"
 #include "classfile/dictionary.hpp"
 #include "classfile/loaderConstraints.hpp"
@@ -56,6 +57,7 @@
 #include "oops/oop.inline.hpp"
 #include "oops/typeArrayKlass.hpp"
 #include "prims/jvmtiRedefineClasses.hpp"
+#include "runtime/arguments.hpp"
 #include "runtime/timerTrace.hpp"
 #include "runtime/os.hpp"
 #include "runtime/signature.hpp"
@@ -1722,6 +1724,85 @@ int MetaspaceShared::preload_classes(const char* class_list_path, TRAPS) {
   return class_count;
 }
 
+// Appends arg to cmd as a single word for the shell that os::fork_and_exec()
+// runs the command with. Returns false if arg cannot be quoted safely.
+static bool append_quoted_arg(stringStream* cmd, const char* arg) {
+  cmd->print(" ");
+#ifdef _WINDOWS
+  // cmd.exe has no escape for a double quote inside a quoted word, and
+  // expands %VAR% even there.
+  if (strchr(arg, '"') != NULL || strchr(arg, '%') != NULL) {
+    return false;
+  }
+  cmd->print("\"%s\"", arg);
+#else
+  // Nothing is special inside single quotes except the quote itself,
+  // which is written as '\''.
+  cmd->put('\'');
+  for (const char* p = arg; *p != '\0'; p++) {
+    if (*p == '\'') {
+      cmd->print("'\\''");
+    } else {
+      cmd->put(*p);
+    }
+  }
+  cmd->put('\'');
+#endif
+  return true;
+}
+
+// Called from before_exit() when -XX:ArchiveClassesAtExit is specified. The
+// classes loaded during this run have been recorded in DumpLoadedClassList;
+// hand the list to a separate -Xshare:dump VM that writes the archive, so
+// that the next run of the same application can map it with
+// -XX:SharedArchiveFile.
+//
+// The exiting VM waits for the dump to complete. The dump takes time
+// proportional to the number of listed classes, typically a few seconds,
+// and happens only when both flags are given explicitly.
+void MetaspaceShared::dump_archive_at_exit() {
+  if (ArchiveClassesAtExit == NULL || DumpLoadedClassList == NULL ||
+      classlist_file == NULL || !classlist_file->is_open()) {
+    return;
+  }
+  classlist_file->flush();
+
+  ResourceMark rm;
+  const char* app_class_path = Arguments::get_appclasspath();
+  if (app_class_path == NULL) {
+    app_class_path = "";
+  }
+  const char* sep = os::file_separator();
+  stringStream java;
+  java.print("%s%sbin%sjava", Arguments::get_java_home(), sep, sep);
+  stringStream class_list;
+  class_list.print("-XX:SharedClassListFile=%s", DumpLoadedClassList);
+  stringStream archive;
+  archive.print("-XX:SharedArchiveFile=%s", ArchiveClassesAtExit);
+
+  // Application classes are only archived with UseAppCDS.
+  const char* args[] = {
+    java.as_string(), "-Xshare:dump", "-XX:+UseAppCDS",
+    "-XX:+UnlockDiagnosticVMOptions",
+    class_list.as_string(), archive.as_string(), "-cp", app_class_path
+  };
+  stringStream cmd;
+  for (size_t i = 0; i < ARRAY_SIZE(args); i++) {
+    if (!append_quoted_arg(&cmd, args[i])) {
+      warning("Failed to dump shared archive %s at exit: cannot quote argument %s",
+              ArchiveClassesAtExit, args[i]);
+      return;
+    }
+  }
+
+  log_info(cds)("Dumping shared archive %s at exit:%s", ArchiveClassesAtExit, cmd.as_string());
+  int status = os::fork_and_exec(cmd.as_string());
+  if (status != 0) {
+    warning("Failed to dump shared archive %s at exit (status %d)",
+            ArchiveClassesAtExit, status);
+  }
+}
+
 // Returns true if the class's status has changed
 bool MetaspaceShared::try_link_class(InstanceKlass* ik, TRAPS) {
   assert(DumpSharedSpaces, "should only be called during dumping");
@@ -1797,7 +1878,7 @@ void MetaspaceShared::dump_closed_archive_heap_objects(
   G1CollectedHeap::heap()->begin_archive_alloc_range();
 
   // Archive interned string objects
-  StringTable::write_to_archive(closed_archive);
+  StringTable::write_to_archive();
 
   G1CollectedHeap::heap()->end_archive_alloc_range(closed_archive,
                                                    os::vm_allocation_granularity());
@@ -2039,6 +2120,7 @@ void MetaspaceShared::initialize_shared_spaces() {
   _cds_i2i_entry_code_buffers = mapinfo->cds_i2i_entry_code_buffers();
   _cds_i2i_entry_code_buffers_size = mapinfo->cds_i2i_entry_code_buffers_size();
   _core_spaces_size = mapinfo->core_spaces_size();
+  ClassLoaderData::the_null_class_loader_data()->presize_packages(mapinfo->boot_package_count());
   char* buffer = mapinfo->misc_data_patching_start();
   clone_cpp_vtables((intptr_t*)buffer);
 
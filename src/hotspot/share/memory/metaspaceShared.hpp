@@ -91,6 +91,9 @@ class MetaspaceShared : AllStatic {
   static int preload_classes(const char * class_list_path,
                              TRAPS) NOT_CDS_RETURN_(0);
 
+  // Dump the classes recorded during this run into ArchiveClassesAtExit.
+  static void dump_archive_at_exit() NOT_CDS_RETURN;
+
 #if INCLUDE_CDS_JAVA_HEAP
  private:
   static bool obj_equals(oop const& p1, oop const& p2) {
@@ -383,6 +383,11 @@ void Universe::genesis(TRAPS) {
       // Set up shared interfaces array.  (Do this before supers are set up.)
       _the_array_interfaces_array->at_put(0, SystemDictionary::Cloneable_klass());
       _the_array_interfaces_array->at_put(1, SystemDictionary::Serializable_klass());
+      // The basic type array klasses saw the placeholders; rebuild their
+      // secondary supers bitmaps now that the interfaces are known.
+      for (int i = T_BOOLEAN; i < T_LONG+1; i++) {
+        _typeArrayKlassObjs[i]->set_secondary_supers(_the_array_interfaces_array);
+      }
     }
 
     initialize_basic_type_klass(boolArrayKlassObj(), CHECK);
@@ -226,6 +226,11 @@ namespace AccessInternal {
     resolve_barrier_gc() {
       BarrierSet* bs = BarrierSet::barrier_set();
       assert(bs != NULL, "GC barriers invoked before BarrierSet is set");
+#ifdef HARDWIRED_BARRIER_SET
+      assert(bs->kind() == BarrierSet::HARDWIRED_BARRIER_SET, "VM built for a different barrier set");
+      return PostRuntimeDispatch<typename BarrierSet::GetType<BarrierSet::HARDWIRED_BARRIER_SET>::type::
+        AccessBarrier<ds>, barrier_type, ds>::oop_access_barrier;
+#else
       switch (bs->kind()) {
 #define BARRIER_SET_RESOLVE_BARRIER_CLOSURE(bs_name)                    \
         case BarrierSet::bs_name: {                                     \
@@ -240,6 +245,7 @@ namespace AccessInternal {
         fatal("BarrierSet AccessBarrier resolving not implemented");
         return NULL;
       };
+#endif
     }
 
     template <DecoratorSet ds>
@@ -249,6 +255,11 @@ namespace AccessInternal {
     resolve_barrier_gc() {
       BarrierSet* bs = BarrierSet::barrier_set();
       assert(bs != NULL, "GC barriers invoked before BarrierSet is set");
+#ifdef HARDWIRED_BARRIER_SET
+      assert(bs->kind() == BarrierSet::HARDWIRED_BARRIER_SET, "VM built for a different barrier set");
+      return PostRuntimeDispatch<typename BarrierSet::GetType<BarrierSet::HARDWIRED_BARRIER_SET>::type::
+        AccessBarrier<ds>, barrier_type, ds>::access_barrier;
+#else
       switch (bs->kind()) {
 #define BARRIER_SET_RESOLVE_BARRIER_CLOSURE(bs_name)                    \
         case BarrierSet::bs_name: {                                       \
@@ -263,6 +274,7 @@ namespace AccessInternal {
         fatal("BarrierSet AccessBarrier resolving not implemented");
         return NULL;
       };
+#endif
     }
 
     static FunctionPointerT resolve_barrier_rt() {
@@ -288,6 +300,16 @@ namespace AccessInternal {
   // it resolves which accessor to be used in future invocations and patches the
   // function pointer to this new accessor.
 
+  // When a barrier set is hardwired at build time, the resolved accessor is
+  // known statically (up to UseCompressedOops), so it is called directly and
+  // can be inlined, instead of going through the patched function pointer.
+#ifdef HARDWIRED_BARRIER_SET
+#define ACCESS_RUNTIME_DISPATCH(func, barrier_type) \
+  (BarrierResolver<decorators, func_t, barrier_type>::resolve_barrier())
+#else
+#define ACCESS_RUNTIME_DISPATCH(func, barrier_type) (func)
+#endif
+
   template <DecoratorSet decorators, typename T, BarrierType type>
   struct RuntimeDispatch: AllStatic {};
 
@@ -303,7 +325,7 @@ namespace AccessInternal {
     }
 
     static inline void store(void* addr, T value) {
-      _store_func(addr, value);
+      ACCESS_RUNTIME_DISPATCH(_store_func, BARRIER_STORE)(addr, value);
     }
   };
 
@@ -319,7 +341,7 @@ namespace AccessInternal {
     }
 
     static inline void store_at(oop base, ptrdiff_t offset, T value) {
-      _store_at_func(base, offset, value);
+      ACCESS_RUNTIME_DISPATCH(_store_at_func, BARRIER_STORE_AT)(base, offset, value);
     }
   };
 
@@ -335,7 +357,7 @@ namespace AccessInternal {
     }
 
     static inline T load(void* addr) {
-      return _load_func(addr);
+      return ACCESS_RUNTIME_DISPATCH(_load_func, BARRIER_LOAD)(addr);
     }
   };
 
@@ -351,7 +373,7 @@ namespace AccessInternal {
     }
 
     static inline T load_at(oop base, ptrdiff_t offset) {
-      return _load_at_func(base, offset);
+      return ACCESS_RUNTIME_DISPATCH(_load_at_func, BARRIER_LOAD_AT)(base, offset);
     }
   };
 
@@ -367,7 +389,7 @@ namespace AccessInternal {
     }
 
     static inline T atomic_cmpxchg(T new_value, void* addr, T compare_value) {
-      return _atomic_cmpxchg_func(new_value, addr, compare_value);
+      return ACCESS_RUNTIME_DISPATCH(_atomic_cmpxchg_func, BARRIER_ATOMIC_CMPXCHG)(new_value, addr, compare_value);
     }
   };
 
@@ -383,7 +405,7 @@ namespace AccessInternal {
     }
 
     static inline T atomic_cmpxchg_at(T new_value, oop base, ptrdiff_t offset, T compare_value) {
-      return _atomic_cmpxchg_at_func(new_value, base, offset, compare_value);
+      return ACCESS_RUNTIME_DISPATCH(_atomic_cmpxchg_at_func, BARRIER_ATOMIC_CMPXCHG_AT)(new_value, base, offset, compare_value);
     }
   };
 
@@ -399,7 +421,7 @@ namespace AccessInternal {
     }
 
     static inline T atomic_xchg(T new_value, void* addr) {
-      return _atomic_xchg_func(new_value, addr);
+      return ACCESS_RUNTIME_DISPATCH(_atomic_xchg_func, BARRIER_ATOMIC_XCHG)(new_value, addr);
     }
   };
 
@@ -415,7 +437,7 @@ namespace AccessInternal {
     }
 
     static inline T atomic_xchg_at(T new_value, oop base, ptrdiff_t offset) {
-      return _atomic_xchg_at_func(new_value, base, offset);
+      return ACCESS_RUNTIME_DISPATCH(_atomic_xchg_at_func, BARRIER_ATOMIC_XCHG_AT)(new_value, base, offset);
     }
   };
 
@@ -431,7 +453,7 @@ namespace AccessInternal {
     }
 
     static inline bool arraycopy(arrayOop src_obj, arrayOop dst_obj, T *src, T* dst, size_t length) {
-      return _arraycopy_func(src_obj, dst_obj, src, dst, length);
+      return ACCESS_RUNTIME_DISPATCH(_arraycopy_func, BARRIER_ARRAYCOPY)(src_obj, dst_obj, src, dst, length);
     }
   };
 
@@ -447,7 +469,7 @@ namespace AccessInternal {
     }
 
     static inline void clone(oop src, oop dst, size_t size) {
-      _clone_func(src, dst, size);
+      ACCESS_RUNTIME_DISPATCH(_clone_func, BARRIER_CLONE)(src, dst, size);
     }
   };
 
@@ -463,10 +485,12 @@ namespace AccessInternal {
     }
 
     static inline oop resolve(oop obj) {
-      return _resolve_func(obj);
+      return ACCESS_RUNTIME_DISPATCH(_resolve_func, BARRIER_RESOLVE)(obj);
     }
   };
 
+#undef ACCESS_RUNTIME_DISPATCH
+
   // Initialize the function pointers to point to the resolving function.
   template <DecoratorSet decorators, typename T>
   typename AccessFunction<decorators, T, BARRIER_STORE>::type
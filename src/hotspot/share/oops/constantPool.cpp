@@ -355,6 +355,23 @@ void ConstantPool::restore_unshareable_info(TRAPS) {
   }
 }
 
+// The holder and its supertypes are the only classes that are guaranteed to
+// be loaded, and to be the very same archived classes, whenever the holder
+// is loaded from the archive (see SystemDictionary::load_shared_class). A
+// class entry that resolves to one of them can be kept resolved.
+bool ConstantPool::can_archive_resolved_klass(Klass* k) {
+  if (!ArchiveResolvedConstants || k == NULL) {
+    return false;
+  }
+  InstanceKlass* holder = pool_holder();
+  if (!holder->is_shared_boot_class() && !holder->is_shared_platform_class() &&
+      !holder->is_shared_app_class()) {
+    // Only classes defined by the builtin loaders.
+    return false;
+  }
+  return k == holder || holder->is_subtype_of(k);
+}
+
 void ConstantPool::remove_unshareable_info() {
   // Resolved references are not in the shared archive.
   // Save the length for restoration.  It is not necessarily the same length
@@ -380,12 +397,15 @@ void ConstantPool::remove_unshareable_info() {
   for (int index = 1; index < length(); index++) { // Index 0 is unused
     assert(!tag_at(index).is_unresolved_klass_in_error(), "This must not happen during dump time");
     if (tag_at(index).is_klass()) {
+      CPKlassSlot kslot = klass_slot_at(index);
+      int resolved_klass_index = kslot.resolved_klass_index();
+      if (can_archive_resolved_klass(resolved_klasses()->at(resolved_klass_index))) {
+        continue;
+      }
       // This class was resolved as a side effect of executing Java code
       // during dump time. We need to restore it back to an UnresolvedClass,
       // so that the proper class loading and initialization can happen
       // at runtime.
-      CPKlassSlot kslot = klass_slot_at(index);
-      int resolved_klass_index = kslot.resolved_klass_index();
       int name_index = kslot.name_index();
       assert(tag_at(name_index).is_symbol(), "sanity");
       resolved_klasses()->at_put(resolved_klass_index, NULL);
@@ -72,6 +72,30 @@ void ConstantPoolCacheEntry::reinitialize(bool f2_used) {
   }
 }
 
+// An instance field declared by the pool holder itself resolves to the same
+// holder and offset at run time: the layout of an archived class is fixed,
+// no loader constraint is involved, and getfield/putfield need no class
+// initialization barrier. Such entries can stay resolved in the archive.
+bool ConstantPoolCacheEntry::can_archive_resolved_field(InstanceKlass* pool_holder) const {
+  if (!ArchiveResolvedConstants || !is_field_entry() || is_f1_null()) {
+    return false;
+  }
+  Bytecodes::Code get_code = bytecode_1();
+  Bytecodes::Code put_code = bytecode_2();
+  if (get_code != Bytecodes::_getfield && put_code != Bytecodes::_putfield) {
+    return false;
+  }
+  return f1_as_klass() == pool_holder;
+}
+
+void ConstantPoolCacheEntry::metaspace_pointers_do(MetaspaceClosure* it) {
+  // Only the field entries kept by walk_entries_for_initialization() have a
+  // non-NULL _f1 at this point; it is the pool holder.
+  if (is_field_entry() && !is_f1_null()) {
+    it->push((Klass**)&_f1);
+  }
+}
+
 int ConstantPoolCacheEntry::make_flags(TosState state,
                                        int option_bits,
                                        int field_index_or_method_params) {
@@ -564,7 +588,7 @@ void ConstantPoolCacheEntry::adjust_method_entry(Method* old_method,
 
 // a constant pool cache entry should never contain old or obsolete methods
 bool ConstantPoolCacheEntry::check_no_old_or_obsolete_entries() {
-  Method* m = get_interesting_method_entry(NULL);
+  Method* m = get_interesting_method_entry();
   // return false if m refers to a non-deleted old or obsolete method
   if (m != NULL) {
     assert(m->is_valid() && m->is_method(), "m is a valid method");
@@ -574,7 +598,7 @@ bool ConstantPoolCacheEntry::check_no_old_or_obsolete_entries() {
   }
 }
 
-Method* ConstantPoolCacheEntry::get_interesting_method_entry(Klass* k) {
+Method* ConstantPoolCacheEntry::get_interesting_method_entry() {
   if (!is_method_entry()) {
     // not a method entry so not interesting by default
     return NULL;
@@ -595,12 +619,11 @@ Method* ConstantPoolCacheEntry::get_interesting_method_entry(Klass* k) {
     }
   }
   assert(m != NULL && m->is_method(), "sanity check");
-  if (m == NULL || !m->is_method() || (k != NULL && m->method_holder() != k)) {
-    // robustness for above sanity checks or method is not in
-    // the interesting class
+  if (m == NULL || !m->is_method()) {
+    // robustness for above sanity checks
     return NULL;
   }
-  // the method is in the interesting class so the entry is interesting
+  // the entry holds a method so it is interesting
   return m;
 }
 #endif // INCLUDE_JVMTI
@@ -728,6 +751,9 @@ void ConstantPoolCache::walk_entries_for_initialization(bool check_only) {
       })
   } else {
     for (int i=0; i<length(); i++) {
+      if (entry_at(i)->can_archive_resolved_field(ik)) {
+        continue;
+      }
       entry_at(i)->reinitialize(f2_used[i]);
     }
   }
@@ -760,10 +786,10 @@ void ConstantPoolCache::set_archived_references(oop o) {
 // RedefineClasses() API support:
 // If any entry of this ConstantPoolCache points to any of
 // old_methods, replace it with the corresponding new_method.
-void ConstantPoolCache::adjust_method_entries(InstanceKlass* holder, bool * trace_name_printed) {
+void ConstantPoolCache::adjust_method_entries(bool * trace_name_printed) {
   for (int i = 0; i < length(); i++) {
     ConstantPoolCacheEntry* entry = entry_at(i);
-    Method* old_method = entry->get_interesting_method_entry(holder);
+    Method* old_method = entry->get_interesting_method_entry();
     if (old_method == NULL || !old_method->is_old()) {
       continue; // skip uninteresting entries
     }
@@ -772,10 +798,7 @@ void ConstantPoolCache::adjust_method_entries(InstanceKlass* holder, bool * trac
       entry->initialize_entry(entry->constant_pool_index());
       continue;
     }
-    Method* new_method = holder->method_with_idnum(old_method->orig_method_idnum());
-
-    assert(new_method != NULL, "method_with_idnum() should not be NULL");
-    assert(old_method != new_method, "sanity check");
+    Method* new_method = old_method->get_new_method();
 
     entry_at(i)->adjust_method_entry(old_method, new_method, trace_name_printed);
   }
@@ -784,7 +807,7 @@ void ConstantPoolCache::adjust_method_entries(InstanceKlass* holder, bool * trac
 // the constant pool cache should never contain old or obsolete methods
 bool ConstantPoolCache::check_no_old_or_obsolete_entries() {
   for (int i = 1; i < length(); i++) {
-    if (entry_at(i)->get_interesting_method_entry(NULL) != NULL &&
+    if (entry_at(i)->get_interesting_method_entry() != NULL &&
         !entry_at(i)->check_no_old_or_obsolete_entries()) {
       return false;
     }
@@ -794,7 +817,7 @@ bool ConstantPoolCache::check_no_old_or_obsolete_entries() {
 
 void ConstantPoolCache::dump_cache() {
   for (int i = 1; i < length(); i++) {
-    if (entry_at(i)->get_interesting_method_entry(NULL) != NULL) {
+    if (entry_at(i)->get_interesting_method_entry() != NULL) {
       entry_at(i)->print(tty, i);
     }
   }
@@ -805,6 +828,11 @@ void ConstantPoolCache::metaspace_pointers_do(MetaspaceClosure* it) {
   log_trace(cds)("Iter(ConstantPoolCache): %p", this);
   it->push(&_constant_pool);
   it->push(&_reference_map);
+  if (DumpSharedSpaces) {
+    for (int i = 0; i < length(); i++) {
+      entry_at(i)->metaspace_pointers_do(it);
+    }
+  }
 }
 
 // Printing
@@ -94,6 +94,9 @@ bool Klass::search_secondary_supers(Klass* k) const {
   // This is necessary, since I am never in my own secondary_super list.
   if (this == k)
     return true;
+  // A clear bit in the bitmap means no secondary super hashes to k's slot.
+  if ((_secondary_supers_bitmap & (uintx(1) << k->hash_slot())) == 0)
+    return false;
   // Scan the array-of-objects for a match
   int cnt = secondary_supers()->length();
   for (int i = 0; i < cnt; i++) {
@@ -188,6 +191,35 @@ Klass::Klass() : _prototype_header(markOopDesc::prototype()),
   CDS_JAVA_HEAP_ONLY(_archived_mirror = 0;)
   _primary_supers[0] = this;
   set_super_check_offset(in_bytes(primary_supers_offset()));
+  _hash_slot = compute_hash_slot(this);
+  _secondary_supers_bitmap = SECONDARY_SUPERS_BITMAP_FULL;
+}
+
+// Klasses never move once allocated in metaspace (and shared klasses are
+// mapped back at their dump time address), so the address is a stable key.
+// Fibonacci hashing spreads the aligned addresses over the word's bits.
+u1 Klass::compute_hash_slot(const Klass* k) {
+  uintx h = (uintx)k >> LogKlassAlignmentInBytes;
+  h *= LP64_ONLY(CONST64(0x9E3779B97F4A7C15)) NOT_LP64(0x9E3779B9U);
+  return (u1)(h >> (BitsPerWord - LogBitsPerWord));
+}
+
+void Klass::set_secondary_supers(Array<Klass*>* secondaries) {
+  _secondary_supers = secondaries;
+  uintx bitmap = 0;
+  if (secondaries != NULL) {
+    for (int i = 0; i < secondaries->length(); i++) {
+      Klass* k = secondaries->at(i);
+      if (k == NULL) {
+        // Bootstrap placeholder (see Universe::genesis); its final value is
+        // not known yet, so every lookup must scan the array.
+        bitmap = SECONDARY_SUPERS_BITMAP_FULL;
+        break;
+      }
+      bitmap |= uintx(1) << k->hash_slot();
+    }
+  }
+  _secondary_supers_bitmap = bitmap;
 }
 
 jint Klass::array_layout_helper(BasicType etype) {
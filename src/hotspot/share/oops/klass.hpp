@@ -73,6 +73,9 @@ class Klass : public Metadata {
   // for better cache behavior (may not make much of a difference but sure won't hurt)
   enum { _primary_super_limit = 8 };
 
+  // Bitmap value that forces a scan of _secondary_supers on every lookup
+  static const uintx SECONDARY_SUPERS_BITMAP_FULL = ~(uintx)0;
+
   // The "layout helper" is a combined descriptor of object layout.
   // For klasses which are neither instance nor array, the value is zero.
   //
@@ -117,6 +120,9 @@ class Klass : public Metadata {
   Klass*      _secondary_super_cache;
   // Array of all secondary supertypes
   Array<Klass*>* _secondary_supers;
+  // One bit per hash slot of the klasses in _secondary_supers.  A clear
+  // bit proves a klass with that slot is not a secondary supertype.
+  uintx       _secondary_supers_bitmap;
   // Ordered list of all primary supertypes
   Klass*      _primary_supers[_primary_super_limit];
   // java/lang/Class instance mirroring this class
@@ -149,6 +155,9 @@ class Klass : public Metadata {
   // vtable length
   int _vtable_len;
 
+  // Slot of this klass in the secondary supers bitmap of its subtypes
+  u1  _hash_slot;
+
 private:
   // This is an index into FileMapHeader::_classpath_entry_table[], to
   // associate this class with the JAR file where it's loaded from during
@@ -206,7 +215,15 @@ protected:
   void set_secondary_super_cache(Klass* k) { _secondary_super_cache = k; }
 
   Array<Klass*>* secondary_supers() const { return _secondary_supers; }
-  void set_secondary_supers(Array<Klass*>* k) { _secondary_supers = k; }
+  void set_secondary_supers(Array<Klass*>* k);
+
+  uintx secondary_supers_bitmap() const   { return _secondary_supers_bitmap; }
+
+  // Bit index of this klass in the secondary supers bitmap of its subtypes.
+  u1 hash_slot() const                    { return _hash_slot; }
+ private:
+  static u1 compute_hash_slot(const Klass* k);
+ public:
 
   // Return the element of the _super chain of the given depth.
   // If there is no such element, return either NULL or this.
@@ -321,6 +338,8 @@ protected:
   static ByteSize primary_supers_offset()        { return in_ByteSize(offset_of(Klass, _primary_supers)); }
   static ByteSize secondary_super_cache_offset() { return in_ByteSize(offset_of(Klass, _secondary_super_cache)); }
   static ByteSize secondary_supers_offset()      { return in_ByteSize(offset_of(Klass, _secondary_supers)); }
+  static ByteSize secondary_supers_bitmap_offset() { return in_ByteSize(offset_of(Klass, _secondary_supers_bitmap)); }
+  static ByteSize hash_slot_offset()             { return in_ByteSize(offset_of(Klass, _hash_slot)); }
   static ByteSize java_mirror_offset()           { return in_ByteSize(offset_of(Klass, _java_mirror)); }
   static ByteSize modifier_flags_offset()        { return in_ByteSize(offset_of(Klass, _modifier_flags)); }
   static ByteSize layout_helper_offset()         { return in_ByteSize(offset_of(Klass, _layout_helper)); }
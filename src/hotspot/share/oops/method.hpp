@@ -749,6 +749,16 @@ class Method : public Metadata {
   bool is_deleted() const                           { return access_flags().is_deleted(); }
   void set_is_deleted()                             { _access_flags.set_is_deleted(); }
 
+  // The current version of this old method in its (redefined) holder
+  Method* get_new_method() const {
+    InstanceKlass* holder = method_holder();
+    Method* new_method = holder->method_with_idnum(orig_method_idnum());
+
+    assert(new_method != NULL, "method_with_idnum() should not be NULL");
+    assert(this != new_method, "sanity check");
+    return new_method;
+  }
+
   bool is_running_emcp() const {
     // EMCP methods are old but not obsolete or deleted. Equivalent
     // Modulo Constant Pool means the method is equivalent except
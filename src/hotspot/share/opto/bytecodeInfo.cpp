@@ -103,6 +103,20 @@ static bool is_unboxing_method(ciMethod* callee_method, Compile* C) {
   return C->eliminate_boxing() && callee_method->is_unboxing_method();
 }
 
+/**
+ *  Is the call site frequent enough to inline callees up to FreqInlineSize?
+ */
+static bool is_hot_call_site(ciMethod* caller_method, ciCallProfile& profile) {
+  int call_site_count  = caller_method->scale_count(profile.count());
+  int invoke_count     = caller_method->interpreter_invocation_count();
+  if (invoke_count == 0) {
+    return false;
+  }
+  int freq = call_site_count / invoke_count;
+  return (freq >= InlineFrequencyRatio) ||
+         (call_site_count >= InlineFrequencyCount);
+}
+
 // positive filter: should callee be inlined?
 bool InlineTree::should_inline(ciMethod* callee_method, ciMethod* caller_method,
                                int caller_bci, ciCallProfile& profile,
@@ -196,6 +210,7 @@ bool InlineTree::should_inline(ciMethod* callee_method, ciMethod* caller_method,
 bool InlineTree::should_not_inline(ciMethod *callee_method,
                                    ciMethod* caller_method,
                                    JVMState* jvms,
+                                   ciCallProfile& profile,
                                    WarmCallInfo* wci_result) {
 
   const char* fail_msg = NULL;
@@ -263,8 +278,13 @@ bool InlineTree::should_not_inline(ciMethod *callee_method,
     return false;
   }
 
+  // The compiled size includes everything the callee inlined, most of
+  // which may be cold. At hot call sites judge the callee by its own
+  // bytecode size instead; its callees go through these checks again.
   if (callee_method->has_compiled_code() &&
-      callee_method->instructions_size() > InlineSmallCode) {
+      callee_method->instructions_size() > InlineSmallCode &&
+      (!is_hot_call_site(caller_method, profile) ||
+       callee_method->code_size_for_inlining() > C->freq_inline_size())) {
     set_msg("already compiled into a big method");
     return true;
   }
@@ -339,7 +359,7 @@ bool InlineTree::try_to_inline(ciMethod* callee_method, ciMethod* caller_method,
                      wci_result)) {
     return false;
   }
-  if (should_not_inline(callee_method, caller_method, jvms, wci_result)) {
+  if (should_not_inline(callee_method, caller_method, jvms, profile, wci_result)) {
     return false;
   }
 
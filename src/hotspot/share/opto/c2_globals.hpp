@@ -263,6 +263,12 @@
   product(bool, UseFPUForSpilling, false,                                   \
           "Spill integer registers to FPU instead of stack when possible")  \
                                                                             \
+  product(intx, RegAllocTimeLimit, 0,                                       \
+          "Give up on C2 compilation of a method, leaving it to C1 code, "  \
+          "if register allocation split/recycle rounds run longer than "    \
+          "this many milliseconds (0 means no limit)")                      \
+          range(0, max_jint)                                                \
+                                                                            \
   develop_pd(intx, RegisterCostAreaRatio,                                   \
           "Spill selection in reg allocator: scale area by (X/64K) before " \
           "adding cost")                                                    \
@@ -393,6 +399,12 @@
   product(bool, UseOnlyInlinedBimorphic, true,                              \
           "Don't use BimorphicInlining if can't inline a second method")    \
                                                                             \
+  product(intx, PolymorphicInlineLimit, 4,                                  \
+          "Max number of receiver types inlined behind type checks at a "   \
+          "call site when all its receivers are profiled. Limited by "      \
+          "TypeProfileWidth")                                               \
+          range(2, 8)                                                       \
+                                                                            \
   product(bool, InsertMemBarAfterArraycopy, true,                           \
           "Insert memory barrier after arraycopy call")                     \
                                                                             \
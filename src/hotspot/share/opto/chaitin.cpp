@@ -41,6 +41,7 @@
 #include "opto/movenode.hpp"
 #include "opto/opcodes.hpp"
 #include "opto/rootnode.hpp"
+#include "runtime/os.hpp"
 #include "utilities/align.hpp"
 
 #ifndef PRODUCT
@@ -347,6 +348,7 @@ void PhaseChaitin::Register_Allocate() {
   _trip_cnt = 0;
   _alternate = 0;
   _matcher._allocation_started = true;
+  const jlong start_ns = os::javaTimeNanos();
 
   ResourceArea split_arena(mtCompiler);     // Arena for Split local resources
   ResourceArea live_arena(mtCompiler);      // Arena for liveness & IFG info
@@ -528,6 +530,14 @@ void PhaseChaitin::Register_Allocate() {
       }
     }
 
+    // Another round costs as much as the first; if the budget is already
+    // spent, leave this method to the cheaper tiers instead.
+    if (RegAllocTimeLimit > 0 &&
+        (os::javaTimeNanos() - start_ns) / NANOSECS_PER_MILLISEC > RegAllocTimeLimit) {
+      C->record_method_not_compilable("register allocation exceeded RegAllocTimeLimit");
+      return;
+    }
+
     if (!_lrg_map.max_lrg_id()) {
       return;
     }
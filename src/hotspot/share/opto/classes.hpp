@@ -341,8 +341,11 @@ macro(URShiftVS)
 macro(URShiftVI)
 macro(URShiftVL)
 macro(AndV)
+macro(AndReductionVI)
 macro(OrV)
+macro(OrReductionVI)
 macro(XorV)
+macro(XorReductionVI)
 macro(LoadVector)
 macro(StoreVector)
 macro(Pack)
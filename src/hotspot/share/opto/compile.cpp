@@ -1057,6 +1057,7 @@ Compile::Compile( ciEnv* ci_env,
 // Prepare for a single compilation
 void Compile::Init(int aliaslevel) {
   _unique  = 0;
+  clear_recycled_out_arrays();
   _regalloc = NULL;
 
   _tf      = NULL;  // filled in later
@@ -3229,6 +3230,9 @@ void Compile::final_graph_reshaping_impl( Node *n, Final_Reshape_Counts &frc) {
   case Op_MulReductionVL:
   case Op_MulReductionVF:
   case Op_MulReductionVD:
+  case Op_AndReductionVI:
+  case Op_OrReductionVI:
+  case Op_XorReductionVI:
     break;
 
   case Op_PackB:
@@ -4600,3 +4604,41 @@ void CloneMap::dump(node_idx_t key) const {
     ni.dump();
   }
 }
+
+//------------------------------alloc_out_array--------------------------------
+// Out arrays are power-of-2 sized.  Arrays released by dead nodes are kept
+// on per-size free lists (threaded through their first slot) so that
+// IGVN's churn of short-lived nodes does not keep growing the node arena.
+Node** Compile::alloc_out_array(uint len) {
+  assert(is_power_of_2(len) && len >= 4, "out arrays are power-of-2 sized");
+  int bucket = log2_intptr(len);
+  if (bucket < out_array_buckets) {
+    Node** out = _recycled_out_arrays[bucket];
+    if (out != NULL) {
+      _recycled_out_arrays[bucket] = (Node**)out[0];
+      return out;
+    }
+  }
+  return (Node**)node_arena()->Amalloc(len * sizeof(Node*));
+}
+
+//------------------------------free_out_array---------------------------------
+void Compile::free_out_array(Node** out, uint len) {
+  assert(is_power_of_2(len) && len >= 4, "out arrays are power-of-2 sized");
+  int bucket = log2_intptr(len);
+  if (bucket < out_array_buckets) {
+    out[0] = (Node*)_recycled_out_arrays[bucket];
+    _recycled_out_arrays[bucket] = out;
+  } else {
+    node_arena()->Afree(out, len * sizeof(Node*));
+  }
+}
+
+//---------------------------clear_recycled_out_arrays-------------------------
+// Must be called whenever the contents of the node arena are moved or freed,
+// since recycled arrays may only be handed out to new-space Nodes.
+void Compile::clear_recycled_out_arrays() {
+  for (int i = 0; i < out_array_buckets; i++) {
+    _recycled_out_arrays[i] = NULL;
+  }
+}
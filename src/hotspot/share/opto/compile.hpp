@@ -431,6 +431,9 @@ class Compile : public Phase {
   debug_only(static int _debug_idx;)            // Monotonic counter (not reset), use -XX:BreakAtNode=<idx>
   Arena                 _node_arena;            // Arena for new-space Nodes
   Arena                 _old_arena;             // Arena for old-space Nodes, lifetime during xform
+  enum { out_array_buckets = 16 };
+  Node**                _recycled_out_arrays[out_array_buckets]; // Free lists of dead nodes' out arrays,
+                                                // indexed by log2 of their capacity
   RootNode*             _root;                  // Unique root of compilation, or NULL after bail-out.
   Node*                 _top;                   // Unique top node.  (Reset by various phases.)
 
@@ -858,6 +861,9 @@ class Compile : public Phase {
   static void  set_debug_idx(int i)        { debug_only(_debug_idx = i); }
   Arena*       node_arena()                { return &_node_arena; }
   Arena*       old_arena()                 { return &_old_arena; }
+  Node**       alloc_out_array(uint len);
+  void         free_out_array(Node** out, uint len);
+  void         clear_recycled_out_arrays();
   RootNode*    root() const                { return _root; }
   void         set_root(RootNode* r)       { _root = r; }
   StartNode*   start() const;              // (Derived from root.)
@@ -970,6 +976,8 @@ class Compile : public Phase {
   CallGenerator*    call_generator(ciMethod* call_method, int vtable_index, bool call_does_dispatch,
                                    JVMState* jvms, bool allow_inline, float profile_factor, ciKlass* speculative_receiver_type = NULL,
                                    bool allow_intrinsics = true, bool delayed_forbidden = false);
+  CallGenerator*    polymorphic_call_generator(ciMethod* callee, int vtable_index, JVMState* jvms,
+                                               bool allow_inline, float prof_factor, ciCallProfile& profile);
   bool should_delay_inlining(ciMethod* call_method, JVMState* jvms) {
     return should_delay_string_inlining(call_method, jvms) ||
            should_delay_boxing_inlining(call_method, jvms);
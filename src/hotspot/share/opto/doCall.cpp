@@ -227,6 +227,11 @@ CallGenerator* Compile::call_generator(ciMethod* callee, int vtable_index, bool
           speculative_receiver_type = NULL;
         }
       }
+      if (receiver_method == NULL && morphism > 2 && UseBimorphicInlining) {
+        CallGenerator* cg = polymorphic_call_generator(callee, vtable_index, jvms,
+                                                       allow_inline, prof_factor, profile);
+        if (cg != NULL)  return cg;
+      }
       if (receiver_method == NULL &&
           (have_major_receiver || morphism == 1 ||
            (morphism == 2 && UseBimorphicInlining))) {
@@ -314,6 +319,49 @@ CallGenerator* Compile::call_generator(ciMethod* callee, int vtable_index, bool
   }
 }
 
+// Inline every receiver of a call site with a small, fully profiled set of
+// receiver types behind a chain of type checks, most frequent first. The
+// remaining path traps, like the bimorphic case. Returns NULL if the site
+// has too many receivers or a receiver's method can't be inlined, since a
+// check in front of an out-of-line call doesn't beat a virtual call.
+CallGenerator* Compile::polymorphic_call_generator(ciMethod* callee, int vtable_index, JVMState* jvms,
+                                                   bool allow_inline, float prof_factor, ciCallProfile& profile) {
+  ciMethod* caller = jvms->method();
+  int       bci    = jvms->bci();
+  int morphism = profile.morphism();
+  if (morphism > PolymorphicInlineLimit ||
+      too_many_traps(caller, bci, Deoptimization::Reason_bimorphic)) {
+    return NULL;
+  }
+
+  ciMethod*      receiver_methods[ciCallProfile::MorphismLimit];
+  CallGenerator* hit_cgs[ciCallProfile::MorphismLimit];
+  for (int i = 0; i < morphism; i++) {
+    receiver_methods[i] = callee->resolve_invoke(caller->holder(), profile.receiver(i));
+    if (receiver_methods[i] == NULL) {
+      return NULL;
+    }
+    hit_cgs[i] = call_generator(receiver_methods[i], vtable_index, false, jvms, allow_inline, prof_factor);
+    if (hit_cgs[i] == NULL || !hit_cgs[i]->is_inline()) {
+      return NULL;
+    }
+  }
+
+  CallGenerator* cg = CallGenerator::for_uncommon_trap(callee, Deoptimization::Reason_bimorphic,
+                                                       Deoptimization::Action_maybe_recompile);
+  // Build the chain from the least frequent receiver up. Each check is
+  // only reached when the checks for more frequent receivers failed.
+  int remaining_count = 0;
+  for (int i = morphism - 1; i >= 0 && cg != NULL; i--) {
+    remaining_count += profile.receiver_count(i);
+    float hit_prob = (i == morphism - 1) ? PROB_MAX : (float)profile.receiver_count(i) / (float)remaining_count;
+    trace_type_profile(this, caller, jvms->depth() - 1, bci, receiver_methods[i], profile.receiver(i),
+                       profile.count(), profile.receiver_count(i));
+    cg = CallGenerator::for_predicted_call(profile.receiver(i), cg, hit_cgs[i], hit_prob);
+  }
+  return cg;
+}
+
 // Return true for methods that shouldn't be inlined early so that
 // they are easier to analyze and optimize as intrinsics.
 bool Compile::should_delay_string_inlining(ciMethod* call_method, JVMState* jvms) {
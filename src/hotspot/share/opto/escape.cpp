@@ -242,6 +242,9 @@ bool ConnectionGraph::compute_escape() {
     if (n->is_CallStaticJava()) {
       n->as_CallStaticJava()->_is_non_escaping = noescape;
     }
+    if (!noescape && n->is_Allocate()) {
+      report_not_scalar_replaceable(n, "escapes as call argument");
+    }
     if (noescape && ptn->scalar_replaceable()) {
       adjust_scalar_replaceable_state(ptn);
       if (ptn->scalar_replaceable()) {
@@ -827,8 +830,8 @@ void ConnectionGraph::add_call_node(CallNode* call) {
     }
     add_java_object(call, es);
     PointsToNode* ptn = ptnode_adr(call_idx);
-    if (!scalar_replaceable && ptn->scalar_replaceable()) {
-      ptn->set_scalar_replaceable(false);
+    if (!scalar_replaceable) {
+      set_not_scalar_replaceable(ptn, "array length is not constant or too big");
     }
   } else if (call->is_CallStaticJava()) {
     // Call nodes could be different types:
@@ -859,7 +862,7 @@ void ConnectionGraph::add_call_node(CallNode* call) {
       assert(strncmp(name, "_multianewarray", 15) == 0, "TODO: add failed case check");
       // Returns a newly allocated unescaped object.
       add_java_object(call, PointsToNode::NoEscape);
-      ptnode_adr(call_idx)->set_scalar_replaceable(false);
+      set_not_scalar_replaceable(ptnode_adr(call_idx), "multianewarray");
     } else if (meth->is_boxing_method()) {
       // Returns boxing object
       PointsToNode::EscapeState es;
@@ -881,7 +884,7 @@ void ConnectionGraph::add_call_node(CallNode* call) {
         // Mark it as NoEscape so that objects referenced by
         // it's fields will be marked as NoEscape at least.
         add_java_object(call, PointsToNode::NoEscape);
-        ptnode_adr(call_idx)->set_scalar_replaceable(false);
+        set_not_scalar_replaceable(ptnode_adr(call_idx), "allocated by a call");
       } else {
         // Determine whether any arguments are returned.
         const TypeTuple* d = call->tf()->domain();
@@ -1657,6 +1660,30 @@ int ConnectionGraph::find_init_values(JavaObjectNode* pta, PointsToNode* init_va
   return new_edges;
 }
 
+void ConnectionGraph::set_not_scalar_replaceable(PointsToNode* ptn, const char* reason) {
+  if (!ptn->scalar_replaceable()) {
+    return; // Keep the first reason
+  }
+  ptn->set_scalar_replaceable(false);
+  if (ptn->escape_state() == PointsToNode::NoEscape) {
+    report_not_scalar_replaceable(ptn->ideal_node(), reason);
+  }
+}
+
+void ConnectionGraph::report_not_scalar_replaceable(Node* n, const char* reason) {
+#ifndef PRODUCT
+  if (PrintEliminateAllocations) {
+    tty->print("=== Allocation %d in ", n->_idx);
+    _compile->method()->print_short_name();
+    tty->print_cr(" is not scalar replaceable: %s", reason);
+  }
+#endif
+  CompileLog* log = _compile->log();
+  if (log != NULL) {
+    log->elem("not_scalar_replaceable idx='%d' reason='%s'", n->_idx, reason);
+  }
+}
+
 // Adjust scalar_replaceable state after Connection Graph is built.
 void ConnectionGraph::adjust_scalar_replaceable_state(JavaObjectNode* jobj) {
   // Search for non-escaping objects which are not scalar replaceable
@@ -1674,7 +1701,7 @@ void ConnectionGraph::adjust_scalar_replaceable_state(JavaObjectNode* jobj) {
       FieldNode* field = use->as_Field();
       assert(field->is_oop() && field->scalar_replaceable(), "sanity");
       if (field->offset() == Type::OffsetBot) {
-        jobj->set_scalar_replaceable(false);
+        set_not_scalar_replaceable(jobj, "stored at unknown offset");
         return;
       }
       // 2. An object is not scalar replaceable if the field into which it is
@@ -1683,7 +1710,7 @@ void ConnectionGraph::adjust_scalar_replaceable_state(JavaObjectNode* jobj) {
         for (BaseIterator i(field); i.has_next(); i.next()) {
           PointsToNode* base = i.get();
           if (base == null_obj) {
-            jobj->set_scalar_replaceable(false);
+            set_not_scalar_replaceable(jobj, "stored into field with null base");
             return;
           }
         }
@@ -1695,8 +1722,8 @@ void ConnectionGraph::adjust_scalar_replaceable_state(JavaObjectNode* jobj) {
       PointsToNode* ptn = j.get();
       if (ptn->is_JavaObject() && ptn != jobj) {
         // Mark all objects.
-        jobj->set_scalar_replaceable(false);
-         ptn->set_scalar_replaceable(false);
+        set_not_scalar_replaceable(jobj, "merged with other object");
+        set_not_scalar_replaceable(ptn, "merged with other object");
       }
     }
     if (!jobj->scalar_replaceable()) {
@@ -1716,7 +1743,7 @@ void ConnectionGraph::adjust_scalar_replaceable_state(JavaObjectNode* jobj) {
     // 4. An object is not scalar replaceable if it has a field with unknown
     // offset (array's element is accessed in loop).
     if (offset == Type::OffsetBot) {
-      jobj->set_scalar_replaceable(false);
+      set_not_scalar_replaceable(jobj, "field accessed at unknown offset");
       return;
     }
     // 5. Currently an object is not scalar replaceable if a LoadStore node
@@ -1725,7 +1752,7 @@ void ConnectionGraph::adjust_scalar_replaceable_state(JavaObjectNode* jobj) {
     Node* n = field->ideal_node();
     for (DUIterator_Fast imax, i = n->fast_outs(imax); i < imax; i++) {
       if (n->fast_out(i)->is_LoadStore()) {
-        jobj->set_scalar_replaceable(false);
+        set_not_scalar_replaceable(jobj, "field accessed by LoadStore");
         return;
       }
     }
@@ -1754,8 +1781,8 @@ void ConnectionGraph::adjust_scalar_replaceable_state(JavaObjectNode* jobj) {
         // this field's base by now.
         if (base->is_JavaObject() && base != jobj) {
           // Mark all bases.
-          jobj->set_scalar_replaceable(false);
-          base->set_scalar_replaceable(false);
+          set_not_scalar_replaceable(jobj, "field may point to other object");
+          set_not_scalar_replaceable(base, "field may point to other object");
         }
       }
     }
@@ -448,6 +448,11 @@ private:
     }
   }
 
+  // Mark an object as not scalar replaceable. The reason is reported
+  // with PrintEliminateAllocations and in the compilation log.
+  void set_not_scalar_replaceable(PointsToNode* ptn, const char* reason);
+  void report_not_scalar_replaceable(Node* n, const char* reason);
+
   // Propagate GlobalEscape and ArgEscape escape states to all nodes
   // and check that we still have non-escaping java objects.
   bool find_non_escaped_objects(GrowableArray<PointsToNode*>& ptnodes_worklist,
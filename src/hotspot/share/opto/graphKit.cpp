@@ -1566,6 +1566,7 @@ void GraphKit::pre_barrier(bool do_load,
       break;
 
     case BarrierSet::CardTableModRef:
+    case BarrierSet::EpsilonBarrierSet:
       break;
 
     default      :
@@ -1581,6 +1582,7 @@ bool GraphKit::can_move_pre_barrier() const {
       return true; // Can move it if no safepoint
 
     case BarrierSet::CardTableModRef:
+    case BarrierSet::EpsilonBarrierSet:
       return true; // There is no pre-barrier
 
     default      :
@@ -1608,6 +1610,9 @@ void GraphKit::post_barrier(Node* ctl,
       write_barrier_post(store, obj, adr, adr_idx, val, use_precise);
       break;
 
+    case BarrierSet::EpsilonBarrierSet:
+      break;
+
     default      :
       ShouldNotReachHere();
 
@@ -3883,6 +3888,19 @@ void GraphKit::write_barrier_post(Node* oop_store,
   // Divide by card size
   assert(Universe::heap()->barrier_set()->is_a(BarrierSet::CardTableModRef),
          "Only one we handle so far.");
+  CardTableModRefBS* ctbs = barrier_set_cast<CardTableModRefBS>(Universe::heap()->barrier_set());
+  bool filter = ctbs->can_filter_card_marks() && val != NULL;
+  if (filter) {
+    // Only a store of a young object into an old object needs the
+    // card: skip stores into the young generation and stores of old
+    // objects or NULL.  The boundary is a heap address, so a signed
+    // compare is fine on 64-bit platforms.
+    Node* boundary = __ makecon(TypeX::make((intptr_t)ctbs->young_gen_boundary()));
+    Node* val_cast = __ CastPX(__ ctrl(), val);
+    bool young_above = ctbs->young_gen_above_boundary();
+    __ if_then(cast, young_above ? BoolTest::lt : BoolTest::ge, boundary, PROB_FAIR);
+    __ if_then(val_cast, young_above ? BoolTest::ge : BoolTest::lt, boundary, PROB_UNLIKELY_MAG(3));
+  }
   Node* card_offset = __ URShiftX( cast, __ ConI(CardTable::card_shift) );
 
   // Combine card table base and card offset
@@ -3922,6 +3940,11 @@ void GraphKit::write_barrier_post(Node* oop_store,
     __ end_if();
   }
 
+  if (filter) {
+    __ end_if();
+    __ end_if();
+  }
+
   // Final sync IdealKit and GraphKit.
   final_sync(ideal);
 }
@@ -318,6 +318,7 @@ void Matcher::match( ) {
 
   // Swap out to old-space; emptying new-space
   Arena *old = C->node_arena()->move_contents(C->old_arena());
+  C->clear_recycled_out_arrays();
 
   // Save debug and profile information for nodes in old space:
   _old_node_note_array = C->node_note_array();
@@ -582,9 +582,9 @@ void Node::destruct() {
   char *out_array = (char*)(_out == NO_OUT_ARRAY? NULL: _out);
   int node_size = size_of();
 
-  // Free the output edge array
+  // Free the output edge array for reuse by other nodes
   if (out_edge_size > 0) {
-    compile->node_arena()->Afree(out_array, out_edge_size);
+    compile->free_out_array((Node**)out_array, _outmax);
   }
 
   // Free the input edge array and the node itself
@@ -656,11 +656,11 @@ void Node::grow( uint len ) {
 // Grow the input array, making space for more edges
 void Node::out_grow( uint len ) {
   assert(!is_top(), "cannot grow a top node's out array");
-  Arena* arena = Compile::current()->node_arena();
+  Compile* C = Compile::current();
   uint new_max = _outmax;
   if( new_max == 0 ) {
     _outmax = 4;
-    _out = (Node **)arena->Amalloc(4*sizeof(Node*));
+    _out = C->alloc_out_array(4);
     return;
   }
   while( new_max <= len ) new_max <<= 1; // Find next power-of-2
@@ -668,7 +668,10 @@ void Node::out_grow( uint len ) {
   // Previously I was using only powers-of-2 which peaked at 128 edges.
   //if( new_max >= limit ) new_max = limit-1;
   assert(_out != NULL && _out != NO_OUT_ARRAY, "out must have sensible value");
-  _out = (Node**)arena->Arealloc(_out,_outmax*sizeof(Node*),new_max*sizeof(Node*));
+  Node** new_out = C->alloc_out_array(new_max);
+  Copy::disjoint_words((HeapWord*)_out, (HeapWord*)new_out, _outmax*sizeof(Node*)/HeapWordSize);
+  C->free_out_array(_out, _outmax);
+  _out = new_out;
   //Copy::zero_to_bytes(&_out[_outmax], (new_max-_outmax)*sizeof(Node*)); // NULL all new space
   _outmax = new_max;               // Record new max length
   // This assertion makes sure that Node::_max is wide enough to
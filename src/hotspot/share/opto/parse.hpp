@@ -85,6 +85,7 @@ protected:
   bool        should_not_inline(ciMethod* callee_method,
                                 ciMethod* caller_method,
                                 JVMState* jvms,
+                                ciCallProfile& profile,
                                 WarmCallInfo* wci_result);
   void        print_inlining(ciMethod* callee_method, int caller_bci,
                              ciMethod* caller_method, bool success) const;
@@ -166,6 +166,12 @@ void SuperWord::transform_loop(IdealLoopTree* lpt, bool do_optimization) {
   if (do_optimization) {
     assert(_packset.length() == 0, "packset must be empty");
     SLP_extract();
+    CompileLog* log = _phase->C->log();
+    if (log != NULL) {
+      log->elem("superword loop='%d' kind='%s' vectorized='%d' unroll='%d'",
+                cl->_idx, cl->is_main_loop() ? "main" : (cl->is_post_loop() ? "post" : "normal"),
+                cl->is_vectorized_loop() ? 1 : 0, cl->slp_max_unroll());
+    }
     if (PostLoopMultiversioning && Matcher::has_predicated_vectors()) {
       if (cl->is_vectorized_loop() && cl->is_main_loop() && !cl->is_reduction_loop()) {
         IdealLoopTree *lpt_next = lpt->_next;
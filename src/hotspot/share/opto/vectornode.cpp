@@ -556,6 +556,18 @@ int ReductionNode::opcode(int opc, BasicType bt) {
       assert(bt == T_DOUBLE, "must be");
       vopc = Op_MulReductionVD;
       break;
+    case Op_AndI:
+      assert(bt == T_INT, "must be");
+      vopc = Op_AndReductionVI;
+      break;
+    case Op_OrI:
+      assert(bt == T_INT, "must be");
+      vopc = Op_OrReductionVI;
+      break;
+    case Op_XorI:
+      assert(bt == T_INT, "must be");
+      vopc = Op_XorReductionVI;
+      break;
     // TODO: add MulL for targets that support it
     default:
       break;
@@ -580,6 +592,9 @@ ReductionNode* ReductionNode::make(int opc, Node *ctrl, Node* n1, Node* n2, Basi
   case Op_MulReductionVL: return new MulReductionVLNode(ctrl, n1, n2);
   case Op_MulReductionVF: return new MulReductionVFNode(ctrl, n1, n2);
   case Op_MulReductionVD: return new MulReductionVDNode(ctrl, n1, n2);
+  case Op_AndReductionVI: return new AndReductionVINode(ctrl, n1, n2);
+  case Op_OrReductionVI:  return new OrReductionVINode(ctrl, n1, n2);
+  case Op_XorReductionVI: return new XorReductionVINode(ctrl, n1, n2);
   default:
     fatal("Missed vector creation for '%s'", NodeClassNames[vopc]);
     return NULL;
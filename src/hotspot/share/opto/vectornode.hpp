@@ -544,6 +544,36 @@ class XorVNode : public VectorNode {
   virtual int Opcode() const;
 };
 
+//------------------------------AndReductionVINode-----------------------------
+// Vector and int as a reduction
+class AndReductionVINode : public ReductionNode {
+public:
+  AndReductionVINode(Node *ctrl, Node* in1, Node* in2) : ReductionNode(ctrl, in1, in2) {}
+  virtual int Opcode() const;
+  virtual const Type* bottom_type() const { return TypeInt::INT; }
+  virtual uint ideal_reg() const { return Op_RegI; }
+};
+
+//------------------------------OrReductionVINode------------------------------
+// Vector or int as a reduction
+class OrReductionVINode : public ReductionNode {
+public:
+  OrReductionVINode(Node *ctrl, Node* in1, Node* in2) : ReductionNode(ctrl, in1, in2) {}
+  virtual int Opcode() const;
+  virtual const Type* bottom_type() const { return TypeInt::INT; }
+  virtual uint ideal_reg() const { return Op_RegI; }
+};
+
+//------------------------------XorReductionVINode-----------------------------
+// Vector xor int as a reduction
+class XorReductionVINode : public ReductionNode {
+public:
+  XorReductionVINode(Node *ctrl, Node* in1, Node* in2) : ReductionNode(ctrl, in1, in2) {}
+  virtual int Opcode() const;
+  virtual const Type* bottom_type() const { return TypeInt::INT; }
+  virtual uint ideal_reg() const { return Op_RegI; }
+};
+
 //================================= M E M O R Y ===============================
 
 //------------------------------LoadVectorNode---------------------------------
@@ -440,11 +440,10 @@ public:
   void doit();
 };
 
-// VM operation to get stack trace at safepoint.
-class VM_GetStackTrace : public VM_Operation {
+// HandshakeClosure to get stack trace; only the target thread is stopped.
+class GetStackTraceClosure : public ThreadClosure {
 private:
   JvmtiEnv *_env;
-  JavaThread *_java_thread;
   jint _start_depth;
   jint _max_count;
   jvmtiFrameInfo *_frame_buffer;
@@ -452,19 +451,17 @@ private:
   jvmtiError _result;
 
 public:
-  VM_GetStackTrace(JvmtiEnv *env, JavaThread *java_thread,
-                   jint start_depth, jint max_count,
-                   jvmtiFrameInfo* frame_buffer, jint* count_ptr) {
+  GetStackTraceClosure(JvmtiEnv *env, jint start_depth, jint max_count,
+                       jvmtiFrameInfo* frame_buffer, jint* count_ptr) {
     _env = env;
-    _java_thread = java_thread;
     _start_depth = start_depth;
     _max_count = max_count;
     _frame_buffer = frame_buffer;
     _count_ptr = count_ptr;
+    _result = JVMTI_ERROR_THREAD_NOT_ALIVE;
   }
   jvmtiError result() { return _result; }
-  VMOp_Type type() const { return VMOp_GetStackTrace; }
-  void doit();
+  void do_thread(Thread *target);
 };
 
 // forward declaration
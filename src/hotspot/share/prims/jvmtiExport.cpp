@@ -268,9 +268,9 @@ private:
   jclass  _class_being_redefined;
 
 public:
-  JvmtiClassFileLoadEventMark(JavaThread *thread, Symbol* name,
+  JvmtiClassFileLoadEventMark(JavaThread *thread, const char* class_name,
      Handle class_loader, Handle prot_domain, Klass* class_being_redefined) : JvmtiThreadEventMark(thread) {
-      _class_name = name != NULL? name->as_utf8() : NULL;
+      _class_name = class_name;
       _jloader = (jobject)to_jobject(class_loader());
       _protection_domain = (jobject)to_jobject(prot_domain());
       if (class_being_redefined == NULL) {
@@ -373,6 +373,14 @@ JvmtiExport::get_jvmti_interface(JavaVM *jvm, void **penv, jint version) {
           return JNI_EVERSION;  // unsupported minor version number
       }
       break;
+    case 11:
+      switch (minor) {
+        case 0:  // version 11.0.<micro> is recognized
+          break;
+        default:
+          return JNI_EVERSION;  // unsupported minor version number
+      }
+      break;
     default:
       return JNI_EVERSION;  // unsupported major version number
   }
@@ -827,6 +835,7 @@ JvmtiExport::cv_oop_to_JavaThread(ThreadsList * t_list, oop thread_oop,
 class JvmtiClassFileLoadHookPoster : public StackObj {
  private:
   Symbol*            _h_name;
+  const char *         _class_name;
   Handle               _class_loader;
   Handle               _h_protection_domain;
   unsigned char **     _data_ptr;
@@ -847,6 +856,7 @@ class JvmtiClassFileLoadHookPoster : public StackObj {
                                       unsigned char **data_ptr, unsigned char **end_ptr,
                                       JvmtiCachedClassFileData **cache_ptr) {
     _h_name = h_name;
+    _class_name = NULL;
     _class_loader = class_loader;
     _h_protection_domain = h_protection_domain;
     _data_ptr = data_ptr;
@@ -926,21 +936,27 @@ class JvmtiClassFileLoadHookPoster : public StackObj {
     if (env->phase() == JVMTI_PHASE_PRIMORDIAL && !env->early_class_hook_env()) {
       return;
     }
+    jvmtiEventClassFileLoadHook callback = env->callbacks()->ClassFileLoadHook;
+    if (callback == NULL) {
+      // Nothing to call, so don't pay for the handles and the transition.
+      return;
+    }
+    if (_class_name == NULL && _h_name != NULL) {
+      // Convert the name once and share it with every environment.
+      _class_name = _h_name->as_utf8();
+    }
     unsigned char *new_data = NULL;
     jint new_len = 0;
-    JvmtiClassFileLoadEventMark jem(_thread, _h_name, _class_loader,
+    JvmtiClassFileLoadEventMark jem(_thread, _class_name, _class_loader,
                                     _h_protection_domain,
                                     _class_being_redefined);
     JvmtiJavaThreadEventTransition jet(_thread);
-    jvmtiEventClassFileLoadHook callback = env->callbacks()->ClassFileLoadHook;
-    if (callback != NULL) {
-      (*callback)(env->jvmti_external(), jem.jni_env(),
-                  jem.class_being_redefined(),
-                  jem.jloader(), jem.class_name(),
-                  jem.protection_domain(),
-                  _curr_len, _curr_data,
-                  &new_len, &new_data);
-    }
+    (*callback)(env->jvmti_external(), jem.jni_env(),
+                jem.class_being_redefined(),
+                jem.jloader(), jem.class_name(),
+                jem.protection_domain(),
+                _curr_len, _curr_data,
+                &new_len, &new_data);
     if (new_data != NULL) {
       // this agent has modified class data.
       _has_been_modified = true;
@@ -1201,6 +1217,7 @@ bool              JvmtiExport::_should_post_garbage_collection_finish     = fals
 bool              JvmtiExport::_should_post_object_free                   = false;
 bool              JvmtiExport::_should_post_resource_exhausted            = false;
 bool              JvmtiExport::_should_post_vm_object_alloc               = false;
+bool              JvmtiExport::_should_post_sampled_object_alloc          = false;
 bool              JvmtiExport::_should_post_on_exceptions                 = false;
 
 ////////////////////////////////////////////////////////////////////////////////////////////////
@@ -1448,16 +1465,25 @@ void JvmtiExport::post_thread_end(JavaThread *thread) {
   }
 }
 
-void JvmtiExport::post_object_free(JvmtiEnv* env, jlong tag) {
-  assert(SafepointSynchronize::is_at_safepoint(), "must be executed at safepoint");
-  assert(env->is_enabled(JVMTI_EVENT_OBJECT_FREE), "checking");
-
+// Posts the ObjectFree events collected by a tag map during GC. Called
+// by the ServiceThread, after the safepoint at which the objects died.
+void JvmtiExport::post_object_free(JvmtiEnv* env, GrowableArray<jlong>* tags) {
+  JavaThread* thread = JavaThread::current();
   EVT_TRIG_TRACE(JVMTI_EVENT_OBJECT_FREE, ("[?] Trg Object Free triggered" ));
-  EVT_TRACE(JVMTI_EVENT_OBJECT_FREE, ("[?] Evt Object Free sent"));
 
+  // The event may have been disabled since the objects were freed.
+  if (!env->is_enabled(JVMTI_EVENT_OBJECT_FREE)) {
+    return;
+  }
   jvmtiEventObjectFree callback = env->callbacks()->ObjectFree;
-  if (callback != NULL) {
-    (*callback)(env->jvmti_external(), tag);
+  if (callback == NULL) {
+    return;
+  }
+
+  JvmtiJavaThreadEventTransition jet(thread);
+  for (int i = 0; i < tags->length(); i++) {
+    EVT_TRACE(JVMTI_EVENT_OBJECT_FREE, ("[?] Evt Object Free sent"));
+    (*callback)(env->jvmti_external(), tags->at(i));
   }
 }
 
@@ -2526,6 +2552,39 @@ void JvmtiExport::post_vm_object_alloc(JavaThread *thread,  oop object) {
   }
 }
 
+void JvmtiExport::post_sampled_object_alloc(JavaThread *thread, oop object) {
+  EVT_TRIG_TRACE(JVMTI_EVENT_SAMPLED_OBJECT_ALLOC,
+                 ("[%s] Trg sampled object alloc triggered",
+                  JvmtiTrace::safe_get_thread_name(thread)));
+  if (object == NULL) {
+    return;
+  }
+  JvmtiThreadState *state = thread->jvmti_thread_state();
+  if (state == NULL) {
+    return;
+  }
+  HandleMark hm(thread);
+  Handle h(thread, object);
+  JvmtiEnvThreadStateIterator it(state);
+  for (JvmtiEnvThreadState* ets = it.first(); ets != NULL; ets = it.next(ets)) {
+    if (ets->is_enabled(JVMTI_EVENT_SAMPLED_OBJECT_ALLOC)) {
+      JvmtiEnv *env = ets->get_env();
+      EVT_TRACE(JVMTI_EVENT_SAMPLED_OBJECT_ALLOC,
+                ("[%s] Evt sampled object alloc sent %s",
+                 JvmtiTrace::safe_get_thread_name(thread),
+                 h()->klass()->external_name()));
+
+      JvmtiVMObjectAllocEventMark jem(thread, h());
+      JvmtiJavaThreadEventTransition jet(thread);
+      jvmtiEventSampledObjectAlloc callback = env->callbacks()->SampledObjectAlloc;
+      if (callback != NULL) {
+        (*callback)(env->jvmti_external(), jem.jni_env(), jem.jni_thread(),
+                    jem.jni_jobject(), jem.jni_class(), jem.size());
+      }
+    }
+  }
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////
 
 void JvmtiExport::cleanup_thread(JavaThread* thread) {
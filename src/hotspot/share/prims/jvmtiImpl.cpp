@@ -37,6 +37,7 @@
 #include "prims/jvmtiEventController.inline.hpp"
 #include "prims/jvmtiImpl.hpp"
 #include "prims/jvmtiRedefineClasses.hpp"
+#include "prims/jvmtiTagMap.hpp"
 #include "runtime/atomic.hpp"
 #include "runtime/deoptimization.hpp"
 #include "runtime/handles.hpp"
@@ -936,6 +937,10 @@ JvmtiDeferredEvent JvmtiDeferredEvent::dynamic_code_generated_event(
   return event;
 }
 
+JvmtiDeferredEvent JvmtiDeferredEvent::object_free_event() {
+  return JvmtiDeferredEvent(TYPE_OBJECT_FREE);
+}
+
 void JvmtiDeferredEvent::post() {
   assert(ServiceThread::is_service_thread(Thread::current()),
          "Service thread must post enqueued events");
@@ -969,6 +974,10 @@ void JvmtiDeferredEvent::post() {
       }
       break;
     }
+    case TYPE_OBJECT_FREE: {
+      JvmtiTagMap::post_freed_objects();
+      break;
+    }
     default:
       ShouldNotReachHere();
   }
@@ -84,6 +84,7 @@ jvmtiCapabilities JvmtiManageCapabilities::init_always_capabilities() {
   jc.can_generate_compiled_method_load_events = 1;
   jc.can_generate_native_method_bind_events = 1;
   jc.can_generate_vm_object_alloc_events = 1;
+  jc.can_generate_sampled_object_alloc_events = 1;
   if (os::is_thread_cpu_time_supported()) {
     jc.can_get_current_thread_cpu_time = 1;
     jc.can_get_thread_cpu_time = 1;
@@ -446,6 +447,8 @@ void JvmtiManageCapabilities:: print(const jvmtiCapabilities* cap) {
     log_trace(jvmti)("can_generate_early_vmstart");
   if (cap->can_generate_early_class_hook_events)
     log_trace(jvmti)("can_generate_early_class_hook_events");
+  if (cap->can_generate_sampled_object_alloc_events)
+    log_trace(jvmti)("can_generate_sampled_object_alloc_events");
 }
 
 #endif
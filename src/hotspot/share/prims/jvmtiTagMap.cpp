@@ -44,19 +44,20 @@
 #include "prims/jvmtiExport.hpp"
 #include "prims/jvmtiImpl.hpp"
 #include "prims/jvmtiTagMap.hpp"
-#include "runtime/biasedLocking.hpp"
 #include "runtime/javaCalls.hpp"
 #include "runtime/jniHandles.inline.hpp"
 #include "runtime/mutex.hpp"
 #include "runtime/mutexLocker.hpp"
 #include "runtime/reflectionUtils.hpp"
 #include "runtime/thread.inline.hpp"
+#include "runtime/serviceThread.hpp"
 #include "runtime/threadSMR.hpp"
 #include "runtime/vframe.hpp"
 #include "runtime/vmThread.hpp"
 #include "runtime/vm_operations.hpp"
 #include "services/serviceUtil.hpp"
 #include "utilities/macros.hpp"
+#include "utilities/resourceHash.hpp"
 
 // JvmtiTagHashmapEntry
 //
@@ -434,7 +435,8 @@ JvmtiTagMap::JvmtiTagMap(JvmtiEnv* env) :
   _env(env),
   _lock(Mutex::nonleaf+2, "JvmtiTagMap._lock", false),
   _free_entries(NULL),
-  _free_entries_count(0)
+  _free_entries_count(0),
+  _freed_tags(NULL)
 {
   assert(JvmtiThreadState_lock->is_locked(), "sanity check");
   assert(((JvmtiEnvBase *)env)->tag_map() == NULL, "tag map already exists for environment");
@@ -467,6 +469,10 @@ JvmtiTagMap::~JvmtiTagMap() {
   delete _hashmap;
   _hashmap = NULL;
 
+  // drop the ObjectFree events that were not posted
+  delete _freed_tags;
+  _freed_tags = NULL;
+
   // remove any entries on the free list
   JvmtiTagHashmapEntry* entry = _free_entries;
   while (entry != NULL) {
@@ -1614,40 +1620,42 @@ jvmtiError JvmtiTagMap::get_objects_with_tags(const jlong* tags,
 // ObjectMarker is used to support the marking objects when walking the
 // heap.
 //
-// This implementation uses the existing mark bits in an object for
-// marking. Objects that are marked must later have their headers restored.
-// As most objects are unlocked and don't have their identity hash computed
-// we don't have to save their headers. Instead we save the headers that
-// are "interesting". Later when the headers are restored this implementation
-// restores all headers to their initial value and then restores the few
-// objects that had interesting headers.
-//
-// Future work: This implementation currently uses growable arrays to save
-// the oop and header of interesting objects. As an optimization we could
-// use the same technique as the GC and make use of the unused area
-// between top() and end().
-//
-
-// An ObjectClosure used to restore the mark bits of an object
-class RestoreMarksClosure : public ObjectClosure {
- public:
-  void do_object(oop o) {
-    if (o != NULL) {
-      markOop mark = o->mark();
-      if (mark->is_marked()) {
-        o->init_mark();
-      }
-    }
-  }
-};
+// Visited objects are recorded in a sparse bitmap on the side, one bit per
+// MinObjAlignment, so object headers are never modified and nothing has to
+// be restored when the walk is done. The bitmap is made of fixed size
+// fragments that are only allocated for the parts of the heap the walk
+// reaches. Fragments are found by their index in a hashtable, and the most
+// recently used fragment is cached as consecutive lookups tend to hit the
+// same part of the heap.
 
 // ObjectMarker provides the mark and visited functions
 class ObjectMarker : AllStatic {
  private:
-  // saved headers
-  static GrowableArray<oop>* _saved_oop_stack;
-  static GrowableArray<markOop>* _saved_mark_stack;
-  static bool _needs_reset;                  // do we need to reset mark bits?
+  // each fragment covers 2^fragment_shift aligned object addresses
+  static const int fragment_shift = 20;
+  static const uintptr_t fragment_mask = (((uintptr_t)1) << fragment_shift) - 1;
+  static const size_t fragment_words = (((size_t)1) << fragment_shift) / BitsPerWord;
+
+  typedef ResourceHashtable<uintptr_t, uintptr_t*,
+                            primitive_hash<uintptr_t>, primitive_equals<uintptr_t>,
+                            1031, ResourceObj::C_HEAP, mtInternal> FragmentTable;
+
+  class FreeFragmentClosure : public StackObj {
+   public:
+    bool do_entry(uintptr_t const& index, uintptr_t* const& fragment) {
+      FREE_C_HEAP_ARRAY(uintptr_t, fragment);
+      return true;
+    }
+  };
+
+  static FragmentTable* _fragments;
+  static uintptr_t      _last_index;
+  static uintptr_t*     _last_fragment;
+
+  static inline uintptr_t object_index(oop o) {
+    return cast_from_oop<uintptr_t>(o) >> LogMinObjAlignmentInBytes;
+  }
+  static inline uintptr_t* fragment_for(uintptr_t index, bool create);
 
  public:
   static void init();                       // initialize
@@ -1655,80 +1663,71 @@ class ObjectMarker : AllStatic {
 
   static inline void mark(oop o);           // mark an object
   static inline bool visited(oop o);        // check if object has been visited
-
-  static inline bool needs_reset()            { return _needs_reset; }
-  static inline void set_needs_reset(bool v)  { _needs_reset = v; }
 };
 
-GrowableArray<oop>* ObjectMarker::_saved_oop_stack = NULL;
-GrowableArray<markOop>* ObjectMarker::_saved_mark_stack = NULL;
-bool ObjectMarker::_needs_reset = true;  // need to reset mark bits by default
+ObjectMarker::FragmentTable* ObjectMarker::_fragments = NULL;
+uintptr_t  ObjectMarker::_last_index = 0;
+uintptr_t* ObjectMarker::_last_fragment = NULL;
 
 // initialize ObjectMarker - prepares for object marking
 void ObjectMarker::init() {
   assert(Thread::current()->is_VM_thread(), "must be VMThread");
-
-  // prepare heap for iteration
-  Universe::heap()->ensure_parsability(false);  // no need to retire TLABs
-
-  // create stacks for interesting headers
-  _saved_mark_stack = new (ResourceObj::C_HEAP, mtInternal) GrowableArray<markOop>(4000, true);
-  _saved_oop_stack = new (ResourceObj::C_HEAP, mtInternal) GrowableArray<oop>(4000, true);
-
-  if (UseBiasedLocking) {
-    BiasedLocking::preserve_marks();
-  }
+  assert(_fragments == NULL, "ObjectMarker already in use");
+  _fragments = new (ResourceObj::C_HEAP, mtInternal) FragmentTable();
+  _last_fragment = NULL;
 }
 
-// Object marking is done so restore object headers
+// Object marking is done so free the bitmap
 void ObjectMarker::done() {
-  // iterate over all objects and restore the mark bits to
-  // their initial value
-  RestoreMarksClosure blk;
-  if (needs_reset()) {
-    Universe::heap()->object_iterate(&blk);
+  FreeFragmentClosure free_fragments;
+  _fragments->iterate(&free_fragments);
+  delete _fragments;
+  _fragments = NULL;
+  _last_fragment = NULL;
+}
+
+// find, and optionally allocate, the bitmap fragment for an object index
+inline uintptr_t* ObjectMarker::fragment_for(uintptr_t index, bool create) {
+  uintptr_t fragment_index = index >> fragment_shift;
+  if (_last_fragment != NULL && _last_index == fragment_index) {
+    return _last_fragment;
+  }
+  uintptr_t* fragment = NULL;
+  uintptr_t** entry = _fragments->get(fragment_index);
+  if (entry != NULL) {
+    fragment = *entry;
+  } else if (create) {
+    fragment = NEW_C_HEAP_ARRAY(uintptr_t, fragment_words, mtInternal);
+    memset(fragment, 0, fragment_words * sizeof(uintptr_t));
+    _fragments->put(fragment_index, fragment);
   } else {
-    // We don't need to reset mark bits on this call, but reset the
-    // flag to the default for the next call.
-    set_needs_reset(true);
-  }
-
-  // now restore the interesting headers
-  for (int i = 0; i < _saved_oop_stack->length(); i++) {
-    oop o = _saved_oop_stack->at(i);
-    markOop mark = _saved_mark_stack->at(i);
-    o->set_mark(mark);
-  }
-
-  if (UseBiasedLocking) {
-    BiasedLocking::restore_marks();
+    return NULL;
   }
-
-  // free the stacks
-  delete _saved_oop_stack;
-  delete _saved_mark_stack;
+  _last_index = fragment_index;
+  _last_fragment = fragment;
+  return fragment;
 }
 
 // mark an object
 inline void ObjectMarker::mark(oop o) {
   assert(Universe::heap()->is_in(o), "sanity check");
-  assert(!o->mark()->is_marked(), "should only mark an object once");
+  assert(!visited(o), "should only mark an object once");
 
-  // object's mark word
-  markOop mark = o->mark();
-
-  if (mark->must_be_preserved(o)) {
-    _saved_mark_stack->push(mark);
-    _saved_oop_stack->push(o);
-  }
-
-  // mark the object
-  o->set_mark(markOopDesc::prototype()->set_marked());
+  uintptr_t index = object_index(o);
+  uintptr_t* fragment = fragment_for(index, true);
+  uintptr_t bit = index & fragment_mask;
+  fragment[bit >> LogBitsPerWord] |= ((uintptr_t)1) << (bit & (BitsPerWord - 1));
 }
 
 // return true if object is marked
 inline bool ObjectMarker::visited(oop o) {
-  return o->mark()->is_marked();
+  uintptr_t index = object_index(o);
+  uintptr_t* fragment = fragment_for(index, false);
+  if (fragment == NULL) {
+    return false;
+  }
+  uintptr_t bit = index & fragment_mask;
+  return (fragment[bit >> LogBitsPerWord] & (((uintptr_t)1) << (bit & (BitsPerWord - 1)))) != 0;
 }
 
 // Stack allocated class to help ensure that ObjectMarker is used
@@ -3243,20 +3242,12 @@ void VM_HeapWalkOperation::doit() {
 
   // the heap walk starts with an initial object or the heap roots
   if (initial_object().is_null()) {
-    // If either collect_stack_roots() or collect_simple_roots()
-    // returns false at this point, then there are no mark bits
-    // to reset.
-    ObjectMarker::set_needs_reset(false);
-
     // Calling collect_stack_roots() before collect_simple_roots()
     // can result in a big performance boost for an agent that is
     // focused on analyzing references in the thread stacks.
     if (!collect_stack_roots()) return;
 
     if (!collect_simple_roots()) return;
-
-    // no early return so enable heap traversal to reset the mark bits
-    ObjectMarker::set_needs_reset(true);
   } else {
     visit_stack()->push(initial_object()());
   }
@@ -3336,6 +3327,25 @@ void JvmtiTagMap::weak_oops_do(BoolObjectClosure* is_alive, OopClosure* f) {
   }
 }
 
+void JvmtiTagMap::post_freed_objects() {
+  assert(ServiceThread::is_service_thread(Thread::current()),
+         "Service thread must post deferred ObjectFree events");
+  JvmtiEnvIterator it;
+  for (JvmtiEnvBase* env = it.first(); env != NULL; env = it.next(env)) {
+    JvmtiTagMap* tag_map = env->tag_map();
+    if (tag_map != NULL) {
+      // The list is only appended to at a safepoint, which cannot
+      // happen while this thread is in the VM.
+      GrowableArray<jlong>* tags = tag_map->_freed_tags;
+      tag_map->_freed_tags = NULL;
+      if (tags != NULL) {
+        JvmtiExport::post_object_free((JvmtiEnv*)env, tags);
+        delete tags;
+      }
+    }
+  }
+}
+
 void JvmtiTagMap::do_weak_oops(BoolObjectClosure* is_alive, OopClosure* f) {
 
   // does this environment have the OBJECT_FREE event enabled
@@ -3380,9 +3390,13 @@ void JvmtiTagMap::do_weak_oops(BoolObjectClosure* is_alive, OopClosure* f) {
         hashmap->remove(prev, pos, entry);
         destroy_entry(entry);
 
-        // post the event to the profiler
+        // defer the event to the profiler, the ServiceThread posts it
+        // after the safepoint
         if (post_object_free) {
-          JvmtiExport::post_object_free(env(), tag);
+          if (_freed_tags == NULL) {
+            _freed_tags = new (ResourceObj::C_HEAP, mtInternal) GrowableArray<jlong>(64, true);
+          }
+          _freed_tags->append(tag);
         }
 
         ++freed;
@@ -3428,6 +3442,11 @@ void JvmtiTagMap::do_weak_oops(BoolObjectClosure* is_alive, OopClosure* f) {
     delayed_add = next;
   }
 
+  if (post_object_free && freed > 0) {
+    MutexLockerEx ml(Service_lock, Mutex::_no_safepoint_check_flag);
+    JvmtiDeferredEventQueue::enqueue(JvmtiDeferredEvent::object_free_event());
+  }
+
   log_debug(jvmti, objecttagging)("(%d->%d, %d freed, %d total moves)",
                                   hashmap->_entry_count + freed, hashmap->_entry_count, freed, moved);
 }
@@ -33,6 +33,7 @@
 #include "jvmtifiles/jvmtiEnv.hpp"
 #include "memory/allocation.hpp"
 #include "memory/universe.hpp"
+#include "utilities/growableArray.hpp"
 
 // forward references
 class JvmtiTagHashmap;
@@ -53,6 +54,8 @@ class JvmtiTagMap :  public CHeapObj<mtInternal> {
   JvmtiTagHashmapEntry* _free_entries;              // free list for this environment
   int _free_entries_count;                          // number of entries on the free list
 
+  GrowableArray<jlong>* _freed_tags;                // tags of freed objects not yet posted
+
   // create a tag map
   JvmtiTagMap(JvmtiEnv* env);
 
@@ -124,6 +127,9 @@ class JvmtiTagMap :  public CHeapObj<mtInternal> {
 
   static void weak_oops_do(
       BoolObjectClosure* is_alive, OopClosure* f) NOT_JVMTI_RETURN;
+
+  // post the ObjectFree events deferred by weak_oops_do
+  static void post_freed_objects() NOT_JVMTI_RETURN;
 };
 
 #endif // SHARE_VM_PRIMS_JVMTITAGMAP_HPP
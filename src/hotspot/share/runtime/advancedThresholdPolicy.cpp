@@ -160,13 +160,13 @@ double AdvancedThresholdPolicy::weight(Method* method) {
 }
 
 // Apply heuristics and return true if x should be compiled before y
-bool AdvancedThresholdPolicy::compare_methods(Method* x, Method* y) {
+bool AdvancedThresholdPolicy::compare_methods(Method* x, double x_weight, Method* y, double y_weight) {
   if (x->highest_comp_level() > y->highest_comp_level()) {
     // recompilation after deopt
     return true;
   } else
     if (x->highest_comp_level() == y->highest_comp_level()) {
-      if (weight(x) > weight(y)) {
+      if (x_weight > y_weight) {
         return true;
       }
     }
@@ -189,15 +189,23 @@ CompileTask* AdvancedThresholdPolicy::select_task(CompileQueue* compile_queue) {
   CompileTask *max_blocking_task = NULL;
   CompileTask *max_task = NULL;
   Method* max_method = NULL;
+  // The weights of max_method and of the best blocking task's method,
+  // cached so that each queued method's weight is computed only once per
+  // scan of a possibly long queue.
+  double max_weight = 0.0;
+  double max_blocking_weight = 0.0;
   jlong t = os::javaTimeMillis();
   // Iterate through the queue and find a method with a maximum rate.
   for (CompileTask* task = compile_queue->first(); task != NULL;) {
     CompileTask* next_task = task->next();
     Method* method = task->method();
     update_rate(t, method);
+    double w;
     if (max_task == NULL) {
+      w = weight(method);
       max_task = task;
       max_method = method;
+      max_weight = w;
     } else {
       // If a method has been stale for some time, remove it from the queue.
       // Blocking tasks and tasks submitted from whitebox API don't become stale
@@ -212,15 +220,19 @@ CompileTask* AdvancedThresholdPolicy::select_task(CompileQueue* compile_queue) {
       }
 
       // Select a method with a higher rate
-      if (compare_methods(method, max_method)) {
+      w = weight(method);
+      if (compare_methods(method, w, max_method, max_weight)) {
         max_task = task;
         max_method = method;
+        max_weight = w;
       }
     }
 
     if (task->is_blocking()) {
-      if (max_blocking_task == NULL || compare_methods(method, max_blocking_task->method())) {
+      if (max_blocking_task == NULL ||
+          compare_methods(method, w, max_blocking_task->method(), max_blocking_weight)) {
         max_blocking_task = task;
+        max_blocking_weight = w;
       }
     }
 
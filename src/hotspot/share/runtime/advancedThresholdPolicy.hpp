@@ -187,8 +187,9 @@ class AdvancedThresholdPolicy : public SimpleThresholdPolicy {
   inline bool is_stale(jlong t, jlong timeout, Method* m);
   // Compute the weight of the method for the compilation scheduling
   inline double weight(Method* method);
-  // Apply heuristics and return true if x should be compiled before y
-  inline bool compare_methods(Method* x, Method* y);
+  // Apply heuristics and return true if x should be compiled before y,
+  // given the weights of x and y
+  inline bool compare_methods(Method* x, double x_weight, Method* y, double y_weight);
   // Compute event rate for a given method. The rate is the number of event (invocations + backedges)
   // per millisecond.
   inline void update_rate(jlong t, Method* m);
@@ -517,6 +517,9 @@ static SpecialFlag const special_jvm_flags[] = {
   { "PrintSafepointStatistics",     JDK_Version::jdk(11), JDK_Version::jdk(12), JDK_Version::jdk(13) },
   { "PrintSafepointStatisticsTimeout", JDK_Version::jdk(11), JDK_Version::jdk(12), JDK_Version::jdk(13) },
   { "PrintSafepointStatisticsCount",JDK_Version::jdk(11), JDK_Version::jdk(12), JDK_Version::jdk(13) },
+  { "BindGCTaskThreadsToCPUs",      JDK_Version::jdk(11), JDK_Version::jdk(12), JDK_Version::jdk(13) },
+  { "UseGCTaskAffinity",            JDK_Version::jdk(11), JDK_Version::jdk(12), JDK_Version::jdk(13) },
+  { "GCTaskTimeStampEntries",       JDK_Version::jdk(11), JDK_Version::jdk(12), JDK_Version::jdk(13) },
 
   // --- Deprecated alias flags (see also aliased_jvm_flags) - sorted by obsolete_in then expired_in:
   { "DefaultMaxRAMFraction",        JDK_Version::jdk(8),  JDK_Version::undefined(), JDK_Version::undefined() },
@@ -1689,6 +1692,37 @@ size_t Arguments::max_heap_for_compressed_oops() {
   NOT_LP64(ShouldNotReachHere(); return 0);
 }
 
+// Raise ObjectAlignmentInBytes to the smallest power of two for which
+// compressed oops can address max_heap_size bytes. The larger shift costs
+// some padding per object, but that is usually much less than the space
+// taken by uncompressed references.
+void Arguments::scale_object_alignment_for_compressed_oops(size_t max_heap_size) {
+  const intx max_alignment = MIN2((intx)256, (intx)os::vm_page_size() / 2);
+  const size_t displacement = (size_t)OopEncodingHeapMax - max_heap_for_compressed_oops();
+
+  intx alignment = ObjectAlignmentInBytes;
+  size_t max_coop_heap;
+  do {
+    alignment *= 2;
+    max_coop_heap = (size_t)(((uint64_t)max_juint + 1) * (uint64_t)alignment) - displacement;
+  } while (max_heap_size > max_coop_heap && alignment < max_alignment);
+
+  if (max_heap_size > max_coop_heap) {
+    // Out of reach even at the largest alignment.
+    return;
+  }
+
+  FLAG_SET_ERGO(intx, ObjectAlignmentInBytes, alignment);
+  if (FLAG_IS_DEFAULT(SurvivorAlignmentInBytes)) {
+    // Let set_object_alignment() pick it up again.
+    SurvivorAlignmentInBytes = 0;
+  }
+  set_object_alignment();
+  log_info(gc, heap, coops)("ObjectAlignmentInBytes set to " INTX_FORMAT
+                            " for a " SIZE_FORMAT "M heap with compressed oops",
+                            ObjectAlignmentInBytes, max_heap_size / M);
+}
+
 void Arguments::set_use_compressed_oops() {
 #ifndef ZERO
 #ifdef _LP64
@@ -1697,6 +1731,13 @@ void Arguments::set_use_compressed_oops() {
   // to use UseCompressedOops is InitialHeapSize.
   size_t max_heap_size = MAX2(MaxHeapSize, InitialHeapSize);
 
+  if (ScaleObjectAlignmentForCompressedOops &&
+      FLAG_IS_DEFAULT(ObjectAlignmentInBytes) &&
+      (FLAG_IS_DEFAULT(UseCompressedOops) || UseCompressedOops) &&
+      max_heap_size > max_heap_for_compressed_oops()) {
+    scale_object_alignment_for_compressed_oops(max_heap_size);
+  }
+
   if (max_heap_size <= max_heap_for_compressed_oops()) {
 #if !defined(COMPILER1) || defined(TIERED)
     if (FLAG_IS_DEFAULT(UseCompressedOops)) {
@@ -2076,13 +2117,6 @@ jint Arguments::set_aggressive_heap_flags() {
     return JNI_EINVAL;
   }
 
-  // Get around early Solaris scheduling bug
-  // (affinity vs other jobs on system)
-  // but disallow DR and offlining (5008695).
-  if (FLAG_SET_CMDLINE(bool, BindGCTaskThreadsToCPUs, true) != Flag::SUCCESS) {
-    return JNI_EINVAL;
-  }
-
   return JNI_OK;
 }
 
@@ -2184,6 +2218,7 @@ bool Arguments::check_gc_consistency() {
   if (UseConcMarkSweepGC)                i++;
   if (UseParallelGC || UseParallelOldGC) i++;
   if (UseG1GC)                           i++;
+  if (UseEpsilonGC)                      i++;
   if (i > 1) {
     jio_fprintf(defaultStream::error_stream(),
                 "Conflicting collector combinations in option list; "
@@ -3100,6 +3135,9 @@ jint Arguments::parse_each_vm_init_arg(const JavaVMInitArgs* args, bool* patch_m
       } else if (strcmp(tail, ":disable") == 0) {
         LogConfiguration::disable_logging();
         ret = true;
+      } else if (strcmp(tail, ":async") == 0) {
+        LogConfiguration::set_async_mode(true);
+        ret = true;
       } else if (*tail == '\0') {
         ret = LogConfiguration::parse_command_line_arguments();
         assert(ret, "-Xlog without arguments should never fail to parse");
@@ -3769,6 +3807,22 @@ jint Arguments::parse_options_buffer(const char* name, char* buffer, const size_
 }
 
 void Arguments::set_shared_spaces_flags() {
+  if (ArchiveClassesAtExit != NULL) {
+    if (DumpSharedSpaces) {
+      // The archive dumping VM started at exit inherits the options in
+      // JAVA_TOOL_OPTIONS; make sure it does not try to dump again.
+      ArchiveClassesAtExit = NULL;
+    } else if (DumpLoadedClassList == NULL) {
+      // Record the loaded classes next to the archive, they are dumped
+      // into it at VM exit.
+      size_t len = strlen(ArchiveClassesAtExit) + strlen(".classlist") + 1;
+      char* list_name = NEW_C_HEAP_ARRAY(char, len, mtArguments);
+      jio_snprintf(list_name, len, "%s.classlist", ArchiveClassesAtExit);
+      FLAG_SET_ERGO(ccstr, DumpLoadedClassList, list_name);
+      FREE_C_HEAP_ARRAY(char, list_name);
+    }
+  }
+
   if (DumpSharedSpaces) {
     if (FailOverToOldVerifier) {
       // Don't fall back to the old verifier on verification failure. If a
@@ -4315,6 +4369,13 @@ jint Arguments::apply_ergo() {
     UseBiasedLocking = false;
   }
 
+  if (AsyncDeflateIdleMonitors && !MonitorInUseLists) {
+    // Async deflation walks the per-thread in-use lists.
+    warning("AsyncDeflateIdleMonitors requires MonitorInUseLists"
+            "; ignoring AsyncDeflateIdleMonitors flag." );
+    FLAG_SET_DEFAULT(AsyncDeflateIdleMonitors, false);
+  }
+
 #ifdef CC_INTERP
   // Clear flags not supported on zero.
   FLAG_SET_DEFAULT(ProfileInterpreter, false);
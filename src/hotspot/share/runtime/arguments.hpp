@@ -377,6 +377,7 @@ class Arguments : AllStatic {
   // GC ergonomics
   static void set_conservative_max_heap_alignment();
   static void set_use_compressed_oops();
+  static void scale_object_alignment_for_compressed_oops(size_t max_heap_size);
   static void set_use_compressed_klass_ptrs();
   static jint set_ergonomics_flags();
   static void set_shared_spaces_flags();
@@ -31,6 +31,8 @@
 #include "runtime/atomic.hpp"
 #include "runtime/basicLock.hpp"
 #include "runtime/biasedLocking.hpp"
+#include "runtime/handshake.hpp"
+#include "runtime/safepointMechanism.hpp"
 #include "runtime/task.hpp"
 #include "runtime/threadSMR.hpp"
 #include "runtime/vframe.hpp"
@@ -582,6 +584,70 @@ public:
 };
 
 
+// Revokes the bias of a single object by handshaking with the thread the
+// object is biased toward. Only the stack of that thread has to be walked,
+// so there is no need to stop all threads at a safepoint.
+class RevokeOneBias : public ThreadClosure {
+  Handle _obj;
+  JavaThread* _requesting_thread;
+  JavaThread* _biased_locker;
+  BiasedLocking::Condition _status_code;
+  traceid _biased_locker_id;
+  bool _completed;
+
+public:
+  RevokeOneBias(Handle obj, JavaThread* requesting_thread, JavaThread* biased_locker)
+    : _obj(obj)
+    , _requesting_thread(requesting_thread)
+    , _biased_locker(biased_locker)
+    , _status_code(BiasedLocking::NOT_BIASED)
+    , _biased_locker_id(0)
+    , _completed(false) {}
+
+  void do_thread(Thread* target) {
+    assert(target == _biased_locker, "Wrong thread");
+
+    oop o = _obj();
+    markOop mark = o->mark();
+    if (!mark->has_bias_pattern()) {
+      // Revoked by someone else in the meantime.
+      _completed = true;
+      return;
+    }
+
+    // The bias can only change hands or expire through a CAS by another
+    // thread or at a safepoint. Leave those cases to the caller; with a
+    // valid bias toward the target no one else can touch the header
+    // while the target is held in the handshake.
+    markOop prototype = o->klass()->prototype_header();
+    if (mark->biased_locker() != _biased_locker ||
+        !prototype->has_bias_pattern() ||
+        prototype->bias_epoch() != mark->bias_epoch()) {
+      return;
+    }
+
+    ResourceMark rm;
+    log_info(biasedlocking)("Revoking bias with handshake:");
+    _status_code = revoke_bias(o, false, false, _requesting_thread, NULL);
+    _biased_locker->set_cached_monitor_info(NULL);
+    _biased_locker_id = THREAD_TRACE_ID(_biased_locker);
+    _completed = true;
+  }
+
+  bool completed() const {
+    return _completed;
+  }
+
+  BiasedLocking::Condition status_code() const {
+    return _status_code;
+  }
+
+  traceid biased_locker() const {
+    return _biased_locker_id;
+  }
+};
+
+
 BiasedLocking::Condition BiasedLocking::revoke_and_rebias(Handle obj, bool attempt_rebias, TRAPS) {
   assert(!SafepointSynchronize::is_at_safepoint(), "must not be called while at safepoint");
 
@@ -644,35 +710,57 @@ BiasedLocking::Condition BiasedLocking::revoke_and_rebias(Handle obj, bool attem
     }
   }
 
+  if (mark->has_bias_pattern() &&
+      mark->biased_locker() == THREAD &&
+      obj->klass()->prototype_header()->has_bias_pattern() &&
+      obj->klass()->prototype_header()->bias_epoch() == mark->bias_epoch()) {
+    // A thread is trying to revoke the bias of an object biased
+    // toward it, again likely due to an identity hash code
+    // computation. We can again avoid a safepoint in this case
+    // since we are only going to walk our own stack. There are no
+    // races with revocations occurring in other threads because we
+    // reach no safepoints in the revocation path.
+    // Also check the epoch because even if threads match, another thread
+    // can come in with a CAS to steal the bias of an object that has a
+    // stale epoch.
+    // This does not show that the object is shared between threads, so
+    // the heuristics are not updated and cannot trigger a bulk revocation.
+    Klass *k = obj->klass();
+    ResourceMark rm;
+    log_info(biasedlocking)("Revoking bias by walking my own stack:");
+    EventBiasedLockSelfRevocation event;
+    BiasedLocking::Condition cond = revoke_bias(obj(), false, false, (JavaThread*) THREAD, NULL);
+    ((JavaThread*) THREAD)->set_cached_monitor_info(NULL);
+    assert(cond == BIAS_REVOKED, "why not?");
+    if (event.should_commit()) {
+      event.set_lockClass(k);
+      event.commit();
+    }
+    return cond;
+  }
+
   HeuristicsResult heuristics = update_heuristics(obj(), attempt_rebias);
   if (heuristics == HR_NOT_BIASED) {
     return NOT_BIASED;
   } else if (heuristics == HR_SINGLE_REVOKE) {
     Klass *k = obj->klass();
-    markOop prototype_header = k->prototype_header();
-    if (mark->biased_locker() == THREAD &&
-        prototype_header->bias_epoch() == mark->bias_epoch()) {
-      // A thread is trying to revoke the bias of an object biased
-      // toward it, again likely due to an identity hash code
-      // computation. We can again avoid a safepoint in this case
-      // since we are only going to walk our own stack. There are no
-      // races with revocations occurring in other threads because we
-      // reach no safepoints in the revocation path.
-      // Also check the epoch because even if threads match, another thread
-      // can come in with a CAS to steal the bias of an object that has a
-      // stale epoch.
-      ResourceMark rm;
-      log_info(biasedlocking)("Revoking bias by walking my own stack:");
-      EventBiasedLockSelfRevocation event;
-      BiasedLocking::Condition cond = revoke_bias(obj(), false, false, (JavaThread*) THREAD, NULL);
-      ((JavaThread*) THREAD)->set_cached_monitor_info(NULL);
-      assert(cond == BIAS_REVOKED, "why not?");
-      if (event.should_commit()) {
-        event.set_lockClass(k);
-        event.commit();
+    JavaThread* biased_locker = mark->biased_locker();
+    if (biased_locker != NULL && SafepointMechanism::uses_thread_local_poll()) {
+      // Only the biased locker has to be stopped; try a handshake with it
+      // before falling back to a safepoint below.
+      EventBiasedLockRevocation event;
+      RevokeOneBias revoke(obj, (JavaThread*) THREAD, biased_locker);
+      Handshake::execute(&revoke, biased_locker);
+      if (revoke.completed()) {
+        if (event.should_commit() && (revoke.status_code() != NOT_BIASED)) {
+          event.set_lockClass(k);
+          event.set_previousOwner(revoke.biased_locker());
+          event.commit();
+        }
+        return revoke.status_code();
       }
-      return cond;
-    } else {
+    }
+    {
       EventBiasedLockRevocation event;
       VM_RevokeBias revoke(&obj, (JavaThread*) THREAD);
       VMThread::execute(&revoke);
@@ -33,6 +33,7 @@
 #include "interpreter/bytecode.hpp"
 #include "interpreter/interpreter.hpp"
 #include "interpreter/oopMapCache.hpp"
+#include "logging/log.hpp"
 #include "memory/allocation.inline.hpp"
 #include "memory/oopFactory.hpp"
 #include "memory/resourceArea.hpp"
@@ -52,6 +53,7 @@
 #include "runtime/stubRoutines.hpp"
 #include "runtime/thread.hpp"
 #include "runtime/threadSMR.hpp"
+#include "runtime/timer.hpp"
 #include "runtime/vframe.hpp"
 #include "runtime/vframeArray.hpp"
 #include "runtime/vframe_hp.hpp"
@@ -229,11 +231,15 @@ Deoptimization::UnrollBlock* Deoptimization::fetch_unroll_info_helper(JavaThread
         }
       }
       if (objects != NULL) {
+        jlong start = os::elapsed_counter();
         JRT_BLOCK
           realloc_failures = realloc_objects(thread, &deoptee, objects, THREAD);
         JRT_END
         bool skip_internal = (cm != NULL) && !cm->is_compiled_by_jvmci();
         reassign_fields(&deoptee, &map, objects, realloc_failures, skip_internal);
+        log_debug(deoptimization)("Reallocated %d scalar replaced objects for %d frames in %.3f ms",
+                                  objects->length(), chunk->length(),
+                                  TimeHelper::counter_to_millis(os::elapsed_counter() - start));
 #ifndef PRODUCT
         if (TraceDeoptimization) {
           ttyLocker ttyl;
@@ -776,8 +782,25 @@ JRT_END
 
 
 int Deoptimization::deoptimize_dependents() {
-  Threads::deoptimized_wrt_marked_nmethods();
-  return 0;
+  return Threads::deoptimized_wrt_marked_nmethods();
+}
+
+void Deoptimization::deoptimize_all_marked() {
+  assert(SafepointSynchronize::is_at_safepoint(), "must be at safepoint");
+  // We do not want any GCs to happen while we are in the middle of this VM operation
+  ResourceMark rm;
+  DeoptimizationMarker dm;
+
+  jlong start = os::elapsed_counter();
+
+  // Deoptimize all activations depending on marked nmethods
+  int frames = deoptimize_dependents();
+
+  // Make the dependent methods not entrant
+  CodeCache::make_marked_nmethods_not_entrant();
+
+  log_info(deoptimization)("Deoptimized %d frames of marked methods in %.3f ms",
+                           frames, TimeHelper::counter_to_millis(os::elapsed_counter() - start));
 }
 
 Deoptimization::DeoptAction Deoptimization::_unloaded_action
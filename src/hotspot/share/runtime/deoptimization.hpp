@@ -129,9 +129,15 @@ class Deoptimization : AllStatic {
   };
 
   // Checks all compiled methods. Invalid methods are deleted and
-  // corresponding activations are deoptimized.
+  // corresponding activations are deoptimized. Returns the number of
+  // frames deoptimized.
   static int deoptimize_dependents();
 
+  // Deoptimizes the activations of all marked compiled methods on all
+  // threads in a single pass and makes the methods not entrant.
+  // Must be called at a safepoint.
+  static void deoptimize_all_marked();
+
   // Deoptimizes a frame lazily. nmethod gets patched deopt happens on return to the frame
   static void deoptimize(JavaThread* thread, frame fr, RegisterMap *reg_map);
   static void deoptimize(JavaThread* thread, frame fr, RegisterMap *reg_map, DeoptReason reason);
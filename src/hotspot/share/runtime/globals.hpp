@@ -586,6 +586,10 @@ public:
           range(8, 256)                                                     \
           constraint(ObjectAlignmentInBytesConstraintFunc,AtParse)          \
                                                                             \
+  lp64_product(bool, ScaleObjectAlignmentForCompressedOops, false,          \
+          "Raise ObjectAlignmentInBytes ergonomically so that compressed "  \
+          "oops can address the maximum heap size")                         \
+                                                                            \
   product(bool, AssumeMP, true,                                             \
           "(Deprecated) Instruct the VM to assume multiple processors are available")\
                                                                             \
@@ -1181,6 +1185,16 @@ public:
                 "The check is performed on GuaranteedSafepointInterval.")   \
                 range(0, 100)                                               \
                                                                             \
+  experimental(bool, AsyncDeflateIdleMonitors, false,                       \
+               "Deflate idle monitors using the ServiceThread instead of "  \
+               "at safepoints; requires MonitorInUseLists")                 \
+                                                                            \
+  experimental(intx, AsyncDeflationInterval, 250,                           \
+               "With AsyncDeflateIdleMonitors, the minimum time in ms "     \
+               "between checks of MonitorUsedDeflationThreshold by the "    \
+               "ServiceThread")                                             \
+               range(1, max_jint)                                           \
+                                                                            \
   experimental(intx, SyncFlags, 0, "(Unsafe, Unstable) "                    \
                "Experimental Sync flags")                                   \
                                                                             \
@@ -1191,6 +1205,11 @@ public:
   experimental(intx, hashCode, 5,                                           \
                "(Unstable) select hashCode generation algorithm")           \
                                                                             \
+  experimental(intx, ParkSpinLimit, 0,                                      \
+               "Maximum number of iterations a thread spins waiting for "   \
+               "unpark before blocking in Unsafe.park (0 disables)")        \
+               range(0, max_jint)                                           \
+                                                                            \
   product(bool, FilterSpuriousWakeups, true,                                \
           "When true prevents OS-level spurious, or premature, wakeups "    \
           "from Object.wait (Ignored for Windows)")                         \
@@ -1274,7 +1293,7 @@ public:
   product(bool, CompactFields, true,                                        \
           "Allocate nonstatic fields in gaps between previous fields")      \
                                                                             \
-  notproduct(bool, PrintFieldLayout, false,                                 \
+  diagnostic(bool, PrintFieldLayout, false,                                 \
           "Print field layout for each class")                              \
                                                                             \
   /* Need to limit the extent of the padding to reasonable size.          */\
@@ -1399,6 +1418,25 @@ public:
   product(bool, UseParallelOldGC, false,                                    \
           "Use the Parallel Old garbage collector")                         \
                                                                             \
+  experimental(bool, UseEpsilonGC, false,                                   \
+          "Use the Epsilon (no-op) garbage collector")                      \
+                                                                            \
+  experimental(size_t, EpsilonPrintHeapSteps, 20,                           \
+          "Print heap occupancy stats with this number of steps. "          \
+          "0 turns the printing off.")                                      \
+          range(0, max_intx)                                                \
+                                                                            \
+  experimental(size_t, EpsilonMaxTLABSize, 4 * M,                           \
+          "Max TLAB size to use with Epsilon GC. Larger value improves "    \
+          "performance at the expense of per-thread memory waste. This "    \
+          "asks TLAB machinery to cap TLAB sizes at this value.")           \
+          range(1, max_intx)                                                \
+                                                                            \
+  experimental(size_t, EpsilonMinHeapExpand, 128 * M,                       \
+          "Min expansion step for heap. Larger value improves performance " \
+          "at the potential expense of memory waste.")                      \
+          range(1, max_intx)                                                \
+                                                                            \
   product(uintx, HeapMaximumCompactionInterval, 20,                         \
           "How often should we maximally compact the heap (not allowing "   \
           "any dead space)")                                                \
@@ -1443,6 +1481,17 @@ public:
           "Force dynamic selection of the number of "                       \
           "parallel threads parallel gc will use to aid debugging")         \
                                                                             \
+  diagnostic(bool, ClaimDeepestStacksFirst, true,                           \
+          "Let parallel GC threads claim the Java threads with the "        \
+          "deepest stacks first when scanning thread roots")                \
+                                                                            \
+  product(uintx, ResourceLimitCheckInterval, 1000,                          \
+          "Interval (in milliseconds) at which the number of available "    \
+          "processors and the physical memory limit, e.g. the CPU quota "   \
+          "and memory limit of a container, are re-read and the active "    \
+          "GC and compiler threads resized to them. 0 disables the check")  \
+          range(0, max_jint)                                                \
+                                                                            \
   product(size_t, HeapSizePerGCThread, ScaleForWordSize(64*M),              \
           "Size of heap (bytes) per GC thread used in calculating the "     \
           "number of GC threads")                                           \
@@ -1745,6 +1794,10 @@ public:
   product(bool, CMSParallelRemarkEnabled, true,                             \
           "Whether parallel remark enabled (only if ParNewGC)")             \
                                                                             \
+  product(bool, CMSParallelFullGC, true,                                    \
+          "Use the parallel GC threads for the compacting collection "      \
+          "done on a concurrent mode failure (only if ParNewGC)")           \
+                                                                            \
   product(bool, CMSParallelSurvivorRemarkEnabled, true,                     \
           "Whether parallel remark of survivor space "                      \
           "enabled (effective only if CMSParallelRemarkEnabled)")           \
@@ -1890,6 +1943,12 @@ public:
   product(bool, ParallelRefProcBalancingEnabled, true,                      \
           "Enable balancing of reference processing queues")                \
                                                                             \
+  experimental(size_t, ReferencesPerThread, 1000,                           \
+          "Ergonomically start one thread for this amount of "              \
+          "references for reference processing if "                         \
+          "ParallelRefProcEnabled is true. Specify 0 to disable and "       \
+          "use all threads.")                                               \
+                                                                            \
   product(uintx, CMSTriggerRatio, 80,                                       \
           "Percentage of MinHeapFreeRatio in CMS generation that is "       \
           "allocated before a CMS collection cycle commences")              \
@@ -1974,6 +2033,11 @@ public:
   experimental(uintx, WorkStealingSpinToYieldRatio, 10,                     \
           "Ratio of hard spins to calls to yield")                          \
                                                                             \
+  product(bool, UseOWSTTaskTerminator, true,                                \
+          "Use Optimized Work Stealing Threads task termination "           \
+          "protocol: one thread spins while the others wait on a monitor "  \
+          "until work becomes available")                                   \
+                                                                            \
   develop(uintx, ObjArrayMarkingStride, 2048,                               \
           "Number of object array elements to push onto the marking stack " \
           "before pushing a continuation entry")                            \
@@ -2005,6 +2069,10 @@ public:
   product(bool, TLABStats, true,                                            \
           "Provide more detailed and expensive TLAB statistics.")           \
                                                                             \
+  product(bool, ResizeTLABOnRefill, true,                                   \
+          "Grow the TLAB of a thread that refills more often than "         \
+          "expected between GCs. Requires ResizeTLAB")                      \
+                                                                            \
   product_pd(bool, NeverActAsServerClassMachine,                            \
           "Never act like a server-class machine")                          \
                                                                             \
@@ -2263,6 +2331,11 @@ public:
   product(bool, UseCondCardMark, false,                                     \
           "Check for already marked card before updating card table")       \
                                                                             \
+  experimental(bool, UseFilteredCardMark, false,                            \
+          "Skip compiled card marks for stores that cannot create an "      \
+          "old-to-young reference. Only supported by the Serial and "       \
+          "Parallel collectors on 64-bit platforms")                        \
+                                                                            \
   diagnostic(bool, VerifyRememberedSets, false,                             \
           "Verify GC remembered sets")                                      \
                                                                             \
@@ -2336,12 +2409,6 @@ public:
   manageable(bool, PrintClassHistogram, false,                              \
           "Print a histogram of class instances")                           \
                                                                             \
-  develop(bool, TraceGCTaskManager, false,                                  \
-          "Trace actions of the GC task manager")                           \
-                                                                            \
-  develop(bool, TraceGCTaskQueue, false,                                    \
-          "Trace actions of the GC task queues")                            \
-                                                                            \
   develop(bool, TraceParallelOldGCMarkingPhase, false,                      \
           "Trace marking phase in ParallelOldGC")                           \
                                                                             \
@@ -2568,6 +2635,11 @@ public:
   product(bool, DisplayVMOutputToStdout, false,                             \
           "If DisplayVMOutput is true, display all VM output to stdout")    \
                                                                             \
+  product(size_t, AsyncLogBufferSize, 2*M,                                  \
+          "Memory budget (in bytes) for the buffers of asynchronous "       \
+          "logging (-Xlog:async)")                                          \
+          range(100*K, 50*M)                                                \
+                                                                            \
   product(bool, UseHeavyMonitors, false,                                    \
           "use heavyweight instead of lightweight Java monitors")           \
                                                                             \
@@ -2896,6 +2968,13 @@ public:
   product(intx, SafepointTimeoutDelay, 10000,                               \
           "Delay in milliseconds for option SafepointTimeout")              \
   LP64_ONLY(range(0, max_intx/MICROUNITS))                                  \
+  NOT_LP64(range(0, max_intx))                                              \
+                                                                            \
+  product(intx, SafepointSlowThreadThreshold, 0,                            \
+          "Warn about the Java thread that delayed a safepoint the most "   \
+          "when it took longer than this many milliseconds to reach it. "   \
+          "0 disables the warning")                                         \
+  LP64_ONLY(range(0, max_intx/MICROUNITS))                                  \
   NOT_LP64(range(0, max_intx))                                              \
                                                                             \
   product(intx, NmethodSweepActivity, 10,                                   \
@@ -3208,6 +3287,12 @@ public:
           "The maximum expansion of Metaspace without full GC (in bytes)")  \
           range(0, max_uintx)                                               \
                                                                             \
+  product(ccstr, MetaspaceReclaimPolicy, "balanced",                        \
+          "How Metaspace returns memory to the OS after class unloading: "  \
+          "none; balanced, to uncommit free chunks of medium size and "     \
+          "above; aggressive, to also uncommit the unused committed tail "  \
+          "of each virtual space")                                          \
+                                                                            \
   product(uintx, QueuedAllocationWarningCount, 0,                           \
           "Number of times an allocation that queues behind a GC "          \
           "will retry before printing a warning")                           \
@@ -3357,6 +3442,11 @@ public:
           "Minimum number of segments in a code cache block")               \
           range(1, 100)                                                     \
                                                                             \
+  product(uintx, InlineCacheBufferSize, 10*K,                               \
+          "Size of the buffer holding transitional inline cache stubs "     \
+          "(in bytes). A full buffer forces a safepoint to empty it")       \
+          range(1*K, 1*M)                                                   \
+                                                                            \
   notproduct(bool, ExitOnFullCodeCache, false,                              \
           "Exit the VM if we fill the code cache")                          \
                                                                             \
@@ -3744,6 +3834,12 @@ public:
           "Maximum rate sampling interval (in milliseconds)")               \
           range(0, max_intx)                                                \
                                                                             \
+  product(bool, TieredReprofileAfterDeopt, true,                            \
+          "Restart profile collection of methods deoptimized with "         \
+          "Action_reinterpret. If disabled, the existing (trap-updated) "   \
+          "profile is reused and the method is recompiled at full "         \
+          "optimization as soon as the interpreter notices it again")       \
+                                                                            \
   product_pd(bool, TieredCompilation,                                       \
           "Enable tiered compilation")                                      \
                                                                             \
@@ -3997,6 +4093,10 @@ public:
           "Dump the names all loaded classes, that could be stored into "   \
           "the CDS archive, in the specified file")                         \
                                                                             \
+  product(ccstr, ArchiveClassesAtExit, NULL,                                \
+          "Record the classes loaded by the application and dump them "     \
+          "into the specified CDS archive when the VM exits")               \
+                                                                            \
   product(ccstr, SharedClassListFile, NULL,                                 \
           "Override the default CDS class list")                            \
                                                                             \
@@ -4006,6 +4106,10 @@ public:
   product(ccstr, ExtraSharedClassListFile, NULL,                            \
           "Extra classlist for building the CDS archive file")              \
                                                                             \
+  diagnostic(bool, ArchiveResolvedConstants, true,                          \
+          "Keep constant pool entries that resolve to the same targets at " \
+          "run time resolved in the CDS archive")                           \
+                                                                            \
   experimental(size_t, ArrayAllocatorMallocLimit,                           \
           SOLARIS_ONLY(64*K) NOT_SOLARIS((size_t)-1),                       \
           "Allocation less than this value will be allocated "              \
@@ -4020,6 +4124,22 @@ public:
   product(bool, UseLockedTracing, false,                                    \
           "Use locked-tracing when doing event-based tracing")              \
                                                                             \
+  product(uintx, LockContentionThreshold, 0,                                \
+          "Record Java monitor and VM mutex acquisitions that block for "   \
+          "at least this many microseconds, see VM.lock_contention. "       \
+          "0 disables recording")                                           \
+          range(0, max_uintx)                                               \
+                                                                            \
+  product(size_t, TraceRecordingBufferSize, 0,                             \
+          "Size in bytes of the in-memory ring buffer that event-based "    \
+          "tracing records into. If 0, events are printed to tty as they "  \
+          "are committed")                                                  \
+          range(0, max_uintx)                                               \
+                                                                            \
+  product(ccstr, TraceRecordingFile, NULL,                                  \
+          "File the trace recording buffer is written to at VM exit. "      \
+          "If not set, it is printed to tty")                               \
+                                                                            \
   diagnostic(bool, UseUnalignedAccesses, false,                             \
           "Use unaligned memory accesses in Unsafe")                        \
                                                                             \
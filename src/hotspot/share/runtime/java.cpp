@@ -39,6 +39,7 @@
 #endif
 #include "logging/log.hpp"
 #include "logging/logStream.hpp"
+#include "memory/metaspaceShared.hpp"
 #include "memory/oopFactory.hpp"
 #include "memory/resourceArea.hpp"
 #include "memory/universe.hpp"
@@ -59,6 +60,7 @@
 #include "runtime/interfaceSupport.hpp"
 #include "runtime/java.hpp"
 #include "runtime/memprofiler.hpp"
+#include "runtime/resourceLimitMonitor.hpp"
 #include "runtime/sharedRuntime.hpp"
 #include "runtime/statSampler.hpp"
 #include "runtime/sweeper.hpp"
@@ -68,6 +70,7 @@
 #include "runtime/vm_operations.hpp"
 #include "services/memTracker.hpp"
 #include "trace/traceMacros.hpp"
+#include "trace/traceRecorder.hpp"
 #include "trace/tracing.hpp"
 #include "utilities/dtrace.hpp"
 #include "utilities/globalDefinitions.hpp"
@@ -463,6 +466,9 @@ void before_exit(JavaThread* thread) {
   }
 
   TRACE_VM_EXIT();
+#if INCLUDE_TRACE
+  TraceRecorder::on_vm_exit();
+#endif
 
   // Stop the WatcherThread. We do this before disenrolling various
   // PeriodicTasks to reduce the likelihood of races.
@@ -474,6 +480,8 @@ void before_exit(JavaThread* thread) {
   StatSampler::disengage();
   StatSampler::destroy();
 
+  ResourceLimitMonitor::disengage();
+
   // Stop concurrent GC threads
   Universe::heap()->stop();
 
@@ -509,20 +517,19 @@ void before_exit(JavaThread* thread) {
   print_statistics();
   Universe::heap()->print_tracing_info();
 
+  // Dump the classes loaded by this run into a CDS archive; done after the
+  // agents have shut down so that no more classes get recorded.
+  MetaspaceShared::dump_archive_at_exit();
+
   { MutexLocker ml(BeforeExit_lock);
     _before_exit_status = BEFORE_EXIT_DONE;
     BeforeExit_lock->notify_all();
   }
 
   if (VerifyStringTableAtExit) {
-    int fail_cnt = 0;
-    {
-      MutexLocker ml(StringTable_lock);
-      fail_cnt = StringTable::verify_and_compare_entries();
-    }
-
+    size_t fail_cnt = StringTable::verify_and_compare_entries();
     if (fail_cnt != 0) {
-      tty->print_cr("ERROR: fail_cnt=%d", fail_cnt);
+      tty->print_cr("ERROR: fail_cnt=" SIZE_FORMAT, fail_cnt);
       guarantee(fail_cnt == 0, "unexpected StringTable verification failures");
     }
   }
@@ -90,6 +90,10 @@ class JNIHandles : AllStatic {
   // Initialization
   static void initialize();
 
+  // Storage for global and weak global handles
+  static OopStorage* global_handles()      { return _global_handles; }
+  static OopStorage* weak_global_handles() { return _weak_global_handles; }
+
   // Debugging
   static void print_on(outputStream* st);
   static void print()           { print_on(tty); }
@@ -0,0 +1,129 @@
+/*
+ * Copyright (c) 2018, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#include "precompiled.hpp"
+#include "memory/resourceArea.hpp"
+#include "oops/symbol.hpp"
+#include "runtime/lockContention.hpp"
+#include "runtime/thread.hpp"
+#include "utilities/globalDefinitions.hpp"
+#include "utilities/ostream.hpp"
+#include "utilities/quickSort.hpp"
+
+LockContentionProfiler::Entry LockContentionProfiler::_table[LockContentionProfiler::table_size];
+int          LockContentionProfiler::_length  = 0;
+jlong        LockContentionProfiler::_dropped = 0;
+volatile int LockContentionProfiler::_lock    = 0;
+
+void LockContentionProfiler::record(Symbol* klass_name, const char* mutex_name,
+                                    jlong owner_tid, jlong blocked_ns) {
+  if (blocked_ns < (jlong)LockContentionThreshold * 1000) {
+    return;
+  }
+  Thread::SpinAcquire(&_lock, "LockContentionProfiler");
+  Entry* e = NULL;
+  for (int i = 0; i < _length; i++) {
+    Entry* cur = &_table[i];
+    if (klass_name != NULL ? cur->_klass_name == klass_name
+                           : (cur->_klass_name == NULL && strcmp(cur->_mutex_name, mutex_name) == 0)) {
+      e = cur;
+      break;
+    }
+  }
+  if (e == NULL && _length < table_size) {
+    e = &_table[_length++];
+    e->_klass_name = klass_name;
+    if (klass_name != NULL) {
+      // Keep the name alive after the class is unloaded
+      klass_name->increment_refcount();
+      e->_mutex_name[0] = '\0';
+    } else {
+      strncpy(e->_mutex_name, mutex_name, MONITOR_NAME_LEN - 1);
+      e->_mutex_name[MONITOR_NAME_LEN - 1] = '\0';
+    }
+    e->_count = 0;
+    e->_total_ns = 0;
+    e->_max_ns = 0;
+    e->_last_owner_tid = 0;
+  }
+  if (e != NULL) {
+    e->_count++;
+    e->_total_ns += blocked_ns;
+    e->_max_ns = MAX2(e->_max_ns, blocked_ns);
+    if (owner_tid != 0) {
+      e->_last_owner_tid = owner_tid;
+    }
+  } else {
+    _dropped++;
+  }
+  Thread::SpinRelease(&_lock);
+}
+
+int LockContentionProfiler::compare_total(const Entry& e1, const Entry& e2) {
+  if (e1._total_ns > e2._total_ns) return -1;
+  if (e1._total_ns < e2._total_ns) return 1;
+  return 0;
+}
+
+void LockContentionProfiler::print_on(outputStream* st) {
+  ResourceMark rm;
+  // Copy the table so that no output is done while holding the spin lock
+  Entry* entries = NEW_RESOURCE_ARRAY(Entry, table_size);
+  Thread::SpinAcquire(&_lock, "LockContentionProfiler");
+  const int length = _length;
+  const jlong dropped = _dropped;
+  memcpy(entries, _table, length * sizeof(Entry));
+  Thread::SpinRelease(&_lock);
+
+  QuickSort::sort(entries, length, compare_total, false);
+
+  st->print_cr("Lock contention above " UINTX_FORMAT " us:", LockContentionThreshold);
+  st->print_cr("%12s %14s %12s %12s  %s", "count", "total-us", "max-us", "last-owner", "lock");
+  for (int i = 0; i < length; i++) {
+    Entry* e = &entries[i];
+    st->print(INT64_FORMAT_W(12) " " INT64_FORMAT_W(14) " " INT64_FORMAT_W(12) " " INT64_FORMAT_W(12) "  ",
+              (int64_t)e->_count, (int64_t)(e->_total_ns / 1000),
+              (int64_t)(e->_max_ns / 1000), (int64_t)e->_last_owner_tid);
+    if (e->_klass_name != NULL) {
+      st->print_cr("monitor %s", e->_klass_name->as_klass_external_name());
+    } else {
+      st->print_cr("mutex %s", e->_mutex_name);
+    }
+  }
+  if (dropped > 0) {
+    st->print_cr("(" INT64_FORMAT " contended acquisitions not recorded, table full)", (int64_t)dropped);
+  }
+}
+
+void LockContentionProfiler::reset() {
+  Thread::SpinAcquire(&_lock, "LockContentionProfiler");
+  for (int i = 0; i < _length; i++) {
+    if (_table[i]._klass_name != NULL) {
+      _table[i]._klass_name->decrement_refcount();
+    }
+  }
+  _length = 0;
+  _dropped = 0;
+  Thread::SpinRelease(&_lock);
+}
@@ -0,0 +1,78 @@
+/*
+ * Copyright (c) 2018, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#ifndef SHARE_VM_RUNTIME_LOCKCONTENTION_HPP
+#define SHARE_VM_RUNTIME_LOCKCONTENTION_HPP
+
+#include "memory/allocation.hpp"
+#include "runtime/globals.hpp"
+#include "runtime/mutex.hpp"
+
+class outputStream;
+class Symbol;
+
+// Aggregates the time threads spend blocked acquiring contended Java
+// monitors and VM mutexes. Only acquisitions that block for at least
+// LockContentionThreshold microseconds are recorded, keyed by the class
+// of the monitor's object or by the mutex name.
+//
+// Recording happens inside Monitor::lock, so the table is guarded by a
+// spin lock rather than a VM mutex, and has a fixed number of entries.
+class LockContentionProfiler : AllStatic {
+ private:
+  enum { table_size = 256 };
+
+  struct Entry {
+    Symbol* _klass_name;                  // monitor object class, NULL for a mutex
+    char    _mutex_name[MONITOR_NAME_LEN];
+    jlong   _count;
+    jlong   _total_ns;
+    jlong   _max_ns;
+    jlong   _last_owner_tid;              // previous owner of a monitor, 0 if unknown
+  };
+
+  static Entry        _table[table_size];
+  static int          _length;
+  static jlong        _dropped;
+  static volatile int _lock;
+
+  static void record(Symbol* klass_name, const char* mutex_name,
+                     jlong owner_tid, jlong blocked_ns);
+  static int compare_total(const Entry& e1, const Entry& e2);
+
+ public:
+  static bool is_enabled() { return LockContentionThreshold > 0; }
+
+  static void record_monitor(Symbol* klass_name, jlong owner_tid, jlong blocked_ns) {
+    record(klass_name, NULL, owner_tid, blocked_ns);
+  }
+  static void record_mutex(const char* name, jlong blocked_ns) {
+    record(NULL, name, 0, blocked_ns);
+  }
+
+  static void print_on(outputStream* st);
+  static void reset();
+};
+
+#endif // SHARE_VM_RUNTIME_LOCKCONTENTION_HPP
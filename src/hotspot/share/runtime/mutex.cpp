@@ -25,6 +25,7 @@
 #include "precompiled.hpp"
 #include "runtime/atomic.hpp"
 #include "runtime/interfaceSupport.hpp"
+#include "runtime/lockContention.hpp"
 #include "runtime/mutex.hpp"
 #include "runtime/orderAccess.inline.hpp"
 #include "runtime/osThread.hpp"
@@ -932,6 +933,7 @@ void Monitor::lock(Thread * Self) {
   if (TrySpin(Self)) goto Exeunt;
 
   check_block_state(Self);
+  jlong contended_start = LockContentionProfiler::is_enabled() ? os::javaTimeNanos() : 0;
   if (Self->is_Java_thread()) {
     // Horrible dictu - we suffer through a state transition
     assert(rank() > Mutex::special, "Potential deadlock with special or lesser rank mutex");
@@ -941,6 +943,9 @@ void Monitor::lock(Thread * Self) {
     // Mirabile dictu
     ILock(Self);
   }
+  if (contended_start != 0) {
+    LockContentionProfiler::record_mutex(name(), os::javaTimeNanos() - contended_start);
+  }
   goto Exeunt;
 }
 
@@ -958,7 +963,13 @@ void Monitor::lock_without_safepoint_check(Thread * Self) {
   assert(_safepoint_check_required != Monitor::_safepoint_check_always,
          "This lock should always have a safepoint check: %s", name());
   assert(_owner != Self, "invariant");
-  ILock(Self);
+  if (!LockContentionProfiler::is_enabled()) {
+    ILock(Self);
+  } else if (!TryFast()) {
+    jlong contended_start = os::javaTimeNanos();
+    ILock(Self);
+    LockContentionProfiler::record_mutex(name(), os::javaTimeNanos() - contended_start);
+  }
   assert(_owner == NULL, "invariant");
   set_owner(Self);
 }
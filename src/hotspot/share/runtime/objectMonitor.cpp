@@ -31,6 +31,7 @@
 #include "runtime/atomic.hpp"
 #include "runtime/handles.inline.hpp"
 #include "runtime/interfaceSupport.hpp"
+#include "runtime/lockContention.hpp"
 #include "runtime/mutexLocker.hpp"
 #include "runtime/objectMonitor.hpp"
 #include "runtime/objectMonitor.inline.hpp"
@@ -257,7 +258,7 @@ void ObjectMonitor::operator delete[] (void *p) {
 // -----------------------------------------------------------------------------
 // Enter support
 
-void ObjectMonitor::enter(TRAPS) {
+bool ObjectMonitor::enter(TRAPS) {
   // The following code is ordered to check the most common cases first
   // and to reduce RTS->RTO cache line upgrades on SPARC and IA32 processors.
   Thread * const Self = THREAD;
@@ -267,13 +268,13 @@ void ObjectMonitor::enter(TRAPS) {
     // Either ASSERT _recursions == 0 or explicitly set _recursions = 0.
     assert(_recursions == 0, "invariant");
     assert(_owner == Self, "invariant");
-    return;
+    return true;
   }
 
   if (cur == Self) {
     // TODO-FIXME: check for integer overflow!  BUGID 6557169.
     _recursions++;
-    return;
+    return true;
   }
 
   if (Self->is_lock_owned ((address)cur)) {
@@ -282,7 +283,7 @@ void ObjectMonitor::enter(TRAPS) {
     // Commute owner from a thread-specific on-stack BasicLockObject address to
     // a full-fledged "Thread *".
     _owner = Self;
-    return;
+    return true;
   }
 
   // We've encountered genuine contention.
@@ -294,12 +295,13 @@ void ObjectMonitor::enter(TRAPS) {
   // transitions.  The following spin is strictly optional ...
   // Note that if we acquire the monitor from an initial spin
   // we forgo posting JVMTI events and firing DTRACE probes.
-  if (Knob_SpinEarly && TrySpin (Self) > 0) {
+  // There is no point in spinning on a monitor that is being deflated.
+  if (cur != DEFLATER_MARKER && Knob_SpinEarly && TrySpin (Self) > 0) {
     assert(_owner == Self, "invariant");
     assert(_recursions == 0, "invariant");
     assert(((oop)(object()))->mark() == markOopDesc::encode(this), "invariant");
     Self->_Stalled = 0;
-    return;
+    return true;
   }
 
   assert(_owner != Self, "invariant");
@@ -308,14 +310,23 @@ void ObjectMonitor::enter(TRAPS) {
   JavaThread * jt = (JavaThread *) Self;
   assert(!SafepointSynchronize::is_at_safepoint(), "invariant");
   assert(jt->thread_state() != _thread_blocked, "invariant");
-  assert(this->object() != NULL, "invariant");
-  assert(_count >= 0, "invariant");
 
   // Prevent deflation at STW-time.  See deflate_idle_monitors() and is_busy().
   // Ensure the object-monitor relationship remains stable while there's contention.
-  Atomic::inc(&_count);
+  // With AsyncDeflateIdleMonitors a non-positive result means the ServiceThread
+  // has already claimed this monitor for deflation: help it restore the object
+  // header and have the caller re-inflate.
+  if (Atomic::add(1, &_count) <= 0) {
+    assert(AsyncDeflateIdleMonitors, "only async deflation makes _count negative");
+    Atomic::dec(&_count);
+    Self->_Stalled = 0;
+    install_displaced_markword_in_object();
+    return false;
+  }
+  assert(this->object() != NULL, "invariant");
 
   EventJavaMonitorEnter event;
+  jlong contended_start = LockContentionProfiler::is_enabled() ? os::javaTimeNanos() : 0;
 
   { // Change java thread status to indicate blocked on monitor enter.
     JavaThreadBlockedOnMonitorEnterState jtbmes(jt, this);
@@ -402,6 +413,12 @@ void ObjectMonitor::enter(TRAPS) {
     // just exited the monitor.
   }
 
+  if (contended_start != 0) {
+    LockContentionProfiler::record_monitor(((oop)this->object())->klass()->name(),
+                                           _previous_owner_tid,
+                                           os::javaTimeNanos() - contended_start);
+  }
+
   if (event.should_commit()) {
     event.set_monitorClass(((oop)this->object())->klass());
     event.set_previousOwner((TYPE_THREAD)_previous_owner_tid);
@@ -410,6 +427,19 @@ void ObjectMonitor::enter(TRAPS) {
   }
 
   OM_PERFDATA_OP(ContendedLockAttempts, inc());
+  return true;
+}
+
+void ObjectMonitor::install_displaced_markword_in_object() {
+  oop obj = (oop)object();
+  if (obj == NULL) {
+    // The deflater has already restored the header and detached the object.
+    return;
+  }
+  markOop dmw = header();
+  assert(dmw->is_neutral(), "must be a neutral header: " INTPTR_FORMAT, p2i(dmw));
+  // Whoever loses the race finds the header already restored.
+  obj->cas_set_mark(dmw, markOopDesc::encode(this));
 }
 
 
@@ -936,13 +966,16 @@ void ObjectMonitor::exit(bool not_suspended, TRAPS) {
     _Responsible = NULL;
   }
 
+  // get the owner's thread id for the MonitorEnter event or the
+  // lock contention profile if either is enabled and the thread
+  // isn't suspended
+  bool record_owner = LockContentionProfiler::is_enabled();
 #if INCLUDE_TRACE
-  // get the owner's thread id for the MonitorEnter event
-  // if it is enabled and the thread isn't suspended
-  if (not_suspended && Tracing::is_event_enabled(TraceJavaMonitorEnterEvent)) {
+  record_owner = record_owner || Tracing::is_event_enabled(TraceJavaMonitorEnterEvent);
+#endif
+  if (not_suspended && record_owner) {
     _previous_owner_tid = THREAD_TRACE_ID(Self);
   }
-#endif
 
   for (;;) {
     assert(THREAD == _owner, "invariant");
@@ -1341,16 +1374,18 @@ intptr_t ObjectMonitor::complete_exit(TRAPS) {
 
 // reenter() enters a lock and sets recursion count
 // complete_exit/reenter operate as a wait without waiting
-void ObjectMonitor::reenter(intptr_t recursions, TRAPS) {
+bool ObjectMonitor::reenter(intptr_t recursions, TRAPS) {
   Thread * const Self = THREAD;
   assert(Self->is_Java_thread(), "Must be Java thread!");
   JavaThread *jt = (JavaThread *)THREAD;
 
   guarantee(_owner != Self, "reenter already owner");
-  enter(THREAD);       // enter the monitor
+  if (!enter(THREAD)) {  // enter the monitor
+    return false;        // deflated in the meantime, caller re-inflates
+  }
   guarantee(_recursions == 0, "reenter recursion");
   _recursions = recursions;
-  return;
+  return true;
 }
 
 
@@ -1589,6 +1624,8 @@ void ObjectMonitor::wait(jlong millis, bool interruptible, TRAPS) {
     assert(_owner != Self, "invariant");
     ObjectWaiter::TStates v = node.TState;
     if (v == ObjectWaiter::TS_RUN) {
+      // _waiters is still elevated so the monitor cannot have been deflated
+      // and enter() cannot fail.
       enter(Self);
     } else {
       guarantee(v == ObjectWaiter::TS_ENTER || v == ObjectWaiter::TS_CXQ, "invariant");
@@ -2224,13 +2261,15 @@ inline void ObjectMonitor::DequeueSpecificWaiter(ObjectWaiter* node) {
 
 // -----------------------------------------------------------------------------
 // PerfData support
-PerfCounter * ObjectMonitor::_sync_ContendedLockAttempts       = NULL;
-PerfCounter * ObjectMonitor::_sync_FutileWakeups               = NULL;
-PerfCounter * ObjectMonitor::_sync_Parks                       = NULL;
-PerfCounter * ObjectMonitor::_sync_Notifications               = NULL;
+PerfStripedCounter * ObjectMonitor::_sync_ContendedLockAttempts = NULL;
+PerfStripedCounter * ObjectMonitor::_sync_FutileWakeups         = NULL;
+PerfStripedCounter * ObjectMonitor::_sync_Parks                 = NULL;
+PerfStripedCounter * ObjectMonitor::_sync_Notifications         = NULL;
 PerfCounter * ObjectMonitor::_sync_Inflations                  = NULL;
 PerfCounter * ObjectMonitor::_sync_Deflations                  = NULL;
 PerfLongVariable * ObjectMonitor::_sync_MonExtant              = NULL;
+PerfCounter * ObjectMonitor::_sync_RTMDisabledMonitors         = NULL;
+volatile jlong ObjectMonitor::_rtm_disabled_monitors           = 0;
 
 // One-shot global initialization for the sync subsystem.
 // We could also defer initialization and initialize on-demand
@@ -2248,6 +2287,12 @@ void ObjectMonitor::Initialize() {
     n = PerfDataManager::create_counter(SUN_RT, #n, PerfData::U_Events,  \
                                         CHECK);                          \
   }
+#define NEWPERFSTRIPEDCOUNTER(n)                                         \
+  {                                                                      \
+    n = PerfDataManager::create_striped_counter(SUN_RT, #n,              \
+                                                PerfData::U_Events,      \
+                                                CHECK);                  \
+  }
 #define NEWPERFVARIABLE(n)                                                \
   {                                                                       \
     n = PerfDataManager::create_variable(SUN_RT, #n, PerfData::U_Events,  \
@@ -2255,12 +2300,17 @@ void ObjectMonitor::Initialize() {
   }
     NEWPERFCOUNTER(_sync_Inflations);
     NEWPERFCOUNTER(_sync_Deflations);
-    NEWPERFCOUNTER(_sync_ContendedLockAttempts);
-    NEWPERFCOUNTER(_sync_FutileWakeups);
-    NEWPERFCOUNTER(_sync_Parks);
-    NEWPERFCOUNTER(_sync_Notifications);
+    NEWPERFSTRIPEDCOUNTER(_sync_ContendedLockAttempts);
+    NEWPERFSTRIPEDCOUNTER(_sync_FutileWakeups);
+    NEWPERFSTRIPEDCOUNTER(_sync_Parks);
+    NEWPERFSTRIPEDCOUNTER(_sync_Notifications);
     NEWPERFVARIABLE(_sync_MonExtant);
+    _sync_RTMDisabledMonitors =
+      PerfDataManager::create_counter(SUN_RT, "_sync_RTMDisabledMonitors",
+                                      PerfData::U_Events,
+                                      (jlong*)&_rtm_disabled_monitors, CHECK);
 #undef NEWPERFCOUNTER
+#undef NEWPERFSTRIPEDCOUNTER
 #undef NEWPERFVARIABLE
   }
 }
@@ -126,6 +126,12 @@ class EventJavaMonitorWait;
 //     intptr_t. There's no reason to use a 64-bit type for this field
 //     in a 64-bit JVM.
 
+// Special owner value used by AsyncDeflateIdleMonitors while the
+// ServiceThread deflates an idle monitor; see ObjectSynchronizer::
+// deflate_monitor_async().  A monitor that is being, or has been,
+// deflated has this owner and a negative _count.
+#define DEFLATER_MARKER reinterpret_cast<void*>(-1)
+
 class ObjectMonitor {
  public:
   enum {
@@ -163,10 +169,12 @@ class ObjectMonitor {
 
   volatile int _Spinner;            // for exit->spinner handoff optimization
   volatile int _SpinDuration;
+  volatile int _rtm_aborts;         // RTM aborts seen by compiled code eliding this monitor
 
   volatile jint  _count;            // reference count to prevent reclamation/deflation
                                     // at stop-the-world time.  See deflate_idle_monitors().
                                     // _count is approximately |_WaitSet| + |_EntryList|
+                                    // Negative once async deflation has claimed the monitor.
  protected:
   ObjectWaiter * volatile _WaitSet; // LL of threads wait()ing on the monitor
   volatile jint  _waiters;          // number of waiting threads
@@ -188,13 +196,20 @@ class ObjectMonitor {
       }                                          \
     } while (0)
 
-  static PerfCounter * _sync_ContendedLockAttempts;
-  static PerfCounter * _sync_FutileWakeups;
-  static PerfCounter * _sync_Parks;
-  static PerfCounter * _sync_Notifications;
+  // Updated on every contended enter, park and notify, so striped
+  static PerfStripedCounter * _sync_ContendedLockAttempts;
+  static PerfStripedCounter * _sync_FutileWakeups;
+  static PerfStripedCounter * _sync_Parks;
+  static PerfStripedCounter * _sync_Notifications;
   static PerfCounter * _sync_Inflations;
   static PerfCounter * _sync_Deflations;
   static PerfLongVariable * _sync_MonExtant;
+  static PerfCounter * _sync_RTMDisabledMonitors;
+
+  // Number of monitors that reached RTMMonitorAbortThreshold. Incremented
+  // by compiled code, so it is sampled into _sync_RTMDisabledMonitors
+  // rather than updated through it.
+  static volatile jlong _rtm_disabled_monitors;
 
   static int Knob_ExitRelease;
   static int Knob_Verbose;
@@ -217,6 +232,7 @@ class ObjectMonitor {
   static int cxq_offset_in_bytes()         { return offset_of(ObjectMonitor, _cxq); }
   static int succ_offset_in_bytes()        { return offset_of(ObjectMonitor, _succ); }
   static int EntryList_offset_in_bytes()   { return offset_of(ObjectMonitor, _EntryList); }
+  static int rtm_aborts_offset_in_bytes()  { return offset_of(ObjectMonitor, _rtm_aborts); }
 
   // ObjectMonitor references can be ORed with markOopDesc::monitor_value
   // as part of the ObjectMonitor tagging mechanism. When we combine an
@@ -245,6 +261,12 @@ class ObjectMonitor {
 
   intptr_t  is_entered(Thread* current) const;
 
+  // True if the ServiceThread has won the race to deflate this monitor.
+  bool      is_being_async_deflated() const;
+  // Restore the displaced header into the object if it still refers to
+  // this monitor.  Used to help a racing async deflation finish.
+  void      install_displaced_markword_in_object();
+
   void*     owner() const;
   void      set_owner(void* owner);
 
@@ -283,6 +305,7 @@ class ObjectMonitor {
     _cxq           = NULL;
     _WaitSet       = NULL;
     _recursions    = 0;
+    _rtm_aborts    = 0;
   }
 
  public:
@@ -297,7 +320,9 @@ class ObjectMonitor {
   static void sanity_checks();  // public for -XX:+ExecuteInternalVMTests
                                 // in PRODUCT for -XX:SyncKnobs=Verbose=1
 
-  void      enter(TRAPS);
+  // Returns false if the monitor was concurrently deflated; the caller
+  // must then re-inflate the object and try again.
+  bool      enter(TRAPS);
   void      exit(bool not_suspended, TRAPS);
   void      wait(jlong millis, bool interruptable, TRAPS);
   void      notify(TRAPS);
@@ -305,7 +330,7 @@ class ObjectMonitor {
 
 // Use the following at your own risk
   intptr_t  complete_exit(TRAPS);
-  void      reenter(intptr_t recursions, TRAPS);
+  bool      reenter(intptr_t recursions, TRAPS);
 
  private:
   void      AddWaiter(ObjectWaiter * waiter);
@@ -32,6 +32,10 @@ inline intptr_t ObjectMonitor::is_entered(TRAPS) const {
   return 0;
 }
 
+inline bool ObjectMonitor::is_being_async_deflated() const {
+  return _owner == DEFLATER_MARKER && _count < 0;
+}
+
 inline markOop ObjectMonitor::header() const {
   return _header;
 }
@@ -122,6 +122,11 @@ int os::snprintf(char* buf, size_t len, const char* fmt, ...) {
 // Also, people wanted milliseconds on there,
 // and strftime doesn't do milliseconds.
 char* os::iso8601_time(char* buffer, size_t buffer_length, bool utc) {
+  return iso8601_time(javaTimeMillis(), buffer, buffer_length, utc);
+}
+
+char* os::iso8601_time(jlong milliseconds_since_19700101, char* buffer,
+                       size_t buffer_length, bool utc) {
   // Output will be of the form "YYYY-MM-DDThh:mm:ss.mmm+zzzz\0"
   //                                      1         2
   //                             12345678901234567890123456789
@@ -137,8 +142,6 @@ char* os::iso8601_time(char* buffer, size_t buffer_length, bool utc) {
     assert(false, "buffer_length too small");
     return NULL;
   }
-  // Get the current time
-  jlong milliseconds_since_19700101 = javaTimeMillis();
   const int milliseconds_per_microsecond = 1000;
   const time_t seconds_since_19700101 =
     milliseconds_since_19700101 / milliseconds_per_microsecond;
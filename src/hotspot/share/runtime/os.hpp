@@ -160,6 +160,7 @@ class os: AllStatic {
   static jint init_2(void);                    // Called after command line parsing
                                                // and VM ergonomics processing
   static void init_globals(void) {             // Called from init_globals() in init.cpp
+    LINUX_ONLY(Linux::tsc_clock_init();)
     init_globals_ext();
   }
 
@@ -214,6 +215,9 @@ class os: AllStatic {
   // E.g., YYYY-MM-DDThh:mm:ss.mmm+zzzz.
   // Returns buffer, or NULL if it failed.
   static char* iso8601_time(char* buffer, size_t buffer_length, bool utc = false);
+  // Same, for a time given in milliseconds since the epoch.
+  static char* iso8601_time(jlong milliseconds_since_19700101, char* buffer,
+                            size_t buffer_length, bool utc = false);
 
   // Interface for detecting multiprocessor system
   static inline bool is_MP() {
@@ -339,6 +343,19 @@ class os: AllStatic {
   // are passed.
   static void   pretouch_memory(void* start, void* end, size_t page_size = vm_page_size());
 
+  // Count the bytes of [start, start + size) currently backed by physical
+  // memory (resident). Returns false if the platform cannot tell.
+  static bool   resident_size_in_range(address start, size_t size, size_t* resident);
+
+  // Count the bytes of [start, start + size) currently backed by transparent
+  // huge pages. Returns false if the platform cannot tell.
+  static bool   huge_page_backed_size_in_range(address start, size_t size, size_t* backed);
+
+  // Add the resident bytes of [start, start + size) to node_sizes[node] for
+  // each NUMA node id below node_count. Returns false if the platform cannot
+  // tell on which node a page resides.
+  static bool   numa_node_residency(address start, size_t size, size_t* node_sizes, int node_count);
+
   enum ProtType { MEM_PROT_NONE, MEM_PROT_READ, MEM_PROT_RW, MEM_PROT_RWX };
   static bool   protect_memory(char* addr, size_t bytes, ProtType prot,
                                bool is_committed = true);
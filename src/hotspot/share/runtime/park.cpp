@@ -24,6 +24,9 @@
 
 #include "precompiled.hpp"
 #include "memory/allocation.inline.hpp"
+#include "runtime/atomic.hpp"
+#include "runtime/os.hpp"
+#include "runtime/safepointMechanism.inline.hpp"
 #include "runtime/thread.hpp"
 
 // Lifecycle management for TSM ParkEvents.
@@ -165,3 +168,36 @@ void Parker::Release (Parker * p) {
   Thread::SpinRelease(&ListLock);
 }
 
+// Adaptive spin-then-park. Handoffs in j.u.c. executors and locks often
+// unpark the waiter within microseconds, in which case spinning saves the
+// futex round trip and context switch. Each Parker keeps its own spin
+// budget: a permit that arrives while spinning doubles it, up to
+// ParkSpinLimit, and a spin that ends in blocking halves it. The budget
+// never drops below 1/16 of the limit so that a thread whose handoff
+// latency improves gets to spin again.
+//
+// The caller is still _thread_in_vm, so the spin is abandoned as soon as
+// a safepoint or handshake is pending, or the thread is interrupted.
+bool Parker::spin_for_permit(JavaThread* jt) {
+  if (ParkSpinLimit == 0 || os::active_processor_count() < 2) {
+    return false;
+  }
+  const int min_duration = MAX2((int)(ParkSpinLimit >> 4), 1);
+  int duration = _spin_duration;
+  if (duration < min_duration || duration > ParkSpinLimit) {
+    duration = min_duration;
+  }
+  for (int ctr = duration; ctr > 0; ctr--) {
+    if (_counter > 0 && Atomic::xchg(0, &_counter) > 0) {
+      _spin_duration = MIN2(duration * 2, (int)ParkSpinLimit);
+      return true;
+    }
+    if ((ctr & 0xFF) == 0 &&
+        (SafepointMechanism::poll(jt) || Thread::is_interrupted(jt, false))) {
+      break;
+    }
+    SpinPause();
+  }
+  _spin_duration = MAX2(duration / 2, min_duration);
+  return false;
+}
@@ -48,12 +48,14 @@
 class Parker : public os::PlatformParker {
 private:
   volatile int _counter ;
+  int _spin_duration ;          // Adaptive spin budget, see spin_for_permit()
   Parker * FreeNext ;
   JavaThread * AssociatedWith ; // Current association
 
 public:
   Parker() : PlatformParker() {
     _counter       = 0 ;
+    _spin_duration = 0 ;
     FreeNext       = NULL ;
     AssociatedWith = NULL ;
   }
@@ -65,6 +67,10 @@ public:
   void park(bool isAbsolute, jlong time);
   void unpark();
 
+  // Spin briefly waiting for an unpark before the platform park blocks.
+  // Returns true if the permit was consumed while spinning.
+  bool spin_for_permit(JavaThread* jt);
+
   // Lifecycle operators
   static Parker * Allocate (JavaThread * t) ;
   static void Release (Parker * e) ;
@@ -34,6 +34,8 @@
 #include "runtime/mutexLocker.hpp"
 #include "runtime/os.hpp"
 #include "runtime/perfData.inline.hpp"
+#include "runtime/thread.inline.hpp"
+#include "utilities/align.hpp"
 #include "utilities/exceptions.hpp"
 #include "utilities/globalDefinitions.hpp"
 
@@ -219,6 +221,42 @@ void PerfLongVariant::sample() {
   }
 }
 
+PerfLongStripedCounter::PerfLongStripedCounter(CounterNS ns, const char* namep,
+                                               Units u)
+                                              : PerfLongCounter(ns, namep, u) {
+  // Each stripe must own a whole cache line, so over-allocate and align.
+  _stripes_base = NEW_C_HEAP_ARRAY(char, stripe_count * sizeof(Stripe) + DEFAULT_CACHE_LINE_SIZE,
+                                   mtInternal);
+  _stripes = (Stripe*)align_up(_stripes_base, DEFAULT_CACHE_LINE_SIZE);
+  for (int i = 0; i < stripe_count; i++) {
+    _stripes[i]._value = 0;
+  }
+}
+
+PerfLongStripedCounter::~PerfLongStripedCounter() {
+  FREE_C_HEAP_ARRAY(char, _stripes_base);
+}
+
+uint PerfLongStripedCounter::stripe_index() {
+  // Hash the current Thread*, a thread-local read. The OS thread id would
+  // cost a system call on Linux. Thread objects are aligned, so the stripe
+  // comes from the high bits of a multiplicative hash.
+  uintx id = (uintx)Thread::current_or_null();
+  return (uint)((id * (uintx)UCONST64(0x9E3779B97F4A7C15)) >> (BitsPerWord - log2_stripe_count));
+}
+
+jlong PerfLongStripedCounter::get_value() {
+  jlong sum = 0;
+  for (int i = 0; i < stripe_count; i++) {
+    sum += _stripes[i]._value;
+  }
+  return sum;
+}
+
+void PerfLongStripedCounter::sample() {
+  *(jlong*)_valuep = get_value();
+}
+
 PerfByteArray::PerfByteArray(CounterNS ns, const char* namep, Units u,
                              Variability v, jint length)
                             : PerfData(ns, namep, u, v), _length(length) {
@@ -564,6 +602,28 @@ PerfLongCounter* PerfDataManager::create_long_counter(CounterNS ns,
   return p;
 }
 
+PerfLongStripedCounter* PerfDataManager::create_long_striped_counter(CounterNS ns,
+                                                                    const char* name,
+                                                                    PerfData::Units u,
+                                                                    TRAPS) {
+
+  // Striped counters are only published by sampling, which is not
+  // supported if UsePerfData is false
+  if (!UsePerfData) return NULL;
+
+  PerfLongStripedCounter* p = new PerfLongStripedCounter(ns, name, u);
+
+  if (!p->is_valid()) {
+    // allocation of native resources failed.
+    delete p;
+    THROW_0(vmSymbols::java_lang_OutOfMemoryError());
+  }
+
+  add_item(p, true);
+
+  return p;
+}
+
 PerfDataList::PerfDataList(int length) {
 
   _set = new(ResourceObj::C_HEAP, mtInternal) PerfDataArray(length, true);
@@ -462,6 +462,50 @@ class PerfLongCounter : public PerfLongVariant {
 
 typedef PerfLongCounter PerfCounter;
 
+/*
+ * The PerfLongStripedCounter class, and its alias PerfStripedCounter,
+ * implement a PerfLongCounter for frequently updated events. Updates go
+ * to one of several cache line sized stripes in the C heap, selected by
+ * the updating thread, rather than to the shared PerfData memory. The
+ * stripes are summed into the PerfData memory whenever the StatSampler
+ * samples, so external readers see an unchanged format with a value that
+ * lags by at most one sampling interval.
+ */
+class PerfLongStripedCounter : public PerfLongCounter {
+
+  friend class PerfDataManager; // for access to protected constructor
+  friend class PerfStripedCounterTest;
+
+  private:
+    enum { log2_stripe_count = 4, stripe_count = 1 << log2_stripe_count };
+
+    struct Stripe {
+      volatile jlong _value;
+      char           _pad[DEFAULT_CACHE_LINE_SIZE - sizeof(jlong)];
+    };
+
+    char*   _stripes_base;      // unaligned allocation, for freeing
+    Stripe* _stripes;           // cache line aligned
+
+    static uint stripe_index();
+
+  protected:
+    PerfLongStripedCounter(CounterNS ns, const char* namep, Units u);
+    ~PerfLongStripedCounter();
+
+    void sample();
+
+  public:
+    inline void inc() { _stripes[stripe_index()]._value++; }
+    inline void inc(jlong val) { _stripes[stripe_index()]._value += val; }
+    inline void add(jlong val) { inc(val); }
+
+    // Current sum of the stripes, which may be ahead of the sampled value
+    jlong get_value();
+};
+
+typedef PerfLongStripedCounter PerfStripedCounter;
+
 /*
  * The PerfLongVariable class, and its alias PerfVariable, implement
  * a PerfData subtype that holds a jlong data value that can
@@ -821,6 +865,11 @@ class PerfDataManager : AllStatic {
                                                 PerfLongSampleHelper* sh,
                                                 TRAPS);
 
+    static PerfLongStripedCounter* create_long_striped_counter(CounterNS ns,
+                                                               const char* name,
+                                                               PerfData::Units u,
+                                                               TRAPS);
+
 
     // these creation methods are provided for ease of use. These allow
     // Long performance data types to be created with a shorthand syntax.
@@ -872,6 +921,11 @@ class PerfDataManager : AllStatic {
       return create_long_counter(ns, name, u, sh, THREAD);
     }
 
+    static PerfStripedCounter* create_striped_counter(CounterNS ns, const char* name,
+                                                      PerfData::Units u, TRAPS) {
+      return create_long_striped_counter(ns, name, u, THREAD);
+    }
+
     static void destroy();
     static bool has_PerfData() { return _has_PerfData; }
 };
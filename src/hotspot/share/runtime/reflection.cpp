@@ -36,6 +36,7 @@
 #include "memory/resourceArea.hpp"
 #include "memory/universe.hpp"
 #include "oops/instanceKlass.hpp"
+#include "oops/klassVtable.hpp"
 #include "oops/objArrayKlass.hpp"
 #include "oops/objArrayOop.inline.hpp"
 #include "oops/oop.inline.hpp"
@@ -1020,6 +1021,29 @@ static methodHandle resolve_interface_call(InstanceKlass* klass,
   return info.selected_method();
 }
 
+// Selects the implementation of an interface method directly from the
+// itable of the receiver class. Returns NULL when the itable cannot give
+// an answer or the selection must fail, so that resolve_interface_call
+// can produce the proper error.
+static Method* select_interface_method(const methodHandle& method, Klass* recv_klass) {
+  if (!method->has_itable_index() || !recv_klass->is_instance_klass()) {
+    return NULL;
+  }
+  InstanceKlass* holder = method->method_holder();
+  klassItable itable(InstanceKlass::cast(recv_klass));
+  for (int i = 0; i < itable.size_offset_table(); i++) {
+    itableOffsetEntry* ioe = itable.offset_entry(i);
+    if (ioe->interface_klass() == holder) {
+      Method* selected = ioe->first_method_entry(recv_klass)[method->itable_index()].method();
+      if (selected != NULL && selected->is_public() && !selected->is_abstract()) {
+        return selected;
+      }
+      return NULL;
+    }
+  }
+  return NULL;
+}
+
 // Conversion
 static BasicType basic_type_mirror_to_basic_type(oop basic_type_mirror, TRAPS) {
   assert(java_lang_Class::is_primitive(basic_type_mirror),
@@ -1096,20 +1120,23 @@ static oop invoke(InstanceKlass* klass,
         //
         // Match resolution errors with those thrown due to reflection inlining
         // Linktime resolution & IllegalAccessCheck already done by Class.getMethod()
-        method = resolve_interface_call(klass, reflected_method, target_klass, receiver, THREAD);
-        if (HAS_PENDING_EXCEPTION) {
-          // Method resolution threw an exception; wrap it in an InvocationTargetException
-          oop resolution_exception = PENDING_EXCEPTION;
-          CLEAR_PENDING_EXCEPTION;
-          // JVMTI has already reported the pending exception
-          // JVMTI internal flag reset is needed in order to report InvocationTargetException
-          if (THREAD->is_Java_thread()) {
-            JvmtiExport::clear_detected_exception((JavaThread*)THREAD);
+        method = methodHandle(THREAD, select_interface_method(reflected_method, target_klass));
+        if (method.is_null()) {
+          method = resolve_interface_call(klass, reflected_method, target_klass, receiver, THREAD);
+          if (HAS_PENDING_EXCEPTION) {
+            // Method resolution threw an exception; wrap it in an InvocationTargetException
+            oop resolution_exception = PENDING_EXCEPTION;
+            CLEAR_PENDING_EXCEPTION;
+            // JVMTI has already reported the pending exception
+            // JVMTI internal flag reset is needed in order to report InvocationTargetException
+            if (THREAD->is_Java_thread()) {
+              JvmtiExport::clear_detected_exception((JavaThread*)THREAD);
+            }
+            JavaCallArguments args(Handle(THREAD, resolution_exception));
+            THROW_ARG_0(vmSymbols::java_lang_reflect_InvocationTargetException(),
+                        vmSymbols::throwable_void_signature(),
+                        &args);
           }
-          JavaCallArguments args(Handle(THREAD, resolution_exception));
-          THROW_ARG_0(vmSymbols::java_lang_reflect_InvocationTargetException(),
-                      vmSymbols::throwable_void_signature(),
-                      &args);
         }
       }  else {
         // if the method can be overridden, we resolve using the vtable index.
@@ -0,0 +1,100 @@
+/*
+ * Copyright (c) 2018, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#include "precompiled.hpp"
+#include "compiler/compileBroker.hpp"
+#include "logging/log.hpp"
+#include "runtime/globals.hpp"
+#include "runtime/os.hpp"
+#include "runtime/resourceLimitMonitor.hpp"
+#include "runtime/task.hpp"
+#include "utilities/align.hpp"
+
+// --------------------------------------------------------
+// Class to re-read the resource limits at ResourceLimitCheckInterval
+class ResourceLimitMonitorTask : public PeriodicTask {
+  public:
+     ResourceLimitMonitorTask(int interval_time) : PeriodicTask(interval_time) {}
+     void task() { ResourceLimitMonitor::check_limits(); }
+};
+
+
+//----------------------------------------------------------
+// Implementation of ResourceLimitMonitor
+
+ResourceLimitMonitorTask* ResourceLimitMonitor::_task                   = NULL;
+volatile int              ResourceLimitMonitor::_active_processor_count = 0;
+julong                    ResourceLimitMonitor::_physical_memory        = 0;
+
+int ResourceLimitMonitor::active_processor_count() {
+  int count = _active_processor_count;
+  return count > 0 ? count : os::initial_active_processor_count();
+}
+
+/*
+ * The engage() method is called at initialization time via
+ * Thread::create_vm() to register the ResourceLimitMonitor with the
+ * WatcherThread as a periodic task.
+ */
+void ResourceLimitMonitor::engage() {
+  if (ResourceLimitCheckInterval > 0 && !is_active()) {
+    _active_processor_count = os::initial_active_processor_count();
+    _physical_memory = os::physical_memory();
+
+    size_t interval = MAX2((size_t)ResourceLimitCheckInterval, (size_t)PeriodicTask::min_interval);
+    interval = MIN2(align_down(interval, PeriodicTask::interval_gran), (size_t)PeriodicTask::max_interval);
+    _task = new ResourceLimitMonitorTask((int)interval);
+    _task->enroll();
+  }
+}
+
+/*
+ * The disengage() method is called from before_exit() in java.cpp, after
+ * the WatcherThread has been stopped.
+ */
+void ResourceLimitMonitor::disengage() {
+  if (is_active()) {
+    _task->disenroll();
+    delete _task;
+    _task = NULL;
+  }
+}
+
+void ResourceLimitMonitor::check_limits() {
+  int old_count = _active_processor_count;
+  int new_count = os::active_processor_count();
+  if (new_count != old_count) {
+    log_info(os, container)("Active processor count changed from %d to %d", old_count, new_count);
+    _active_processor_count = new_count;
+    CompileBroker::update_active_compiler_threads(new_count);
+  }
+
+  julong old_memory = _physical_memory;
+  julong new_memory = os::physical_memory();
+  if (new_memory != old_memory) {
+    log_info(os, container)("Physical memory limit changed from " JULONG_FORMAT "k to " JULONG_FORMAT "k",
+                            old_memory / K, new_memory / K);
+    _physical_memory = new_memory;
+  }
+}
@@ -0,0 +1,69 @@
+/*
+ * Copyright (c) 2018, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#ifndef SHARE_VM_RUNTIME_RESOURCELIMITMONITOR_HPP
+#define SHARE_VM_RUNTIME_RESOURCELIMITMONITOR_HPP
+
+#include "memory/allocation.hpp"
+
+class ResourceLimitMonitorTask;
+
+/*
+ * The number of processors and the amount of physical memory available to
+ * the VM may change while it runs, e.g. when the CPU quota or memory limit
+ * of the container it runs in is updated. If ResourceLimitCheckInterval is
+ * non-zero, the ResourceLimitMonitor re-reads both periodically on the
+ * WatcherThread and logs every change it observes.
+ *
+ * A changed processor count is propagated to the number of active compiler
+ * threads, and caps the number of active GC worker threads chosen by
+ * AdaptiveSizePolicy at the next collection. Neither can grow beyond the
+ * number of threads sized at startup.
+ */
+class ResourceLimitMonitor : AllStatic {
+
+  friend class ResourceLimitMonitorTask;
+
+  private:
+    static ResourceLimitMonitorTask* _task;
+
+    static volatile int _active_processor_count;
+    static julong       _physical_memory;
+
+    static void check_limits();
+
+  public:
+    // Start/stop task
+    static void engage();
+    static void disengage();
+
+    static bool is_active() { return _task != NULL; }
+
+    // The number of processors the VM currently sizes its active threads
+    // by. This is the initial active processor count until a change was
+    // observed.
+    static int active_processor_count();
+};
+
+#endif // SHARE_VM_RUNTIME_RESOURCELIMITMONITOR_HPP
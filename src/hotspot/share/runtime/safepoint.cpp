@@ -24,6 +24,7 @@
 
 #include "precompiled.hpp"
 #include "classfile/classLoaderData.hpp"
+#include "classfile/dictionary.hpp"
 #include "classfile/stringTable.hpp"
 #include "classfile/symbolTable.hpp"
 #include "classfile/systemDictionary.hpp"
@@ -34,6 +35,7 @@
 #include "code/scopeDesc.hpp"
 #include "gc/shared/collectedHeap.hpp"
 #include "gc/shared/gcLocker.inline.hpp"
+#include "gc/shared/oopStorage.hpp"
 #include "gc/shared/strongRootsScope.hpp"
 #include "gc/shared/workgroup.hpp"
 #include "interpreter/interpreter.hpp"
@@ -61,6 +63,7 @@
 #include "runtime/thread.inline.hpp"
 #include "runtime/threadSMR.hpp"
 #include "runtime/timerTrace.hpp"
+#include "runtime/vframe.hpp"
 #include "services/runtimeService.hpp"
 #include "trace/tracing.hpp"
 #include "trace/traceMacros.hpp"
@@ -172,6 +175,8 @@ void SafepointSynchronize::begin() {
     EventSafepointStateSynchronization sync_event;
     int initial_running = 0;
 
+    SafepointSyncProfiler::begin_sync(os::javaTimeNanos());
+
     _state            = _synchronizing;
 
     if (SafepointMechanism::uses_thread_local_poll()) {
@@ -219,6 +224,9 @@ void SafepointSynchronize::begin() {
       // Iterate through all threads until it have been determined how to stop them all at a safepoint
       int steps = 0 ;
       while(still_running > 0) {
+        // Threads found safe at the first check did not delay the safepoint;
+        // for the others, one time stamp per pass is enough.
+        jlong pass_time = (iterations > 0) ? os::javaTimeNanos() : 0;
         jtiwh.rewind();
         for (; JavaThread *cur = jtiwh.next(); ) {
           assert(!cur->is_ConcurrentGC_thread(), "A concurrent GC thread is unexpectly being suspended");
@@ -227,6 +235,9 @@ void SafepointSynchronize::begin() {
             cur_state->examine_state_of_thread();
             if (!cur_state->is_running()) {
               still_running--;
+              if (iterations > 0) {
+                SafepointSyncProfiler::thread_stopped(cur, pass_time);
+              }
               // consider adjusting steps downward:
               //   steps = 0
               //   steps -= NNN
@@ -399,6 +410,8 @@ void SafepointSynchronize::begin() {
     }
   } // EventSafepointWaitBlocked
 
+  SafepointSyncProfiler::end_sync(safepoint_counter(), os::javaTimeNanos());
+
 #ifdef ASSERT
   // Make sure all the threads were visited.
   for (JavaThreadIteratorWithHandle jtiwh; JavaThread *cur = jtiwh.next(); ) {
@@ -553,6 +566,9 @@ bool SafepointSynchronize::is_cleanup_needed() {
   if (ObjectSynchronizer::is_cleanup_needed()) return true;
   // Need a safepoint if some inline cache buffers is non-empty
   if (!InlineCacheBuffer::is_empty()) return true;
+  // Need a safepoint if a class loader dictionary has outgrown its table;
+  // lookups walk ever longer bucket chains until it is resized.
+  if (Dictionary::does_any_dictionary_needs_resizing()) return true;
   return false;
 }
 
@@ -572,7 +588,7 @@ private:
 public:
   ParallelSPCleanupThreadClosure(DeflateMonitorCounters* counters) :
     _counters(counters),
-    _nmethod_cl(NMethodSweeper::prepare_mark_active_nmethods()) {}
+    _nmethod_cl(NMethodSweeper::prepare_reset_hotness_counters()) {}
 
   void do_thread(Thread* thread) {
     ObjectSynchronizer::deflate_thread_local_monitors(thread, _counters);
@@ -694,6 +710,9 @@ void SafepointSynchronize::do_cleanup_tasks() {
 
   // Finish monitor deflation.
   ObjectSynchronizer::finish_deflate_idle_monitors(&deflate_counters);
+
+  // Hand pending oop storage cleanup requests to the ServiceThread.
+  OopStorage::trigger_cleanup_if_needed();
 }
 
 
@@ -1395,3 +1414,150 @@ void SafepointSynchronize::print_stat_on_exit() {
                 INT64_FORMAT_W(5) " ms",
                 (int64_t)(_max_vmop_time / MICROUNITS));
 }
+
+// --------------------------------------------------------------------------------------------------
+// Implementation of SafepointSyncProfiler
+
+jlong        SafepointSyncProfiler::_sync_begin = 0;
+JavaThread*  SafepointSyncProfiler::_slowest_thread = NULL;
+jlong        SafepointSyncProfiler::_slowest_time = 0;
+int          SafepointSyncProfiler::_late_threads = 0;
+julong       SafepointSyncProfiler::_safepoint_count = 0;
+jlong        SafepointSyncProfiler::_total_sync_time = 0;
+jlong        SafepointSyncProfiler::_max_sync_time = 0;
+volatile int SafepointSyncProfiler::_records_lock = 0;
+SafepointSyncProfiler::SlowThreadRecord SafepointSyncProfiler::_records[SafepointSyncProfiler::max_records];
+uint         SafepointSyncProfiler::_record_count = 0;
+
+// Threads that were not safe for at least this long are remembered.
+static const jlong slow_thread_record_threshold = NANOSECS_PER_MILLISEC;
+
+void SafepointSyncProfiler::begin_sync(jlong now) {
+  _sync_begin = now;
+  _slowest_thread = NULL;
+  _slowest_time = 0;
+  _late_threads = 0;
+}
+
+// The thread is stopped at this point, so its top Java frame is where it
+// reached the safepoint: typically the poll at the end of the loop or
+// method that kept it from getting there sooner.
+void SafepointSyncProfiler::describe_location(JavaThread* thread, char* buf, size_t buflen,
+                                              Method** method, int* bci, bool* compiled) {
+  *method = NULL;
+  *bci = InvocationEntryBci;
+  *compiled = false;
+  if (!thread->has_last_Java_frame()) {
+    jio_snprintf(buf, buflen, "(no Java frame)");
+    return;
+  }
+  vframeStream vfst(thread);
+  if (vfst.at_end()) {
+    jio_snprintf(buf, buflen, "(no Java frame)");
+    return;
+  }
+  *method = vfst.method();
+  *bci = vfst.bci();
+  *compiled = !vfst.is_interpreted_frame();
+  size_t len = strlen((*method)->name_and_sig_as_C_string(buf, (int)buflen));
+  if (*compiled) {
+    jio_snprintf(buf + len, buflen - len, " @ %d (nmethod " INTPTR_FORMAT ")", *bci, p2i(vfst.nm()));
+  } else {
+    jio_snprintf(buf + len, buflen - len, " @ %d (interpreted)", *bci);
+  }
+}
+
+void SafepointSyncProfiler::end_sync(int safepoint_id, jlong now) {
+  assert(SafepointSynchronize::is_at_safepoint(), "must be at safepoint");
+  jlong sync_time = now - _sync_begin;
+
+  Thread::SpinAcquire(&_records_lock, "SafepointSyncProfiler");
+  _safepoint_count++;
+  _total_sync_time += sync_time;
+  _max_sync_time = MAX2(_max_sync_time, sync_time);
+  Thread::SpinRelease(&_records_lock);
+
+  if (_slowest_thread == NULL || _slowest_time < slow_thread_record_threshold) {
+    return;
+  }
+
+  ResourceMark rm;
+  SlowThreadRecord rec;
+  rec._safepoint_id = safepoint_id;
+  rec._time_to_safepoint = _slowest_time;
+  rec._sync_time = sync_time;
+  rec._late_threads = _late_threads;
+  strncpy(rec._thread_name, _slowest_thread->get_thread_name(), thread_name_length - 1);
+  rec._thread_name[thread_name_length - 1] = '\0';
+  Method* method;
+  int bci;
+  bool compiled;
+  describe_location(_slowest_thread, rec._location, location_length, &method, &bci, &compiled);
+
+  Thread::SpinAcquire(&_records_lock, "SafepointSyncProfiler");
+  _records[_record_count % max_records] = rec;
+  _record_count++;
+  Thread::SpinRelease(&_records_lock);
+
+  EventSafepointSlowThread event;
+  if (event.should_commit()) {
+    event.set_safepointId(safepoint_id);
+    event.set_slowThread(THREAD_TRACE_ID(_slowest_thread));
+    event.set_timeToSafepoint(_slowest_time);
+    event.set_method(method);
+    event.set_bci(bci);
+    event.set_compiled(compiled);
+    event.set_lateThreadCount(_late_threads);
+    event.commit();
+  }
+
+  if (SafepointSlowThreadThreshold > 0 &&
+      _slowest_time > (jlong)SafepointSlowThreadThreshold * MICROUNITS) {
+    log_warning(safepoint)("Safepoint %d for %s: thread \"%s\" took " JLONG_FORMAT " ms to reach it "
+                           "(total sync " JLONG_FORMAT " ms, %d late threads), stopped in %s",
+                           safepoint_id, VMThread::vm_safepoint_description(), rec._thread_name,
+                           _slowest_time / MICROUNITS, sync_time / MICROUNITS, _late_threads,
+                           rec._location);
+  }
+}
+
+void SafepointSyncProfiler::print_on(outputStream* st) {
+  SlowThreadRecord records[max_records];
+  julong count;
+  jlong total_sync_time, max_sync_time;
+  uint record_count;
+
+  // Copy out under the lock; the VM thread must not wait for the printing.
+  Thread::SpinAcquire(&_records_lock, "SafepointSyncProfiler");
+  count = _safepoint_count;
+  total_sync_time = _total_sync_time;
+  max_sync_time = _max_sync_time;
+  record_count = _record_count;
+  memcpy(records, _records, sizeof(records));
+  Thread::SpinRelease(&_records_lock);
+
+  st->print_cr("Safepoints: " JULONG_FORMAT ", total sync time: " JLONG_FORMAT " ms, "
+               "average: " JLONG_FORMAT " us, maximum: " JLONG_FORMAT " ms",
+               count, total_sync_time / MICROUNITS,
+               count == 0 ? 0 : (jlong)(total_sync_time / count) / (NANOUNITS / MICROUNITS),
+               max_sync_time / MICROUNITS);
+
+  uint n = MIN2(record_count, (uint)max_records);
+  if (n == 0) {
+    st->print_cr("No thread took longer than " JLONG_FORMAT " ms to reach a safepoint.",
+                 slow_thread_record_threshold / MICROUNITS);
+    return;
+  }
+  st->print_cr("Slowest thread of the last %u safepoints that were delayed by at least " JLONG_FORMAT " ms:",
+               n, slow_thread_record_threshold / MICROUNITS);
+  st->print_cr("%10s %10s %10s %6s  %-24s %s", "safepoint", "ttsp ms", "sync ms", "late",
+               "thread", "stopped in");
+  // Most recent first
+  for (uint i = 0; i < n; i++) {
+    const SlowThreadRecord& rec = records[(record_count - 1 - i) % max_records];
+    st->print_cr("%10d " INT64_FORMAT_W(10) " " INT64_FORMAT_W(10) " %6d  %-24s %s",
+                 rec._safepoint_id, (int64_t)(rec._time_to_safepoint / MICROUNITS),
+                 (int64_t)(rec._sync_time / MICROUNITS), rec._late_threads,
+                 rec._thread_name, rec._location);
+  }
+}
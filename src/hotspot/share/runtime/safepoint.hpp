@@ -275,6 +275,61 @@ class ThreadSafepointState: public CHeapObj<mtInternal> {
   static void destroy(JavaThread *thread);
 };
 
+// Time-to-safepoint (TTSP) profiling. While the VM thread brings the Java
+// threads to a safepoint it notes, for the threads that were not already
+// safe at the first check, when they were seen stopped. Once synchronized,
+// the slowest of them is blamed together with the method it stopped in;
+// the recent culprits are kept for the Safepoint.statistics DCmd.
+class SafepointSyncProfiler : AllStatic {
+ public:
+  enum {
+    max_records        = 16,
+    thread_name_length = 64,
+    location_length    = 256
+  };
+
+  struct SlowThreadRecord {
+    int   _safepoint_id;
+    jlong _time_to_safepoint;        // nanos from sync begin until the thread was seen stopped
+    jlong _sync_time;                // nanos from sync begin until all threads were stopped
+    int   _late_threads;             // threads not yet safe at the first check
+    char  _thread_name[thread_name_length];
+    char  _location[location_length];
+  };
+
+ private:
+  static jlong            _sync_begin;
+  static JavaThread*      _slowest_thread;
+  static jlong            _slowest_time;
+  static int              _late_threads;
+
+  static julong           _safepoint_count;
+  static jlong            _total_sync_time;
+  static jlong            _max_sync_time;
+
+  static volatile int     _records_lock;
+  static SlowThreadRecord _records[max_records];
+  static uint             _record_count;     // total number of records ever made
+
+  static void describe_location(JavaThread* thread, char* buf, size_t buflen,
+                                Method** method, int* bci, bool* compiled);
+
+ public:
+  // Only called by the VM thread from SafepointSynchronize::begin()
+  static void begin_sync(jlong now);
+  static void thread_stopped(JavaThread* thread, jlong now) {
+    jlong time = now - _sync_begin;
+    _late_threads++;
+    if (time > _slowest_time) {
+      _slowest_time = time;
+      _slowest_thread = thread;
+    }
+  }
+  static void end_sync(int safepoint_id, jlong now);
+
+  static void print_on(outputStream* st);
+};
+
 
 
 #endif // SHARE_VM_RUNTIME_SAFEPOINT_HPP
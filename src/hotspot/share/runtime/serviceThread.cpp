@@ -23,11 +23,16 @@
  */
 
 #include "precompiled.hpp"
+#include "classfile/stringTable.hpp"
+#include "classfile/symbolTable.hpp"
+#include "gc/shared/oopStorage.hpp"
 #include "runtime/interfaceSupport.hpp"
 #include "runtime/javaCalls.hpp"
+#include "runtime/jniHandles.hpp"
 #include "runtime/serviceThread.hpp"
 #include "runtime/mutexLocker.hpp"
 #include "runtime/os.hpp"
+#include "runtime/synchronizer.hpp"
 #include "prims/jvmtiImpl.hpp"
 #include "services/diagnosticArgument.hpp"
 #include "services/diagnosticFramework.hpp"
@@ -81,6 +86,15 @@ void ServiceThread::initialize() {
   }
 }
 
+static void cleanup_oopstorages() {
+  OopStorage* storages[] = { JNIHandles::global_handles(),
+                             JNIHandles::weak_global_handles(),
+                             StringTable::weak_storage() };
+  for (size_t i = 0; i < ARRAY_SIZE(storages); ++i) {
+    storages[i]->delete_empty_blocks();
+  }
+}
+
 void ServiceThread::service_thread_entry(JavaThread* jt, TRAPS) {
   while (true) {
     bool sensors_changed = false;
@@ -88,6 +102,10 @@ void ServiceThread::service_thread_entry(JavaThread* jt, TRAPS) {
     bool has_gc_notification_event = false;
     bool has_dcmd_notification_event = false;
     bool acs_notify = false;
+    bool stringtable_work = false;
+    bool symboltable_work = false;
+    bool deflate_idle_monitors = false;
+    bool oopstorage_work = false;
     JvmtiDeferredEvent jvmti_event;
     {
       // Need state transition ThreadBlockInVM so that this thread
@@ -104,10 +122,18 @@ void ServiceThread::service_thread_entry(JavaThread* jt, TRAPS) {
       while (!(sensors_changed = LowMemoryDetector::has_pending_requests()) &&
              !(has_jvmti_events = JvmtiDeferredEventQueue::has_events()) &&
               !(has_gc_notification_event = GCNotifier::has_event()) &&
-              !(has_dcmd_notification_event = DCmdFactory::has_pending_jmx_notification())) {
+              !(has_dcmd_notification_event = DCmdFactory::has_pending_jmx_notification()) &&
+              !(stringtable_work = StringTable::has_work()) &&
+              !(symboltable_work = SymbolTable::has_work()) &&
+              !(deflate_idle_monitors = ObjectSynchronizer::is_async_deflation_needed()) &&
+              !(oopstorage_work = OopStorage::has_cleanup_work_and_reset())) {
         // wait until one of the sensors has pending requests, or there is a
-        // pending JVMTI event or JMX GC notification to post
-        Service_lock->wait(Mutex::_no_safepoint_check_flag);
+        // pending JVMTI event or JMX GC notification to post, or the
+        // string or symbol table needs cleaning or growing, or it is time
+        // to check for idle monitors to deflate, or an oop storage has
+        // empty blocks to delete
+        Service_lock->wait(Mutex::_no_safepoint_check_flag,
+                           AsyncDeflateIdleMonitors ? AsyncDeflationInterval : 0);
       }
 
       if (has_jvmti_events) {
@@ -130,6 +156,22 @@ void ServiceThread::service_thread_entry(JavaThread* jt, TRAPS) {
     if(has_dcmd_notification_event) {
       DCmdFactory::send_notification(CHECK);
     }
+
+    if (stringtable_work) {
+      StringTable::do_concurrent_work(jt);
+    }
+
+    if (symboltable_work) {
+      SymbolTable::do_concurrent_work(jt);
+    }
+
+    if (deflate_idle_monitors) {
+      ObjectSynchronizer::do_async_deflation(jt);
+    }
+
+    if (oopstorage_work) {
+      cleanup_oopstorages();
+    }
   }
 }
 
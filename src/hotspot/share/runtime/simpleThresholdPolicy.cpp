@@ -188,6 +188,12 @@ CompileTask* SimpleThresholdPolicy::select_task(CompileQueue* compile_queue) {
 }
 
 void SimpleThresholdPolicy::reprofile(ScopeDesc* trap_scope, bool is_osr) {
+  if (!TieredReprofileAfterDeopt) {
+    // Keep the start counters, so that the profile collected so far still
+    // counts towards the Tier4 thresholds and the method goes straight back
+    // to C2 without another warm-up in the interpreter or at tier 3.
+    return;
+  }
   for (ScopeDesc* sd = trap_scope;; sd = sd->sender()) {
     if (PrintTieredEvents) {
       methodHandle mh(sd->method());
@@ -35,6 +35,7 @@
 #include "oops/method.hpp"
 #include "runtime/atomic.hpp"
 #include "runtime/compilationPolicy.hpp"
+#include "runtime/handshake.hpp"
 #include "runtime/mutexLocker.hpp"
 #include "runtime/orderAccess.inline.hpp"
 #include "runtime/os.hpp"
@@ -208,8 +209,30 @@ void NMethodSweeper::mark_active_nmethods() {
   }
 }
 
+#ifdef ASSERT
+void NMethodSweeper::check_current_method() {
+  CompiledMethod* cm = _current.method();
+  if (cm != NULL) {
+    if (cm->is_nmethod()) {
+      assert(CodeCache::find_blob_unsafe(cm) == cm, "Sweeper nmethod cached state invalid");
+    } else if (cm->is_aot()) {
+      assert(CodeCache::find_blob_unsafe(cm->code_begin()) == cm, "Sweeper AOT method cached state invalid");
+    } else {
+      ShouldNotReachHere();
+    }
+  }
+}
+#endif
+
 CodeBlobClosure* NMethodSweeper::prepare_mark_active_nmethods() {
-  assert(SafepointSynchronize::is_at_safepoint(), "must be executed at a safepoint");
+#ifdef ASSERT
+  if (ThreadLocalHandshakes) {
+    assert(Thread::current()->is_Code_cache_sweeper_thread(), "must be executed in the sweeper thread");
+    assert_lock_strong(CodeCache_lock);
+  } else {
+    assert(SafepointSynchronize::is_at_safepoint(), "must be executed at a safepoint");
+  }
+#endif
   // If we do not want to reclaim not-entrant or zombie methods there is no need
   // to scan stacks
   if (!MethodFlushing) {
@@ -220,15 +243,7 @@ CodeBlobClosure* NMethodSweeper::prepare_mark_active_nmethods() {
   _time_counter++;
 
   // Check for restart
-  if (_current.method() != NULL) {
-    if (_current.method()->is_nmethod()) {
-      assert(CodeCache::find_blob_unsafe(_current.method()) == _current.method(), "Sweeper nmethod cached state invalid");
-    } else if (_current.method()->is_aot()) {
-      assert(CodeCache::find_blob_unsafe(_current.method()->code_begin()) == _current.method(), "Sweeper AOT method cached state invalid");
-    } else {
-      ShouldNotReachHere();
-    }
-  }
+  check_current_method();
 
   if (wait_for_stack_scanning()) {
     _seen = 0;
@@ -251,14 +266,61 @@ CodeBlobClosure* NMethodSweeper::prepare_mark_active_nmethods() {
 }
 
 /**
-  * This function triggers a VM operation that does stack scanning of active
-  * methods. Stack scanning is mandatory for the sweeper to make progress.
+  * This function is called at each safepoint cleanup. Stack scanning for
+  * not-entrant methods is done separately by 'do_stack_scanning()', so
+  * the safepoint only resets the hotness counters of active nmethods.
+  */
+CodeBlobClosure* NMethodSweeper::prepare_reset_hotness_counters() {
+  assert(SafepointSynchronize::is_at_safepoint(), "must be executed at a safepoint");
+  if (!MethodFlushing) {
+    return NULL;
+  }
+
+  // Increase time so that we can estimate when to invoke the sweeper again.
+  _time_counter++;
+
+  // Check for restart
+  check_current_method();
+
+  return &set_hotness_closure;
+}
+
+class NMethodMarkingThreadClosure : public ThreadClosure {
+private:
+  CodeBlobClosure* _cl;
+public:
+  NMethodMarkingThreadClosure(CodeBlobClosure* cl) : _cl(cl) {}
+  void do_thread(Thread* thread) {
+    if (thread->is_Java_thread() && ! thread->is_Code_cache_sweeper_thread()) {
+      JavaThread* jt = (JavaThread*) thread;
+      jt->nmethods_do(_cl);
+    }
+  }
+};
+
+/**
+  * This function scans the stacks of all Java threads for active methods,
+  * using a handshake if thread-local handshakes are available and a VM
+  * operation otherwise. Stack scanning is mandatory for the sweeper to make
+  * progress.
   */
 void NMethodSweeper::do_stack_scanning() {
   assert(!CodeCache_lock->owned_by_self(), "just checking");
   if (wait_for_stack_scanning()) {
-    VM_MarkActiveNMethods op;
-    VMThread::execute(&op);
+    if (ThreadLocalHandshakes) {
+      CodeBlobClosure* code_cl;
+      {
+        MutexLockerEx ccl(CodeCache_lock, Mutex::_no_safepoint_check_flag);
+        code_cl = prepare_mark_active_nmethods();
+      }
+      if (code_cl != NULL) {
+        NMethodMarkingThreadClosure tcl(code_cl);
+        Handshake::execute(&tcl);
+      }
+    } else {
+      VM_MarkActiveNMethods op;
+      VMThread::execute(&op);
+    }
     _should_sweep = true;
   }
 }
@@ -511,11 +573,19 @@ void NMethodSweeper::sweep_code_cache() {
   }
 #endif
 
+  log_info(codecache, sweep)("Sweep %ld: swept %d, flushed %d (%d bytes), made zombie %d in %.3fms",
+                             _traversals, swept_count, flushed_count, freed_memory, zombified_count,
+                             TicksToTimeHelper::seconds(sweep_time) * 1000.0);
+
   Log(codecache, sweep) log;
   if (log.is_debug()) {
     LogStream ls(log.debug());
     CodeCache::print_summary(&ls, false);
   }
+  if (log.is_trace()) {
+    LogStream ls(log.trace());
+    CodeCache::print_fragmentation(&ls);
+  }
   log_sweep("finished");
 
   // Sweeper is the only case where memory is released, check here if it
@@ -37,8 +37,10 @@ class CodeBlobClosure;
 //    - reclamation of nmethods
 // Removing nmethods from the code cache includes two operations
 //  1) mark active nmethods
-//     Is done in 'mark_active_nmethods()'. This function is called at a
-//     safepoint and marks all nmethods that are active on a thread's stack.
+//     Is done in 'do_stack_scanning()'. With thread-local handshakes, each
+//     thread's stack is scanned by a handshake; otherwise 'mark_active_nmethods()'
+//     is called at a safepoint. Either way all nmethods that are active on a
+//     thread's stack are marked.
 //  2) sweep nmethods
 //     Is done in sweep_code_cache(). This function is the only place in the
 //     sweeper where memory is reclaimed. Note that sweep_code_cache() is not
@@ -94,6 +96,7 @@ class NMethodSweeper : public AllStatic {
   static void              release_compiled_method(CompiledMethod* nm);
 
   static void init_sweeper_log() NOT_DEBUG_RETURN;
+  static void check_current_method() NOT_DEBUG_RETURN;
   static bool wait_for_stack_scanning();
   static void sweep_code_cache();
   static void handle_safepoint_request();
@@ -115,8 +118,9 @@ class NMethodSweeper : public AllStatic {
   static void report_events();
 #endif
 
-  static void mark_active_nmethods();      // Invoked at the end of each safepoint
+  static void mark_active_nmethods();      // Invoked by VM_MarkActiveNMethods
   static CodeBlobClosure* prepare_mark_active_nmethods();
+  static CodeBlobClosure* prepare_reset_hotness_counters(); // Invoked during safepoint cleanup
   static void sweeper_loop();
   static void notify(int code_blob_type);  // Possibly start the sweeper thread.
   static void force_sweep();
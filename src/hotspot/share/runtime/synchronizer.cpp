@@ -33,6 +33,7 @@
 #include "oops/oop.inline.hpp"
 #include "runtime/atomic.hpp"
 #include "runtime/biasedLocking.hpp"
+#include "runtime/handshake.hpp"
 #include "runtime/handles.inline.hpp"
 #include "runtime/interfaceSupport.hpp"
 #include "runtime/mutexLocker.hpp"
@@ -121,9 +122,10 @@ ObjectMonitor * volatile ObjectSynchronizer::gOmInUseList  = NULL;
 // count of entries in gOmInUseList
 int ObjectSynchronizer::gOmInUseCount = 0;
 
-static volatile intptr_t gListLock = 0;      // protects global monitor lists
+static volatile intptr_t gListLock = 0;      // protects gOmInUseList
 static volatile int gMonitorFreeCount  = 0;  // # on gFreeList
 static volatile int gMonitorPopulation = 0;  // # Extant -- in circulation
+static jlong gLastAsyncDeflationTime = 0;    // os::javaTimeNanos() at end of last async deflation
 
 static void post_monitor_inflate_event(EventJavaMonitorInflate&,
                                        const oop,
@@ -364,9 +366,11 @@ void ObjectSynchronizer::slow_enter(Handle obj, BasicLock* lock, TRAPS) {
   // must be non-zero to avoid looking like a re-entrant lock,
   // and must not look locked either.
   lock->set_displaced_header(markOopDesc::unused_mark());
-  ObjectSynchronizer::inflate(THREAD,
-                              obj(),
-                              inflate_cause_monitor_enter)->enter(THREAD);
+  while (!ObjectSynchronizer::inflate(THREAD,
+                                      obj(),
+                                      inflate_cause_monitor_enter)->enter(THREAD)) {
+    // The monitor was deflated concurrently; re-inflate and retry.
+  }
 }
 
 // This routine is used to handle interpreter/compiler slow case
@@ -411,11 +415,12 @@ void ObjectSynchronizer::reenter(Handle obj, intptr_t recursion, TRAPS) {
     assert(!obj->mark()->has_bias_pattern(), "biases should be revoked by now");
   }
 
-  ObjectMonitor* monitor = ObjectSynchronizer::inflate(THREAD,
-                                                       obj(),
-                                                       inflate_cause_vm_internal);
-
-  monitor->reenter(recursion, THREAD);
+  ObjectMonitor* monitor;
+  do {
+    monitor = ObjectSynchronizer::inflate(THREAD,
+                                          obj(),
+                                          inflate_cause_vm_internal);
+  } while (!monitor->reenter(recursion, THREAD));
 }
 // -----------------------------------------------------------------------------
 // JNI locks on java objects
@@ -428,7 +433,9 @@ void ObjectSynchronizer::jni_enter(Handle obj, TRAPS) {
     assert(!obj->mark()->has_bias_pattern(), "biases should be revoked by now");
   }
   THREAD->set_current_pending_monitor_is_from_java(false);
-  ObjectSynchronizer::inflate(THREAD, obj(), inflate_cause_jni_enter)->enter(THREAD);
+  while (!ObjectSynchronizer::inflate(THREAD, obj(), inflate_cause_jni_enter)->enter(THREAD)) {
+    // The monitor was deflated concurrently; re-inflate and retry.
+  }
   THREAD->set_current_pending_monitor_is_from_java(true);
 }
 
@@ -808,6 +815,12 @@ intptr_t ObjectSynchronizer::FastHashCode(Thread * Self, oop obj) {
       hash = test->hash();
       assert(test->is_neutral(), "invariant");
       assert(hash != 0, "Trivial unexpected object/monitor header usage.");
+    } else if (monitor->is_being_async_deflated()) {
+      // The ServiceThread may have copied the header back into the object
+      // before our hash code was installed in the monitor. Make sure the
+      // object has its header back and start over from there.
+      monitor->install_displaced_markword_in_object();
+      return FastHashCode(Self, obj);
     }
   }
   // We finally get the hash
@@ -883,7 +896,8 @@ ObjectSynchronizer::LockOwnership ObjectSynchronizer::query_lock_ownership
   // not at a safepoint.
   if (mark->has_monitor()) {
     void * owner = mark->monitor()->_owner;
-    if (owner == NULL) return owner_none;
+    // A monitor being deflated has no owner.
+    if (owner == NULL || owner == DEFLATER_MARKER) return owner_none;
     return (owner == self ||
             self->is_lock_owned((address)owner)) ? owner_self : owner_other;
   }
@@ -921,7 +935,7 @@ JavaThread* ObjectSynchronizer::get_lock_owner(ThreadsList * t_list, Handle h_ob
     owner = (address) monitor->owner();
   }
 
-  if (owner != NULL) {
+  if (owner != NULL && owner != (address) DEFLATER_MARKER) {
     // owning_thread_from_monitor_owner() may also return NULL here
     return Threads::owning_thread_from_monitor_owner(t_list, owner);
   }
@@ -969,12 +983,31 @@ static bool monitors_used_above_threshold() {
 }
 
 bool ObjectSynchronizer::is_cleanup_needed() {
+  if (AsyncDeflateIdleMonitors) {
+    // Idle monitors are deflated by the ServiceThread.
+    return false;
+  }
   if (MonitorUsedDeflationThreshold > 0) {
     return monitors_used_above_threshold();
   }
   return false;
 }
 
+bool ObjectSynchronizer::is_async_deflation_needed() {
+  if (!AsyncDeflateIdleMonitors) {
+    return false;
+  }
+  if (ForceMonitorScavenge != 0) {
+    // MonitorBound was exceeded, see InduceScavenge().
+    return true;
+  }
+  jlong since_last = os::javaTimeNanos() - gLastAsyncDeflationTime;
+  if (since_last < AsyncDeflationInterval * NANOSECS_PER_MILLISEC) {
+    return false;
+  }
+  return MonitorUsedDeflationThreshold > 0 && monitors_used_above_threshold();
+}
+
 void ObjectSynchronizer::oops_do(OopClosure* f) {
   if (MonitorInUseLists) {
     // When using thread local monitor lists, we only scan the
@@ -1029,8 +1062,14 @@ void ObjectSynchronizer::list_oops_do(ObjectMonitor* list, OopClosure* f) {
 // STW-time -- disassociates idle monitors from objects.  Such
 // scavenged monitors are returned to the gFreeList.
 //
-// The global list is protected by gListLock.  All the critical sections
-// are short and operate in constant-time.
+// The global free list is a lock-free stack that only supports two
+// operations: prepending a chain of monitors (a CAS on gFreeList) and
+// detaching the whole list (an xchg of gFreeList with NULL).  Neither
+// operation reads the FreeNext field of a monitor that is still on the
+// shared list, so the stack is immune to ABA.  gBlockList is likewise
+// extended with a CAS.  The global in-use list of moribund threads is
+// protected by gListLock.  All the critical sections are short and
+// operate in constant-time.
 //
 // ObjectMonitors reside in type-stable memory (TSM) and are immortal.
 //
@@ -1065,6 +1104,11 @@ static void InduceScavenge(Thread * Self, const char * Whence) {
   // TODO: assert thread state is reasonable
 
   if (ForceMonitorScavenge == 0 && Atomic::xchg (1, &ForceMonitorScavenge) == 0) {
+    if (AsyncDeflateIdleMonitors) {
+      // No safepoint needed: the ServiceThread notices the request
+      // in is_async_deflation_needed().
+      return;
+    }
     if (ObjectMonitor::Knob_Verbose) {
       tty->print_cr("INFO: Monitor scavenge - Induced STW @%s (%d)",
                     Whence, ForceMonitorScavenge) ;
@@ -1099,6 +1143,26 @@ void ObjectSynchronizer::verifyInUse(Thread *Self) {
   assert(free_tally == Self->omFreeCount, "free count off");
 }
 
+void ObjectSynchronizer::push_free_list(ObjectMonitor* head,
+                                        ObjectMonitor* tail, int count) {
+  assert(head != NULL && tail != NULL && count > 0, "invariant");
+  for (;;) {
+    ObjectMonitor* cur = gFreeList;
+    tail->FreeNext = cur;
+    if (Atomic::cmpxchg(head, &gFreeList, cur) == cur) {
+      break;
+    }
+  }
+  Atomic::add(count, &gMonitorFreeCount);
+}
+
+ObjectMonitor* ObjectSynchronizer::take_free_list() {
+  if (gFreeList == NULL) {
+    return NULL;
+  }
+  return Atomic::xchg((ObjectMonitor*)NULL, &gFreeList);
+}
+
 ObjectMonitor* ObjectSynchronizer::omAlloc(Thread * Self) {
   // A large MAXPRIVATE value reduces both list lock contention
   // and list coherency traffic, but also tends to increase the
@@ -1113,7 +1177,7 @@ ObjectMonitor* ObjectSynchronizer::omAlloc(Thread * Self) {
     // Threads will attempt to allocate first from their local list, then
     // from the global list, and only after those attempts fail will the thread
     // attempt to instantiate new monitors.   Thread-local free lists take
-    // heat off the gListLock and improve allocation latency, as well as reducing
+    // heat off gFreeList and improve allocation latency, as well as reducing
     // coherency traffic on the shared global list.
     m = Self->omFreeList;
     if (m != NULL) {
@@ -1135,25 +1199,41 @@ ObjectMonitor* ObjectSynchronizer::omAlloc(Thread * Self) {
     }
 
     // 2: try to allocate from the global gFreeList
-    // CONSIDER: use muxTry() instead of muxAcquire().
-    // If the muxTry() fails then drop immediately into case 3.
-    // If we're using thread-local free lists then try
-    // to reprovision the caller's free list.
-    if (gFreeList != NULL) {
-      // Reprovision the thread's omFreeList.
-      // Use bulk transfers to reduce the allocation rate and heat
-      // on various locks.
-      Thread::muxAcquire(&gListLock, "omAlloc");
-      for (int i = Self->omFreeProvision; --i >= 0 && gFreeList != NULL;) {
-        gMonitorFreeCount--;
-        ObjectMonitor * take = gFreeList;
-        gFreeList = take->FreeNext;
+    // Detach the whole global list, keep omFreeProvision monitors to
+    // reprovision the caller's free list and push the remainder back.
+    // Use bulk transfers to reduce the allocation rate and heat
+    // on gFreeList.  Another thread that finds the list empty while we
+    // hold it detached falls through to case 3; that is rare and only
+    // costs one extra block.
+    ObjectMonitor * list = take_free_list();
+    if (list != NULL) {
+      int taken = 0;
+      for (int i = Self->omFreeProvision; --i >= 0 && list != NULL;) {
+        ObjectMonitor * take = list;
+        list = take->FreeNext;
         guarantee(take->object() == NULL, "invariant");
         guarantee(!take->is_busy(), "invariant");
         take->Recycle();
         omRelease(Self, take, false);
+        taken++;
+      }
+      Atomic::sub(taken, &gMonitorFreeCount);
+      // Return the rest, which is still accounted for in gMonitorFreeCount.
+      // The remainder can be long, so rather than walking it to find its
+      // tail we reinstall it if gFreeList is still empty, and otherwise
+      // prepend whatever was pushed in the meantime to it and retry.
+      while (list != NULL &&
+             Atomic::cmpxchg(list, &gFreeList, (ObjectMonitor*)NULL) != NULL) {
+        ObjectMonitor * pushed = take_free_list();
+        if (pushed != NULL) {
+          ObjectMonitor * tail = pushed;
+          while (tail->FreeNext != NULL) {
+            tail = tail->FreeNext;
+          }
+          tail->FreeNext = list;
+          list = pushed;
+        }
       }
-      Thread::muxRelease(&gListLock);
       Self->omFreeProvision += 1 + (Self->omFreeProvision/2);
       if (Self->omFreeProvision > MAXPRIVATE) Self->omFreeProvision = MAXPRIVATE;
       TEVENT(omFirst - reprovision);
@@ -1212,28 +1292,35 @@ ObjectMonitor* ObjectSynchronizer::omAlloc(Thread * Self) {
     // Element [0] is reserved for global list linkage
     temp[0].set_object(CHAINMARKER);
 
-    // Consider carving out this thread's current request from the
-    // block in hand.  This avoids some lock traffic and redundant
-    // list activity.
-
-    // Acquire the gListLock to manipulate gBlockList and gFreeList.
-    // An Oyama-Taura-Yonezawa scheme might be more efficient.
-    Thread::muxAcquire(&gListLock, "omAlloc [2]");
-    gMonitorPopulation += _BLOCKSIZE-1;
-    gMonitorFreeCount += _BLOCKSIZE-1;
+    Atomic::add(_BLOCKSIZE - 1, &gMonitorPopulation);
 
     // Add the new block to the list of extant blocks (gBlockList).
     // The very first objectMonitor in a block is reserved and dedicated.
     // It serves as blocklist "next" linkage.
-    temp[0].FreeNext = gBlockList;
-    // There are lock-free uses of gBlockList so make sure that
-    // the previous stores happen before we update gBlockList.
-    OrderAccess::release_store(&gBlockList, temp);
-
-    // Add the new string of objectMonitors to the global free list
-    temp[_BLOCKSIZE - 1].FreeNext = gFreeList;
-    gFreeList = temp + 1;
-    Thread::muxRelease(&gListLock);
+    // There are lock-free uses of gBlockList; the cmpxchg makes sure
+    // that the previous stores happen before we update gBlockList.
+    for (;;) {
+      PaddedEnd<ObjectMonitor> * cur = gBlockList;
+      temp[0].FreeNext = cur;
+      if (Atomic::cmpxchg(temp, &gBlockList, cur) == cur) {
+        break;
+      }
+    }
+
+    // Carve out this thread's current request from the block in hand.
+    // This avoids some list traffic, and since the block was just
+    // zeroed by this thread its pages are first-touched on this thread's
+    // NUMA node, so with UseNUMA the monitors the thread is about to
+    // inflate stay local to it.  The rest of the block goes to gFreeList.
+    int carve = MIN2(Self->omFreeProvision, (int)_BLOCKSIZE - 1);
+    for (int i = 1; i <= carve; i++) {
+      omRelease(Self, (ObjectMonitor *)&temp[i], false);
+    }
+    if (carve < _BLOCKSIZE - 1) {
+      push_free_list((ObjectMonitor *)&temp[carve + 1],
+                     (ObjectMonitor *)&temp[_BLOCKSIZE - 1],
+                     _BLOCKSIZE - 1 - carve);
+    }
     TEVENT(Allocate block of monitors);
   }
 }
@@ -1311,8 +1398,8 @@ void ObjectSynchronizer::omFlush(Thread * Self) {
     ObjectMonitor * s;
     // The thread is going away, the per-thread free monitors
     // are freed via set_owner(NULL)
-    // Link them to tail, which will be linked into the global free list
-    // gFreeList below, under the gListLock
+    // Link them to tail, which will be pushed onto the global free list
+    // gFreeList below
     for (s = list; s != NULL; s = s->FreeNext) {
       tally++;
       tail = s;
@@ -1343,22 +1430,20 @@ void ObjectSynchronizer::omFlush(Thread * Self) {
     guarantee(inUseTail != NULL && inUseList != NULL, "invariant");
   }
 
-  Thread::muxAcquire(&gListLock, "omFlush");
   if (tail != NULL) {
-    tail->FreeNext = gFreeList;
-    gFreeList = list;
-    gMonitorFreeCount += tally;
     assert(Self->omFreeCount == tally, "free-count off");
     Self->omFreeCount = 0;
+    push_free_list(list, tail, tally);
   }
 
   if (inUseTail != NULL) {
+    Thread::muxAcquire(&gListLock, "omFlush");
     inUseTail->FreeNext = gOmInUseList;
     gOmInUseList = inUseList;
     gOmInUseCount += inUseTally;
+    Thread::muxRelease(&gListLock);
   }
 
-  Thread::muxRelease(&gListLock);
   TEVENT(omFlush);
 }
 
@@ -1701,11 +1786,17 @@ void ObjectSynchronizer::prepare_deflate_idle_monitors(DeflateMonitorCounters* c
   counters->nInuse = 0;          // currently associated with objects
   counters->nInCirculation = 0;  // extant
   counters->nScavenged = 0;      // reclaimed
+  counters->startTime = os::javaTimeNanos();
 }
 
 void ObjectSynchronizer::deflate_idle_monitors(DeflateMonitorCounters* counters) {
   assert(SafepointSynchronize::is_at_safepoint(), "must be at safepoint");
+  if (AsyncDeflateIdleMonitors) {
+    // gOmInUseList is deflated by the ServiceThread, see do_async_deflation().
+    return;
+  }
   bool deflated = false;
+  int deflated_total = 0;
 
   ObjectMonitor * freeHeadp = NULL;  // Local SLL of scavenged monitors
   ObjectMonitor * freeTailp = NULL;
@@ -1725,6 +1816,7 @@ void ObjectSynchronizer::deflate_idle_monitors(DeflateMonitorCounters* counters)
       counters->nInCirculation += gOmInUseCount;
       int deflated_count = deflate_monitor_list((ObjectMonitor **)&gOmInUseList, &freeHeadp, &freeTailp);
       gOmInUseCount -= deflated_count;
+      deflated_total += deflated_count;
       counters->nScavenged += deflated_count;
       counters->nInuse += gOmInUseCount;
     }
@@ -1751,6 +1843,7 @@ void ObjectSynchronizer::deflate_idle_monitors(DeflateMonitorCounters* counters)
 
         if (deflated) {
           mid->FreeNext = NULL;
+          deflated_total++;
           counters->nScavenged++;
         } else {
           counters->nInuse++;
@@ -1759,23 +1852,28 @@ void ObjectSynchronizer::deflate_idle_monitors(DeflateMonitorCounters* counters)
     }
   }
 
+  Thread::muxRelease(&gListLock);
+
   // Move the scavenged monitors back to the global free list.
   if (freeHeadp != NULL) {
-    guarantee(freeTailp != NULL && counters->nScavenged > 0, "invariant");
+    guarantee(freeTailp != NULL && deflated_total > 0, "invariant");
     assert(freeTailp->FreeNext == NULL, "invariant");
     // constant-time list splice - prepend scavenged segment to gFreeList
-    freeTailp->FreeNext = gFreeList;
-    gFreeList = freeHeadp;
+    push_free_list(freeHeadp, freeTailp, deflated_total);
   }
-  Thread::muxRelease(&gListLock);
-
 }
 
 void ObjectSynchronizer::finish_deflate_idle_monitors(DeflateMonitorCounters* counters) {
-  gMonitorFreeCount += counters->nScavenged;
-
+  // gMonitorFreeCount was updated as the scavenged monitors were pushed.
   // Consider: audit gFreeList to ensure that gMonitorFreeCount and list agree.
 
+  log_info(monitorinflation, stats)("Safepoint deflation: in-circulation=%d, in-use=%d, "
+                                    "scavenged=%d, %.3f ms",
+                                    counters->nInCirculation, counters->nInuse,
+                                    counters->nScavenged,
+                                    (os::javaTimeNanos() - counters->startTime) /
+                                    (double)NANOSECS_PER_MILLISEC);
+
   if (ObjectMonitor::Knob_Verbose) {
     tty->print_cr("INFO: Deflate: InCirc=%d InUse=%d Scavenged=%d "
                   "ForceMonitorScavenge=%d : pop=%d free=%d",
@@ -1784,7 +1882,9 @@ void ObjectSynchronizer::finish_deflate_idle_monitors(DeflateMonitorCounters* co
     tty->flush();
   }
 
-  ForceMonitorScavenge = 0;    // Reset
+  if (!AsyncDeflateIdleMonitors) {
+    ForceMonitorScavenge = 0;    // Reset, otherwise left to the ServiceThread
+  }
 
   OM_PERFDATA_OP(Deflations, inc(counters->nScavenged));
   OM_PERFDATA_OP(MonExtant, set_value(counters->nInCirculation));
@@ -1798,6 +1898,9 @@ void ObjectSynchronizer::finish_deflate_idle_monitors(DeflateMonitorCounters* co
 void ObjectSynchronizer::deflate_thread_local_monitors(Thread* thread, DeflateMonitorCounters* counters) {
   assert(SafepointSynchronize::is_at_safepoint(), "must be at safepoint");
   if (!MonitorInUseLists) return;
+  // JavaThreads are handled by the ServiceThread; only the lists of the
+  // few non-JavaThreads that inflate monitors are left to the safepoint.
+  if (AsyncDeflateIdleMonitors && thread->is_Java_thread()) return;
 
   ObjectMonitor * freeHeadp = NULL;  // Local SLL of scavenged monitors
   ObjectMonitor * freeTailp = NULL;
@@ -1814,6 +1917,7 @@ void ObjectSynchronizer::deflate_thread_local_monitors(Thread* thread, DeflateMo
   }
   counters->nScavenged += deflated_count;
   counters->nInuse += thread->omInUseCount;
+  Thread::muxRelease(&gListLock);
 
   // Move the scavenged monitors back to the global free list.
   if (freeHeadp != NULL) {
@@ -1821,10 +1925,228 @@ void ObjectSynchronizer::deflate_thread_local_monitors(Thread* thread, DeflateMo
     assert(freeTailp->FreeNext == NULL, "invariant");
 
     // constant-time list splice - prepend scavenged segment to gFreeList
-    freeTailp->FreeNext = gFreeList;
-    gFreeList = freeHeadp;
+    push_free_list(freeHeadp, freeTailp, deflated_count);
   }
-  Thread::muxRelease(&gListLock);
+}
+
+// Async deflation of idle monitors
+//
+// With AsyncDeflateIdleMonitors the ServiceThread deflates idle monitors
+// while mutators are running.  The protocol with threads that race to use
+// a monitor taken from an object header is:
+//
+// 1. The deflater claims an idle monitor by CASing _owner from NULL to
+//    DEFLATER_MARKER.  Every other path acquires the monitor with a CAS
+//    from NULL, so no thread can enter it afterwards.
+// 2. The deflater commits by CASing _count from 0 to -max_jint.  An
+//    entering thread increments _count before it blocks; if it gets there
+//    first the CAS fails and the deflater gives the monitor back.  If the
+//    deflater gets there first, the entering thread sees a negative _count,
+//    helps restore the object header and re-inflates (see enter()).
+// 3. The displaced header is copied back into the object and the monitor
+//    is detached.  FastHashCode() re-checks after installing a hash code
+//    in the monitor so no hash is lost.
+//
+// A thread may still hold a pointer to a deflated monitor it loaded from
+// the header just before step 3.  Deflated monitors are therefore kept
+// back until a later handshake with all threads has completed, and are
+// only then returned to gFreeList for reuse.
+//
+// The per-thread in-use lists are only modified by their owning thread,
+// so they are walked from a handshake operation that stops that thread.
+
+// Deflate a single monitor if not in-use, concurrently with mutators.
+// Return true if deflated, false if in-use or if we lost a race for it.
+bool ObjectSynchronizer::deflate_monitor_async(ObjectMonitor* mid,
+                                               ObjectMonitor** freeHeadp,
+                                               ObjectMonitor** freeTailp) {
+  assert(AsyncDeflateIdleMonitors, "sanity check");
+  assert(!SafepointSynchronize::is_at_safepoint(), "use deflate_monitor()");
+
+  if (mid->is_busy()) {
+    return false;
+  }
+  if (Atomic::cmpxchg(DEFLATER_MARKER, &mid->_owner, (void*)NULL) != NULL) {
+    return false;
+  }
+  if (mid->_waiters != 0 || mid->_cxq != NULL || mid->_EntryList != NULL ||
+      Atomic::cmpxchg(-max_jint, &mid->_count, (jint)0) != 0) {
+    // A thread got in before we could commit; give the monitor back.
+    Atomic::cmpxchg((void*)NULL, &mid->_owner, DEFLATER_MARKER);
+    return false;
+  }
+
+  // Only the deflater clears the object field, so obj is stable here. Its
+  // header is not: once _count is negative an entering thread may restore
+  // it in enter(), and the object may then be locked or inflated again.
+  oop obj = (oop)mid->object();
+  guarantee(obj != NULL, "invariant");
+  guarantee(mid->header()->is_neutral(), "invariant");
+  TEVENT(deflate_idle_monitors - async);
+  if (log_is_enabled(Debug, monitorinflation)) {
+    if (obj->is_instance()) {
+      ResourceMark rm;
+      log_debug(monitorinflation)("Async deflating object " INTPTR_FORMAT " , "
+                                  "mark " INTPTR_FORMAT " , type %s",
+                                  p2i(obj), p2i(obj->mark()),
+                                  obj->klass()->external_name());
+    }
+  }
+
+  // Restore the header back to obj unless a racing thread already did.
+  mid->install_displaced_markword_in_object();
+  guarantee(obj->mark() != markOopDesc::encode(mid), "header must be restored");
+  mid->set_object(NULL);
+
+  // Move the monitor to the working free list defined by freeHeadp, freeTailp
+  if (*freeHeadp == NULL) *freeHeadp = mid;
+  if (*freeTailp != NULL) {
+    ObjectMonitor * prevtail = *freeTailp;
+    assert(prevtail->FreeNext == NULL, "cleaned up deflated?");
+    prevtail->FreeNext = mid;
+  }
+  *freeTailp = mid;
+  return true;
+}
+
+// Walk a given monitor list, and deflate idle monitors concurrently with
+// mutators.  The caller makes sure the list itself is stable.
+int ObjectSynchronizer::deflate_monitor_list_async(ObjectMonitor** listHeadp,
+                                                   ObjectMonitor** freeHeadp,
+                                                   ObjectMonitor** freeTailp) {
+  ObjectMonitor* mid;
+  ObjectMonitor* next;
+  ObjectMonitor* cur_mid_in_use = NULL;
+  int deflated_count = 0;
+
+  for (mid = *listHeadp; mid != NULL;) {
+    // Save the successor first: a deflated monitor is appended to the
+    // working free list, which clobbers its FreeNext.
+    next = mid->FreeNext;
+    if (mid->object() != NULL && deflate_monitor_async(mid, freeHeadp, freeTailp)) {
+      // extract from the in-use list
+      if (mid == *listHeadp) {
+        *listHeadp = next;
+      } else if (cur_mid_in_use != NULL) {
+        cur_mid_in_use->FreeNext = next;
+      }
+      mid->FreeNext = NULL;  // This mid is current tail in the freeHeadp list
+      deflated_count++;
+    } else {
+      cur_mid_in_use = mid;
+    }
+    mid = next;
+  }
+  return deflated_count;
+}
+
+// Collects the monitors deflated from each JavaThread's in-use list.  The
+// handshake may run do_thread() for several threads in parallel.
+class AsyncDeflateThreadClosure : public ThreadClosure {
+ private:
+  ObjectMonitor* volatile _free_head;
+  volatile int _in_circulation;
+  volatile int _deflated;
+
+ public:
+  AsyncDeflateThreadClosure() : _free_head(NULL), _in_circulation(0), _deflated(0) {}
+
+  // Prepend a chain of deflated monitors; push-only, so ABA is not an issue.
+  void add_deflated(ObjectMonitor* head, ObjectMonitor* tail, int count) {
+    for (;;) {
+      ObjectMonitor* cur = _free_head;
+      tail->FreeNext = cur;
+      if (Atomic::cmpxchg(head, &_free_head, cur) == cur) {
+        break;
+      }
+    }
+    Atomic::add(count, &_deflated);
+  }
+
+  void add_in_circulation(int count) {
+    Atomic::add(count, &_in_circulation);
+  }
+
+  void do_thread(Thread* thread) {
+    ObjectMonitor* freeHeadp = NULL;
+    ObjectMonitor* freeTailp = NULL;
+    add_in_circulation(thread->omInUseCount);
+    int deflated_count =
+      ObjectSynchronizer::deflate_monitor_list_async(thread->omInUseList_addr(),
+                                                     &freeHeadp, &freeTailp);
+    if (deflated_count > 0) {
+      thread->omInUseCount -= deflated_count;
+      if (ObjectMonitor::Knob_VerifyInUse) {
+        ObjectSynchronizer::verifyInUse(thread);
+      }
+      add_deflated(freeHeadp, freeTailp, deflated_count);
+    }
+  }
+
+  ObjectMonitor* free_head() const { return _free_head; }
+  int in_circulation() const       { return _in_circulation; }
+  int deflated() const             { return _deflated; }
+};
+
+class AsyncDeflateSyncClosure : public ThreadClosure {
+ public:
+  void do_thread(Thread* thread) {}
+};
+
+void ObjectSynchronizer::do_async_deflation(JavaThread* self) {
+  assert(AsyncDeflateIdleMonitors, "sanity check");
+  assert(self == Thread::current(), "must be current thread");
+  jlong start = os::javaTimeNanos();
+  AsyncDeflateThreadClosure cl;
+
+  // For moribund threads, scan gOmInUseList
+  {
+    ObjectMonitor * freeHeadp = NULL;  // Local SLL of scavenged monitors
+    ObjectMonitor * freeTailp = NULL;
+    int deflated_count = 0;
+    Thread::muxAcquire(&gListLock, "async deflation");
+    if (gOmInUseList != NULL) {
+      cl.add_in_circulation(gOmInUseCount);
+      deflated_count = deflate_monitor_list_async((ObjectMonitor **)&gOmInUseList,
+                                                  &freeHeadp, &freeTailp);
+      gOmInUseCount -= deflated_count;
+    }
+    Thread::muxRelease(&gListLock);
+    if (deflated_count > 0) {
+      cl.add_deflated(freeHeadp, freeTailp, deflated_count);
+    }
+  }
+
+  // The in-use lists of the live JavaThreads
+  Handshake::execute(&cl);
+
+  if (cl.free_head() != NULL) {
+    // Make sure no thread can still be using a just-deflated monitor that
+    // it found in an object header before that header was restored.
+    AsyncDeflateSyncClosure sync_cl;
+    Handshake::execute(&sync_cl);
+
+    ObjectMonitor* tail = NULL;
+    for (ObjectMonitor* mid = cl.free_head(); mid != NULL; mid = mid->FreeNext) {
+      assert(mid->is_being_async_deflated() && mid->object() == NULL, "invariant");
+      mid->_header = NULL;
+      mid->_count = 0;
+      mid->_owner = NULL;
+      tail = mid;
+    }
+    push_free_list(cl.free_head(), tail, cl.deflated());
+  }
+
+  ForceMonitorScavenge = 0;
+  gLastAsyncDeflationTime = os::javaTimeNanos();
+
+  OM_PERFDATA_OP(Deflations, inc(cl.deflated()));
+  log_info(monitorinflation, stats)("Async deflation: in-circulation=%d, deflated=%d, "
+                                    "pop=%d, free=%d, %.3f ms",
+                                    cl.in_circulation(), cl.deflated(),
+                                    gMonitorPopulation, gMonitorFreeCount,
+                                    (gLastAsyncDeflationTime - start) /
+                                    (double)NANOSECS_PER_MILLISEC);
 }
 
 // Monitor cleanup on JavaThread::exit
@@ -38,6 +38,7 @@ struct DeflateMonitorCounters {
   int nInuse;          // currently associated with objects
   int nInCirculation;  // extant
   int nScavenged;      // reclaimed
+  jlong startTime;     // os::javaTimeNanos() at prepare_deflate_idle_monitors()
 };
 
 class ObjectSynchronizer : AllStatic {
@@ -148,6 +149,16 @@ class ObjectSynchronizer : AllStatic {
                               ObjectMonitor** freeHeadp,
                               ObjectMonitor** freeTailp);
   static bool is_cleanup_needed();
+
+  // AsyncDeflateIdleMonitors support: deflation by the ServiceThread
+  static bool is_async_deflation_needed();
+  static void do_async_deflation(JavaThread* self);
+  static int deflate_monitor_list_async(ObjectMonitor** listheadp,
+                                        ObjectMonitor** freeHeadp,
+                                        ObjectMonitor** freeTailp);
+  static bool deflate_monitor_async(ObjectMonitor* mid,
+                                    ObjectMonitor** freeHeadp,
+                                    ObjectMonitor** freeTailp);
   static void oops_do(OopClosure* f);
   // Process oops in thread local used monitors
   static void thread_local_used_oops_do(Thread* thread, OopClosure* f);
@@ -162,7 +173,7 @@ class ObjectSynchronizer : AllStatic {
   enum { _BLOCKSIZE = 128 };
   // global list of blocks of monitors
   static PaddedEnd<ObjectMonitor> * volatile gBlockList;
-  // global monitor free list
+  // global monitor free list, a lock-free stack
   static ObjectMonitor * volatile gFreeList;
   // global monitor in-use list, for moribund threads,
   // monitors they inflated need to be scanned for deflation
@@ -177,6 +188,11 @@ class ObjectSynchronizer : AllStatic {
   // Process oops in monitors on the given list
   static void list_oops_do(ObjectMonitor* list, OopClosure* f);
 
+  // Prepend the chain [head, tail] of count free monitors to gFreeList.
+  static void push_free_list(ObjectMonitor* head, ObjectMonitor* tail, int count);
+  // Detach the whole of gFreeList, returning its former head.
+  static ObjectMonitor* take_free_list();
+
 };
 
 // ObjectLocker enforced balanced locking and can never thrown an
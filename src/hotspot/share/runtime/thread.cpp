@@ -41,6 +41,7 @@
 #include "interpreter/oopMapCache.hpp"
 #include "jvmtifiles/jvmtiEnv.hpp"
 #include "logging/log.hpp"
+#include "logging/logAsyncWriter.hpp"
 #include "logging/logConfiguration.hpp"
 #include "logging/logStream.hpp"
 #include "memory/allocation.inline.hpp"
@@ -80,6 +81,7 @@
 #include "runtime/orderAccess.inline.hpp"
 #include "runtime/osThread.hpp"
 #include "runtime/prefetch.inline.hpp"
+#include "runtime/resourceLimitMonitor.hpp"
 #include "runtime/safepoint.hpp"
 #include "runtime/safepointMechanism.inline.hpp"
 #include "runtime/sharedRuntime.hpp"
@@ -103,6 +105,7 @@
 #include "services/memTracker.hpp"
 #include "services/threadService.hpp"
 #include "trace/traceMacros.hpp"
+#include "trace/traceRecorder.hpp"
 #include "trace/tracing.hpp"
 #include "utilities/align.hpp"
 #include "utilities/defaultStream.hpp"
@@ -110,11 +113,11 @@
 #include "utilities/events.hpp"
 #include "utilities/macros.hpp"
 #include "utilities/preserveException.hpp"
+#include "utilities/quickSort.hpp"
 #include "utilities/vmError.hpp"
 #if INCLUDE_ALL_GCS
 #include "gc/cms/concurrentMarkSweepThread.hpp"
 #include "gc/g1/concurrentMarkThread.inline.hpp"
-#include "gc/parallel/pcTasks.hpp"
 #endif // INCLUDE_ALL_GCS
 #if INCLUDE_JVMCI
 #include "jvmci/jvmciCompiler.hpp"
@@ -242,6 +245,7 @@ Thread::Thread() {
   _threads_hazard_ptr = NULL;
   _nested_threads_hazard_ptr = NULL;
   _nested_threads_hazard_ptr_cnt = 0;
+  _rcu_counter = 0;
 
   // the handle mark links itself to last_handle_mark
   new HandleMark(this);
@@ -1526,6 +1530,8 @@ void JavaThread::initialize() {
   _suspend_equivalent = false;
   _in_deopt_handler = 0;
   _doing_unsafe_access = false;
+  // Start threads at different points so that they do not sample in lockstep
+  _profile_sample_counter = os::random();
   _stack_guard_state = stack_guard_unused;
 #if INCLUDE_JVMCI
   _pending_monitorenter = false;
@@ -2777,15 +2783,18 @@ void JavaThread::make_zombies() {
 #endif // PRODUCT
 
 
-void JavaThread::deoptimized_wrt_marked_nmethods() {
-  if (!has_last_Java_frame()) return;
+int JavaThread::deoptimized_wrt_marked_nmethods() {
+  if (!has_last_Java_frame()) return 0;
+  int count = 0;
   // BiasedLocking needs an updated RegisterMap for the revoke monitors pass
   StackFrameStream fst(this, UseBiasedLocking);
   for (; !fst.is_done(); fst.next()) {
     if (fst.current()->should_be_deoptimized()) {
       Deoptimization::deoptimize(this, *fst.current(), fst.register_map());
+      count++;
     }
   }
+  return count;
 }
 
 
@@ -3401,6 +3410,8 @@ int         Threads::_number_of_threads = 0;
 int         Threads::_number_of_non_daemon_threads = 0;
 int         Threads::_return_code = 0;
 int         Threads::_thread_claim_parity = 0;
+JavaThread** Threads::_parallel_claim_order = NULL;
+uint        Threads::_parallel_claim_order_length = 0;
 size_t      JavaThread::_stack_size_at_create = 0;
 
 #ifdef ASSERT
@@ -3457,9 +3468,18 @@ void Threads::threads_do(ThreadClosure* tc) {
 
 void Threads::possibly_parallel_threads_do(bool is_par, ThreadClosure* tc) {
   int cp = Threads::thread_claim_parity();
-  ALL_JAVA_THREADS(p) {
-    if (p->claim_oops_do(is_par, cp)) {
-      tc->do_thread(p);
+  if (is_par && _parallel_claim_order != NULL) {
+    for (uint i = 0; i < _parallel_claim_order_length; i++) {
+      JavaThread* p = _parallel_claim_order[i];
+      if (p->claim_oops_do(is_par, cp)) {
+        tc->do_thread(p);
+      }
+    }
+  } else {
+    ALL_JAVA_THREADS(p) {
+      if (p->claim_oops_do(is_par, cp)) {
+        tc->do_thread(p);
+      }
     }
   }
   VMThread* vmt = VMThread::vm_thread();
@@ -3732,6 +3752,9 @@ jint Threads::create_vm(JavaVMInitArgs* args, bool* canTryAgain) {
   if (TRACE_INITIALIZE() != JNI_OK) {
     vm_exit_during_initialization("Failed to initialize tracing backend");
   }
+#if INCLUDE_TRACE
+  TraceRecorder::initialize();
+#endif
 
   // Should be done after the heap is fully created
   main_thread->cache_global_variables();
@@ -3801,6 +3824,7 @@ jint Threads::create_vm(JavaVMInitArgs* args, bool* canTryAgain) {
   set_init_completed();
 
   LogConfiguration::post_initialize();
+  AsyncLogWriter::initialize();
   Metaspace::post_initialize();
 
   HOTSPOT_VM_INIT_END();
@@ -3905,6 +3929,7 @@ jint Threads::create_vm(JavaVMInitArgs* args, bool* canTryAgain) {
   if (MemProfiling)                   MemProfiler::engage();
   StatSampler::engage();
   if (CheckJNICalls)                  JniPeriodicChecker::engage();
+  ResourceLimitMonitor::engage();
 
   BiasedLocking::init();
 
@@ -3936,6 +3961,13 @@ jint Threads::create_vm(JavaVMInitArgs* args, bool* canTryAgain) {
   }
 
   create_vm_timer.end();
+  {
+    LogTarget(Info, startuptime) lt;
+    if (lt.is_enabled()) {
+      LogStream ls(lt);
+      ClassLoader::print_counters(&ls);
+    }
+  }
 #ifdef ASSERT
   _vm_complete = true;
 #endif
@@ -4417,6 +4449,60 @@ void Threads::change_thread_claim_parity() {
          "Not in range.");
 }
 
+struct ThreadStackDepth {
+  JavaThread* _thread;
+  size_t      _depth;
+};
+
+static int compare_stack_depth(ThreadStackDepth a, ThreadStackDepth b) {
+  // Deepest first
+  if (a._depth > b._depth) return -1;
+  if (a._depth < b._depth) return 1;
+  return 0;
+}
+
+void Threads::sort_parallel_claim_order() {
+  assert(SafepointSynchronize::is_at_safepoint(), "thread list must be stable");
+  if (!ClaimDeepestStacksFirst || _parallel_claim_order != NULL) {
+    return;
+  }
+  ThreadsList* list = ThreadsSMRSupport::get_java_thread_list();
+  uint length = list->length();
+  if (length < 2) {
+    return;
+  }
+  ThreadStackDepth* depths = NEW_C_HEAP_ARRAY_RETURN_NULL(ThreadStackDepth, length, mtThread);
+  if (depths == NULL) {
+    return;
+  }
+  for (uint i = 0; i < length; i++) {
+    JavaThread* p = list->thread_at(i);
+    depths[i]._thread = p;
+    // The distance from the stack base to the last Java frame is a cheap
+    // estimate of the amount of work scanning the stack takes.
+    depths[i]._depth = p->has_last_Java_frame() ?
+      pointer_delta(p->stack_base(), (address)p->last_Java_sp(), 1) : 0;
+  }
+  QuickSort::sort(depths, length, compare_stack_depth, false);
+
+  _parallel_claim_order = NEW_C_HEAP_ARRAY_RETURN_NULL(JavaThread*, length, mtThread);
+  if (_parallel_claim_order != NULL) {
+    for (uint i = 0; i < length; i++) {
+      _parallel_claim_order[i] = depths[i]._thread;
+    }
+    _parallel_claim_order_length = length;
+  }
+  FREE_C_HEAP_ARRAY(ThreadStackDepth, depths);
+}
+
+void Threads::clear_parallel_claim_order() {
+  if (_parallel_claim_order != NULL) {
+    FREE_C_HEAP_ARRAY(JavaThread*, _parallel_claim_order);
+    _parallel_claim_order = NULL;
+    _parallel_claim_order_length = 0;
+  }
+}
+
 #ifdef ASSERT
 void Threads::assert_all_threads_claimed() {
   ALL_JAVA_THREADS(p) {
@@ -4447,24 +4533,6 @@ void Threads::possibly_parallel_oops_do(bool is_par, OopClosure* f, CodeBlobClos
   possibly_parallel_threads_do(is_par, &tc);
 }
 
-#if INCLUDE_ALL_GCS
-// Used by ParallelScavenge
-void Threads::create_thread_roots_tasks(GCTaskQueue* q) {
-  ALL_JAVA_THREADS(p) {
-    q->enqueue(new ThreadRootsTask(p));
-  }
-  q->enqueue(new ThreadRootsTask(VMThread::vm_thread()));
-}
-
-// Used by Parallel Old
-void Threads::create_thread_roots_marking_tasks(GCTaskQueue* q) {
-  ALL_JAVA_THREADS(p) {
-    q->enqueue(new ThreadRootsMarkingTask(p));
-  }
-  q->enqueue(new ThreadRootsMarkingTask(VMThread::vm_thread()));
-}
-#endif // INCLUDE_ALL_GCS
-
 void Threads::nmethods_do(CodeBlobClosure* cf) {
   ALL_JAVA_THREADS(p) {
     // This is used by the code cache sweeper to mark nmethods that are active
@@ -4497,10 +4565,12 @@ void Threads::metadata_handles_do(void f(Metadata*)) {
   threads_do(&handles_closure);
 }
 
-void Threads::deoptimized_wrt_marked_nmethods() {
+int Threads::deoptimized_wrt_marked_nmethods() {
+  int count = 0;
   ALL_JAVA_THREADS(p) {
-    p->deoptimized_wrt_marked_nmethods();
+    count += p->deoptimized_wrt_marked_nmethods();
   }
+  return count;
 }
 
 
@@ -4705,6 +4775,7 @@ void Threads::print_threads_compiling(outputStream* st, char* buf, int buflen) {
 // mechanism.
 //
 // Testing has shown that contention on the ListLock guarding gFreeList
+// (now a lock-free stack, see synchronizer.cpp)
 // is common.  If we implement ListLock as a simple SpinLock it's common
 // for the JVM to devolve to yielding with little progress.  This is true
 // despite the fact that the critical sections protected by ListLock are
@@ -40,6 +40,7 @@
 #include "runtime/park.hpp"
 #include "runtime/safepoint.hpp"
 #include "runtime/stubRoutines.hpp"
+#include "runtime/threadHeapSampler.hpp"
 #include "runtime/threadLocalStorage.hpp"
 #include "runtime/unhandledOops.hpp"
 #include "trace/traceBackend.hpp"
@@ -78,7 +79,6 @@ class vframeArray;
 class DeoptResourceMark;
 class jvmtiDeferredLocalVariableSet;
 
-class GCTaskQueue;
 class ThreadClosure;
 class IdealGraphPrinter;
 
@@ -97,7 +97,6 @@ class WorkerThread;
 //     - ConcurrentGCThread
 //     - WorkerThread
 //       - GangWorker
-//       - GCTaskThread
 //   - JavaThread
 //     - various subclasses eg CompilerThread, ServiceThread
 //   - WatcherThread
@@ -163,6 +162,13 @@ class Thread: public ThreadShadow {
     return _nested_threads_hazard_ptr_cnt;
   }
 
+ private:
+  // Read-side critical section state for GlobalCounter (utilities/globalCounter.hpp).
+  volatile uintx _rcu_counter;
+
+ public:
+  volatile uintx* get_rcu_counter() { return &_rcu_counter; }
+
  public:
   void* operator new(size_t size) throw() { return allocate(size, true); }
   void* operator new(size_t size, const std::nothrow_t& nothrow_constant) throw() {
@@ -322,6 +328,7 @@ class Thread: public ThreadShadow {
   ThreadLocalAllocBuffer _tlab;                 // Thread-local eden
   jlong _allocated_bytes;                       // Cumulative number of bytes allocated on
                                                 // the Java heap
+  ThreadHeapSampler _heap_sampler;              // For use when sampling the memory.
 
   mutable TRACE_DATA _trace_data;               // Thread-local data for tracing
 
@@ -496,6 +503,9 @@ class Thread: public ThreadShadow {
     }
   }
 
+  // Heap allocation sampling support
+  ThreadHeapSampler& heap_sampler()     { return _heap_sampler; }
+
   jlong allocated_bytes()               { return _allocated_bytes; }
   void set_allocated_bytes(jlong value) { _allocated_bytes = value; }
   void incr_allocated_bytes(jlong size) { _allocated_bytes += size; }
@@ -949,6 +959,7 @@ class JavaThread: public Thread {
   volatile bool         _doing_unsafe_access;    // Thread may fault due to unsafe access
   bool                  _do_not_unlock_if_synchronized;  // Do not unlock the receiver of a synchronized method (since it was
                                                          // never locked) when throwing an exception. Used by interpreter only.
+  jint                  _profile_sample_counter; // Events seen by C1 profiled code, see C1ProfileCounterSampleLog
 
   // JNI attach states:
   enum JNIAttachStates {
@@ -1648,6 +1659,7 @@ class JavaThread: public Thread {
   static ByteSize thread_state_offset()          { return byte_offset_of(JavaThread, _thread_state); }
   static ByteSize saved_exception_pc_offset()    { return byte_offset_of(JavaThread, _saved_exception_pc); }
   static ByteSize osthread_offset()              { return byte_offset_of(JavaThread, _osthread); }
+  static ByteSize profile_sample_counter_offset() { return byte_offset_of(JavaThread, _profile_sample_counter); }
 #if INCLUDE_JVMCI
   static ByteSize pending_deoptimization_offset() { return byte_offset_of(JavaThread, _pending_deoptimization); }
   static ByteSize pending_monitorenter_offset()  { return byte_offset_of(JavaThread, _pending_monitorenter); }
@@ -1804,7 +1816,7 @@ class JavaThread: public Thread {
   void deoptimize();
   void make_zombies();
 
-  void deoptimized_wrt_marked_nmethods();
+  int deoptimized_wrt_marked_nmethods();       // returns the number of frames deoptimized
 
  public:
   // Returns the running thread as a JavaThread
@@ -2101,6 +2113,8 @@ class Threads: AllStatic {
   static int         _number_of_non_daemon_threads;
   static int         _return_code;
   static int         _thread_claim_parity;
+  static JavaThread** _parallel_claim_order;
+  static uint         _parallel_claim_order_length;
 #ifdef ASSERT
   static bool        _vm_complete;
 #endif
@@ -2147,15 +2161,17 @@ class Threads: AllStatic {
   static void change_thread_claim_parity();
   static void assert_all_threads_claimed() NOT_DEBUG_RETURN;
 
+  // At a safepoint, let possibly_parallel_threads_do() claim the threads
+  // with the deepest stacks first, so that no worker is left scanning a
+  // deep stack alone after the others are done.
+  static void sort_parallel_claim_order();
+  static void clear_parallel_claim_order();
+
   // Apply "f->do_oop" to all root oops in all threads.
   // This version may only be called by sequential code.
   static void oops_do(OopClosure* f, CodeBlobClosure* cf);
   // This version may be called by sequential or parallel code.
   static void possibly_parallel_oops_do(bool is_par, OopClosure* f, CodeBlobClosure* cf);
-  // This creates a list of GCTasks, one per thread.
-  static void create_thread_roots_tasks(GCTaskQueue* q);
-  // This creates a list of GCTasks, one per thread, for marking objects.
-  static void create_thread_roots_marking_tasks(GCTaskQueue* q);
 
   // Apply "f->do_oop" to roots in all threads that
   // are part of compiled frames
@@ -2201,7 +2217,7 @@ class Threads: AllStatic {
   static int number_of_non_daemon_threads()      { return _number_of_non_daemon_threads; }
 
   // Deoptimizes all frames tied to marked nmethods
-  static void deoptimized_wrt_marked_nmethods();
+  static int deoptimized_wrt_marked_nmethods();
 };
 
 
@@ -0,0 +1,96 @@
+/*
+ * Copyright (c) 2018, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#include "precompiled.hpp"
+#include "runtime/threadHeapSampler.hpp"
+#include "utilities/globalDefinitions.hpp"
+
+// Default sampling interval of 512 KB.
+int           ThreadHeapSampler::_sampling_interval = 512 * K;
+volatile bool ThreadHeapSampler::_enabled           = false;
+
+ThreadHeapSampler::ThreadHeapSampler() :
+  _bytes_until_sample(0),
+  _rnd((uint32_t)(uintptr_t)this),
+  _check_pending(false),
+  _update_tlab(false),
+  _pending_bytes(0) {
+  if (_rnd == 0) {
+    _rnd = 1;
+  }
+  pick_next_sample();
+}
+
+// The linear congruential generator of drand48.
+uint64_t ThreadHeapSampler::next_random(uint64_t rnd) {
+  const uint64_t PrngMult = 0x5DEECE66DLL;
+  const uint64_t PrngAdd = 0xB;
+  const uint64_t PrngModPower = 48;
+  const uint64_t PrngModMask = right_n_bits(PrngModPower);
+  return (PrngMult * rnd + PrngAdd) & PrngModMask;
+}
+
+void ThreadHeapSampler::pick_next_sample(size_t overflowed_bytes) {
+  if (_sampling_interval == 0) {
+    _bytes_until_sample = 0;
+    return;
+  }
+
+  // Draw the distance to the next sample point from an exponential
+  // distribution with mean _sampling_interval: -ln(u) * interval for u
+  // uniform in (0, 1], taken from the top 26 bits of the generator. This
+  // only runs once per sample, so the cost of log() does not matter.
+  _rnd = next_random(_rnd);
+  const uint64_t PrngModPower = 48;
+  const int RandomBits = 26;
+  double u = ((double)(_rnd >> (PrngModPower - RandomBits)) + 1.0) / (double)(1 << RandomBits);
+  double distance = -log(u) * _sampling_interval + 1;
+  assert(distance > 0 && distance < (double)SIZE_MAX, "distance out of range");
+  _bytes_until_sample = (size_t)distance;
+
+  // Carry over the bytes by which the last allocation overshot the
+  // previous sample point.
+  if (overflowed_bytes > 0 && _bytes_until_sample > overflowed_bytes) {
+    _bytes_until_sample -= overflowed_bytes;
+  }
+}
+
+bool ThreadHeapSampler::check_for_sampling(size_t allocation_size) {
+  assert(_check_pending, "no allocation to account for");
+  _check_pending = false;
+
+  size_t total_allocated_bytes = _pending_bytes + allocation_size;
+  if (total_allocated_bytes < _bytes_until_sample) {
+    _bytes_until_sample -= total_allocated_bytes;
+    return false;
+  }
+
+  pick_next_sample(total_allocated_bytes - _bytes_until_sample);
+  return true;
+}
+
+void ThreadHeapSampler::set_sampling_interval(int sampling_interval) {
+  assert(sampling_interval >= 0, "must be");
+  _sampling_interval = sampling_interval;
+}
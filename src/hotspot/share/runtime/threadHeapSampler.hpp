@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) 2018, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#ifndef SHARE_VM_RUNTIME_THREADHEAPSAMPLER_HPP
+#define SHARE_VM_RUNTIME_THREADHEAPSAMPLER_HPP
+
+#include "memory/allocation.hpp"
+
+// Per-thread state for heap allocation sampling.
+//
+// Each thread counts down the number of bytes it has left to allocate
+// until its next sample point. The distance between sample points is
+// drawn from an exponential distribution with the sampling interval as
+// its mean, so that the samples are not biased by periodic allocation
+// patterns.
+//
+// The TLAB fast paths never check the sampler: the TLAB end is lowered to
+// the next sample point instead (see ThreadLocalAllocBuffer::set_sample_end),
+// so the allocation crossing it takes the slow path, where the count is
+// settled. When sampling is disabled the TLAB end is never lowered and the
+// fast paths are unchanged.
+class ThreadHeapSampler {
+ private:
+  size_t   _bytes_until_sample;
+  uint64_t _rnd;                  // State of the cheap random number generator
+
+  // Set on the allocation slow paths, settled once the object is initialized.
+  bool     _check_pending;
+  bool     _update_tlab;          // The tlab sample end must be recomputed
+  size_t   _pending_bytes;        // Bytes allocated since the last sample point
+
+  static int           _sampling_interval;
+  static volatile bool _enabled;
+
+  static uint64_t next_random(uint64_t rnd);
+  void pick_next_sample(size_t overflowed_bytes = 0);
+
+ public:
+  ThreadHeapSampler();
+
+  size_t bytes_until_sample() const           { return _bytes_until_sample; }
+
+  // Record that an allocation took a slow path and should be accounted
+  // for once the object is set up; bytes_since_sample_point is the amount
+  // allocated in the tlab since its sample end was last set.
+  void set_check_pending(size_t bytes_since_sample_point, bool update_tlab) {
+    _check_pending = true;
+    _update_tlab = update_tlab;
+    _pending_bytes = bytes_since_sample_point;
+  }
+  bool check_pending() const                  { return _check_pending; }
+  bool update_tlab() const                    { return _update_tlab; }
+
+  // Account for the pending bytes and an allocation of allocation_size
+  // bytes. Returns true if that allocation should be sampled.
+  bool check_for_sampling(size_t allocation_size);
+
+  static void set_sampling_interval(int sampling_interval);
+  static int sampling_interval()              { return _sampling_interval; }
+
+  static bool enabled()                       { return _enabled; }
+  static void set_enabled(bool enabled)       { _enabled = enabled; }
+};
+
+#endif // SHARE_VM_RUNTIME_THREADHEAPSAMPLER_HPP
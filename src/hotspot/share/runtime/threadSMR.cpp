@@ -120,6 +120,15 @@ uint                  ThreadsSMRSupport::_to_delete_list_cnt = 0;
 // Impl note: See _to_delete_list_cnt note.
 uint                  ThreadsSMRSupport::_to_delete_list_max = 0;
 
+// # of ThreadsLists added to the to-delete list since the hazard ptrs
+// were last scanned.
+uint                  ThreadsSMRSupport::_to_delete_list_unscanned = 0;
+
+// Scanning the hazard ptrs visits every thread, which makes each thread
+// start and exit O(threads) while holding the Threads_lock. Let this many
+// ThreadsLists accumulate and free them with a single scan.
+static const uint to_delete_list_scan_batch = 8;
+
 
 // 'inline' functions first so the definitions are before first use:
 
@@ -696,6 +705,12 @@ void ThreadsSMRSupport::free_list(ThreadsList* threads) {
     }
   }
 
+  if (++_to_delete_list_unscanned < to_delete_list_scan_batch) {
+    log_debug(thread, smr)("tid=" UINTX_FORMAT ": ThreadsSMRSupport::free_list: threads=" INTPTR_FORMAT " is not freed yet.", os::current_thread_id(), p2i(threads));
+    return;
+  }
+  _to_delete_list_unscanned = 0;
+
   // Hash table size should be first power of two higher than twice the length of the ThreadsList
   int hash_table_size = MIN2((int)get_java_thread_list()->length(), 32) << 1;
   hash_table_size--;
@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) 2018, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#include "precompiled.hpp"
+#include "runtime/thread.hpp"
+#include "runtime/vmOperationStats.hpp"
+#include "utilities/globalDefinitions.hpp"
+#include "utilities/ostream.hpp"
+
+VMOperationStats::Entry VMOperationStats::_table[VM_Operation::VMOp_Terminating];
+volatile int            VMOperationStats::_lock = 0;
+
+int VMOperationStats::bucket_for(jlong ns) {
+  jlong limit = 10 * NANOSECS_PER_MILLISEC / MILLIUNITS;  // 10us
+  int bucket = 0;
+  while (bucket < histogram_buckets - 1 && ns >= limit) {
+    limit *= 10;
+    bucket++;
+  }
+  return bucket;
+}
+
+void VMOperationStats::record(VM_Operation::VMOp_Type type, jlong wait_ns, jlong run_ns, jlong cpu_ns) {
+  assert(type >= 0 && type < VM_Operation::VMOp_Terminating, "invalid VM operation type");
+  wait_ns = MAX2(wait_ns, (jlong)0);
+  Thread::SpinAcquire(&_lock, "VMOperationStats");
+  Entry* e = &_table[type];
+  e->_count++;
+  e->_total_ns += run_ns;
+  e->_max_ns = MAX2(e->_max_ns, run_ns);
+  if (cpu_ns > 0) {
+    e->_cpu_ns += cpu_ns;
+  }
+  e->_wait_ns += wait_ns;
+  e->_max_wait_ns = MAX2(e->_max_wait_ns, wait_ns);
+  e->_run_histogram[bucket_for(run_ns)]++;
+  e->_wait_histogram[bucket_for(wait_ns)]++;
+  Thread::SpinRelease(&_lock);
+}
+
+void VMOperationStats::print_histogram(outputStream* st, const char* title, const Entry* entries, bool wait) {
+  st->print_cr("%s:", title);
+  st->print_cr("%10s %10s %10s %10s %10s %10s %10s  %s",
+               "<10us", "<100us", "<1ms", "<10ms", "<100ms", "<1s", ">=1s", "operation");
+  for (int type = 0; type < VM_Operation::VMOp_Terminating; type++) {
+    const Entry* e = &entries[type];
+    if (e->_count == 0) {
+      continue;
+    }
+    const jlong* histogram = wait ? e->_wait_histogram : e->_run_histogram;
+    for (int i = 0; i < histogram_buckets; i++) {
+      st->print(INT64_FORMAT_W(10) " ", (int64_t)histogram[i]);
+    }
+    st->print_cr(" %s", VM_Operation::name(type));
+  }
+}
+
+void VMOperationStats::print_on(outputStream* st) {
+  // Copy the table so that no output is done while holding the spin lock
+  Entry* entries = NEW_C_HEAP_ARRAY(Entry, VM_Operation::VMOp_Terminating, mtInternal);
+  Thread::SpinAcquire(&_lock, "VMOperationStats");
+  memcpy(entries, _table, sizeof(_table));
+  Thread::SpinRelease(&_lock);
+
+  const double ns_per_ms = (double)NANOSECS_PER_MILLISEC;
+  st->print_cr("VM operations evaluated by the VMThread (times in ms, cpu is VMThread CPU time):");
+  st->print_cr("%10s %12s %10s %12s %12s %10s  %s",
+               "count", "total", "max", "cpu", "wait", "max-wait", "operation");
+  for (int type = 0; type < VM_Operation::VMOp_Terminating; type++) {
+    const Entry* e = &entries[type];
+    if (e->_count == 0) {
+      continue;
+    }
+    st->print_cr(INT64_FORMAT_W(10) " %12.3f %10.3f %12.3f %12.3f %10.3f  %s",
+                 (int64_t)e->_count, e->_total_ns / ns_per_ms, e->_max_ns / ns_per_ms,
+                 e->_cpu_ns / ns_per_ms, e->_wait_ns / ns_per_ms, e->_max_wait_ns / ns_per_ms,
+                 VM_Operation::name(type));
+  }
+  st->cr();
+  print_histogram(st, "Run time histogram", entries, false);
+  st->cr();
+  print_histogram(st, "Queue wait time histogram", entries, true);
+
+  FREE_C_HEAP_ARRAY(Entry, entries);
+}
+
+void VMOperationStats::reset() {
+  Thread::SpinAcquire(&_lock, "VMOperationStats");
+  memset(_table, 0, sizeof(_table));
+  Thread::SpinRelease(&_lock);
+}
@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) 2018, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#ifndef SHARE_VM_RUNTIME_VMOPERATIONSTATS_HPP
+#define SHARE_VM_RUNTIME_VMOPERATIONSTATS_HPP
+
+#include "memory/allocation.hpp"
+#include "runtime/vm_operations.hpp"
+
+class outputStream;
+
+// Per VM operation type accounting of the operations evaluated by the
+// VMThread: how long they waited in the queue, how long they ran, and how
+// much CPU time the VMThread spent on them, with coarse histograms of the
+// wait and run times. Printed by the VM.vmoperation_stats diagnostic command.
+//
+// Only the VMThread records, but the table is read and reset by other
+// threads, so it is guarded by a spin lock.
+class VMOperationStats : AllStatic {
+ private:
+  // Histogram buckets: <10us, <100us, <1ms, <10ms, <100ms, <1s, >=1s
+  enum { histogram_buckets = 7 };
+
+  struct Entry {
+    jlong _count;
+    jlong _total_ns;
+    jlong _max_ns;
+    jlong _cpu_ns;
+    jlong _wait_ns;
+    jlong _max_wait_ns;
+    jlong _run_histogram[histogram_buckets];
+    jlong _wait_histogram[histogram_buckets];
+  };
+
+  static Entry        _table[VM_Operation::VMOp_Terminating];
+  static volatile int _lock;
+
+  static int bucket_for(jlong ns);
+  static void print_histogram(outputStream* st, const char* title, const Entry* entries, bool wait);
+
+ public:
+  // Record one evaluation of an operation of the given type. A negative
+  // cpu_ns means the VMThread CPU time is not available.
+  static void record(VM_Operation::VMOp_Type type, jlong wait_ns, jlong run_ns, jlong cpu_ns);
+
+  static void print_on(outputStream* st);
+  static void reset();
+};
+
+#endif // SHARE_VM_RUNTIME_VMOPERATIONSTATS_HPP
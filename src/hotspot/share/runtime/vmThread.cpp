@@ -36,6 +36,7 @@
 #include "runtime/os.hpp"
 #include "runtime/safepoint.hpp"
 #include "runtime/thread.inline.hpp"
+#include "runtime/vmOperationStats.hpp"
 #include "runtime/vmThread.hpp"
 #include "runtime/vm_operations.hpp"
 #include "services/runtimeService.hpp"
@@ -342,6 +343,11 @@ void VMThread::wait_for_vm_thread_exit() {
 void VMThread::evaluate_operation(VM_Operation* op) {
   ResourceMark rm;
 
+  const VM_Operation::VMOp_Type type = op->type();
+  const jlong start_ns = os::javaTimeNanos();
+  const jlong start_cpu_ns = os::current_thread_cpu_time();
+  const jlong wait_ns = start_ns - op->enqueue_time_ns();
+
   {
     PerfTraceTime vm_op_timer(perf_accumulated_vm_operation_time());
     HOTSPOT_VMOPS_BEGIN(
@@ -371,6 +377,10 @@ void VMThread::evaluate_operation(VM_Operation* op) {
                      op->evaluation_mode());
   }
 
+  const jlong end_cpu_ns = os::current_thread_cpu_time();
+  VMOperationStats::record(type, wait_ns, os::javaTimeNanos() - start_ns,
+                           (start_cpu_ns >= 0 && end_cpu_ns >= 0) ? end_cpu_ns - start_cpu_ns : -1);
+
   // Last access of info in _cur_vm_operation!
   bool c_heap_allocated = op->is_cheap_allocated();
 
@@ -615,6 +625,7 @@ void VMThread::execute(VM_Operation* op) {
       log_debug(vmthread)("Adding VM operation: %s", op->name());
       bool ok = _vm_queue->add(op);
       op->set_timestamp(os::javaTimeMillis());
+      op->set_enqueue_time_ns(os::javaTimeNanos());
       VMOperationQueue_lock->notify();
       VMOperationQueue_lock->unlock();
       // VM_Operation got skipped
@@ -116,15 +116,7 @@ void VM_ClearICs::doit() {
 }
 
 void VM_Deoptimize::doit() {
-  // We do not want any GCs to happen while we are in the middle of this VM operation
-  ResourceMark rm;
-  DeoptimizationMarker dm;
-
-  // Deoptimize all activations depending on marked nmethods
-  Deoptimization::deoptimize_dependents();
-
-  // Make the dependent methods not entrant
-  CodeCache::make_marked_nmethods_not_entrant();
+  Deoptimization::deoptimize_all_marked();
 }
 
 void VM_MarkActiveNMethods::doit() {
@@ -195,7 +187,7 @@ void VM_ZombieAll::doit() {
 void VM_UnlinkSymbols::doit() {
   JavaThread *thread = (JavaThread *)calling_thread();
   assert(thread->is_Java_thread(), "must be a Java thread");
-  SymbolTable::unlink();
+  SymbolTable::trigger_cleanup();
 }
 
 void VM_Verify::doit() {
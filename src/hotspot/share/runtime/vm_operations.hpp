@@ -83,7 +83,6 @@
   template(GetOwnedMonitorInfo)                   \
   template(GetObjectMonitorUsage)                 \
   template(GetCurrentContendedMonitor)            \
-  template(GetStackTrace)                         \
   template(GetMultipleStackTraces)                \
   template(GetAllStackTraces)                     \
   template(GetThreadListStackTraces)              \
@@ -134,6 +133,7 @@ class VM_Operation: public CHeapObj<mtInternal> {
   Thread*         _calling_thread;
   ThreadPriority  _priority;
   long            _timestamp;
+  jlong           _enqueue_time_ns;   // os::javaTimeNanos() when queued
   VM_Operation*   _next;
   VM_Operation*   _prev;
 
@@ -141,7 +141,7 @@ class VM_Operation: public CHeapObj<mtInternal> {
   static const char* _names[];
 
  public:
-  VM_Operation()  { _calling_thread = NULL; _next = NULL; _prev = NULL; }
+  VM_Operation()  { _calling_thread = NULL; _next = NULL; _prev = NULL; _enqueue_time_ns = 0; }
   virtual ~VM_Operation() {}
 
   // VM operation support (used by VM thread)
@@ -151,6 +151,8 @@ class VM_Operation: public CHeapObj<mtInternal> {
 
   long timestamp() const              { return _timestamp; }
   void set_timestamp(long timestamp)  { _timestamp = timestamp; }
+  jlong enqueue_time_ns() const       { return _enqueue_time_ns; }
+  void set_enqueue_time_ns(jlong t)   { _enqueue_time_ns = t; }
 
   // Called by VM thread - does in turn invoke doit(). Do not override this
   void evaluate();
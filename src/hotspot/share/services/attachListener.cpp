@@ -202,12 +202,36 @@ static jint jcmd(AttachOperation* op, outputStream* out) {
   return JNI_OK;
 }
 
+// Parses the comma separated "dumpheap" options "gz=<level>" and
+// "parallel=<threads>". Returns false if an option is malformed.
+static bool parse_dump_options(const char* options, int* level, uint* threads, outputStream* out) {
+  const char* p = options;
+  while (*p != '\0') {
+    int value;
+    if (strncmp(p, "gz=", 3) == 0 && sscanf(p + 3, "%d", &value) == 1 && value >= 1 && value <= 9) {
+      *level = value;
+    } else if (strncmp(p, "parallel=", 9) == 0 && sscanf(p + 9, "%d", &value) == 1 && value >= 1) {
+      *threads = (uint)value;
+    } else {
+      out->print_cr("Invalid option to dumpheap operation: %s", p);
+      return false;
+    }
+    p = strchr(p, ',');
+    if (p == NULL) {
+      break;
+    }
+    p++;
+  }
+  return true;
+}
+
 // Implementation of "dumpheap" command.
 // See also: HeapDumpDCmd class
 //
 // Input arguments :-
 //   arg0: Name of the dump file
 //   arg1: "-live" or "-all"
+//   arg2: optional "gz=<level>,parallel=<threads>"
 jint dump_heap(AttachOperation* op, outputStream* out) {
   const char* path = op->arg(0);
   if (path == NULL || path[0] == '\0') {
@@ -223,11 +247,20 @@ jint dump_heap(AttachOperation* op, outputStream* out) {
       live_objects_only = strcmp(arg1, "-live") == 0;
     }
 
+    int level = 0;
+    uint threads = 1;
+    const char* arg2 = op->arg(2);
+    if (arg2 != NULL && (strlen(arg2) > 0)) {
+      if (!parse_dump_options(arg2, &level, &threads, out)) {
+        return JNI_ERR;
+      }
+    }
+
     // Request a full GC before heap dump if live_objects_only = true
     // This helps reduces the amount of unreachable objects in the dump
     // and makes it easier to browse.
     HeapDumper dumper(live_objects_only /* request GC */);
-    int res = dumper.dump(op->arg(0));
+    int res = dumper.dump(op->arg(0), level, threads);
     if (res == 0) {
       out->print_cr("Heap dump file created");
     } else {
@@ -249,6 +282,7 @@ jint dump_heap(AttachOperation* op, outputStream* out) {
 //
 // Input arguments :-
 //   arg0: "-live" or "-all"
+//   arg1: optional "parallel=<threads>"
 static jint heap_inspection(AttachOperation* op, outputStream* out) {
   bool live_objects_only = true;   // default is true to retain the behavior before this change is made
   const char* arg0 = op->arg(0);
@@ -259,7 +293,17 @@ static jint heap_inspection(AttachOperation* op, outputStream* out) {
     }
     live_objects_only = strcmp(arg0, "-live") == 0;
   }
-  VM_GC_HeapInspection heapop(out, live_objects_only /* request full gc */);
+  uint threads = 1;
+  const char* arg1 = op->arg(1);
+  if (arg1 != NULL && (strlen(arg1) > 0)) {
+    int value;
+    if (strncmp(arg1, "parallel=", 9) != 0 || sscanf(arg1 + 9, "%d", &value) != 1 || value < 1) {
+      out->print_cr("Invalid argument to inspectheap operation: %s", arg1);
+      return JNI_ERR;
+    }
+    threads = (uint)value;
+  }
+  VM_GC_HeapInspection heapop(out, live_objects_only /* request full gc */, threads);
   VMThread::execute(&heapop);
   return JNI_OK;
 }
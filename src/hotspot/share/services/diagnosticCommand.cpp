@@ -28,13 +28,19 @@
 #include "classfile/compactHashtable.hpp"
 #include "compiler/compileBroker.hpp"
 #include "compiler/directivesParser.hpp"
+#include "gc/shared/threadLocalAllocBuffer.hpp"
 #include "gc/shared/vmGCOperations.hpp"
 #include "memory/resourceArea.hpp"
 #include "oops/oop.inline.hpp"
 #include "oops/typeArrayOop.inline.hpp"
 #include "runtime/globals.hpp"
 #include "runtime/javaCalls.hpp"
+#include "runtime/lockContention.hpp"
 #include "runtime/os.hpp"
+#include "runtime/safepoint.hpp"
+#include "runtime/thread.inline.hpp"
+#include "runtime/threadSMR.hpp"
+#include "runtime/vmOperationStats.hpp"
 #include "services/diagnosticArgument.hpp"
 #include "services/diagnosticCommand.hpp"
 #include "services/diagnosticFramework.hpp"
@@ -80,6 +86,10 @@ void DCmdRegistrant::register_dcmds(){
   DCmdFactory::register_DCmdFactory(new DCmdFactoryImpl<SystemGCDCmd>(full_export, true, false));
   DCmdFactory::register_DCmdFactory(new DCmdFactoryImpl<RunFinalizationDCmd>(full_export, true, false));
   DCmdFactory::register_DCmdFactory(new DCmdFactoryImpl<HeapInfoDCmd>(full_export, true, false));
+  DCmdFactory::register_DCmdFactory(new DCmdFactoryImpl<TLABStatsDCmd>(full_export, true, false));
+  DCmdFactory::register_DCmdFactory(new DCmdFactoryImpl<ThreadStatsDCmd>(full_export, true, false));
+  DCmdFactory::register_DCmdFactory(new DCmdFactoryImpl<LockContentionDCmd>(full_export, true, false));
+  DCmdFactory::register_DCmdFactory(new DCmdFactoryImpl<VMOperationStatsDCmd>(full_export, true, false));
   DCmdFactory::register_DCmdFactory(new DCmdFactoryImpl<FinalizerInfoDCmd>(full_export, true, false));
 #if INCLUDE_SERVICES
   DCmdFactory::register_DCmdFactory(new DCmdFactoryImpl<HeapDumpDCmd>(DCmd_Source_Internal | DCmd_Source_AttachAPI, true, false));
@@ -102,7 +112,9 @@ void DCmdRegistrant::register_dcmds(){
   DCmdFactory::register_DCmdFactory(new DCmdFactoryImpl<CompileQueueDCmd>(full_export, true, false));
   DCmdFactory::register_DCmdFactory(new DCmdFactoryImpl<CodeListDCmd>(full_export, true, false));
   DCmdFactory::register_DCmdFactory(new DCmdFactoryImpl<CodeCacheDCmd>(full_export, true, false));
+  DCmdFactory::register_DCmdFactory(new DCmdFactoryImpl<CodeCacheFragmentationDCmd>(full_export, true, false));
   DCmdFactory::register_DCmdFactory(new DCmdFactoryImpl<TouchedMethodsDCmd>(full_export, true, false));
+  DCmdFactory::register_DCmdFactory(new DCmdFactoryImpl<SafepointStatisticsDCmd>(full_export, true, false));
 
   DCmdFactory::register_DCmdFactory(new DCmdFactoryImpl<CompilerDirectivesPrintDCmd>(full_export, true, false));
   DCmdFactory::register_DCmdFactory(new DCmdFactoryImpl<CompilerDirectivesAddDCmd>(full_export, true, false));
@@ -433,6 +445,95 @@ void HeapInfoDCmd::execute(DCmdSource source, TRAPS) {
   Universe::heap()->print_on(output());
 }
 
+void TLABStatsDCmd::execute(DCmdSource source, TRAPS) {
+  ThreadLocalAllocBuffer::print_statistics_on(output());
+}
+
+void ThreadStatsDCmd::execute(DCmdSource source, TRAPS) {
+  ResourceMark rm(THREAD);
+  outputStream* out = output();
+  const bool cpu_supported = os::is_thread_cpu_time_supported();
+
+  out->print_cr("%8s %-14s %12s %12s %16s  %s",
+                "tid", "state", "cpu-ms", "user-ms", "allocated", "name");
+  // One pass over a stable threads list; -1 marks unsupported CPU times
+  for (JavaThreadIteratorWithHandle jtiwh; JavaThread* jt = jtiwh.next(); ) {
+    oop tobj = jt->threadObj();
+    if (tobj == NULL || jt->is_exiting()) {
+      continue;
+    }
+    jlong cpu_ms = -1;
+    jlong user_ms = -1;
+    if (cpu_supported) {
+      jlong cpu_ns = os::thread_cpu_time(jt, true);
+      jlong user_ns = os::thread_cpu_time(jt, false);
+      cpu_ms = cpu_ns < 0 ? -1 : cpu_ns / NANOSECS_PER_MILLISEC;
+      user_ms = user_ns < 0 ? -1 : user_ns / NANOSECS_PER_MILLISEC;
+    }
+    out->print_cr(INT64_FORMAT_W(8) " %-14s " INT64_FORMAT_W(12) " " INT64_FORMAT_W(12) " " INT64_FORMAT_W(16) "  %s",
+                  (int64_t)java_lang_Thread::thread_id(tobj),
+                  java_lang_Thread::thread_status_name(tobj),
+                  (int64_t)cpu_ms, (int64_t)user_ms,
+                  (int64_t)jt->cooked_allocated_bytes(),
+                  jt->get_thread_name());
+  }
+}
+
+LockContentionDCmd::LockContentionDCmd(outputStream* output, bool heap) :
+                                       DCmdWithParser(output, heap),
+  _reset("-reset", "Clear the recorded contention after printing it",
+         "BOOLEAN", false, "false") {
+  _dcmdparser.add_dcmd_option(&_reset);
+}
+
+void LockContentionDCmd::execute(DCmdSource source, TRAPS) {
+  if (!LockContentionProfiler::is_enabled()) {
+    output()->print_cr("Lock contention recording is disabled, "
+                       "set -XX:LockContentionThreshold to enable it");
+    return;
+  }
+  LockContentionProfiler::print_on(output());
+  if (_reset.value()) {
+    LockContentionProfiler::reset();
+  }
+}
+
+int LockContentionDCmd::num_arguments() {
+  ResourceMark rm;
+  LockContentionDCmd* dcmd = new LockContentionDCmd(NULL, false);
+  if (dcmd != NULL) {
+    DCmdMark mark(dcmd);
+    return dcmd->_dcmdparser.num_arguments();
+  } else {
+    return 0;
+  }
+}
+
+VMOperationStatsDCmd::VMOperationStatsDCmd(outputStream* output, bool heap) :
+                                           DCmdWithParser(output, heap),
+  _reset("-reset", "Clear the statistics after printing them",
+         "BOOLEAN", false, "false") {
+  _dcmdparser.add_dcmd_option(&_reset);
+}
+
+void VMOperationStatsDCmd::execute(DCmdSource source, TRAPS) {
+  VMOperationStats::print_on(output());
+  if (_reset.value()) {
+    VMOperationStats::reset();
+  }
+}
+
+int VMOperationStatsDCmd::num_arguments() {
+  ResourceMark rm;
+  VMOperationStatsDCmd* dcmd = new VMOperationStatsDCmd(NULL, false);
+  if (dcmd != NULL) {
+    DCmdMark mark(dcmd);
+    return dcmd->_dcmdparser.num_arguments();
+  } else {
+    return 0;
+  }
+}
+
 void FinalizerInfoDCmd::execute(DCmdSource source, TRAPS) {
   ResourceMark rm;
 
@@ -485,17 +586,36 @@ HeapDumpDCmd::HeapDumpDCmd(outputStream* output, bool heap) :
                            DCmdWithParser(output, heap),
   _filename("filename","Name of the dump file", "STRING",true),
   _all("-all", "Dump all objects, including unreachable objects",
-       "BOOLEAN", false, "false") {
+       "BOOLEAN", false, "false"),
+  _gzip("-gz", "If specified, the heap dump is written in gzipped format "
+               "using the given compression level. 1 (recommended) is the fastest, "
+               "9 the strongest compression.", "INT", false, "0"),
+  _parallel("-parallel", "Number of threads used to walk the heap. The heap "
+            "is walked serially if the collector does not support parallel "
+            "iteration.", "INT", false, "1") {
   _dcmdparser.add_dcmd_option(&_all);
+  _dcmdparser.add_dcmd_option(&_gzip);
+  _dcmdparser.add_dcmd_option(&_parallel);
   _dcmdparser.add_dcmd_argument(&_filename);
 }
 
 void HeapDumpDCmd::execute(DCmdSource source, TRAPS) {
+  jlong level = _gzip.value();
+  if (level < 0 || level > 9) {
+    output()->print_cr("Compression level out of range (1-9): " JLONG_FORMAT, level);
+    return;
+  }
+  jlong parallel = _parallel.value();
+  if (parallel < 1) {
+    output()->print_cr("Invalid number of threads: " JLONG_FORMAT, parallel);
+    return;
+  }
+
   // Request a full GC before heap dump if _all is false
   // This helps reduces the amount of unreachable objects in the dump
   // and makes it easier to browse.
   HeapDumper dumper(!_all.value() /* request GC if _all is false*/);
-  int res = dumper.dump(_filename.value());
+  int res = dumper.dump(_filename.value(), (int)level, (uint)MIN2(parallel, (jlong)max_juint));
   if (res == 0) {
     output()->print_cr("Heap dump file created");
   } else {
@@ -524,13 +644,23 @@ int HeapDumpDCmd::num_arguments() {
 ClassHistogramDCmd::ClassHistogramDCmd(outputStream* output, bool heap) :
                                        DCmdWithParser(output, heap),
   _all("-all", "Inspect all objects, including unreachable objects",
-       "BOOLEAN", false, "false") {
+       "BOOLEAN", false, "false"),
+  _parallel("-parallel", "Number of threads used to walk the heap. The heap "
+            "is walked serially if the collector does not support parallel "
+            "iteration.", "INT", false, "1") {
   _dcmdparser.add_dcmd_option(&_all);
+  _dcmdparser.add_dcmd_option(&_parallel);
 }
 
 void ClassHistogramDCmd::execute(DCmdSource source, TRAPS) {
+  jlong parallel = _parallel.value();
+  if (parallel < 1) {
+    output()->print_cr("Invalid number of threads: " JLONG_FORMAT, parallel);
+    return;
+  }
   VM_GC_HeapInspection heapop(output(),
-                              !_all.value() /* request full gc if false */);
+                              !_all.value() /* request full gc if false */,
+                              (uint)MIN2(parallel, (jlong)max_juint));
   VMThread::execute(&heapop);
 }
 
@@ -919,6 +1049,14 @@ void CodeCacheDCmd::execute(DCmdSource source, TRAPS) {
   CodeCache::print_layout(output());
 }
 
+void CodeCacheFragmentationDCmd::execute(DCmdSource source, TRAPS) {
+  CodeCache::print_fragmentation(output());
+}
+
+void SafepointStatisticsDCmd::execute(DCmdSource source, TRAPS) {
+  SafepointSyncProfiler::print_on(output());
+}
+
 void CompilerDirectivesPrintDCmd::execute(DCmdSource source, TRAPS) {
   DirectivesStack::print(output());
 }
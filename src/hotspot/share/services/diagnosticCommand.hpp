@@ -305,6 +305,92 @@ public:
   virtual void execute(DCmdSource source, TRAPS);
 };
 
+class TLABStatsDCmd : public DCmd {
+public:
+  TLABStatsDCmd(outputStream* output, bool heap) : DCmd(output, heap) { }
+  static const char* name() { return "GC.tlab_stats"; }
+  static const char* description() {
+    return "Provide per-thread TLAB sizes and refills, and their distribution.";
+  }
+  static const char* impact() {
+    return "Low: Depends on number of threads";
+  }
+  static int num_arguments() { return 0; }
+  static const JavaPermission permission() {
+    JavaPermission p = {"java.lang.management.ManagementPermission",
+      "monitor", NULL};
+      return p;
+  }
+
+  virtual void execute(DCmdSource source, TRAPS);
+};
+
+class ThreadStatsDCmd : public DCmd {
+public:
+  ThreadStatsDCmd(outputStream* output, bool heap) : DCmd(output, heap) { }
+  static const char* name() { return "Thread.stats"; }
+  static const char* description() {
+    return "Print CPU time, allocated bytes and state of all Java threads.";
+  }
+  static const char* impact() {
+    return "Low: Depends on number of threads";
+  }
+  static int num_arguments() { return 0; }
+  static const JavaPermission permission() {
+    JavaPermission p = {"java.lang.management.ManagementPermission",
+      "monitor", NULL};
+      return p;
+  }
+
+  virtual void execute(DCmdSource source, TRAPS);
+};
+
+class LockContentionDCmd : public DCmdWithParser {
+protected:
+  DCmdArgument<bool> _reset;
+public:
+  LockContentionDCmd(outputStream* output, bool heap);
+  static const char* name() { return "VM.lock_contention"; }
+  static const char* description() {
+    return "Print the Java monitors and VM mutexes threads blocked on for at "
+           "least LockContentionThreshold microseconds.";
+  }
+  static const char* impact() {
+    return "Low";
+  }
+  static int num_arguments();
+  static const JavaPermission permission() {
+    JavaPermission p = {"java.lang.management.ManagementPermission",
+      "monitor", NULL};
+      return p;
+  }
+
+  virtual void execute(DCmdSource source, TRAPS);
+};
+
+class VMOperationStatsDCmd : public DCmdWithParser {
+protected:
+  DCmdArgument<bool> _reset;
+public:
+  VMOperationStatsDCmd(outputStream* output, bool heap);
+  static const char* name() { return "VM.vmoperation_stats"; }
+  static const char* description() {
+    return "Print per VM operation counts, run, CPU and queue wait times, "
+           "and run and wait time histograms.";
+  }
+  static const char* impact() {
+    return "Low";
+  }
+  static int num_arguments();
+  static const JavaPermission permission() {
+    JavaPermission p = {"java.lang.management.ManagementPermission",
+      "monitor", NULL};
+      return p;
+  }
+
+  virtual void execute(DCmdSource source, TRAPS);
+};
+
 class FinalizerInfoDCmd : public DCmd {
 public:
   FinalizerInfoDCmd(outputStream* output, bool heap) : DCmd(output, heap) { }
@@ -331,6 +417,8 @@ class HeapDumpDCmd : public DCmdWithParser {
 protected:
   DCmdArgument<char*> _filename;
   DCmdArgument<bool>  _all;
+  DCmdArgument<jlong> _gzip;
+  DCmdArgument<jlong> _parallel;
 public:
   HeapDumpDCmd(outputStream* output, bool heap);
   static const char* name() {
@@ -357,6 +445,7 @@ public:
 class ClassHistogramDCmd : public DCmdWithParser {
 protected:
   DCmdArgument<bool> _all;
+  DCmdArgument<jlong> _parallel;
 public:
   ClassHistogramDCmd(outputStream* output, bool heap);
   static const char* name() {
@@ -641,6 +730,27 @@ public:
   virtual void execute(DCmdSource source, TRAPS);
 };
 
+class CodeCacheFragmentationDCmd : public DCmd {
+public:
+  CodeCacheFragmentationDCmd(outputStream* output, bool heap) : DCmd(output, heap) {}
+  static const char* name() {
+    return "Compiler.codecache_fragmentation";
+  }
+  static const char* description() {
+    return "Print free block histogram, largest free block and largest blobs of each code heap.";
+  }
+  static const char* impact() {
+    return "Medium: Depends on code cache size.";
+  }
+  static const JavaPermission permission() {
+    JavaPermission p = {"java.lang.management.ManagementPermission",
+                        "monitor", NULL};
+    return p;
+  }
+  static int num_arguments() { return 0; }
+  virtual void execute(DCmdSource source, TRAPS);
+};
+
 class CompilerDirectivesPrintDCmd : public DCmd {
 public:
   CompilerDirectivesPrintDCmd(outputStream* output, bool heap) : DCmd(output, heap) {}
@@ -793,6 +903,28 @@ public:
   virtual void execute(DCmdSource source, TRAPS);
 };
 
+class SafepointStatisticsDCmd : public DCmd {
+public:
+  SafepointStatisticsDCmd(outputStream* output, bool heap) : DCmd(output, heap) { }
+  static const char* name() {
+    return "Safepoint.statistics";
+  }
+  static const char* description() {
+    return "Print safepoint synchronization times and the threads that took "
+           "the longest to reach recent safepoints.";
+  }
+  static const char* impact() {
+    return "Low";
+  }
+  static const JavaPermission permission() {
+    JavaPermission p = {"java.lang.management.ManagementPermission",
+                        "monitor", NULL};
+    return p;
+  }
+  static int num_arguments() { return 0; }
+  virtual void execute(DCmdSource source, TRAPS);
+};
+
 class StringtableDCmd : public DCmdWithParser {
 protected:
   DCmdArgument<bool> _verbose;
@@ -30,6 +30,8 @@
 #include "gc/shared/gcLocker.inline.hpp"
 #include "gc/shared/genCollectedHeap.hpp"
 #include "gc/shared/vmGCOperations.hpp"
+#include "gc/shared/workgroup.hpp"
+#include "logging/log.hpp"
 #include "memory/allocation.inline.hpp"
 #include "memory/resourceArea.hpp"
 #include "memory/universe.hpp"
@@ -47,6 +49,7 @@
 #include "runtime/vmThread.hpp"
 #include "runtime/vm_operations.hpp"
 #include "services/heapDumper.hpp"
+#include "services/heapDumperCompression.hpp"
 #include "services/threadService.hpp"
 #include "utilities/macros.hpp"
 #include "utilities/ostream.hpp"
@@ -375,64 +378,47 @@ enum {
   INITIAL_CLASS_COUNT = 200
 };
 
-// Supports I/O operations on a dump file
+// Supports I/O operations for a dump. The writer collects complete
+// top-level records in its buffer and hands the buffer to the shared
+// DumpOutput, so several writers can produce parts of the same dump.
+// Sub-records of a heap dump are collected into HPROF_HEAP_DUMP_SEGMENT
+// records which are closed before the buffer is handed over; their length
+// is patched into the buffer instead of seeking back in the file.
 
 class DumpWriter : public StackObj {
  private:
   enum {
-    io_buffer_size  = 8*M
+    io_buffer_size  = 1*M,
+    dump_segment_header_size = 9
   };
 
-  int _fd;              // file descriptor (-1 if dump file not open)
-  julong _bytes_written; // number of byte written to dump file
+  DumpOutput* _output;  // the (possibly compressed) dump file
 
   char* _buffer;    // internal buffer
   size_t _size;
   size_t _pos;
 
-  jlong _dump_start;
+  char* _out_buffer;  // scratch buffer used for compression
+  size_t _out_size;
 
-  char* _error;   // error message when I/O fails
-
-  void set_file_descriptor(int fd)              { _fd = fd; }
-  int file_descriptor() const                   { return _fd; }
+  bool _in_dump_segment;     // are we currently in a dump segment?
+  bool _is_huge_sub_record;  // are we writing a sub-record larger than the buffer?
+  DEBUG_ONLY(size_t _sub_record_left;)  // bytes not yet written for the current sub-record
+  DEBUG_ONLY(bool _sub_record_ended;)   // true if end_sub_record() has been called
 
   char* buffer() const                          { return _buffer; }
   size_t buffer_size() const                    { return _size; }
   size_t position() const                       { return _pos; }
   void set_position(size_t pos)                 { _pos = pos; }
 
-  void set_error(const char* error)             { _error = (char*)os::strdup(error); }
-
-  // all I/O go through this function
-  void write_internal(void* s, size_t len);
-
  public:
-  DumpWriter(const char* path);
+  DumpWriter(DumpOutput* output);
   ~DumpWriter();
 
-  void close();
-  bool is_open() const                  { return file_descriptor() >= 0; }
-  void flush();
-
-  jlong dump_start() const                      { return _dump_start; }
-  void set_dump_start(jlong pos);
-  julong current_record_length();
-
-  // total number of bytes written to the disk
-  julong bytes_written() const          { return _bytes_written; }
+  bool is_open() const                  { return buffer() != NULL && _output->is_open(); }
 
-  // adjust the number of bytes written to disk (used to keep the count
-  // of the number of bytes written in case of rewrites)
-  void adjust_bytes_written(jlong n)    { _bytes_written += n; }
-
-  // number of (buffered) bytes as yet unwritten to the dump file
-  size_t bytes_unwritten() const        { return position(); }
-
-  char* error() const                   { return _error; }
-
-  jlong current_offset();
-  void seek_to_offset(jlong pos);
+  // hands the buffered bytes to the output
+  void flush();
 
   // writer functions
   void write_raw(void* s, size_t len);
@@ -444,139 +430,88 @@ class DumpWriter : public StackObj {
   void write_symbolID(Symbol* o);
   void write_classID(Klass* k);
   void write_id(u4 x);
+
+  // Starts a new sub-record inside a dump segment. len is the exact length
+  // of the sub-record including the tag.
+  void start_sub_record(u1 tag, u4 len);
+  // Ends the current sub-record.
+  void end_sub_record();
+  // Finishes the current dump segment if not already finished.
+  void finish_dump_segment();
 };
 
-DumpWriter::DumpWriter(const char* path) {
+DumpWriter::DumpWriter(DumpOutput* output) :
+  _output(output), _out_buffer(NULL), _out_size(0),
+  _in_dump_segment(false), _is_huge_sub_record(false) {
+  DEBUG_ONLY(_sub_record_left = 0;)
+  DEBUG_ONLY(_sub_record_ended = false;)
+
   // try to allocate an I/O buffer of io_buffer_size. If there isn't
   // sufficient memory then reduce size until we can allocate something.
+  // A segment header and a few small sub-records must fit in any case.
   _size = io_buffer_size;
   do {
     _buffer = (char*)os::malloc(_size, mtInternal);
     if (_buffer == NULL) {
       _size = _size >> 1;
     }
-  } while (_buffer == NULL && _size > 0);
-  assert((_size > 0 && _buffer != NULL) || (_size == 0 && _buffer == NULL), "sanity check");
+  } while (_buffer == NULL && _size >= 4*K);
   _pos = 0;
-  _error = NULL;
-  _bytes_written = 0L;
-  _dump_start = (jlong)-1;
-  _fd = os::create_binary_file(path, false);    // don't replace existing file
-
-  // if the open failed we record the error
-  if (_fd < 0) {
-    _error = (char*)os::strdup(os::strerror(errno));
-  }
-}
-
-DumpWriter::~DumpWriter() {
-  // flush and close dump file
-  if (is_open()) {
-    close();
-  }
-  if (_buffer != NULL) os::free(_buffer);
-  if (_error != NULL) os::free(_error);
-}
-
-// closes dump file (if open)
-void DumpWriter::close() {
-  // flush and close dump file
-  if (is_open()) {
-    flush();
-    os::close(file_descriptor());
-    set_file_descriptor(-1);
-  }
-}
 
-// sets the dump starting position
-void DumpWriter::set_dump_start(jlong pos) {
-  _dump_start = pos;
-}
-
-julong DumpWriter::current_record_length() {
-  if (is_open()) {
-    // calculate the size of the dump record
-    julong dump_end = bytes_written() + bytes_unwritten();
-    assert(dump_end == (size_t)current_offset(), "checking");
-    julong dump_len = dump_end - dump_start() - 4;
-    return dump_len;
+  if (_buffer == NULL) {
+    _output->set_error("Could not allocate buffer memory for heap dump");
+    return;
   }
-  return 0;
-}
 
-// write directly to the file
-void DumpWriter::write_internal(void* s, size_t len) {
-  if (is_open()) {
-    const char* pos = (char*)s;
-    ssize_t n = 0;
-    while (len > 0) {
-      uint tmp = (uint)MIN2(len, (size_t)UINT_MAX);
-      n = os::write(file_descriptor(), pos, tmp);
-
-      if (n < 0) {
-        // EINTR cannot happen here, os::write will take care of that
-        set_error(os::strerror(errno));
-        os::close(file_descriptor());
-        set_file_descriptor(-1);
-        return;
+  if (_output->is_compressed()) {
+    _out_size = _output->init_compression(_size);
+    if (_out_size > 0) {
+      _out_buffer = (char*)os::malloc(_out_size, mtInternal);
+      if (_out_buffer == NULL) {
+        _output->set_error("Could not allocate buffer memory for heap dump compression");
+        _output->close();
       }
-
-      _bytes_written += n;
-      pos += n;
-      len -= n;
     }
   }
 }
 
+DumpWriter::~DumpWriter() {
+  finish_dump_segment();
+  flush();
+  if (_buffer != NULL) os::free(_buffer);
+  if (_out_buffer != NULL) os::free(_out_buffer);
+}
+
 // write raw bytes
 void DumpWriter::write_raw(void* s, size_t len) {
-  if (is_open()) {
-    // flush buffer to make room
-    if ((position() + len) >= buffer_size()) {
-      flush();
-    }
+  assert(!_in_dump_segment || (_sub_record_left >= len), "sub-record too large");
+  DEBUG_ONLY(_sub_record_left -= len);
 
-    // buffer not available or too big to buffer it
-    if ((buffer() == NULL) || (len >= buffer_size())) {
-      write_internal(s, len);
-    } else {
-      // Should optimize this for u1/u2/u4/u8 sizes.
-      memcpy(buffer() + position(), s, len);
-      set_position(position() + len);
-    }
+  if (!is_open()) {
+    return;
   }
-}
 
-// flush any buffered bytes to the file
-void DumpWriter::flush() {
-  if (is_open() && position() > 0) {
-    write_internal(buffer(), position());
-    set_position(0);
+  // flush buffer to make room
+  while (len > buffer_size() - position()) {
+    assert(!_in_dump_segment || _is_huge_sub_record, "cannot overflow in non-huge sub-record");
+    size_t to_write = buffer_size() - position();
+    memcpy(buffer() + position(), s, to_write);
+    s = (void*)((char*)s + to_write);
+    len -= to_write;
+    set_position(position() + to_write);
+    flush();
   }
-}
 
-jlong DumpWriter::current_offset() {
-  if (is_open()) {
-    // the offset is the file offset plus whatever we have buffered
-    jlong offset = os::current_file_offset(file_descriptor());
-    assert(offset >= 0, "lseek failed");
-    return offset + position();
-  } else {
-    return (jlong)-1;
-  }
+  memcpy(buffer() + position(), s, len);
+  set_position(position() + len);
 }
 
-void DumpWriter::seek_to_offset(jlong off) {
-  assert(off >= 0, "bad offset");
-
-  // need to flush before seeking
-  flush();
-
-  // may be closed due to I/O error
-  if (is_open()) {
-    jlong n = os::seek_to_file_offset(file_descriptor(), off);
-    assert(n >= 0, "lseek failed");
+// hand any buffered bytes to the output
+void DumpWriter::flush() {
+  if (is_open() && position() > 0) {
+    _output->write(buffer(), position(), _out_buffer, _out_size);
   }
+  set_position(0);
 }
 
 void DumpWriter::write_u2(u2 x) {
@@ -628,6 +563,68 @@ void DumpWriter::write_classID(Klass* k) {
   write_objectID(k->java_mirror());
 }
 
+void DumpWriter::start_sub_record(u1 tag, u4 len) {
+  if (!_in_dump_segment) {
+    if (position() > 0) {
+      flush();
+    }
+
+    assert(position() == 0, "must be at the start");
+
+    write_u1(HPROF_HEAP_DUMP_SEGMENT);
+    write_u4(0); // current ticks
+    // Fixed up in finish_dump_segment() if more sub-records are added. A huge
+    // sub-record is the only one in its segment, so this is its final length.
+    write_u4(len);
+
+    _in_dump_segment = true;
+    _is_huge_sub_record = len > buffer_size() - dump_segment_header_size;
+    if (_is_huge_sub_record) {
+      // the record is streamed through the buffer, keep other writers out
+      _output->begin_exclusive();
+    }
+  } else if (_is_huge_sub_record || (len > buffer_size() - position())) {
+    // This sub-record will not fit completely or the last one was huge.
+    // Finish the current segment and try again.
+    finish_dump_segment();
+    start_sub_record(tag, len);
+    return;
+  }
+
+  DEBUG_ONLY(_sub_record_left = len);
+  DEBUG_ONLY(_sub_record_ended = false);
+
+  write_u1(tag);
+}
+
+void DumpWriter::end_sub_record() {
+  assert(_in_dump_segment, "must be in dump segment");
+  assert(_sub_record_left == 0, "sub-record not written completely");
+  assert(!_sub_record_ended, "must not have ended yet");
+  DEBUG_ONLY(_sub_record_ended = true);
+}
+
+void DumpWriter::finish_dump_segment() {
+  if (_in_dump_segment) {
+    assert(_sub_record_left == 0, "last sub-record not written completely");
+    assert(_sub_record_ended, "sub-record must have ended");
+
+    // Fix up the segment length unless the last sub-record was huge, its
+    // length was already correct when the segment was started.
+    if (!_is_huge_sub_record && is_open()) {
+      assert(position() > dump_segment_header_size, "dump segment should have some content");
+      Bytes::put_Java_u4((address)(buffer() + 5), (u4)(position() - dump_segment_header_size));
+    }
+
+    flush();
+    if (_is_huge_sub_record) {
+      _output->end_exclusive();
+    }
+    _in_dump_segment = false;
+    _is_huge_sub_record = false;
+  }
+}
+
 
 
 // Support class with a collection of functions used when dumping the heap
@@ -643,6 +640,9 @@ class DumperSupport : AllStatic {
   // returns hprof tag for the given basic type
   static hprofTag type2tag(BasicType type);
 
+  // returns the size of the value of the given type signature
+  static u4 sig2size(Symbol* sig);
+
   // returns the size of the instance of the given class
   static u4 instance_size(Klass* k);
 
@@ -652,10 +652,15 @@ class DumperSupport : AllStatic {
   static void dump_double(DumpWriter* writer, jdouble d);
   // dumps the raw value of the given field
   static void dump_field_value(DumpWriter* writer, char type, oop obj, int offset);
+  // returns the size of the static fields and their descriptors, and
+  // the number of static fields of the given class
+  static u4 get_static_fields_size(InstanceKlass* ik, u2& field_count);
   // dumps static fields of the given class
   static void dump_static_fields(DumpWriter* writer, Klass* k);
   // dump the raw values of the instance fields of the given object
   static void dump_instance_fields(DumpWriter* writer, oop o);
+  // returns the number of instance fields of the given class
+  static u2 get_instance_fields_count(InstanceKlass* ik);
   // dumps the definition of the instance fields for a given class
   static void dump_instance_field_descriptors(DumpWriter* writer, Klass* k);
   // creates HPROF_GC_INSTANCE_DUMP record for the given object
@@ -675,15 +680,9 @@ class DumperSupport : AllStatic {
   static void dump_stack_frame(DumpWriter* writer, int frame_serial_num, int class_serial_num, Method* m, int bci);
 
   // check if we need to truncate an array
-  static int calculate_array_max_length(DumpWriter* writer, arrayOop array, short header_size);
-
-  // writes a HPROF_HEAP_DUMP_SEGMENT record
-  static void write_dump_header(DumpWriter* writer);
+  static int calculate_array_max_length(arrayOop array, short header_size);
 
-  // fixes up the length of the current dump record
-  static void write_current_dump_record_length(DumpWriter* writer);
-
-  // fixes up the current dump record and writes HPROF_HEAP_DUMP_END record
+  // finishes the current dump segment and writes HPROF_HEAP_DUMP_END record
   static void end_of_dump(DumpWriter* writer);
 };
 
@@ -811,6 +810,28 @@ void DumperSupport::dump_field_value(DumpWriter* writer, char type, oop obj, int
   }
 }
 
+// returns the size of the value of the given type signature
+u4 DumperSupport::sig2size(Symbol* sig) {
+  switch (sig->byte_at(0)) {
+    case JVM_SIGNATURE_CLASS   :
+    case JVM_SIGNATURE_ARRAY   : return sizeof(address);
+
+    case JVM_SIGNATURE_BYTE    :
+    case JVM_SIGNATURE_BOOLEAN : return 1;
+
+    case JVM_SIGNATURE_CHAR    :
+    case JVM_SIGNATURE_SHORT   : return 2;
+
+    case JVM_SIGNATURE_INT     :
+    case JVM_SIGNATURE_FLOAT   : return 4;
+
+    case JVM_SIGNATURE_LONG    :
+    case JVM_SIGNATURE_DOUBLE  : return 8;
+
+    default : ShouldNotReachHere(); return 0;
+  }
+}
+
 // returns the size of the instance of the given class
 u4 DumperSupport::instance_size(Klass* k) {
   HandleMark hm;
@@ -820,39 +841,23 @@ u4 DumperSupport::instance_size(Klass* k) {
 
   for (FieldStream fld(ik, false, false); !fld.eos(); fld.next()) {
     if (!fld.access_flags().is_static()) {
-      Symbol* sig = fld.signature();
-      switch (sig->byte_at(0)) {
-        case JVM_SIGNATURE_CLASS   :
-        case JVM_SIGNATURE_ARRAY   : size += oopSize; break;
-
-        case JVM_SIGNATURE_BYTE    :
-        case JVM_SIGNATURE_BOOLEAN : size += 1; break;
-
-        case JVM_SIGNATURE_CHAR    :
-        case JVM_SIGNATURE_SHORT   : size += 2; break;
-
-        case JVM_SIGNATURE_INT     :
-        case JVM_SIGNATURE_FLOAT   : size += 4; break;
-
-        case JVM_SIGNATURE_LONG    :
-        case JVM_SIGNATURE_DOUBLE  : size += 8; break;
-
-        default : ShouldNotReachHere();
-      }
+      size += sig2size(fld.signature());
     }
   }
   return size;
 }
 
-// dumps static fields of the given class
-void DumperSupport::dump_static_fields(DumpWriter* writer, Klass* k) {
-  HandleMark hm;
-  InstanceKlass* ik = InstanceKlass::cast(k);
+// returns the size of the static field entries of the given class and
+// sets field_count to their number
+u4 DumperSupport::get_static_fields_size(InstanceKlass* ik, u2& field_count) {
+  field_count = 0;
+  u4 size = 0;
 
-  // pass 1 - count the static fields
-  u2 field_count = 0;
   for (FieldStream fldc(ik, true, true); !fldc.eos(); fldc.next()) {
-    if (fldc.access_flags().is_static()) field_count++;
+    if (fldc.access_flags().is_static()) {
+      field_count++;
+      size += sig2size(fldc.signature());
+    }
   }
 
   // Add in resolved_references which is referenced by the cpCache
@@ -861,12 +866,14 @@ void DumperSupport::dump_static_fields(DumpWriter* writer, Klass* k) {
   oop resolved_references = ik->constants()->resolved_references_or_null();
   if (resolved_references != NULL) {
     field_count++;
+    size += sizeof(address);
 
     // Add in the resolved_references of the used previous versions of the class
     // in the case of RedefineClasses
     InstanceKlass* prev = ik->previous_versions();
     while (prev != NULL && prev->constants()->resolved_references_or_null() != NULL) {
       field_count++;
+      size += sizeof(address);
       prev = prev->previous_versions();
     }
   }
@@ -876,10 +883,26 @@ void DumperSupport::dump_static_fields(DumpWriter* writer, Klass* k) {
   oop init_lock = ik->init_lock();
   if (init_lock != NULL) {
     field_count++;
+    size += sizeof(address);
   }
 
+  // every entry has a name ID and a type tag in front of the value
+  return size + field_count * (sizeof(address) + 1);
+}
+
+// dumps static fields of the given class
+void DumperSupport::dump_static_fields(DumpWriter* writer, Klass* k) {
+  HandleMark hm;
+  InstanceKlass* ik = InstanceKlass::cast(k);
+
+  // pass 1 - count the static fields
+  u2 field_count = 0;
+  get_static_fields_size(ik, field_count);
   writer->write_u2(field_count);
 
+  oop resolved_references = ik->constants()->resolved_references_or_null();
+  oop init_lock = ik->init_lock();
+
   // pass 2 - dump the field descriptors and raw values
   for (FieldStream fld(ik, true, true); !fld.eos(); fld.next()) {
     if (fld.access_flags().is_static()) {
@@ -930,17 +953,25 @@ void DumperSupport::dump_instance_fields(DumpWriter* writer, oop o) {
   }
 }
 
-// dumps the definition of the instance fields for a given class
-void DumperSupport::dump_instance_field_descriptors(DumpWriter* writer, Klass* k) {
+// returns the number of instance fields of the given class
+u2 DumperSupport::get_instance_fields_count(InstanceKlass* ik) {
   HandleMark hm;
-  InstanceKlass* ik = InstanceKlass::cast(k);
-
-  // pass 1 - count the instance fields
   u2 field_count = 0;
+
   for (FieldStream fldc(ik, true, true); !fldc.eos(); fldc.next()) {
     if (!fldc.access_flags().is_static()) field_count++;
   }
 
+  return field_count;
+}
+
+// dumps the definition of the instance fields for a given class
+void DumperSupport::dump_instance_field_descriptors(DumpWriter* writer, Klass* k) {
+  HandleMark hm;
+  InstanceKlass* ik = InstanceKlass::cast(k);
+
+  // pass 1 - count the instance fields
+  u2 field_count = get_instance_fields_count(ik);
   writer->write_u2(field_count);
 
   // pass 2 - dump the field descriptors
@@ -957,8 +988,10 @@ void DumperSupport::dump_instance_field_descriptors(DumpWriter* writer, Klass* k
 // creates HPROF_GC_INSTANCE_DUMP record for the given object
 void DumperSupport::dump_instance(DumpWriter* writer, oop o) {
   Klass* k = o->klass();
+  u4 is = instance_size(k);
+  u4 size = 1 + sizeof(address) + 4 + sizeof(address) + 4 + is;
 
-  writer->write_u1(HPROF_GC_INSTANCE_DUMP);
+  writer->start_sub_record(HPROF_GC_INSTANCE_DUMP, size);
   writer->write_objectID(o);
   writer->write_u4(STACK_TRACE_ID);
 
@@ -966,10 +999,12 @@ void DumperSupport::dump_instance(DumpWriter* writer, oop o) {
   writer->write_classID(k);
 
   // number of bytes that follow
-  writer->write_u4(instance_size(k) );
+  writer->write_u4(is);
 
   // field values
   dump_instance_fields(writer, o);
+
+  writer->end_sub_record();
 }
 
 // creates HPROF_GC_CLASS_DUMP record for the given class and each of
@@ -984,7 +1019,13 @@ void DumperSupport::dump_class_and_array_classes(DumpWriter* writer, Klass* k) {
     return;
   }
 
-  writer->write_u1(HPROF_GC_CLASS_DUMP);
+  u2 static_fields_count = 0;
+  u4 static_size = get_static_fields_size(ik, static_fields_count);
+  u2 instance_fields_count = get_instance_fields_count(ik);
+  u4 instance_fields_size = instance_fields_count * (sizeof(address) + 1);
+  u4 size = 1 + sizeof(address) + 4 + 6 * sizeof(address) + 4 + 2 + 2 + static_size + 2 + instance_fields_size;
+
+  writer->start_sub_record(HPROF_GC_CLASS_DUMP, size);
 
   // class ID
   writer->write_classID(ik);
@@ -1018,13 +1059,18 @@ void DumperSupport::dump_class_and_array_classes(DumpWriter* writer, Klass* k) {
   // description of instance fields
   dump_instance_field_descriptors(writer, k);
 
+  writer->end_sub_record();
+
   // array classes
   k = k->array_klass_or_null();
   while (k != NULL) {
     Klass* klass = k;
     assert(klass->is_objArray_klass(), "not an ObjArrayKlass");
 
-    writer->write_u1(HPROF_GC_CLASS_DUMP);
+    // class ID, stack trace, super, loader, signers, protection domain,
+    // two reserved IDs, instance size and three empty u2 counts
+    u4 size = 1 + sizeof(address) + 4 + 6 * sizeof(address) + 4 + 2 * 3;
+    writer->start_sub_record(HPROF_GC_CLASS_DUMP, size);
     writer->write_classID(klass);
     writer->write_u4(STACK_TRACE_ID);
 
@@ -1044,6 +1090,8 @@ void DumperSupport::dump_class_and_array_classes(DumpWriter* writer, Klass* k) {
     writer->write_u2(0);             // static fields
     writer->write_u2(0);             // instance fields
 
+    writer->end_sub_record();
+
     // get the array class for the next rank
     k = klass->array_klass_or_null();
   }
@@ -1056,7 +1104,8 @@ void DumperSupport::dump_basic_type_array_class(DumpWriter* writer, Klass* k) {
  while (k != NULL) {
     Klass* klass = k;
 
-    writer->write_u1(HPROF_GC_CLASS_DUMP);
+    u4 size = 1 + sizeof(address) + 4 + 6 * sizeof(address) + 4 + 2 * 3;
+    writer->start_sub_record(HPROF_GC_CLASS_DUMP, size);
     writer->write_classID(klass);
     writer->write_u4(STACK_TRACE_ID);
 
@@ -1076,6 +1125,8 @@ void DumperSupport::dump_basic_type_array_class(DumpWriter* writer, Klass* k) {
     writer->write_u2(0);             // static fields
     writer->write_u2(0);             // instance fields
 
+    writer->end_sub_record();
+
     // get the array class for the next rank
     k = klass->array_klass_or_null();
   }
@@ -1083,7 +1134,7 @@ void DumperSupport::dump_basic_type_array_class(DumpWriter* writer, Klass* k) {
 
 // Hprof uses an u4 as record length field,
 // which means we need to truncate arrays that are too long.
-int DumperSupport::calculate_array_max_length(DumpWriter* writer, arrayOop array, short header_size) {
+int DumperSupport::calculate_array_max_length(arrayOop array, short header_size) {
   BasicType type = ArrayKlass::cast(array->klass())->element_type();
   assert(type >= T_BOOLEAN && type <= T_OBJECT, "invalid array element type");
 
@@ -1098,19 +1149,9 @@ int DumperSupport::calculate_array_max_length(DumpWriter* writer, arrayOop array
 
   size_t length_in_bytes = (size_t)length * type_size;
 
-  // Create a new record if the current record is non-empty and the array can't fit.
-  julong current_record_length = writer->current_record_length();
-  if (current_record_length > 0 &&
-      (current_record_length + header_size + length_in_bytes) > max_juint) {
-    write_current_dump_record_length(writer);
-    write_dump_header(writer);
-
-    // We now have an empty record.
-    current_record_length = 0;
-  }
-
-  // Calculate max bytes we can use.
-  uint max_bytes = max_juint - (header_size + current_record_length);
+  // A record too large for the writer's buffer gets a dump segment of its
+  // own, so the whole segment length is available to the array.
+  uint max_bytes = max_juint - header_size;
 
   // Array too long for the record?
   // Calculate max length and return it.
@@ -1129,9 +1170,10 @@ void DumperSupport::dump_object_array(DumpWriter* writer, objArrayOop array) {
   // sizeof(u1) + 2 * sizeof(u4) + sizeof(objectID) + sizeof(classID)
   short header_size = 1 + 2 * 4 + 2 * sizeof(address);
 
-  int length = calculate_array_max_length(writer, array, header_size);
+  int length = calculate_array_max_length(array, header_size);
+  u4 size = header_size + length * sizeof(address);
 
-  writer->write_u1(HPROF_GC_OBJ_ARRAY_DUMP);
+  writer->start_sub_record(HPROF_GC_OBJ_ARRAY_DUMP, size);
   writer->write_objectID(array);
   writer->write_u4(STACK_TRACE_ID);
   writer->write_u4(length);
@@ -1144,6 +1186,8 @@ void DumperSupport::dump_object_array(DumpWriter* writer, objArrayOop array) {
     oop o = array->obj_at(index);
     writer->write_objectID(o);
   }
+
+  writer->end_sub_record();
 }
 
 #define WRITE_ARRAY(Array, Type, Size, Length) \
@@ -1156,11 +1200,12 @@ void DumperSupport::dump_prim_array(DumpWriter* writer, typeArrayOop array) {
   // 2 * sizeof(u1) + 2 * sizeof(u4) + sizeof(objectID)
   short header_size = 2 * 1 + 2 * 4 + sizeof(address);
 
-  int length = calculate_array_max_length(writer, array, header_size);
+  int length = calculate_array_max_length(array, header_size);
   int type_size = type2aelembytes(type);
   u4 length_in_bytes = (u4)length * type_size;
+  u4 size = header_size + length_in_bytes;
 
-  writer->write_u1(HPROF_GC_PRIM_ARRAY_DUMP);
+  writer->start_sub_record(HPROF_GC_PRIM_ARRAY_DUMP, size);
   writer->write_objectID(array);
   writer->write_u4(STACK_TRACE_ID);
   writer->write_u4(length);
@@ -1168,6 +1213,7 @@ void DumperSupport::dump_prim_array(DumpWriter* writer, typeArrayOop array) {
 
   // nothing to copy
   if (length == 0) {
+    writer->end_sub_record();
     return;
   }
 
@@ -1237,6 +1283,8 @@ void DumperSupport::dump_prim_array(DumpWriter* writer, typeArrayOop array) {
     }
     default : ShouldNotReachHere();
   }
+
+  writer->end_sub_record();
 }
 
 // create a HPROF_FRAME record of the given Method* and bci
@@ -1312,10 +1360,12 @@ void JNILocalsDumper::do_oop(oop* obj_p) {
   // ignore null handles
   oop o = *obj_p;
   if (o != NULL) {
-    writer()->write_u1(HPROF_GC_ROOT_JNI_LOCAL);
+    u4 size = 1 + sizeof(address) + 4 + 4;
+    writer()->start_sub_record(HPROF_GC_ROOT_JNI_LOCAL, size);
     writer()->write_objectID(o);
     writer()->write_u4(_thread_serial_num);
     writer()->write_u4((u4)_frame_num);
+    writer()->end_sub_record();
   }
 }
 
@@ -1343,9 +1393,11 @@ void JNIGlobalsDumper::do_oop(oop* obj_p) {
 
   // we ignore global ref to symbols and other internal objects
   if (o->is_instance() || o->is_objArray() || o->is_typeArray()) {
-    writer()->write_u1(HPROF_GC_ROOT_JNI_GLOBAL);
+    u4 size = 1 + 2 * sizeof(address);
+    writer()->start_sub_record(HPROF_GC_ROOT_JNI_GLOBAL, size);
     writer()->write_objectID(o);
     writer()->write_objectID((oopDesc*)obj_p);      // global ref ID
+    writer()->end_sub_record();
   }
 };
 
@@ -1361,8 +1413,10 @@ class MonitorUsedDumper : public OopClosure {
     _writer = writer;
   }
   void do_oop(oop* obj_p) {
-    writer()->write_u1(HPROF_GC_ROOT_MONITOR_USED);
+    u4 size = 1 + sizeof(address);
+    writer()->start_sub_record(HPROF_GC_ROOT_MONITOR_USED, size);
     writer()->write_objectID(*obj_p);
+    writer()->end_sub_record();
   }
   void do_oop(narrowOop* obj_p) { ShouldNotReachHere(); }
 };
@@ -1381,8 +1435,10 @@ class StickyClassDumper : public KlassClosure {
   void do_klass(Klass* k) {
     if (k->is_instance_klass()) {
       InstanceKlass* ik = InstanceKlass::cast(k);
-        writer()->write_u1(HPROF_GC_ROOT_STICKY_CLASS);
+        u4 size = 1 + sizeof(address);
+        writer()->start_sub_record(HPROF_GC_ROOT_STICKY_CLASS, size);
         writer()->write_classID(ik);
+        writer()->end_sub_record();
       }
     }
 };
@@ -1394,18 +1450,12 @@ class VM_HeapDumper;
 
 class HeapObjectDumper : public ObjectClosure {
  private:
-  VM_HeapDumper* _dumper;
   DumpWriter* _writer;
 
-  VM_HeapDumper* dumper()               { return _dumper; }
   DumpWriter* writer()                  { return _writer; }
 
-  // used to indicate that a record has been writen
-  void mark_end_of_record();
-
  public:
-  HeapObjectDumper(VM_HeapDumper* dumper, DumpWriter* writer) {
-    _dumper = dumper;
+  HeapObjectDumper(DumpWriter* writer) {
     _writer = writer;
   }
 
@@ -1424,30 +1474,34 @@ void HeapObjectDumper::do_object(oop o) {
   if (o->is_instance()) {
     // create a HPROF_GC_INSTANCE record for each object
     DumperSupport::dump_instance(writer(), o);
-    mark_end_of_record();
   } else if (o->is_objArray()) {
     // create a HPROF_GC_OBJ_ARRAY_DUMP record for each object array
     DumperSupport::dump_object_array(writer(), objArrayOop(o));
-    mark_end_of_record();
   } else if (o->is_typeArray()) {
     // create a HPROF_GC_PRIM_ARRAY_DUMP record for each type array
     DumperSupport::dump_prim_array(writer(), typeArrayOop(o));
-    mark_end_of_record();
   }
 }
 
-// The VM operation that performs the heap dump
-class VM_HeapDumper : public VM_GC_Operation {
+// The VM operation that performs the heap dump. If the heap provides a
+// parallel object iterator the heap is dumped by the safepoint workers,
+// each of which writes its share of the objects through its own writer.
+// Worker 0 uses the VM thread's writer and also dumps the classes and
+// the GC roots.
+class VM_HeapDumper : public VM_GC_Operation, public AbstractGangTask {
  private:
   static VM_HeapDumper* _global_dumper;
   static DumpWriter*    _global_writer;
   DumpWriter*           _local_writer;
+  DumpOutput*           _output;
   JavaThread*           _oome_thread;
   Method*               _oome_constructor;
   bool _gc_before_heap_dump;
   GrowableArray<Klass*>* _klass_map;
   ThreadStackTrace** _stack_traces;
   int _num_threads;
+  uint _num_dumper_threads;
+  ParallelObjectIterator* _poi;
 
   // accessors and setters
   static VM_HeapDumper* dumper()         {  assert(_global_dumper != NULL, "Error"); return _global_dumper; }
@@ -1487,13 +1541,21 @@ class VM_HeapDumper : public VM_GC_Operation {
   // HPROF_TRACE and HPROF_FRAME records
   void dump_stack_traces();
 
+  // HPROF_GC_CLASS_DUMP and HPROF_GC_ROOT_* records
+  void dump_classes_and_roots();
+
  public:
-  VM_HeapDumper(DumpWriter* writer, bool gc_before_heap_dump, bool oome) :
+  VM_HeapDumper(DumpWriter* writer, DumpOutput* output, bool gc_before_heap_dump, bool oome,
+                uint num_dumper_threads) :
     VM_GC_Operation(0 /* total collections,      dummy, ignored */,
                     GCCause::_heap_dump /* GC Cause */,
                     0 /* total full collections, dummy, ignored */,
-                    gc_before_heap_dump) {
+                    gc_before_heap_dump),
+    AbstractGangTask("dump heap") {
     _local_writer = writer;
+    _output = output;
+    _num_dumper_threads = MAX2(num_dumper_threads, 1u);
+    _poi = NULL;
     _gc_before_heap_dump = gc_before_heap_dump;
     _klass_map = new (ResourceObj::C_HEAP, mtInternal) GrowableArray<Klass*>(INITIAL_CLASS_COUNT, true);
     _stack_traces = NULL;
@@ -1522,9 +1584,8 @@ class VM_HeapDumper : public VM_GC_Operation {
   }
 
   VMOp_Type type() const { return VMOp_HeapDumper; }
-  // used to mark sub-record boundary
-  void check_segment_length();
   void doit();
+  void work(uint worker_id);
 };
 
 VM_HeapDumper* VM_HeapDumper::_global_dumper = NULL;
@@ -1534,72 +1595,13 @@ bool VM_HeapDumper::skip_operation() const {
   return false;
 }
 
- // writes a HPROF_HEAP_DUMP_SEGMENT record
-void DumperSupport::write_dump_header(DumpWriter* writer) {
-  if (writer->is_open()) {
-    writer->write_u1(HPROF_HEAP_DUMP_SEGMENT);
-    writer->write_u4(0); // current ticks
-
-    // record the starting position for the dump (its length will be fixed up later)
-    writer->set_dump_start(writer->current_offset());
-    writer->write_u4(0);
-  }
-}
-
-// fixes up the length of the current dump record
-void DumperSupport::write_current_dump_record_length(DumpWriter* writer) {
-  if (writer->is_open()) {
-    julong dump_end = writer->bytes_written() + writer->bytes_unwritten();
-    julong dump_len = writer->current_record_length();
-
-    // record length must fit in a u4
-    if (dump_len > max_juint) {
-      warning("record is too large");
-    }
-
-    // seek to the dump start and fix-up the length
-    assert(writer->dump_start() >= 0, "no dump start recorded");
-    writer->seek_to_offset(writer->dump_start());
-    writer->write_u4((u4)dump_len);
-
-    // adjust the total size written to keep the bytes written correct.
-    writer->adjust_bytes_written(-((jlong) sizeof(u4)));
-
-    // seek to dump end so we can continue
-    writer->seek_to_offset(dump_end);
-
-    // no current dump record
-    writer->set_dump_start((jlong)-1);
-  }
-}
-
-// used on a sub-record boundary to check if we need to start a
-// new segment.
-void VM_HeapDumper::check_segment_length() {
-  if (writer()->is_open()) {
-    julong dump_len = writer()->current_record_length();
-
-    if (dump_len > 2UL*G) {
-      DumperSupport::write_current_dump_record_length(writer());
-      DumperSupport::write_dump_header(writer());
-    }
-  }
-}
-
-// fixes up the current dump record and writes HPROF_HEAP_DUMP_END record
+// finishes the current dump segment and writes HPROF_HEAP_DUMP_END record
 void DumperSupport::end_of_dump(DumpWriter* writer) {
-  if (writer->is_open()) {
-    write_current_dump_record_length(writer);
-
-    writer->write_u1(HPROF_HEAP_DUMP_END);
-    writer->write_u4(0);
-    writer->write_u4(0);
-  }
-}
+  writer->finish_dump_segment();
 
-// marks sub-record boundary
-void HeapObjectDumper::mark_end_of_record() {
-  dumper()->check_segment_length();
+  writer->write_u1(HPROF_HEAP_DUMP_END);
+  writer->write_u4(0);
+  writer->write_u4(0);
 }
 
 // writes a HPROF_LOAD_CLASS record for the class (and each of its
@@ -1689,10 +1691,12 @@ int VM_HeapDumper::do_thread(JavaThread* java_thread, u4 thread_serial_num) {
               oop o = locals->obj_at(slot)();
 
               if (o != NULL) {
-                writer()->write_u1(HPROF_GC_ROOT_JAVA_FRAME);
+                u4 size = 1 + sizeof(address) + 4 + 4;
+                writer()->start_sub_record(HPROF_GC_ROOT_JAVA_FRAME, size);
                 writer()->write_objectID(o);
                 writer()->write_u4(thread_serial_num);
                 writer()->write_u4((u4) (stack_depth + extra_frames));
+                writer()->end_sub_record();
               }
             }
           }
@@ -1701,10 +1705,12 @@ int VM_HeapDumper::do_thread(JavaThread* java_thread, u4 thread_serial_num) {
             if (exprs->at(index)->type() == T_OBJECT) {
                oop o = exprs->obj_at(index)();
                if (o != NULL) {
-                 writer()->write_u1(HPROF_GC_ROOT_JAVA_FRAME);
+                 u4 size = 1 + sizeof(address) + 4 + 4;
+                 writer()->start_sub_record(HPROF_GC_ROOT_JAVA_FRAME, size);
                  writer()->write_objectID(o);
                  writer()->write_u4(thread_serial_num);
                  writer()->write_u4((u4) (stack_depth + extra_frames));
+                 writer()->end_sub_record();
                }
              }
           }
@@ -1752,10 +1758,12 @@ void VM_HeapDumper::do_threads() {
     oop threadObj = thread->threadObj();
     u4 thread_serial_num = i+1;
     u4 stack_serial_num = thread_serial_num + STACK_TRACE_ID;
-    writer()->write_u1(HPROF_GC_ROOT_THREAD_OBJ);
+    u4 size = 1 + sizeof(address) + 4 + 4;
+    writer()->start_sub_record(HPROF_GC_ROOT_THREAD_OBJ, size);
     writer()->write_objectID(threadObj);
     writer()->write_u4(thread_serial_num);  // thread number
     writer()->write_u4(stack_serial_num);   // stack trace serial number
+    writer()->end_sub_record();
     int num_frames = do_thread(thread, thread_serial_num);
     assert(num_frames == _stack_traces[i]->get_stack_depth(),
            "total number of Java frames not matched");
@@ -1780,12 +1788,15 @@ void VM_HeapDumper::do_threads() {
 // unknown object alloc site.
 //
 // Each HPROF_HEAP_DUMP_SEGMENT record has a length followed by sub-records.
-// To allow the heap dump be generated in a single pass we remember the position
-// of the dump length and fix it up after all sub-records have been written.
+// The sub-records are collected in the writer's buffer and the segment length
+// is patched in before the buffer is written out, so every buffer written is
+// a sequence of complete records. This lets several writers produce segments
+// concurrently. A sub-record which does not fit into the buffer is given a
+// segment of its own whose length is known up front.
 // To generate the sub-records we iterate over the heap, writing
 // HPROF_GC_INSTANCE_DUMP, HPROF_GC_OBJ_ARRAY_DUMP, and HPROF_GC_PRIM_ARRAY_DUMP
-// records as we go. Once that is done we write records for some of the GC
-// roots.
+// records as we go, in parallel if the heap supports it. Worker 0 also writes
+// the HPROF_GC_CLASS_DUMP records and the records for some of the GC roots.
 
 void VM_HeapDumper::doit() {
 
@@ -1809,7 +1820,6 @@ void VM_HeapDumper::doit() {
   set_global_writer();
 
   // Write the file header - we always use 1.0.2
-  size_t used = ch->used();
   const char* header = "JAVA PROFILE 1.0.2";
 
   // header is few bytes long - no chance to overflow int
@@ -1830,51 +1840,80 @@ void VM_HeapDumper::doit() {
   // this must be called after _klass_map is built when iterating the classes above.
   dump_stack_traces();
 
-  // write HPROF_HEAP_DUMP_SEGMENT
-  DumperSupport::write_dump_header(writer());
+  // The records above must precede the heap dump segments of all writers.
+  writer()->flush();
+
+  WorkGang* gang = ch->get_safepoint_workers();
+  uint num_workers = (gang == NULL) ? 1 : MIN2(_num_dumper_threads, gang->active_workers());
+  if (num_workers > 1) {
+    _poi = ch->parallel_object_iterator(num_workers);
+  }
+
+  if (_poi != NULL) {
+    log_debug(gc, heap)("Dumping heap with %u threads", num_workers);
+    gang->run_task(this, num_workers);
+    delete _poi;
+    _poi = NULL;
+  } else {
+    work(0);
+  }
+
+  // finishes the last segment and writes the HPROF_HEAP_DUMP_END record.
+  DumperSupport::end_of_dump(writer());
+  writer()->flush();
+
+  // Now we clear the global variables, so that a future dumper might run.
+  clear_global_dumper();
+  clear_global_writer();
+}
+
+void VM_HeapDumper::work(uint worker_id) {
+  if (worker_id == 0) {
+    // the VM thread is blocked in run_task, so its writer can be used here
+    dump_classes_and_roots();
+
+    // writes HPROF_GC_INSTANCE_DUMP records.
+    // The HPROF_GC_CLASS_DUMP and HPROF_GC_INSTANCE_DUMP are the vast bulk
+    // of the heap dump.
+    HeapObjectDumper obj_dumper(writer());
+    if (_poi != NULL) {
+      _poi->object_iterate(&obj_dumper, worker_id);
+    } else {
+      Universe::heap()->safe_object_iterate(&obj_dumper);
+    }
+    writer()->finish_dump_segment();
+  } else {
+    // other workers write into their own buffer which is handed to the
+    // output when it fills up and when the writer goes out of scope
+    DumpWriter local_writer(_output);
+    HeapObjectDumper obj_dumper(&local_writer);
+    _poi->object_iterate(&obj_dumper, worker_id);
+  }
+}
 
+void VM_HeapDumper::dump_classes_and_roots() {
   // Writes HPROF_GC_CLASS_DUMP records
   ClassLoaderDataGraph::classes_do(&do_class_dump);
   Universe::basic_type_classes_do(&do_basic_type_array_class_dump);
-  check_segment_length();
-
-  // writes HPROF_GC_INSTANCE_DUMP records.
-  // After each sub-record is written check_segment_length will be invoked
-  // to check if the current segment exceeds a threshold. If so, a new
-  // segment is started.
-  // The HPROF_GC_CLASS_DUMP and HPROF_GC_INSTANCE_DUMP are the vast bulk
-  // of the heap dump.
-  HeapObjectDumper obj_dumper(this, writer());
-  Universe::heap()->safe_object_iterate(&obj_dumper);
 
   // HPROF_GC_ROOT_THREAD_OBJ + frames + jni locals
   do_threads();
-  check_segment_length();
 
   // HPROF_GC_ROOT_MONITOR_USED
   MonitorUsedDumper mon_dumper(writer());
   ObjectSynchronizer::oops_do(&mon_dumper);
-  check_segment_length();
 
   // HPROF_GC_ROOT_JNI_GLOBAL
   JNIGlobalsDumper jni_dumper(writer());
   JNIHandles::oops_do(&jni_dumper);
   Universe::oops_do(&jni_dumper);  // technically not jni roots, but global roots
                                    // for things like preallocated throwable backtraces
-  check_segment_length();
 
   // HPROF_GC_ROOT_STICKY_CLASS
   // These should be classes in the NULL class loader data, and not all classes
   // if !ClassUnloading
   StickyClassDumper class_dumper(writer());
   ClassLoaderData::the_null_class_loader_data()->classes_do(&class_dumper);
-
-  // fixes up the length of the dump record and writes the HPROF_HEAP_DUMP_END record.
-  DumperSupport::end_of_dump(writer());
-
-  // Now we clear the global variables, so that a future dumper might run.
-  clear_global_dumper();
-  clear_global_writer();
 }
 
 void VM_HeapDumper::dump_stack_traces() {
@@ -1932,8 +1971,9 @@ void VM_HeapDumper::dump_stack_traces() {
 }
 
 // dump the heap to given path.
-int HeapDumper::dump(const char* path) {
+int HeapDumper::dump(const char* path, int compression, uint num_threads) {
   assert(path != NULL && strlen(path) > 0, "path missing");
+  assert(compression >= 0 && compression <= 9, "invalid compression level %d", compression);
 
   // print message in interactive case
   if (print_to_tty()) {
@@ -1941,42 +1981,47 @@ int HeapDumper::dump(const char* path) {
     timer()->start();
   }
 
-  // create the dump writer. If the file can be opened then bail
-  DumpWriter writer(path);
-  if (!writer.is_open()) {
-    set_error(writer.error());
-    if (print_to_tty()) {
-      tty->print_cr("Unable to create %s: %s", path,
-        (error() != NULL) ? error() : "reason unknown");
+  // create the dump output. If the file can't be opened or the compression
+  // can't be set up then bail
+  AbstractCompressor* compressor = (compression > 0) ? new GZipCompressor(compression) : NULL;
+  DumpOutput output(path, compressor);
+  {
+    DumpWriter writer(&output);
+    if (writer.is_open()) {
+      // generate the dump
+      VM_HeapDumper dumper(&writer, &output, _gc_before_heap_dump, _oome, num_threads);
+      if (Thread::current()->is_VM_thread()) {
+        assert(SafepointSynchronize::is_at_safepoint(), "Expected to be called at a safepoint");
+        dumper.doit();
+      } else {
+        VMThread::execute(&dumper);
+      }
+    } else {
+      set_error(output.error());
+      if (print_to_tty()) {
+        tty->print_cr("Unable to create %s: %s", path,
+          (error() != NULL) ? error() : "reason unknown");
+      }
+      return -1;
     }
-    return -1;
-  }
-
-  // generate the dump
-  VM_HeapDumper dumper(&writer, _gc_before_heap_dump, _oome);
-  if (Thread::current()->is_VM_thread()) {
-    assert(SafepointSynchronize::is_at_safepoint(), "Expected to be called at a safepoint");
-    dumper.doit();
-  } else {
-    VMThread::execute(&dumper);
   }
 
-  // close dump file and record any error that the writer may have encountered
-  writer.close();
-  set_error(writer.error());
+  // close dump file and record any error that the writers may have encountered
+  output.close();
+  set_error(output.error());
 
   // print message in interactive case
   if (print_to_tty()) {
     timer()->stop();
     if (error() == NULL) {
       tty->print_cr("Heap dump file created [" JULONG_FORMAT " bytes in %3.3f secs]",
-                    writer.bytes_written(), timer()->seconds());
+                    output.bytes_written(), timer()->seconds());
     } else {
-      tty->print_cr("Dump file is incomplete: %s", writer.error());
+      tty->print_cr("Dump file is incomplete: %s", output.error());
     }
   }
 
-  return (writer.error() == NULL) ? 0 : -1;
+  return (output.error() == NULL) ? 0 : -1;
 }
 
 // stop timer (if still active), and free any error string we might be holding
@@ -2102,6 +2147,6 @@ void HeapDumper::dump_heap(bool oome) {
   HeapDumper dumper(false /* no GC before heap dump */,
                     true  /* send to tty */,
                     oome  /* pass along out-of-memory-error flag */);
-  dumper.dump(my_path);
+  dumper.dump(my_path, 0 /* no compression */, os::initial_active_processor_count());
   os::free(my_path);
 }
@@ -71,7 +71,10 @@ class HeapDumper : public StackObj {
   ~HeapDumper();
 
   // dumps the heap to the specified file, returns 0 if success.
-  int dump(const char* path);
+  // compression > 0 writes a gzip file using the given level (1-9).
+  // num_threads is the maximum number of safepoint workers used to walk
+  // the heap; the heap is walked serially if it has no parallel iterator.
+  int dump(const char* path, int compression = 0, uint num_threads = 1);
 
   // returns error message (resource allocated), or NULL if no error
   char* error_as_C_string() const;
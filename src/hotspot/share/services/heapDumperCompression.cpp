@@ -0,0 +1,174 @@
+/*
+ * Copyright (c) 2018, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#include "precompiled.hpp"
+#include "jvm.h"
+#include "runtime/arguments.hpp"
+#include "runtime/mutex.hpp"
+#include "runtime/mutexLocker.hpp"
+#include "runtime/os.hpp"
+#include "services/heapDumperCompression.hpp"
+
+// Entry points of the gzip support in libzip.
+typedef jlong (JNICALL *GZipBound_t)(jlong inLen);
+typedef jlong (JNICALL *GZipFully_t)(void* inBuf, jlong inLen, void* outBuf, jlong outLen,
+                                     jint level, char** pmsg);
+
+static GZipBound_t GZipBound = NULL;
+static GZipFully_t GZipFully = NULL;
+
+// Looks up the gzip entry points. libzip has already been loaded by the
+// ClassLoader at this point, so this only resolves the symbols.
+static bool load_gzip_functions() {
+  if (GZipFully == NULL) {
+    char path[JVM_MAXPATHLEN];
+    char ebuf[1024];
+    void* handle = NULL;
+    if (os::dll_locate_lib(path, sizeof(path), Arguments::get_dll_dir(), "zip")) {
+      handle = os::dll_load(path, ebuf, sizeof ebuf);
+    }
+    if (handle != NULL) {
+      GZipBound = CAST_TO_FN_PTR(GZipBound_t, os::dll_lookup(handle, "ZIP_GZip_Bound"));
+      GZipFully = CAST_TO_FN_PTR(GZipFully_t, os::dll_lookup(handle, "ZIP_GZip_Fully"));
+    }
+  }
+  return GZipBound != NULL && GZipFully != NULL;
+}
+
+const char* GZipCompressor::init(size_t block_size, size_t* needed_out_size) {
+  if (!load_gzip_functions()) {
+    return "Cannot get the gzip functions from the zip library";
+  }
+  *needed_out_size = (size_t)GZipBound((jlong)block_size);
+  return NULL;
+}
+
+const char* GZipCompressor::compress(char* in, size_t in_size, char* out, size_t out_size,
+                                     size_t* compressed_size) {
+  char* msg = NULL;
+  jlong result = GZipFully(in, (jlong)in_size, out, (jlong)out_size, _level, &msg);
+
+  if (result <= 0) {
+    return (msg != NULL) ? msg : "Unknown error in gzip compression";
+  }
+  *compressed_size = (size_t)result;
+  return NULL;
+}
+
+DumpOutput::DumpOutput(const char* path, AbstractCompressor* compressor) :
+  _fd(-1), _bytes_written(0), _error(NULL), _compressor(compressor),
+  _lock(new Mutex(Mutex::leaf, "HeapDumpOutput_lock", true, Monitor::_safepoint_check_never)) {
+  _fd = os::create_binary_file(path, false);    // don't replace existing file
+
+  // if the open failed we record the error
+  if (_fd < 0) {
+    set_error(os::strerror(errno));
+  }
+}
+
+DumpOutput::~DumpOutput() {
+  close();
+  delete _compressor;
+  delete _lock;
+  if (_error != NULL) os::free(_error);
+}
+
+size_t DumpOutput::init_compression(size_t block_size) {
+  size_t needed_out_size = 0;
+  if (is_open() && is_compressed()) {
+    const char* msg = _compressor->init(block_size, &needed_out_size);
+    if (msg != NULL) {
+      set_error(msg);
+      close();
+      return 0;
+    }
+  }
+  return needed_out_size;
+}
+
+// closes dump file (if open)
+void DumpOutput::close() {
+  if (is_open()) {
+    os::close(_fd);
+    _fd = -1;
+  }
+}
+
+// records the first error only, later ones are usually follow-ups
+void DumpOutput::set_error(const char* error) {
+  if (_error == NULL) {
+    _error = os::strdup(error);
+  }
+}
+
+// write directly to the file, called with the lock held
+void DumpOutput::write_internal(const char* s, size_t len) {
+  assert(_lock->owned_by_self(), "must hold the output lock");
+  while (is_open() && len > 0) {
+    uint tmp = (uint)MIN2(len, (size_t)UINT_MAX);
+    ssize_t n = os::write(_fd, s, tmp);
+
+    if (n < 0) {
+      // EINTR cannot happen here, os::write will take care of that
+      set_error(os::strerror(errno));
+      close();
+      return;
+    }
+
+    _bytes_written += n;
+    s += n;
+    len -= n;
+  }
+}
+
+void DumpOutput::write(char* buf, size_t len, char* out_buf, size_t out_size) {
+  if (!is_open() || len == 0) {
+    return;
+  }
+
+  const char* data = buf;
+  if (is_compressed()) {
+    assert(out_buf != NULL, "compression needs an output buffer");
+    const char* msg = _compressor->compress(buf, len, out_buf, out_size, &len);
+    if (msg != NULL) {
+      MutexLockerEx ml(_lock->owned_by_self() ? NULL : _lock, Mutex::_no_safepoint_check_flag);
+      set_error(msg);
+      close();
+      return;
+    }
+    data = out_buf;
+  }
+
+  // the lock is already held while a huge record is streamed
+  MutexLockerEx ml(_lock->owned_by_self() ? NULL : _lock, Mutex::_no_safepoint_check_flag);
+  write_internal(data, len);
+}
+
+void DumpOutput::begin_exclusive() {
+  _lock->lock_without_safepoint_check();
+}
+
+void DumpOutput::end_exclusive() {
+  _lock->unlock();
+}
@@ -0,0 +1,109 @@
+/*
+ * Copyright (c) 2018, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#ifndef SHARE_VM_SERVICES_HEAPDUMPERCOMPRESSION_HPP
+#define SHARE_VM_SERVICES_HEAPDUMPERCOMPRESSION_HPP
+
+#include "memory/allocation.hpp"
+
+class Mutex;
+
+// Interface for a compression algorithm applied to the blocks of a heap dump.
+// Every block is compressed independently, so blocks compressed by different
+// threads can be written to the dump file in any order.
+class AbstractCompressor : public CHeapObj<mtInternal> {
+public:
+  virtual ~AbstractCompressor() { }
+
+  // Initializes the compressor. Returns a static error message in case of an
+  // error. Otherwise sets the size of the output buffer needed to compress
+  // a block of block_size bytes.
+  virtual const char* init(size_t block_size, size_t* needed_out_size) = 0;
+
+  // Compresses the input buffer into the output buffer. Returns a static
+  // error message in case of an error, otherwise sets the compressed size.
+  virtual const char* compress(char* in, size_t in_size, char* out, size_t out_size,
+                               size_t* compressed_size) = 0;
+};
+
+// Compresses each block into a self contained gzip member using the
+// zlib bundled with libzip. A file made of concatenated members is a
+// valid gzip file.
+class GZipCompressor : public AbstractCompressor {
+private:
+  int _level;
+
+public:
+  GZipCompressor(int level) : _level(level) { }
+
+  virtual const char* init(size_t block_size, size_t* needed_out_size);
+
+  virtual const char* compress(char* in, size_t in_size, char* out, size_t out_size,
+                               size_t* compressed_size);
+};
+
+// The dump file shared by all DumpWriters of a heap dump. Writers hand over
+// their buffers only at top-level record boundaries, so output from different
+// writers can be interleaved at block granularity. A writer that has to
+// stream a record larger than its buffer takes the output exclusively for the
+// duration of that record.
+class DumpOutput : public CHeapObj<mtInternal> {
+private:
+  int _fd;                          // file descriptor (-1 if dump file not open)
+  julong _bytes_written;            // number of bytes written to dump file
+  char* _error;                     // error message when I/O fails
+  AbstractCompressor* _compressor;  // NULL if the dump is not compressed
+  Mutex* _lock;
+
+  void write_internal(const char* s, size_t len);
+
+public:
+  DumpOutput(const char* path, AbstractCompressor* compressor);
+  ~DumpOutput();
+
+  // Sets up the compressor for blocks of at most block_size bytes and
+  // returns the size of the scratch buffer each writer has to provide.
+  size_t init_compression(size_t block_size);
+
+  bool is_open() const           { return _fd >= 0; }
+  bool is_compressed() const     { return _compressor != NULL; }
+  void close();
+
+  // total number of bytes written to the disk
+  julong bytes_written() const   { return _bytes_written; }
+  char* error() const            { return _error; }
+  void set_error(const char* error);
+
+  // Compresses (if enabled) and writes the given block. The compression
+  // happens in the calling thread using its own scratch buffer, only the
+  // file write is serialized.
+  void write(char* buf, size_t len, char* out_buf, size_t out_size);
+
+  // Brackets a sequence of writes which must not be interleaved with the
+  // output of other writers.
+  void begin_exclusive();
+  void end_exclusive();
+};
+
+#endif // SHARE_VM_SERVICES_HEAPDUMPERCOMPRESSION_HPP
@@ -37,10 +37,24 @@ size_t MallocMemorySnapshot::total() const {
   for (int index = 0; index < mt_number_of_types; index ++) {
     amount += _malloc[index].malloc_size();
   }
-  amount += _tracking_header.size() + total_arena();
+  amount += malloc_overhead() + total_arena();
   return amount;
 }
 
+// Every tracked malloc carries exactly one MallocHeader, so the header
+// overhead follows from the malloc counts and needs no counter of its
+// own. Thread stacks are counted in mtThreadStack without a header.
+size_t MallocMemorySnapshot::malloc_overhead() const {
+  size_t headers = 0;
+  int thread_stack_idx = NMTUtil::flag_to_index(mtThreadStack);
+  for (int index = 0; index < mt_number_of_types; index ++) {
+    if (index != thread_stack_idx) {
+      headers += _malloc[index].malloc_count();
+    }
+  }
+  return headers * sizeof(MallocHeader);
+}
+
 // Total malloc'd memory used by arenas
 size_t MallocMemorySnapshot::total_arena() const {
   size_t amount = 0;
@@ -55,7 +69,7 @@ size_t MallocMemorySnapshot::total_arena() const {
 void MallocMemorySnapshot::make_adjustment() {
   size_t arena_size = total_arena();
   int chunk_idx = NMTUtil::flag_to_index(mtChunk);
-  _malloc[chunk_idx].record_free(arena_size);
+  _malloc[chunk_idx].record_malloc_size_change(-(long)arena_size);
 }
 
 
@@ -70,7 +84,6 @@ void MallocHeader::release() const {
   if (MemTracker::tracking_level() <= NMT_minimal) return;
 
   MallocMemorySummary::record_free(size(), flags());
-  MallocMemorySummary::record_free_malloc_header(sizeof(MallocHeader));
   if (MemTracker::tracking_level() == NMT_detail) {
     MallocSiteTable::deallocation_at(size(), _bucket_idx, _pos_idx);
   }
@@ -62,6 +62,7 @@
 #include "utilities/debug.hpp"
 #include "utilities/formatBuffer.hpp"
 #include "utilities/macros.hpp"
+#include "utilities/resourceHash.hpp"
 
 PerfVariable* Management::_begin_vm_creation_time = NULL;
 PerfVariable* Management::_end_vm_creation_time = NULL;
@@ -2088,6 +2089,27 @@ jlong Management::ticks_to_ms(jlong ticks) {
 }
 #endif // INCLUDE_MANAGEMENT
 
+// Resolves every thread ID in ids_ah against t_list, appending the matching
+// JavaThread or NULL if the thread does not exist or has terminated. The
+// list is walked once for all IDs instead of once per ID.
+static void find_java_threads(ThreadsList* t_list, typeArrayHandle ids_ah,
+                              GrowableArray<JavaThread*>* threads) {
+  ResourceHashtable<jlong, JavaThread*, primitive_hash<jlong>,
+                    primitive_equals<jlong>, 1031> tid_map;
+  for (uint i = 0; i < t_list->length(); i++) {
+    JavaThread* jt = t_list->thread_at(i);
+    oop tobj = jt->threadObj();
+    // Same filtering as ThreadsList::find_JavaThread_from_java_tid()
+    if (tobj != NULL && !jt->is_exiting()) {
+      tid_map.put(java_lang_Thread::thread_id(tobj), jt);
+    }
+  }
+  for (int i = 0; i < ids_ah->length(); i++) {
+    JavaThread** jt = tid_map.get(ids_ah->long_at(i));
+    threads->append(jt != NULL ? *jt : NULL);
+  }
+}
+
 // Gets an array containing the amount of memory allocated on the Java
 // heap for a set of threads (in bytes).  Each element of the array is
 // the amount of memory allocated for the thread ID specified in the
@@ -2119,8 +2141,10 @@ JVM_ENTRY(void, jmm_GetThreadAllocatedMemory(JNIEnv *env, jlongArray ids,
   }
 
   ThreadsListHandle tlh;
+  GrowableArray<JavaThread*> threads(num_threads);
+  find_java_threads(tlh.list(), ids_ah, &threads);
   for (int i = 0; i < num_threads; i++) {
-    JavaThread* java_thread = tlh.list()->find_JavaThread_from_java_tid(ids_ah->long_at(i));
+    JavaThread* java_thread = threads.at(i);
     if (java_thread != NULL) {
       sizeArray_h->long_at_put(i, java_thread->cooked_allocated_bytes());
     }
@@ -2190,8 +2214,10 @@ JVM_ENTRY(void, jmm_GetThreadCpuTimesWithKind(JNIEnv *env, jlongArray ids,
   }
 
   ThreadsListHandle tlh;
+  GrowableArray<JavaThread*> threads(num_threads);
+  find_java_threads(tlh.list(), ids_ah, &threads);
   for (int i = 0; i < num_threads; i++) {
-    JavaThread* java_thread = tlh.list()->find_JavaThread_from_java_tid(ids_ah->long_at(i));
+    JavaThread* java_thread = threads.at(i);
     if (java_thread != NULL) {
       timeArray_h->long_at_put(i, os::thread_cpu_time((Thread*)java_thread,
                                                       user_sys_cpu_time != 0));
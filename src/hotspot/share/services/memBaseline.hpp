@@ -95,6 +95,13 @@ class MemBaseline {
 
   bool baseline(bool summaryOnly = true);
 
+  // Sample the resident size of committed virtual memory into this baseline.
+  // Returns false if the platform cannot report residency.
+  bool sample_resident_memory() {
+    assert(baseline_type() != Not_baselined, "Not yet baselined");
+    return VirtualMemoryTracker::sample_resident(&_virtual_memory_snapshot);
+  }
+
   BaselineType baseline_type() const { return _baseline_type; }
 
   MallocMemorySnapshot* malloc_memory_snapshot() {
@@ -144,8 +151,7 @@ class MemBaseline {
 
   size_t malloc_tracking_overhead() const {
     assert(baseline_type() != Not_baselined, "Not yet baselined");
-    MemBaseline* bl = const_cast<MemBaseline*>(this);
-    return bl->_malloc_memory_snapshot.malloc_overhead()->size();
+    return _malloc_memory_snapshot.malloc_overhead();
   }
 
   MallocMemory* malloc_memory(MEMFLAGS flag) {
@@ -24,6 +24,7 @@
 #include "precompiled.hpp"
 
 #include "memory/allocation.hpp"
+#include "memory/arena.hpp"
 #include "services/mallocTracker.hpp"
 #include "services/memReporter.hpp"
 #include "services/virtualMemoryTracker.hpp"
@@ -104,6 +105,14 @@ void MemSummaryReporter::report() {
   out->print_cr("\nNative Memory Tracking:\n");
   out->print("Total: ");
   print_total(total_reserved_amount, total_committed_amount);
+  if (_vm_snapshot->is_resident_sampled()) {
+    out->print(", mmap resident=" SIZE_FORMAT "%s",
+      amount_in_current_scale(_vm_snapshot->total_resident()), scale);
+    if (_vm_snapshot->is_thp_sampled()) {
+      out->print(", thp=" SIZE_FORMAT "%s",
+        amount_in_current_scale(_vm_snapshot->total_thp()), scale);
+    }
+  }
   out->print("\n");
 
   // Summary by memory type
@@ -132,8 +141,8 @@ void MemSummaryReporter::report_summary_of_type(MEMFLAGS flag,
     committed_amount += thread_stack_usage->committed();
   } else if (flag == mtNMT) {
     // Count malloc headers in "NMT" category
-    reserved_amount  += _malloc_snapshot->malloc_overhead()->size();
-    committed_amount += _malloc_snapshot->malloc_overhead()->size();
+    reserved_amount  += _malloc_snapshot->malloc_overhead();
+    committed_amount += _malloc_snapshot->malloc_overhead();
   }
 
   if (amount_in_current_scale(reserved_amount) > 0) {
@@ -156,6 +165,10 @@ void MemSummaryReporter::report_summary_of_type(MEMFLAGS flag,
        _vm_snapshot->by_type(mtThreadStack);
       out->print("%27s (stack: ", " ");
       print_total(thread_stack_usage->reserved(), thread_stack_usage->committed());
+      if (_vm_snapshot->is_resident_sampled()) {
+        out->print(", resident=" SIZE_FORMAT "%s",
+          amount_in_current_scale(thread_stack_usage->resident()), scale);
+      }
       out->print_cr(")");
     }
 
@@ -164,10 +177,26 @@ void MemSummaryReporter::report_summary_of_type(MEMFLAGS flag,
       // We don't know how many arena chunks are in used, so don't report the count
       size_t count = (flag == mtChunk) ? 0 : malloc_memory->malloc_count();
       print_malloc_line(malloc_memory->malloc_size(), count);
+      if (flag == mtChunk) {
+        // Split arena chunks into those cached in the chunk pools and those in use
+        size_t pooled = MIN2(Chunk::pooled_bytes(), malloc_memory->malloc_size());
+        out->print_cr("%27s (pooled=" SIZE_FORMAT "%s, in use=" SIZE_FORMAT "%s)", " ",
+          amount_in_current_scale(pooled), scale,
+          amount_in_current_scale(malloc_memory->malloc_size() - pooled), scale);
+      }
     }
 
     if (amount_in_current_scale(virtual_memory->reserved()) > 0) {
       print_virtual_memory_line(virtual_memory->reserved(), virtual_memory->committed());
+      if (_vm_snapshot->is_resident_sampled()) {
+        out->print("%27s (mmap: resident=" SIZE_FORMAT "%s", " ",
+          amount_in_current_scale(virtual_memory->resident()), scale);
+        if (_vm_snapshot->is_thp_sampled()) {
+          out->print(", thp=" SIZE_FORMAT "%s",
+            amount_in_current_scale(virtual_memory->thp()), scale);
+        }
+        out->print_cr(")");
+      }
     }
 
     if (amount_in_current_scale(malloc_memory->arena_size()) > 0) {
@@ -175,9 +204,9 @@ void MemSummaryReporter::report_summary_of_type(MEMFLAGS flag,
     }
 
     if (flag == mtNMT &&
-      amount_in_current_scale(_malloc_snapshot->malloc_overhead()->size()) > 0) {
+      amount_in_current_scale(_malloc_snapshot->malloc_overhead()) > 0) {
       out->print_cr("%27s (tracking overhead=" SIZE_FORMAT "%s)", " ",
-        amount_in_current_scale(_malloc_snapshot->malloc_overhead()->size()), scale);
+        amount_in_current_scale(_malloc_snapshot->malloc_overhead()), scale);
     } else if (flag == mtClass) {
       // Metadata information
       report_metadata(Metaspace::NonClassType);
@@ -216,6 +245,30 @@ void MemSummaryReporter::report_metadata(Metaspace::MetadataType type) const {
     scale, ((float)waste * 100)/committed);
 }
 
+void MemNumaReporter::report() {
+  outputStream* out = output();
+  const char* scale = current_scale();
+  out->print_cr("Resident virtual memory by NUMA node:");
+  out->print_cr(" ");
+  for (int index = 0; index < mt_number_of_types; index ++) {
+    const size_t* row = _node_sizes + index * _node_count;
+    size_t total = 0;
+    for (int i = 0; i < _num_ids; i ++) {
+      total += row[_node_ids[i]];
+    }
+    if (amount_in_current_scale(total) == 0) {
+      continue;
+    }
+    out->print("-%26s (", NMTUtil::flag_to_name(NMTUtil::index_to_flag(index)));
+    for (int i = 0; i < _num_ids; i ++) {
+      out->print("%snode%d=" SIZE_FORMAT "%s", (i == 0) ? "" : ", ", _node_ids[i],
+        amount_in_current_scale(row[_node_ids[i]]), scale);
+    }
+    out->print_cr(")");
+  }
+  out->print_cr(" ");
+}
+
 void MemDetailReporter::report_detail() {
   // Start detail report
   outputStream* out = output();
@@ -151,6 +151,26 @@ class MemDetailReporter : public MemSummaryReporter {
   void report_virtual_memory_region(const ReservedMemoryRegion* rgn);
 };
 
+/*
+ * The class is for reporting on which NUMA nodes the committed virtual
+ * memory of each type resides.
+ */
+class MemNumaReporter : public MemReporterBase {
+ private:
+  const size_t* _node_sizes;  // mt_number_of_types rows of _node_count entries
+  const int*    _node_ids;    // configured node ids, each below _node_count
+  int           _num_ids;
+  int           _node_count;
+
+ public:
+  MemNumaReporter(const size_t* node_sizes, int node_count, const int* node_ids,
+    int num_ids, outputStream* output, size_t scale = K) :
+    MemReporterBase(output, scale), _node_sizes(node_sizes), _node_ids(node_ids),
+    _num_ids(num_ids), _node_count(node_count) { }
+
+  void report();
+};
+
 /*
  * The class is for generating summary comparison report.
  * It compares current memory baseline against an early baseline.
@@ -24,6 +24,7 @@
 #include "precompiled.hpp"
 #include "memory/resourceArea.hpp"
 #include "runtime/mutexLocker.hpp"
+#include "runtime/os.hpp"
 #include "runtime/vmThread.hpp"
 #include "runtime/vm_operations.hpp"
 #include "services/nmtDCmd.hpp"
@@ -55,6 +56,14 @@ NMTDCmd::NMTDCmd(outputStream* output,
             "BOOLEAN", false, "false"),
   _statistics("statistics", "print tracker statistics for tuning purpose.", \
             "BOOLEAN", false, "false"),
+  _resident("resident", "sample and report the resident size of committed " \
+            "virtual memory, and the part of it backed by transparent huge " \
+            "pages where available, use with summary or detail.",
+            "BOOLEAN", false, "false"),
+  _numa("numa", "report on which NUMA nodes the resident committed virtual " \
+            "memory of each type is placed, use with summary or detail, " \
+            "requires -XX:+UseNUMA.",
+            "BOOLEAN", false, "false"),
   _scale("scale", "Memory usage in which scale, KB, MB or GB",
        "STRING", false, "KB") {
   _dcmdparser.add_dcmd_option(&_summary);
@@ -64,6 +73,8 @@ NMTDCmd::NMTDCmd(outputStream* output,
   _dcmdparser.add_dcmd_option(&_detail_diff);
   _dcmdparser.add_dcmd_option(&_shutdown);
   _dcmdparser.add_dcmd_option(&_statistics);
+  _dcmdparser.add_dcmd_option(&_resident);
+  _dcmdparser.add_dcmd_option(&_numa);
   _dcmdparser.add_dcmd_option(&_scale);
 }
 
@@ -113,16 +124,32 @@ void NMTDCmd::execute(DCmdSource source, TRAPS) {
     }
   }
 
+  if (_resident.value() && !_summary.value() && !_detail.value()) {
+    output()->print_cr("The resident option can only be used with summary or detail");
+    return;
+  }
+
+  if (_numa.value() && !_summary.value() && !_detail.value()) {
+    output()->print_cr("The numa option can only be used with summary or detail");
+    return;
+  }
+
   // Serialize NMT query
   MutexLocker locker(MemTracker::query_lock());
 
   if (_summary.value()) {
-    report(true, scale_unit);
+    report(true, _resident.value(), scale_unit);
+    if (_numa.value()) {
+      report_numa(scale_unit);
+    }
   } else if (_detail.value()) {
     if (!check_detail_tracking_level(output())) {
       return;
     }
-    report(false, scale_unit);
+    report(false, _resident.value(), scale_unit);
+    if (_numa.value()) {
+      report_numa(scale_unit);
+    }
   } else if (_baseline.value()) {
     MemBaseline& baseline = MemTracker::get_baseline();
     if (!baseline.baseline(MemTracker::tracking_level() != NMT_detail)) {
@@ -171,9 +198,12 @@ int NMTDCmd::num_arguments() {
   }
 }
 
-void NMTDCmd::report(bool summaryOnly, size_t scale_unit) {
+void NMTDCmd::report(bool summaryOnly, bool resident, size_t scale_unit) {
   MemBaseline baseline;
   if (baseline.baseline(summaryOnly)) {
+    if (resident && !baseline.sample_resident_memory()) {
+      output()->print_cr("Resident memory sampling is not supported on this platform");
+    }
     if (summaryOnly) {
       MemSummaryReporter rpt(baseline, output(), scale_unit);
       rpt.report();
@@ -184,6 +214,28 @@ void NMTDCmd::report(bool summaryOnly, size_t scale_unit) {
   }
 }
 
+void NMTDCmd::report_numa(size_t scale_unit) {
+  if (!UseNUMA) {
+    output()->print_cr("NUMA placement is only reported with -XX:+UseNUMA");
+    return;
+  }
+  ResourceMark rm;
+  const size_t num_groups = os::numa_get_groups_num();
+  int* ids = NEW_RESOURCE_ARRAY(int, num_groups);
+  const int num_ids = (int)os::numa_get_leaf_groups(ids, num_groups);
+  int node_count = 0;
+  for (int i = 0; i < num_ids; i ++) {
+    node_count = MAX2(node_count, ids[i] + 1);
+  }
+  size_t* node_sizes = NEW_RESOURCE_ARRAY(size_t, mt_number_of_types * node_count);
+  if (num_ids == 0 || !VirtualMemoryTracker::sample_numa_residency(node_sizes, node_count)) {
+    output()->print_cr("NUMA placement of memory is not available on this platform");
+    return;
+  }
+  MemNumaReporter rpt(node_sizes, node_count, ids, num_ids, output(), scale_unit);
+  rpt.report();
+}
+
 void NMTDCmd::report_diff(bool summaryOnly, size_t scale_unit) {
   MemBaseline& early_baseline = MemTracker::get_baseline();
   assert(early_baseline.baseline_type() != MemBaseline::Not_baselined,
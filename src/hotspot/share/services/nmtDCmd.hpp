@@ -44,6 +44,8 @@ class NMTDCmd: public DCmdWithParser {
   DCmdArgument<bool>  _detail_diff;
   DCmdArgument<bool>  _shutdown;
   DCmdArgument<bool>  _statistics;
+  DCmdArgument<bool>  _resident;
+  DCmdArgument<bool>  _numa;
   DCmdArgument<char*> _scale;
 
  public:
@@ -64,7 +66,8 @@ class NMTDCmd: public DCmdWithParser {
   virtual void execute(DCmdSource source, TRAPS);
 
  private:
-  void report(bool summaryOnly, size_t scale);
+  void report(bool summaryOnly, bool resident, size_t scale);
+  void report_numa(size_t scale);
   void report_diff(bool summaryOnly, size_t scale);
 
   size_t get_scale(const char* scale) const;
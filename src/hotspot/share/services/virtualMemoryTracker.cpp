@@ -478,6 +478,92 @@ bool VirtualMemoryTracker::walk_virtual_memory(VirtualMemoryWalker* walker) {
   return true;
 }
 
+// Accumulate the resident and huge page backed sizes of committed regions
+// by memory type
+class ResidentMemoryWalker : public VirtualMemoryWalker {
+ private:
+  size_t _resident[mt_number_of_types];
+  size_t _thp[mt_number_of_types];
+  bool   _thp_available;
+
+ public:
+  ResidentMemoryWalker() : _thp_available(true) {
+    for (int index = 0; index < mt_number_of_types; index ++) {
+      _resident[index] = 0;
+      _thp[index] = 0;
+    }
+  }
+
+  bool do_allocation_site(const ReservedMemoryRegion* rgn) {
+    CommittedRegionIterator itr = rgn->iterate_committed_regions();
+    const CommittedMemoryRegion* committed_rgn;
+    while ((committed_rgn = itr.next()) != NULL) {
+      size_t resident;
+      if (!os::resident_size_in_range(committed_rgn->base(), committed_rgn->size(), &resident)) {
+        return false;
+      }
+      _resident[NMTUtil::flag_to_index(rgn->flag())] += resident;
+      size_t thp;
+      if (_thp_available &&
+          os::huge_page_backed_size_in_range(committed_rgn->base(), committed_rgn->size(), &thp)) {
+        _thp[NMTUtil::flag_to_index(rgn->flag())] += thp;
+      } else {
+        _thp_available = false;
+      }
+    }
+    return true;
+  }
+
+  size_t resident(int index) const { return _resident[index]; }
+  size_t thp(int index) const      { return _thp[index]; }
+  bool   thp_available() const     { return _thp_available; }
+};
+
+bool VirtualMemoryTracker::sample_resident(VirtualMemorySnapshot* s) {
+  ResidentMemoryWalker walker;
+  if (!walk_virtual_memory(&walker)) {
+    return false;
+  }
+  for (int index = 0; index < mt_number_of_types; index ++) {
+    s->by_index(index)->set_resident(walker.resident(index));
+    s->by_index(index)->set_thp(walker.thp_available() ? walker.thp(index) : 0);
+  }
+  s->set_resident_sampled(true);
+  s->set_thp_sampled(walker.thp_available());
+  return true;
+}
+
+// Accumulate the resident size of committed regions by memory type and node
+class NumaResidencyWalker : public VirtualMemoryWalker {
+ private:
+  size_t* _node_sizes;
+  int     _node_count;
+
+ public:
+  NumaResidencyWalker(size_t* node_sizes, int node_count) :
+    _node_sizes(node_sizes), _node_count(node_count) { }
+
+  bool do_allocation_site(const ReservedMemoryRegion* rgn) {
+    size_t* row = _node_sizes + NMTUtil::flag_to_index(rgn->flag()) * _node_count;
+    CommittedRegionIterator itr = rgn->iterate_committed_regions();
+    const CommittedMemoryRegion* committed_rgn;
+    while ((committed_rgn = itr.next()) != NULL) {
+      if (!os::numa_node_residency(committed_rgn->base(), committed_rgn->size(), row, _node_count)) {
+        return false;
+      }
+    }
+    return true;
+  }
+};
+
+bool VirtualMemoryTracker::sample_numa_residency(size_t* node_sizes, int node_count) {
+  for (int index = 0; index < mt_number_of_types * node_count; index ++) {
+    node_sizes[index] = 0;
+  }
+  NumaResidencyWalker walker(node_sizes, node_count);
+  return walk_virtual_memory(&walker);
+}
+
 // Transition virtual memory tracking level.
 bool VirtualMemoryTracker::transition(NMT_TrackingLevel from, NMT_TrackingLevel to) {
   assert (from != NMT_minimal, "cannot convert from the lowest tracking level to anything");
@@ -43,9 +43,11 @@ class VirtualMemory {
  private:
   size_t     _reserved;
   size_t     _committed;
+  size_t     _resident;   // sampled on demand, see VirtualMemoryTracker::sample_resident()
+  size_t     _thp;        // resident in transparent huge pages, sampled with _resident
 
  public:
-  VirtualMemory() : _reserved(0), _committed(0) { }
+  VirtualMemory() : _reserved(0), _committed(0), _resident(0), _thp(0) { }
 
   inline void reserve_memory(size_t sz) { _reserved += sz; }
   inline void commit_memory (size_t sz) {
@@ -65,6 +67,10 @@ class VirtualMemory {
 
   inline size_t reserved()  const { return _reserved;  }
   inline size_t committed() const { return _committed; }
+  inline size_t resident()  const { return _resident;  }
+  inline void set_resident(size_t sz) { _resident = sz; }
+  inline size_t thp()       const { return _thp;       }
+  inline void set_thp(size_t sz)      { _thp = sz; }
 };
 
 // Virtual memory allocation site, keeps track where the virtual memory is reserved.
@@ -90,8 +96,12 @@ class VirtualMemorySnapshot : public ResourceObj {
 
  private:
   VirtualMemory  _virtual_memory[mt_number_of_types];
+  bool           _resident_sampled;
+  bool           _thp_sampled;
 
  public:
+  VirtualMemorySnapshot() : _resident_sampled(false), _thp_sampled(false) { }
+
   inline VirtualMemory* by_type(MEMFLAGS flag) {
     int index = NMTUtil::flag_to_index(flag);
     return &_virtual_memory[index];
@@ -119,10 +129,34 @@ class VirtualMemorySnapshot : public ResourceObj {
     return amount;
   }
 
+  inline size_t total_resident() const {
+    size_t amount = 0;
+    for (int index = 0; index < mt_number_of_types; index ++) {
+      amount += _virtual_memory[index].resident();
+    }
+    return amount;
+  }
+
+  inline size_t total_thp() const {
+    size_t amount = 0;
+    for (int index = 0; index < mt_number_of_types; index ++) {
+      amount += _virtual_memory[index].thp();
+    }
+    return amount;
+  }
+
+  // Resident sizes are only meaningful once sampled
+  bool is_resident_sampled() const    { return _resident_sampled; }
+  void set_resident_sampled(bool v)   { _resident_sampled = v; }
+  bool is_thp_sampled() const         { return _thp_sampled; }
+  void set_thp_sampled(bool v)        { _thp_sampled = v; }
+
   void copy_to(VirtualMemorySnapshot* s) {
     for (int index = 0; index < mt_number_of_types; index ++) {
       s->_virtual_memory[index] = _virtual_memory[index];
     }
+    s->_resident_sampled = _resident_sampled;
+    s->_thp_sampled = _thp_sampled;
   }
 };
 
@@ -406,6 +440,16 @@ class VirtualMemoryTracker : AllStatic {
   // Walk virtual memory data structure for creating baseline, etc.
   static bool walk_virtual_memory(VirtualMemoryWalker* walker);
 
+  // Sample the resident portion of all committed regions into the snapshot,
+  // and, where the platform can tell, the portion backed by transparent huge
+  // pages. Returns false if the platform cannot report residency.
+  static bool sample_resident(VirtualMemorySnapshot* s);
+
+  // Sample on which NUMA node the committed memory of each type resides.
+  // node_sizes holds mt_number_of_types rows of node_count entries, indexed
+  // by node id. Returns false if the platform cannot report page placement.
+  static bool sample_numa_residency(size_t* node_sizes, int node_count);
+
   static bool transition(NMT_TrackingLevel from, NMT_TrackingLevel to);
 
  private:
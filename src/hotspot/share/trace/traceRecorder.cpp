@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) 2018, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#include "precompiled.hpp"
+#include "trace/traceRecorder.hpp"
+#if INCLUDE_TRACE
+#include "runtime/atomic.hpp"
+#include "runtime/globals.hpp"
+#include "utilities/globalDefinitions.hpp"
+#include "utilities/ostream.hpp"
+
+char*           TraceRecorder::_buffer   = NULL;
+size_t          TraceRecorder::_capacity = 0;
+volatile size_t TraceRecorder::_top      = 0;
+
+void TraceRecorder::initialize() {
+  if (!EnableTracing || TraceRecordingBufferSize == 0) {
+    return;
+  }
+  _buffer = NEW_C_HEAP_ARRAY_RETURN_NULL(char, TraceRecordingBufferSize, mtTracing);
+  if (_buffer == NULL) {
+    vm_exit_during_initialization("Could not allocate trace recording buffer");
+  }
+  _capacity = TraceRecordingBufferSize;
+}
+
+void TraceRecorder::record(const char* data, size_t len) {
+  assert(is_recording(), "invariant");
+  if (len > _capacity) {
+    // Only the tail of an oversized record survives anyway
+    data += len - _capacity;
+    len = _capacity;
+  }
+  const size_t start = Atomic::add(len, &_top) - len;
+  const size_t pos = start % _capacity;
+  const size_t first = MIN2(len, _capacity - pos);
+  memcpy(_buffer + pos, data, first);
+  memcpy(_buffer, data + first, len - first);
+}
+
+void TraceRecorder::dump(outputStream* st) {
+  assert(is_recording(), "invariant");
+  const size_t top = _top;
+  if (top <= _capacity) {
+    st->write(_buffer, top);
+    return;
+  }
+  // The ring has wrapped: the oldest record is partially overwritten,
+  // so start after the first line break following the write position.
+  size_t pos = top % _capacity;
+  size_t remaining = _capacity;
+  while (remaining > 0 && _buffer[pos] != '\n') {
+    pos = (pos + 1) % _capacity;
+    remaining--;
+  }
+  if (remaining <= 1) {
+    return;
+  }
+  pos = (pos + 1) % _capacity;
+  remaining--;
+  const size_t first = MIN2(remaining, _capacity - pos);
+  st->write(_buffer + pos, first);
+  st->write(_buffer, remaining - first);
+}
+
+void TraceRecorder::on_vm_exit() {
+  if (!is_recording()) {
+    return;
+  }
+  if (TraceRecordingFile != NULL) {
+    fileStream fs(TraceRecordingFile);
+    if (fs.is_open()) {
+      dump(&fs);
+    } else {
+      warning("Could not open trace recording file %s", TraceRecordingFile);
+    }
+  } else {
+    ttyLocker ttyl;
+    dump(tty);
+  }
+}
+
+#endif // INCLUDE_TRACE
@@ -0,0 +1,57 @@
+/*
+ * Copyright (c) 2018, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#ifndef SHARE_VM_TRACE_TRACERECORDER_HPP
+#define SHARE_VM_TRACE_TRACERECORDER_HPP
+
+#include "utilities/macros.hpp"
+#if INCLUDE_TRACE
+#include "memory/allocation.hpp"
+
+class outputStream;
+
+// In-memory ring buffer for committed trace events.
+//
+// When TraceRecordingBufferSize is set, events are formatted into a per-event
+// stack buffer by TraceStream and then copied into the ring with a single
+// atomic reservation, instead of being printed to tty piecemeal. The oldest
+// events are overwritten once the ring is full. The ring is written out at
+// VM exit, to TraceRecordingFile if set and to tty otherwise.
+class TraceRecorder : AllStatic {
+ private:
+  static char*           _buffer;
+  static size_t          _capacity;
+  static volatile size_t _top;      // total number of bytes ever recorded
+
+ public:
+  static void initialize();
+  static bool is_recording() { return _buffer != NULL; }
+
+  static void record(const char* data, size_t len);
+  static void dump(outputStream* st);
+  static void on_vm_exit();
+};
+
+#endif // INCLUDE_TRACE
+#endif // SHARE_VM_TRACE_TRACERECORDER_HPP
@@ -31,6 +31,16 @@
 #include "oops/klass.hpp"
 #include "oops/method.hpp"
 #include "oops/symbol.hpp"
+#include "trace/traceRecorder.hpp"
+
+TraceStream::~TraceStream() {
+  if (TraceRecorder::is_recording()) {
+    TraceRecorder::record(_st.base(), _st.size());
+  } else {
+    assert(tty != NULL, "invariant");
+    tty->write(_st.base(), _st.size());
+  }
+}
 
 void TraceStream::print_val(const char* label, const Klass* val) const {
   ResourceMark rm;
@@ -41,7 +51,7 @@ void TraceStream::print_val(const char* label, const Klass* val) const {
       description = name->as_C_string();
     }
   }
-  tty->print("%s = %s", label, description);
+  _st.print("%s = %s", label, description);
 }
 
 void TraceStream::print_val(const char* label, const Method* val) const {
@@ -50,13 +60,13 @@ void TraceStream::print_val(const char* label, const Method* val) const {
   if (val != NULL) {
     description = val->name_and_sig_as_C_string();
   }
-  tty->print("%s = %s", label, description);
+  _st.print("%s = %s", label, description);
 }
 
 void TraceStream::print_val(const char* label, const ClassLoaderData* cld) const {
   ResourceMark rm;
   if (cld == NULL || cld->is_anonymous()) {
-    tty->print("%s = NULL", label);
+    _st.print("%s = NULL", label);
     return;
   }
   const char* class_loader_name = "NULL";
@@ -85,7 +95,7 @@ void TraceStream::print_val(const char* label, const ClassLoaderData* cld) const
     // anonymous CLDs are excluded, this would be the boot loader
     class_loader_name = "boot";
   }
-  tty->print("%s = name=%s class=%s", label, class_loader_name, class_loader_type_name);
+  _st.print("%s = name=%s class=%s", label, class_loader_name, class_loader_type_name);
 }
 
 #endif // INCLUDE_TRACE
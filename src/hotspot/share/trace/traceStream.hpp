@@ -35,58 +35,65 @@ class ClassLoaderData;
 class Klass;
 class Method;
 
+// Formats one event into a stack buffer; the complete event is emitted
+// with a single write, to the trace recorder or to tty, on destruction.
 class TraceStream : public StackObj {
+ private:
+  enum { buffer_size = 2 * K };
+
+  char                 _buf[buffer_size];
+  mutable stringStream _st;
+
  public:
-  TraceStream() {
-    assert(tty != NULL, "invariant");
-  }
+  TraceStream() : _st(_buf, sizeof(_buf)) { }
+  ~TraceStream();
 
   void print(const char* val) const {
-    tty->print("%s", val);
+    _st.print("%s", val);
   }
 
   void print_val(const char* label, u1 val) const {
-    tty->print("%s = " UINT32_FORMAT, label, val);
+    _st.print("%s = " UINT32_FORMAT, label, val);
   }
 
   void print_val(const char* label, u2 val) const {
-    tty->print("%s = " UINT32_FORMAT, label, val);
+    _st.print("%s = " UINT32_FORMAT, label, val);
   }
 
   void print_val(const char* label, s2 val) const {
-    tty->print("%s = " INT32_FORMAT, label, val);
+    _st.print("%s = " INT32_FORMAT, label, val);
   }
 
   void print_val(const char* label, u4 val) const {
-    tty->print("%s = " UINT32_FORMAT, label, val);
+    _st.print("%s = " UINT32_FORMAT, label, val);
   }
 
   void print_val(const char* label, s4 val) const {
-    tty->print("%s = " INT32_FORMAT, label, val);
+    _st.print("%s = " INT32_FORMAT, label, val);
   }
 
   void print_val(const char* label, u8 val) const {
-    tty->print("%s = " UINT64_FORMAT, label, val);
+    _st.print("%s = " UINT64_FORMAT, label, val);
   }
 
   void print_val(const char* label, s8 val) const {
-    tty->print("%s = " INT64_FORMAT, label, (int64_t) val);
+    _st.print("%s = " INT64_FORMAT, label, (int64_t) val);
   }
 
   void print_val(const char* label, bool val) const {
-    tty->print("%s = %s", label, val ? "true" : "false");
+    _st.print("%s = %s", label, val ? "true" : "false");
   }
 
   void print_val(const char* label, float val) const {
-    tty->print("%s = %f", label, val);
+    _st.print("%s = %f", label, val);
   }
 
   void print_val(const char* label, double val) const {
-    tty->print("%s = %f", label, val);
+    _st.print("%s = %f", label, val);
   }
 
   void print_val(const char* label, const char* val) const {
-    tty->print("%s = '%s'", label, val);
+    _st.print("%s = '%s'", label, val);
   }
 
   void print_val(const char* label, const Klass* val) const;
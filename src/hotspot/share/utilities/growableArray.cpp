@@ -58,6 +58,13 @@ void* GenericGrowableArray::raw_allocate(int elementSize) {
   }
 }
 
+bool GenericGrowableArray::raw_try_extend(void* elements, int elementSize, int old_max) {
+  assert(!on_C_heap(), "C heap arrays are reallocated");
+  assert(_max >= old_max, "integer overflow");
+  Arena* arena = on_stack() ? Thread::current()->resource_area() : _arena;
+  return arena->Aextend(elements, elementSize * (size_t) old_max, elementSize * (size_t) _max);
+}
+
 void GenericGrowableArray::free_C_heap(void* elements) {
   FreeHeap(elements);
 }
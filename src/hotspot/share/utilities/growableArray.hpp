@@ -139,6 +139,10 @@ class GenericGrowableArray : public ResourceObj {
 
   void* raw_allocate(int elementSize);
 
+  // Try to grow the arena or resource area backed elements in place
+  // from old_max to _max elements.
+  bool raw_try_extend(void* elements, int elementSize, int old_max);
+
   // some uses pass the Thread explicitly for speed (4990299 tuning)
   void* raw_allocate(Thread* thread, int elementSize) {
     assert(on_stack(), "fast ResourceObj path only");
@@ -443,6 +447,14 @@ template<class E> void GrowableArray<E>::grow(int j) {
     if (_max == 0) _max = 1; // prevent endless loop
     while (j >= _max) _max = _max*2;
     // j < _max
+    if (!on_C_heap() && _data != NULL && raw_try_extend(_data, sizeof(E), old_max)) {
+      // The elements stay where they are; only construct the new slots.
+#ifdef _MSC_VER
+#pragma warning(suppress: 4345)
+#endif
+      for (int i = old_max; i < _max; i++) ::new ((void*)&_data[i]) E();
+      return;
+    }
     E* newData = (E*)raw_allocate(sizeof(E));
     int i = 0;
     for (     ; i < _len; i++) ::new ((void*)&newData[i]) E(_data[i]);
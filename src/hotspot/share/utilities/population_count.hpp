@@ -0,0 +1,49 @@
+/*
+ * Copyright (c) 2018, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#ifndef SHARE_VM_UTILITIES_POPULATIONCOUNT_HPP
+#define SHARE_VM_UTILITIES_POPULATIONCOUNT_HPP
+
+#include "utilities/globalDefinitions.hpp"
+
+// unsigned population_count(uintx x)
+// Return the number of bits set in x.
+//
+// Branch-free SWAR implementation, adapted from Hacker's Delight, 2nd
+// Edition, Figure 5-2.  The compiler builtins are not used because our
+// builds still target processors without a POPCNT instruction, and for
+// those the builtin is an out-of-line library call that is slower than
+// this sequence.
+inline unsigned population_count(uintx x) {
+  const uintx m1  = ~(uintx)0 / 3;        // 0x5555...
+  const uintx m2  = ~(uintx)0 / 15 * 3;   // 0x3333...
+  const uintx m4  = ~(uintx)0 / 255 * 15; // 0x0f0f...
+  const uintx h01 = ~(uintx)0 / 255;      // 0x0101...
+  x -= (x >> 1) & m1;
+  x = (x & m2) + ((x >> 2) & m2);
+  x = (x + (x >> 4)) & m4;
+  return (unsigned)((x * h01) >> (BitsPerWord - BitsPerByte));
+}
+
+#endif // SHARE_VM_UTILITIES_POPULATIONCOUNT_HPP
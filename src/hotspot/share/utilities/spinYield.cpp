@@ -0,0 +1,55 @@
+/*
+ * Copyright (c) 2018, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#include "precompiled.hpp"
+#include "runtime/os.hpp"
+#include "utilities/spinYield.hpp"
+
+SpinYield::SpinYield(uint spin_limit, uint yield_limit) :
+  _spins(0),
+  _yields(0),
+  _sleeps(0),
+  _spin_limit(os::is_MP() ? spin_limit : 0),
+  _yield_limit(yield_limit)
+{}
+
+void SpinYield::wait() {
+  // Simple policy: first spin for a while, then yield, then sleep.
+  if (_spins < _spin_limit) {
+    ++_spins;
+    SpinPause();
+  } else {
+    yield_or_sleep();
+  }
+}
+
+void SpinYield::yield_or_sleep() {
+  if (_yields < _yield_limit) {
+    ++_yields;
+    os::naked_yield();
+  } else {
+    ++_sleeps;
+    os::naked_short_sleep(1);
+  }
+}
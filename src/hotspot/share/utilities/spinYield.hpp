@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2016, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2018, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -22,31 +22,33 @@
  *
  */
 
-#ifndef SHARE_VM_GC_G1_G1CARDLIVEDATA_INLINE_HPP
-#define SHARE_VM_GC_G1_G1CARDLIVEDATA_INLINE_HPP
+#ifndef SHARE_VM_UTILITIES_SPINYIELD_HPP
+#define SHARE_VM_UTILITIES_SPINYIELD_HPP
 
-#include "gc/g1/g1CardLiveData.hpp"
-#include "utilities/bitMap.inline.hpp"
+#include "memory/allocation.hpp"
 #include "utilities/globalDefinitions.hpp"
 
-inline BitMapView G1CardLiveData::live_card_bitmap(uint region) {
-  return BitMapView(_live_cards + ((size_t)region * _cards_per_region >> LogBitsPerWord), _cards_per_region);
-}
+// Provide utilities for waiting for a condition to become true by
+// busy-waiting.  Starts by spinning for a while, then yields the
+// processor a number of times, and finally falls back to sleeping.
+class SpinYield : public StackObj {
+  uint _spins;
+  uint _yields;
+  uint _sleeps;
+  uint _spin_limit;
+  uint _yield_limit;
 
-inline bool G1CardLiveData::is_card_live_at(BitMap::idx_t idx) const {
-  return live_cards_bm().at(idx);
-}
+  void yield_or_sleep();
 
-inline bool G1CardLiveData::is_region_live(uint region) const {
-  return live_regions_bm().at(region);
-}
+public:
+  static const uint default_spin_limit = 4096;
+  static const uint default_yield_limit = 64;
 
-inline void G1CardLiveData::remove_nonlive_cards(uint region, BitMap* bm) {
-  bm->set_intersection(live_card_bitmap(region));
-}
+  explicit SpinYield(uint spin_limit = default_spin_limit,
+                     uint yield_limit = default_yield_limit);
 
-inline void G1CardLiveData::remove_nonlive_regions(BitMap* bm) {
-  bm->set_intersection(live_regions_bm());
-}
+  // Perform next round of delay.
+  void wait();
+};
 
-#endif /* SHARE_VM_GC_G1_G1CARDLIVEDATA_INLINE_HPP */
+#endif // SHARE_VM_UTILITIES_SPINYIELD_HPP
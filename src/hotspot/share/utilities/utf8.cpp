@@ -25,6 +25,29 @@
 #include "precompiled.hpp"
 #include "utilities/utf8.hpp"
 
+// The low and the high bit of every byte in a word. A word of input bytes
+// ANDed with high_bits is zero iff all of them are ASCII.
+static const uint64_t low_bits  = UCONST64(0x0101010101010101);
+static const uint64_t high_bits = UCONST64(0x8080808080808080);
+
+// Returns the number of leading ASCII bytes in str[0, len), scanning a
+// word at a time. Unaligned loads go through memcpy, which compilers
+// turn into a single move on platforms that allow it.
+static int ascii_prefix_length(const char* str, int len) {
+  int i = 0;
+  for (; i + (int)sizeof(uint64_t) <= len; i += sizeof(uint64_t)) {
+    uint64_t word;
+    memcpy(&word, str + i, sizeof(word));
+    if ((word & high_bits) != 0) {
+      break;
+    }
+  }
+  while (i < len && (unsigned char)str[i] <= 0x7F) {
+    i++;
+  }
+  return i;
+}
+
 // Assume the utf8 string is in legal form and has been
 // checked in the class file parser/format checker.
 template<typename T> char* UTF8::next(const char* str, T* value) {
@@ -100,8 +123,10 @@ int UTF8::unicode_length(const char* str, int len, bool& is_latin1, bool& has_mu
   int num_chars = len;
   has_multibyte = false;
   is_latin1 = true;
-  unsigned char prev = 0;
-  for (int i = 0; i < len; i++) {
+  // ASCII bytes are one character each and do not affect the flags.
+  int i = ascii_prefix_length(str, len);
+  unsigned char prev = (i > 0) ? str[i - 1] : 0;
+  for (; i < len; i++) {
     unsigned char c = str[i];
     if ((c & 0xC0) == 0x80) {
       // Multibyte, check if valid latin1 character.
@@ -172,6 +197,11 @@ template<typename T> void UTF8::convert_to_unicode(const char* utf8_str, T* unic
   int index = 0;
 
   /* ASCII case loop optimization */
+  int ascii = ascii_prefix_length(ptr, unicode_length);
+  for (; index < ascii; index++) {
+    unicode_str[index] = (T)ptr[index];
+  }
+  ptr += ascii;
   for (; index < unicode_length; index++) {
     if((ch = ptr[0]) > 0x7F) { break; }
     unicode_str[index] = (T)ch;
@@ -336,7 +366,18 @@ jint UTF8::get_supplementary_character(const unsigned char* str) {
 bool UTF8::is_legal_utf8(const unsigned char* buffer, int length,
                          bool version_leq_47) {
   int i = 0;
-  int count = length >> 2;
+  // Most class file strings are ASCII, so first check eight bytes at a
+  // time. A word is plain ASCII without embedded zeros if no byte has its
+  // high bit set and no byte is zero; (w - 0x01..01) & ~w sets the high
+  // bit of a byte if the word contains a zero byte.
+  for (; i + (int)sizeof(uint64_t) <= length; i += sizeof(uint64_t)) {
+    uint64_t word;
+    memcpy(&word, buffer + i, sizeof(word));
+    if (((word | ((word - low_bits) & ~word)) & high_bits) != 0) {
+      break;
+    }
+  }
+  int count = (length - i) >> 2;
   for (int k=0; k<count; k++) {
     unsigned char b0 = buffer[i];
     unsigned char b1 = buffer[i+1];
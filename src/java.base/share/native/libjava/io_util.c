@@ -57,6 +57,13 @@ readSingle(JNIEnv *env, jobject this, jfieldID fid) {
  */
 #define BUF_SIZE 8192
 
+/* The maximum size of a malloc'd buffer. Larger reads return at most this
+ * many bytes, which is allowed by the read contracts, and larger writes are
+ * done in chunks of this size. This bounds the native memory used per call
+ * and keeps large requests from hitting malloc's mmap threshold every time.
+ */
+#define MAX_MALLOC_SIZE (64 * 1024)
+
 /*
  * Returns true if the array slice defined by the given offset and length
  * is out of bounds.
@@ -92,6 +99,9 @@ readBytes(JNIEnv *env, jobject this, jbyteArray bytes,
     if (len == 0) {
         return 0;
     } else if (len > BUF_SIZE) {
+        if (len > MAX_MALLOC_SIZE) {
+            len = MAX_MALLOC_SIZE;
+        }
         buf = malloc(len);
         if (buf == NULL) {
             JNU_ThrowOutOfMemoryError(env, NULL);
@@ -149,6 +159,7 @@ writeBytes(JNIEnv *env, jobject this, jbyteArray bytes,
     jint n;
     char stackBuf[BUF_SIZE];
     char *buf = NULL;
+    jint bufSize;
     FD fd;
 
     if (IS_NULL(bytes)) {
@@ -164,38 +175,48 @@ writeBytes(JNIEnv *env, jobject this, jbyteArray bytes,
     if (len == 0) {
         return;
     } else if (len > BUF_SIZE) {
-        buf = malloc(len);
+        bufSize = (len > MAX_MALLOC_SIZE) ? MAX_MALLOC_SIZE : len;
+        buf = malloc(bufSize);
         if (buf == NULL) {
             JNU_ThrowOutOfMemoryError(env, NULL);
             return;
         }
     } else {
+        bufSize = BUF_SIZE;
         buf = stackBuf;
     }
 
-    (*env)->GetByteArrayRegion(env, bytes, off, len, (jbyte *)buf);
+    /* Copy and write one buffer-sized chunk of the array at a time */
+    while (len > 0) {
+        jint chunkLen = (len > bufSize) ? bufSize : len;
+        jint chunkOff = 0;
 
-    if (!(*env)->ExceptionOccurred(env)) {
-        off = 0;
-        while (len > 0) {
+        (*env)->GetByteArrayRegion(env, bytes, off, chunkLen, (jbyte *)buf);
+        if ((*env)->ExceptionOccurred(env)) {
+            break;
+        }
+        while (chunkOff < chunkLen) {
             fd = GET_FD(this, fid);
             if (fd == -1) {
                 JNU_ThrowIOException(env, "Stream Closed");
-                break;
+                goto done;
             }
             if (append == JNI_TRUE) {
-                n = IO_Append(fd, buf+off, len);
+                n = IO_Append(fd, buf+chunkOff, chunkLen-chunkOff);
             } else {
-                n = IO_Write(fd, buf+off, len);
+                n = IO_Write(fd, buf+chunkOff, chunkLen-chunkOff);
             }
             if (n == -1) {
                 JNU_ThrowIOExceptionWithLastError(env, "Write error");
-                break;
+                goto done;
             }
-            off += n;
-            len -= n;
+            chunkOff += n;
         }
+        off += chunkLen;
+        len -= chunkLen;
     }
+
+done:
     if (buf != stackBuf) {
         free(buf);
     }
@@ -1563,3 +1563,50 @@ ZIP_InflateFully(void *inBuf, jlong inLen, void *outBuf, jlong outLen, char **pm
     inflateEnd(&strm);
     return JNI_TRUE;
 }
+
+/*
+ * Returns the size of the output buffer ZIP_GZip_Fully needs to
+ * compress inLen bytes.
+ */
+JNIEXPORT jlong JNICALL
+ZIP_GZip_Bound(jlong inLen)
+{
+    /* compressBound() accounts for a zlib wrapper, a gzip one is 12 bytes larger */
+    return (jlong) compressBound((uLong) inLen) + 12;
+}
+
+/*
+ * Compresses the input buffer into a single, complete gzip member.
+ * Returns the compressed size, or 0 with *pmsg set if compression failed.
+ */
+JNIEXPORT jlong JNICALL
+ZIP_GZip_Fully(void *inBuf, jlong inLen, void *outBuf, jlong outLen, jint level, char **pmsg)
+{
+    z_stream strm;
+    jlong result;
+    memset(&strm, 0, sizeof(z_stream));
+
+    *pmsg = 0; /* Reset error message */
+
+    /* Adding 16 to the window bits selects the gzip format */
+    if (deflateInit2(&strm, level, Z_DEFLATED, MAX_WBITS + 16, 8,
+                     Z_DEFAULT_STRATEGY) != Z_OK) {
+        *pmsg = "ZIP_GZip_Fully: cannot initialize deflater";
+        return 0;
+    }
+
+    strm.next_in = (Bytef *) inBuf;
+    strm.avail_in = (uInt) inLen;
+    strm.next_out = (Bytef *) outBuf;
+    strm.avail_out = (uInt) outLen;
+
+    if (deflate(&strm, Z_FINISH) != Z_STREAM_END) {
+        *pmsg = "ZIP_GZip_Fully: output buffer too small";
+        deflateEnd(&strm);
+        return 0;
+    }
+
+    result = (jlong) strm.total_out;
+    deflateEnd(&strm);
+    return result;
+}
@@ -48,10 +48,21 @@ Java_java_net_SocketInputStream_init(JNIEnv *env, jclass cls) {
 }
 
 static int NET_ReadWithTimeout(JNIEnv *env, int fd, char *bufP, int len, long timeout) {
-    int result = 0;
-    jlong prevNanoTime = JVM_NanoTime(env, 0);
+    int result;
+    jlong prevNanoTime;
     jlong nanoTimeout = (jlong) timeout * NET_NSEC_PER_MSEC;
-    while (nanoTimeout >= NET_NSEC_PER_MSEC) {
+
+    /*
+     * Try the read before polling: on a busy connection data is usually
+     * already available and the poll would be a wasted system call.
+     */
+    result = NET_NonBlockingRead(fd, bufP, len);
+    if (result != -1 || ((errno != EAGAIN) && (errno != EWOULDBLOCK))) {
+        return result;
+    }
+
+    prevNanoTime = JVM_NanoTime(env, 0);
+    for (;;) {
         result = NET_Timeout(env, fd, nanoTimeout / NET_NSEC_PER_MSEC, prevNanoTime);
         if (result <= 0) {
             if (result == 0) {
@@ -70,16 +81,18 @@ static int NET_ReadWithTimeout(JNIEnv *env, int fd, char *bufP, int len, long ti
         }
         result = NET_NonBlockingRead(fd, bufP, len);
         if (result == -1 && ((errno == EAGAIN) || (errno == EWOULDBLOCK))) {
-            jlong newtNanoTime = JVM_NanoTime(env, 0);
-            nanoTimeout -= newtNanoTime - prevNanoTime;
-            if (nanoTimeout >= NET_NSEC_PER_MSEC) {
-                prevNanoTime = newtNanoTime;
+            /* Spurious wakeup; poll again for the remaining time. */
+            jlong newNanoTime = JVM_NanoTime(env, 0);
+            nanoTimeout -= newNanoTime - prevNanoTime;
+            if (nanoTimeout < NET_NSEC_PER_MSEC) {
+                JNU_ThrowByName(env, "java/net/SocketTimeoutException", "Read timed out");
+                return -1;
             }
+            prevNanoTime = newNanoTime;
         } else {
-            break;
+            return result;
         }
     }
-    return result;
 }
 
 /*
@@ -37,7 +37,10 @@
 #include "nio_util.h"
 #include <dlfcn.h>
 
-#if defined(__linux__) || defined(__solaris__)
+#if defined(__linux__)
+#include <sys/sendfile.h>
+#include <sys/syscall.h>
+#elif defined(__solaris__)
 #include <sys/sendfile.h>
 #elif defined(_AIX)
 #include <sys/socket.h>
@@ -151,7 +154,33 @@ Java_sun_nio_ch_FileChannelImpl_transferTo0(JNIEnv *env, jobject this,
 
 #if defined(__linux__)
     off64_t offset = (off64_t)position;
-    jlong n = sendfile64(dstFD, srcFD, &offset, (size_t)count);
+    jlong n;
+#if defined(__NR_copy_file_range)
+    /* For a file target copy_file_range lets the filesystem share or
+     * offload the copy. It writes at the target's file position, as
+     * sendfile does, and the cases it rejects fall through to sendfile.
+     * A return of 0 also falls through: procfs, sysfs and other pseudo
+     * filesystems report 0 on some kernels even when data is available.
+     */
+    struct stat64 st;
+    if (fstat64(dstFD, &st) == 0 && S_ISREG(st.st_mode)) {
+        n = syscall(__NR_copy_file_range, srcFD, &offset, dstFD, NULL,
+                    (size_t)count, 0);
+        if (n > 0)
+            return n;
+        if (n < 0) {
+            if (errno == EINTR)
+                return IOS_INTERRUPTED;
+            if (errno != ENOSYS && errno != EXDEV && errno != EINVAL &&
+                errno != EOPNOTSUPP && errno != EBADF) {
+                JNU_ThrowIOExceptionWithLastError(env, "Transfer failed");
+                return IOS_THROWN;
+            }
+        }
+        offset = (off64_t)position;
+    }
+#endif
+    n = sendfile64(dstFD, srcFD, &offset, (size_t)count);
     if (n < 0) {
         if (errno == EAGAIN)
             return IOS_UNAVAILABLE;
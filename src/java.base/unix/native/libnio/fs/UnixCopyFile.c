@@ -30,6 +30,12 @@
 #include <unistd.h>
 #include <errno.h>
 
+#if defined(__linux__)
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/fs.h>
+#endif
+
 #include "sun_nio_fs_UnixCopyFile.h"
 
 #define RESTARTABLE(_cmd, _result) do { \
@@ -46,8 +52,68 @@ static void throwUnixException(JNIEnv* env, int errnum) {
     }
 }
 
+#if defined(__linux__)
+
+/*
+ * Errors after which copying in the kernel is not possible for this pair
+ * of files, but a copy through user-space buffers is.
+ */
+static int kernelCopyUnsupported(int errnum) {
+    return errnum == ENOSYS || errnum == EXDEV || errnum == EINVAL ||
+           errnum == EOPNOTSUPP || errnum == ENOTTY || errnum == EBADF;
+}
+
+/**
+ * Transfer all bytes from src to dst without copying them through user
+ * space: first try to share the extents (reflink) where the filesystem
+ * supports it, then copy_file_range. Both start at the current file
+ * offsets. Returns 0 when done, 1 if the caller should fall back to the
+ * user-space copy from the current offsets, and -1 with a pending
+ * exception on error.
+ */
+static int kernelTransfer(JNIEnv* env, int dst, int src, volatile jint* cancel)
+{
+#if defined(FICLONE)
+    if (lseek(src, 0, SEEK_CUR) == 0 && ioctl(dst, FICLONE, src) == 0) {
+        return 0;
+    }
+#endif
+#if defined(__NR_copy_file_range)
+    jlong copied = 0;
+    for (;;) {
+        ssize_t n;
+        RESTARTABLE(syscall(__NR_copy_file_range, src, NULL, dst, NULL,
+                            (size_t)(1 << 30), 0), n);
+        if (n == 0) {
+            /* procfs, sysfs and other pseudo filesystems report 0 on some
+             * kernels even when data is available, so only trust it as
+             * end of file once something has been copied. The offsets
+             * are unchanged otherwise, so the caller can copy through
+             * user space instead. */
+            return (copied > 0) ? 0 : 1;
+        }
+        if (n < 0) {
+            if (kernelCopyUnsupported(errno))
+                return 1;
+            throwUnixException(env, errno);
+            return -1;
+        }
+        copied += n;
+        if (cancel != NULL && *cancel != 0) {
+            throwUnixException(env, ECANCELED);
+            return -1;
+        }
+    }
+#else
+    return 1;
+#endif
+}
+
+#endif
+
 /**
- * Transfer all bytes from src to dst via user-space buffers
+ * Transfer all bytes from src to dst, in the kernel where possible and
+ * via user-space buffers otherwise
  */
 JNIEXPORT void JNICALL
 Java_sun_nio_fs_UnixCopyFile_transfer
@@ -56,6 +122,12 @@ Java_sun_nio_fs_UnixCopyFile_transfer
     char buf[8192];
     volatile jint* cancel = (jint*)jlong_to_ptr(cancelAddress);
 
+#if defined(__linux__)
+    if (kernelTransfer(env, (int)dst, (int)src, cancel) <= 0) {
+        return;
+    }
+#endif
+
     for (;;) {
         ssize_t n, pos, len;
         RESTARTABLE(read((int)src, &buf, sizeof(buf)), n);
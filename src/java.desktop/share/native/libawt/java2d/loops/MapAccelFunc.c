@@ -23,7 +23,51 @@
  * questions.
  */
 
+#include <stdlib.h>
 #include "GraphicsPrimitiveMgr.h"
+#include "SSELoops.h"
+
+#ifdef J2D_SSE2_LOOPS
+
+typedef struct {
+    AnyFunc  *func_c;
+    AnyFunc  *func_sse2;
+} AnyFunc_pair;
+
+static AnyFunc_pair sse2_func_pair_array[] = {
+    { (AnyFunc *) &IntArgbPreSrcOverMaskFill,
+      (AnyFunc *) &IntArgbPreSrcOverMaskFill_SSE2 },
+    { (AnyFunc *) &IntArgbPreToIntArgbPreSrcOverMaskBlit,
+      (AnyFunc *) &IntArgbPreToIntArgbPreSrcOverMaskBlit_SSE2 },
+};
+
+#define NUM_SSE2_FUNCS \
+    (sizeof(sse2_func_pair_array) / sizeof(sse2_func_pair_array[0]))
+
+/*
+ * Maps the C loops that have SSE2 versions to those versions, unless
+ * the J2D_USE_SSE2_LOOPS environment variable starts with 'f' or 'F'.
+ */
+AnyFunc *MapAccelFunction(AnyFunc *c_func) {
+    static int usesse2 = -1;
+    size_t i;
+
+    if (usesse2 < 0) {
+        char *sse2_env = getenv("J2D_USE_SSE2_LOOPS");
+        usesse2 = !(sse2_env != NULL &&
+                    (*sse2_env == 'f' || *sse2_env == 'F'));
+    }
+    if (usesse2) {
+        for (i = 0; i < NUM_SSE2_FUNCS; i++) {
+            if (sse2_func_pair_array[i].func_c == c_func) {
+                return sse2_func_pair_array[i].func_sse2;
+            }
+        }
+    }
+    return c_func;
+}
+
+#else /* J2D_SSE2_LOOPS */
 
 /*
  * This is a dummy function that satisfies the MapAccelFunction
@@ -35,3 +79,5 @@
 AnyFunc *MapAccelFunction(AnyFunc *c_func) {
     return c_func;
 }
+
+#endif /* J2D_SSE2_LOOPS */
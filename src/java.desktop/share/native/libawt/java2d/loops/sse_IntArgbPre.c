@@ -0,0 +1,248 @@
+/*
+ * Copyright (c) 2018, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+#include "SSELoops.h"
+
+#ifdef J2D_SSE2_LOOPS
+
+#include <string.h>
+#include <emmintrin.h>
+
+#include "AlphaMath.h"
+#include "IntArgbPre.h"
+
+/*
+ * The loops below work on 4 pixels at a time, each unpacked into 16 bit
+ * lanes as two vectors of 2 pixels.  Every IntArgbPre SrcOver result has
+ * the form
+ *
+ *     res = MUL8(f, src) + MUL8(0xff - MUL8(f, srcA), dst)
+ *
+ * for all four components, where f is the path (and extra) alpha of the
+ * pixel.  MUL8 is computed as ((t + (t >> 8)) >> 8) with t = a * b + 128,
+ * which matches mul8table for every pair of operands.
+ */
+
+static __m128i
+mul8_epi16(__m128i a, __m128i b)
+{
+    __m128i t = _mm_add_epi16(_mm_mullo_epi16(a, b), _mm_set1_epi16(128));
+    return _mm_srli_epi16(_mm_add_epi16(t, _mm_srli_epi16(t, 8)), 8);
+}
+
+/* Copies the alpha lane of each pixel into its other three lanes */
+static __m128i
+broadcast_alpha_epi16(__m128i v)
+{
+    v = _mm_shufflelo_epi16(v, _MM_SHUFFLE(3, 3, 3, 3));
+    return _mm_shufflehi_epi16(v, _MM_SHUFFLE(3, 3, 3, 3));
+}
+
+/* Widens 4 mask bytes into a per-component byte mask for 4 pixels */
+static __m128i
+expand_mask(const jubyte *pMask)
+{
+    jint m;
+    __m128i v;
+
+    memcpy(&m, pMask, sizeof(m));
+    v = _mm_cvtsi32_si128(m);
+    v = _mm_unpacklo_epi8(v, v);
+    return _mm_unpacklo_epi16(v, v);
+}
+
+/*
+ * Composites 4 pixels of (premultiplied) src over dst with the per
+ * component factors in f, which are bytes in the layout of expand_mask.
+ */
+static __m128i
+srcover_4(__m128i src, __m128i dst, __m128i f)
+{
+    __m128i zero = _mm_setzero_si128();
+    __m128i ff = _mm_set1_epi16(0xff);
+    __m128i lo, hi, dstF;
+
+    lo = mul8_epi16(_mm_unpacklo_epi8(f, zero), _mm_unpacklo_epi8(src, zero));
+    dstF = _mm_sub_epi16(ff, broadcast_alpha_epi16(lo));
+    lo = _mm_add_epi16(lo, mul8_epi16(dstF, _mm_unpacklo_epi8(dst, zero)));
+
+    hi = mul8_epi16(_mm_unpackhi_epi8(f, zero), _mm_unpackhi_epi8(src, zero));
+    dstF = _mm_sub_epi16(ff, broadcast_alpha_epi16(hi));
+    hi = _mm_add_epi16(hi, mul8_epi16(dstF, _mm_unpackhi_epi8(dst, zero)));
+
+    return _mm_packus_epi16(lo, hi);
+}
+
+/* Scalar form of srcover_4 for a single pixel */
+static juint
+srcover_1(juint src, juint dst, jint f)
+{
+    jint resA = MUL8(f, src >> 24);
+    jint dstF = 0xff - resA;
+    jint resR = MUL8(f, (src >> 16) & 0xff) + MUL8(dstF, (dst >> 16) & 0xff);
+    jint resG = MUL8(f, (src >>  8) & 0xff) + MUL8(dstF, (dst >>  8) & 0xff);
+    jint resB = MUL8(f, (src      ) & 0xff) + MUL8(dstF, (dst      ) & 0xff);
+
+    resA += MUL8(dstF, dst >> 24);
+    return (resA << 24) | (resR << 16) | (resG << 8) | resB;
+}
+
+void IntArgbPreSrcOverMaskFill_SSE2
+    (void *rasBase,
+     jubyte *pMask, jint maskOff, jint maskScan,
+     jint width, jint height,
+     jint fgColor,
+     SurfaceDataRasInfo *pRasInfo,
+     NativePrimitive *pPrim,
+     CompositeInfo *pCompInfo)
+{
+    jint rasScan = pRasInfo->scanStride;
+    jint srcA = ((juint) fgColor) >> 24;
+    jint srcR = (fgColor >> 16) & 0xff;
+    jint srcG = (fgColor >>  8) & 0xff;
+    jint srcB = (fgColor      ) & 0xff;
+    juint srcPixel;
+    __m128i src;
+
+    if (srcA == 0) {
+        return;
+    }
+    if (srcA != 0xff) {
+        srcR = MUL8(srcA, srcR);
+        srcG = MUL8(srcA, srcG);
+        srcB = MUL8(srcA, srcB);
+    }
+    srcPixel = (srcA << 24) | (srcR << 16) | (srcG << 8) | srcB;
+    src = _mm_set1_epi32(srcPixel);
+
+    if (pMask) {
+        pMask += maskOff;
+    }
+    do {
+        juint *pRas = (juint *) rasBase;
+        jint x = 0;
+
+        if (pMask) {
+            for (; x + 4 <= width; x += 4) {
+                __m128i f = expand_mask(pMask + x);
+                __m128i dst;
+
+                if (_mm_movemask_epi8(_mm_cmpeq_epi8(f, _mm_setzero_si128()))
+                    == 0xffff)
+                {
+                    continue;
+                }
+                dst = _mm_loadu_si128((__m128i *) (pRas + x));
+                _mm_storeu_si128((__m128i *) (pRas + x),
+                                 srcover_4(src, dst, f));
+            }
+            for (; x < width; x++) {
+                jint pathA = pMask[x];
+                if (pathA) {
+                    pRas[x] = srcover_1(srcPixel, pRas[x], pathA);
+                }
+            }
+            pMask = PtrAddBytes(pMask, maskScan);
+        } else {
+            __m128i f = _mm_set1_epi8((char) 0xff);
+            for (; x + 4 <= width; x += 4) {
+                __m128i dst = _mm_loadu_si128((__m128i *) (pRas + x));
+                _mm_storeu_si128((__m128i *) (pRas + x),
+                                 srcover_4(src, dst, f));
+            }
+            for (; x < width; x++) {
+                pRas[x] = srcover_1(srcPixel, pRas[x], 0xff);
+            }
+        }
+        rasBase = PtrAddBytes(rasBase, rasScan);
+    } while (--height > 0);
+}
+
+void IntArgbPreToIntArgbPreSrcOverMaskBlit_SSE2
+    (void *dstBase, void *srcBase,
+     jubyte *pMask, jint maskOff, jint maskScan,
+     jint width, jint height,
+     SurfaceDataRasInfo *pDstInfo,
+     SurfaceDataRasInfo *pSrcInfo,
+     NativePrimitive *pPrim,
+     CompositeInfo *pCompInfo)
+{
+    DeclareAndInitExtraAlphaFor4ByteArgb(extraA)
+    jint srcScan = pSrcInfo->scanStride;
+    jint dstScan = pDstInfo->scanStride;
+    __m128i zero = _mm_setzero_si128();
+    __m128i extra = _mm_set1_epi16((short) extraA);
+
+    if (pMask) {
+        pMask += maskOff;
+    }
+    do {
+        juint *pSrc = (juint *) srcBase;
+        juint *pDst = (juint *) dstBase;
+        jint x = 0;
+
+        for (; x + 4 <= width; x += 4) {
+            __m128i src = _mm_loadu_si128((__m128i *) (pSrc + x));
+            __m128i dst, f, res, keep;
+
+            if (pMask) {
+                f = expand_mask(pMask + x);
+                if (extraA < 0xff) {
+                    f = _mm_packus_epi16(
+                            mul8_epi16(_mm_unpacklo_epi8(f, zero), extra),
+                            mul8_epi16(_mm_unpackhi_epi8(f, zero), extra));
+                }
+            } else {
+                f = _mm_set1_epi8((char) extraA);
+            }
+            dst = _mm_loadu_si128((__m128i *) (pDst + x));
+            res = srcover_4(src, dst, f);
+            /*
+             * The C loop leaves pixels whose effective source alpha,
+             * MUL8(f, srcA), is 0 untouched.  The alphas sit in the low
+             * 16 bits of each 32 bit lane, so mul8_epi16 works on them.
+             */
+            keep = _mm_cmpeq_epi32(mul8_epi16(_mm_srli_epi32(f, 24),
+                                              _mm_srli_epi32(src, 24)),
+                                   zero);
+            res = _mm_or_si128(_mm_and_si128(keep, dst),
+                               _mm_andnot_si128(keep, res));
+            _mm_storeu_si128((__m128i *) (pDst + x), res);
+        }
+        for (; x < width; x++) {
+            jint pathA = pMask ? MUL8(pMask[x], extraA) : extraA;
+            if (MUL8(pathA, pSrc[x] >> 24)) {
+                pDst[x] = srcover_1(pSrc[x], pDst[x], pathA);
+            }
+        }
+        if (pMask) {
+            pMask = PtrAddBytes(pMask, maskScan);
+        }
+        srcBase = PtrAddBytes(srcBase, srcScan);
+        dstBase = PtrAddBytes(dstBase, dstScan);
+    } while (--height > 0);
+}
+
+#endif /* J2D_SSE2_LOOPS */
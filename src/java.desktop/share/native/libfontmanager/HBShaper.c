@@ -25,6 +25,7 @@
 
 #include <jni_util.h>
 #include <stdlib.h>
+#include <string.h>
 #include "hb.h"
 #include "hb-jdk.h"
 #include "hb-ot.h"
@@ -218,6 +219,8 @@ JDKFontInfo*
     fi->nativeFont = pNativeFont;
     fi->layoutTables = (TTLayoutTableCache*)layoutTables;
     fi->aat = aat;
+    memset(fi->charCacheValid, 0, sizeof(fi->charCacheValid));
+    memset(fi->advCacheValid, 0, sizeof(fi->advCacheValid));
     (*env)->GetFloatArrayRegion(env, matrix, 0, 4, fi->matrix);
     fi->ptSize = ptSize;
     fi->xPtSize = euclidianDistance(fi->matrix[0], fi->matrix[1]);
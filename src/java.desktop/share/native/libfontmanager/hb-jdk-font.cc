@@ -49,12 +49,23 @@ hb_jdk_get_glyph (hb_font_t *font HB_UNUSED,
     JNIEnv* env = jdkFontInfo->env;
     jobject font2D = jdkFontInfo->font2D;
     hb_codepoint_t u = (variation_selector==0) ? unicode : variation_selector;
+    unsigned int slot = u % JDK_CACHE_SIZE;
 
+    if (JDK_CACHE_IS_VALID(jdkFontInfo->charCacheValid, slot) &&
+        jdkFontInfo->charCacheKeys[slot] == u) {
+        *glyph = jdkFontInfo->charCacheGlyphs[slot];
+        return (*glyph != 0);
+    }
     *glyph = (hb_codepoint_t)
           env->CallIntMethod(font2D, sunFontIDs.f2dCharToGlyphMID, u);
     if ((int)*glyph < 0) {
         *glyph = 0;
     }
+    if (!env->ExceptionCheck()) {
+        JDK_CACHE_SET_VALID(jdkFontInfo->charCacheValid, slot);
+        jdkFontInfo->charCacheKeys[slot] = u;
+        jdkFontInfo->charCacheGlyphs[slot] = *glyph;
+    }
     return (*glyph != 0);
 }
 
@@ -71,6 +82,12 @@ hb_jdk_get_glyph_h_advance (hb_font_t *font HB_UNUSED,
     }
 
     JDKFontInfo *jdkFontInfo = (JDKFontInfo*)font_data;
+    unsigned int slot = glyph % JDK_CACHE_SIZE;
+    if (JDK_CACHE_IS_VALID(jdkFontInfo->advCacheValid, slot) &&
+        jdkFontInfo->advCacheKeys[slot] == glyph) {
+        return jdkFontInfo->advCacheValues[slot];
+    }
+
     JNIEnv* env = jdkFontInfo->env;
     jobject fontStrike = jdkFontInfo->fontStrike;
     jobject pt = env->CallObjectMethod(fontStrike,
@@ -83,7 +100,10 @@ hb_jdk_get_glyph_h_advance (hb_font_t *font HB_UNUSED,
     fadv *= jdkFontInfo->devScale;
     env->DeleteLocalRef(pt);
 
-    return HBFloatToFixed(fadv);
+    JDK_CACHE_SET_VALID(jdkFontInfo->advCacheValid, slot);
+    jdkFontInfo->advCacheKeys[slot] = glyph;
+    jdkFontInfo->advCacheValues[slot] = HBFloatToFixed(fadv);
+    return jdkFontInfo->advCacheValues[slot];
 }
 
 static hb_position_t
@@ -35,6 +35,19 @@
 extern "C" {
 #endif
 
+/*
+ * Direct mapped caches of the char to glyph and glyph advance lookups
+ * made during one shaping call, so that repeated characters in a run do
+ * not each call back into Java. A slot is used only once its bit is set
+ * in the cache's valid bitmap, so starting a shaping call clears just
+ * the bitmaps rather than the slots.
+ */
+#define JDK_CACHE_SIZE  256
+#define JDK_CACHE_IS_VALID(valid, slot) \
+    (((valid)[(slot) >> 3] >> ((slot) & 7)) & 1)
+#define JDK_CACHE_SET_VALID(valid, slot) \
+    ((valid)[(slot) >> 3] |= (unsigned char)(1 << ((slot) & 7)))
+
 typedef struct JDKFontInfo_Struct {
     JNIEnv* env;
     jobject font2D;
@@ -47,6 +60,12 @@ typedef struct JDKFontInfo_Struct {
     float yPtSize;
     float devScale; // How much applying the full glyph tx scales x distance.
     jboolean aat;
+    unsigned char charCacheValid[JDK_CACHE_SIZE / 8];
+    unsigned char advCacheValid[JDK_CACHE_SIZE / 8];
+    hb_codepoint_t charCacheKeys[JDK_CACHE_SIZE];
+    hb_codepoint_t charCacheGlyphs[JDK_CACHE_SIZE];
+    hb_codepoint_t advCacheKeys[JDK_CACHE_SIZE];
+    hb_position_t advCacheValues[JDK_CACHE_SIZE];
 } JDKFontInfo;
 
 
@@ -109,6 +109,73 @@ build_ycc_rgb_table (j_decompress_ptr cinfo)
 }
 
 
+#if (defined(__SSE2__) || defined(_M_X64)) && \
+    BITS_IN_JSAMPLE == 8 && RGB_PIXELSIZE == 3
+#define YCC_RGB_SSE2
+
+#include <emmintrin.h>
+
+/*
+ * SSE2 conversion of 16 pixels, producing the same output as the table
+ * lookups in ycc_rgb_convert.  It works in 16-bit lanes, with the
+ * constants split so that every product fits a signed 16-bit multiply:
+ *      FIX(1.40200) =  65536 + 26345
+ *      FIX(1.77200) = 131072 - 14942
+ *      FIX(0.71414) =  65536 - 18734
+ * For a 32-bit product p, (p + ONE_HALF) >> 16 is computed as
+ * ((p >> 15) + 1) >> 1, where p >> 15 is mulhi(2 * x, c).  The G term
+ * sums two products before rounding, so it is done in 32 bits.
+ * The range limit table clamps to 0..MAXJSAMPLE for every sum that can
+ * occur here, which is what the saturating pack does.
+ */
+
+LOCAL(void)
+ycc_rgb_convert_16 (__m128i y, __m128i cb, __m128i cr,
+                    __m128i * r, __m128i * g, __m128i * b)
+{
+  const __m128i one = _mm_set1_epi16(1);
+  const __m128i half = _mm_set1_epi32(ONE_HALF);
+  const __m128i cgcoef = _mm_set_epi16(18734, -22554, 18734, -22554,
+                                       18734, -22554, 18734, -22554);
+  const __m128i zero = _mm_setzero_si128();
+  const __m128i center = _mm_set1_epi16(CENTERJSAMPLE);
+  __m128i res[3][2];
+  int i;
+
+  for (i = 0; i < 2; i++) {
+    __m128i y16, x_b, x_r, rt, bt, gt, glo, ghi;
+
+    if (i == 0) {
+      y16 = _mm_unpacklo_epi8(y, zero);
+      x_b = _mm_sub_epi16(_mm_unpacklo_epi8(cb, zero), center);
+      x_r = _mm_sub_epi16(_mm_unpacklo_epi8(cr, zero), center);
+    } else {
+      y16 = _mm_unpackhi_epi8(y, zero);
+      x_b = _mm_sub_epi16(_mm_unpackhi_epi8(cb, zero), center);
+      x_r = _mm_sub_epi16(_mm_unpackhi_epi8(cr, zero), center);
+    }
+    rt = _mm_mulhi_epi16(_mm_add_epi16(x_r, x_r), _mm_set1_epi16(26345));
+    rt = _mm_add_epi16(x_r, _mm_srai_epi16(_mm_add_epi16(rt, one), 1));
+    bt = _mm_mulhi_epi16(_mm_add_epi16(x_b, x_b), _mm_set1_epi16(-14942));
+    bt = _mm_add_epi16(_mm_add_epi16(x_b, x_b),
+                       _mm_srai_epi16(_mm_add_epi16(bt, one), 1));
+    glo = _mm_madd_epi16(_mm_unpacklo_epi16(x_b, x_r), cgcoef);
+    ghi = _mm_madd_epi16(_mm_unpackhi_epi16(x_b, x_r), cgcoef);
+    gt = _mm_packs_epi32(_mm_srai_epi32(_mm_add_epi32(glo, half), SCALEBITS),
+                         _mm_srai_epi32(_mm_add_epi32(ghi, half), SCALEBITS));
+    gt = _mm_sub_epi16(gt, x_r);
+    res[0][i] = _mm_add_epi16(y16, rt);
+    res[1][i] = _mm_add_epi16(y16, gt);
+    res[2][i] = _mm_add_epi16(y16, bt);
+  }
+  *r = _mm_packus_epi16(res[0][0], res[0][1]);
+  *g = _mm_packus_epi16(res[1][0], res[1][1]);
+  *b = _mm_packus_epi16(res[2][0], res[2][1]);
+}
+
+#endif /* YCC_RGB_SSE2 */
+
+
 /*
  * Convert some rows of samples to the output colorspace.
  *
@@ -137,6 +204,10 @@ ycc_rgb_convert (j_decompress_ptr cinfo,
   register int * Cbbtab = cconvert->Cb_b_tab;
   register INT32 * Crgtab = cconvert->Cr_g_tab;
   register INT32 * Cbgtab = cconvert->Cb_g_tab;
+#ifdef YCC_RGB_SSE2
+  JSAMPLE rgb[3][16];
+  int i;
+#endif
   SHIFT_TEMPS
 
   while (--num_rows >= 0) {
@@ -145,7 +216,27 @@ ycc_rgb_convert (j_decompress_ptr cinfo,
     inptr2 = input_buf[2][input_row];
     input_row++;
     outptr = *output_buf++;
-    for (col = 0; col < num_cols; col++) {
+    col = 0;
+#ifdef YCC_RGB_SSE2
+    for (; col + 16 <= num_cols; col += 16) {
+      __m128i r, g, b;
+
+      ycc_rgb_convert_16(_mm_loadu_si128((__m128i *) (inptr0 + col)),
+                         _mm_loadu_si128((__m128i *) (inptr1 + col)),
+                         _mm_loadu_si128((__m128i *) (inptr2 + col)),
+                         &r, &g, &b);
+      _mm_storeu_si128((__m128i *) rgb[0], r);
+      _mm_storeu_si128((__m128i *) rgb[1], g);
+      _mm_storeu_si128((__m128i *) rgb[2], b);
+      for (i = 0; i < 16; i++) {
+        outptr[RGB_RED] =   rgb[0][i];
+        outptr[RGB_GREEN] = rgb[1][i];
+        outptr[RGB_BLUE] =  rgb[2][i];
+        outptr += RGB_PIXELSIZE;
+      }
+    }
+#endif
+    for (; col < num_cols; col++) {
       y  = GETJSAMPLE(inptr0[col]);
       cb = GETJSAMPLE(inptr1[col]);
       cr = GETJSAMPLE(inptr2[col]);
@@ -622,6 +622,13 @@ JNIEXPORT void JNICALL Java_sun_java2d_cmm_lcms_LCMS_colorConvert
 
     if (srcAtOnce && dstAtOnce) {
         cmsDoTransform(sTrans, inputRow, outputRow, width * height);
+    } else if (srcNextRowOffset >= 0 && dstNextRowOffset >= 0) {
+        /* Let lcms step over the rows itself, keeping its pixel cache
+         * across rows. The plane strides match those of cmsDoTransform.
+         */
+        cmsDoTransformLineStride(sTrans, inputRow, outputRow, width, height,
+                                 srcNextRowOffset, dstNextRowOffset,
+                                 width, width);
     } else {
         for (i = 0; i < height; i++) {
             cmsDoTransform(sTrans, inputRow, outputRow, width);
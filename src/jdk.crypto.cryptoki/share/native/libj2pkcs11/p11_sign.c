@@ -109,8 +109,9 @@ JNIEXPORT jbyteArray JNICALL Java_sun_security_pkcs11_wrapper_PKCS11_C_1Sign
     CK_SESSION_HANDLE ckSessionHandle;
     CK_BYTE_PTR ckpData = NULL_PTR;
     CK_BYTE_PTR ckpSignature;
+    CK_BYTE BUF[MAX_STACK_BUFFER_LEN];
     CK_ULONG ckDataLength;
-    CK_ULONG ckSignatureLength = 0;
+    CK_ULONG ckSignatureLength;
     jbyteArray jSignature = NULL;
     CK_RV rv;
 
@@ -121,39 +122,14 @@ JNIEXPORT jbyteArray JNICALL Java_sun_security_pkcs11_wrapper_PKCS11_C_1Sign
     jByteArrayToCKByteArray(env, jData, &ckpData, &ckDataLength);
     if ((*env)->ExceptionCheck(env)) { return NULL; }
 
-    /* START standard code */
-
-    /* first determine the length of the signature */
-    rv = (*ckpFunctions->C_Sign)(ckSessionHandle, ckpData, ckDataLength, NULL_PTR, &ckSignatureLength);
-    if (ckAssertReturnValueOK(env, rv) != CK_ASSERT_OK) {
-        free(ckpData);
-        return NULL;
-    }
-
-    ckpSignature = (CK_BYTE_PTR) malloc(ckSignatureLength * sizeof(CK_BYTE));
-    if (ckpSignature == NULL) {
-        free(ckpData);
-        throwOutOfMemoryError(env, 0);
-        return NULL;
-    }
-
-    /* now get the signature */
+    /* Try a buffer that fits any common signature first, so that a
+     * token only has to be asked for the length when it does not fit.
+     * For HSMs the extra C_Sign round trip is the dominant cost.
+     */
+    ckpSignature = BUF;
+    ckSignatureLength = MAX_STACK_BUFFER_LEN;
     rv = (*ckpFunctions->C_Sign)(ckSessionHandle, ckpData, ckDataLength, ckpSignature, &ckSignatureLength);
- /* END standard code */
-
-
-    /* START workaround code for operation abort bug in pkcs#11 of Datakey and iButton */
-/*
-    ckpSignature = (CK_BYTE_PTR) malloc(256 * sizeof(CK_BYTE));
-    if (ckpSignature == NULL) {
-        free(ckpData);
-        throwOutOfMemoryError(env, 0);
-        return NULL;
-    }
-    rv = (*ckpFunctions->C_Sign)(ckSessionHandle, ckpData, ckDataLength, ckpSignature, &ckSignatureLength);
-
     if (rv == CKR_BUFFER_TOO_SMALL) {
-        free(ckpSignature);
         ckpSignature = (CK_BYTE_PTR) malloc(ckSignatureLength * sizeof(CK_BYTE));
         if (ckpSignature == NULL) {
             free(ckpData);
@@ -162,13 +138,11 @@ JNIEXPORT jbyteArray JNICALL Java_sun_security_pkcs11_wrapper_PKCS11_C_1Sign
         }
         rv = (*ckpFunctions->C_Sign)(ckSessionHandle, ckpData, ckDataLength, ckpSignature, &ckSignatureLength);
     }
- */
-    /* END workaround code */
     if (ckAssertReturnValueOK(env, rv) == CK_ASSERT_OK) {
         jSignature = ckByteArrayToJByteArray(env, ckpSignature, ckSignatureLength);
     }
     free(ckpData);
-    free(ckpSignature);
+    if (ckpSignature != BUF) { free(ckpSignature); }
 
     return jSignature ;
 }
@@ -387,6 +387,28 @@ ec_GFp_nistp256_mod(const mp_int *a, mp_int *r, const GFMethod *meth)
         return res;
 }
 
+/* Number of digits in a reduced p256 field element, and the size of a
+ * product of two of them. */
+#define P256_DIGITS      ECL_CURVE_DIGITS(256)
+#define P256_PROD_DIGITS (2 * P256_DIGITS)
+
+/* Set up t as a temporary whose digits live in the caller's buf of
+ * P256_PROD_DIGITS digits. mp_mul and mp_sqr copy an operand to a fresh
+ * heap allocation whenever the result overwrites it, which is how the
+ * point arithmetic calls field_mul and field_sqr; computing the product
+ * into t and reducing from there into r avoids that allocation. t must
+ * not be passed to mp_clear. */
+static void
+ec_GFp_nistp256_tmp(const mp_int *a, mp_int *t, mp_digit *buf)
+{
+        MP_FLAG(t) = MP_FLAG(a);
+        MP_SIGN(t) = MP_ZPOS;
+        MP_ALLOC(t) = P256_PROD_DIGITS;
+        MP_USED(t) = 1;
+        MP_DIGITS(t) = buf;
+        buf[0] = 0;
+}
+
 /* Compute the square of polynomial a, reduce modulo p256. Store the
  * result in r.  r could be a.  Uses optimized modular reduction for p256.
  */
@@ -394,10 +416,23 @@ mp_err
 ec_GFp_nistp256_sqr(const mp_int *a, mp_int *r, const GFMethod *meth)
 {
         mp_err res = MP_OKAY;
+        mp_digit buf[P256_PROD_DIGITS];
+        mp_int t;
 
-        MP_CHECKOK(mp_sqr(a, r));
-        MP_CHECKOK(ec_GFp_nistp256_mod(r, r, meth));
+        MP_DIGITS(&t) = NULL;
+        if (MP_USED(a) <= P256_DIGITS) {
+                ec_GFp_nistp256_tmp(a, &t, buf);
+                MP_CHECKOK(mp_sqr(a, &t));
+                MP_CHECKOK(ec_GFp_nistp256_mod(&t, r, meth));
+        } else {
+                MP_CHECKOK(mp_sqr(a, r));
+                MP_CHECKOK(ec_GFp_nistp256_mod(r, r, meth));
+        }
   CLEANUP:
+        /* The product is as sensitive as the operands; clear it as
+         * mp_clear does for heap digits. */
+        if (MP_DIGITS(&t) == buf)
+                s_mp_setz(buf, P256_PROD_DIGITS);
         return res;
 }
 
@@ -409,10 +444,23 @@ ec_GFp_nistp256_mul(const mp_int *a, const mp_int *b, mp_int *r,
                                         const GFMethod *meth)
 {
         mp_err res = MP_OKAY;
+        mp_digit buf[P256_PROD_DIGITS];
+        mp_int t;
 
-        MP_CHECKOK(mp_mul(a, b, r));
-        MP_CHECKOK(ec_GFp_nistp256_mod(r, r, meth));
+        MP_DIGITS(&t) = NULL;
+        if (MP_USED(a) <= P256_DIGITS && MP_USED(b) <= P256_DIGITS) {
+                ec_GFp_nistp256_tmp(a, &t, buf);
+                MP_CHECKOK(mp_mul(a, b, &t));
+                MP_CHECKOK(ec_GFp_nistp256_mod(&t, r, meth));
+        } else {
+                MP_CHECKOK(mp_mul(a, b, r));
+                MP_CHECKOK(ec_GFp_nistp256_mod(r, r, meth));
+        }
   CLEANUP:
+        /* The product is as sensitive as the operands; clear it as
+         * mp_clear does for heap digits. */
+        if (MP_DIGITS(&t) == buf)
+                s_mp_setz(buf, P256_PROD_DIGITS);
         return res;
 }
 
@@ -78,6 +78,8 @@ typedef struct ps_prochandle_ops {
 
 struct core_data {
    int                core_fd;   // file descriptor of core file
+   char*              core_map;  // core file mapped read-only, NULL if not mapped
+   size_t             core_map_size; // size of the core_map mapping
    int                exec_fd;   // file descriptor of exec file
    int                interp_fd; // file descriptor of interpreter (ld-linux.so.2)
    // part of the class sharing workaround
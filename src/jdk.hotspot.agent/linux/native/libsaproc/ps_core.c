@@ -30,6 +30,8 @@
 #include <stddef.h>
 #include <elf.h>
 #include <link.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 #include "libproc_impl.h"
 #include "salibelf.h"
 
@@ -44,7 +46,9 @@
 static void close_files(struct ps_prochandle* ph) {
   lib_info* lib = NULL;
 
-  // close core file descriptor
+  // unmap and close core file
+  if (ph->core->core_map != NULL)
+    munmap(ph->core->core_map, ph->core->core_map_size);
   if (ph->core->core_fd >= 0)
     close(ph->core->core_fd);
 
@@ -458,6 +462,27 @@ static bool sort_map_array(struct ps_prochandle* ph) {
   return true;
 }
 
+// Map the whole core file read-only so that reads from core segments,
+// which the SA issues a few bytes at a time while walking the heap, are
+// memory copies instead of a pread system call each. If the file can't
+// be mapped (e.g. not enough address space) reads fall back to pread.
+static void map_core_file(struct ps_prochandle* ph) {
+  struct stat st;
+  void* addr;
+
+  if (fstat(ph->core->core_fd, &st) != 0 || st.st_size <= 0 ||
+      (unsigned long long) st.st_size > (size_t) -1) {
+    return;
+  }
+  addr = mmap(NULL, (size_t) st.st_size, PROT_READ, MAP_PRIVATE, ph->core->core_fd, 0);
+  if (addr == MAP_FAILED) {
+    print_debug("can't map core file, using pread\n");
+    return;
+  }
+  ph->core->core_map = (char*) addr;
+  ph->core->core_map_size = (size_t) st.st_size;
+}
+
 #ifndef MIN
 #define MIN(x, y) (((x) < (y))? (x): (y))
 #endif
@@ -481,7 +506,10 @@ static bool core_read_data(struct ps_prochandle* ph, uintptr_t addr, char *buf,
       len = MIN(resid, mp->memsz - mapoff);
       off = mp->offset + mapoff;
 
-      if ((len = pread(fd, buf, len, off)) <= 0) {
+      if (fd == ph->core->core_fd && ph->core->core_map != NULL &&
+          off >= 0 && (size_t) off + len <= ph->core->core_map_size) {
+         memcpy(buf, ph->core->core_map + off, len);
+      } else if ((len = pread(fd, buf, len, off)) <= 0) {
          break;
       }
 
@@ -1044,6 +1072,8 @@ Pgrab_core(const char* exec_file, const char* core_file) {
     goto err;
   }
 
+  map_core_file(ph);
+
   if ((ph->core->exec_fd = open(exec_file, O_RDONLY)) < 0) {
     print_debug("can't open executable file\n");
     goto err;
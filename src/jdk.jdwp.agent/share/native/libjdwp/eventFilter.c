@@ -604,6 +604,30 @@ eventFilterRestricted_passesUnloadFilter(JNIEnv *env,
     return JNI_TRUE;
 }
 
+/**
+ * Return true if passing the filters of the given node requires
+ * the name of the event class, i.e. it has a ClassMatch or
+ * ClassExclude modifier. Lets the caller skip fetching and
+ * converting the class signature for nodes that never look at it.
+ */
+jboolean
+eventFilterRestricted_needsClassname(HandlerNode *node)
+{
+    Filter *filter = FILTERS_ARRAY(node);
+    int i;
+
+    for (i = 0; i < FILTER_COUNT(node); ++i, ++filter) {
+        switch (filter->modifier) {
+            case JDWP_REQUEST_MODIFIER(ClassMatch):
+            case JDWP_REQUEST_MODIFIER(ClassExclude):
+                return JNI_TRUE;
+            default:
+                break;
+        }
+    }
+    return JNI_FALSE;
+}
+
 /**
  * This function returns true only if it is certain that
  * all events for the given node in the given stack frame will
@@ -636,6 +636,7 @@ event_callback(JNIEnv *env, EventInfo *evinfo)
     {
         HandlerNode *node;
         char        *classname;
+        jboolean     haveClassname;
 
         /* We must keep track of all classes prepared to know what's unloaded */
         if (evinfo->ei == EI_CLASS_PREPARE) {
@@ -643,13 +644,22 @@ event_callback(JNIEnv *env, EventInfo *evinfo)
         }
 
         node = getHandlerChain(evinfo->ei)->first;
-        classname = getClassname(evinfo->clazz);
+
+        /* The class name is only looked up once a handler with a
+         * class pattern filter needs it.
+         */
+        classname = NULL;
+        haveClassname = JNI_FALSE;
 
         while (node != NULL) {
             /* save next so handlers can remove themselves */
             HandlerNode *next = NEXT(node);
             jboolean shouldDelete;
 
+            if (!haveClassname && eventFilterRestricted_needsClassname(node)) {
+                classname = getClassname(evinfo->clazz);
+                haveClassname = JNI_TRUE;
+            }
             if (eventFilterRestricted_passesFilter(env, classname,
                                                    evinfo, node,
                                                    &shouldDelete)) {
@@ -462,17 +462,14 @@ JNIEXPORT jint JNICALL Java_sun_nio_ch_sctp_SctpChannelImpl_receive0
             char *bufp = (char*)addr;
             union sctp_notification *snp;
             jboolean allocated = JNI_FALSE;
+            /* a notification is at most SCTP_NOTIFICATION_SIZE bytes, so a
+             * partial one is completed on the stack rather than the heap */
+            union sctp_notification notification;
 
             if (!(msg->msg_flags & MSG_EOR) && length < SCTP_NOTIFICATION_SIZE) {
-                char* newBuf;
+                char* newBuf = (char*) &notification;
                 int rvSAVE = rv;
 
-                if ((newBuf = malloc(SCTP_NOTIFICATION_SIZE)) == NULL) {
-                    JNU_ThrowOutOfMemoryError(env, "Out of native heap space.");
-                    return -1;
-                }
-                allocated = JNI_TRUE;
-
                 memcpy(newBuf, addr, rv);
                 iov->iov_base = newBuf + rv;
                 iov->iov_len = SCTP_NOTIFICATION_SIZE - rv;
@@ -0,0 +1,89 @@
+/*
+ * Copyright (c) 2018, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#include "precompiled.hpp"
+#include "memory/arena.hpp"
+#include "memory/resourceArea.hpp"
+#include "microBenchmark.hpp"
+#include "unittest.hpp"
+
+// Allocates a batch of fixed size blocks from a fresh arena.  The arena
+// is created and freed outside of the timed region.
+class ArenaAllocateBody : public MicroBenchmarkBody {
+  Arena* _arena;
+  size_t _size;
+
+public:
+  ArenaAllocateBody(size_t size) : _arena(NULL), _size(size) {}
+
+  void prepare() {
+    _arena = new (mtTest) Arena(mtTest);
+  }
+
+  void run(size_t ops) {
+    uintx sum = 0;
+    for (size_t i = 0; i < ops; i++) {
+      sum += (uintx)_arena->Amalloc(_size);
+    }
+    MicroBenchmark::consume(sum);
+  }
+
+  void finish() {
+    delete _arena;
+    _arena = NULL;
+  }
+};
+
+// One operation is a ResourceMark scope with a single small allocation,
+// the pattern used by most resource area clients.
+class ResourceMarkBody : public MicroBenchmarkBody {
+public:
+  void run(size_t ops) {
+    uintx sum = 0;
+    for (size_t i = 0; i < ops; i++) {
+      ResourceMark rm;
+      sum += (uintx)NEW_RESOURCE_ARRAY(char, 64);
+    }
+    MicroBenchmark::consume(sum);
+  }
+};
+
+TEST_VM_BENCHMARK(Arena, allocate_small) {
+  ArenaAllocateBody body(24);
+  MicroBenchmark bench("Arena.allocate_small", 16 * K);
+  bench.run(&body);
+}
+
+// Large enough that most allocations need a new chunk.
+TEST_VM_BENCHMARK(Arena, allocate_chunk) {
+  ArenaAllocateBody body(Chunk::size);
+  MicroBenchmark bench("Arena.allocate_chunk", 256);
+  bench.run(&body);
+}
+
+TEST_VM_BENCHMARK(Arena, resource_mark) {
+  ResourceMarkBody body;
+  MicroBenchmark bench("Arena.resource_mark", 16 * K);
+  bench.run(&body);
+}
@@ -0,0 +1,128 @@
+/*
+ * Copyright (c) 2018, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#include "precompiled.hpp"
+#include "memory/resourceArea.hpp"
+#include "microBenchmark.hpp"
+#include "utilities/bitMap.inline.hpp"
+#include "unittest.hpp"
+
+static const BitMap::idx_t bitmap_size = 64 * K;
+
+// Each operation covers one range; ranges of the given length are walked
+// through the map so that both the word-aligned and the partial word
+// paths are exercised.
+class BitMapRangeBody : public MicroBenchmarkBody {
+protected:
+  ResourceBitMap _map;
+  BitMap::idx_t _range;
+
+  BitMap::idx_t begin(size_t i) const {
+    // A stride that is not a multiple of the word size.
+    return (BitMap::idx_t)((i * 67) % (bitmap_size - _range));
+  }
+
+public:
+  BitMapRangeBody(BitMap::idx_t range) : _map(bitmap_size), _range(range) {}
+};
+
+class BitMapSetClearRangeBody : public BitMapRangeBody {
+public:
+  BitMapSetClearRangeBody(BitMap::idx_t range) : BitMapRangeBody(range) {}
+
+  void run(size_t ops) {
+    for (size_t i = 0; i < ops; i += 2) {
+      BitMap::idx_t beg = begin(i);
+      _map.set_range(beg, beg + _range);
+      _map.clear_range(beg, beg + _range);
+    }
+  }
+};
+
+class BitMapCountBody : public BitMapRangeBody {
+public:
+  BitMapCountBody() : BitMapRangeBody(0) {
+    for (BitMap::idx_t i = 0; i < bitmap_size; i += 3) {
+      _map.set_bit(i);
+    }
+  }
+
+  void run(size_t ops) {
+    uintx count = 0;
+    for (size_t i = 0; i < ops; i++) {
+      count += _map.count_one_bits();
+    }
+    MicroBenchmark::consume(count);
+  }
+};
+
+class BitMapNextOneBody : public BitMapRangeBody {
+public:
+  BitMapNextOneBody() : BitMapRangeBody(0) {
+    for (BitMap::idx_t i = 0; i < bitmap_size; i += 97) {
+      _map.set_bit(i);
+    }
+  }
+
+  void run(size_t ops) {
+    uintx sum = 0;
+    BitMap::idx_t offset = 0;
+    for (size_t i = 0; i < ops; i++) {
+      offset = _map.get_next_one_offset(offset + 1);
+      if (offset >= bitmap_size) {
+        offset = 0;
+      }
+      sum += offset;
+    }
+    MicroBenchmark::consume(sum);
+  }
+};
+
+TEST_VM_BENCHMARK(BitMap, set_clear_small_range) {
+  ResourceMark rm;
+  BitMapSetClearRangeBody body(13);
+  MicroBenchmark bench("BitMap.set_clear_small_range", 16 * K);
+  bench.run(&body);
+}
+
+TEST_VM_BENCHMARK(BitMap, set_clear_large_range) {
+  ResourceMark rm;
+  BitMapSetClearRangeBody body(8 * K + 5);
+  MicroBenchmark bench("BitMap.set_clear_large_range", 1 * K);
+  bench.run(&body);
+}
+
+TEST_VM_BENCHMARK(BitMap, count_one_bits) {
+  ResourceMark rm;
+  BitMapCountBody body;
+  MicroBenchmark bench("BitMap.count_one_bits", 64);
+  bench.run(&body);
+}
+
+TEST_VM_BENCHMARK(BitMap, get_next_one_offset) {
+  ResourceMark rm;
+  BitMapNextOneBody body;
+  MicroBenchmark bench("BitMap.get_next_one_offset", 16 * K);
+  bench.run(&body);
+}
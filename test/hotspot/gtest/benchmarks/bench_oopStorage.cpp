@@ -0,0 +1,165 @@
+/*
+ * Copyright (c) 2018, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#include "precompiled.hpp"
+#include "gc/shared/oopStorage.inline.hpp"
+#include "memory/iterator.hpp"
+#include "microBenchmark.hpp"
+#include "runtime/interfaceSupport.hpp"
+#include "runtime/mutex.hpp"
+#include "runtime/thread.hpp"
+#include "runtime/vm_operations.hpp"
+#include "runtime/vmThread.hpp"
+#include "unittest.hpp"
+
+static const size_t oop_storage_entries = 4 * K;
+
+class OopStorageBenchmark : public ::testing::Test {
+public:
+  OopStorageBenchmark();
+  ~OopStorageBenchmark();
+
+  Mutex _allocate_mutex;
+  Mutex _active_mutex;
+  OopStorage _storage;
+  oop* _entries[oop_storage_entries];
+
+  class AllocateReleaseBody;
+  class BulkReleaseBody;
+  class IterateBody;
+  class VM_IterateBenchmark;
+};
+
+OopStorageBenchmark::OopStorageBenchmark() :
+  _allocate_mutex(Mutex::leaf,
+                  "bench_OopStorage_allocate",
+                  false,
+                  Mutex::_safepoint_check_never),
+  _active_mutex(Mutex::leaf - 1,
+                "bench_OopStorage_active",
+                false,
+                Mutex::_safepoint_check_never),
+  _storage("Benchmark Storage", &_allocate_mutex, &_active_mutex)
+{ }
+
+OopStorageBenchmark::~OopStorageBenchmark() {
+  EXPECT_EQ(0u, _storage.allocation_count());
+}
+
+// Allocates a batch of entries and releases them one at a time.
+class OopStorageBenchmark::AllocateReleaseBody : public MicroBenchmarkBody {
+  OopStorageBenchmark* _test;
+
+public:
+  AllocateReleaseBody(OopStorageBenchmark* test) : _test(test) {}
+
+  void run(size_t ops) {
+    size_t entries = ops / 2;
+    for (size_t i = 0; i < entries; i++) {
+      _test->_entries[i] = _test->_storage.allocate();
+    }
+    for (size_t i = 0; i < entries; i++) {
+      _test->_storage.release(_test->_entries[i]);
+    }
+  }
+};
+
+TEST_VM_F(OopStorageBenchmark, DISABLED_allocate_release) {
+  AllocateReleaseBody body(this);
+  MicroBenchmark bench("OopStorage.allocate_release", 2 * oop_storage_entries);
+  bench.run(&body);
+}
+
+// Allocates a batch of entries untimed and times releasing them in bulk.
+class OopStorageBenchmark::BulkReleaseBody : public MicroBenchmarkBody {
+  OopStorageBenchmark* _test;
+
+public:
+  BulkReleaseBody(OopStorageBenchmark* test) : _test(test) {}
+
+  void prepare() {
+    for (size_t i = 0; i < oop_storage_entries; i++) {
+      _test->_entries[i] = _test->_storage.allocate();
+    }
+  }
+
+  void run(size_t ops) {
+    _test->_storage.release(_test->_entries, ops);
+  }
+};
+
+TEST_VM_F(OopStorageBenchmark, DISABLED_bulk_release) {
+  BulkReleaseBody body(this);
+  MicroBenchmark bench("OopStorage.bulk_release", oop_storage_entries);
+  bench.run(&body);
+}
+
+class OopStorageBenchmark::IterateBody : public MicroBenchmarkBody {
+  class CountClosure : public OopClosure {
+  public:
+    size_t _count;
+    CountClosure() : _count(0) {}
+    virtual void do_oop(oop* p) { _count++; }
+    virtual void do_oop(narrowOop* p) { ShouldNotReachHere(); }
+  };
+
+  OopStorage* _storage;
+
+public:
+  IterateBody(OopStorage* storage) : _storage(storage) {}
+
+  void run(size_t ops) {
+    CountClosure cl;
+    _storage->oops_do(&cl);
+    MicroBenchmark::consume(cl._count);
+  }
+};
+
+// Iteration requires a safepoint, so the whole benchmark runs inside a
+// single VM operation and the timings exclude safepoint synchronization.
+class OopStorageBenchmark::VM_IterateBenchmark : public VM_GTestExecuteAtSafepoint {
+  OopStorage* _storage;
+
+public:
+  VM_IterateBenchmark(OopStorage* storage) : _storage(storage) {}
+
+  void doit() {
+    IterateBody body(_storage);
+    MicroBenchmark bench("OopStorage.iterate", oop_storage_entries);
+    bench.run(&body);
+  }
+};
+
+TEST_VM_F(OopStorageBenchmark, DISABLED_iterate) {
+  for (size_t i = 0; i < oop_storage_entries; i++) {
+    _entries[i] = _storage.allocate();
+    ASSERT_TRUE(_entries[i] != NULL);
+  }
+  VM_IterateBenchmark op(&_storage);
+  {
+    ThreadInVMfromNative invm(JavaThread::current());
+    VMThread::execute(&op);
+  }
+  _storage.release(_entries, oop_storage_entries);
+}
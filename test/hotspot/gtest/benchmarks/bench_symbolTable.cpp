@@ -0,0 +1,90 @@
+/*
+ * Copyright (c) 2018, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#include "precompiled.hpp"
+#include "classfile/symbolTable.hpp"
+#include "microBenchmark.hpp"
+#include "runtime/interfaceSupport.hpp"
+#include "runtime/thread.hpp"
+#include "unittest.hpp"
+
+static const int symbol_count = 1024;
+static const int symbol_name_length = 32;
+
+// Probes the table for a fixed set of names.  When the names were added
+// to the table first every probe hits, otherwise every probe misses.
+class SymbolTableLookupBody : public MicroBenchmarkBody {
+  char _names[symbol_count][symbol_name_length];
+  int _lengths[symbol_count];
+  Symbol* _symbols[symbol_count];
+
+public:
+  SymbolTableLookupBody(const char* prefix, bool insert, TRAPS) {
+    for (int i = 0; i < symbol_count; i++) {
+      _lengths[i] = jio_snprintf(_names[i], symbol_name_length, "%s%d", prefix, i);
+      _symbols[i] = NULL;
+      if (insert) {
+        _symbols[i] = SymbolTable::new_symbol(_names[i], _lengths[i], CATCH);
+      }
+    }
+  }
+
+  ~SymbolTableLookupBody() {
+    for (int i = 0; i < symbol_count; i++) {
+      if (_symbols[i] != NULL) {
+        _symbols[i]->decrement_refcount();
+      }
+    }
+  }
+
+  void run(size_t ops) {
+    uintx found = 0;
+    for (size_t i = 0; i < ops; i++) {
+      int index = (int)(i % symbol_count);
+      Symbol* sym = SymbolTable::probe(_names[index], _lengths[index]);
+      if (sym != NULL) {
+        // probe() increments the refcount of a found symbol.
+        sym->decrement_refcount();
+        found++;
+      }
+    }
+    MicroBenchmark::consume(found);
+  }
+};
+
+TEST_VM_BENCHMARK(SymbolTable, lookup_hit) {
+  JavaThread* THREAD = JavaThread::current();
+  ThreadInVMfromNative invm(THREAD);
+  SymbolTableLookupBody body("bench/SymbolTable/Hit", true, THREAD);
+  MicroBenchmark bench("SymbolTable.lookup_hit", 4 * symbol_count);
+  bench.run(&body);
+}
+
+TEST_VM_BENCHMARK(SymbolTable, lookup_miss) {
+  JavaThread* THREAD = JavaThread::current();
+  ThreadInVMfromNative invm(THREAD);
+  SymbolTableLookupBody body("bench/SymbolTable/Miss", false, THREAD);
+  MicroBenchmark bench("SymbolTable.lookup_miss", 4 * symbol_count);
+  bench.run(&body);
+}
@@ -0,0 +1,144 @@
+/*
+ * Copyright (c) 2018, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#include "precompiled.hpp"
+#include "classfile/systemDictionary.hpp"
+#include "memory/oopFactory.hpp"
+#include "microBenchmark.hpp"
+#include "oops/instanceKlass.hpp"
+#include "oops/objArrayOop.inline.hpp"
+#include "runtime/biasedLocking.hpp"
+#include "runtime/handles.inline.hpp"
+#include "runtime/interfaceSupport.hpp"
+#include "runtime/synchronizer.hpp"
+#include "runtime/thread.hpp"
+#include "runtime/vmThread.hpp"
+#include "runtime/vm_operations.hpp"
+#include "unittest.hpp"
+
+static const int monitor_count = 4 * K;
+
+// Owns an array of fresh java.lang.Object instances.  Idle monitors are
+// deflated during the cleanup phase of every safepoint, so forcing a
+// safepoint returns all inflated monitors to the free lists.
+class SynchronizerBody : public MicroBenchmarkBody {
+protected:
+  JavaThread* _thread;
+  objArrayHandle _objects;
+
+  void allocate_objects() {
+    JavaThread* THREAD = _thread;
+    HandleMark hm(THREAD);
+    InstanceKlass* ik = InstanceKlass::cast(SystemDictionary::Object_klass());
+    for (int i = 0; i < monitor_count; i++) {
+      instanceOop obj = ik->allocate_instance(CATCH);
+      Handle h(THREAD, obj);
+      if (UseBiasedLocking) {
+        // Fresh objects may be anonymously biased; inflation expects
+        // an unbiased header.
+        BiasedLocking::revoke_and_rebias(h, false, CATCH);
+      }
+      _objects->obj_at_put(i, h());
+    }
+  }
+
+  void inflate_objects(size_t count) {
+    for (size_t i = 0; i < count; i++) {
+      ObjectSynchronizer::inflate(_thread, _objects->obj_at((int)i),
+                                  ObjectSynchronizer::inflate_cause_vm_internal);
+    }
+  }
+
+  void force_safepoint() {
+    VM_ForceSafepoint op;
+    VMThread::execute(&op);
+  }
+
+public:
+  SynchronizerBody(JavaThread* thread) : _thread(thread) {
+    JavaThread* THREAD = thread;
+    objArrayOop array = oopFactory::new_objArray(SystemDictionary::Object_klass(),
+                                                 monitor_count, CATCH);
+    _objects = objArrayHandle(THREAD, array);
+  }
+};
+
+class SynchronizerInflateBody : public SynchronizerBody {
+public:
+  SynchronizerInflateBody(JavaThread* thread) : SynchronizerBody(thread) {}
+
+  void prepare()      { allocate_objects(); }
+  void run(size_t ops) { inflate_objects(ops); }
+  void finish()       { force_safepoint(); }
+};
+
+// A sample is one safepoint whose cleanup deflates the monitors inflated
+// by prepare(), so it includes the cost of reaching the safepoint.  With
+// no inflated monitors the same body measures that fixed cost, which is
+// reported separately as the baseline.
+class SynchronizerDeflateBody : public SynchronizerBody {
+  bool _inflate;
+
+public:
+  SynchronizerDeflateBody(JavaThread* thread, bool inflate) :
+    SynchronizerBody(thread), _inflate(inflate) {}
+
+  void prepare() {
+    allocate_objects();
+    if (_inflate) {
+      inflate_objects(monitor_count);
+    }
+  }
+
+  void run(size_t ops) { force_safepoint(); }
+};
+
+TEST_VM_BENCHMARK(ObjectSynchronizer, inflate) {
+  JavaThread* THREAD = JavaThread::current();
+  ThreadInVMfromNative invm(THREAD);
+  HandleMark hm(THREAD);
+  SynchronizerInflateBody body(THREAD);
+  MicroBenchmark bench("ObjectSynchronizer.inflate", monitor_count);
+  bench.run(&body);
+}
+
+TEST_VM_BENCHMARK(ObjectSynchronizer, deflate) {
+  if (AsyncDeflateIdleMonitors) {
+    // Deflation happens on the ServiceThread rather than at safepoints.
+    return;
+  }
+  JavaThread* THREAD = JavaThread::current();
+  ThreadInVMfromNative invm(THREAD);
+  HandleMark hm(THREAD);
+  {
+    SynchronizerDeflateBody body(THREAD, false);
+    MicroBenchmark bench("ObjectSynchronizer.deflate_baseline", monitor_count);
+    bench.run(&body);
+  }
+  {
+    SynchronizerDeflateBody body(THREAD, true);
+    MicroBenchmark bench("ObjectSynchronizer.deflate", monitor_count);
+    bench.run(&body);
+  }
+}
@@ -0,0 +1,106 @@
+/*
+ * Copyright (c) 2018, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#include "precompiled.hpp"
+#include "gc/shared/taskqueue.inline.hpp"
+#include "microBenchmark.hpp"
+#include "unittest.hpp"
+
+typedef GenericTaskQueue<int, mtGC>               BenchTaskQueue;
+typedef GenericTaskQueueSet<BenchTaskQueue, mtGC> BenchTaskQueueSet;
+
+// Batch size per sample; well below the queue capacity so that pushes
+// never fail.
+static const size_t task_queue_ops = 4 * K;
+
+// The owner pushes a batch and pops it back from the local end.
+class TaskQueuePushPopBody : public MicroBenchmarkBody {
+  BenchTaskQueue _queue;
+
+public:
+  TaskQueuePushPopBody() { _queue.initialize(); }
+
+  void run(size_t ops) {
+    for (size_t i = 0; i < ops; i++) {
+      _queue.push((int)i);
+    }
+    int t;
+    uintx sum = 0;
+    while (_queue.pop_local(t)) {
+      sum += t;
+    }
+    MicroBenchmark::consume(sum);
+  }
+};
+
+TEST_VM_BENCHMARK(TaskQueue, push_pop_local) {
+  TaskQueuePushPopBody body;
+  MicroBenchmark bench("TaskQueue.push_pop_local", 2 * task_queue_ops);
+  bench.run(&body);
+}
+
+// A second queue in the set steals a prefilled batch from the first,
+// measuring the uncontended pop_global path through the set.
+class TaskQueueStealBody : public MicroBenchmarkBody {
+  BenchTaskQueue _queues[2];
+  BenchTaskQueueSet _set;
+  int _seed;
+
+public:
+  TaskQueueStealBody() : _set(2), _seed(17) {
+    for (uint i = 0; i < 2; i++) {
+      _queues[i].initialize();
+      _set.register_queue(i, &_queues[i]);
+    }
+  }
+
+  void prepare() {
+    for (size_t i = 0; i < task_queue_ops; i++) {
+      _queues[0].push((int)i);
+    }
+  }
+
+  void run(size_t ops) {
+    int t;
+    uintx sum = 0;
+    for (size_t i = 0; i < ops; i++) {
+      if (_set.steal(1, &_seed, t)) {
+        sum += t;
+      }
+    }
+    MicroBenchmark::consume(sum);
+  }
+
+  void finish() {
+    int t;
+    while (_queues[0].pop_local(t)) {}
+    ASSERT_EQ(0u, _set.tasks());
+  }
+};
+
+TEST_VM_BENCHMARK(TaskQueue, steal) {
+  TaskQueueStealBody body;
+  MicroBenchmark bench("TaskQueue.steal", task_queue_ops);
+  bench.run(&body);
+}
@@ -0,0 +1,161 @@
+/*
+ * Copyright (c) 2018, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#ifndef GTEST_BENCHMARKS_MICROBENCHMARK_HPP
+#define GTEST_BENCHMARKS_MICROBENCHMARK_HPP
+
+#include "memory/allocation.hpp"
+#include "runtime/os.hpp"
+#include "utilities/globalDefinitions.hpp"
+#include "utilities/ostream.hpp"
+#include "utilities/quickSort.hpp"
+#include "unittest.hpp"
+
+#include <math.h>
+
+// Timing harness for the VM-internal microbenchmarks in this directory.
+//
+// The benchmarks are ordinary gtest cases whose names start with
+// DISABLED_, so they are skipped by normal test runs.  Run them with
+//
+//   gtestLauncher -jdk:<jdk> --gtest_also_run_disabled_tests \
+//                 --gtest_filter='*Benchmark*'
+//
+// TEST_VM_BENCHMARK adds the prefix and suffix to the test case name;
+// fixture based benchmarks use a fixture named *Benchmark and TEST_VM_F
+// with a DISABLED_ test name.
+//
+// Each benchmark runs a body in samples of a fixed number of operations.
+// A number of warm-up samples are run and discarded first, then every
+// measured sample is timed with os::javaTimeNanos().  One line is printed
+// per benchmark, in nanoseconds per operation:
+//
+//   BENCHMARK <name> ops=<n> samples=<n> min=<ns> median=<ns> mean=<ns> stddev=<ns>
+//
+// The format is fixed so that the output of two builds can be diffed or
+// fed to a script.  The sample counts can be overridden with the
+// HOTSPOT_BENCHMARK_WARMUP and HOTSPOT_BENCHMARK_SAMPLES environment
+// variables.
+//
+// A body is any class providing
+//
+//   void prepare();        // untimed, before each sample
+//   void run(size_t ops);  // timed, performs ops operations
+//   void finish();         // untimed, after each sample
+//
+// MicroBenchmarkBody provides empty prepare() and finish().
+
+#define TEST_VM_BENCHMARK(category, name) \
+  TEST_VM(DISABLED_ ## category ## Benchmark, name)
+
+class MicroBenchmarkBody {
+public:
+  void prepare() {}
+  void finish() {}
+};
+
+class MicroBenchmark : public StackObj {
+public:
+  static const int default_warmup = 5;
+  static const int default_samples = 20;
+  static const int max_samples = 1000;
+
+private:
+  const char* _name;
+  size_t _ops;
+  int _warmup;
+  int _samples;
+  jlong _elapsed[max_samples];
+
+  static int sample_count(const char* env, int default_value) {
+    const char* value = ::getenv(env);
+    if (value == NULL) {
+      return default_value;
+    }
+    int count = atoi(value);
+    return MAX2(0, MIN2(count, (int)max_samples));
+  }
+
+  static int compare_elapsed(jlong a, jlong b) {
+    return (a < b) ? -1 : ((a > b) ? 1 : 0);
+  }
+
+  double per_op(jlong nanos) const {
+    return (double)nanos / (double)_ops;
+  }
+
+  void report() {
+    QuickSort::sort(_elapsed, _samples, compare_elapsed, false);
+    double sum = 0.0;
+    for (int i = 0; i < _samples; i++) {
+      sum += per_op(_elapsed[i]);
+    }
+    double mean = sum / _samples;
+    double squares = 0.0;
+    for (int i = 0; i < _samples; i++) {
+      double delta = per_op(_elapsed[i]) - mean;
+      squares += delta * delta;
+    }
+    double stddev = (_samples > 1) ? sqrt(squares / (_samples - 1)) : 0.0;
+    tty->print_cr("BENCHMARK %s ops=" SIZE_FORMAT " samples=%d"
+                  " min=%.2f median=%.2f mean=%.2f stddev=%.2f",
+                  _name, _ops, _samples,
+                  per_op(_elapsed[0]), per_op(_elapsed[_samples / 2]),
+                  mean, stddev);
+  }
+
+public:
+  MicroBenchmark(const char* name, size_t ops) :
+    _name(name),
+    _ops(ops),
+    _warmup(sample_count("HOTSPOT_BENCHMARK_WARMUP", default_warmup)),
+    _samples(MAX2(1, sample_count("HOTSPOT_BENCHMARK_SAMPLES", default_samples)))
+  {
+    assert(ops > 0, "must perform some operations");
+  }
+
+  // Keeps a computed value alive so the timed loop cannot be optimized away.
+  static void consume(uintx value) {
+    volatile uintx sink = value;
+  }
+
+  template<typename Body>
+  void run(Body* body) {
+    for (int i = 0; i < _warmup; i++) {
+      body->prepare();
+      body->run(_ops);
+      body->finish();
+    }
+    for (int i = 0; i < _samples; i++) {
+      body->prepare();
+      jlong start = os::javaTimeNanos();
+      body->run(_ops);
+      _elapsed[i] = os::javaTimeNanos() - start;
+      body->finish();
+    }
+    report();
+  }
+};
+
+#endif // GTEST_BENCHMARKS_MICROBENCHMARK_HPP
@@ -75,3 +75,23 @@ TEST_VM(SymbolTable, temp_new_symbol) {
   ASSERT_EQ(xyz->refcount(), xyzcount - 1)
           << "Should have been decremented by dtor in inner scope";
 }
+
+TEST_VM(SymbolTable, dead_symbol_not_revived) {
+  JavaThread* THREAD = JavaThread::current();
+  // the thread should be in vm to use locks
+  ThreadInVMfromNative ThreadInVMfromNative(THREAD);
+
+  const char* name = "dead_symbol_not_revived";
+  Symbol* dead = SymbolTable::new_symbol(name, CATCH);
+  ASSERT_EQ(dead->refcount(), 1) << "new symbol should have one reference";
+  dead->decrement_refcount();
+  ASSERT_EQ(dead->refcount(), 0) << "symbol should be dead";
+  ASSERT_FALSE(dead->try_increment_refcount()) << "dead symbol must not be revived";
+
+  // The dead symbol stays in the table until the ServiceThread removes it,
+  // but a lookup must never hand it out again.
+  TempNewSymbol alive = SymbolTable::new_symbol(name, CATCH);
+  ASSERT_NE(alive->refcount(), 0) << "lookup should return a live symbol";
+  ASSERT_TRUE(alive != dead) << "lookup should not return the dead symbol";
+  ASSERT_TRUE(alive->equals(name)) << "lookup should return an equal symbol";
+}
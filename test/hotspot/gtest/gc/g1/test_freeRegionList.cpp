@@ -23,6 +23,7 @@
 
 #include "precompiled.hpp"
 #include "gc/g1/g1CollectedHeap.inline.hpp"
+#include "gc/g1/heapRegionSet.inline.hpp"
 #include "unittest.hpp"
 
 // @requires UseG1GC
@@ -78,3 +79,60 @@ TEST_VM(FreeRegionList, length) {
   delete bot_storage;
   FREE_C_HEAP_ARRAY(HeapWord, bot_data);
 }
+
+// @requires UseG1GC
+TEST_VM(FreeRegionList, remove_region_with_node_index) {
+  if (!UseG1GC) {
+    return;
+  }
+
+  FreeRegionList l("test");
+  const uint num_regions_in_test = 4;
+
+  MemRegion heap(NULL, num_regions_in_test * HeapRegion::GrainWords);
+
+  size_t bot_size = G1BlockOffsetTable::compute_size(heap.word_size());
+  HeapWord* bot_data = NEW_C_HEAP_ARRAY(HeapWord, bot_size, mtGC);
+  ReservedSpace bot_rs(G1BlockOffsetTable::compute_size(heap.word_size()));
+  G1RegionToSpaceMapper* bot_storage =
+    G1RegionToSpaceMapper::create_mapper(bot_rs,
+                                         bot_rs.size(),
+                                         os::vm_page_size(),
+                                         HeapRegion::GrainBytes,
+                                         BOTConstants::N_bytes,
+                                         mtGC);
+  G1BlockOffsetTable bot(heap, bot_storage);
+  bot_storage->commit_regions(0, num_regions_in_test);
+
+  MemRegion mr0(heap.start(), HeapRegion::GrainWords);
+  MemRegion mr1(mr0.end(), HeapRegion::GrainWords);
+  MemRegion mr2(mr1.end(), HeapRegion::GrainWords);
+  MemRegion mr3(mr2.end(), HeapRegion::GrainWords);
+
+  HeapRegion hr0(0, &bot, mr0);
+  HeapRegion hr1(1, &bot, mr1);
+  HeapRegion hr2(2, &bot, mr2);
+  HeapRegion hr3(3, &bot, mr3);
+  hr0.set_node_index(0);
+  hr1.set_node_index(1);
+  hr2.set_node_index(0);
+  hr3.set_node_index(1);
+  l.add_ordered(&hr0);
+  l.add_ordered(&hr1);
+  l.add_ordered(&hr2);
+  l.add_ordered(&hr3);
+
+  EXPECT_EQ(&hr1, l.remove_region_with_node_index(true /* from_head */, 1));
+  EXPECT_EQ(&hr2, l.remove_region_with_node_index(false /* from_head */, 0));
+  EXPECT_TRUE(l.remove_region_with_node_index(true /* from_head */, 2) == NULL);
+  EXPECT_EQ(l.length(), 2u) << "Wrong free region list length";
+  l.verify_list();
+
+  EXPECT_EQ(&hr0, l.remove_region(true /* from_head */));
+  EXPECT_EQ(&hr3, l.remove_region(true /* from_head */));
+  EXPECT_EQ(l.length(), 0u) << "Wrong free region list length";
+
+  bot_storage->uncommit_regions(0, num_regions_in_test);
+  delete bot_storage;
+  FREE_C_HEAP_ARRAY(HeapWord, bot_data);
+}
@@ -0,0 +1,64 @@
+/*
+ * Copyright (c) 2018, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#include "precompiled.hpp"
+#include "gc/g1/g1RegionMarkStatsCache.inline.hpp"
+#include "memory/allocation.inline.hpp"
+#include "unittest.hpp"
+
+TEST_VM(G1RegionMarkStatsCache, evict_to_target) {
+  const uint num_regions = 64;
+  const uint num_cache_entries = 8;
+
+  G1RegionMarkStats* stats = NEW_C_HEAP_ARRAY(G1RegionMarkStats, num_regions, mtGC);
+  for (uint i = 0; i < num_regions; i++) {
+    stats[i].clear();
+  }
+
+  {
+    G1RegionMarkStatsCache cache(stats, num_regions, num_cache_entries);
+
+    // Regions 1 and 1 + num_cache_entries map to the same cache entry, so
+    // adding to the latter evicts the former.
+    cache.add_live_words(1, 10);
+    cache.add_live_words(1, 5);
+    EXPECT_EQ(0u, stats[1]._live_words) << "Must still be cached";
+    cache.add_live_words(1 + num_cache_entries, 7);
+    EXPECT_EQ(15u, stats[1]._live_words) << "Must have been evicted";
+
+    cache.add_live_words(2, 3);
+    cache.evict_all();
+    EXPECT_EQ(15u, stats[1]._live_words);
+    EXPECT_EQ(3u, stats[2]._live_words);
+    EXPECT_EQ(7u, stats[1 + num_cache_entries]._live_words);
+
+    // Resetting a region discards its cached statistics.
+    cache.add_live_words(3, 4);
+    cache.reset(3);
+    cache.evict_all();
+    EXPECT_EQ(0u, stats[3]._live_words);
+  }
+
+  FREE_C_HEAP_ARRAY(G1RegionMarkStats, stats);
+}
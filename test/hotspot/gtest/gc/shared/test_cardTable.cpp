@@ -0,0 +1,72 @@
+/*
+ * Copyright (c) 2018, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+#include "precompiled.hpp"
+#include "gc/shared/cardTable.hpp"
+#include "unittest.hpp"
+
+// Cards of a test table, word aligned, with room for a leading card
+// used as the limit - 1 sentinel of backward searches.
+static const size_t card_count = 16 * BytesPerWord;
+
+static void check_searches(jbyte* cards, size_t count) {
+  // Compare both searches against a card at a time search, for every
+  // subrange starting and ending at a few unaligned positions.
+  for (size_t from = 0; from < BytesPerWord + 1; ++from) {
+    for (size_t to = count - BytesPerWord - 1; to <= count; ++to) {
+      jbyte* expected_first = cards + from;
+      while (expected_first < cards + to && *expected_first == CardTable::clean_card_val()) {
+        expected_first++;
+      }
+      ASSERT_EQ(expected_first, CardTable::find_first_non_clean_card(cards + from, cards + to));
+
+      jbyte* expected_last = cards + to - 1;
+      while (expected_last >= cards + from && *expected_last == CardTable::clean_card_val()) {
+        expected_last--;
+      }
+      ASSERT_EQ(expected_last, CardTable::find_last_non_clean_card(cards + from, cards + to - 1));
+    }
+  }
+}
+
+TEST(CardTable, find_non_clean_card) {
+  jbyte storage[card_count + 2 * BytesPerWord];
+  jbyte* cards = align_up(storage + 1, BytesPerWord);
+
+  memset(cards, CardTable::clean_card_val(), card_count);
+  check_searches(cards, card_count);
+
+  size_t positions[] = { 0, 1, BytesPerWord - 1, BytesPerWord, 5 * BytesPerWord + 3,
+                         card_count - BytesPerWord, card_count - 2, card_count - 1 };
+  for (size_t i = 0; i < ARRAY_SIZE(positions); ++i) {
+    memset(cards, CardTable::clean_card_val(), card_count);
+    cards[positions[i]] = CardTable::dirty_card_val();
+    check_searches(cards, card_count);
+  }
+
+  // Two non-clean cards in the same word.
+  memset(cards, CardTable::clean_card_val(), card_count);
+  cards[3 * BytesPerWord + 1] = CardTable::dirty_card_val();
+  cards[3 * BytesPerWord + 6] = CardTable::dirty_card_val();
+  check_searches(cards, card_count);
+}
@@ -1067,6 +1067,28 @@ TEST_VM_F(OopStorageTestWithAllocation, delete_empty_blocks_concurrent) {
   EXPECT_EQ(initial_active_size - 3, _storage.block_count());
 }
 
+TEST_VM_F(OopStorageTestWithAllocation, delete_empty_blocks_on_request) {
+  TestAccess::BlockList& active_list = TestAccess::active_list(_storage);
+
+  size_t initial_active_size = list_length(active_list);
+  ASSERT_LE(3u, initial_active_size); // Need at least 3 blocks for test
+
+  // No release has emptied a block, so there is no cleanup request.
+  _storage.delete_empty_blocks();
+  EXPECT_EQ(initial_active_size, _storage.block_count());
+
+  for (size_t i = 0; empty_block_count(_storage) < 3; ++i) {
+    ASSERT_GT(_max_entries, i);
+    release_entry(_storage, _entries[i]);
+  }
+  EXPECT_EQ(3u, empty_block_count(_storage));
+
+  _storage.delete_empty_blocks();
+  EXPECT_EQ(0u, empty_block_count(_storage));
+  EXPECT_EQ(initial_active_size - 3, list_length(active_list));
+  EXPECT_EQ(initial_active_size - 3, _storage.block_count());
+}
+
 TEST_VM_F(OopStorageTestWithAllocation, allocation_status) {
   oop* retained = _entries[200];
   oop* released = _entries[300];
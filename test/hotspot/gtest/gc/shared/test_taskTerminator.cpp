@@ -0,0 +1,102 @@
+/*
+ * Copyright (c) 2018, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#include "precompiled.hpp"
+#include "gc/shared/owstTaskTerminator.hpp"
+#include "gc/shared/taskqueue.inline.hpp"
+#include "unittest.hpp"
+
+typedef GenericTaskQueue<int, mtGC>             TestTaskQueue;
+typedef GenericTaskQueueSet<TestTaskQueue, mtGC> TestTaskQueueSet;
+
+class TaskTerminatorTestQueues : public StackObj {
+  TestTaskQueue* _queues[2];
+  TestTaskQueueSet _set;
+
+public:
+  TaskTerminatorTestQueues() : _set(2) {
+    for (uint i = 0; i < 2; i++) {
+      _queues[i] = new TestTaskQueue();
+      _queues[i]->initialize();
+      _set.register_queue(i, _queues[i]);
+    }
+  }
+
+  ~TaskTerminatorTestQueues() {
+    for (uint i = 0; i < 2; i++) {
+      delete _queues[i];
+    }
+  }
+
+  TestTaskQueue* queue(uint i) { return _queues[i]; }
+  TestTaskQueueSet* set() { return &_set; }
+};
+
+TEST_VM(TaskTerminator, queue_set_tasks) {
+  TaskTerminatorTestQueues q;
+  ASSERT_EQ(0u, q.set()->tasks());
+
+  q.queue(0)->push(1);
+  q.queue(1)->push(2);
+  q.queue(1)->push(3);
+  ASSERT_EQ(3u, q.set()->tasks());
+
+  int t;
+  ASSERT_TRUE(q.queue(1)->pop_local(t));
+  ASSERT_EQ(2u, q.set()->tasks());
+}
+
+TEST_VM(TaskTerminator, single_thread_terminates) {
+  TaskTerminatorTestQueues q;
+  OWSTTaskTerminator owst(1, q.set());
+  ParallelTaskTerminator ptt(1, q.set());
+  ParallelTaskTerminator* terminators[] = { &owst, &ptt };
+  for (uint i = 0; i < 2; i++) {
+    ASSERT_TRUE(terminators[i]->offer_termination());
+  }
+}
+
+TEST_VM(TaskTerminator, exits_when_tasks_available) {
+  TaskTerminatorTestQueues q;
+  q.queue(1)->push(1);
+
+  // The second thread never offers termination, so the only way out
+  // is to notice the pending task and go back to stealing.
+  OWSTTaskTerminator owst(2, q.set());
+  ParallelTaskTerminator ptt(2, q.set());
+  ParallelTaskTerminator* terminators[] = { &owst, &ptt };
+  for (uint i = 0; i < 2; i++) {
+    ASSERT_FALSE(terminators[i]->offer_termination());
+  }
+
+  int t;
+  ASSERT_TRUE(q.queue(1)->pop_local(t));
+}
+
+TEST_VM(TaskTerminator, selects_protocol) {
+  TaskTerminatorTestQueues q;
+  TaskTerminator terminator(1, q.set());
+  ASSERT_TRUE(terminator.terminator() != NULL);
+  ASSERT_TRUE(terminator.terminator()->offer_termination());
+}
@@ -224,3 +224,38 @@ TEST(LogDecorations, identifiers) {
     EXPECT_EQ(ids[i].expected, strtol(reported, NULL, 10));
   }
 }
+
+TEST_VM(LogDecorations, copy) {
+  LogDecorators decorators;
+  ASSERT_TRUE(decorators.parse("uptime,pid,tags"));
+  LogDecorations* original = new LogDecorations(LogLevel::Info, tagset, decorators);
+  LogDecorations copy(*original);
+
+  // The copy must not refer to the buffer of the original
+  char expected_tags[1 * K];
+  strcpy(expected_tags, original->decoration(LogDecorators::tags_decorator));
+  char expected_uptime[1 * K];
+  strcpy(expected_uptime, original->decoration(LogDecorators::uptime_decorator));
+  delete original;
+
+  EXPECT_STREQ(expected_tags, copy.decoration(LogDecorators::tags_decorator));
+  EXPECT_STREQ(expected_uptime, copy.decoration(LogDecorators::uptime_decorator));
+  EXPECT_STREQ(LogLevel::name(LogLevel::Info), copy.decoration(LogDecorators::level_decorator));
+}
+
+// Decorations are rendered lazily, but must reflect the time of creation
+TEST_VM(LogDecorations, captured_at_creation) {
+  LogDecorators decorators;
+  ASSERT_TRUE(decorators.parse("uptimenanos,timemillis"));
+  LogDecorations first(LogLevel::Info, tagset, decorators);
+  os::naked_short_sleep(5);
+  LogDecorations second(LogLevel::Info, tagset, decorators);
+
+  // Render the later decorations first
+  julong second_nanos = strtoull(second.decoration(LogDecorators::uptimenanos_decorator), NULL, 10);
+  julong second_millis = strtoull(second.decoration(LogDecorators::timemillis_decorator), NULL, 10);
+  julong first_nanos = strtoull(first.decoration(LogDecorators::uptimenanos_decorator), NULL, 10);
+  julong first_millis = strtoull(first.decoration(LogDecorators::timemillis_decorator), NULL, 10);
+  EXPECT_LT(first_nanos, second_nanos);
+  EXPECT_LT(first_millis, second_millis);
+}
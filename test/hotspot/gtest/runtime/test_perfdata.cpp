@@ -22,7 +22,9 @@
  */
 
 #include "precompiled.hpp"
+#include "runtime/perfData.hpp"
 #include "runtime/perfMemory.hpp"
+#include "utilities/align.hpp"
 #include "unittest.hpp"
 
 class PerfMemoryTest : public ::testing::Test {
@@ -41,3 +43,47 @@ TEST_VM_F(PerfMemoryTest, destroy) {
   ASSERT_NE(PerfMemory::capacity(), (size_t)0) << "PerfMemory::_capacity should not be 0";
 }
 
+
+class PerfStripedCounterTest : public ::testing::Test {
+  public:
+    static const int stripe_count = PerfLongStripedCounter::stripe_count;
+
+    static PerfLongStripedCounter* create(const char* name) {
+      return new PerfLongStripedCounter(SUN_RT, name, PerfData::U_Events);
+    }
+    static void destroy(PerfLongStripedCounter* c) { delete c; }
+    static void sample(PerfLongStripedCounter* c) { c->sample(); }
+    static void* stripe(PerfLongStripedCounter* c, int i) { return (void*)&c->_stripes[i]; }
+    static void set_stripe(PerfLongStripedCounter* c, int i, jlong v) { c->_stripes[i]._value = v; }
+};
+
+TEST_VM_F(PerfStripedCounterTest, stripes) {
+  if (!UsePerfData || !PerfMemory::is_usable()) {
+    return;
+  }
+  PerfLongStripedCounter* c = create("gtest.stripedCounter");
+  ASSERT_TRUE(c->is_valid());
+
+  for (int i = 0; i < stripe_count; i++) {
+    EXPECT_TRUE(is_aligned(stripe(c, i), DEFAULT_CACHE_LINE_SIZE))
+        << "stripe " << i << " must start a cache line";
+  }
+  EXPECT_EQ(0, c->get_value());
+
+  jlong expected = 0;
+  for (int i = 0; i < stripe_count; i++) {
+    set_stripe(c, i, i + 1);
+    expected += i + 1;
+  }
+  c->inc();
+  c->inc(5);
+  expected += 6;
+  EXPECT_EQ(expected, c->get_value()) << "get_value() must sum the stripes";
+
+  // The PerfData memory only changes when the counter is sampled.
+  EXPECT_EQ(0, *(jlong*)c->get_address());
+  sample(c);
+  EXPECT_EQ(expected, *(jlong*)c->get_address()) << "sample() must publish the sum";
+
+  destroy(c);
+}
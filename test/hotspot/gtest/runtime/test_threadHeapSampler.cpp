@@ -0,0 +1,63 @@
+/*
+ * Copyright (c) 2018, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+#include "precompiled.hpp"
+#include "runtime/threadHeapSampler.hpp"
+#include "unittest.hpp"
+
+static size_t count_samples(ThreadHeapSampler* sampler, size_t total_bytes, size_t allocation_size) {
+  size_t samples = 0;
+  for (size_t allocated = 0; allocated < total_bytes; allocated += allocation_size) {
+    sampler->set_check_pending(0, false);
+    if (sampler->check_for_sampling(allocation_size)) {
+      samples++;
+    }
+  }
+  return samples;
+}
+
+TEST(ThreadHeapSampler, average_interval) {
+  int saved_interval = ThreadHeapSampler::sampling_interval();
+  const int interval = 512 * K;
+  ThreadHeapSampler::set_sampling_interval(interval);
+
+  ThreadHeapSampler sampler;
+  const size_t total_bytes = 1024 * (size_t)interval;
+  size_t samples = count_samples(&sampler, total_bytes, 64);
+
+  // The expected number of samples is 1024 with a standard deviation of 32.
+  EXPECT_GT(samples, 1024u * 9 / 10);
+  EXPECT_LT(samples, 1024u * 11 / 10);
+
+  ThreadHeapSampler::set_sampling_interval(saved_interval);
+}
+
+TEST(ThreadHeapSampler, zero_interval_samples_every_allocation) {
+  int saved_interval = ThreadHeapSampler::sampling_interval();
+  ThreadHeapSampler::set_sampling_interval(0);
+
+  ThreadHeapSampler sampler;
+  EXPECT_EQ(100u, count_samples(&sampler, 100 * 16, 16));
+
+  ThreadHeapSampler::set_sampling_interval(saved_interval);
+}
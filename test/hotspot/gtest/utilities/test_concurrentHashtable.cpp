@@ -0,0 +1,267 @@
+/*
+ * Copyright (c) 2018, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+#include "precompiled.hpp"
+#include "runtime/thread.hpp"
+#include "utilities/concurrentHashTable.inline.hpp"
+#include "utilities/concurrentHashTableTasks.inline.hpp"
+#include "unittest.hpp"
+
+// NOTE: On win32 gtest asserts are not mt-safe.
+// Amusingly as long as they do not assert they are mt-safe.
+
+class Pointer;
+
+typedef ConcurrentHashTable<uintptr_t, Pointer, mtInternal> SimpleTestTable;
+
+// Simplest working CRPT implementation for the hash-table.
+class Pointer : public SimpleTestTable::BaseConfig {
+ public:
+  static uintx get_hash(const uintptr_t& value, bool* dead_hash) {
+    return (uintx)value;
+  }
+  static void* allocate_node(size_t size, const uintptr_t& value) {
+    return ::malloc(size);
+  }
+  static void free_node(void* memory, const uintptr_t& value) {
+    ::free(memory);
+  }
+};
+
+struct SimpleTestLookup {
+  uintptr_t _val;
+  SimpleTestLookup(uintptr_t val) : _val(val) {}
+  uintx get_hash() {
+    return Pointer::get_hash(_val, NULL);
+  }
+  bool equals(const uintptr_t* value, bool* is_dead) {
+    return _val == *value;
+  }
+};
+
+struct ValueGet {
+  uintptr_t _return;
+  ValueGet() : _return(0) {}
+  void operator()(uintptr_t* value) {
+    EXPECT_NE(value, (uintptr_t*)NULL) << "expected valid value";
+    _return = *value;
+  }
+  uintptr_t get_value() const {
+    return _return;
+  }
+};
+
+static uintptr_t cht_get_copy(SimpleTestTable* cht, Thread* thr,
+                              SimpleTestLookup stl) {
+  ValueGet vg;
+  cht->get(thr, stl, vg);
+  return vg.get_value();
+}
+
+static void cht_insert(Thread* thr) {
+  uintptr_t val = 0x2;
+  SimpleTestLookup stl(val);
+  SimpleTestTable* cht = new SimpleTestTable();
+  EXPECT_TRUE(cht->insert(thr, stl, val)) << "Insert unique value failed.";
+  EXPECT_EQ(cht_get_copy(cht, thr, stl), val) << "Getting an existing value failed.";
+  EXPECT_TRUE(cht->remove(thr, stl)) << "Removing an existing value failed.";
+  EXPECT_FALSE(cht->remove(thr, stl)) << "Removing an already removed item succeeded.";
+  EXPECT_NE(cht_get_copy(cht, thr, stl), val) << "Getting a removed value succeeded.";
+  delete cht;
+}
+
+static void cht_getinsert(Thread* thr) {
+  uintptr_t val = 0x2;
+  SimpleTestLookup stl(val);
+  SimpleTestTable* cht = new SimpleTestTable();
+  EXPECT_FALSE(cht->get_insert(thr, stl, val)) << "First get_insert must insert.";
+  EXPECT_TRUE(cht->get_insert(thr, stl, val)) << "Second get_insert must find the value.";
+  EXPECT_EQ(cht_get_copy(cht, thr, stl), val) << "Getting an inserted value failed.";
+  delete cht;
+}
+
+static void cht_unsafe_insert(Thread* thr) {
+  uintptr_t val = 0x2;
+  SimpleTestLookup stl(val);
+  SimpleTestTable* cht = new SimpleTestTable();
+  EXPECT_TRUE(cht->unsafe_insert(val)) << "Insert unique value failed.";
+  EXPECT_EQ(cht_get_copy(cht, thr, stl), val) << "Getting an existing value failed.";
+  delete cht;
+}
+
+struct ChtCountScan {
+  size_t _count;
+  ChtCountScan() : _count(0) {}
+  bool operator()(uintptr_t* val) {
+    _count++;
+    return true; /* continue scan */
+  }
+};
+
+static void cht_scan(Thread* thr) {
+  uintptr_t val = 0x2;
+  SimpleTestLookup stl(val);
+  ChtCountScan scan;
+  SimpleTestTable* cht = new SimpleTestTable();
+  EXPECT_TRUE(cht->insert(thr, stl, val)) << "Insert unique value failed.";
+  EXPECT_EQ(cht->try_scan(thr, scan), true) << "Scanning an non-growing/shrinking table should work.";
+  EXPECT_EQ(scan._count, (size_t)1) << "Scan should visit the single item.";
+  EXPECT_TRUE(cht->remove(thr, stl)) << "Removing a pre-existing value failed.";
+  delete cht;
+}
+
+struct ChtEvenDelete {
+  bool operator()(uintptr_t* val) {
+    return (*val & 0x1) == 0;
+  }
+};
+
+struct ChtDeleteCount {
+  size_t _count;
+  ChtDeleteCount() : _count(0) {}
+  void operator()(uintptr_t* val) {
+    _count++;
+  }
+};
+
+static void cht_bulk_delete(Thread* thr, bool use_task) {
+  const uintptr_t start = 1;
+  const uintptr_t end = 1024;
+  SimpleTestTable* cht = new SimpleTestTable(5, 16);
+  for (uintptr_t v = start; v <= end; v++) {
+    SimpleTestLookup stl(v);
+    EXPECT_TRUE(cht->insert(thr, stl, v)) << "Insert unique value failed.";
+  }
+  ChtEvenDelete eval;
+  ChtDeleteCount del;
+  if (use_task) {
+    SimpleTestTable::BulkDeleteTask bdt(cht);
+    EXPECT_TRUE(bdt.prepare(thr)) << "Uncontended prepare must work.";
+    while (bdt.do_task(thr, eval, del)) {
+      bdt.pause(thr);
+      EXPECT_TRUE(bdt.cont(thr)) << "Uncontended cont must work.";
+    }
+    bdt.done(thr);
+  } else {
+    EXPECT_TRUE(cht->try_bulk_delete(thr, eval, del)) << "Uncontended bulk delete must work.";
+  }
+  EXPECT_EQ(del._count, (size_t)(end / 2)) << "Half of the values should be deleted.";
+  for (uintptr_t v = start; v <= end; v++) {
+    SimpleTestLookup stl(v);
+    if ((v & 0x1) == 0) {
+      EXPECT_EQ(cht_get_copy(cht, thr, stl), (uintptr_t)0) << "Deleted value found.";
+    } else {
+      EXPECT_EQ(cht_get_copy(cht, thr, stl), v) << "Kept value missing.";
+    }
+  }
+  delete cht;
+}
+
+static void cht_grow_shrink(Thread* thr, bool use_task) {
+  const uintptr_t start = 1;
+  const uintptr_t end = 4096;
+  SimpleTestTable* cht = new SimpleTestTable(5, 12);
+  for (uintptr_t v = start; v <= end; v++) {
+    SimpleTestLookup stl(v);
+    EXPECT_TRUE(cht->insert(thr, stl, v)) << "Insert unique value failed.";
+  }
+  if (use_task) {
+    SimpleTestTable::GrowTask gt(cht);
+    EXPECT_TRUE(gt.prepare(thr)) << "Growing uncontended should not fail.";
+    while (gt.do_task(thr)) {
+      gt.pause(thr);
+      gt.cont(thr);
+    }
+    gt.done(thr);
+    EXPECT_EQ(cht->get_size_log2(thr), (size_t)6) << "Task grows one step.";
+  } else {
+    EXPECT_TRUE(cht->grow(thr)) << "Growing uncontended should not fail.";
+    EXPECT_EQ(cht->get_size_log2(thr), (size_t)12) << "Grow should reach the limit.";
+    EXPECT_TRUE(cht->is_max_size_reached()) << "Limit should be reached.";
+  }
+  for (uintptr_t v = start; v <= end; v++) {
+    SimpleTestLookup stl(v);
+    EXPECT_EQ(cht_get_copy(cht, thr, stl), v) << "Getting an item after grow failed.";
+  }
+  EXPECT_TRUE(cht->shrink(thr)) << "Shrinking uncontended should not fail.";
+  EXPECT_EQ(cht->get_size_log2(thr), (size_t)5) << "Shrink should reach the start size.";
+  for (uintptr_t v = start; v <= end; v++) {
+    SimpleTestLookup stl(v);
+    EXPECT_EQ(cht_get_copy(cht, thr, stl), v) << "Getting an item after shrink failed.";
+    EXPECT_TRUE(cht->remove(thr, stl)) << "Removing an existing value failed.";
+  }
+  delete cht;
+}
+
+static void cht_move_to(Thread* thr) {
+  SimpleTestTable* from = new SimpleTestTable();
+  SimpleTestTable* to = new SimpleTestTable();
+  for (uintptr_t v = 1; v <= 64; v++) {
+    SimpleTestLookup stl(v);
+    EXPECT_TRUE(from->insert(thr, stl, v)) << "Insert unique value failed.";
+  }
+  EXPECT_TRUE(from->try_move_nodes_to(thr, to)) << "Moving nodes uncontended should work.";
+  for (uintptr_t v = 1; v <= 64; v++) {
+    SimpleTestLookup stl(v);
+    EXPECT_EQ(cht_get_copy(from, thr, stl), (uintptr_t)0) << "Moved value still in source.";
+    EXPECT_EQ(cht_get_copy(to, thr, stl), v) << "Moved value missing in destination.";
+  }
+  delete from;
+  delete to;
+}
+
+TEST_VM(ConcurrentHashTable, basic_insert) {
+  cht_insert(Thread::current());
+}
+
+TEST_VM(ConcurrentHashTable, basic_get_insert) {
+  cht_getinsert(Thread::current());
+}
+
+TEST_VM(ConcurrentHashTable, basic_unsafe_insert) {
+  cht_unsafe_insert(Thread::current());
+}
+
+TEST_VM(ConcurrentHashTable, basic_scan) {
+  cht_scan(Thread::current());
+}
+
+TEST_VM(ConcurrentHashTable, basic_bulk_delete) {
+  cht_bulk_delete(Thread::current(), false);
+}
+
+TEST_VM(ConcurrentHashTable, task_bulk_delete) {
+  cht_bulk_delete(Thread::current(), true);
+}
+
+TEST_VM(ConcurrentHashTable, basic_grow_shrink) {
+  cht_grow_shrink(Thread::current(), false);
+}
+
+TEST_VM(ConcurrentHashTable, task_grow) {
+  cht_grow_shrink(Thread::current(), true);
+}
+
+TEST_VM(ConcurrentHashTable, basic_move_to) {
+  cht_move_to(Thread::current());
+}
@@ -0,0 +1,68 @@
+/*
+ * Copyright (c) 2018, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#include "precompiled.hpp"
+#include "utilities/globalDefinitions.hpp"
+#include "utilities/population_count.hpp"
+#include "unittest.hpp"
+
+static unsigned naive_population_count(uintx value) {
+  unsigned count = 0;
+  for ( ; value != 0; value >>= 1) {
+    count += (unsigned)(value & 1);
+  }
+  return count;
+}
+
+TEST(population_count, zero_and_all_ones) {
+  EXPECT_EQ(0u, population_count(0));
+  EXPECT_EQ((unsigned)BitsPerWord, population_count(~(uintx)0));
+}
+
+TEST(population_count, one_or_two_set_bits) {
+  for (uintx ix = 1; ix != 0; ix <<= 1) {
+    for (uintx jx = 1; jx != 0; jx <<= 1) {
+      uintx value = ix | jx;
+      EXPECT_EQ((ix == jx) ? 1u : 2u, population_count(value))
+        << "value = " << value;
+    }
+  }
+}
+
+TEST(population_count, all_ones_shifted) {
+  unsigned expected = BitsPerWord;
+  for (uintx value = ~(uintx)0; value != 0; value >>= 1, --expected) {
+    EXPECT_EQ(expected, population_count(value))
+      << "value = " << value;
+  }
+}
+
+TEST(population_count, matches_naive_count) {
+  uintx value = (uintx)0x9e3779b97f4a7c15ULL;
+  for (int i = 0; i < 1000; i++) {
+    EXPECT_EQ(naive_population_count(value), population_count(value))
+      << "value = " << value;
+    value = value * 6364136223846793005ULL + 1442695040888963407ULL;
+  }
+}
@@ -48,3 +48,31 @@ TEST(utf8, length) {
   UNICODE::as_utf8(str, 19, res, INT_MAX);
   ASSERT_EQ(strlen(res), (size_t) 3 * 19) << "string should end here";
 }
+
+TEST(utf8, is_legal_utf8) {
+  // Long enough to exercise the word-at-a-time ASCII fast path
+  unsigned char buf[40];
+  for (int i = 0; i < 40; i++) {
+    buf[i] = (unsigned char) ('a' + (i % 26));
+  }
+  ASSERT_TRUE(UTF8::is_legal_utf8(buf, 40, false)) << "plain ASCII is legal";
+
+  // Embedded zero inside the fast path and inside the tail
+  for (int pos = 0; pos < 40; pos += 7) {
+    unsigned char saved = buf[pos];
+    buf[pos] = 0;
+    ASSERT_FALSE(UTF8::is_legal_utf8(buf, 40, false)) << "embedded zero at " << pos;
+    buf[pos] = saved;
+  }
+
+  // Legal two-byte sequence (U+00E9) after the first word
+  buf[11] = 0xC3;
+  buf[12] = 0xA9;
+  ASSERT_TRUE(UTF8::is_legal_utf8(buf, 40, false)) << "two-byte sequence is legal";
+
+  // Stray continuation byte
+  buf[12] = 'x';
+  buf[20] = 0xA9;
+  buf[11] = 'x';
+  ASSERT_FALSE(UTF8::is_legal_utf8(buf, 40, false)) << "stray continuation byte";
+}
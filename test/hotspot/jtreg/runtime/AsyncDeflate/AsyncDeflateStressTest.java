@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) 2018, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+/*
+ * @test AsyncDeflateStressTest
+ * @summary Contend on monitors while the ServiceThread deflates idle monitors
+ * @run main/othervm -XX:+UnlockExperimentalVMOptions -XX:+AsyncDeflateIdleMonitors
+ *                   -XX:AsyncDeflationInterval=1 -XX:MonitorUsedDeflationThreshold=1
+ *                   AsyncDeflateStressTest
+ */
+
+public class AsyncDeflateStressTest {
+    static final int OBJECTS = 64;
+    static final int THREADS = 8;
+    static final long RUN_MILLIS = 10_000;
+
+    static final Object[] locks = new Object[OBJECTS];
+    static final int[] hashes = new int[OBJECTS];
+    static final long[] counters = new long[OBJECTS];
+
+    static volatile boolean exit_now = false;
+
+    public static void main(String... args) throws Exception {
+        for (int i = 0; i < OBJECTS; i++) {
+            locks[i] = new Object();
+            hashes[i] = System.identityHashCode(locks[i]);
+        }
+
+        Thread[] threads = new Thread[THREADS];
+        long[] expected = new long[OBJECTS];
+        long[][] done = new long[THREADS][OBJECTS];
+        for (int t = 0; t < THREADS; t++) {
+            final long[] mine = done[t];
+            final int seed = t;
+            threads[t] = new Thread(() -> {
+                int i = seed;
+                while (!exit_now) {
+                    i = (i * 31 + 7) & (OBJECTS - 1);
+                    Object lock = locks[i];
+                    synchronized (lock) {
+                        counters[i]++;
+                        mine[i]++;
+                        if ((counters[i] & 255) == 0) {
+                            // Force inflation even without contention.
+                            try {
+                                lock.wait(0, 1);
+                            } catch (InterruptedException e) {
+                                throw new RuntimeException(e);
+                            }
+                        }
+                    }
+                    // Leave the monitor idle now and then so that it is
+                    // deflated, and re-inflated by the next enter.
+                    if ((i & 7) == 0) {
+                        Thread.yield();
+                    }
+                }
+            });
+            threads[t].start();
+        }
+
+        Thread.sleep(RUN_MILLIS);
+        exit_now = true;
+        for (Thread t : threads) {
+            t.join();
+        }
+
+        for (int t = 0; t < THREADS; t++) {
+            for (int i = 0; i < OBJECTS; i++) {
+                expected[i] += done[t][i];
+            }
+        }
+        for (int i = 0; i < OBJECTS; i++) {
+            if (counters[i] != expected[i]) {
+                throw new RuntimeException("lost update on lock " + i + ": " +
+                                           counters[i] + " != " + expected[i]);
+            }
+            if (System.identityHashCode(locks[i]) != hashes[i]) {
+                throw new RuntimeException("identity hash of lock " + i + " changed");
+            }
+        }
+    }
+}